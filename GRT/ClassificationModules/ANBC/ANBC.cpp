@@ -84,41 +84,46 @@ bool ANBC::deepCopyFrom(const Classifier *classifier){
 
 bool ANBC::train_(ClassificationData &trainingData){
     
+    //The ANBC model does not need to modify the training data, so it is trained from a view of the data rather than a copy
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool ANBC::train_(ClassificationDataView &trainingData){
+    
     //Clear any previous model
     clear();
     
     const unsigned int N = trainingData.getNumDimensions();
-    const unsigned int K = trainingData.getNumClasses();
     
     if( trainingData.getNumSamples() == 0 ){
-        errorLog << "train_(ClassificationData &trainingData) - Training data has zero samples!" << std::endl;
+        errorLog << "train_(ClassificationDataView &trainingData) - Training data has zero samples!" << std::endl;
         return false;
     }
     
     if( weightsDataSet ){
         if( weightsData.getNumDimensions() != N ){
-            errorLog << "train_(ClassificationData &trainingData) - The number of dimensions in the weights data (" << weightsData.getNumDimensions() << ") is not equal to the number of dimensions of the training data (" << N << ")" << std::endl;
+            errorLog << "train_(ClassificationDataView &trainingData) - The number of dimensions in the weights data (" << weightsData.getNumDimensions() << ") is not equal to the number of dimensions of the training data (" << N << ")" << std::endl;
             return false;
         }
     }
     
+    ranges = trainingData.getRanges();
+    ClassificationDataView validationData;
+
+    if( useValidationSet ){
+        validationData = trainingData.split( 100-validationSetSize, false, random );
+    }
+
+    //A model can only be trained for a class with samples, so drop any class that has no samples in the view (or was moved to the validation set)
+    trainingData.removeEmptyClasses();
+    
+    const unsigned int K = trainingData.getNumClasses();
     numInputDimensions = N;
     numOutputDimensions = K;
     numClasses = K;
     models.resize(K);
     classLabels.resize(K);
-    ranges = trainingData.getRanges();
-    ClassificationData validationData;
-    
-    //Scale the training data if needed
-    if( useScaling ){
-        //Scale the training data between 0 and 1
-        trainingData.scale(0, 1);
-    }
-
-    if( useValidationSet ){
-        validationData = trainingData.split( 100-validationSetSize );
-    }
 
     const UINT M = trainingData.getNumSamples();
     trainingLog << "Training Naive Bayes model, num training examples: " << M << ", num validation examples: " << validationData.getNumSamples() << ", num classes: " << numClasses << std::endl;
@@ -153,14 +158,15 @@ bool ANBC::train_(ClassificationData &trainingData){
             for(UINT j=0; j<numInputDimensions; j++) weights[j] = 1.0;
         }
         
-        //Get all the training data for this class
-        ClassificationData classData = trainingData.getClassData(classLabel);
-        MatrixFloat data(classData.getNumSamples(),N);
+        //Copy the training data for this class into a matrix, this is the only copy of the training data that is made
+        MatrixFloat data = trainingData.getClassView( classLabel ).getDataAsMatrixFloat();
         
-        //Copy the training data into a matrix
-        for(UINT i=0; i<data.getNumRows(); i++){
-            for(UINT j=0; j<data.getNumCols(); j++){
-                data[i][j] = classData[i][j];
+        //Scale the training data between 0 and 1 if needed
+        if( useScaling ){
+            for(UINT i=0; i<data.getNumRows(); i++){
+                for(UINT j=0; j<data.getNumCols(); j++){
+                    data[i][j] = grt_scale(data[i][j], ranges[j].minValue, ranges[j].maxValue, Float(0), Float(1));
+                }
             }
         }
         
@@ -198,13 +204,10 @@ bool ANBC::train_(ClassificationData &trainingData){
     trained = true;
     converged = true;
 
-    //Compute the final training stats
+    //Compute the final training stats, the view has not been scaled so the model scales each sample as it is tested
     trainingSetAccuracy = 0;
     validationSetAccuracy = 0;
 
-    //If scaling was on, then the data will already be scaled, so turn it off temporially so we can test the model accuracy
-    bool scalingState = useScaling;
-    useScaling = false;
     if( !computeAccuracy( trainingData, trainingSetAccuracy ) ){
         trained = false;
         errorLog << __GRT_LOG__ << " Failed to compute training set accuracy! Failed to fully train model!" << std::endl;
@@ -226,9 +229,6 @@ bool ANBC::train_(ClassificationData &trainingData){
         trainingLog << "Validation set accuracy: " << validationSetAccuracy << std::endl;
     }
 
-    //Reset the scaling state for future prediction
-    useScaling = scalingState;
-
     return trained;
 }
 
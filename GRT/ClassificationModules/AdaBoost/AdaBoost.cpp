@@ -149,7 +149,7 @@ bool AdaBoost::train_(ClassificationData &trainingData){
     }
 
     if( useValidationSet ){
-        validationData = trainingData.split( 100-validationSetSize );
+        validationData = trainingData.split( 100-validationSetSize, false, random );
     }
 
     const UINT M = trainingData.getNumSamples();
@@ -116,7 +116,7 @@ bool BAG::train_(ClassificationData &trainingData){
     }
 
     if( useValidationSet ){
-        validationData = trainingData.split( 100-validationSetSize );
+        validationData = trainingData.split( 100-validationSetSize, false, random );
     }
     
     UINT ensembleSize = ensemble.getSize();
@@ -133,9 +133,9 @@ bool BAG::train_(ClassificationData &trainingData){
         }
     }
     
-    //Train the ensemble
+    //Train the ensemble, each classifier is trained with a bootstrapped view of the training data so the samples are not copied
     for(UINT i=0; i<ensembleSize; i++){
-        ClassificationData boostedDataset = trainingData.getBootstrappedDataset();
+        ClassificationDataView boostedDataset = trainingData.getBootstrappedView( 0, false, random );
 
         //Propagate the training logging to the ensemble
         ensemble[i]->setTrainingLoggingEnabled( this->getTrainingLoggingEnabled() );
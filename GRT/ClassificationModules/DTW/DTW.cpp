@@ -20,6 +20,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "DTW.h"
+#include <deque>
 
 GRT_BEGIN_NAMESPACE
 
@@ -54,6 +55,11 @@ DTW::DTW(bool useScaling,bool useNullRejection,Float nullRejectionCoeff,UINT rej
     trimThreshold = 0.1;
     maximumTrimPercentage = 90;
     
+    computeWarpingPaths = false;
+    useStreamingMode = false;
+    useLowerBounding = false;
+    streamingSampleCounter = 0;
+    
     numTemplates=0;
     distanceMethod=EUCLIDEAN_DIST;
     
@@ -83,6 +89,13 @@ DTW& DTW::operator=(const DTW &rhs){
         this->useZNormalisation = rhs.useZNormalisation;
         this->constrainZNorm = rhs.constrainZNorm;
         this->constrainWarpingPath = rhs.constrainWarpingPath;
+        this->computeWarpingPaths = rhs.computeWarpingPaths;
+        this->useStreamingMode = rhs.useStreamingMode;
+        this->useLowerBounding = rhs.useLowerBounding;
+        this->streamingStates = rhs.streamingStates;
+        this->streamingMatchStart = rhs.streamingMatchStart;
+        this->streamingSampleCounter = rhs.streamingSampleCounter;
+        this->streamingNullRejectionThresholds = rhs.streamingNullRejectionThresholds;
         this->trimTrainingData = rhs.trimTrainingData;
         this->zNormConstrainThreshold = rhs.zNormConstrainThreshold;
         this->radius = rhs.radius;
@@ -118,6 +131,13 @@ bool DTW::deepCopyFrom(const Classifier *classifier){
         this->useZNormalisation = ptr->useZNormalisation;
         this->constrainZNorm = ptr->constrainZNorm;
         this->constrainWarpingPath = ptr->constrainWarpingPath;
+        this->computeWarpingPaths = ptr->computeWarpingPaths;
+        this->useStreamingMode = ptr->useStreamingMode;
+        this->useLowerBounding = ptr->useLowerBounding;
+        this->streamingStates = ptr->streamingStates;
+        this->streamingMatchStart = ptr->streamingMatchStart;
+        this->streamingSampleCounter = ptr->streamingSampleCounter;
+        this->streamingNullRejectionThresholds = ptr->streamingNullRejectionThresholds;
         this->trimTrainingData = ptr->trimTrainingData;
         this->zNormConstrainThreshold = ptr->zNormConstrainThreshold;
         this->radius = ptr->radius;
@@ -186,21 +206,13 @@ bool DTW::train_(TimeSeriesClassificationData &data){
     if( useScaling ) scaleData( trainingData );
     if( useZNormalisation ) znormData( trainingData );
     
-    //For each class, run a one-to-one DTW and find the template the best describes the data
+    //Split the data by class, and check each class has enough examples
+    Vector< TimeSeriesClassificationData > classData( numTemplates );
     for(UINT k=0; k<numTemplates; k++){
         //Get the class label for the cth class
         UINT classLabel = trainingData.getClassTracker()[k].classLabel;
-        TimeSeriesClassificationData classData = trainingData.getClassData( classLabel );
-        UINT numExamples = classData.getNumSamples();
-        bestIndex = 0;
-        
-        //Set the class label of this template
-        templatesBuffer[k].classLabel = classLabel;
-        
-        //Set the kth class label
-        classLabels[k] = classLabel;
-        
-        trainingLog << "Training Template: " << k << " Class: " << classLabel << std::endl;
+        classData[k] = trainingData.getClassData( classLabel );
+        UINT numExamples = classData[k].getNumSamples();
         
         //Check to make sure we actually have some training examples
         if( numExamples < 1 ){
@@ -212,29 +224,53 @@ bool DTW::train_(TimeSeriesClassificationData &data){
             errorLog << __GRT_LOG__ << " Can not train model as there is only 1 example in class: " << classLabel << ". Turn off null rejection if you want to use DTW with only 1 training sample per class." << std::endl;
             return false;
         }
+    }
+    
+    //Compute the distance between every pair of examples in each class, this is run in parallel over all the classes
+    Vector< MatrixFloat > distanceCache;
+    if( !computeTrainingDistances( classData, distanceCache ) ){
+        errorLog << __GRT_LOG__ << " Failed to compute the distances between the training examples!" << std::endl;
+        return false;
+    }
+    
+    //For each class, use the one-to-one DTW distances to find the template the best describes the data
+    Vector< UINT > templateIndexs( numTemplates, 0 );
+    for(UINT k=0; k<numTemplates; k++){
+        UINT classLabel = trainingData.getClassTracker()[k].classLabel;
+        UINT numExamples = classData[k].getNumSamples();
+        bestIndex = 0;
+        
+        //Set the class label of this template
+        templatesBuffer[k].classLabel = classLabel;
+        
+        //Set the kth class label
+        classLabels[k] = classLabel;
+        
+        trainingLog << "Training Template: " << k << " Class: " << classLabel << std::endl;
         
         if( numExamples == 1 ){//If we have just one training example then we have to use it as the template
             bestIndex = 0;
             nullRejectionThresholds[k] = 0.0;//TODO-We need a better way of calculating this!
         }else{
             //Search for the best training example for this class
-            if( !train_NDDTW(classData,templatesBuffer[k],bestIndex) ){
+            if( !train_NDDTW(classData[k],distanceCache[k],templatesBuffer[k],bestIndex) ){
                 errorLog << __GRT_LOG__ << " Failed to train template for class with label: " << classLabel << std::endl;
                     return false;
             }
         }
         
         //Add the template with the best index to the buffer
+        templateIndexs[k] = bestIndex;
         int trainingMethod = 0;
         if(useSmoothing) trainingMethod = 1;
         
         switch (trainingMethod) {
             case(0)://Standard Training
-                templatesBuffer[k].timeSeries = classData[bestIndex].getData();
+                templatesBuffer[k].timeSeries = classData[k][bestIndex].getData();
             break;
             case(1)://Training using Smoothing
                 //Smooth the data, reducing its size by a factor set by smoothFactor
-                smoothData(classData[ bestIndex ].getData(),smoothingFactor,templatesBuffer[k].timeSeries);
+                smoothData(classData[k][ bestIndex ].getData(),smoothingFactor,templatesBuffer[k].timeSeries);
             break;
             default:
                 errorLog << __GRT_LOG__ << " Can not train model: Unknown training method "  << std::endl;
@@ -255,12 +291,22 @@ bool DTW::train_(TimeSeriesClassificationData &data){
     converged = true;
     averageTemplateLength = averageTemplateLength/numTemplates;
     
+    //Compute the subsequence distances used to set the null rejection thresholds for the streaming mode
+    if( !computeStreamingThresholds( classData, templateIndexs ) ){
+        errorLog << __GRT_LOG__ << " Failed to compute the streaming null rejection thresholds!" << std::endl;
+        return false;
+    }
+    
     //Recompute the null rejection thresholds
     recomputeNullRejectionThresholds();
     
+    //Compute the envelopes used to lower bound the distance to each template
+    computeEnvelopes();
+    
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
     continuousInputDataBuffer.resize(averageTemplateLength,VectorFloat(numInputDimensions,0));
+    resetStreamingStates();
     classLikelihoods.resize(numTemplates,DEFAULT_NULL_LIKELIHOOD_VALUE);
     classDistances.resize(numTemplates,0);
     predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
@@ -270,48 +316,70 @@ bool DTW::train_(TimeSeriesClassificationData &data){
     return trained;
 }
 
-bool DTW::train_NDDTW(TimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex){
+bool DTW::computeTrainingDistances(Vector< TimeSeriesClassificationData > &classData,Vector< MatrixFloat > &distanceCache){
+    
+    const UINT numClasses = classData.getSize();
+    
+    //Smooth and offset each training example once, so they can be shared by all the DTW computations
+    Vector< Vector< MatrixFloat > > timeSeries( numClasses );
+    distanceCache.resize( numClasses );
+    for(UINT k=0; k<numClasses; k++){
+        const UINT numExamples = classData[k].getNumSamples();
+        timeSeries[k].resize( numExamples );
+        for(UINT m=0; m<numExamples; m++){
+            if( useSmoothing ) smoothData(classData[k][m].getData(),smoothingFactor,timeSeries[k][m]);
+            else timeSeries[k][m] = classData[k][m].getData();
+            
+            if( offsetUsingFirstSample ){
+                offsetTimeseries( timeSeries[k][m] );
+            }
+        }
+        distanceCache[k].resize( numExamples, numExamples );
+        distanceCache[k].setAll( 0 );
+    }
+    
+    //Each task computes one row of the upper triangle of a class distance matrix, and mirrors it into the lower triangle
+    //The tasks write to different cells, so they can run in parallel without any locking
+    Vector< UINT > rowClass;
+    Vector< UINT > rowIndex;
+    for(UINT k=0; k<numClasses; k++){
+        for(UINT m=0; m+1<timeSeries[k].getSize(); m++){
+            rowClass.push_back( k );
+            rowIndex.push_back( m );
+        }
+    }
+    
+    return ThreadPool::parallel_for( 0, rowClass.getSize(), [&](const UINT i){
+        const UINT k = rowClass[i];
+        const UINT m = rowIndex[i];
+        const UINT numExamples = timeSeries[k].getSize();
+        Vector< Float > workspace;
+        for(UINT n=m+1; n<numExamples; n++){
+            const Float dist = computeDistance( timeSeries[k][m], timeSeries[k][n], workspace );
+            distanceCache[k][m][n] = dist;
+            distanceCache[k][n][m] = dist;
+        }
+    }, 1 );
+}
+
+bool DTW::train_NDDTW(TimeSeriesClassificationData &trainingData,const MatrixFloat &distanceResults,DTWTemplate &dtwTemplate,UINT &bestIndex){
     
     UINT numExamples = trainingData.getNumSamples();
     VectorFloat results(numExamples,0.0);
-    MatrixFloat distanceResults(numExamples,numExamples);
     dtwTemplate.averageTemplateLength = 0;
     
+    if( distanceResults.getNumRows() != numExamples || distanceResults.getNumCols() != numExamples ){
+        errorLog << __GRT_LOG__ << " The size of the distance matrix does not match the number of training examples!" << std::endl;
+        return false;
+    }
+    
     for(UINT m=0; m<numExamples; m++){
-        
-        MatrixFloat templateA; //The m'th template
-        MatrixFloat templateB; //The n'th template
         dtwTemplate.averageTemplateLength += trainingData[m].getLength();
-        
-        //Smooth the data if required
-        if( useSmoothing ) smoothData(trainingData[m].getData(),smoothingFactor,templateA);
-        else templateA = trainingData[m].getData();
-            
-        if( offsetUsingFirstSample ){
-            offsetTimeseries(templateA);
-        }
-        
         for(UINT n=0; n<numExamples; n++){
             if(m!=n){
-                //Smooth the data if required
-                if( useSmoothing ) smoothData(trainingData[n].getData(),smoothingFactor,templateB);
-                else templateB = trainingData[n].getData();
-                    
-                if( offsetUsingFirstSample ){
-                    offsetTimeseries(templateB);
-                }
-                
-                //Compute the distance between the two time series
-                MatrixFloat distanceMatrix(templateA.getNumRows(),templateB.getNumRows());
-                Vector< IndexDist > warpPath;
-                Float dist = computeDistance(templateA,templateB,distanceMatrix,warpPath);
-                
-                trainingLog << "Template: " << m << " Timeseries: " << n << " Dist: " << dist << std::endl;
-                
-                //Update the results values
-                distanceResults[m][n] = dist;
-                results[m] += dist;
-            }else distanceResults[m][n] = 0; //The distance is zero because the two timeseries are the same
+                trainingLog << "Template: " << m << " Timeseries: " << n << " Dist: " << distanceResults[m][n] << std::endl;
+                results[m] += distanceResults[m][n];
+            }
         }
     }
     
@@ -402,15 +470,69 @@ bool DTW::predict_(MatrixFloat &inputTimeSeries){
     }
     
     //Make the prediction by finding the closest template
-    Float sum = 0;
-    if( distanceMatrices.size() != numTemplates ) distanceMatrices.resize( numTemplates );
-    if( warpPaths.size() != numTemplates ) warpPaths.resize( numTemplates );
+    if( computeWarpingPaths ){
+        if( distanceMatrices.size() != numTemplates ) distanceMatrices.resize( numTemplates );
+        if( warpPaths.size() != numTemplates ) warpPaths.resize( numTemplates );
+    }
+    
+    //The pruned templates do not have an exact distance, so the class likelihoods are only approximate. Pruning is therefore only used when
+    //the prediction depends on the closest template alone, i.e. when null rejection is disabled or uses the template thresholds
+    const bool pruneTemplates = useLowerBounding && !computeWarpingPaths && (!useNullRejection || rejectionMode == TEMPLATE_THRESHOLDS);
+    
+    if( pruneTemplates ){
+        
+        //Test the templates in order of their LB_Kim bound, so a close template is likely to be found first
+        lowerBounds.resize( numTemplates );
+        templateOrder.resize( numTemplates );
+        for(UINT k=0; k<numTemplates; k++){
+            lowerBounds[k] = computeLowerBound(templatesBuffer[k],*timeSeriesPtr,false);
+            templateOrder[k] = k;
+        }
+        for(UINT k=1; k<numTemplates; k++){
+            const UINT index = templateOrder[k];
+            UINT n = k;
+            while( n > 0 && lowerBounds[ templateOrder[n-1] ] > lowerBounds[index] ){
+                templateOrder[n] = templateOrder[n-1];
+                n--;
+            }
+            templateOrder[n] = index;
+        }
+        
+        //A template is pruned if its lower bound is greater than the best distance so far, the lower bound is then used as its distance
+        Float bestSoFar = INFINITY;
+        for(UINT n=0; n<numTemplates; n++){
+            const UINT k = templateOrder[n];
+            if( lowerBounds[k] > bestSoFar ){
+                classDistances[k] = lowerBounds[k];
+                continue;
+            }
+            const Float lowerBound = grt_max( lowerBounds[k], computeLowerBound(templatesBuffer[k],*timeSeriesPtr,true) );
+            if( lowerBound > bestSoFar ){
+                classDistances[k] = lowerBound;
+                continue;
+            }
+            classDistances[k] = computeDistance(templatesBuffer[k].timeSeries,*timeSeriesPtr,distanceWorkspace,NULL,bestSoFar);
+            if( classDistances[k] < bestSoFar ) bestSoFar = classDistances[k];
+        }
+        
+        return predictFromClassDistances( nullRejectionThresholds );
+    }
     
     //Test the timeSeries against all the templates in the timeSeries buffer
     for(UINT k=0; k<numTemplates; k++){
-        //Perform DTW
-        classDistances[k] = computeDistance(templatesBuffer[k].timeSeries,*timeSeriesPtr,distanceMatrices[k],warpPaths[k]);
-        
+        //Perform DTW, the full cost matrix and warping path are only computed if they have been requested
+        if( computeWarpingPaths ) classDistances[k] = computeDistance(templatesBuffer[k].timeSeries,*timeSeriesPtr,distanceMatrices[k],warpPaths[k]);
+        else classDistances[k] = computeDistance(templatesBuffer[k].timeSeries,*timeSeriesPtr,distanceWorkspace);
+    }
+    
+    return predictFromClassDistances( nullRejectionThresholds );
+}
+
+bool DTW::predictFromClassDistances(const VectorFloat &thresholds){
+    
+    //Compute the class likelihoods from the distance to each template
+    Float sum = 0;
+    for(UINT k=0; k<numTemplates; k++){
         if(classDistances[k] > 1e-8)
         {
             classLikelihoods[k] = 1.0 / classDistances[k];
@@ -450,7 +572,7 @@ bool DTW::predict_(MatrixFloat &inputTimeSeries){
         
         switch( rejectionMode ){
             case TEMPLATE_THRESHOLDS:
-            if( bestDistance <= nullRejectionThresholds[ closestTemplateIndex ] ) predictedClassLabel = templatesBuffer[ closestTemplateIndex ].classLabel;
+            if( bestDistance <= thresholds[ closestTemplateIndex ] ) predictedClassLabel = templatesBuffer[ closestTemplateIndex ].classLabel;
             else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
                 break;
             case CLASS_LIKELIHOODS:
@@ -458,7 +580,7 @@ bool DTW::predict_(MatrixFloat &inputTimeSeries){
             else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
                 break;
             case THRESHOLDS_AND_LIKELIHOODS:
-            if( bestDistance <= nullRejectionThresholds[ closestTemplateIndex ] && maxLikelihood >= nullRejectionLikelihoodThreshold)
+            if( bestDistance <= thresholds[ closestTemplateIndex ] && maxLikelihood >= nullRejectionLikelihoodThreshold)
             predictedClassLabel = templatesBuffer[ closestTemplateIndex ].classLabel;
             else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
                 break;
@@ -489,6 +611,11 @@ bool DTW::predict_( VectorFloat &inputVector ){
         return false;
     }
     
+    //If the streaming mode can be used then update the subsequence DTW state for each template, rather than rerunning DTW over the buffer
+    if( getStreamingModeActive() ){
+        return predictStreaming( inputVector );
+    }
+    
     //Add the new input to the circular buffer
     continuousInputDataBuffer.push_back( inputVector );
     
@@ -516,6 +643,7 @@ bool DTW::reset(){
     continuousInputDataBuffer.clear();
     if( trained ){
         continuousInputDataBuffer.resize(averageTemplateLength,VectorFloat(numInputDimensions,0));
+        resetStreamingStates();
         recomputeNullRejectionThresholds();
     }
     return true;
@@ -531,6 +659,10 @@ bool DTW::clear(){
     distanceMatrices.clear();
     warpPaths.clear();
     continuousInputDataBuffer.clear();
+    streamingStates.clear();
+    streamingMatchStart.clear();
+    streamingSampleCounter = 0;
+    streamingNullRejectionThresholds.clear();
     
     return true;
 }
@@ -547,6 +679,12 @@ bool DTW::recomputeNullRejectionThresholds(){
         nullRejectionThresholds[k] = templatesBuffer[k].trainingMu + (templatesBuffer[k].trainingSigma * nullRejectionCoeff);
     }
     
+    //The streaming mode uses the subsequence distances, so it has its own thresholds
+    streamingNullRejectionThresholds.resize(numTemplates);
+    for(UINT k=0; k<numTemplates; k++){
+        streamingNullRejectionThresholds[k] = templatesBuffer[k].streamingMu + (templatesBuffer[k].streamingSigma * nullRejectionCoeff);
+    }
+    
     return true;
 }
 
@@ -559,6 +697,7 @@ bool DTW::setModels( Vector< DTWTemplate > newTemplates ){
         for(UINT i=0; i<templatesBuffer.size(); i++){
             classLabels[i] = templatesBuffer[i].classLabel;
         }
+        if( trained ) computeEnvelopes();
         return true;
     }
     return false;
@@ -566,84 +705,224 @@ bool DTW::setModels( Vector< DTWTemplate > newTemplates ){
 
 ////////////////////////// computeDistance ///////////////////////////////////////////
 
-Float DTW::computeDistance(MatrixFloat &timeSeriesA,MatrixFloat &timeSeriesB,MatrixFloat &distanceMatrix,Vector< IndexDist > &warpPath){
-    
+//The local distance functions used to compare one sample in timeseries A with one sample in timeseries B
+struct DTWAbsoluteDistance{
+    DTWAbsoluteDistance(const UINT C):C(C){}
+    inline Float operator()(const Float *a,const Float *b) const{
+        Float dist = 0;
+        for(UINT k=0; k<C; k++) dist += fabs( a[k]-b[k] );
+        return dist;
+    }
+    const UINT C;
+};
+
+struct DTWEuclideanDistance{
+    DTWEuclideanDistance(const UINT C):C(C){}
+    inline Float operator()(const Float *a,const Float *b) const{
+        Float dist = 0;
+        for(UINT k=0; k<C; k++) dist += SQR( a[k]-b[k] );
+        return sqrt( dist );
+    }
+    const UINT C;
+};
+
+struct DTWNormAbsoluteDistance{
+    DTWNormAbsoluteDistance(const UINT C,const UINT N):C(C),N(Float(N)){}
+    inline Float operator()(const Float *a,const Float *b) const{
+        Float dist = 0;
+        for(UINT k=0; k<C; k++) dist += fabs( a[k]-b[k] );
+        return dist / N;
+    }
+    const UINT C;
+    const Float N;
+};
+
+/*
+ The Sakoe-Chiba band used to constrain the warping path between a timeseries with M samples (the rows of the cost matrix)
+ and a timeseries with N samples (the columns). Row i can only be matched with the columns [lo hi] around slope*i, the window
+ is widened if needed to make sure the band is connected when M and N differ.
+*/
+struct DTWWarpingWindow{
+    DTWWarpingWindow(const int M,const int N,const bool constrainWarpingPath,const Float radius):N(N){
+        useBand = constrainWarpingPath && M > 1 && N > 1;
+        slope = useBand ? (N-1)/Float(M-1) : 0;
+        r = 0;
+        if( useBand ){
+            r = ceil( grt_min(M,N)*radius );
+            r = grt_max( r, ceil( slope/2.0 ) );
+            r = grt_max( r, 1.0 );
+        }
+    }
+    inline void getColumns(const int i,int &lo,int &hi) const{
+        lo = 0;
+        hi = N-1;
+        if( useBand ){
+            const Float center = slope * i;
+            lo = grt_max( 0, (int)ceil( center - r ) );
+            hi = grt_min( N-1, (int)floor( center + r ) );
+        }
+    }
+    const int N;
+    bool useBand;
+    Float slope;
+    Float r;
+};
+
+/*
+ Fills the DTW cost matrix bottom-up, one row at a time, keeping only the current and previous rows in the workspace.
+ For each cell we track the accumulated cost D, the sum of the accumulated costs along the best path S, and the length of
+ the best path L, which gives the same normalized distance (S/L) as backtracking through the full cost matrix.
+ If the warping path is constrained then only the cells inside the Sakoe-Chiba band are visited, so the cost is O(M*r).
+ If costMatrix is not NULL then the accumulated costs will also be stored in the full [M N] matrix so the warping path can be recovered.
+ 
+ If abandonThreshold is finite then the computation is abandoned as soon as the distance is known to be greater than the threshold.
+ The best path leaves row i at some cell j, and each of the remaining (at least M-1-i) cells on the path adds at least D[j] to S, so
+ the final distance is at least min_j( S[j] + (M-1-i)*D[j] ) / (M+N-1). This bound is returned if the computation is abandoned.
+*/
+template< class LocalDistance >
+static Float dtwComputeBandedDistance(const MatrixFloat &timeSeriesA,const MatrixFloat &timeSeriesB,const bool constrainWarpingPath,const Float radius,const LocalDistance &localDistance,Vector< Float > &workspace,MatrixFloat *costMatrix,const Float abandonThreshold){
+
     const int M = timeSeriesA.getNumRows();
     const int N = timeSeriesB.getNumRows();
-    const int C = timeSeriesA.getNumCols();
-    int i,j,k,index = 0;
-    Float totalDist,v,normFactor = 0.;
-    
-    warpPath.clear();
-    if( int(distanceMatrix.getNumRows()) != M || int(distanceMatrix.getNumCols()) != N ){
-        distanceMatrix.resize(M, N);
+    const Float inf = INFINITY;
+    const DTWWarpingWindow window( M, N, constrainWarpingPath, radius );
+    const bool useAbandoning = !grt_isinf( abandonThreshold ) && costMatrix == NULL;
+    const Float maxPathLength = M + N - 1;
+
+    //The workspace stores two rows of D, S and L
+    if( workspace.getSize() < (UINT)(6*N) ) workspace.resize( 6*N );
+    Float *rows[2][3];
+    for(int k=0; k<2; k++){
+        for(int n=0; n<3; n++){
+            rows[k][n] = &workspace[ (k*3+n)*N ];
+        }
     }
-    
-    switch (distanceMethod) {
-        case (ABSOLUTE_DIST):
-        for(i=0; i<M; i++){
-            for(j=0; j<N; j++){
-                distanceMatrix[i][j] = 0.0;
-                for(k=0; k< C; k++){
-                    distanceMatrix[i][j] += fabs(timeSeriesA[i][k]-timeSeriesB[j][k]);
-                }
+    for(int j=0; j<N; j++){
+        rows[0][0][j] = rows[1][0][j] = inf;
+    }
+
+    if( costMatrix != NULL ){
+        if( int(costMatrix->getNumRows()) != M || int(costMatrix->getNumCols()) != N ) costMatrix->resize(M, N);
+        costMatrix->setAll( inf );
+    }
+
+    int lastLo[2] = {0,-1};
+    int lastHi[2] = {-1,-1};
+    for(int i=0; i<M; i++){
+        Float *D = rows[i%2][0];  Float *S = rows[i%2][1];  Float *L = rows[i%2][2];
+        const Float *prevD = rows[(i+1)%2][0]; const Float *prevS = rows[(i+1)%2][1]; const Float *prevL = rows[(i+1)%2][2];
+
+        //Get the columns inside the warping window for this row
+        int lo = 0;
+        int hi = N-1;
+        window.getColumns( i, lo, hi );
+
+        //Reset the cells that were used two rows ago so that anything outside this window is unreachable
+        for(int j=lastLo[i%2]; j<=lastHi[i%2]; j++) D[j] = inf;
+        lastLo[i%2] = lo;
+        lastHi[i%2] = hi;
+
+        const Float *a = timeSeriesA[i];
+        for(int j=lo; j<=hi; j++){
+            const Float cost = localDistance( a, timeSeriesB[j] );
+
+            //Find the best predecessor, ties are resolved in the order: diagonal, up, left
+            Float minValue = inf;
+            Float pathSum = 0;
+            Float pathLength = 0;
+            if( i == 0 && j == 0 ){
+                minValue = 0;
+            }else if( i == 0 ){
+                minValue = D[j-1]; pathSum = S[j-1]; pathLength = L[j-1];
+            }else if( j == 0 ){
+                minValue = prevD[j]; pathSum = prevS[j]; pathLength = prevL[j];
+            }else{
+                if( prevD[j-1] < minValue ){ minValue = prevD[j-1]; pathSum = prevS[j-1]; pathLength = prevL[j-1]; }
+                if( prevD[j] < minValue ){ minValue = prevD[j]; pathSum = prevS[j]; pathLength = prevL[j]; }
+                if( D[j-1] < minValue ){ minValue = D[j-1]; pathSum = S[j-1]; pathLength = L[j-1]; }
             }
+
+            D[j] = cost + minValue;
+            S[j] = D[j] + pathSum;
+            L[j] = pathLength + 1;
         }
-        break;
-        case (EUCLIDEAN_DIST):
-        //Calculate Euclidean Distance for all possible values
-        for(i=0; i<M; i++){
-            for(j=0; j<N; j++){
-                distanceMatrix[i][j] = 0.0;
-                for(k=0; k< C; k++){
-                    distanceMatrix[i][j] += SQR( timeSeriesA[i][k]-timeSeriesB[j][k] );
-                }
-                distanceMatrix[i][j] = sqrt( distanceMatrix[i][j] );
+
+        if( costMatrix != NULL ){
+            Float *c = (*costMatrix)[i];
+            for(int j=lo; j<=hi; j++) c[j] = D[j];
+        }
+        
+        if( useAbandoning && i < M-1 ){
+            Float bound = inf;
+            for(int j=lo; j<=hi; j++){
+                const Float value = S[j] + (M-1-i)*D[j];
+                if( value < bound ) bound = value;
             }
+            bound /= maxPathLength;
+            if( bound > abandonThreshold ) return bound;
         }
+    }
+
+    const int last = (M-1)%2;
+    if( grt_isinf( rows[last][0][N-1] ) || grt_isnan( rows[last][0][N-1] ) ) return inf;
+    return rows[last][1][N-1] / rows[last][2][N-1];
+}
+
+Float DTW::computeDistance(const MatrixFloat &timeSeriesA,const MatrixFloat &timeSeriesB,Vector< Float > &workspace,MatrixFloat *costMatrix,const Float abandonThreshold) const{
+
+    const UINT M = timeSeriesA.getNumRows();
+    const UINT N = timeSeriesB.getNumRows();
+    const UINT C = timeSeriesA.getNumCols();
+
+    if( M == 0 || N == 0 || C != timeSeriesB.getNumCols() ){
+        errorLog << __GRT_LOG__ << " Invalid timeseries sizes, A: [" << M << " " << C << "] B: [" << N << " " << timeSeriesB.getNumCols() << "]" << std::endl;
+        return INFINITY;
+    }
+
+    Float distance = 0;
+    switch (distanceMethod) {
+        case (ABSOLUTE_DIST):
+            distance = dtwComputeBandedDistance( timeSeriesA, timeSeriesB, constrainWarpingPath, radius, DTWAbsoluteDistance(C), workspace, costMatrix, abandonThreshold );
+        break;
+        case (EUCLIDEAN_DIST):
+            distance = dtwComputeBandedDistance( timeSeriesA, timeSeriesB, constrainWarpingPath, radius, DTWEuclideanDistance(C), workspace, costMatrix, abandonThreshold );
         break;
         case (NORM_ABSOLUTE_DIST):
-        for(i=0; i<M; i++){
-            for(j=0; j<N; j++){
-                distanceMatrix[i][j] = 0.0;
-                for(k=0; k< C; k++){
-                    distanceMatrix[i][j] += fabs(timeSeriesA[i][k]-timeSeriesB[j][k]);
-                }
-                distanceMatrix[i][j]/=N;
-            }
-        }
+            distance = dtwComputeBandedDistance( timeSeriesA, timeSeriesB, constrainWarpingPath, radius, DTWNormAbsoluteDistance(C,N), workspace, costMatrix, abandonThreshold );
         break;
         default:
-        errorLog<< __GRT_LOG__ << " Unknown distance method: "<<distanceMethod<< std::endl;
-        return -1;
+            errorLog<< __GRT_LOG__ << " Unknown distance method: "<<distanceMethod<< std::endl;
+            return -1;
         break;
     }
-    
-    //Run the recursive search function to build the cost matrix
-    Float distance = sqrt( d(M-1,N-1,distanceMatrix,M,N) );
-    
+
     if( grt_isinf(distance) || grt_isnan(distance) ){
         warningLog << __GRT_LOG__ << " Distance Matrix Values are INF!" << std::endl;
         return INFINITY;
     }
+
+    return distance;
+}
+
+Float DTW::computeDistance(const MatrixFloat &timeSeriesA,const MatrixFloat &timeSeriesB,MatrixFloat &distanceMatrix,Vector< IndexDist > &warpPath){
     
-    //cout << "DIST: " << distance << std::endl;
+    warpPath.clear();
     
-    //The distMatrix values are negative so make them positive
-    for(i=0; i<M; i++){
-        for(j=0; j<N; j++){
-            distanceMatrix[i][j] = fabs( distanceMatrix[i][j] );
-        }
+    //Compute the distance, storing the accumulated cost matrix so the warping path can be found
+    Float distance = computeDistance( timeSeriesA, timeSeriesB, distanceWorkspace, &distanceMatrix );
+    
+    if( grt_isinf(distance) || distance < 0 ){
+        return distance;
     }
     
     //Now Create the Warp Path through the cost matrix, starting at the end
-    i=M-1;
-    j=N-1;
-    totalDist = distanceMatrix[i][j];
+    int i = timeSeriesA.getNumRows()-1;
+    int j = timeSeriesB.getNumRows()-1;
+    int index = 0;
+    Float v = 0;
     warpPath.push_back( IndexDist(i,j,distanceMatrix[i][j]) );
     
     //Use dynamic programming to navigate through the cost matrix until [0][0] has been reached
-    normFactor = 1;
     while( true ) {
         if( i==0 && j==0 ) break;
         if( i==0 ){ j--; }
@@ -653,9 +932,9 @@ Float DTW::computeDistance(MatrixFloat &timeSeriesA,MatrixFloat &timeSeriesB,Mat
                 //Find the minimum cell to move to
                 v = grt_numeric_limits< Float >::max();
                 index = 0;
+                if( distanceMatrix[i-1][j-1] <= v ){ v = distanceMatrix[i-1][j-1]; index = 3; }
                 if( distanceMatrix[i-1][j] < v ){ v = distanceMatrix[i-1][j]; index = 1; }
                 if( distanceMatrix[i][j-1] < v ){ v = distanceMatrix[i][j-1]; index = 2; }
-                if( distanceMatrix[i-1][j-1] <= v ){ index = 3; }
                 switch(index){
                     case(1):
                         i--;
@@ -674,114 +953,387 @@ Float DTW::computeDistance(MatrixFloat &timeSeriesA,MatrixFloat &timeSeriesB,Mat
                 }
             }
         }
-        normFactor++;
-        totalDist += distanceMatrix[i][j];
         warpPath.push_back( IndexDist(i,j,distanceMatrix[i][j]) );
     }
     
-    return totalDist/normFactor;
+    return distance;
 }
 
-Float DTW::d(int m,int n,MatrixFloat &distanceMatrix,const int M,const int N){
-    
-    Float dist = 0;
-    //The following is based on Matlab code by Eamonn Keogh and Michael Pazzani
-    
-    //If this cell is NAN then it has already been flagged as unreachable
-    if( grt_isnan( distanceMatrix[m][n] ) ){
-        return NAN;
+////////////////////////// Lower bounding ///////////////////////////////////////////
+
+/*
+ Computes the LB_Kim lower bound of the distance between timeseries A and B, using only the first, second and last cells of the path.
+ The cost of the first cell is added to every accumulated cost along the path, the cost of the second cell is added to all but one
+ of them, and the cost of the last cell is added once. As the path length L is between max(M,N) and M+N-1 this gives:
+ S/L >= c(0,0) + min( c(0,1), c(1,0), c(1,1) ) * (max(M,N)-1)/max(M,N) + c(M-1,N-1)/(M+N-1)
+*/
+template< class LocalDistance >
+static Float dtwComputeLBKim(const MatrixFloat &timeSeriesA,const MatrixFloat &timeSeriesB,const LocalDistance &localDistance){
+
+    const UINT M = timeSeriesA.getNumRows();
+    const UINT N = timeSeriesB.getNumRows();
+
+    Float bound = localDistance( timeSeriesA[0], timeSeriesB[0] );
+    if( M == 1 && N == 1 ) return bound;
+
+    Float secondCost = INFINITY;
+    if( N > 1 ) secondCost = grt_min( secondCost, localDistance( timeSeriesA[0], timeSeriesB[1] ) );
+    if( M > 1 ) secondCost = grt_min( secondCost, localDistance( timeSeriesA[1], timeSeriesB[0] ) );
+    if( M > 1 && N > 1 ) secondCost = grt_min( secondCost, localDistance( timeSeriesA[1], timeSeriesB[1] ) );
+    const Float minPathLength = grt_max( M, N );
+    bound += secondCost * (minPathLength-1) / minPathLength;
+
+    //The last cell is only distinct from the second cell if the path has more than two cells
+    if( M > 2 || N > 2 ) bound += localDistance( timeSeriesA[M-1], timeSeriesB[N-1] ) / Float(M+N-1);
+
+    return bound;
+}
+
+/*
+ Computes the LB_Keogh lower bound of the distance between timeseries A (with M samples) and B, using the envelope of A.
+ The envelope gives the range of the samples in A that are inside the warping window of each sample j in B, so any cell in
+ column j costs at least lb_j, the distance from B[j] to the closest point inside the envelope. The path visits every column,
+ and the first visit to column j is followed by at least N-1-j more cells, so this gives: S/L >= sum_j( lb_j*(N-j) ) / (M+N-1)
+*/
+template< class LocalDistance >
+static Float dtwComputeLBKeogh(const MatrixFloat &upperEnvelope,const MatrixFloat &lowerEnvelope,const UINT M,const MatrixFloat &timeSeriesB,const LocalDistance &localDistance,Vector< Float > &workspace){
+
+    const UINT N = timeSeriesB.getNumRows();
+    const UINT C = timeSeriesB.getNumCols();
+
+    if( workspace.getSize() < C ) workspace.resize( C );
+    Float *closest = &workspace[0];
+
+    Float bound = 0;
+    for(UINT j=0; j<N; j++){
+        const Float *b = timeSeriesB[j];
+        const Float *upper = upperEnvelope[j];
+        const Float *lower = lowerEnvelope[j];
+        for(UINT k=0; k<C; k++){
+            closest[k] = b[k] > upper[k] ? upper[k] : (b[k] < lower[k] ? lower[k] : b[k]);
+        }
+        bound += localDistance( closest, b ) * (N-j);
     }
-    
-    if( constrainWarpingPath ){
-        Float r = ceil( grt_min(M,N)*radius );
-        //Test to see if the current cell is outside of the warping window
-        if( fabs( n-((N-1)/((M-1)/Float(m))) ) > r ){
-            if( n-((N-1)/((M-1)/Float(m))) > 0 ){
-                for(int i=0; i<m; i++){
-                    for(int j=n; j<N; j++){
-                        distanceMatrix[i][j] = NAN;
-                    }
-                }
+
+    return bound / Float(M+N-1);
+}
+
+bool DTW::computeEnvelope(const MatrixFloat &timeSeries,const UINT inputLength,MatrixFloat &upperEnvelope,MatrixFloat &lowerEnvelope) const{
+
+    const int M = timeSeries.getNumRows();
+    const int N = inputLength;
+    const UINT C = timeSeries.getNumCols();
+
+    if( M == 0 || N == 0 ){
+        upperEnvelope.clear();
+        lowerEnvelope.clear();
+        return false;
+    }
+
+    upperEnvelope.resize( N, C );
+    lowerEnvelope.resize( N, C );
+
+    //Get the columns inside the warping window for each row, these only move forward as the row increases
+    const DTWWarpingWindow window( M, N, constrainWarpingPath, radius );
+    Vector< int > lo( M );
+    Vector< int > hi( M );
+    for(int i=0; i<M; i++) window.getColumns( i, lo[i], hi[i] );
+
+    //Column j is inside the window of the rows [first next), so the min and max of each column can be found with a monotonic queue in O(M+N)
+    std::deque< int > maxQueue;
+    std::deque< int > minQueue;
+    for(UINT k=0; k<C; k++){
+        maxQueue.clear();
+        minQueue.clear();
+        Float maxValue = timeSeries[0][k];
+        Float minValue = timeSeries[0][k];
+        for(int i=1; i<M; i++){
+            maxValue = grt_max( maxValue, timeSeries[i][k] );
+            minValue = grt_min( minValue, timeSeries[i][k] );
+        }
+        int first = 0;
+        int next = 0;
+        for(int j=0; j<N; j++){
+            while( next < M && lo[next] <= j ){
+                while( !maxQueue.empty() && timeSeries[ maxQueue.back() ][k] <= timeSeries[next][k] ) maxQueue.pop_back();
+                while( !minQueue.empty() && timeSeries[ minQueue.back() ][k] >= timeSeries[next][k] ) minQueue.pop_back();
+                maxQueue.push_back( next );
+                minQueue.push_back( next );
+                next++;
+            }
+            while( first < next && hi[first] < j ) first++;
+            while( !maxQueue.empty() && maxQueue.front() < first ) maxQueue.pop_front();
+            while( !minQueue.empty() && minQueue.front() < first ) minQueue.pop_front();
+
+            if( !maxQueue.empty() ){
+                upperEnvelope[j][k] = timeSeries[ maxQueue.front() ][k];
+                lowerEnvelope[j][k] = timeSeries[ minQueue.front() ][k];
             }else{
-                for(int i=m; i<M; i++){
-                    for(int j=0; j<n; j++){
-                        distanceMatrix[i][j] = NAN;
-                    }
-                }
+                //No path can reach this column, so any envelope is valid, the full range of the timeseries is used
+                upperEnvelope[j][k] = maxValue;
+                lowerEnvelope[j][k] = minValue;
             }
-            return NAN;
         }
     }
+
+    return true;
+}
+
+bool DTW::computeEnvelopes(){
+
+    //The envelopes are computed for the length of the realtime input buffer, after any smoothing
+    const UINT inputLength = getProcessedInputLength( averageTemplateLength );
+
+    for(UINT k=0; k<templatesBuffer.getSize(); k++){
+        DTWTemplate &dtwTemplate = templatesBuffer[k];
+        if( !computeEnvelope( dtwTemplate.timeSeries, inputLength, dtwTemplate.upperEnvelope, dtwTemplate.lowerEnvelope ) ){
+            warningLog << __GRT_LOG__ << " Failed to compute the envelope for template " << k << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Float DTW::computeLowerBound(const DTWTemplate &dtwTemplate,const MatrixFloat &timeSeries,const bool useEnvelope){
+
+    const MatrixFloat &templateTimeSeries = dtwTemplate.timeSeries;
+    const UINT M = templateTimeSeries.getNumRows();
+    const UINT N = timeSeries.getNumRows();
+    const UINT C = timeSeries.getNumCols();
+
+    if( M == 0 || N == 0 || C != templateTimeSeries.getNumCols() ) return 0;
+
+    //The saved envelope is computed for the realtime input length, if the input has a different length then a temporary envelope is computed
+    const MatrixFloat *upperEnvelope = &dtwTemplate.upperEnvelope;
+    const MatrixFloat *lowerEnvelope = &dtwTemplate.lowerEnvelope;
+    if( useEnvelope && (upperEnvelope->getNumRows() != N || upperEnvelope->getNumCols() != C || lowerEnvelope->getNumRows() != N || lowerEnvelope->getNumCols() != C) ){
+        if( !computeEnvelope( templateTimeSeries, N, upperEnvelopeBuffer, lowerEnvelopeBuffer ) ) return 0;
+        upperEnvelope = &upperEnvelopeBuffer;
+        lowerEnvelope = &lowerEnvelopeBuffer;
+    }
+
+    switch (distanceMethod) {
+        case (ABSOLUTE_DIST):
+            if( useEnvelope ) return dtwComputeLBKeogh( *upperEnvelope, *lowerEnvelope, M, timeSeries, DTWAbsoluteDistance(C), distanceWorkspace );
+            return dtwComputeLBKim( templateTimeSeries, timeSeries, DTWAbsoluteDistance(C) );
+        break;
+        case (EUCLIDEAN_DIST):
+            if( useEnvelope ) return dtwComputeLBKeogh( *upperEnvelope, *lowerEnvelope, M, timeSeries, DTWEuclideanDistance(C), distanceWorkspace );
+            return dtwComputeLBKim( templateTimeSeries, timeSeries, DTWEuclideanDistance(C) );
+        break;
+        case (NORM_ABSOLUTE_DIST):
+            if( useEnvelope ) return dtwComputeLBKeogh( *upperEnvelope, *lowerEnvelope, M, timeSeries, DTWNormAbsoluteDistance(C,N), distanceWorkspace );
+            return dtwComputeLBKim( templateTimeSeries, timeSeries, DTWNormAbsoluteDistance(C,N) );
+        break;
+        default:
+        break;
+    }
+
+    return 0;
+}
+
+UINT DTW::getProcessedInputLength(const UINT inputLength) const{
+    //Smoothing reduces the length of the timeseries by the smoothing factor, with any remaining samples averaged into one extra sample
+    if( useSmoothing && smoothingFactor > 1 && inputLength >= smoothingFactor ){
+        return (UINT)ceil( inputLength / Float(smoothingFactor) );
+    }
+    return inputLength;
+}
+
+////////////////////////// Streaming subsequence DTW ///////////////////////////////////////////
+
+/*
+ Updates the subsequence DTW state for one template with a new input sample, this is based on the SPRING algorithm:
+ Sakurai, Y., Faloutsos, C., & Yamamuro, M. (2007). Stream monitoring under the time warping distance.
+ 
+ The state stores one column of the cost matrix (one cell per template sample). The first template sample can be matched
+ against any input sample at zero cost, so the best path through the column gives the best matching subsequence that ends
+ at the current input sample. The start of that subsequence is carried along the path. Each update is O(N), where N is the
+ length of the template.
+*/
+template< class LocalDistance >
+static void dtwUpdateStreamingState(const MatrixFloat &timeSeries,const Float *x,const UINT sampleIndex,const LocalDistance &localDistance,DTWStreamingState &state){
+
+    const UINT N = timeSeries.getNumRows();
+    const Float inf = INFINITY;
+
+    Float *D = &state.cost[0];
+    Float *S = &state.pathSum[0];
+    Float *L = &state.pathLength[0];
+    UINT *start = &state.startIndex[0];
+
+    //Track the values from the previous input sample that are about to be overwritten (the diagonal predecessor)
+    Float diagD = inf, diagS = 0, diagL = 0;
+    UINT diagStart = sampleIndex;
+
+    for(UINT i=0; i<N; i++){
+        const Float cost = localDistance( timeSeries[i], x );
+        const Float leftD = D[i], leftS = S[i], leftL = L[i];
+        const UINT leftStart = start[i];
+
+        if( i == 0 ){
+            //A new subsequence can start at any input sample, which is always at least as good as extending an older match
+            D[i] = cost;
+            S[i] = cost;
+            L[i] = 1;
+            start[i] = sampleIndex;
+        }else{
+            //Find the best predecessor, ties are resolved in the order: diagonal, up, left
+            Float minValue = inf, pathSum = 0, pathLength = 0;
+            UINT pathStart = sampleIndex;
+            if( diagD < minValue ){ minValue = diagD; pathSum = diagS; pathLength = diagL; pathStart = diagStart; }
+            if( D[i-1] < minValue ){ minValue = D[i-1]; pathSum = S[i-1]; pathLength = L[i-1]; pathStart = start[i-1]; }
+            if( leftD < minValue ){ minValue = leftD; pathSum = leftS; pathLength = leftL; pathStart = leftStart; }
+            D[i] = cost + minValue;
+            S[i] = D[i] + pathSum;
+            L[i] = pathLength + 1;
+            start[i] = pathStart;
+        }
+
+        diagD = leftD; diagS = leftS; diagL = leftL; diagStart = leftStart;
+    }
+}
+
+static void dtwResetStreamingState(const UINT N,DTWStreamingState &state){
+    state.cost.resize( N );
+    state.pathSum.resize( N );
+    state.pathLength.resize( N );
+    state.startIndex.resize( N );
+    std::fill( state.cost.begin(), state.cost.end(), INFINITY );
+    std::fill( state.pathSum.begin(), state.pathSum.end(), 0 );
+    std::fill( state.pathLength.begin(), state.pathLength.end(), 0 );
+    std::fill( state.startIndex.begin(), state.startIndex.end(), 0 );
+}
+
+bool DTW::predictStreaming(const VectorFloat &inputVector){
+    
+    //Scale the input if needed, the streaming mode does not use any of the timeseries normalization options
+    const VectorFloat *x = &inputVector;
+    if( useScaling ){
+        if( streamingInput.getSize() != numInputDimensions ) streamingInput.resize( numInputDimensions );
+        for(UINT j=0; j<numInputDimensions; j++){
+            streamingInput[j] = grt_scale(inputVector[j],ranges[j].minValue,ranges[j].maxValue,0.0,1.0);
+        }
+        x = &streamingInput;
+    }
     
-    //If this cell contains a negative value then it has already been searched
-    //The cost is therefore the absolute value of the negative value so return it
-    if( std::signbit(distanceMatrix[m][n]) ){
-        dist = fabs( distanceMatrix[m][n] );
-        return dist;
+    if( streamingStates.getSize() != numTemplates ) resetStreamingStates();
+    
+    //The normalized absolute distance uses the length of the input buffer, to match the buffered prediction
+    const UINT normLength = grt_max( averageTemplateLength, 1 );
+    
+    for(UINT k=0; k<numTemplates; k++){
+        switch( distanceMethod ){
+            case (ABSOLUTE_DIST):
+                dtwUpdateStreamingState( templatesBuffer[k].timeSeries, &(*x)[0], streamingSampleCounter, DTWAbsoluteDistance(numInputDimensions), streamingStates[k] );
+            break;
+            case (EUCLIDEAN_DIST):
+                dtwUpdateStreamingState( templatesBuffer[k].timeSeries, &(*x)[0], streamingSampleCounter, DTWEuclideanDistance(numInputDimensions), streamingStates[k] );
+            break;
+            case (NORM_ABSOLUTE_DIST):
+                dtwUpdateStreamingState( templatesBuffer[k].timeSeries, &(*x)[0], streamingSampleCounter, DTWNormAbsoluteDistance(numInputDimensions,normLength), streamingStates[k] );
+            break;
+            default:
+                errorLog << __GRT_LOG__ << " Unknown distance method: " << distanceMethod << std::endl;
+                return false;
+            break;
+        }
     }
+    streamingSampleCounter++;
     
-    //Case 1: A warping path has reached the end
-    //Return the contribution of distance
-    //Negate the value, to record the fact that this cell has been visited
-    //End of recursion
-    if( m == 0 && n == 0 ){
-        dist = distanceMatrix[0][0];
-        distanceMatrix[0][0] = -distanceMatrix[0][0];
-        return dist;
+    if( streamingSampleCounter < averageTemplateLength ){
+        //We haven't got enough samples yet so can't do the prediction
+        return true;
     }
     
-    //Case 2: we are somewhere in the top row of the matrix
-    //Only need to consider moving left
-    if( m == 0 ){
-        Float contribDist = d(m,n-1,distanceMatrix,M,N);
+    //The distance for each template is given by the best matching subsequence that ends at this sample
+    for(UINT k=0; k<numTemplates; k++){
+        const DTWStreamingState &state = streamingStates[k];
+        const UINT last = state.cost.getSize()-1;
+        classDistances[k] = state.pathSum[last] / state.pathLength[last];
+        streamingMatchStart[k] = state.startIndex[last];
+    }
+    
+    return predictFromClassDistances( streamingNullRejectionThresholds );
+}
+
+bool DTW::computeStreamingThresholds(Vector< TimeSeriesClassificationData > &classData,const Vector< UINT > &templateIndexs){
+    
+    //The threshold for each template is computed in the same way as the full DTW threshold in train_NDDTW, using the subsequence distance
+    //that the streaming mode would give at the end of each of the other training examples of the class
+    for(UINT k=0; k<numTemplates; k++){
+        const UINT numExamples = classData[k].getNumSamples();
+        DTWTemplate &dtwTemplate = templatesBuffer[k];
+        dtwTemplate.streamingMu = 0.0;
+        dtwTemplate.streamingSigma = 0.0;
         
-        dist = distanceMatrix[m][n] + contribDist;
+        if( numExamples <= 2 ) continue;
         
-        distanceMatrix[m][n] = -dist;
-        return dist;
-    }else{
-        //Case 3: we are somewhere in the left column of the matrix
-        //Only need to consider moving down
-        if ( n == 0) {
-            Float contribDist = d(m-1,n,distanceMatrix,M,N);
-            
-            dist = distanceMatrix[m][n] + contribDist;
-            
-            distanceMatrix[m][n] = -dist;
-            return dist;
-        }else{
-            //Case 4: We are somewhere away from the edges so consider moving in the three main directions
-            Float contribDist1 = d(m-1,n-1,distanceMatrix,M,N);
-            Float contribDist2 = d(m-1,n,distanceMatrix,M,N);
-            Float contribDist3 = d(m,n-1,distanceMatrix,M,N);
-            Float minValue = grt_numeric_limits< Float >::max();
-            int index = 0;
-            if( contribDist1 < minValue ){ minValue = contribDist1; index = 1; }
-            if( contribDist2 < minValue ){ minValue = contribDist2; index = 2; }
-            if( contribDist3 < minValue ){ minValue = contribDist3; index = 3; }
-            
-            switch ( index ) {
-                case 1:
-                dist = distanceMatrix[m][n] + minValue;
-                break;
-                case 2:
-                dist = distanceMatrix[m][n] + minValue;
-                break;
-                case 3:
-                dist = distanceMatrix[m][n] + minValue;
-                break;
-                
-                default:
-                break;
-            }
-            
-            distanceMatrix[m][n] = -dist; //Negate the value to record that it has been visited
-            return dist;
+        VectorFloat distances( numExamples, 0.0 );
+        for(UINT n=0; n<numExamples; n++){
+            if( n == templateIndexs[k] ) continue;
+            distances[n] = computeStreamingDistance( dtwTemplate.timeSeries, classData[k][n].getData() );
+            dtwTemplate.streamingMu += distances[n];
+        }
+        dtwTemplate.streamingMu /= Float(numExamples-1);
+        
+        for(UINT n=0; n<numExamples; n++){
+            if( n == templateIndexs[k] ) continue;
+            dtwTemplate.streamingSigma += SQR( distances[n] - dtwTemplate.streamingMu );
         }
+        dtwTemplate.streamingSigma = sqrt( dtwTemplate.streamingSigma / Float(numExamples-2) );
     }
     
-    //This should not happen!
-    return dist;
+    return true;
+}
+
+Float DTW::computeStreamingDistance(const MatrixFloat &templateTimeSeries,const MatrixFloat &timeSeries) const{
+    
+    const UINT N = templateTimeSeries.getNumRows();
+    const UINT M = timeSeries.getNumRows();
+    if( N == 0 || M == 0 ) return 0;
+    
+    DTWStreamingState state;
+    dtwResetStreamingState( N, state );
+    
+    const UINT normLength = grt_max( averageTemplateLength, 1 );
+    for(UINT t=0; t<M; t++){
+        switch( distanceMethod ){
+            case (ABSOLUTE_DIST):
+                dtwUpdateStreamingState( templateTimeSeries, timeSeries[t], t, DTWAbsoluteDistance(numInputDimensions), state );
+            break;
+            case (EUCLIDEAN_DIST):
+                dtwUpdateStreamingState( templateTimeSeries, timeSeries[t], t, DTWEuclideanDistance(numInputDimensions), state );
+            break;
+            case (NORM_ABSOLUTE_DIST):
+                dtwUpdateStreamingState( templateTimeSeries, timeSeries[t], t, DTWNormAbsoluteDistance(numInputDimensions,normLength), state );
+            break;
+            default:
+                return 0;
+            break;
+        }
+    }
+    
+    return state.pathSum[N-1] / state.pathLength[N-1];
+}
+
+bool DTW::resetStreamingStates(){
+    
+    streamingSampleCounter = 0;
+    streamingStates.resize( numTemplates );
+    streamingMatchStart.resize( numTemplates );
+    
+    for(UINT k=0; k<numTemplates; k++){
+        dtwResetStreamingState( templatesBuffer[k].timeSeries.getNumRows(), streamingStates[k] );
+        streamingMatchStart[k] = 0;
+    }
+    
+    return true;
+}
+
+bool DTW::getStreamingModeActive() const{
+    return useStreamingMode && !useZNormalisation && !useSmoothing && !offsetUsingFirstSample;
 }
 
 inline Float DTW::MIN_(Float a,Float b, Float c){
@@ -948,7 +1500,7 @@ bool DTW::save( std::fstream &file ) const{
         return false;
     }
     
-    file << "GRT_DTW_Model_File_V2.0" << std::endl;
+    file << "GRT_DTW_Model_File_V4.0" << std::endl;
     
     //Write the classifier settings to the file
     if( !Classifier::saveBaseSettingsToFile(file) ){
@@ -988,6 +1540,8 @@ bool DTW::save( std::fstream &file ) const{
             file << "TemplateThreshold: " << nullRejectionThresholds[i] << std::endl;
             file << "TrainingMu: " << templatesBuffer[i].trainingMu << std::endl;
             file << "TrainingSigma: " << templatesBuffer[i].trainingSigma << std::endl;
+            file << "StreamingMu: " << templatesBuffer[i].streamingMu << std::endl;
+            file << "StreamingSigma: " << templatesBuffer[i].streamingSigma << std::endl;
             file << "AverageTemplateLength: " << templatesBuffer[i].averageTemplateLength << std::endl;
             file << "TimeSeries: " << std::endl;
             for(UINT k=0; k<templatesBuffer[i].timeSeries.getNumRows(); k++){
@@ -996,6 +1550,21 @@ bool DTW::save( std::fstream &file ) const{
                 }
                 file << std::endl;
             }
+            file << "EnvelopeLength: " << templatesBuffer[i].upperEnvelope.getNumRows() << std::endl;
+            file << "UpperEnvelope: " << std::endl;
+            for(UINT k=0; k<templatesBuffer[i].upperEnvelope.getNumRows(); k++){
+                for(UINT j=0; j<templatesBuffer[i].upperEnvelope.getNumCols(); j++){
+                    file << templatesBuffer[i].upperEnvelope[k][j] << "\t";
+                }
+                file << std::endl;
+            }
+            file << "LowerEnvelope: " << std::endl;
+            for(UINT k=0; k<templatesBuffer[i].lowerEnvelope.getNumRows(); k++){
+                for(UINT j=0; j<templatesBuffer[i].lowerEnvelope.getNumCols(); j++){
+                    file << templatesBuffer[i].lowerEnvelope[k][j] << "\t";
+                }
+                file << std::endl;
+            }
         }
     }
     
@@ -1006,6 +1575,7 @@ bool DTW::load( std::fstream &file ){
     
     std::string word;
     UINT timeSeriesLength;
+    UINT envelopeLength;
     UINT ts;
     
     if(!file.is_open())
@@ -1018,11 +1588,26 @@ bool DTW::load( std::fstream &file ){
     
     //Check to see if we should load a legacy file
     if( word == "GRT_DTW_Model_File_V1.0" ){
-        return loadLegacyModelFromFile( file );
+        if( !loadLegacyModelFromFile( file ) ) return false;
+        if( trained ){
+            computeEnvelopes();
+            
+            //The legacy format does not contain the streaming distances, so the full DTW thresholds are used instead
+            streamingNullRejectionThresholds.resize( numTemplates );
+            for(UINT k=0; k<numTemplates; k++){
+                templatesBuffer[k].streamingMu = templatesBuffer[k].trainingMu;
+                templatesBuffer[k].streamingSigma = templatesBuffer[k].trainingSigma;
+                streamingNullRejectionThresholds[k] = nullRejectionThresholds[k];
+            }
+        }
+        return true;
     }
     
-    //Check to make sure this is a file with the DTW File Format
-    if(word != "GRT_DTW_Model_File_V2.0"){
+    //Check to make sure this is a file with the DTW File Format, the V2.0 format does not contain the template envelopes
+    //and the V2.0 and V3.0 formats do not contain the streaming distances
+    const bool hasStreamingDistances = word == "GRT_DTW_Model_File_V4.0";
+    const bool hasEnvelopes = word == "GRT_DTW_Model_File_V3.0" || hasStreamingDistances;
+    if(word != "GRT_DTW_Model_File_V2.0" && !hasEnvelopes){
         errorLog << __GRT_LOG__ << " Unknown file header!" << std::endl;
         return false;
     }
@@ -1195,6 +1780,28 @@ bool DTW::load( std::fstream &file ){
             }
             file >> templatesBuffer[i].trainingSigma;
             
+            //Get the streaming mu and sigma values, older model files do not contain these so the full DTW values are used instead
+            if( !hasStreamingDistances ){
+                templatesBuffer[i].streamingMu = templatesBuffer[i].trainingMu;
+                templatesBuffer[i].streamingSigma = templatesBuffer[i].trainingSigma;
+            }else{
+                file >> word;
+                if(word != "StreamingMu:"){
+                    clear();
+                    errorLog << __GRT_LOG__ << " Failed to find StreamingMu!" << std::endl;
+                    return false;
+                }
+                file >> templatesBuffer[i].streamingMu;
+            
+                file >> word;
+                if(word != "StreamingSigma:"){
+                    clear();
+                    errorLog << __GRT_LOG__ << " Failed to find StreamingSigma!" << std::endl;
+                    return false;
+                }
+                file >> templatesBuffer[i].streamingSigma;
+            }
+            
             //Get the AverageTemplateLength value
             file >> word;
             if(word != "AverageTemplateLength:"){
@@ -1214,11 +1821,55 @@ bool DTW::load( std::fstream &file ){
             for(UINT k=0; k<timeSeriesLength; k++)
             for(UINT j=0; j<numInputDimensions; j++)
             file >> templatesBuffer[i].timeSeries[k][j];
+            
+            if( !hasEnvelopes ) continue;
+            
+            //Get the envelope length
+            file >> word;
+            if(word != "EnvelopeLength:"){
+                clear();
+                errorLog << __GRT_LOG__ << " Failed to find EnvelopeLength!" << std::endl;
+                return false;
+            }
+            file >> envelopeLength;
+            templatesBuffer[i].upperEnvelope.resize(envelopeLength,numInputDimensions);
+            templatesBuffer[i].lowerEnvelope.resize(envelopeLength,numInputDimensions);
+            
+            //Get the envelopes
+            file >> word;
+            if(word != "UpperEnvelope:"){
+                clear();
+                errorLog << __GRT_LOG__ << " Failed to find UpperEnvelope!" << std::endl;
+                return false;
+            }
+            for(UINT k=0; k<envelopeLength; k++)
+            for(UINT j=0; j<numInputDimensions; j++)
+            file >> templatesBuffer[i].upperEnvelope[k][j];
+            
+            file >> word;
+            if(word != "LowerEnvelope:"){
+                clear();
+                errorLog << __GRT_LOG__ << " Failed to find LowerEnvelope!" << std::endl;
+                return false;
+            }
+            for(UINT k=0; k<envelopeLength; k++)
+            for(UINT j=0; j<numInputDimensions; j++)
+            file >> templatesBuffer[i].lowerEnvelope[k][j];
+        }
+        
+        //Older model files do not contain the envelopes, so they need to be computed
+        if( !hasEnvelopes ) computeEnvelopes();
+        
+        //Set the streaming null rejection thresholds from the streaming distances of each template
+        streamingNullRejectionThresholds.resize( numTemplates );
+        for(UINT k=0; k<numTemplates; k++){
+            streamingNullRejectionThresholds[k] = templatesBuffer[k].streamingMu + (templatesBuffer[k].streamingSigma * nullRejectionCoeff);
         }
         
         //Resize the prediction results to make sure it is setup for realtime prediction
         continuousInputDataBuffer.clear();
         continuousInputDataBuffer.resize(averageTemplateLength,VectorFloat(numInputDimensions,0));
+        resetStreamingStates();
         maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
         bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
         classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
@@ -1248,11 +1899,34 @@ bool DTW::setOffsetTimeseriesUsingFirstSample(bool offsetUsingFirstSample){
 
 bool DTW::setContrainWarpingPath(bool constrain){
     this->constrainWarpingPath = constrain;
+    //The envelopes depend on the warping window, so they need to be recomputed
+    if( trained ) computeEnvelopes();
     return true;
 }
 
 bool DTW::setWarpingRadius(Float radius){
     this->radius = radius;
+    if( trained ) computeEnvelopes();
+    return true;
+}
+
+bool DTW::enableStreamingMode(const bool useStreamingMode){
+    this->useStreamingMode = useStreamingMode;
+    if( trained ) resetStreamingStates();
+    return true;
+}
+
+bool DTW::enableLowerBounding(const bool useLowerBounding){
+    this->useLowerBounding = useLowerBounding;
+    return true;
+}
+
+bool DTW::enableWarpingPaths(const bool computeWarpingPaths){
+    this->computeWarpingPaths = computeWarpingPaths;
+    if( !computeWarpingPaths ){
+        distanceMatrices.clear();
+        warpPaths.clear();
+    }
     return true;
 }
 
@@ -1527,6 +2201,7 @@ bool DTW::loadLegacyModelFromFile( std::fstream &file ){
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
     continuousInputDataBuffer.resize(averageTemplateLength,VectorFloat(numInputDimensions,0));
+    resetStreamingStates();
     maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
     bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
     classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
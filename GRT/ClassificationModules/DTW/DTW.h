@@ -53,6 +53,18 @@ class GRT_API IndexDist{
     Float dist;
 };
 
+///////////////// DTW Streaming State /////////////////
+class GRT_API DTWStreamingState{
+    public:
+    DTWStreamingState(){}
+    ~DTWStreamingState(){};
+    
+    Vector< Float > cost;               //The accumulated cost for each template sample, for the best path ending at the latest input sample
+    Vector< Float > pathSum;            //The sum of the accumulated costs along each best path
+    Vector< Float > pathLength;         //The length of each best path
+    Vector< UINT > startIndex;          //The input sample index at which each best path started
+};
+
 ///////////////// DTW Template /////////////////
 class GRT_API DTWTemplate{
     public:
@@ -60,6 +72,8 @@ class GRT_API DTWTemplate{
         classLabel = 0;
         trainingMu = 0.0;
         trainingSigma = 0.0;
+        streamingMu = 0.0;
+        streamingSigma = 0.0;
         averageTemplateLength=0;
     }
     ~DTWTemplate(){};
@@ -68,7 +82,11 @@ class GRT_API DTWTemplate{
     MatrixFloat timeSeries;            //The raw time series
     Float trainingMu;                  //The mean distance value of the training data with the trained template
     Float trainingSigma;               //The sigma of the distance value of the training data with the trained template
+    Float streamingMu;                 //The mean subsequence distance of the training data with the trained template, used by the streaming mode
+    Float streamingSigma;              //The sigma of the subsequence distance of the training data with the trained template, used by the streaming mode
     UINT averageTemplateLength;          //The average length of the examples used to train this template
+    MatrixFloat upperEnvelope;           //The upper envelope of the time series inside the warping window, for each sample in an input timeseries
+    MatrixFloat lowerEnvelope;           //The lower envelope of the time series inside the warping window, for each sample in an input timeseries
 };
 
 /**
@@ -260,6 +278,95 @@ public:
     */
     bool setWarpingRadius(Float radius);
     
+    /**
+    Sets if the streaming (subsequence) DTW mode should be used for realtime prediction with predict(VectorFloat).
+    In the streaming mode, the DTW state for each template is updated incrementally with each new sample (using the SPRING algorithm),
+    rather than rerunning DTW over the entire input buffer, which reduces the cost of each prediction from O(M*N) to O(N) per template.
+    The class distances are then given by the best matching subsequence (of any length) that ends at the latest sample, and the
+    start of each match can be accessed via getStreamingMatchStart().
+    
+    The streaming mode does not support z-normalization, smoothing or offsetting the timeseries using the first sample, if any of these
+    options are enabled then the buffered prediction will be used instead. The warping window constraint is not used in the streaming mode.
+    Null rejection in the streaming mode uses its own thresholds, which are trained with the same subsequence distance, see getStreamingNullRejectionThresholds().
+    
+    @param useStreamingMode: if true then the streaming mode will be used for realtime prediction
+    @return returns true if the parameter was updated successfully, false otherwise
+    */
+    bool enableStreamingMode(const bool useStreamingMode);
+    
+    /**
+    Gets if the streaming mode has been enabled.
+    
+    @return returns true if the streaming mode has been enabled, false otherwise
+    */
+    bool getStreamingModeEnabled() const { return useStreamingMode; }
+    
+    /**
+    Gets the start index of the best matching subsequence for each template from the last streaming prediction.  The index counts the
+    number of samples passed to predict(VectorFloat) since the model was trained or reset, the end of each match is always the latest sample
+    (which has the index getStreamingSampleCounter()-1).
+    
+    @return returns a vector with the start index of the best match for each template, or an empty vector if the streaming mode has not been used
+    */
+    const Vector< UINT >& getStreamingMatchStart() const { return streamingMatchStart; }
+    
+    /**
+    Gets the number of samples that have been passed to the streaming mode since the model was trained or reset.
+    
+    @return returns the number of samples processed by the streaming mode
+    */
+    UINT getStreamingSampleCounter() const { return streamingSampleCounter; }
+    
+    /**
+    Gets the null rejection thresholds used by the streaming mode.  The streaming mode compares the best matching subsequence with each template,
+    which gives smaller distances than matching the whole input, so these thresholds are trained using the same subsequence distance rather than
+    the distance between whole training examples.
+    
+    @return returns a vector with the streaming null rejection threshold for each template, or an empty vector if the model has not been trained
+    */
+    const VectorFloat& getStreamingNullRejectionThresholds() const { return streamingNullRejectionThresholds; }
+    
+    /**
+    Sets if the full cost matrix and warping path should be computed for each template during prediction.
+    By default only the DTW distance is computed, which only needs two rows of the cost matrix, so this should only be enabled
+    if you need to access the distance matrices or warping paths after each prediction.
+    
+    @param computeWarpingPaths: if true then the distance matrices and warping paths will be computed for each prediction
+    @return returns true if the parameter was updated successfully, false otherwise
+    */
+    bool enableWarpingPaths(const bool computeWarpingPaths);
+    
+    /**
+    Gets if the full cost matrix and warping path will be computed for each template during prediction.
+    
+    @return returns true if the warping paths will be computed, false otherwise
+    */
+    bool getWarpingPathsEnabled() const { return computeWarpingPaths; }
+    
+    /**
+    Sets if lower bounds should be used to prune the templates during prediction.  If enabled, the cheap LB_Kim and LB_Keogh lower bounds
+    are computed for each template before the full DTW distance, and the template is skipped if the bound is greater than the best distance
+    found so far.  The DTW computation is also abandoned early if the accumulated cost shows that it can not beat the best distance.
+    The envelopes used by LB_Keogh are computed for each template when the model is trained, and are saved with the model.
+    
+    The class distance of any pruned template is set to the lower bound of its distance (which is always greater than the best distance), so the
+    class distances and class likelihoods are only approximate when the templates are pruned.  For this reason the templates are only pruned if
+    null rejection is disabled or the rejection mode is TEMPLATE_THRESHOLDS, as the predicted class label and best distance then only depend on
+    the closest template and are not changed by the pruning.  The CLASS_LIKELIHOODS and THRESHOLDS_AND_LIKELIHOODS rejection modes need the
+    exact likelihoods, so lower bounding has no effect in these modes.  Lower bounding is also not used if the warping paths have been enabled.
+    
+    @param useLowerBounding: if true then the templates will be pruned using lower bounds during prediction
+    @return returns true if the parameter was updated successfully, false otherwise
+    */
+    bool enableLowerBounding(const bool useLowerBounding);
+    
+    /**
+    Gets if lower bounds will be used to prune the templates during prediction.
+    
+    @return returns true if lower bounding has been enabled, false otherwise
+    */
+    bool getLowerBoundingEnabled() const { return useLowerBounding; }
+    
     /**
     Gets the rejection mode used for null rejection. The rejection mode will be one of the RejectionModes enums.
     
@@ -317,6 +424,7 @@ public:
     
     /**
     Gets the distances matrices from the last prediction.  Each element in the vector represents the distance matrices for each corresponding class.
+    The distance matrices are only computed if enableWarpingPaths(true) has been called. Cells outside of the warping window are set to INFINITY.
     
     @return returns a vector of MatrixFloat containing the distance matrices from the last prediction, or an empty vector if no prediction has been made
     */
@@ -324,6 +432,7 @@ public:
     
     /**
     Gets the warping paths from the last prediction.  Each element in the vector represents the warping path for each corresponding class.
+    The warping paths are only computed if enableWarpingPaths(true) has been called.
     
     @return returns a vector of vectors containing the warping paths from the last prediction, or an empty vector if no prediction has been made
     */
@@ -344,11 +453,26 @@ public:
     
 protected:
     //Public training and prediction methods
-    bool train_NDDTW(TimeSeriesClassificationData &trainingData,DTWTemplate &dtwTemplate,UINT &bestIndex);
-    
-    //The actual DTW function
-    Float computeDistance(MatrixFloat &timeSeriesA,MatrixFloat &timeSeriesB,MatrixFloat &distanceMatrix,Vector< IndexDist > &warpPath);
-    Float d(int m,int n,MatrixFloat &distanceMatrix,const int M,const int N);
+    bool train_NDDTW(TimeSeriesClassificationData &trainingData,const MatrixFloat &distanceResults,DTWTemplate &dtwTemplate,UINT &bestIndex);
+    bool computeTrainingDistances(Vector< TimeSeriesClassificationData > &classData,Vector< MatrixFloat > &distanceCache);
+    
+    //The actual DTW functions, the first computes the full cost matrix and warping path, the second only computes the distance
+    Float computeDistance(const MatrixFloat &timeSeriesA,const MatrixFloat &timeSeriesB,MatrixFloat &distanceMatrix,Vector< IndexDist > &warpPath);
+    Float computeDistance(const MatrixFloat &timeSeriesA,const MatrixFloat &timeSeriesB,Vector< Float > &workspace,MatrixFloat *costMatrix = NULL,const Float abandonThreshold = INFINITY) const;
+    bool predictFromClassDistances(const VectorFloat &thresholds);
+    
+    //The lower bounding functions, used to prune templates during prediction
+    bool computeEnvelope(const MatrixFloat &timeSeries,const UINT inputLength,MatrixFloat &upperEnvelope,MatrixFloat &lowerEnvelope) const;
+    bool computeEnvelopes();
+    Float computeLowerBound(const DTWTemplate &dtwTemplate,const MatrixFloat &timeSeries,const bool useEnvelope);
+    UINT getProcessedInputLength(const UINT inputLength) const;
+    
+    //The streaming subsequence DTW functions
+    bool predictStreaming(const VectorFloat &inputVector);
+    bool computeStreamingThresholds(Vector< TimeSeriesClassificationData > &classData,const Vector< UINT > &templateIndexs);
+    Float computeStreamingDistance(const MatrixFloat &templateTimeSeries,const MatrixFloat &timeSeries) const;
+    bool resetStreamingStates();
+    bool getStreamingModeActive() const;
     Float inline MIN_(Float a,Float b, Float c);
     
     //Scaling and Utility Functions
@@ -364,6 +488,16 @@ protected:
     Vector< DTWTemplate > templatesBuffer;      //A buffer to store the templates for each time series
     Vector< MatrixFloat > distanceMatrices;
     Vector< Vector< IndexDist > > warpPaths;
+    Vector< Float > distanceWorkspace;          //Stores the rows of the cost matrix used by computeDistance
+    Vector< Float > lowerBounds;                //Stores the LB_Kim lower bound for each template during prediction
+    Vector< UINT > templateOrder;               //Stores the order the templates are tested in when lower bounding is used
+    MatrixFloat upperEnvelopeBuffer;            //Stores the upper envelope of a template if the input length does not match the saved envelope
+    MatrixFloat lowerEnvelopeBuffer;            //Stores the lower envelope of a template if the input length does not match the saved envelope
+    Vector< DTWStreamingState > streamingStates;//Stores the subsequence DTW state for each template, used by the streaming mode
+    Vector< UINT > streamingMatchStart;         //The start index of the best match for each template in the streaming mode
+    VectorFloat streamingInput;                 //Stores the scaled input sample for the streaming mode
+    VectorFloat streamingNullRejectionThresholds;//The null rejection threshold for each template, used by the streaming mode
+    UINT streamingSampleCounter;                //The number of samples processed by the streaming mode
     CircularBuffer< VectorFloat > continuousInputDataBuffer;
     UINT                numTemplates;           //The number of templates in our buffer
     UINT                rejectionMode;          //The rejection mode used to reject null gestures during the prediction phase
@@ -374,6 +508,9 @@ protected:
     bool                offsetUsingFirstSample; //A flag to check if each timeseries should be offset by the first sample in the time series
     bool                constrainZNorm;         //A flag to check if we need to constrain zNorm (only zNorm if stdDev > zNormConstrainThreshold)
     bool                constrainWarpingPath;   //A flag to check if we need to constrain the dtw cost matrix and search
+    bool                computeWarpingPaths;    //A flag to check if the full cost matrix and warping path should be computed during prediction
+    bool                useStreamingMode;       //A flag to check if the streaming subsequence DTW should be used for realtime prediction
+    bool                useLowerBounding;       //A flag to check if the templates should be pruned using lower bounds during prediction
     bool                trimTrainingData;       //A flag to check if we need to trim the training data first before training
     
     Float               zNormConstrainThreshold;//The threshold value to be used if constrainZNorm is turned on
@@ -394,4 +531,3 @@ private:
 GRT_END_NAMESPACE
 
 #endif //GRT_DTW_HEADER
-    
\ No newline at end of file
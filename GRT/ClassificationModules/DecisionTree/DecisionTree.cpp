@@ -33,6 +33,8 @@ RegisterClassifierModule< DecisionTree >  DecisionTree::registerModule( Decision
 DecisionTree::DecisionTree(const DecisionTreeNode &decisionTreeNode,const UINT minNumSamplesPerNode,const UINT maxDepth,const bool removeFeaturesAtEachSplit,const Tree::TrainingMode trainingMode,const UINT numSplittingSteps,const bool useScaling) : Classifier( DecisionTree::getId() )
 {
     this->tree = NULL;
+    this->flatTreeBuilt = false;
+    this->predictedNodeID = 0;
     this->decisionTreeNode = dynamic_cast< DecisionTreeNode* >( decisionTreeNode.deepCopy() );
     this->minNumSamplesPerNode = minNumSamplesPerNode;
     this->maxDepth = maxDepth;
@@ -48,6 +50,8 @@ DecisionTree::DecisionTree(const DecisionTreeNode &decisionTreeNode,const UINT m
 DecisionTree::DecisionTree(const DecisionTree &rhs) : Classifier( DecisionTree::getId() )
 {
     tree = NULL;
+    flatTreeBuilt = false;
+    predictedNodeID = 0;
     decisionTreeNode = NULL;
     classifierMode = STANDARD_CLASSIFIER_MODE;
     *this = rhs;
@@ -131,6 +135,13 @@ bool DecisionTree::deepCopyFrom(const Classifier *classifier){
 
 bool DecisionTree::train_(ClassificationData &trainingData){
     
+    //The tree copies its training data into its own column-major store, so it is trained from a view of the data rather than copying it twice
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool DecisionTree::train_(ClassificationDataView &trainingData){
+    
     //Clear any previous model
     clear();
     
@@ -153,10 +164,11 @@ bool DecisionTree::train_(ClassificationData &trainingData){
     classLabels = trainingData.getClassLabels();
     ranges = trainingData.getRanges();
     
-    //Get the validation set if needed
-    ClassificationData validationData;
+    //Get the validation set if needed, the tree keeps every class of the view even if it has no samples left, so trees trained from
+    //bootstrapped views of the same data (such as the trees in a RandomForests model) all have the same classes
+    ClassificationDataView validationData;
     if( useValidationSet ){
-        validationData = trainingData.split( validationSetSize );
+        validationData = trainingData.split( validationSetSize, false, random );
         validationSetAccuracy = 0;
         validationSetPrecision.resize( useNullRejection ? K+1 : K, 0 );
         validationSetRecall.resize( useNullRejection ? K+1 : K, 0 );
@@ -164,18 +176,6 @@ bool DecisionTree::train_(ClassificationData &trainingData){
 
     const unsigned int M = trainingData.getNumSamples();
     
-    //Scale the training data if needed
-    if( useScaling ){
-        //Scale the training data between 0 and 1
-        trainingData.scale(0, 1);
-    }
-    
-    //If we are using null rejection, then we need a copy of the training dataset for later
-    ClassificationData trainingDataCopy;
-    if( useNullRejection ){
-        trainingDataCopy = trainingData;
-    }
-    
     //Setup the valid features - at this point all features can be used
     Vector< UINT > features(N);
     for(UINT i=0; i<N; i++){
@@ -195,7 +195,7 @@ bool DecisionTree::train_(ClassificationData &trainingData){
 
             trainingLog << "Training tree iteration: " << i+1 << "/" << numTrainingIterationsToConverge << std::endl;
 
-            if( !trainTree( trainingData, trainingDataCopy, validationData, features ) ){
+            if( !trainTree( trainingData, validationData, features ) ){
                 errorLog << __GRT_LOG__ << " Failed to build tree!" << std::endl;
                 //Delete the best tree if it exists
                 if( bestTree != NULL ){
@@ -243,7 +243,7 @@ bool DecisionTree::train_(ClassificationData &trainingData){
 
     }else{
         //If we get here, then we are going to train the tree once
-        if( !trainTree( trainingData, trainingDataCopy, validationData, features ) ){
+        if( !trainTree( trainingData, validationData, features ) ){
             return false;
         }
     }
@@ -257,15 +257,14 @@ bool DecisionTree::train_(ClassificationData &trainingData){
     classLikelihoods.resize(numClasses);
     classDistances.resize(numClasses);
 
-    //Compute the final training stats
+    //Compute the final training stats, the view has not been scaled so the model scales each sample as it is tested
     trainingSetAccuracy = 0;
     validationSetAccuracy = 0;
 
-    //If scaling was on, then the data will already be scaled, so turn it off temporially
-    bool scalingState = useScaling;
-    useScaling = false;
+    VectorFloat sample;
     for(UINT i=0; i<M; i++){
-        if( !predict_( trainingData[i].getSample() ) ){
+        sample = trainingData[i].getSample();
+        if( !predict_( sample ) ){
             trained = false;
             errorLog << __GRT_LOG__ << " Failed to run prediction for training sample: " << i << "! Failed to fully train model!" << std::endl;
             return false;
@@ -278,7 +277,8 @@ bool DecisionTree::train_(ClassificationData &trainingData){
 
     if( useValidationSet ){
         for(UINT i=0; i<validationData.getNumSamples(); i++){
-            if( !predict_( validationData[i].getSample() ) ){
+            sample = validationData[i].getSample();
+            if( !predict_( sample ) ){
                 trained = false;
                 errorLog << __GRT_LOG__ << " Failed to run prediction for validation sample: " << i << "! Failed to fully train model!" << std::endl;
                 return false;
@@ -299,21 +299,31 @@ bool DecisionTree::train_(ClassificationData &trainingData){
         trainingLog << "Validation set accuracy: " << validationSetAccuracy << std::endl;
     }
 
-    //Reset the scaling state for future prediction
-    useScaling = scalingState;
-
     return true;
 }
 
-bool DecisionTree::trainTree( ClassificationData trainingData, const ClassificationData &trainingDataCopy, const ClassificationData &validationData, Vector< UINT > features ){
+bool DecisionTree::trainTree( const ClassificationDataView &trainingData, const ClassificationDataView &validationData, Vector< UINT > features ){
 
     //Note, this function is only called internally by the decision tree, users should call train_ instead.
 
     const unsigned int M = trainingData.getNumSamples();
 
+    //Copy the training data into the column-major store that is shared by all the nodes while the tree is built, scaling it if needed
+    DecisionTreeTrainingData treeData;
+    if( !treeData.set( trainingData, classLabels, useScaling ? ranges : Vector< MinMax >() ) ){
+        errorLog << __GRT_LOG__ << " Failed to set the tree training data!" << std::endl;
+        return false;
+    }
+
+    //Quantise the features if the tree will be built from histograms, the number of splitting steps is the maximum number of bins
+    if( trainingMode == Tree::BEST_HISTOGRAM_SPLIT && !treeData.computeBins( numSplittingSteps ) ){
+        errorLog << __GRT_LOG__ << " Failed to compute the feature bins, the number of splitting steps must be in the range [2 65535] when using the histogram training mode!" << std::endl;
+        return false;
+    }
+
     //Build the tree
     UINT nodeID = 0;
-    tree = buildTree( trainingData, NULL, features, classLabels, nodeID );
+    tree = buildTree( treeData, 0, M, NULL, features, classLabels, nodeID );
     
     if( tree == NULL ){
         clear();
@@ -334,8 +344,13 @@ bool DecisionTree::trainTree( ClassificationData trainingData, const Classificat
         //Run over the training dataset and compute the distance between each training sample and the predicted node cluster
         VectorFloat sample;
         for(UINT i=0; i<M; i++){
-            //Run the prediction for this sample
-            sample = trainingDataCopy[i].getSample();
+            //Run the prediction for this sample, the view has not been scaled so the sample is scaled before it is passed to the tree
+            sample = trainingData[i].getSample();
+            if( useScaling ){
+                for(UINT j=0; j<numInputDimensions; j++){
+                    sample[j] = grt_scale(sample[j], ranges[j].minValue, ranges[j].maxValue, 0.0, 1.0);
+                }
+            }
             if( !tree->predict_( sample, classLikelihoods ) ){
                 errorLog << __GRT_LOG__ << " Failed to predict training sample while building null rejection model!" << std::endl;
                 return false;
@@ -423,6 +438,7 @@ bool DecisionTree::trainTree( ClassificationData trainingData, const Classificat
 bool DecisionTree::predict_(VectorFloat &inputVector){
     
     predictedClassLabel = 0;
+    predictedNodeID = 0;
     maxLikelihood = 0;
     
     //Validate the input is OK and the model is trained properly
@@ -451,10 +467,21 @@ bool DecisionTree::predict_(VectorFloat &inputVector){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
     
+    //Flatten the tree the first time it is used, if any of its nodes can not be flattened then the tree is run node by node
+    if( !flatTreeBuilt ) buildFlatTree();
+    
     //Run the decision tree prediction
-    if( !tree->predict_( inputVector, classLikelihoods ) ){
-        errorLog << __GRT_LOG__ << " Failed to predict!" << std::endl;
-        return false;
+    if( flatTree.getNumTrees() > 0 ){
+        const UINT leafIndex = flatTree.predictLeaf( 0, &inputVector[0] );
+        const Float *leafValues = flatTree.getLeafValues( leafIndex );
+        std::copy( leafValues, leafValues+numClasses, classLikelihoods.begin() );
+        predictedNodeID = flatTree.getLeafNodeID( leafIndex );
+    }else{
+        if( !tree->predict_( inputVector, classLikelihoods ) ){
+            errorLog << __GRT_LOG__ << " Failed to predict!" << std::endl;
+            return false;
+        }
+        predictedNodeID = tree->getPredictedNodeID();
     }
     
     //Find the maximum likelihood
@@ -472,7 +499,7 @@ bool DecisionTree::predict_(VectorFloat &inputVector){
     if( useNullRejection ){
         
         //Get the distance between the input and the leaf mean
-        Float leafDistance = getNodeDistance( inputVector, tree->getPredictedNodeID() );
+        Float leafDistance = getNodeDistance( inputVector, predictedNodeID );
         
         if( grt_isnan(leafDistance) ){
             errorLog << __GRT_LOG__ << " Failed to match leaf node ID to compute node distance!" << std::endl;
@@ -510,6 +537,9 @@ bool DecisionTree::clear(){
         delete tree;
         tree = NULL;
     }
+    flatTree.clear();
+    flatTreeBuilt = false;
+    predictedNodeID = 0;
     
     //NOTE: We do not want to clean up the decisionTreeNode here as we need to keep track of this, this is only delete in the destructor
     
@@ -864,10 +894,9 @@ bool DecisionTree::setDecisionTreeNode( const DecisionTreeNode &node ){
     return true;
 }
 
-DecisionTreeNode* DecisionTree::buildTree(ClassificationData &trainingData,DecisionTreeNode *parent,Vector< UINT > features,const Vector< UINT > &classLabels, UINT nodeID){
+DecisionTreeNode* DecisionTree::buildTree(DecisionTreeTrainingData &trainingData,const UINT startIndex,const UINT endIndex,DecisionTreeNode *parent,Vector< UINT > features,const Vector< UINT > &classLabels, UINT nodeID){
     
-    const UINT M = trainingData.getNumSamples();
-    const UINT N = trainingData.getNumDimensions();
+    const UINT M = endIndex - startIndex;
     
     //Update the nodeID
     nodeID++;
@@ -879,7 +908,7 @@ DecisionTreeNode* DecisionTree::buildTree(ClassificationData &trainingData,Decis
     depth = parent->getDepth() + 1;
     
     //If there are no training data then return NULL
-    if( trainingData.getNumSamples() == 0 )
+    if( M == 0 )
     return NULL;
     
     //Create the new node
@@ -889,29 +918,32 @@ DecisionTreeNode* DecisionTree::buildTree(ClassificationData &trainingData,Decis
     return NULL;
     
     //Get the class probabilities
-    VectorFloat classProbs = trainingData.getClassProbabilities( classLabels );
+    Vector< UINT > classCounts;
+    const UINT numClassesInNode = trainingData.getClassCounts( startIndex, endIndex, classCounts );
+    VectorFloat classProbs = trainingData.getClassProbabilities( startIndex, endIndex );
     
     //Set the parent
     node->initNode( parent, depth, nodeID );
     
     //If all the training data belongs to the same class or there are no features left then create a leaf node and return
-    if( trainingData.getNumClasses() == 1 || features.size() == 0 || M < minNumSamplesPerNode || depth >= maxDepth ){
+    if( numClassesInNode == 1 || features.size() == 0 || M < minNumSamplesPerNode || depth >= maxDepth ){
         
-        //Set the node
-        node->setLeafNode( trainingData.getNumSamples(), classProbs );
+        //Set the node and release its histogram, if one was computed
+        node->setLeafNode( M, classProbs );
+        trainingData.releaseHistogram( startIndex, endIndex );
         
         //Build the null cluster if null rejection is enabled
         if( useNullRejection ){
-            nodeClusters[ nodeID ] = trainingData.getMean();
+            nodeClusters[ nodeID ] = trainingData.getMean( startIndex, endIndex );
         }
         
         std::string info = "Reached leaf node.";
-        if( trainingData.getNumClasses() == 1 ) info = "Reached pure leaf node.";
+        if( numClassesInNode == 1 ) info = "Reached pure leaf node.";
         else if( features.size() == 0 ) info = "Reached leaf node, no remaining features.";
         else if( M < minNumSamplesPerNode ) info = "Reached leaf node, hit min-samples-per-node limit.";
         else if( depth >= maxDepth ) info = "Reached leaf node, max depth reached.";
         
-        trainingLog << info << " Depth: " << depth << " NumSamples: " << trainingData.getNumSamples();
+        trainingLog << info << " Depth: " << depth << " NumSamples: " << M;
         
         trainingLog << " Class Probabilities: ";
         for(UINT k=0; k<classProbs.getSize(); k++){
@@ -926,7 +958,8 @@ DecisionTreeNode* DecisionTree::buildTree(ClassificationData &trainingData,Decis
     UINT featureIndex = 0;
     Float minError = 0;
     
-    if( !node->computeBestSplit( trainingMode, numSplittingSteps, trainingData, features, classLabels, featureIndex, minError ) ){
+    if( !node->computeBestSplit( trainingMode, numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random ) ){
+        trainingData.releaseHistogram( startIndex, endIndex );
         delete node;
         return NULL;
     }
@@ -948,40 +981,43 @@ DecisionTreeNode* DecisionTree::buildTree(ClassificationData &trainingData,Decis
         }
     }
     
-    //Split the data into a left and right dataset
-    ClassificationData lhs(N);
-    ClassificationData rhs(N);
-    
-    //Reserve the memory to speed up the allocation of large datasets
-    lhs.reserve( M );
-    rhs.reserve( M );
-    
-    for(UINT i=0; i<M; i++){
-        if( node->predict_( trainingData[i].getSample() ) ){
-            rhs.addSample(trainingData[i].getClassLabel(), trainingData[i].getSample());
-        }else lhs.addSample(trainingData[i].getClassLabel(), trainingData[i].getSample());
-    }
-    
-    //Clear the parent dataset so we do not run out of memory with very large datasets (with very deep trees)
-    trainingData.clear();
+    //Split the data into a left and right range, the samples are partitioned in place so no data is copied (the node histogram is split with them)
+    const UINT splitIndex = trainingData.partition( startIndex, endIndex, [&](const UINT sampleIndex){
+        return node->predictTrainingSample( trainingData, sampleIndex );
+    } );
     
     //Get the new node IDs for the children
     UINT leftNodeID = ++nodeID;
     UINT rightNodeID = ++nodeID;
     
     //Run the recursive tree building on the children
-    node->setLeftChild( buildTree( lhs, node, features, classLabels, leftNodeID ) );
-    node->setRightChild( buildTree( rhs, node, features, classLabels, rightNodeID ) );
+    node->setLeftChild( buildTree( trainingData, startIndex, splitIndex, node, features, classLabels, leftNodeID ) );
+    node->setRightChild( buildTree( trainingData, splitIndex, endIndex, node, features, classLabels, rightNodeID ) );
     
     //Build the null clusters for the rhs and lhs nodes if null rejection is enabled
     if( useNullRejection ){
-        nodeClusters[ leftNodeID ] = lhs.getMean();
-        nodeClusters[ rightNodeID ] = rhs.getMean();
+        nodeClusters[ leftNodeID ] = trainingData.getMean( startIndex, splitIndex );
+        nodeClusters[ rightNodeID ] = trainingData.getMean( splitIndex, endIndex );
     }
     
     return node;
 }
 
+bool DecisionTree::buildFlatTree(){
+    
+    flatTreeBuilt = true;
+    
+    if( tree == NULL ) return false;
+    
+    if( !flatTree.init( numClasses ) || !flatTree.addTree( tree ) ){
+        flatTree.clear();
+        warningLog << __GRT_LOG__ << " Failed to flatten the tree, the tree will be run node by node!" << std::endl;
+        return false;
+    }
+    
+    return true;
+}
+
 Float DecisionTree::getNodeDistance( const VectorFloat &x, const UINT nodeID ){
     
     //Use the node ID to find the node cluster
@@ -1024,12 +1060,7 @@ UINT DecisionTree::getMaxDepth()const{
 }
 
 UINT DecisionTree::getPredictedNodeID()const{
-    
-    if( tree == NULL ){
-        return 0;
-    }
-    
-    return tree->getPredictedNodeID();
+    return predictedNodeID;
 }
 
 bool DecisionTree::getRemoveFeaturesAtEachSplit() const{
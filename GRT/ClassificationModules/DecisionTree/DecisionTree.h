@@ -97,6 +97,15 @@ public:
     @return returns true if the DecisionTree model was trained, false otherwise
     */
     virtual bool train_(ClassificationData &trainingData) override;
+
+    /**
+    This trains the DecisionTree model, using a view of the labelled classification data.  The samples in the view are not modified,
+    they are scaled (if needed) as they are copied into the column-major store the tree is built from.  The tree keeps every class of the view.
+
+    @param trainingData: a reference to a view of the training data
+    @return returns true if the DecisionTree model was trained, false otherwise
+    */
+    virtual bool train_(ClassificationDataView &trainingData) override;
     
     /**
     This predicts the class of the inputVector.
@@ -185,6 +194,7 @@ public:
     
     If the trainingMode is set to BEST_ITERATIVE_SPILT, then the numSplittingSteps controls how many iterative steps there will be per feature.
     If the trainingMode is set to BEST_RANDOM_SPLIT, then the numSplittingSteps controls how many random searches there will be per feature.
+    If the trainingMode is set to BEST_HISTOGRAM_SPLIT, then the numSplittingSteps controls the maximum number of bins each feature is quantised into, this should be in the range [2 65535].
     
     @return returns the number of steps that will be used to search for the best spliting value for each node
     */
@@ -232,6 +242,7 @@ public:
     
     If the trainingMode is set to BEST_ITERATIVE_SPILT, then the numSplittingSteps controls how many iterative steps there will be per feature.
     If the trainingMode is set to BEST_RANDOM_SPLIT, then the numSplittingSteps controls how many random searches there will be per feature.
+    If the trainingMode is set to BEST_HISTOGRAM_SPLIT, then the numSplittingSteps controls the maximum number of bins each feature is quantised into, this should be in the range [2 65535].
     
     A higher value will increase the chances of building a better model, but will take longer to train the model.
     Value must be larger than zero.
@@ -301,8 +312,9 @@ protected:
     bool loadLegacyModelFromFile_v2( std::fstream &file );
     bool loadLegacyModelFromFile_v3( std::fstream &file );
     
-    bool trainTree( ClassificationData trainingData, const ClassificationData &trainingDataCopy, const ClassificationData &validationData, Vector< UINT > features );
-    DecisionTreeNode* buildTree(ClassificationData &trainingData, DecisionTreeNode *parent, Vector< UINT > features, const Vector< UINT > &classLabels, UINT nodeID );
+    bool trainTree( const ClassificationDataView &trainingData, const ClassificationDataView &validationData, Vector< UINT > features );
+    DecisionTreeNode* buildTree( DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, DecisionTreeNode *parent, Vector< UINT > features, const Vector< UINT > &classLabels, UINT nodeID );
+    bool buildFlatTree();
     Float getNodeDistance( const VectorFloat &x, const UINT nodeID );
     Float getNodeDistance( const VectorFloat &x, const VectorFloat &y );
     
@@ -312,6 +324,9 @@ protected:
     VectorFloat classClusterStdDev;
 
     DecisionTreeNode *tree; 
+    FlatForest flatTree;
+    bool flatTreeBuilt;
+    UINT predictedNodeID;
     UINT minNumSamplesPerNode;
     UINT maxDepth;
     UINT numSplittingSteps;
@@ -22,6 +22,15 @@ bool DecisionTreeClusterNode::predict_(VectorFloat &x) {
     return false;
 }
 
+bool DecisionTreeClusterNode::predictTrainingSample( const DecisionTreeTrainingData &trainingData, const UINT sampleIndex ) const{
+    return trainingData.getValue( sampleIndex, featureIndex ) >= threshold;
+}
+
+bool DecisionTreeClusterNode::flatten( FlatForest &flatForest, const UINT flatNodeIndex, const bool isLeaf ) const{
+    if( isLeaf ) return DecisionTreeNode::flatten( flatForest, flatNodeIndex, isLeaf );
+    return flatForest.setThresholdSplit( flatNodeIndex, featureIndex, threshold );
+}
+
 bool DecisionTreeClusterNode::clear(){
 
     //Call the base class clear function
@@ -185,17 +194,18 @@ bool DecisionTreeClusterNode::set(const UINT nodeSize,const UINT featureIndex,co
     return true;
 }
 
-bool DecisionTreeClusterNode::computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
-    return computeSplit( numSplittingSteps, trainingData, features, classLabels, featureIndex, minError);
+bool DecisionTreeClusterNode::computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
+    return computeSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
 }
 
-bool DecisionTreeClusterNode::computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
-    return computeSplit( numSplittingSteps, trainingData, features, classLabels, featureIndex, minError);
+bool DecisionTreeClusterNode::computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
+    return computeSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
 }
 
-bool DecisionTreeClusterNode::computeSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
+bool DecisionTreeClusterNode::computeSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
 
-    const UINT M = trainingData.getNumSamples();
+    const UINT M = endIndex - startIndex;
+    const Vector< UINT > &indexs = trainingData.getIndexs();
     const UINT N = features.getSize();
     const UINT K = classLabels.getSize();
 
@@ -203,12 +213,9 @@ bool DecisionTreeClusterNode::computeSplit( const UINT &numSplittingSteps, const
     if( K == 0 ) return false;
 
     minError = grt_numeric_limits< Float >::max();
-    Random random;
     UINT bestFeatureIndex = 0;
     Float bestThreshold = 0;
     Float error = 0;
-    Vector< UINT > groupIndex(M);
-    Vector< MinMax > ranges = trainingData.getRanges();
     MatrixDouble data(M,1); //This will store our temporary data for each dimension
 
     //Randomly select which features we want to use
@@ -222,10 +229,10 @@ bool DecisionTreeClusterNode::computeSplit( const UINT &numSplittingSteps, const
 
         //Use the data in this feature dimension to create a sum dataset
         for(UINT i=0; i<M; i++){
-            data[i][0] = trainingData[i][featureIndex];
+            data[i][0] = trainingData.getValue( indexs[ startIndex+i ], featureIndex );
         }
 
-        if( computeError( trainingData, data, classLabels, ranges, groupIndex, featureIndex, threshold, error ) ){
+        if( computeError( trainingData, startIndex, endIndex, data, classLabels, featureIndex, threshold, error, random ) ){
             //Store the best threshold and feature index
             if( error < minError ){
                 minError = error;
@@ -239,23 +246,26 @@ bool DecisionTreeClusterNode::computeSplit( const UINT &numSplittingSteps, const
      featureIndex = bestFeatureIndex;
 
      //Store the node size, feature index, best threshold and class probabilities for this node
-     set( M, featureIndex, bestThreshold, trainingData.getClassProbabilities(classLabels) );
+     set( M, featureIndex, bestThreshold, trainingData.getClassProbabilities( startIndex, endIndex ) );
 
      return true;
 }
 
-bool DecisionTreeClusterNode::computeError( const ClassificationData &trainingData, MatrixFloat &data, const Vector< UINT > &classLabels, Vector< MinMax > ranges, Vector< UINT > groupIndex, const UINT featureIndex, Float &threshold, Float &error ){
+bool DecisionTreeClusterNode::computeError( const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, MatrixFloat &data, const Vector< UINT > &classLabels, const UINT featureIndex, Float &threshold, Float &error, Random &random ){
 
     error = 0;
     threshold = 0;
 
-    const UINT M = trainingData.getNumSamples();
+    const UINT M = endIndex - startIndex;
+    const Vector< UINT > &indexs = trainingData.getIndexs();
     const UINT K = (UINT)classLabels.size();
 
     Float giniIndexL = 0;
     Float giniIndexR = 0;
     Float weightL = 0;
     Float weightR = 0;
+    UINT sampleIndex = 0;
+    UINT groupIndex = 0;
     VectorFloat groupCounter(2,0);
     MatrixFloat classProbabilities(K,2);
 
@@ -266,6 +276,7 @@ bool DecisionTreeClusterNode::computeError( const ClassificationData &trainingDa
     kmeans.setMinChange( 1.0e-5 );
     kmeans.setMinNumEpochs( 1 );
     kmeans.setMaxNumEpochs( 100 );
+    kmeans.setRandomSeed( (unsigned long long)random.getRandomNumberInt( 1, std::numeric_limits< int >::max() ) );
 
     //Disable the logging to clean things up
     kmeans.setTrainingLoggingEnabled( false );
@@ -286,10 +297,11 @@ bool DecisionTreeClusterNode::computeError( const ClassificationData &trainingDa
     //Iterate over each sample and work out if it should be in the lhs (0) or rhs (1) group based on the current threshold
     groupCounter[0] = groupCounter[1] = 0;
     classProbabilities.setAllValues(0);
-    for(UINT i=0; i<M; i++){
-        groupIndex[i] = trainingData[ i ][ featureIndex ] >= threshold ? 1 : 0;
-        groupCounter[ groupIndex[i] ]++;
-        classProbabilities[ getClassLabelIndexValue(trainingData[i].getClassLabel(),classLabels) ][ groupIndex[i] ]++;
+    for(UINT i=startIndex; i<endIndex; i++){
+        sampleIndex = indexs[i];
+        groupIndex = trainingData.getValue( sampleIndex, featureIndex ) >= threshold ? 1 : 0;
+        groupCounter[ groupIndex ]++;
+        classProbabilities[ trainingData.getClassIndex( sampleIndex ) ][ groupIndex ]++;
     }
 
     //Compute the class probabilities for the lhs group and rhs group
@@ -61,14 +61,17 @@ bool DecisionTreeNode::predict_(VectorFloat &x,VectorFloat &classLikelihoods){
     return false;
 }
 
-bool DecisionTreeNode::computeBestSplit( const UINT &trainingMode, const UINT &numSplittingSteps,const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
+bool DecisionTreeNode::computeBestSplit( const UINT &trainingMode, const UINT &numSplittingSteps,DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
     
     switch( trainingMode ){
         case Tree::BEST_ITERATIVE_SPILT:
-            return computeBestSplitBestIterativeSplit( numSplittingSteps, trainingData, features, classLabels, featureIndex, minError );
+            return computeBestSplitBestIterativeSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
             break;
         case Tree::BEST_RANDOM_SPLIT:
-            return computeBestSplitBestRandomSplit( numSplittingSteps, trainingData, features, classLabels, featureIndex, minError );
+            return computeBestSplitBestRandomSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
+            break;
+        case Tree::BEST_HISTOGRAM_SPLIT:
+            return computeBestSplitBestHistogramSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
             break;
         default:
             errorLog << __GRT_LOG__ << " Uknown trainingMode!" << std::endl;
@@ -79,6 +82,11 @@ bool DecisionTreeNode::computeBestSplit( const UINT &trainingMode, const UINT &n
     return false;
 }
 
+bool DecisionTreeNode::flatten( FlatForest &flatForest, const UINT flatNodeIndex, const bool isLeaf ) const{
+    if( !isLeaf ) return Node::flatten( flatForest, flatNodeIndex, isLeaf );
+    return flatForest.setLeaf( flatNodeIndex, classProbabilities, nodeID );
+}
+
 bool DecisionTreeNode::clear(){
     
     //Call the base class clear function
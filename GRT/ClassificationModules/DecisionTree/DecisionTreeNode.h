@@ -29,7 +29,7 @@
 
 #include "../../CoreAlgorithms/Tree/Node.h"
 #include "../../CoreAlgorithms/Tree/Tree.h"
-#include "../../DataStructures/ClassificationData.h"
+#include "DecisionTreeTrainingData.h"
 
 GRT_BEGIN_NAMESPACE
     
@@ -78,14 +78,43 @@ public:
      
      @param trainingMode: the training mode to use, this should be one of the
      @param numSplittingSteps: sets the number of iterations that will be used to search for the best threshold
-     @param trainingData: the training data to use for the best split search
+     @param trainingData: the training data to use for the best split search, the histogram split caches the node histograms in it
+     @param startIndex: the start of the range of the training data's sample indexs that belong to this node
+     @param endIndex: the end of the range of the training data's sample indexs that belong to this node (not inclusive)
      @param features: a Vector containing the indexs of the features that can be used for the search
      @param classLabels: a Vector containing the class labels for the search
      @param featureIndex: this will store the best feature index found during the search
      @param minError: this will store the minimum error found during the search
+     @param random: the random number generator used by the splitting algorithms
      @return returns true if the best spliting algorithm found a split, false otherwise
      */
-    virtual bool computeBestSplit( const UINT &trainingMode, const UINT &numSplittingSteps,const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError );
+    virtual bool computeBestSplit( const UINT &trainingMode, const UINT &numSplittingSteps,DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random );
+
+    /**
+     This function writes this node into a FlatForest. The base DecisionTreeNode writes the node as a leaf holding its class
+     probabilities, the inheriting class should write its split when isLeaf is false.
+     
+     @param flatForest: the flat forest the node will be written to
+     @param flatNodeIndex: the index of the node in the flat forest
+     @param isLeaf: if true, the node is written as a leaf
+     @return returns true if the node was written, false otherwise
+     */
+    virtual bool flatten( FlatForest &flatForest, const UINT flatNodeIndex, const bool isLeaf ) const override;
+
+    /**
+     This function returns true if the sample in the training data should go to the right child of this node, it is
+     used to partition the training data when the node is split and gives the same result as predict_ on the sample.
+     
+     @param trainingData: the training data the sample is in
+     @param sampleIndex: the index of the sample in the training data
+     @return returns true if the sample should go to the right child, false otherwise
+     */
+    virtual bool predictTrainingSample( const DecisionTreeTrainingData &trainingData, const UINT sampleIndex ) const{
+        
+        errorLog << __GRT_LOG__ << " Base class not overwritten!" << std::endl;
+        
+        return false;
+    }
 
     /**
      This functions cleans up any dynamic memory assigned by the node.
@@ -164,19 +193,27 @@ public:
     using Node::predict_;
     
 protected:
-    virtual bool computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
+    virtual bool computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
         
         errorLog << __GRT_LOG__ << " Base class not overwritten!" << std::endl;
         
         return false;
     }
     
-    virtual bool computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
+    virtual bool computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
         
         errorLog << __GRT_LOG__ << " Base class not overwritten!" << std::endl;
         
         return false;
     }
+
+    /**
+     Searches for the best split using the histogram of the node, the bins of the training data must have been computed.
+     Nodes that do not support histogram splits use the iterative search instead.
+     */
+    virtual bool computeBestSplitBestHistogramSplit( const UINT &numSplittingSteps, DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
+        return computeBestSplitBestIterativeSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
+    }
     
     /**
      This saves the DecisionTreeNode custom parameters to a file. It will be called automatically by the Node base class
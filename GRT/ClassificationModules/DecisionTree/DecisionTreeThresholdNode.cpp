@@ -22,6 +22,15 @@ bool DecisionTreeThresholdNode::predict_(VectorFloat &x) {
     return false;
 }
 
+bool DecisionTreeThresholdNode::predictTrainingSample( const DecisionTreeTrainingData &trainingData, const UINT sampleIndex ) const{
+    return trainingData.getValue( sampleIndex, featureIndex ) >= threshold;
+}
+
+bool DecisionTreeThresholdNode::flatten( FlatForest &flatForest, const UINT flatNodeIndex, const bool isLeaf ) const{
+    if( isLeaf ) return DecisionTreeNode::flatten( flatForest, flatNodeIndex, isLeaf );
+    return flatForest.setThresholdSplit( flatNodeIndex, featureIndex, threshold );
+}
+
 bool DecisionTreeThresholdNode::clear(){
     
     //Call the base class clear function
@@ -119,9 +128,10 @@ bool DecisionTreeThresholdNode::set(const UINT nodeSize,const UINT featureIndex,
     return true;
 }
 
-bool DecisionTreeThresholdNode::computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
+bool DecisionTreeThresholdNode::computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &/*random*/ ){
     
-    const UINT M = trainingData.getNumSamples();
+    const UINT M = endIndex - startIndex;
+    const Vector< UINT > &indexs = trainingData.getIndexs();
     const UINT N = features.getSize();
     const UINT K = classLabels.getSize();
     
@@ -134,32 +144,35 @@ bool DecisionTreeThresholdNode::computeBestSplitBestIterativeSplit( const UINT &
     Float minRange = 0;
     Float maxRange = 0;
     Float step = 0;
+    MinMax range;
     Float giniIndexL = 0;
     Float giniIndexR = 0;
     Float weightL = 0;
     Float weightR = 0;
-    Vector< UINT > groupIndex(M);
+    UINT sampleIndex = 0;
+    UINT groupIndex = 0;
     VectorFloat groupCounter(2,0);
-    Vector< MinMax > ranges = trainingData.getRanges();
     
     MatrixFloat classProbabilities(K,2);
     
     //Loop over each feature and try and find the best split point
     for(UINT n=0; n<N; n++){
-        minRange = ranges[n].minValue;
-        maxRange = ranges[n].maxValue;
+        featureIndex = features[n];
+        range = trainingData.getRange( featureIndex, startIndex, endIndex );
+        minRange = range.minValue;
+        maxRange = range.maxValue;
         step = (maxRange-minRange)/Float(numSplittingSteps);
         threshold = minRange;
-        featureIndex = features[n];
         while( threshold <= maxRange ){
             
             //Iterate over each sample and work out if it should be in the lhs (0) or rhs (1) group
             groupCounter[0] = groupCounter[1] = 0;
             classProbabilities.setAllValues(0);
-            for(UINT i=0; i<M; i++){
-                groupIndex[i] = trainingData[ i ][ featureIndex ] >= threshold ? 1 : 0;
-                groupCounter[ groupIndex[i] ]++;
-                classProbabilities[ getClassLabelIndexValue(trainingData[i].getClassLabel(),classLabels) ][ groupIndex[i] ]++;
+            for(UINT i=startIndex; i<endIndex; i++){
+                sampleIndex = indexs[i];
+                groupIndex = trainingData.getValue( sampleIndex, featureIndex ) >= threshold ? 1 : 0;
+                groupCounter[ groupIndex ]++;
+                classProbabilities[ trainingData.getClassIndex( sampleIndex ) ][ groupIndex ]++;
             }
             
             //Compute the class probabilities for the lhs group and rhs group
@@ -194,14 +207,15 @@ bool DecisionTreeThresholdNode::computeBestSplitBestIterativeSplit( const UINT &
     featureIndex = bestFeatureIndex;
     
     //Store the node size, feature index, best threshold and class probabilities for this node
-    set(M,featureIndex,bestThreshold,trainingData.getClassProbabilities(classLabels));
+    set(M,featureIndex,bestThreshold,trainingData.getClassProbabilities( startIndex, endIndex ));
     
     return true;
 }
 
-bool DecisionTreeThresholdNode::computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
+bool DecisionTreeThresholdNode::computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
     
-    const UINT M = trainingData.getNumSamples();
+    const UINT M = endIndex - startIndex;
+    const Vector< UINT > &indexs = trainingData.getIndexs();
     const UINT N = (UINT)features.size();
     const UINT K = (UINT)classLabels.size();
     
@@ -215,8 +229,8 @@ bool DecisionTreeThresholdNode::computeBestSplitBestRandomSplit( const UINT &num
     Float giniIndexR = 0;
     Float weightL = 0;
     Float weightR = 0;
-    Random random;
-    Vector< UINT > groupIndex(M);
+    UINT sampleIndex = 0;
+    UINT groupIndex = 0;
     VectorFloat groupCounter(2,0);
     
     MatrixFloat classProbabilities(K,2);
@@ -230,15 +244,16 @@ bool DecisionTreeThresholdNode::computeBestSplitBestRandomSplit( const UINT &num
         featureIndex = features[n];
         
         //Randomly choose the threshold, the threshold is based on a randomly selected sample with some random scaling
-        threshold = trainingData[ random.getRandomNumberInt(0,M) ][ featureIndex ] * random.getRandomNumberUniform(0.8,1.2);
+        threshold = trainingData.getValue( indexs[ startIndex + random.getRandomNumberInt(0,M) ], featureIndex ) * random.getRandomNumberUniform(0.8,1.2);
         
         //Iterate over each sample and work out if it should be in the lhs (0) or rhs (1) group
         groupCounter[0] = groupCounter[1] = 0;
         classProbabilities.setAllValues(0);
-        for(UINT i=0; i<M; i++){
-            groupIndex[i] = trainingData[ i ][ featureIndex ] >= threshold ? 1 : 0;
-            groupCounter[ groupIndex[i] ]++;
-            classProbabilities[ getClassLabelIndexValue(trainingData[i].getClassLabel(),classLabels) ][ groupIndex[i] ]++;
+        for(UINT i=startIndex; i<endIndex; i++){
+            sampleIndex = indexs[i];
+            groupIndex = trainingData.getValue( sampleIndex, featureIndex ) >= threshold ? 1 : 0;
+            groupCounter[ groupIndex ]++;
+            classProbabilities[ trainingData.getClassIndex( sampleIndex ) ][ groupIndex ]++;
         }
         
         //Compute the class probabilities for the lhs group and rhs group
@@ -269,7 +284,89 @@ bool DecisionTreeThresholdNode::computeBestSplitBestRandomSplit( const UINT &num
     featureIndex = bestFeatureIndex;
     
     //Store the node size, feature index, best threshold and class probabilities for this node
-    set(M,featureIndex,bestThreshold,trainingData.getClassProbabilities(classLabels));
+    set(M,featureIndex,bestThreshold,trainingData.getClassProbabilities( startIndex, endIndex ));
+    
+    return true;
+}
+
+bool DecisionTreeThresholdNode::computeBestSplitBestHistogramSplit( const UINT &numSplittingSteps, DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
+    
+    const UINT M = endIndex - startIndex;
+    const UINT N = features.getSize();
+    const UINT K = classLabels.getSize();
+    
+    if( N == 0 ) return false;
+    
+    if( !trainingData.getBinsComputed() ){
+        errorLog << __GRT_LOG__ << " The bins of the training data have not been computed!" << std::endl;
+        return false;
+    }
+    
+    //Get the histogram of this node, each entry holds the number of samples in a bin followed by the number of samples of each class
+    const VectorFloat &histogram = trainingData.getHistogram( startIndex, endIndex );
+    const UINT stride = trainingData.getHistogramStride();
+    const UINT maxNumBins = trainingData.getMaxNumBins();
+    
+    Vector< UINT > classCounts;
+    trainingData.getClassCounts( startIndex, endIndex, classCounts );
+    
+    minError = grt_numeric_limits< Float >::max();
+    UINT bestFeatureIndex = 0;
+    Float bestThreshold = 0;
+    Float error = 0;
+    Float giniIndexL = 0;
+    Float giniIndexR = 0;
+    Float groupCounterL = 0;
+    Float groupCounterR = 0;
+    VectorFloat classCountsL( K );
+    
+    //Loop over each feature and test a split between each pair of neighbouring bins, the lhs group is every bin below the split
+    for(UINT n=0; n<N; n++){
+        featureIndex = features[n];
+        const UINT numBins = trainingData.getNumBins( featureIndex );
+        const Float *featureHistogram = &histogram[ featureIndex*maxNumBins*stride ];
+        
+        groupCounterL = 0;
+        std::fill( classCountsL.begin(), classCountsL.end(), 0 );
+        for(UINT b=1; b<numBins; b++){
+            const Float *entry = featureHistogram + (b-1)*stride;
+            if( entry[0] == 0 ) continue;
+            groupCounterL += entry[0];
+            for(UINT k=0; k<K; k++){
+                classCountsL[k] += entry[k+1];
+            }
+            groupCounterR = M - groupCounterL;
+            if( groupCounterR == 0 ) break;
+            
+            //Compute the weighted Gini index for the lhs and rhs groups
+            giniIndexL = giniIndexR = 1.0;
+            for(UINT k=0; k<K; k++){
+                const Float pL = classCountsL[k] / groupCounterL;
+                const Float pR = (classCounts[k] - classCountsL[k]) / groupCounterR;
+                giniIndexL -= pL * pL;
+                giniIndexR -= pR * pR;
+            }
+            error = (giniIndexL*groupCounterL + giniIndexR*groupCounterR) / M;
+            
+            //Store the best threshold and feature index
+            if( error < minError ){
+                minError = error;
+                bestThreshold = trainingData.getBinThreshold( featureIndex, b );
+                bestFeatureIndex = featureIndex;
+            }
+        }
+    }
+    
+    //If all the samples share a bin for every feature there is no split between the bins, so fall back to the exact search over the samples
+    if( minError == grt_numeric_limits< Float >::max() ){
+        return computeBestSplitBestIterativeSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
+    }
+    
+    //Set the best feature index that will be returned to the DecisionTree that called this function
+    featureIndex = bestFeatureIndex;
+    
+    //Store the node size, feature index, best threshold and class probabilities for this node
+    set(M,featureIndex,bestThreshold,trainingData.getClassProbabilities( startIndex, endIndex ));
     
     return true;
 }
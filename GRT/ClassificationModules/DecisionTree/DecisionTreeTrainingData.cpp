@@ -0,0 +1,91 @@
+#define GRT_DLL_EXPORTS
+#include "DecisionTreeTrainingData.h"
+
+GRT_BEGIN_NAMESPACE
+
+DecisionTreeTrainingData::DecisionTreeTrainingData(){
+    numClasses = 0;
+}
+
+DecisionTreeTrainingData::~DecisionTreeTrainingData(){
+}
+
+bool DecisionTreeTrainingData::set( const ClassificationDataView &trainingData, const Vector< UINT > &classLabels, const Vector< MinMax > &ranges ){
+
+    clear();
+
+    const UINT K = classLabels.getSize();
+    if( K == 0 ) return false;
+
+    const bool scaleData = ranges.getSize() > 0;
+    if( scaleData && ranges.getSize() != trainingData.getNumDimensions() ) return false;
+
+    //The statistics of each sample are its one-hot class Vector
+    if( !resize( trainingData.getNumSamples(), trainingData.getNumDimensions(), K ) ) return false;
+    numClasses = K;
+    classIndexs.resize( numSamples );
+    sampleStats.setAllValues( 0 );
+
+    //Transpose the data so the values of each feature are contiguous
+    for(UINT i=0; i<numSamples; i++){
+        const ClassificationSample &sample = trainingData[i];
+        for(UINT j=0; j<numDimensions; j++){
+            data[j][i] = scaleData ? grt_scale(sample[j], ranges[j].minValue, ranges[j].maxValue, 0.0, 1.0) : sample[j];
+        }
+
+        //Map the class label to its index in the class labels
+        const UINT classLabel = sample.getClassLabel();
+        UINT k = 0;
+        while( k < numClasses && classLabels[k] != classLabel ) k++;
+        if( k == numClasses ){
+            clear();
+            return false;
+        }
+        classIndexs[i] = k;
+        sampleStats[i][k] = 1;
+    }
+
+    return true;
+}
+
+bool DecisionTreeTrainingData::clear(){
+    TreeTrainingData::clear();
+    numClasses = 0;
+    classIndexs.clear();
+    return true;
+}
+
+UINT DecisionTreeTrainingData::getClassCounts( const UINT startIndex, const UINT endIndex, Vector< UINT > &classCounts ) const{
+
+    classCounts.resize( numClasses );
+    std::fill( classCounts.begin(), classCounts.end(), 0 );
+
+    for(UINT i=startIndex; i<endIndex; i++){
+        classCounts[ classIndexs[ indexs[i] ] ]++;
+    }
+
+    UINT numClassesInRange = 0;
+    for(UINT k=0; k<numClasses; k++){
+        if( classCounts[k] > 0 ) numClassesInRange++;
+    }
+
+    return numClassesInRange;
+}
+
+VectorFloat DecisionTreeTrainingData::getClassProbabilities( const UINT startIndex, const UINT endIndex ) const{
+
+    Vector< UINT > classCounts;
+    getClassCounts( startIndex, endIndex, classCounts );
+
+    VectorFloat classProbabilities( numClasses, 0 );
+    if( endIndex > startIndex ){
+        const Float norm = 1.0 / Float(endIndex-startIndex);
+        for(UINT k=0; k<numClasses; k++){
+            classProbabilities[k] = classCounts[k] * norm;
+        }
+    }
+
+    return classProbabilities;
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,107 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+ */
+
+/**
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef GRT_DECISION_TREE_TRAINING_DATA_HEADER
+#define GRT_DECISION_TREE_TRAINING_DATA_HEADER
+
+#include "../../DataStructures/ClassificationDataView.h"
+#include "../../CoreAlgorithms/Tree/TreeTrainingData.h"
+
+GRT_BEGIN_NAMESPACE
+
+/**
+ @brief This class holds the training data used to build a DecisionTree.
+
+ The class label of each sample is stored as an index into the class labels of the tree, and the statistics of each sample
+ are its one-hot class Vector, so the histogram of a node holds the number of samples of each class in each bin.
+ See TreeTrainingData for how the samples are stored and partitioned.
+*/
+class GRT_API DecisionTreeTrainingData : public TreeTrainingData{
+public:
+    /**
+     Default Constructor.
+     */
+    DecisionTreeTrainingData();
+
+    /**
+     Default Destructor.
+     */
+    virtual ~DecisionTreeTrainingData();
+
+    /**
+     Copies the training data into the column-major store and resets the sample index permutation.
+
+     @param trainingData: a view of the data that will be copied
+     @param classLabels: the class labels of the tree, the class index of each sample is its position in this Vector
+     @param ranges: if not empty, each value is scaled from the range of its dimension to [0 1] as it is copied, so the view does not need to be scaled first
+     @return returns true if the data was set, false otherwise
+     */
+    bool set( const ClassificationDataView &trainingData, const Vector< UINT > &classLabels, const Vector< MinMax > &ranges = Vector< MinMax >() );
+
+    /**
+     Clears the store.
+
+     @return returns true if the store was cleared, false otherwise
+     */
+    virtual bool clear();
+
+    /**
+     @return returns the number of classes
+     */
+    UINT getNumClasses() const{ return numClasses; }
+
+    /**
+     @param sampleIndex: the index of the sample in the original dataset
+     @return returns the class index of that sample
+     */
+    UINT getClassIndex( const UINT sampleIndex ) const{ return classIndexs[ sampleIndex ]; }
+
+    /**
+     Counts the samples of each class in the range [startIndex endIndex) of the index permutation.
+
+     @param startIndex: the start of the range
+     @param endIndex: the end of the range (not inclusive)
+     @param classCounts: returns the number of samples of each class
+     @return returns the number of classes with at least one sample in the range
+     */
+    UINT getClassCounts( const UINT startIndex, const UINT endIndex, Vector< UINT > &classCounts ) const;
+
+    /**
+     @param startIndex: the start of the range
+     @param endIndex: the end of the range (not inclusive)
+     @return returns the probability of each class in the range [startIndex endIndex) of the index permutation
+     */
+    VectorFloat getClassProbabilities( const UINT startIndex, const UINT endIndex ) const;
+
+protected:
+    UINT numClasses;
+    Vector< UINT > classIndexs;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_DECISION_TREE_TRAINING_DATA_HEADER
@@ -22,6 +22,16 @@ bool DecisionTreeTripleFeatureNode::predict_(VectorFloat &x) {
     return false;
 }
 
+bool DecisionTreeTripleFeatureNode::predictTrainingSample( const DecisionTreeTrainingData &trainingData, const UINT sampleIndex ) const{
+    const Float valueB = trainingData.getValue( sampleIndex, featureIndexB );
+    return (trainingData.getValue( sampleIndex, featureIndexA ) - valueB) >= (trainingData.getValue( sampleIndex, featureIndexC ) - valueB);
+}
+
+bool DecisionTreeTripleFeatureNode::flatten( FlatForest &flatForest, const UINT flatNodeIndex, const bool isLeaf ) const{
+    if( isLeaf ) return DecisionTreeNode::flatten( flatForest, flatNodeIndex, isLeaf );
+    return flatForest.setComparisonSplit( flatNodeIndex, featureIndexA, featureIndexB, featureIndexC );
+}
+
 bool DecisionTreeTripleFeatureNode::clear(){
     
     //Call the base class clear function
@@ -132,24 +142,24 @@ bool DecisionTreeTripleFeatureNode::set(const UINT nodeSize,const UINT featureIn
     return true;
 }
 
-bool DecisionTreeTripleFeatureNode::computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
-    return computeSplit( numSplittingSteps, trainingData, features, classLabels, featureIndex, minError);
+bool DecisionTreeTripleFeatureNode::computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
+    return computeSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
 }
 
-bool DecisionTreeTripleFeatureNode::computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
-    return computeSplit( numSplittingSteps, trainingData, features, classLabels, featureIndex, minError);
+bool DecisionTreeTripleFeatureNode::computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
+    return computeSplit( numSplittingSteps, trainingData, startIndex, endIndex, features, classLabels, featureIndex, minError, random );
 }
 
-bool DecisionTreeTripleFeatureNode::computeSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ){
+bool DecisionTreeTripleFeatureNode::computeSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ){
 
-    const UINT M = trainingData.getNumSamples();
+    const UINT M = endIndex - startIndex;
+    const Vector< UINT > &indexs = trainingData.getIndexs();
     const UINT N = features.getSize();
     const UINT K = classLabels.getSize();
     
     if( N == 0 ) return false;
     
     minError = grt_numeric_limits< Float >::max();
-    Random random;
     UINT bestFeatureIndexA = 0;
     UINT bestFeatureIndexB = 0;
     UINT bestFeatureIndexC = 0;
@@ -158,11 +168,10 @@ bool DecisionTreeTripleFeatureNode::computeSplit( const UINT &numSplittingSteps,
     Float giniIndexR = 0;
     Float weightL = 0;
     Float weightR = 0;
-    Vector< UINT > groupIndex(M);
+    UINT sampleIndex = 0;
+    UINT groupIndex = 0;
     VectorFloat groupCounter(2,0);
-    Vector< MinMax > ranges = trainingData.getRanges();
     MatrixFloat classProbabilities(K,2);
-    MatrixFloat data(M,1); //This will store our temporary data for each dimension
     
     //Randomly select which features we want to use
     UINT numRandomFeatures = numSplittingSteps > N ? N : numSplittingSteps;
@@ -179,10 +188,11 @@ bool DecisionTreeTripleFeatureNode::computeSplit( const UINT &numSplittingSteps,
         //Iterate over each sample and work out if it should be in the lhs (0) or rhs (1) group based on the current threshold
         groupCounter[0] = groupCounter[1] = 0;
         classProbabilities.setAllValues(0);
-        for(UINT i=0; i<M; i++){
-            groupIndex[i] = predict( trainingData[i].getSample() ) ? 1 : 0;
-            groupCounter[ groupIndex[i] ]++;
-            classProbabilities[ getClassLabelIndexValue(trainingData[i].getClassLabel(),classLabels) ][ groupIndex[i] ]++;
+        for(UINT i=startIndex; i<endIndex; i++){
+            sampleIndex = indexs[i];
+            groupIndex = predictTrainingSample( trainingData, sampleIndex ) ? 1 : 0;
+            groupCounter[ groupIndex ]++;
+            classProbabilities[ trainingData.getClassIndex( sampleIndex ) ][ groupIndex ]++;
         }
      
         //Compute the class probabilities for the lhs group and rhs group
@@ -216,7 +226,7 @@ bool DecisionTreeTripleFeatureNode::computeSplit( const UINT &numSplittingSteps,
      featureIndex = bestFeatureIndexB;
      
      //Store the node size, feature indexs and class probabilities for this node
-     set(M,bestFeatureIndexA,bestFeatureIndexB,bestFeatureIndexC,trainingData.getClassProbabilities(classLabels));
+     set(M,bestFeatureIndexA,bestFeatureIndexB,bestFeatureIndexC,trainingData.getClassProbabilities( startIndex, endIndex ));
 
      return true;
 }
@@ -58,6 +58,26 @@ public:
      */
     virtual bool predict_(VectorFloat &x) override;
     
+    /**
+     This function returns true if the sample in the training data should go to the right child of this node, using the same rule as predict_.
+     
+     @param trainingData: the training data the sample is in
+     @param sampleIndex: the index of the sample in the training data
+     @return returns true if the sample should go to the right child, false otherwise
+     */
+    virtual bool predictTrainingSample( const DecisionTreeTrainingData &trainingData, const UINT sampleIndex ) const override;
+    
+    /**
+     This function writes this node into a FlatForest, as a leaf holding the class probabilities of the node if isLeaf is true,
+     otherwise as a comparison split on the three feature indexs of the node.
+     
+     @param flatForest: the flat forest the node will be written to
+     @param flatNodeIndex: the index of the node in the flat forest
+     @param isLeaf: if true, the node is written as a leaf
+     @return returns true if the node was written, false otherwise
+     */
+    virtual bool flatten( FlatForest &flatForest, const UINT flatNodeIndex, const bool isLeaf ) const override;
+    
     /**
      This functions cleans up any dynamic memory assigned by the node.
      It will recursively clear the memory for the left and right child nodes.
@@ -128,11 +148,11 @@ public:
     
 protected:
     
-    virtual bool computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ) override;
+    virtual bool computeBestSplitBestIterativeSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ) override;
     
-    virtual bool computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError ) override;
+    virtual bool computeBestSplitBestRandomSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random ) override;
     
-    bool computeSplit( const UINT &numSplittingSteps, const ClassificationData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError );
+    bool computeSplit( const UINT &numSplittingSteps, const DecisionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &minError, Random &random );
     
     /**
      This saves the DecisionTreeNode custom parameters to a file. It will be called automatically by the Node base class
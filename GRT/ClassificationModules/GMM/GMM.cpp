@@ -145,6 +145,13 @@ bool GMM::predict_(VectorFloat &x){
 
 bool GMM::train_(ClassificationData &trainingData){
     
+    //The GMM model does not need to modify the training data, so it is trained from a view of the data rather than a copy
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool GMM::train_(ClassificationDataView &trainingData){
+    
     //Clear any old models
     clear();
     
@@ -153,11 +160,7 @@ bool GMM::train_(ClassificationData &trainingData){
         return false;
     }
     
-    //Set the number of features and number of classes and resize the models buffer
     numInputDimensions = trainingData.getNumDimensions();
-    numOutputDimensions = trainingData.getNumClasses();
-    numClasses = trainingData.getNumClasses();
-    models.resize(numClasses);
     
     if( numInputDimensions >= 6 ){
         warningLog << __GRT_LOG__ << " The number of features in your training data is high (" << numInputDimensions << ").  The GMMClassifier does not work well with high dimensional data, you might get better results from one of the other classifiers." << std::endl;
@@ -166,25 +169,27 @@ bool GMM::train_(ClassificationData &trainingData){
     //Get the ranges of the training data if the training data is going to be scaled
     ranges = trainingData.getRanges();
 
-    ClassificationData validationData;
-    
-    //Scale the training data if needed
-    if( useScaling ){
-        //Scale the training data between 0 and 1
-        if( !trainingData.scale(GMM_MIN_SCALE_VALUE, GMM_MAX_SCALE_VALUE) ){
-            errorLog << __GRT_LOG__ << " Failed to scale training data!" << std::endl;
-            return false;
-        }
-    }
+    ClassificationDataView validationData;
 
     if( useValidationSet ){
-        validationData = trainingData.split( 100-validationSetSize );
+        validationData = trainingData.split( 100-validationSetSize, false, random );
     }
+
+    //A model can only be fitted to a class with samples, so drop any class that has no samples in the view (or was moved to the validation set)
+    trainingData.removeEmptyClasses();
+    
+    //Set the number of classes and resize the models buffer
+    numOutputDimensions = trainingData.getNumClasses();
+    numClasses = trainingData.getNumClasses();
+    models.resize(numClasses);
     
     //Fit a Mixture Model to each class (independently)
     for(UINT k=0; k<numClasses; k++){
         UINT classLabel = trainingData.getClassTracker()[k].classLabel;
-        ClassificationData classData = trainingData.getClassData( classLabel );
+        
+        //Copy the training data for this class into a matrix, scaling it if needed, this is the only copy of the training data that is made
+        ClassificationDataView classView = trainingData.getClassView( classLabel );
+        MatrixFloat classData = useScaling ? classView.getDataAsMatrixFloat( ranges, GMM_MIN_SCALE_VALUE, GMM_MAX_SCALE_VALUE ) : classView.getDataAsMatrixFloat();
         
         //Train the Mixture Model for this class
         GaussianMixtureModels gaussianMixtureModel;
@@ -193,7 +198,7 @@ bool GMM::train_(ClassificationData &trainingData){
         gaussianMixtureModel.setMaxNumEpochs( maxNumEpochs );
         gaussianMixtureModel.setNumRestarts( numRestarts ); //The learning algorithm can retry building a model up to N times
         
-        if( !gaussianMixtureModel.train( classData.getDataAsMatrixFloat() ) ){
+        if( !gaussianMixtureModel.train( classData ) ){
             errorLog << __GRT_LOG__ << " Failed to train Mixture Model for class " << classLabel << std::endl;
             return false;
         }
@@ -223,20 +228,20 @@ bool GMM::train_(ClassificationData &trainingData){
         //Compute the rejection thresholds
         Float mu = 0;
         Float sigma = 0;
-        VectorFloat predictionResults(classData.getNumSamples(),0);
-        for(UINT i=0; i<classData.getNumSamples(); i++){
-            VectorFloat sample = classData[i].getSample();
+        VectorFloat predictionResults(classData.getNumRows(),0);
+        for(UINT i=0; i<classData.getNumRows(); i++){
+            VectorFloat sample = classData.getRow(i);
             predictionResults[i] = models[k].computeMixtureLikelihood( sample );
             mu += predictionResults[i];
         }
         
         //Update mu
-        mu /= Float( classData.getNumSamples() );
+        mu /= Float( classData.getNumRows() );
         
         //Calculate the standard deviation
-        for(UINT i=0; i<classData.getNumSamples(); i++)
+        for(UINT i=0; i<classData.getNumRows(); i++)
         sigma += grt_sqr( (predictionResults[i]-mu) );
-        sigma = grt_sqrt( sigma / (Float(classData.getNumSamples())-1.0) );
+        sigma = grt_sqrt( sigma / (Float(classData.getNumRows())-1.0) );
         sigma = 0.2;
         
         //Set the models training mu and sigma
@@ -266,13 +271,10 @@ bool GMM::train_(ClassificationData &trainingData){
     trained = true;
     converged = true;
 
-    //Compute the final training stats
+    //Compute the final training stats, the view has not been scaled so the model scales each sample as it is tested
     trainingSetAccuracy = 0;
     validationSetAccuracy = 0;
 
-    //If scaling was on, then the data will already be scaled, so turn it off temporially so we can test the model accuracy
-    bool scalingState = useScaling;
-    useScaling = false;
     if( !computeAccuracy( trainingData, trainingSetAccuracy ) ){
         trained = false;
         converged = false;
@@ -295,9 +297,6 @@ bool GMM::train_(ClassificationData &trainingData){
     if( useValidationSet ){
         trainingLog << "Validation set accuracy: " << validationSetAccuracy << std::endl;
     }
-
-    //Reset the scaling state for future prediction
-    useScaling = scalingState;
     
     return trained;
 }
@@ -34,6 +34,7 @@ ContinuousHiddenMarkovModel::ContinuousHiddenMarkovModel(const UINT downsampleFa
     this->autoEstimateSigma = autoEstimateSigma;
     this->sigma = sigma;
     modelType = HMMModelTypes::HMM_LEFTRIGHT;
+    predictionMode = HMM_SLIDING_WINDOW;
     cThreshold = 0;
     useScaling = false;
 }
@@ -59,6 +60,28 @@ ContinuousHiddenMarkovModel::ContinuousHiddenMarkovModel(const ContinuousHiddenM
     this->delta = rhs.delta;
     this->loglikelihood = rhs.loglikelihood;
     this->cThreshold = rhs.cThreshold;
+    this->predictionMode = rhs.predictionMode;
+    this->windowEmissions = rhs.windowEmissions;
+    this->windowEmissionsHead = rhs.windowEmissionsHead;
+    this->windowEmissionsValid = rhs.windowEmissionsValid;
+    this->windowFrontAlpha = rhs.windowFrontAlpha;
+    this->windowFrontLogScale = rhs.windowFrontLogScale;
+    this->windowFrontStart = rhs.windowFrontStart;
+    this->windowBackProduct = rhs.windowBackProduct;
+    this->windowBackLogScale = rhs.windowBackLogScale;
+    this->windowPhase = rhs.windowPhase;
+    this->transitionStart = rhs.transitionStart;
+    this->transitionEnd = rhs.transitionEnd;
+    this->onlineAlpha = rhs.onlineAlpha;
+    this->onlineSampleCounter = rhs.onlineSampleCounter;
+    this->onlineObservationCounter = rhs.onlineObservationCounter;
+    this->observation = rhs.observation;
+    this->logNormalisers = rhs.logNormalisers;
+    this->stateMeans = rhs.stateMeans;
+    this->stateInverseVariances = rhs.stateInverseVariances;
+    
+    const MLBase *basePointer = &rhs;
+    this->copyMLBaseVariables( basePointer );
 }
 
 //Default destructor
@@ -88,6 +111,25 @@ ContinuousHiddenMarkovModel& ContinuousHiddenMarkovModel::operator=(const Contin
         this->delta = rhs.delta;
         this->loglikelihood = rhs.loglikelihood;
         this->cThreshold = rhs.cThreshold;
+        this->predictionMode = rhs.predictionMode;
+        this->windowEmissions = rhs.windowEmissions;
+        this->windowEmissionsHead = rhs.windowEmissionsHead;
+        this->windowEmissionsValid = rhs.windowEmissionsValid;
+        this->windowFrontAlpha = rhs.windowFrontAlpha;
+        this->windowFrontLogScale = rhs.windowFrontLogScale;
+        this->windowFrontStart = rhs.windowFrontStart;
+        this->windowBackProduct = rhs.windowBackProduct;
+        this->windowBackLogScale = rhs.windowBackLogScale;
+        this->windowPhase = rhs.windowPhase;
+        this->transitionStart = rhs.transitionStart;
+        this->transitionEnd = rhs.transitionEnd;
+        this->onlineAlpha = rhs.onlineAlpha;
+        this->onlineSampleCounter = rhs.onlineSampleCounter;
+        this->onlineObservationCounter = rhs.onlineObservationCounter;
+        this->observation = rhs.observation;
+        this->logNormalisers = rhs.logNormalisers;
+        this->stateMeans = rhs.stateMeans;
+        this->stateInverseVariances = rhs.stateInverseVariances;
         
         const MLBase *basePointer = &rhs;
         this->copyMLBaseVariables( basePointer );
@@ -108,17 +150,37 @@ bool ContinuousHiddenMarkovModel::predict_(VectorFloat &x){
         return false;
     }
     
-    //Add the new sample to the circular buffer
+    if( predictionMode == HMM_ONLINE ){
+        return predictOnline( x );
+    }
+    
+    //Add the new sample to the circular buffer, the window only slides by one sample if the buffer was already full
+    const bool bufferFilled = observationSequence.getBufferFilled();
     observationSequence.push_back( x );
     
-    //Convert the circular buffer to MatrixFloat
-    for(unsigned int i=0; i<observationSequence.getSize(); i++){
-        for(unsigned int j=0; j<numInputDimensions; j++){
-            obsSequence[i][j] = observationSequence[i][j];
+    //Downsample the window using the same downsample factor of the training data
+    const unsigned int L = observationSequence.getSize();
+    const unsigned int T = downsampleFactor < L ? (unsigned int)floor( L / Float(downsampleFactor) ) : L;
+    const unsigned int K = downsampleFactor < L ? downsampleFactor : 1;
+    
+    //The downsampled observation that starts j*K samples into the window is the same observation that started (T-1)*K samples into the
+    //window (T-1-j)*K samples ago, so the emissions of the last (T-1)*K+1 observations are stored and only the newest one is computed
+    const unsigned int numWindowObservations = (T-1)*K+1;
+    bool windowEmissionsRebuilt = false;
+    if( !bufferFilled || !windowEmissionsValid || windowEmissions.getNumRows() != numWindowObservations ){
+        windowEmissions.resize( numWindowObservations, numStates );
+        for(unsigned int i=0; i<numWindowObservations; i++){
+            computeWindowEmissions( i, K, windowEmissions[i] );
         }
+        windowEmissionsHead = 0;
+        windowEmissionsValid = true;
+        windowEmissionsRebuilt = true;
+    }else{
+        computeWindowEmissions( (T-1)*K, K, windowEmissions[ windowEmissionsHead ] );
+        windowEmissionsHead = (windowEmissionsHead+1) % numWindowObservations;
     }
     
-    return predict_( obsSequence );
+    return predictWindow( T, K, windowEmissionsRebuilt );
 }
 
 bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
@@ -133,8 +195,7 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
         return false;
     }
     
-    unsigned int t,i,j,k,index = 0;
-    Float maxAlpha = 0;
+    unsigned int i,j,k,index = 0;
     Float norm = 0;
     
     //Downsample the observation timeseries using the same downsample factor of the training data
@@ -158,6 +219,263 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
         }
     }
     
+    //Compute the emissions of each state for each observation
+    if( emissions.getNumRows() != T || emissions.getNumCols() != numStates ) emissions.resize(T,numStates);
+    for(unsigned int t=0; t<T; t++){
+        computeEmissions( obs[t], emissions[t] );
+    }
+    
+    return forward( T );
+}
+
+bool ContinuousHiddenMarkovModel::predictOnline( const VectorFloat &x ){
+    
+    //Add the sample to the current downsampled observation
+    if( observation.getSize() != numInputDimensions ) observation.resize( numInputDimensions, 0 );
+    if( onlineSampleCounter == 0 ) observation.setAll( 0 );
+    for(unsigned int j=0; j<numInputDimensions; j++){
+        observation[j] += x[j];
+    }
+    
+    //Wait until the observation is complete, the last result stays valid until then
+    if( ++onlineSampleCounter < downsampleFactor ){
+        return true;
+    }
+    onlineSampleCounter = 0;
+    
+    if( downsampleFactor > 1 ){
+        for(unsigned int j=0; j<numInputDimensions; j++){
+            observation[j] /= Float(downsampleFactor);
+        }
+    }
+    
+    if( emissions.getNumRows() != 1 || emissions.getNumCols() != numStates ) emissions.resize(1,numStates);
+    if( alpha.getNumRows() != 1 || alpha.getNumCols() != numStates ) alpha.resize(1,numStates);
+    if( onlineAlpha.getSize() != numStates ) onlineAlpha.resize( numStates );
+    computeEmissions( observation.getData(), emissions[0] );
+    const Float logOffset = scaleEmissions( emissions[0] );
+    
+    //Update the forward variables with the new observation, starting from pi for the first observation since the last reset
+    const Float *e = &scaledEmissions[0];
+    Float *currentAlpha = alpha[0];
+    Float sum = 0;
+    if( onlineObservationCounter == 0 ){
+        for(unsigned int i=0; i<numStates; i++){
+            onlineAlpha[i] = pi[i]*e[i];
+            sum += onlineAlpha[i];
+        }
+    }else{
+        for(unsigned int j=0; j<numStates; j++){
+            onlineAlpha[j] = 0.0;
+            for(unsigned int i=transitionStart[j]; i<transitionEnd[j]; i++){
+                onlineAlpha[j] += currentAlpha[i] * a[i][j];
+            }
+            onlineAlpha[j] *= e[j];
+            sum += onlineAlpha[j];
+        }
+    }
+    onlineObservationCounter++;
+    
+    //Scale alpha and keep track of the best state
+    const Float scale = 1.0/sum;
+    Float maxAlpha = 0;
+    unsigned int bestState = 0;
+    for(unsigned int i=0; i<numStates; i++){
+        currentAlpha[i] = onlineAlpha[i] * scale;
+        if( currentAlpha[i] > maxAlpha ){
+            maxAlpha = currentAlpha[i];
+            bestState = i;
+        }
+    }
+    
+    //The loglikelihood is the sum over all the observations since the last reset
+    loglikelihood += logOffset - log( scale );
+    phase = (bestState+1.0)/Float(numStates);
+    
+    return true;
+}
+
+bool ContinuousHiddenMarkovModel::predictWindow( const unsigned int T, const unsigned int K, const bool windowEmissionsRebuilt ){
+    
+    //The windows that start K samples apart share all but one observation, so each of the K downsampling phases keeps its own forward
+    //recursion. The recursion of a phase is split at an anchor, the newest observation when the phase was last anchored: the forward
+    //variables from each observation before the anchor up to the anchor are computed once, and the product of the transitions and
+    //emissions after the anchor is updated with each new observation. The loglikelihood of the window is then the forward variables of
+    //its oldest observation multiplied by that product, which gives the same result as running the forward algorithm over the window.
+    if( windowEmissionsRebuilt || windowFrontStart.getSize() != K || windowFrontAlpha.getNumRows() != K*T || windowFrontAlpha.getNumCols() != numStates ){
+        windowFrontAlpha.resize( K*T, numStates );
+        windowFrontLogScale.resize( K*T );
+        windowFrontStart.resize( K );
+        windowBackProduct.resize( K*numStates, numStates );
+        windowBackLogScale.resize( K );
+        
+        //Flag that every phase needs to be anchored
+        std::fill( windowFrontStart.begin(), windowFrontStart.end(), T );
+        windowPhase = 0;
+    }
+    
+    const unsigned int phaseIndex = windowPhase;
+    windowPhase = (windowPhase+1) % K;
+    
+    //Drop the oldest observation of this phase, once every observation before the anchor has been dropped the newest observation
+    //becomes the new anchor, so the cost of anchoring a phase is spread over the next T windows of that phase
+    if( ++windowFrontStart[ phaseIndex ] >= T ){
+        anchorWindowPhase( phaseIndex, T, K );
+    }else{
+        pushWindowPhase( phaseIndex, T, K );
+    }
+    
+    //Multiply the forward variables of the oldest observation by the product since the anchor to get the forward variables of the newest observation
+    if( alpha.getNumRows() != 1 || alpha.getNumCols() != numStates ) alpha.resize(1,numStates);
+    const unsigned int frontIndex = phaseIndex*T + windowFrontStart[ phaseIndex ];
+    const Float *frontAlpha = windowFrontAlpha[ frontIndex ];
+    Float *currentAlpha = alpha[0];
+    std::fill( currentAlpha, currentAlpha+numStates, 0 );
+    for(unsigned int i=0; i<numStates; i++){
+        if( frontAlpha[i] == 0 ) continue;
+        const Float *product = windowBackProduct[ phaseIndex*numStates + i ];
+        for(unsigned int j=0; j<numStates; j++){
+            currentAlpha[j] += frontAlpha[i] * product[j];
+        }
+    }
+    
+    //Scale alpha and keep track of the best state
+    Float sum = 0;
+    Float maxAlpha = 0;
+    unsigned int bestState = 0;
+    for(unsigned int i=0; i<numStates; i++){
+        sum += currentAlpha[i];
+        if( currentAlpha[i] > maxAlpha ){
+            maxAlpha = currentAlpha[i];
+            bestState = i;
+        }
+    }
+    if( sum > 0 ){
+        for(unsigned int i=0; i<numStates; i++) currentAlpha[i] /= sum;
+    }
+    
+    loglikelihood = log( sum ) + windowFrontLogScale[ frontIndex ] + windowBackLogScale[ phaseIndex ];
+    phase = (bestState+1.0)/Float(numStates);
+    
+    return true;
+}
+
+void ContinuousHiddenMarkovModel::anchorWindowPhase( const unsigned int phaseIndex, const unsigned int T, const unsigned int K ){
+    
+    const unsigned int numWindowObservations = windowEmissions.getNumRows();
+    if( windowProduct.getNumRows() != numStates || windowProduct.getNumCols() != numStates ) windowProduct.resize( numStates, numStates );
+    if( windowProductBuffer.getNumRows() != numStates || windowProductBuffer.getNumCols() != numStates ) windowProductBuffer.resize( numStates, numStates );
+    
+    //The product of the transitions and emissions from observation s+1 up to the anchor is built backwards from the identity matrix,
+    //and is scaled by its largest value at each step so it can not underflow
+    MatrixFloat *product = &windowProduct;
+    MatrixFloat *nextProduct = &windowProductBuffer;
+    product->setAllValues( 0 );
+    for(unsigned int i=0; i<numStates; i++) (*product)[i][i] = 1;
+    Float productLogScale = 0;
+    
+    for(unsigned int s=T; s-- > 0; ){
+        const Float logOffset = scaleEmissions( windowEmissions[ (windowEmissionsHead + s*K) % numWindowObservations ] );
+        
+        //The forward variables at the anchor of a window that starts at observation s
+        Float *frontAlpha = windowFrontAlpha[ phaseIndex*T + s ];
+        std::fill( frontAlpha, frontAlpha+numStates, 0 );
+        Float sum = 0;
+        for(unsigned int i=0; i<numStates; i++){
+            const Float weight = pi[i]*scaledEmissions[i];
+            if( weight == 0 ) continue;
+            const Float *productRow = (*product)[i];
+            for(unsigned int j=0; j<numStates; j++){
+                frontAlpha[j] += weight * productRow[j];
+            }
+        }
+        for(unsigned int j=0; j<numStates; j++) sum += frontAlpha[j];
+        if( sum > 0 ){
+            for(unsigned int j=0; j<numStates; j++) frontAlpha[j] /= sum;
+        }
+        windowFrontLogScale[ phaseIndex*T + s ] = productLogScale + logOffset + log( sum );
+        
+        if( s == 0 ) break;
+        
+        //Move the start of the product back by one observation, only the states that can transition into state j are summed
+        nextProduct->setAllValues( 0 );
+        for(unsigned int j=0; j<numStates; j++){
+            const Float emission = scaledEmissions[j];
+            if( emission == 0 ) continue;
+            const Float *productRow = (*product)[j];
+            for(unsigned int i=transitionStart[j]; i<transitionEnd[j]; i++){
+                const Float weight = a[i][j] * emission;
+                Float *nextRow = (*nextProduct)[i];
+                for(unsigned int k=0; k<numStates; k++){
+                    nextRow[k] += weight * productRow[k];
+                }
+            }
+        }
+        std::swap( product, nextProduct );
+        
+        Float maxValue = 0;
+        for(unsigned int i=0; i<numStates; i++){
+            for(unsigned int k=0; k<numStates; k++){
+                if( (*product)[i][k] > maxValue ) maxValue = (*product)[i][k];
+            }
+        }
+        if( maxValue > 0 ){
+            for(unsigned int i=0; i<numStates; i++){
+                for(unsigned int k=0; k<numStates; k++) (*product)[i][k] /= maxValue;
+            }
+        }
+        productLogScale += logOffset + log( maxValue );
+    }
+    
+    //Nothing has been added since the anchor, so the product after the anchor is the identity matrix
+    for(unsigned int i=0; i<numStates; i++){
+        Float *backRow = windowBackProduct[ phaseIndex*numStates + i ];
+        std::fill( backRow, backRow+numStates, 0 );
+        backRow[i] = 1;
+    }
+    windowBackLogScale[ phaseIndex ] = 0;
+    windowFrontStart[ phaseIndex ] = 0;
+}
+
+void ContinuousHiddenMarkovModel::pushWindowPhase( const unsigned int phaseIndex, const unsigned int T, const unsigned int K ){
+    
+    //Multiply the product since the anchor by the transitions and emissions of the newest observation
+    const unsigned int numWindowObservations = windowEmissions.getNumRows();
+    const Float logOffset = scaleEmissions( windowEmissions[ (windowEmissionsHead + (T-1)*K) % numWindowObservations ] );
+    if( windowAlpha.getSize() != numStates ) windowAlpha.resize( numStates );
+    
+    Float maxValue = 0;
+    for(unsigned int r=0; r<numStates; r++){
+        Float *backRow = windowBackProduct[ phaseIndex*numStates + r ];
+        for(unsigned int j=0; j<numStates; j++){
+            windowAlpha[j] = 0;
+            for(unsigned int i=transitionStart[j]; i<transitionEnd[j]; i++){
+                windowAlpha[j] += backRow[i] * a[i][j];
+            }
+            windowAlpha[j] *= scaledEmissions[j];
+        }
+        for(unsigned int j=0; j<numStates; j++){
+            backRow[j] = windowAlpha[j];
+            if( backRow[j] > maxValue ) maxValue = backRow[j];
+        }
+    }
+    
+    //Scale the product by its largest value so it can not underflow
+    if( maxValue > 0 ){
+        for(unsigned int r=0; r<numStates; r++){
+            Float *backRow = windowBackProduct[ phaseIndex*numStates + r ];
+            for(unsigned int j=0; j<numStates; j++) backRow[j] /= maxValue;
+        }
+    }
+    windowBackLogScale[ phaseIndex ] += logOffset + log( maxValue );
+}
+
+bool ContinuousHiddenMarkovModel::forward( const unsigned int T ){
+    
+    unsigned int t,i,j = 0;
+    Float maxAlpha = 0;
+    Float logOffset = 0;
+    
     //Resize alpha, c, and the estimated states vector as needed
     if( alpha.getNumRows() != T || alpha.getNumCols() != numStates ) alpha.resize(T,numStates);
     if( (unsigned int)c.size() != T ) c.resize(T);
@@ -168,8 +486,9 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
     t = 0;
     c[t] = 0;
     maxAlpha = 0;
+    logOffset += scaleEmissions( emissions[t] );
     for(i=0; i<numStates; i++){
-        alpha[t][i] = pi[i]*gauss(b,obs,sigmaStates,i,t,numInputDimensions);
+        alpha[t][i] = pi[i]*scaledEmissions[i];
         c[t] += alpha[t][i];
         
         //Keep track of the best state at time t
@@ -185,16 +504,17 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
     //Scale alpha
     for(i=0; i<numStates; i++) alpha[t][i] *= c[t];
     
-    //Step 2: Induction
+    //Step 2: Induction, only the states that can transition into state j are summed
     for(t=1; t<T; t++){
         c[t] = 0.0;
         maxAlpha = 0;
+        logOffset += scaleEmissions( emissions[t] );
         for(j=0; j<numStates; j++){
             alpha[t][j] = 0.0;
-            for(i=0; i<numStates; i++){
+            for(i=transitionStart[j]; i<transitionEnd[j]; i++){
                 alpha[t][j] +=  alpha[t-1][i] * a[i][j];
             }
-            alpha[t][j] *= gauss(b,obs,sigmaStates,j,t,numInputDimensions);
+            alpha[t][j] *= scaledEmissions[j];
             c[t] += alpha[t][j];
             
             //Keep track of the best state at time t
@@ -211,10 +531,10 @@ bool ContinuousHiddenMarkovModel::predict_( MatrixFloat &timeseries ){
         for(j=0; j<numStates; j++) alpha[t][j] *= c[t];
     }
     
-    //Termination
+    //Termination, the emissions at each step were scaled by exp(-offset) so the offsets are added back
     loglikelihood = 0.0;
     for(t=0; t<T; t++) loglikelihood += log( c[t] );
-    loglikelihood = -loglikelihood; //Store the negative log likelihood
+    loglikelihood = logOffset - loglikelihood; //Store the negative log likelihood
     
     //Set the phase as the last estimated state, this will give a phase between [0 1]
     phase = (estimatedStates[T-1]+1.0)/Float(numStates);
@@ -351,6 +671,9 @@ bool ContinuousHiddenMarkovModel::train_(TimeSeriesClassificationSample &trainin
     observationSequence.resize( timeseriesLength, VectorFloat(numInputDimensions,0) );
     obsSequence.resize(timeseriesLength,numInputDimensions);
     estimatedStates.resize( numStates );
+    windowEmissionsValid = false;
+    computeTransitionRanges();
+    computeEmissionParameters();
     
     //Finally, flag that the model was trained
     trained = true;
@@ -369,6 +692,12 @@ bool ContinuousHiddenMarkovModel::reset(){
         }
     }
     
+    //Reset the streaming state, the cached window emissions are rebuilt on the next prediction
+    windowEmissionsValid = false;
+    onlineSampleCounter = 0;
+    onlineObservationCounter = 0;
+    if( predictionMode == HMM_ONLINE ) loglikelihood = 0;
+    
     return true;
 }
 
@@ -389,6 +718,29 @@ bool ContinuousHiddenMarkovModel::clear(){
     obsSequence.clear();
     estimatedStates.clear();
     sigmaStates.clear();
+    emissions.clear();
+    windowEmissions.clear();
+    windowEmissionsHead = 0;
+    windowEmissionsValid = false;
+    windowFrontAlpha.clear();
+    windowFrontLogScale.clear();
+    windowFrontStart.clear();
+    windowBackProduct.clear();
+    windowBackLogScale.clear();
+    windowProduct.clear();
+    windowProductBuffer.clear();
+    windowAlpha.clear();
+    windowPhase = 0;
+    transitionStart.clear();
+    transitionEnd.clear();
+    observation.clear();
+    onlineAlpha.clear();
+    logNormalisers.clear();
+    stateMeans.clear();
+    stateInverseVariances.clear();
+    scaledEmissions.clear();
+    onlineSampleCounter = 0;
+    onlineObservationCounter = 0;
     
     return true;
 }
@@ -478,6 +830,8 @@ bool ContinuousHiddenMarkovModel::setSigma(const Float sigma){
         
         if( !autoEstimateSigma && trained ){
             sigmaStates.setAllValues(sigma);
+            computeEmissionParameters();
+            windowEmissionsValid = false;
         }
         return true;
     }
@@ -494,12 +848,92 @@ bool ContinuousHiddenMarkovModel::setAutoEstimateSigma(const bool autoEstimateSi
     return true;
 }
 
-Float ContinuousHiddenMarkovModel::gauss( const MatrixFloat &x, const MatrixFloat &y, const MatrixFloat &sigma, const unsigned int i,const unsigned int j,const unsigned int N ){
-    Float z = 1;
-    for(unsigned int n=0; n<N; n++){
-        z *= (1.0/( sigma[i][n] * SQRT_TWO_PI )) * exp( - SQR(x[i][n]-y[j][n])/(2.0*SQR(sigma[i][n])) );
+bool ContinuousHiddenMarkovModel::setPredictionMode(const UINT predictionMode){
+    if( predictionMode == HMM_SLIDING_WINDOW || predictionMode == HMM_ONLINE ){
+        this->predictionMode = predictionMode;
+        reset();
+        return true;
+    }
+    warningLog << "setPredictionMode(const UINT predictionMode) - Unknown prediction mode: " << predictionMode << std::endl;
+    return false;
+}
+
+void ContinuousHiddenMarkovModel::computeEmissionParameters(){
+    
+    //The Gaussian of each state only depends on b and sigmaStates, so the normalisation constants are computed once in log space
+    logNormalisers.resize( numStates );
+    stateMeans.resize( numInputDimensions, numStates );
+    stateInverseVariances.resize( numInputDimensions, numStates );
+    for(unsigned int i=0; i<numStates; i++){
+        logNormalisers[i] = 0;
+        for(unsigned int n=0; n<numInputDimensions; n++){
+            logNormalisers[i] -= log( sigmaStates[i][n] * SQRT_TWO_PI );
+            stateMeans[n][i] = b[i][n];
+            stateInverseVariances[n][i] = 1.0 / (2.0*SQR(sigmaStates[i][n]));
+        }
+    }
+}
+
+void ContinuousHiddenMarkovModel::computeEmissions( const Float *observation, Float *stateEmissions ) const{
+    
+    //Compute the log emission of every state, the inner loop runs over the states so it has no dependencies between iterations
+    std::copy( logNormalisers.begin(), logNormalisers.end(), stateEmissions );
+    for(unsigned int n=0; n<numInputDimensions; n++){
+        const Float x = observation[n];
+        const Float *mu = stateMeans[n];
+        const Float *inverseVariance = stateInverseVariances[n];
+        for(unsigned int i=0; i<numStates; i++){
+            const Float diff = x - mu[i];
+            stateEmissions[i] -= diff * diff * inverseVariance[i];
+        }
+    }
+}
+
+Float ContinuousHiddenMarkovModel::scaleEmissions( const Float *stateEmissions ){
+    
+    //Scale the emissions by the most likely state before leaving log space, so the emissions can not all underflow to zero
+    if( scaledEmissions.getSize() != numStates ) scaledEmissions.resize( numStates );
+    Float maxEmission = stateEmissions[0];
+    for(unsigned int i=1; i<numStates; i++){
+        if( stateEmissions[i] > maxEmission ) maxEmission = stateEmissions[i];
+    }
+    for(unsigned int i=0; i<numStates; i++){
+        scaledEmissions[i] = exp( stateEmissions[i] - maxEmission );
+    }
+    return maxEmission;
+}
+
+void ContinuousHiddenMarkovModel::computeWindowEmissions( const unsigned int start, const unsigned int K, Float *stateEmissions ){
+    
+    //Average the K samples starting at the start of the window in the same order as predict_( MatrixFloat &timeseries )
+    if( observation.getSize() != numInputDimensions ) observation.resize( numInputDimensions );
+    for(unsigned int j=0; j<numInputDimensions; j++){
+        observation[j] = 0;
+        for(unsigned int k=0; k<K; k++){
+            observation[j] += observationSequence[start+k][j];
+        }
+        if( K > 1 ) observation[j] /= Float(K);
+    }
+    
+    computeEmissions( observation.getData(), stateEmissions );
+}
+
+void ContinuousHiddenMarkovModel::computeTransitionRanges(){
+    
+    //Find the range of states that can transition into each state, a left-right model only has a narrow band of non-zero transitions
+    transitionStart.resize( numStates );
+    transitionEnd.resize( numStates );
+    for(unsigned int j=0; j<numStates; j++){
+        transitionStart[j] = numStates;
+        transitionEnd[j] = 0;
+        for(unsigned int i=0; i<numStates; i++){
+            if( a[i][j] != 0 ){
+                if( transitionStart[j] == numStates ) transitionStart[j] = i;
+                transitionEnd[j] = i+1;
+            }
+        }
+        if( transitionStart[j] > transitionEnd[j] ) transitionStart[j] = transitionEnd[j];
     }
-    return z;
 }
 
 bool ContinuousHiddenMarkovModel::save( std::fstream &file ) const{
@@ -717,6 +1151,9 @@ bool ContinuousHiddenMarkovModel::load( std::fstream &file ){
         observationSequence.resize( timeseriesLength, VectorFloat(numInputDimensions,0) );
         obsSequence.resize(timeseriesLength,numInputDimensions);
         estimatedStates.resize( numStates );
+        windowEmissionsValid = false;
+        computeTransitionRanges();
+        computeEmissionParameters();
     }
     
     return true;
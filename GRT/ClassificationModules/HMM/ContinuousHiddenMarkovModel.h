@@ -99,6 +99,8 @@ class GRT_API ContinuousHiddenMarkovModel : public MLBase {
     
     MatrixFloat getAlpha() const { return alpha; }
     
+    UINT getPredictionMode() const { return predictionMode; }
+    
     bool setDownsampleFactor(const UINT downsampleFactor);
     
     /**
@@ -129,6 +131,24 @@ class GRT_API ContinuousHiddenMarkovModel : public MLBase {
     
     bool setAutoEstimateSigma(const bool autoEstimateSigma);
     
+    /**
+    This function sets how the model predicts from the stream of samples passed to predict_(VectorFloat &x). This should be one of the
+    HMMPredictionModes enums.
+    
+    In HMM_SLIDING_WINDOW mode (the default) the loglikelihood is computed over the last timeseriesLength samples. The emissions of each
+    downsampled observation are only computed once, and the forward recursion of the window is split at an anchor observation, so each
+    new sample costs O(N^2) (O(N*N*delta) for a left-right model) on average instead of rerunning the forward algorithm over the window.
+    In this mode getAlpha() returns the scaled forward variables of the newest observation only.
+    
+    In HMM_ONLINE mode the samples are downsampled into consecutive observations, and the forward variables are updated with each new
+    observation. The loglikelihood is then computed over all the observations since the model was last reset, so the model should be reset
+    at the start of each new segment.
+    
+    @param const UINT predictionMode: the prediction mode, this should be one of the HMMPredictionModes enums
+    @return returns true if the parameter was set correctly, false otherwise
+    */
+    bool setPredictionMode(const UINT predictionMode);
+    
     using MLBase::save;
     using MLBase::load;
     using MLBase::train_;
@@ -136,7 +156,16 @@ class GRT_API ContinuousHiddenMarkovModel : public MLBase {
     
 protected:
     
-    Float gauss( const MatrixFloat &x, const MatrixFloat &y, const MatrixFloat &sigma, const unsigned int i,const unsigned int j,const unsigned int N );
+    void computeEmissionParameters();
+    void computeEmissions( const Float *observation, Float *stateEmissions ) const;
+    Float scaleEmissions( const Float *stateEmissions );
+    void computeWindowEmissions( const unsigned int start, const unsigned int K, Float *stateEmissions );
+    bool predictWindow( const unsigned int T, const unsigned int K, const bool windowEmissionsRebuilt );
+    void anchorWindowPhase( const unsigned int phaseIndex, const unsigned int T, const unsigned int K );
+    void pushWindowPhase( const unsigned int phaseIndex, const unsigned int T, const unsigned int K );
+    bool forward( const unsigned int T );
+    bool predictOnline( const VectorFloat &x );
+    void computeTransitionRanges();
     
     UINT downsampleFactor;
     UINT numStates;             ///<The number of states for this model
@@ -159,6 +188,31 @@ protected:
     UINT delta;             ///<The number of states a model can move to in a LEFTRIGHT model
     Float loglikelihood;    ///<The log likelihood of an observation sequence given the modal, calculated by the forward method
     Float cThreshold;       ///<The classification threshold for this model
+    UINT predictionMode;    ///<How the model predicts from a stream of samples (HMM_SLIDING_WINDOW or HMM_ONLINE)
+    
+    VectorFloat logNormalisers;             ///<The log of the Gaussian normalisation constant of each state
+    MatrixFloat stateMeans;                 ///<The mean of each state, stored by dimension so the emissions are computed across all the states at once
+    MatrixFloat stateInverseVariances;      ///<The value 1/(2*sigma^2) of each state, stored by dimension
+    VectorFloat scaledEmissions;            ///<The emissions of one observation, scaled relative to the most likely state
+    MatrixFloat emissions;                  ///<The log emission probability of each state for each downsampled observation
+    MatrixFloat windowEmissions;            ///<The emissions of the recent downsampled observations in the sliding window, stored as a ring
+    UINT windowEmissionsHead;               ///<The row in windowEmissions that holds the oldest observation
+    bool windowEmissionsValid;              ///<False if windowEmissions need to be recomputed from the observationSequence
+    MatrixFloat windowFrontAlpha;           ///<For each downsampling phase, the scaled forward variables from each observation before the anchor up to the anchor
+    VectorFloat windowFrontLogScale;        ///<The log of the scale removed from each row of windowFrontAlpha
+    Vector< UINT > windowFrontStart;        ///<For each downsampling phase, the row in windowFrontAlpha of the oldest observation in its window
+    MatrixFloat windowBackProduct;          ///<For each downsampling phase, the scaled product of the transitions and emissions since the anchor
+    VectorFloat windowBackLogScale;         ///<The log of the scale removed from each product in windowBackProduct
+    MatrixFloat windowProduct;              ///<A buffer for the products computed when a phase is anchored
+    MatrixFloat windowProductBuffer;        ///<A second buffer for the products computed when a phase is anchored
+    VectorFloat windowAlpha;                ///<A buffer for one row of forward variables in sliding window mode
+    UINT windowPhase;                       ///<The downsampling phase of the next window in sliding window mode
+    Vector< UINT > transitionStart;         ///<The first state that can transition into each state
+    Vector< UINT > transitionEnd;           ///<One past the last state that can transition into each state
+    VectorFloat observation;                ///<A buffer for one downsampled observation
+    VectorFloat onlineAlpha;                ///<A buffer for the forward variables in online mode
+    UINT onlineSampleCounter;               ///<The number of samples in the current downsampled observation in online mode
+    UINT onlineObservationCounter;          ///<The number of observations since the last reset in online mode
     
 };
 
@@ -35,6 +35,8 @@ DiscreteHiddenMarkovModel::DiscreteHiddenMarkovModel() : MLBase( "DiscreteHidden
 	modelType = HMM_LEFTRIGHT;
 	logLikelihood = 0.0;
 	minChange = 1.0e-5;
+	predictionMode = HMM_SLIDING_WINDOW;
+	onlineObservationCounter = 0;
 }
 
 //Init the model with a set number of states and symbols
@@ -48,6 +50,8 @@ DiscreteHiddenMarkovModel::DiscreteHiddenMarkovModel(const UINT numStates,const
 	numRandomTrainingIterations = 5;
 	cThreshold = -1000;
 	logLikelihood = 0.0;
+	predictionMode = HMM_SLIDING_WINDOW;
+	onlineObservationCounter = 0;
     
 	randomizeMatrices(numStates,numSymbols);
 }
@@ -63,6 +67,8 @@ DiscreteHiddenMarkovModel::DiscreteHiddenMarkovModel(const MatrixFloat &a,const
 	cThreshold = -1000;
 	logLikelihood = 0.0;
 	minChange = 1.0e-5;
+	predictionMode = HMM_SLIDING_WINDOW;
+	onlineObservationCounter = 0;
 
     if( a.getNumRows() == a.getNumRows() && a.getNumRows() == b.getNumRows() && a.getNumRows() == pi.size() ){
         this->a = a;
@@ -72,6 +78,7 @@ DiscreteHiddenMarkovModel::DiscreteHiddenMarkovModel(const MatrixFloat &a,const
         this->delta = delta;
         numStates = b.getNumRows();
         numSymbols = b.getNumCols();
+        computeTransitionRanges();
         trained = true;
     }else{
         errorLog << "DiscreteHiddenMarkovModel(...) - The a,b,pi sizes are invalid!" << std::endl;
@@ -91,6 +98,11 @@ DiscreteHiddenMarkovModel::DiscreteHiddenMarkovModel(const DiscreteHiddenMarkovM
 	this->b = rhs.b;
 	this->pi = rhs.pi;
     this->trainingLog = rhs.trainingLog;
+    this->predictionMode = rhs.predictionMode;
+    this->onlineAlpha = rhs.onlineAlpha;
+    this->onlineObservationCounter = rhs.onlineObservationCounter;
+    this->transitionStart = rhs.transitionStart;
+    this->transitionEnd = rhs.transitionEnd;
 }
     
 //Default destructor
@@ -176,6 +188,8 @@ bool DiscreteHiddenMarkovModel::randomizeMatrices(const UINT numStates,const UIN
 	for (UINT i=0; i<numStates; i++) sum += pi[i];
 	for (UINT i=0; i<numStates; i++) pi[i] /= sum;
     
+    computeTransitionRanges();
+    
     return true;
 }
     
@@ -185,11 +199,20 @@ Float DiscreteHiddenMarkovModel::predict(const UINT newSample){
         return 0;
     }
     
+    if( predictionMode == HMM_ONLINE ){
+        return predictOnline( newSample );
+    }
+    
     observationSequence.push_back( newSample );
     
-    Vector< UINT > obs = observationSequence.getData();
+    //Copy the observations from oldest to newest into the reusable buffer
+    const UINT numObs = observationSequence.getNumValuesInBuffer();
+    if( obsBuffer.getSize() != numObs ) obsBuffer.resize( numObs );
+    for(UINT i=0; i<numObs; i++){
+        obsBuffer[i] = observationSequence[i];
+    }
     
-    return predict(obs);
+    return predict(obsBuffer);
 }
   
 /*Float predictLogLikelihood(Vector<UINT> &obs)
@@ -200,8 +223,10 @@ Float DiscreteHiddenMarkovModel::predict(const Vector<UINT> &obs){
 	const int N = (int)numStates;
     const int T = (int)obs.size();
 	int t,i,j = 0;
-    MatrixFloat alpha(T,numStates);
-    VectorFloat c(T);
+    if( T == 0 ) return 0;
+    if( int(alpha.getNumRows()) != T || int(alpha.getNumCols()) != N ) alpha.resize(T,numStates);
+    if( int(c.size()) != T ) c.resize(T);
+    if( int(estimatedStates.size()) != T ) estimatedStates.resize(T);
     
 	////////////////// Run the forward algorithm ////////////////////////
 	//Step 1: Init at t=0
@@ -218,12 +243,12 @@ Float DiscreteHiddenMarkovModel::predict(const Vector<UINT> &obs){
 	//Scale alpha
     for(i=0; i<N; i++) alpha[t][i] *= c[t];
     
-	//Step 2: Induction
+	//Step 2: Induction, only the states that can transition into state j are summed
 	for(t=1; t<T; t++){
 		c[t] = 0.0;
 		for(j=0; j<N; j++){
 			alpha[t][j] = 0.0;
-			for(i=0; i<N; i++){
+			for(i=(int)transitionStart[j]; i<(int)transitionEnd[j]; i++){
 				alpha[t][j] +=  alpha[t-1][i] * a[i][j];
 			}
             alpha[t][j] *= b[j][obs[t]];
@@ -237,7 +262,6 @@ Float DiscreteHiddenMarkovModel::predict(const Vector<UINT> &obs){
         for(j=0; j<N; j++) alpha[t][j] *= c[t];
 	}
     
-    if( int(estimatedStates.size()) != T ) estimatedStates.resize(T);
     for(t=0; t<T; t++){
         Float maxValue = 0;
         for(i=0; i<N; i++){
@@ -254,6 +278,78 @@ Float DiscreteHiddenMarkovModel::predict(const Vector<UINT> &obs){
     return -loglikelihood; //Return the negative log likelihood
 }
 
+Float DiscreteHiddenMarkovModel::predictOnline(const UINT newSample){
+    
+    if( alpha.getNumRows() != 1 || alpha.getNumCols() != numStates ) alpha.resize(1,numStates);
+    if( onlineAlpha.getSize() != numStates ) onlineAlpha.resize( numStates );
+    if( estimatedStates.getSize() != 1 ) estimatedStates.resize( 1 );
+    
+    //Update the forward variables with the new observation, starting from pi for the first observation since the last reset
+    Float *currentAlpha = alpha[0];
+    Float sum = 0;
+    if( onlineObservationCounter == 0 ){
+        logLikelihood = 0;
+        for(UINT i=0; i<numStates; i++){
+            onlineAlpha[i] = pi[i]*b[i][ newSample ];
+            sum += onlineAlpha[i];
+        }
+    }else{
+        for(UINT j=0; j<numStates; j++){
+            onlineAlpha[j] = 0.0;
+            for(UINT i=transitionStart[j]; i<transitionEnd[j]; i++){
+                onlineAlpha[j] += currentAlpha[i] * a[i][j];
+            }
+            onlineAlpha[j] *= b[j][ newSample ];
+            sum += onlineAlpha[j];
+        }
+    }
+    onlineObservationCounter++;
+    
+    //Scale alpha and keep track of the best state
+    const Float scale = 1.0/sum;
+    Float maxValue = 0;
+    for(UINT i=0; i<numStates; i++){
+        currentAlpha[i] = onlineAlpha[i] * scale;
+        if( currentAlpha[i] > maxValue ){
+            maxValue = currentAlpha[i];
+            estimatedStates[0] = i;
+        }
+    }
+    
+    //The loglikelihood is the sum over all the observations since the last reset
+    logLikelihood -= log( scale );
+    
+    return logLikelihood;
+}
+
+bool DiscreteHiddenMarkovModel::setPredictionMode(const UINT predictionMode){
+    if( predictionMode == HMM_SLIDING_WINDOW || predictionMode == HMM_ONLINE ){
+        this->predictionMode = predictionMode;
+        reset();
+        return true;
+    }
+    warningLog << "setPredictionMode(const UINT predictionMode) - Unknown prediction mode: " << predictionMode << std::endl;
+    return false;
+}
+
+void DiscreteHiddenMarkovModel::computeTransitionRanges(){
+    
+    //Find the range of states that can transition into each state, a left-right model only has a narrow band of non-zero transitions
+    transitionStart.resize( numStates );
+    transitionEnd.resize( numStates );
+    for(UINT j=0; j<numStates; j++){
+        transitionStart[j] = numStates;
+        transitionEnd[j] = 0;
+        for(UINT i=0; i<numStates; i++){
+            if( a[i][j] != 0 ){
+                if( transitionStart[j] == numStates ) transitionStart[j] = i;
+                transitionEnd[j] = i+1;
+            }
+        }
+        if( transitionStart[j] > transitionEnd[j] ) transitionStart[j] = transitionEnd[j];
+    }
+}
+
 /*Float predictLogLikelihood(Vector<UINT> &obs)
 - This method computes P(O|A,B,Pi) using the forward algorithm
 */
@@ -455,6 +551,8 @@ bool DiscreteHiddenMarkovModel::train(const Vector< Vector<UINT> > &trainingData
     averageObsLength = (UINT)floor( averageObsLength/Float(numObs) );
     observationSequence.resize( averageObsLength );
     estimatedStates.resize( averageObsLength );
+    computeTransitionRanges();
+    onlineObservationCounter = 0;
     
     //Finally, flag that the model was trained
     trained = true;
@@ -473,16 +571,18 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
     //Create the array to hold the data for each training instance
     Vector< HMMTrainingObject > hmms( numObs );
     
-    //Create epislon and gamma to hold the re-estimation variables
-    Vector< Vector< MatrixFloat > > epsilon( numObs );
-    Vector< MatrixFloat > gamma( numObs );
+    //Create epislon and gamma to hold the re-estimation variables, these are only needed to re-estimate pi
+    Vector< Vector< MatrixFloat > > epsilon( modelType == HMM_ERGODIC ? numObs : 0 );
+    Vector< MatrixFloat > gamma( modelType == HMM_ERGODIC ? numObs : 0 );
     
     //Resize the hmms, epsilon and gamma matrices so they are ready to be filled
     for(k=0; k<numObs; k++){
         const UINT T = (UINT)obs[k].size();
-        gamma[k].resize(T,numStates);
-        epsilon[k].resize(T);
-        for(t=0; t<T; t++) epsilon[k][t].resize(numStates,numStates);
+        if( modelType == HMM_ERGODIC ){
+            gamma[k].resize(T,numStates);
+            epsilon[k].resize(T);
+            for(t=0; t<T; t++) epsilon[k][t].resize(numStates,numStates);
+        }
         
         //Resize alpha, beta and phi
         hmms[k].alpha.resize(T,numStates);
@@ -490,6 +590,14 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
         hmms[k].c.resize(T);
     }
     
+    //The sequences are split into a fixed number of blocks, the statistics of each block are summed in parallel and the blocks are
+    //then summed in order, so the trained model does not depend on the number of threads
+    const UINT maxNumBlocks = 64;
+    const UINT blockSize = numObs > maxNumBlocks ? (UINT)ceil( numObs / Float(maxNumBlocks) ) : 1;
+    const UINT numBlocks = (UINT)ceil( numObs / Float(blockSize) );
+    Vector< HMMTrainingAccumulator > accumulators( numBlocks );
+    HMMTrainingAccumulator total;
+    
     //For each training seq, run one pass of the forward backward
     //algorithm then reestimate a and b using the Baum-Welch
     oldLoglikelihood = 0;
@@ -497,18 +605,30 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
     currentIter = 0;
     
     do{
-        newLoglikelihood = 0.0;
+        //Run the forwardbackward algorithm for each training example and sum the re-estimation statistics of each block
+        ThreadPool::parallel_for( 0, numBlocks, [&](const UINT block){
+            accumulateTrainingStatistics( hmms, obs, block*blockSize, std::min( (block+1)*blockSize, numObs ), accumulators[block] );
+        }, 1 );
         
-        //Run the forwardbackward algorithm for each training example
-        for(k=0; k<numObs; k++){
-            if( !forwardBackward(hmms[k],obs[k]) ){
-                return false;
+        total = accumulators[0];
+        for(UINT block=1; block<numBlocks; block++){
+            const HMMTrainingAccumulator &acc = accumulators[block];
+            total.valid = total.valid && acc.valid;
+            total.loglikelihood += acc.loglikelihood;
+            for(i=0; i<numStates; i++){
+                total.aDenom[i] += acc.aDenom[i];
+                total.bDenom[i] += acc.bDenom[i];
+                for(j=0; j<numStates; j++) total.aNum[i][j] += acc.aNum[i][j];
+                for(j=0; j<numSymbols; j++) total.bNum[i][j] += acc.bNum[i][j];
             }
-            newLoglikelihood += hmms[k].pk;
+        }
+        
+        if( !total.valid ){
+            return false;
         }
         
         //Set the new log likelihood as the average of the observations
-        newLoglikelihood /= numObs;
+        newLoglikelihood = total.loglikelihood / numObs;
         
         trainingIterationLog.push_back( newLoglikelihood );
         
@@ -528,27 +648,10 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
 
             //Re-estimate A
             for(i=0; i<numStates; i++){
-                
-                //Compute the denominator of A (which is independent of j)
-                denom = 0;
-                for(k=0; k<numObs; k++){
-                    for(t=0; t<obs[k].size()-1; t++){
-                        denom += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                    }
-                }
-                
-                //Compute the numerator and also update a[i][j]
+                denom = total.aDenom[i];
                 if( denom > 0 ){
                     for(j=0; j<numStates; j++){
-                        num = 0;
-                        for(k=0; k<numObs; k++){
-                            for(t=0; t<obs[k].size()-1; t++){
-                                num += hmms[k].alpha[t][i] * a[i][j] * b[j][ obs[k][t+1] ] * hmms[k].beta[t+1][j];
-                            }
-                        }
-                    
-                        //Update a[i][j]
-                        a[i][j] = num/denom;
+                        a[i][j] = total.aNum[i][j]/denom;
                     }
                 }else{
                     errorLog << "Denom is zero for A!" << std::endl;
@@ -559,27 +662,18 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
             //Re-estimate B
             bool renormB = false;
             for(i=0; i<numStates; i++){
+                denom = total.bDenom[i];
+                if( denom == 0 ){
+                    errorLog << "Denominator is zero for B!" << std::endl;
+                    return false;
+                }
                 for(j=0; j<numSymbols; j++){
-                    num=0.0;
-                    denom = 0.0;
-                    for(k=0; k<numObs; k++){
-                        const UINT T = (unsigned int)obs[k].size();
-                        for(t=0; t<T; t++){
-                            if( obs[k][t] == j ){
-                                num += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                            }
-                            denom += hmms[k].alpha[t][i] * hmms[k].beta[t][i] / hmms[k].c[t];
-                        }
-                    }
+                    num = total.bNum[i][j];
                     
-                    if( denom == 0 ){
-                        errorLog << "Denominator is zero for B!" << std::endl;
-                        return false;
-                    }
                     //Update b[i][j]
                     //If there are no observations at all for a state then the probabilities will be zero which is bad
                     //So instead we flag that B needs to be renormalized later
-                    if( num > 0 ) b[i][j] = denom > 0 ? num/denom : 1.0e-5;
+                    if( num > 0 ) b[i][j] = num/denom;
                     else{ b[i][j] = 0; renormB = true; }
                 }
             }
@@ -598,8 +692,10 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
             
             //Re-estimate Pi - only if the model type is HMM_ERGODIC, otherwise Pi[0] == 1 and everything else is 0
             if (modelType==HMM_ERGODIC ){
-                for(k=0; k<numObs; k++){
+                ThreadPool::parallel_for( 0, numObs, [&](const UINT k){
                     const UINT T = (unsigned int)obs[k].size();
+                    UINT t,i,j = 0;
+                    Float denom = 0;
                     //Compute epsilon
                     for(t=0; t<T-1; t++){
                         denom = 0.0;
@@ -626,7 +722,7 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
                                 gamma[k][t][i] += epsilon[k][t][i][j];
                         }
                     }
-                }
+                } );
                 
                 Float sum = 0;
                 for(i=0; i<numStates; i++){
@@ -645,12 +741,64 @@ bool DiscreteHiddenMarkovModel::train_(const Vector< Vector<UINT> > &obs,const U
     
 }
     
+void DiscreteHiddenMarkovModel::accumulateTrainingStatistics(Vector< HMMTrainingObject > &hmms,const Vector< Vector<UINT> > &obs,const UINT start,const UINT end,HMMTrainingAccumulator &acc){
+    
+    UINT i,j,k,t = 0;
+    if( acc.aNum.getNumRows() != numStates ){
+        acc.aNum.resize(numStates,numStates);
+        acc.aDenom.resize(numStates);
+        acc.bNum.resize(numStates,numSymbols);
+        acc.bDenom.resize(numStates);
+    }
+    acc.aNum.setAllValues(0);
+    acc.aDenom.setAll(0);
+    acc.bNum.setAllValues(0);
+    acc.bDenom.setAll(0);
+    acc.loglikelihood = 0;
+    acc.valid = true;
+    
+    for(k=start; k<end; k++){
+        HMMTrainingObject &hmm = hmms[k];
+        if( !forwardBackward(hmm,obs[k]) ){
+            acc.valid = false;
+            return;
+        }
+        acc.loglikelihood += hmm.pk;
+        
+        //Sum the expected number of transitions from each state, and the expected number of transitions from state i to state j
+        const UINT T = (unsigned int)obs[k].size();
+        for(t=0; t<T-1; t++){
+            const UINT nextSymbol = obs[k][t+1];
+            for(i=0; i<numStates; i++){
+                acc.aDenom[i] += hmm.alpha[t][i] * hmm.beta[t][i] / hmm.c[t];
+                for(j=0; j<numStates; j++){
+                    if( a[i][j] == 0 ) continue; //The transitions that are not allowed stay at zero
+                    acc.aNum[i][j] += hmm.alpha[t][i] * a[i][j] * b[j][ nextSymbol ] * hmm.beta[t+1][j];
+                }
+            }
+        }
+        
+        //Sum the expected number of times each state emits each symbol
+        for(t=0; t<T; t++){
+            const UINT symbol = obs[k][t];
+            for(i=0; i<numStates; i++){
+                const Float g = hmm.alpha[t][i] * hmm.beta[t][i] / hmm.c[t];
+                acc.bNum[i][ symbol ] += g;
+                acc.bDenom[i] += g;
+            }
+        }
+    }
+}
+    
 bool DiscreteHiddenMarkovModel::reset(){
 
     for(UINT i=0; i<observationSequence.getSize(); i++){
         observationSequence.push_back( 0 );
     }
     
+    //Restart the online forward recursion
+    onlineObservationCounter = 0;
+    
     return true;
 }
     
@@ -814,6 +962,9 @@ bool DiscreteHiddenMarkovModel::load( std::fstream &file ){
         file >> pi[i];
     }
     
+    computeTransitionRanges();
+    onlineObservationCounter = 0;
+    
     return true;
 }
 
@@ -50,6 +50,22 @@ class GRT_API HMMTrainingObject{
     Float pk;               //P( O | Model )
 };
 
+//This class is used to sum the Baum-Welch re-estimation statistics of a block of training sequences
+class GRT_API HMMTrainingAccumulator{
+    public:
+    HMMTrainingAccumulator(){
+        loglikelihood = 0.0;
+        valid = true;
+    }
+    ~HMMTrainingAccumulator(){}
+    MatrixFloat aNum;       //The numerator of each transition probability
+    VectorFloat aDenom;     //The denominator of the transition probabilities of each state
+    MatrixFloat bNum;       //The numerator of each emission probability
+    VectorFloat bDenom;     //The denominator of the emission probabilities of each state
+    Float loglikelihood;    //The sum of the loglikelihood of each sequence
+    bool valid;             //False if the forward backward algorithm failed for any sequence
+};
+
 class GRT_API DiscreteHiddenMarkovModel : public MLBase {
     
 public:
@@ -95,6 +111,24 @@ public:
     
     VectorFloat getTrainingIterationLog() const;
     
+    /**
+    Gets the prediction mode, this will be one of the HMMPredictionModes.
+    
+    @return returns the prediction mode
+    */
+    UINT getPredictionMode() const { return predictionMode; }
+    
+    /**
+    Sets the prediction mode used by predict(const UINT newSample). In the HMM_SLIDING_WINDOW mode the loglikelihood is computed
+    over the last observations in the observation buffer. In the HMM_ONLINE mode each new observation updates the forward variables
+    in O(N*delta) for a left-right model, and the loglikelihood is the loglikelihood of all the observations since the last reset.
+    Setting the prediction mode will reset the model.
+    
+    @param predictionMode: the new prediction mode, this should be one of the HMMPredictionModes
+    @return returns true if the prediction mode was updated, false otherwise
+    */
+    bool setPredictionMode(const UINT predictionMode);
+    
     using MLBase::save;
     using MLBase::load;
     using MLBase::train;
@@ -103,6 +137,10 @@ public:
     using MLBase::predict;
     
 protected:
+    Float predictOnline(const UINT newSample);
+    void accumulateTrainingStatistics(Vector< HMMTrainingObject > &hmms,const Vector< Vector<UINT> > &obs,const UINT start,const UINT end,HMMTrainingAccumulator &acc);
+    void computeTransitionRanges();
+    
     UINT numStates;             //The number of states for this model
     UINT numSymbols;            //The number of symbols for this model
     MatrixFloat a;             //The transitions probability matrix
@@ -117,6 +155,14 @@ protected:
     Float cThreshold;       //The classification threshold for this model
     CircularBuffer<UINT> observationSequence;
     Vector< UINT > estimatedStates;
+    UINT predictionMode;    //The prediction mode, this should be one of the HMMPredictionModes
+    Vector< UINT > obsBuffer;       //The ordered observations used by the sliding window prediction
+    MatrixFloat alpha;     //The forward estimate matrix used for prediction
+    VectorFloat c;         //The scaling coefficients used for prediction
+    VectorFloat onlineAlpha;       //The unscaled forward variables of the newest observation in the online mode
+    UINT onlineObservationCounter;  //The number of observations since the last reset in the online mode
+    Vector< UINT > transitionStart; //The first state that can transition into each state
+    Vector< UINT > transitionEnd;   //One past the last state that can transition into each state
 };
 
 GRT_END_NAMESPACE
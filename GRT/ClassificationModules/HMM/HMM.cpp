@@ -49,6 +49,7 @@ HMM::HMM(const UINT hmmType,const UINT modelType,const UINT delta,const bool use
     committeeSize = 5;
     sigma = 10.0;
     autoEstimateSigma = true;
+    predictionMode = HMM_SLIDING_WINDOW;
     
     supportsNullRejection = false; //TODO - need to add better null rejection support
     classifierMode = TIMESERIES_CLASSIFIER_MODE;
@@ -75,6 +76,7 @@ HMM& HMM::operator=(const HMM &rhs){
         this->committeeSize = rhs.committeeSize;
         this->sigma = rhs.sigma;
         this->autoEstimateSigma = rhs.autoEstimateSigma;
+        this->predictionMode = rhs.predictionMode;
         this->discreteModels = rhs.discreteModels;
         this->continuousModels = rhs.continuousModels;
         
@@ -103,6 +105,7 @@ bool HMM::deepCopyFrom(const Classifier *classifier){
         this->committeeSize = ptr->committeeSize;
         this->sigma = ptr->sigma;
         this->autoEstimateSigma = ptr->autoEstimateSigma;
+        this->predictionMode = ptr->predictionMode;
         this->discreteModels = ptr->discreteModels;
         this->continuousModels = ptr->continuousModels;
         
@@ -112,7 +115,7 @@ bool HMM::deepCopyFrom(const Classifier *classifier){
     return false;
 }
 
-bool HMM::train(ClassificationData trainingData){
+bool HMM::train_(ClassificationData &/*trainingData*/){
     errorLog << __GRT_LOG__ << " The HMM classifier should be trained using the train(TimeSeriesClassificationData &trainingData) method" << std::endl;
     return false;
 }
@@ -159,24 +162,31 @@ bool HMM::train_discrete(TimeSeriesClassificationData &trainingData){
         discreteModels[k].resetModel(numStates,numSymbols,modelType,delta);
         discreteModels[k].setMaxNumEpochs( maxNumEpochs );
         discreteModels[k].setMinChange( minChange );
+        discreteModels[k].setPredictionMode( predictionMode );
     }
     
-    //Train each of the models
+    //Convert each classes training data into a list of observation sequences
+    Vector< Vector< Vector< UINT > > > classObservationSequences( numClasses );
     for(UINT k=0; k<numClasses; k++){
         //Get the class ID of this gesture
         UINT classID = trainingData.getClassTracker()[k].classLabel;
         classLabels[k] = classID;
         
-        //Convert this classes training data into a list of observation sequences
         TimeSeriesClassificationData classData = trainingData.getClassData( classID );
-        Vector< Vector< UINT > > observationSequences;
-        if( !convertDataToObservationSequence( classData, observationSequences ) ){
+        if( !convertDataToObservationSequence( classData, classObservationSequences[k] ) ){
             return false;
         }
-        
-        //Train the model
-        if( !discreteModels[k].train( observationSequences ) ){
-            errorLog << __GRT_LOG__ << " Failed to train HMM for class " << classID << std::endl;
+    }
+    
+    //Train each of the models, the models are independent so the classes are trained in parallel
+    Vector< UINT > modelTrained( numClasses, 0 );
+    ThreadPool::parallel_for( 0, numClasses, [&](const UINT k){
+        modelTrained[k] = discreteModels[k].train( classObservationSequences[k] ) ? 1 : 0;
+    }, 1 );
+    
+    for(UINT k=0; k<numClasses; k++){
+        if( !modelTrained[k] ){
+            errorLog << __GRT_LOG__ << " Failed to train HMM for class " << classLabels[k] << std::endl;
             return false;
         }
     }
@@ -184,17 +194,8 @@ bool HMM::train_discrete(TimeSeriesClassificationData &trainingData){
     //Compute the rejection thresholds
     nullRejectionThresholds.resize(numClasses);
     
-    for(UINT k=0; k<numClasses; k++){
-        //Get the class ID of this gesture
-        UINT classID = trainingData.getClassTracker()[k].classLabel;
-        classLabels[k] = classID;
-        
-        //Convert this classes training data into a list of observation sequences
-        TimeSeriesClassificationData classData = trainingData.getClassData( classID );
-        Vector< Vector< UINT > > observationSequences;
-        if( !convertDataToObservationSequence( classData, observationSequences ) ){
-            return false;
-        }
+    ThreadPool::parallel_for( 0, numClasses, [&](const UINT k){
+        const Vector< Vector< UINT > > &observationSequences = classObservationSequences[k];
         
         //Test the model
         Float loglikelihood = 0;
@@ -204,7 +205,7 @@ bool HMM::train_discrete(TimeSeriesClassificationData &trainingData){
             avgLoglikelihood += fabs( loglikelihood );
         }
         nullRejectionThresholds[k] = -( avgLoglikelihood / Float( observationSequences.size() ) );
-    }
+    }, 1 );
     
     //Flag that the model has been trained
     trained = true;
@@ -241,8 +242,9 @@ bool HMM::train_continuous(TimeSeriesClassificationData &trainingData){
     const UINT numTrainingSamples = trainingData.getNumSamples();
     continuousModels.resize( numTrainingSamples );
     
-    //Train each of the models
-    for(UINT k=0; k<numTrainingSamples; k++){
+    //Train each of the models, there is one model per sample so the models are trained in parallel
+    Vector< UINT > modelTrained( numTrainingSamples, 0 );
+    ThreadPool::parallel_for( 0, numTrainingSamples, [&](const UINT k){
         
         //Init the model
         continuousModels[k].setDownsampleFactor( downsampleFactor );
@@ -251,11 +253,16 @@ bool HMM::train_continuous(TimeSeriesClassificationData &trainingData){
         continuousModels[k].setSigma( sigma );
         continuousModels[k].setAutoEstimateSigma( autoEstimateSigma );
         continuousModels[k].enableScaling( false ); //Scaling should always off for the models as we do any scaling in the CHMM
+        continuousModels[k].setPredictionMode( predictionMode );
         
         //Train the model
-        if( !continuousModels[k].train_( trainingData[k] ) ){
+        modelTrained[k] = continuousModels[k].train_( trainingData[k] ) ? 1 : 0;
+    } );
+    
+    for(UINT k=0; k<numTrainingSamples; k++){
+        if( !modelTrained[k] ){
             errorLog << __GRT_LOG__ << " Failed to train CHMM for sample " << k << std::endl;
-                return false;
+            return false;
         }
     }
     
@@ -844,6 +851,7 @@ bool HMM::load( std::fstream &file ){
                     errorLog << __GRT_LOG__ << " Failed to load discrete model " << i << " from file!" << std::endl;
                     return false;
                 }
+                discreteModels[i].setPredictionMode( predictionMode );
             }
         }
         break;
@@ -890,6 +898,7 @@ bool HMM::load( std::fstream &file ){
                     errorLog << __GRT_LOG__ << " Failed to load continuous model " << i << " from file!" << std::endl;
                     return false;
                 }
+                continuousModels[i].setPredictionMode( predictionMode );
             }
         }
         break;
@@ -942,6 +951,10 @@ UINT HMM::getNumRandomTrainingIterations() const{
     return numRandomTrainingIterations;
 }
 
+UINT HMM::getPredictionMode() const{
+    return predictionMode;
+}
+
 Vector< DiscreteHiddenMarkovModel > HMM::getDiscreteModels() const{
     return discreteModels;
 }
@@ -1059,6 +1072,21 @@ bool HMM::setSigma(const Float sigma){
     return false;
 }
 
+bool HMM::setPredictionMode(const UINT predictionMode){
+    if( predictionMode == HMM_SLIDING_WINDOW || predictionMode == HMM_ONLINE ){
+        this->predictionMode = predictionMode;
+        for(UINT i=0; i<discreteModels.getSize(); i++){
+            discreteModels[i].setPredictionMode( predictionMode );
+        }
+        for(UINT i=0; i<continuousModels.getSize(); i++){
+            continuousModels[i].setPredictionMode( predictionMode );
+        }
+        return true;
+    }
+    warningLog << __GRT_LOG__ << " Unknown prediction mode: " << predictionMode << std::endl;
+    return false;
+}
+
 bool HMM::setAutoEstimateSigma(const bool autoEstimateSigma){
     
     clear();
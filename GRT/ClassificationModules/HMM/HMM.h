@@ -88,13 +88,13 @@ public:
     virtual bool deepCopyFrom(const Classifier *classifier);
     
     /**
-    This overrides the train function in the Classifier base class. It simply prints a warning message stating that the
+    This overrides the train_ function in the Classifier base class. It simply prints a warning message stating that the
     bool train(LabelledTimeSeriesClassificationData trainingData) function should be used to train the HMM model.
     
     @param trainingData: a reference to the training data
     @return returns true if the HMM model was trained, false otherwise
     */
-    virtual bool train(ClassificationData trainingData);
+    virtual bool train_(ClassificationData &trainingData);
     
     /**
     This trains the HMM model, using the labelled timeseries classification data.
@@ -207,6 +207,13 @@ public:
     */
     UINT getNumRandomTrainingIterations() const;
     
+    /**
+    This function returns the prediction mode used by the HMM models, this will be one of the HMMPredictionModes.
+    
+    @return returns the prediction mode
+    */
+    UINT getPredictionMode() const;
+    
     /**
     This function gets returns a Vector of trained DiscreteHiddenMarkovModels.  There will be one HiddenMarkovModel for each class in
     the training data. This is only relevant if the HMM model type is HMM_DISCRETE.
@@ -327,6 +334,23 @@ public:
     */
     bool setSigma(const Float sigma);
     
+    /**
+    This function sets how the HMM models compute the loglikelihood of the realtime input stream.
+    
+    In the HMM_SLIDING_WINDOW mode (the default) each model computes the loglikelihood of the last observations in its observation buffer,
+    which gives the same result as classifying that window as a timeseries. The continuous models update the forward recursion of the
+    window incrementally, so each prediction costs O(N^2) on average, while the discrete models rerun the forward algorithm over the
+    window with each new observation. In the HMM_ONLINE mode each model only updates its forward
+    variables with the newest observation, so the loglikelihood covers all the observations since the last reset and the cost of each
+    prediction no longer depends on the length of the window.
+    
+    Modifing the prediction mode will NOT clear the trained model, but it will reset the models.
+    
+    @param predictionMode: the new prediction mode, this should be one of the HMMPredictionModes
+    @return returns true if the parameter was set correctly, false otherwise
+    */
+    bool setPredictionMode(const UINT predictionMode);
+    
     bool setAutoEstimateSigma(const bool autoEstimateSigma);
 
     /**
@@ -361,6 +385,7 @@ protected:
     UINT numStates;         //The number of states for each model
     UINT numSymbols;        //The number of symbols for each model
     UINT numRandomTrainingIterations;
+    UINT predictionMode;    //Controls if the models predict over a HMM_SLIDING_WINDOW or HMM_ONLINE
     Vector< DiscreteHiddenMarkovModel > discreteModels;
     
     //Continuous HMM variables
@@ -35,5 +35,6 @@
     
 enum HMMModelTypes{HMM_ERGODIC=0,HMM_LEFTRIGHT};
 enum HMMTypes{HMM_DISCRETE=0,HMM_CONTINUOUS};
+enum HMMPredictionModes{HMM_SLIDING_WINDOW=0,HMM_ONLINE};
 
 #endif //GRT_HMM_ENUMS_HEADER
@@ -20,9 +20,121 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "KNN.h"
+#include "../../Util/GEMM.h"
+
+//The AVX2 kernels are written for double precision, they will only be used if the GEMM class selects its AVX2 kernel
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRT_KNN_AVX2_ENABLED
+#define GRT_KNN_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#define GRT_KNN_AVX2_ENABLED
+#define GRT_KNN_AVX2_TARGET
+#include <immintrin.h>
+#endif
 
 GRT_BEGIN_NAMESPACE
 
+//The number of training examples packed into each block, and the number of queries tested against each block by predictBatch
+#define GRT_KNN_BLOCK_SIZE 8
+#define GRT_KNN_QUERY_TILE_SIZE 16
+
+//Each kernel computes the sums for the GRT_KNN_BLOCK_SIZE training examples in a block, the block holds the first feature of
+//each example, then the second feature of each example, etc. Each example is summed over the features in order, so the sums are
+//the same as the ones computed one example at a time by computeEuclideanDistance, computeCosineDistance and computeManhattanDistance
+typedef void (*KNNBlockKernel)(const Float *query,const Float *block,const UINT N,Float *sums);
+
+static void knnEuclideanBlock(const Float *query,const Float *block,const UINT N,Float *sums){
+    for(UINT l=0; l<GRT_KNN_BLOCK_SIZE; l++) sums[l] = 0;
+    for(UINT j=0; j<N; j++){
+        const Float q = query[j];
+        const Float *column = block + j*GRT_KNN_BLOCK_SIZE;
+        for(UINT l=0; l<GRT_KNN_BLOCK_SIZE; l++){
+            const Float diff = q - column[l];
+            sums[l] += diff*diff;
+        }
+    }
+}
+
+static void knnManhattanBlock(const Float *query,const Float *block,const UINT N,Float *sums){
+    for(UINT l=0; l<GRT_KNN_BLOCK_SIZE; l++) sums[l] = 0;
+    for(UINT j=0; j<N; j++){
+        const Float q = query[j];
+        const Float *column = block + j*GRT_KNN_BLOCK_SIZE;
+        for(UINT l=0; l<GRT_KNN_BLOCK_SIZE; l++){
+            sums[l] += fabs( q - column[l] );
+        }
+    }
+}
+
+static void knnDotProductBlock(const Float *query,const Float *block,const UINT N,Float *sums){
+    for(UINT l=0; l<GRT_KNN_BLOCK_SIZE; l++) sums[l] = 0;
+    for(UINT j=0; j<N; j++){
+        const Float q = query[j];
+        const Float *column = block + j*GRT_KNN_BLOCK_SIZE;
+        for(UINT l=0; l<GRT_KNN_BLOCK_SIZE; l++){
+            sums[l] += q * column[l];
+        }
+    }
+}
+
+#ifdef GRT_KNN_AVX2_ENABLED
+//The AVX2 kernels do not use fused multiply-adds, so each lane is rounded the same way as the scalar kernels
+GRT_KNN_AVX2_TARGET static void knnEuclideanBlockAVX2(const Float *query_,const Float *block_,const UINT N,Float *sums_){
+    const double *query = reinterpret_cast< const double* >( query_ );
+    const double *block = reinterpret_cast< const double* >( block_ );
+    double *sums = reinterpret_cast< double* >( sums_ );
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    for(UINT j=0; j<N; j++){
+        const __m256d q = _mm256_set1_pd( query[j] );
+        const __m256d d0 = _mm256_sub_pd( q, _mm256_loadu_pd( block + j*8 ) );
+        const __m256d d1 = _mm256_sub_pd( q, _mm256_loadu_pd( block + j*8 + 4 ) );
+        s0 = _mm256_add_pd( s0, _mm256_mul_pd( d0, d0 ) );
+        s1 = _mm256_add_pd( s1, _mm256_mul_pd( d1, d1 ) );
+    }
+    _mm256_storeu_pd( sums, s0 );
+    _mm256_storeu_pd( sums + 4, s1 );
+}
+
+GRT_KNN_AVX2_TARGET static void knnManhattanBlockAVX2(const Float *query_,const Float *block_,const UINT N,Float *sums_){
+    const double *query = reinterpret_cast< const double* >( query_ );
+    const double *block = reinterpret_cast< const double* >( block_ );
+    double *sums = reinterpret_cast< double* >( sums_ );
+    const __m256d signMask = _mm256_set1_pd( -0.0 );
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    for(UINT j=0; j<N; j++){
+        const __m256d q = _mm256_set1_pd( query[j] );
+        const __m256d d0 = _mm256_sub_pd( q, _mm256_loadu_pd( block + j*8 ) );
+        const __m256d d1 = _mm256_sub_pd( q, _mm256_loadu_pd( block + j*8 + 4 ) );
+        s0 = _mm256_add_pd( s0, _mm256_andnot_pd( signMask, d0 ) );
+        s1 = _mm256_add_pd( s1, _mm256_andnot_pd( signMask, d1 ) );
+    }
+    _mm256_storeu_pd( sums, s0 );
+    _mm256_storeu_pd( sums + 4, s1 );
+}
+
+GRT_KNN_AVX2_TARGET static void knnDotProductBlockAVX2(const Float *query_,const Float *block_,const UINT N,Float *sums_){
+    const double *query = reinterpret_cast< const double* >( query_ );
+    const double *block = reinterpret_cast< const double* >( block_ );
+    double *sums = reinterpret_cast< double* >( sums_ );
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    for(UINT j=0; j<N; j++){
+        const __m256d q = _mm256_set1_pd( query[j] );
+        s0 = _mm256_add_pd( s0, _mm256_mul_pd( q, _mm256_loadu_pd( block + j*8 ) ) );
+        s1 = _mm256_add_pd( s1, _mm256_mul_pd( q, _mm256_loadu_pd( block + j*8 + 4 ) ) );
+    }
+    _mm256_storeu_pd( sums, s0 );
+    _mm256_storeu_pd( sums + 4, s1 );
+}
+#else
+#define knnEuclideanBlockAVX2 knnEuclideanBlock
+#define knnManhattanBlockAVX2 knnManhattanBlock
+#define knnDotProductBlockAVX2 knnDotProductBlock
+#endif
+
 //Define the string that will be used to identify the object
 const std::string KNN::id = "KNN";
 std::string KNN::getId() { return KNN::id; }
@@ -40,6 +152,7 @@ KNN::KNN(unsigned int K,bool useScaling,bool useNullRejection,Float nullRejectio
     this->searchForBestKValue = searchForBestKValue;
     this->minKSearchValue = minKSearchValue;
     this->maxKSearchValue = maxKSearchValue;
+    this->useSpatialIndex = true;
     supportsNullRejection = true;
     classifierMode = STANDARD_CLASSIFIER_MODE;
     distanceMethod = EUCLIDEAN_DISTANCE;
@@ -66,6 +179,11 @@ KNN& KNN::operator=(const KNN &rhs){
         this->trainingData = rhs.trainingData;
         this->trainingMu = rhs.trainingMu;
         this->trainingSigma = rhs.trainingSigma;
+        this->useSpatialIndex = rhs.useSpatialIndex;
+        this->spatialIndex = rhs.spatialIndex;
+        this->packedSamples = rhs.packedSamples;
+        this->packedNorms = rhs.packedNorms;
+        this->sampleClassIndexs = rhs.sampleClassIndexs;
         
         //Classifier variables
         copyBaseVariables( (Classifier*)&rhs );
@@ -89,6 +207,11 @@ bool KNN::deepCopyFrom(const Classifier *classifier){
         this->trainingData = ptr->trainingData;
         this->trainingMu = ptr->trainingMu;
         this->trainingSigma = ptr->trainingSigma;
+        this->useSpatialIndex = ptr->useSpatialIndex;
+        this->spatialIndex = ptr->spatialIndex;
+        this->packedSamples = ptr->packedSamples;
+        this->packedNorms = ptr->packedNorms;
+        this->sampleClassIndexs = ptr->sampleClassIndexs;
         
         //Classifier variables
         return copyBaseVariables( classifier );
@@ -98,31 +221,40 @@ bool KNN::deepCopyFrom(const Classifier *classifier){
 
 bool KNN::train_(ClassificationData &trainingData){
     
+    //The KNN model stores its own copy of the training data, so it is trained from a view of the data rather than copying it twice
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool KNN::train_(ClassificationDataView &view){
+    
     //Clear any previous models
     clear();
     
-    if( trainingData.getNumSamples() == 0 ){
+    if( view.getNumSamples() == 0 ){
         errorLog << __GRT_LOG__ << "  Training data has zero samples!" << std::endl;
         return false;
     }
 
-    //Store the number of features, classes and the training data
-    this->numInputDimensions = trainingData.getNumDimensions();
-    this->numOutputDimensions = trainingData.getNumClasses();
-    this->numClasses = trainingData.getNumClasses();
-    this->ranges = trainingData.getRanges();
+    //Store the training data, this is the only copy of the samples that is made as it is the model, any class without samples in the view is not copied
+    this->ranges = view.getRanges();
+    this->trainingData = view.getClassificationData();
 
     if( useScaling ){
         //Scale the training data between 0 and 1
-        trainingData.scale(0, 1);
+        this->trainingData.scale(ranges, 0, 1);
     }
 
-    //TODO: In the future need to build a kdtree from the training data to allow better realtime prediction
-    this->trainingData = trainingData;
+    //Store the number of features and classes
+    this->numInputDimensions = this->trainingData.getNumDimensions();
+    this->numOutputDimensions = this->trainingData.getNumClasses();
+    this->numClasses = this->trainingData.getNumClasses();
 
-    ClassificationData validationData;
+    //The validation set and the K search use views of the stored training data, so the samples are not copied again
+    ClassificationDataView trainingData( this->trainingData );
+    ClassificationDataView validationData;
     if( useValidationSet ){
-        validationData = trainingData.split( 100-validationSetSize );
+        validationData = trainingData.split( 100-validationSetSize, false, random );
     }
     
     //Set the class labels
@@ -131,6 +263,11 @@ bool KNN::train_(ClassificationData &trainingData){
         classLabels[k] = trainingData.getClassTracker()[k].classLabel;
     }
     
+    //Pack and index the training data to allow better realtime prediction
+    if( !buildSearchData() ){
+        return false;
+    }
+    
     //If we do not need to search for the best K value, then call the sub training function with the default value of K
     if( !searchForBestKValue ){
         if( !train_(trainingData,K) ){
@@ -144,7 +281,7 @@ bool KNN::train_(ClassificationData &trainingData){
         
         for(UINT k=minKSearchValue; k<=maxKSearchValue; k++){
             //Randomly spilt the data and use 80% to train the algorithm and 20% to test it
-            ClassificationData testSet = useValidationSet ? validationData : trainingData.split(80,true);
+            ClassificationDataView testSet = useValidationSet ? validationData : trainingData.split(80,true,random);
             
             if( !train_(trainingData, k) ){
                 errorLog << __GRT_LOG__ << " Failed to train model for a k value of " << k << std::endl;
@@ -219,8 +356,10 @@ bool KNN::train_(ClassificationData &trainingData){
     //If scaling was on, then the data will already be scaled, so turn it off temporially
     bool scalingState = useScaling;
     useScaling = false;
+    VectorFloat sample;
     for(UINT i=0; i<trainingData.getNumSamples(); i++){
-        if( !predict_( trainingData[i].getSample() ) ){
+        sample = trainingData[i].getSample();
+        if( !predict_( sample ) ){
             trained = false;
             errorLog << __GRT_LOG__ << " Failed to run prediction for training sample: " << i << "! Failed to fully train model!" << std::endl;
             return false;
@@ -233,7 +372,8 @@ bool KNN::train_(ClassificationData &trainingData){
 
     if( useValidationSet ){
         for(UINT i=0; i<validationData.getNumSamples(); i++){
-            if( !predict_( validationData[i].getSample() ) ){
+            sample = validationData[i].getSample();
+            if( !predict_( sample ) ){
                 trained = false;
                 errorLog << __GRT_LOG__ << " Failed to run prediction for validation sample: " << i << "! Failed to fully train model!" << std::endl;
                 return false;
@@ -262,7 +402,7 @@ bool KNN::train_(ClassificationData &trainingData){
     return true;
 }
     
-bool KNN::train_(const ClassificationData &trainingData,const UINT K){
+bool KNN::train_(const ClassificationDataView &trainingData,const UINT K){
     
     //Set the dimensionality of the input data
     this->K = K;
@@ -403,48 +543,16 @@ bool KNN::predict(const VectorFloat &inputVector,const UINT K){
         return false;
     }
     
-    //TODO - need to build a kdtree of the training data to allow better realtime prediction
-    const UINT M = trainingData.getNumSamples();
-    Vector< IndexedDouble > neighbours;
-    
-    for(UINT i=0; i<M; i++){
-        Float dist = 0;
-        UINT classLabel = trainingData[i].getClassLabel();
-        VectorFloat trainingSample = trainingData[i].getSample();
-        
-        switch( distanceMethod ){
-            case EUCLIDEAN_DISTANCE:
-            dist = computeEuclideanDistance(inputVector,trainingSample);
-            break;
-            case COSINE_DISTANCE:
-            dist = computeCosineDistance(inputVector,trainingSample);
-            break;
-            case MANHATTAN_DISTANCE:
-            dist = computeManhattanDistance(inputVector, trainingSample);
-            break;
-            default:
-            errorLog << __GRT_LOG__ << " unkown distance measure!" << std::endl;
+    //Find the K nearest neighbours
+    if( spatialIndex.getBuilt() ){
+        if( !spatialIndex.search( &inputVector[0], K, neighbours ) ){
+            errorLog << __GRT_LOG__ << " Failed to search the KDTree!" << std::endl;
             return false;
-            break;
         }
-        
-        if( neighbours.size() < K ){
-            neighbours.push_back( IndexedDouble(classLabel,dist) );
-        }else{
-            //Find the maximum value in the neighbours buffer
-            Float maxValue = neighbours[0].value;
-            UINT maxIndex = 0;
-            for(UINT n=1; n<neighbours.size(); n++){
-                if( neighbours[n].value > maxValue ){
-                    maxValue = neighbours[n].value;
-                    maxIndex = n;
-                }
-            }
-            
-            //If the dist is less than the maximum value in the buffer, then replace that value with the new dist
-            if( dist < maxValue ){
-                neighbours[ maxIndex ] = IndexedDouble(classLabel,dist);
-            }
+    }else{
+        const Float *query = &inputVector[0];
+        if( !searchNeighbours( &query, 1, K, &neighbours ) ){
+            return false;
         }
     }
     
@@ -452,64 +560,208 @@ bool KNN::predict(const VectorFloat &inputVector,const UINT K){
     if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses);
     if( classDistances.size() != numClasses ) classDistances.resize(numClasses);
     
-    std::fill(classLikelihoods.begin(),classLikelihoods.end(),0);
-    std::fill(classDistances.begin(),classDistances.end(),0);
+    UINT maxIndex = 0;
+    classifyNeighbours( neighbours, &classLikelihoods[0], &classDistances[0], maxIndex, predictedClassLabel );
     
-    //Count the classes
-    for(UINT k=0; k<neighbours.size(); k++){
-        UINT classLabel = neighbours[k].index;
-        if( classLabel == 0 ){
-            errorLog << __GRT_LOG__ << " Class label of training example can not be zero!" << std::endl;
+    //Set the maximum likelihood value
+    maxLikelihood = classLikelihoods[ maxIndex ];
+    
+    return true;
+}
+
+bool KNN::predictBatch(const MatrixFloat &inputData,MatrixFloat &classLikelihoods,Vector< UINT > &predictedClassLabels){
+    
+    if( !trained ){
+        errorLog << __GRT_LOG__ << " KNN model has not been trained" << std::endl;
+        return false;
+    }
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << __GRT_LOG__ << " The number of columns in the input data (" << inputData.getNumCols() << ") does not match the number of features " << numInputDimensions << std::endl;
+        return false;
+    }
+    
+    if( K > trainingData.getNumSamples() ){
+        errorLog << __GRT_LOG__ << " K Is Greater Than The Number Of Training Samples" << std::endl;
+        return false;
+    }
+    
+    const UINT M = inputData.getNumRows();
+    predictedClassLabels.resize( M );
+    if( !classLikelihoods.resize( M, numClasses ) ) return false;
+    
+    //Scale a copy of the input data if needed
+    MatrixFloat scaledData;
+    if( useScaling ){
+        scaledData = inputData;
+        for(UINT i=0; i<M; i++){
+            for(UINT n=0; n<numInputDimensions; n++){
+                scaledData[i][n] = scale(scaledData[i][n], ranges[n].minValue, ranges[n].maxValue, 0, 1);
+            }
+        }
+    }
+    const MatrixFloat &data = useScaling ? scaledData : inputData;
+    
+    //Search for the neighbours of a tile of rows at a time, the full scan tests every row in the tile against each block of training examples
+    const UINT tileSize = GRT_KNN_QUERY_TILE_SIZE;
+    Vector< Vector< IndexedDouble > > tileNeighbours( tileSize );
+    const Float *queries[ GRT_KNN_QUERY_TILE_SIZE ];
+    VectorFloat distances( numClasses );
+    
+    for(UINT i=0; i<M; i+=tileSize){
+        const UINT T = M-i < tileSize ? M-i : tileSize;
+        for(UINT t=0; t<T; t++){
+            queries[t] = data[i+t];
+        }
+        
+        if( spatialIndex.getBuilt() ){
+            for(UINT t=0; t<T; t++){
+                if( !spatialIndex.search( queries[t], K, tileNeighbours[t] ) ){
+                    errorLog << __GRT_LOG__ << " Failed to search the KDTree!" << std::endl;
+                    return false;
+                }
+            }
+        }else if( !searchNeighbours( queries, T, K, &tileNeighbours[0] ) ){
             return false;
         }
         
-        //Find the index of the classLabel
-        UINT classLabelIndex = 0;
-        for(UINT j=0; j<numClasses; j++){
-            if( classLabel == classLabels[j] ){
-                classLabelIndex = j;
-                break;
+        for(UINT t=0; t<T; t++){
+            UINT maxIndex = 0;
+            classifyNeighbours( tileNeighbours[t], classLikelihoods[i+t], &distances[0], maxIndex, predictedClassLabels[i+t] );
+        }
+    }
+    
+    return true;
+}
+
+bool KNN::searchNeighbours(const Float **queries,const UINT numQueries,const UINT K,Vector< IndexedDouble > *neighbours) const{
+    
+    const UINT N = numInputDimensions;
+    const UINT M = trainingData.getNumSamples();
+    const UINT blockSize = GRT_KNN_BLOCK_SIZE;
+    const UINT numBlocks = (M + blockSize - 1) / blockSize;
+    const bool useAVX2 = GEMM::getKernelType() == GEMM::AVX2_KERNEL;
+    
+    if( packedSamples.getSize() != numBlocks*blockSize*N ){
+        errorLog << __GRT_LOG__ << " The packed training data has not been built!" << std::endl;
+        return false;
+    }
+    
+    KNNBlockKernel kernel = NULL;
+    switch( distanceMethod ){
+        case EUCLIDEAN_DISTANCE:
+        kernel = useAVX2 ? knnEuclideanBlockAVX2 : knnEuclideanBlock;
+        break;
+        case COSINE_DISTANCE:
+        kernel = useAVX2 ? knnDotProductBlockAVX2 : knnDotProductBlock;
+        break;
+        case MANHATTAN_DISTANCE:
+        kernel = useAVX2 ? knnManhattanBlockAVX2 : knnManhattanBlock;
+        break;
+        default:
+        errorLog << __GRT_LOG__ << " unkown distance measure!" << std::endl;
+        return false;
+        break;
+    }
+    
+    //The norm of each query is only needed by the cosine measure
+    Float queryNorms[ GRT_KNN_QUERY_TILE_SIZE ];
+    for(UINT q=0; q<numQueries; q++){
+        neighbours[q].clear();
+        neighbours[q].reserve( K );
+        if( distanceMethod == COSINE_DISTANCE ){
+            Float magA = 0;
+            for(UINT j=0; j<N; j++){
+                magA += SQR( queries[q][j] );
             }
+            queryNorms[q] = sqrt( magA );
         }
-        classLikelihoods[ classLabelIndex ] += 1;
-        classDistances[ classLabelIndex ] += neighbours[k].value;
+    }
+    
+    //Test each query against one block of training examples at a time, so the block stays in the cache for all the queries
+    Float sums[ GRT_KNN_BLOCK_SIZE ];
+    for(UINT b=0; b<numBlocks; b++){
+        const Float *block = &packedSamples[ b*blockSize*N ];
+        const UINT start = b*blockSize;
+        const UINT B = M-start < blockSize ? M-start : blockSize;
+        
+        for(UINT q=0; q<numQueries; q++){
+            kernel( queries[q], block, N, sums );
+            
+            //Turn the sums into distances, the same way as computeEuclideanDistance and computeCosineDistance
+            if( distanceMethod == EUCLIDEAN_DISTANCE ){
+                for(UINT l=0; l<B; l++) sums[l] = sqrt( sums[l] );
+            }else if( distanceMethod == COSINE_DISTANCE ){
+                for(UINT l=0; l<B; l++) sums[l] = sums[l] / (queryNorms[q] * packedNorms[start+l]);
+            }
+            
+            Vector< IndexedDouble > &heap = neighbours[q];
+            for(UINT l=0; l<B; l++){
+                const Float dist = sums[l];
+                
+                //Keep the K nearest neighbours in a max heap, so the furthest neighbour is always at the front
+                if( heap.size() < K ){
+                    heap.push_back( IndexedDouble(start+l,dist) );
+                    std::push_heap( heap.begin(), heap.end(), KDTree::sortNeighboursByDistance );
+                }else if( dist < heap.front().value ){
+                    std::pop_heap( heap.begin(), heap.end(), KDTree::sortNeighboursByDistance );
+                    heap.back() = IndexedDouble(start+l,dist);
+                    std::push_heap( heap.begin(), heap.end(), KDTree::sortNeighboursByDistance );
+                }
+            }
+        }
+    }
+    
+    //Sort the neighbours so the class distances are summed in the same order as the KDTree search
+    for(UINT q=0; q<numQueries; q++){
+        std::sort_heap( neighbours[q].begin(), neighbours[q].end(), KDTree::sortNeighboursByDistance );
+    }
+    
+    return true;
+}
+
+void KNN::classifyNeighbours(const Vector< IndexedDouble > &neighbours,Float *likelihoods,Float *distances,UINT &maxIndex,UINT &label) const{
+    
+    std::fill(likelihoods,likelihoods+numClasses,0);
+    std::fill(distances,distances+numClasses,0);
+    
+    //Count the classes
+    for(UINT k=0; k<neighbours.size(); k++){
+        const UINT classLabelIndex = sampleClassIndexs[ neighbours[k].index ];
+        likelihoods[ classLabelIndex ] += 1;
+        distances[ classLabelIndex ] += neighbours[k].value;
     }
     
     //Get the max count
-    Float maxCount = classLikelihoods[0];
-    UINT maxIndex = 0;
-    for(UINT i=1; i<classLikelihoods.size(); i++){
-        if( classLikelihoods[i] > maxCount ){
-            maxCount = classLikelihoods[i];
+    Float maxCount = likelihoods[0];
+    maxIndex = 0;
+    for(UINT i=1; i<numClasses; i++){
+        if( likelihoods[i] > maxCount ){
+            maxCount = likelihoods[i];
             maxIndex = i;
         }
     }
     
     //Compute the average distances per class
     for(UINT i=0; i<numClasses; i++){
-        if( classLikelihoods[i] > 0 )   classDistances[i] /= classLikelihoods[i];
-        else classDistances[i] = BIG_DISTANCE;
-        }
+        if( likelihoods[i] > 0 )   distances[i] /= likelihoods[i];
+        else distances[i] = BIG_DISTANCE;
+    }
     
     //Normalize the likelihoods
     for(UINT i=0; i<numClasses; i++){
-        classLikelihoods[i] /= Float( neighbours.size() );
+        likelihoods[i] /= Float( neighbours.size() );
     }
     
-    //Set the maximum likelihood value
-    maxLikelihood = classLikelihoods[ maxIndex ];
-    
     if( useNullRejection ){
-        if( classDistances[ maxIndex ] <= nullRejectionThresholds[ maxIndex ] ){
-            predictedClassLabel = classLabels[maxIndex];
+        if( distances[ maxIndex ] <= nullRejectionThresholds[ maxIndex ] ){
+            label = classLabels[maxIndex];
         }else{
-            predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL; //Set the gesture label as the null label
+            label = GRT_DEFAULT_NULL_CLASS_LABEL; //Set the gesture label as the null label
         }
     }else{
-        predictedClassLabel = classLabels[maxIndex];
+        label = classLabels[maxIndex];
     }
-    
-    return true;
 }
 
 bool KNN::clear(){
@@ -521,6 +773,10 @@ bool KNN::clear(){
     trainingData.clear();
     trainingMu.clear();
     trainingSigma.clear();
+    spatialIndex.clear();
+    packedSamples.clear();
+    packedNorms.clear();
+    sampleClassIndexs.clear();
     
     return true;
 }
@@ -703,6 +959,11 @@ bool KNN::load( std::fstream &file ){
             trainingData.addSample(classLabel, sample);
         }
         
+        //Rebuild the packed and indexed training data
+        if( !buildSearchData() ){
+            return false;
+        }
+        
         maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
         bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
         classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
@@ -766,11 +1027,84 @@ bool KNN::setNullRejectionCoeff(const Float nullRejectionCoeff){
 bool KNN::setDistanceMethod(UINT distanceMethod){
     if( distanceMethod == EUCLIDEAN_DISTANCE || distanceMethod == COSINE_DISTANCE || distanceMethod == MANHATTAN_DISTANCE ){
         this->distanceMethod = distanceMethod;
+        
+        //The index of a trained model depends on the distance, so it needs to be rebuilt
+        if( trained ) return buildSearchData();
         return true;
     }
     return false;
 }
 
+bool KNN::enableSpatialIndex(const bool useSpatialIndex){
+    this->useSpatialIndex = useSpatialIndex;
+    if( trained ) return buildSearchData();
+    return true;
+}
+
+bool KNN::buildSearchData(){
+    
+    spatialIndex.clear();
+    packedSamples.clear();
+    packedNorms.clear();
+    sampleClassIndexs.clear();
+    
+    const UINT M = trainingData.getNumSamples();
+    const UINT N = numInputDimensions;
+    
+    //Store the index of the class of each training example, so the neighbours can be counted without searching the class labels
+    sampleClassIndexs.resize( M, 0 );
+    for(UINT i=0; i<M; i++){
+        const UINT classLabel = trainingData[i].getClassLabel();
+        if( classLabel == 0 ){
+            errorLog << __GRT_LOG__ << " Class label of training example can not be zero!" << std::endl;
+            return false;
+        }
+        for(UINT k=0; k<classLabels.getSize(); k++){
+            if( classLabel == classLabels[k] ){
+                sampleClassIndexs[i] = k;
+                break;
+            }
+        }
+    }
+    
+    //Build the KDTree for the metric distances, if there are enough training examples for it to prune the search (at least 2^N)
+    if( useSpatialIndex && (distanceMethod == EUCLIDEAN_DISTANCE || distanceMethod == MANHATTAN_DISTANCE) && N < 32 && M >= (1u << N) ){
+        const UINT indexDistanceMethod = distanceMethod == EUCLIDEAN_DISTANCE ? KDTree::EUCLIDEAN_DISTANCE : KDTree::MANHATTAN_DISTANCE;
+        if( !spatialIndex.build( trainingData.getDataAsMatrixFloat(), indexDistanceMethod ) ){
+            errorLog << __GRT_LOG__ << " Failed to build the KDTree from the training data!" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    //Otherwise pack the training examples into blocks for the full scan, the last block is padded with zeros
+    const UINT blockSize = GRT_KNN_BLOCK_SIZE;
+    const UINT numBlocks = (M + blockSize - 1) / blockSize;
+    packedSamples.resize( numBlocks*blockSize*N, 0 );
+    for(UINT i=0; i<M; i++){
+        Float *block = &packedSamples[ (i/blockSize)*blockSize*N ];
+        const VectorFloat &sample = trainingData[i].getSample();
+        for(UINT j=0; j<N; j++){
+            block[ j*blockSize + i%blockSize ] = sample[j];
+        }
+    }
+    
+    //The cosine measure also needs the norm of each training example
+    if( distanceMethod == COSINE_DISTANCE ){
+        packedNorms.resize( M );
+        for(UINT i=0; i<M; i++){
+            const VectorFloat &sample = trainingData[i].getSample();
+            Float magB = 0;
+            for(UINT j=0; j<N; j++){
+                magB += SQR( sample[j] );
+            }
+            packedNorms[i] = sqrt( magB );
+        }
+    }
+    
+    return true;
+}
+
 Float KNN::computeEuclideanDistance(const VectorFloat &a,const VectorFloat &b){
     Float dist = 0;
     for(UINT j=0; j<numInputDimensions; j++){
@@ -955,6 +1289,11 @@ bool KNN::loadLegacyModelFromFile( std::fstream &file ){
         trainingData.addSample(classLabel, sample);
     }
     
+    //Rebuild the packed and indexed training data
+    if( !buildSearchData() ){
+        return false;
+    }
+    
     //Flag that the model has been trained
     trained = true;
     
@@ -27,6 +27,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define GRT_KNN_HEADER
 
 #include "../../CoreModules/Classifier.h"
+#include "../../CoreAlgorithms/KDTree/KDTree.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -44,6 +45,14 @@ distance of the closest K neighbors with the class label of the majority vote is
 the predicted class label will be set to 0, indicating that the majority class was rejected.  This feature can be enabled or disabled by setting
 the enableNullRejection paramter to false.
 
+For the Euclidean and Manhattan distances, the training data is indexed with a KDTree after training (or loading), so each prediction only
+needs to test the training examples near the input vector.  The KDTree finds the exact K nearest neighbours, so the predictions are the same as
+testing every training example.  The index is only built when it can prune the search (when there are at least 2^N training examples for N
+dimensions), otherwise every training example is tested.  Neighbours at the same distance are ranked by the order of the training examples.
+For the full scan, the training data is packed into blocks of 8 examples that are tested together (with AVX2 instructions when the CPU supports
+them) and the K nearest neighbours are kept in a heap.  The predictBatch function tests a tile of input vectors against each block, so each block
+is only loaded into the cache once per tile.
+
 @example ClassificationModulesExamples/KNNExample/KNNExample.cpp
 
 @remark This implementation is based on Bishop, Christopher M. Pattern recognition and machine learning. Vol. 1. New York: springer, 2006.
@@ -103,6 +112,16 @@ public:
     @return returns true if the KNN model was trained, false otherwise
     */
     virtual bool train_(ClassificationData &trainingData);
+
+    /**
+    This trains the KNN model, using a view of the labelled classification data.  The samples in the view are copied once, as the
+    KNN model is its (scaled) training data, the validation set and the search for the best K value use views of that copy.
+    Any class without samples in the view is not copied.
+
+    @param view: a reference to a view of the training data
+    @return returns true if the KNN model was trained, false otherwise
+    */
+    virtual bool train_(ClassificationDataView &view);
     
     /**
     This predicts the class of the inputVector.
@@ -113,6 +132,19 @@ public:
     */
     virtual bool predict_(VectorFloat &inputVector);
     
+    /**
+    This predicts the class of each row of the input data.  The rows are predicted in tiles, each block of the training data is tested against
+    all the rows in a tile before moving to the next block.  The results for each row are the same as calling predict with that row, the
+    class likelihoods and labels of each row are returned in the matrix and vector (the classLikelihoods and predictedClassLabel of the
+    model are not changed).
+    
+    @param inputData: the input data to classify, each row is a sample and the number of columns must match the number of features of the model
+    @param classLikelihoods: returns the class likelihoods of each row, this will be resized to [inputData.getNumRows() numClasses]
+    @param predictedClassLabels: returns the predicted class label of each row, this will be resized to inputData.getNumRows()
+    @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictBatch(const MatrixFloat &inputData,MatrixFloat &classLikelihoods,Vector< UINT > &predictedClassLabels);
+    
     /**
     This overrides the clear function in the Classifier base class.
     It will completely clear the ML module, removing any trained model and setting all the base variables to their default values.
@@ -215,6 +247,29 @@ public:
     */
     bool setDistanceMethod(UINT distanceMethod);
     
+    /**
+    Sets if a KDTree should be built from the training data to speed up the search for the nearest neighbours.
+    The KDTree is only built for the Euclidean and Manhattan distances, and when there are enough training examples for it to prune the search.
+    The predictions are the same with or without the KDTree.  The default value is true.
+    
+    @return returns true if the parameter was updated successfully, false otherwise
+    */
+    bool enableSpatialIndex(const bool useSpatialIndex);
+    
+    /**
+    Gets if a KDTree will be built from the training data to speed up the search for the nearest neighbours.
+    
+    @return returns true if a KDTree will be built, false otherwise
+    */
+    bool getUseSpatialIndex() const{ return useSpatialIndex; }
+    
+    /**
+    Gets if a KDTree has been built from the training data and is being used to search for the nearest neighbours.
+    
+    @return returns true if the KDTree is being used, false otherwise
+    */
+    bool getSpatialIndexBuilt() const{ return spatialIndex.getBuilt(); }
+    
     /**
     Gets a string that represents the KNN class.
     
@@ -230,9 +285,12 @@ public:
     using MLBase::predict;
     
 protected:
-    bool train_(const ClassificationData &trainingData,const UINT K);
+    bool train_(const ClassificationDataView &trainingData,const UINT K);
     bool predict(const VectorFloat &inputVector,const UINT K);
     bool loadLegacyModelFromFile( std::fstream &file );
+    bool buildSearchData();
+    bool searchNeighbours(const Float **queries,const UINT numQueries,const UINT K,Vector< IndexedDouble > *neighbours) const;
+    void classifyNeighbours(const Vector< IndexedDouble > &neighbours,Float *likelihoods,Float *distances,UINT &maxIndex,UINT &label) const;
     Float computeEuclideanDistance(const VectorFloat &a,const VectorFloat &b);
     Float computeCosineDistance(const VectorFloat &a,const VectorFloat &b);
     Float computeManhattanDistance(const VectorFloat &a,const VectorFloat &b);
@@ -245,6 +303,12 @@ protected:
     ClassificationData trainingData;            ///> Holds the trainingData to perform the predictions
     VectorFloat trainingMu;                    ///> Holds the average max-class distance of the training data for each of classes
     VectorFloat trainingSigma;                 ///> Holds the stddev of the max-class distance of the training data for each of classes
+    bool useSpatialIndex;                       ///> Sets if a KDTree should be built from the training data
+    KDTree spatialIndex;                        ///> The KDTree of the training data, this is empty if the nearest neighbours are found by testing every training example
+    VectorFloat packedSamples;                  ///> The training data packed into blocks of examples for the full scan, this is empty if the KDTree is used
+    VectorFloat packedNorms;                    ///> The norm of each training example, this is only used by the cosine distance
+    Vector< UINT > sampleClassIndexs;           ///> The index in classLabels of the class of each training example
+    Vector< IndexedDouble > neighbours;         ///> A buffer holding the neighbours found by the last prediction
     
 private:
     static RegisterClassifierModule< KNN > registerModule;
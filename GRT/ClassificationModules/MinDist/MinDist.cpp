@@ -82,12 +82,18 @@ bool MinDist::deepCopyFrom(const Classifier *classifier){
 
 bool MinDist::train_(ClassificationData &trainingData){
     
+    //The MinDist model does not need to modify the training data, so it is trained from a view of the data rather than a copy
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool MinDist::train_(ClassificationDataView &trainingData){
+    
     //Clear any previous models
     clear();
     
     const unsigned int M = trainingData.getNumSamples();
     const unsigned int N = trainingData.getNumDimensions();
-    const unsigned int K = trainingData.getNumClasses();
     
     if( M == 0 ){
         errorLog << __GRT_LOG__ << " Training data has zero samples!" << std::endl;
@@ -99,24 +105,23 @@ bool MinDist::train_(ClassificationData &trainingData){
         return false;
     }
     
+    ranges = trainingData.getRanges();
+    ClassificationDataView validationData;
+
+    if( useValidationSet ){
+        validationData = trainingData.split( 100-validationSetSize, false, random );
+    }
+
+    //A model can only be trained for a class with samples, so drop any class that has no samples in the view (or was moved to the validation set)
+    trainingData.removeEmptyClasses();
+    
+    const unsigned int K = trainingData.getNumClasses();
     numInputDimensions = N;
     numOutputDimensions = K;
     numClasses = K;
     models.resize(K);
     classLabels.resize(K);
     nullRejectionThresholds.resize(K);
-    ranges = trainingData.getRanges();
-    ClassificationData validationData;
-    
-    //Scale the training data if needed
-    if( useScaling ){
-        //Scale the training data between 0 and 1
-        trainingData.scale(0, 1);
-    }
-
-    if( useValidationSet ){
-        validationData = trainingData.split( 100-validationSetSize );
-    }
     
     //Train each of the models
     for(UINT k=0; k<numClasses; k++){
@@ -132,16 +137,8 @@ bool MinDist::train_(ClassificationData &trainingData){
         //Set the kth class label
         classLabels[k] = classLabel;
         
-        //Get all the training data for this class
-        ClassificationData classData = trainingData.getClassData(classLabel);
-        MatrixFloat data(classData.getNumSamples(),N);
-        
-        //Copy the training data into a matrix
-        for(UINT i=0; i<data.getNumRows(); i++){
-            for(UINT j=0; j<data.getNumCols(); j++){
-                data[i][j] = classData[i][j];
-            }
-        }
+        //Copy the training data for this class into a matrix, scaling it between 0 and 1 if needed, this is the only copy of the training data that is made
+        MatrixFloat data = useScaling ? trainingData.getClassView(classLabel).getDataAsMatrixFloat(ranges, 0, 1) : trainingData.getClassView(classLabel).getDataAsMatrixFloat();
         
         //Train the model for this class
         models[k].setGamma( nullRejectionCoeff );
@@ -160,13 +157,10 @@ bool MinDist::train_(ClassificationData &trainingData){
     trained = true;
     converged = true;
 
-    //Compute the final training stats
+    //Compute the final training stats, the view has not been scaled so the model scales each sample as it is tested
     trainingSetAccuracy = 0;
     validationSetAccuracy = 0;
 
-    //If scaling was on, then the data will already be scaled, so turn it off temporially so we can test the model accuracy
-    bool scalingState = useScaling;
-    useScaling = false;
     if( !computeAccuracy( trainingData, trainingSetAccuracy ) ){
         trained = false;
         converged = false;
@@ -190,9 +184,6 @@ bool MinDist::train_(ClassificationData &trainingData){
         trainingLog << "Validation set accuracy: " << validationSetAccuracy << std::endl;
     }
 
-    //Reset the scaling state for future prediction
-    useScaling = scalingState;
-
     return trained;
 }
 
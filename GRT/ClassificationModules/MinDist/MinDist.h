@@ -88,6 +88,16 @@ public:
     @return returns true if the MinDist model was trained, false otherwise
     */
     virtual bool train_(ClassificationData &trainingData);
+
+    /**
+    This trains the MinDist model, using a view of the labelled classification data.  The samples in the view are not copied or modified,
+    only the samples of each class are copied into a matrix as the model for that class is trained.  Any class without samples in the view
+    is removed from the view, a model is only trained for the classes with samples.
+
+    @param trainingData: a reference to a view of the training data
+    @return returns true if the MinDist model was trained, false otherwise
+    */
+    virtual bool train_(ClassificationDataView &trainingData);
     
     /**
     This predicts the class of the inputVector.
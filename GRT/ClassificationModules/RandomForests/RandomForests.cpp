@@ -20,6 +20,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "RandomForests.h"
+#include <mutex>
 
 GRT_BEGIN_NAMESPACE
 
@@ -41,6 +42,8 @@ RandomForests::RandomForests(const DecisionTreeNode &decisionTreeNode,const UINT
     this->removeFeaturesAtEachSplit = removeFeaturesAtEachSplit;
     this->useScaling = useScaling;
     this->bootstrappedDatasetWeight = bootstrappedDatasetWeight;
+    this->oobError = 0;
+    this->flatForestBuilt = false;
     classifierMode = STANDARD_CLASSIFIER_MODE;
     useNullRejection = false;
     supportsNullRejection = false;
@@ -51,6 +54,7 @@ RandomForests::RandomForests(const DecisionTreeNode &decisionTreeNode,const UINT
 RandomForests::RandomForests(const RandomForests &rhs) : Classifier( RandomForests::getId() )
 {
     this->decisionTreeNode = NULL;
+    this->flatForestBuilt = false;
     classifierMode = STANDARD_CLASSIFIER_MODE;
     *this = rhs;
 }
@@ -95,6 +99,7 @@ RandomForests& RandomForests::operator=(const RandomForests &rhs){
             this->maxDepth = rhs.maxDepth;
             this->removeFeaturesAtEachSplit = rhs.removeFeaturesAtEachSplit;
             this->bootstrappedDatasetWeight = rhs.bootstrappedDatasetWeight;
+            this->oobError = rhs.oobError;
             this->trainingMode = rhs.trainingMode;
             
         }else errorLog << __GRT_LOG__ << " Failed to copy base variables!" << std::endl;
@@ -136,6 +141,7 @@ bool RandomForests::deepCopyFrom(const Classifier *classifier){
             this->maxDepth = ptr->maxDepth;
             this->removeFeaturesAtEachSplit = ptr->removeFeaturesAtEachSplit;
             this->bootstrappedDatasetWeight = ptr->bootstrappedDatasetWeight;
+            this->oobError = ptr->oobError;
             this->trainingMode = ptr->trainingMode;
             
             return true;
@@ -148,9 +154,19 @@ bool RandomForests::deepCopyFrom(const Classifier *classifier){
 
 bool RandomForests::train_(ClassificationData &trainingData){
     
+    //The trees are trained from bootstrapped views of the training data, so the forest is trained from a view of the data rather than a copy
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool RandomForests::train_(ClassificationDataView &trainingData){
+    
     //Clear any previous model
     clear();
     
+    //Only the classes with samples can be predicted, so drop any class that has no samples in the view
+    trainingData.removeEmptyClasses();
+    
     const unsigned int M = trainingData.getNumSamples();
     const unsigned int N = trainingData.getNumDimensions();
     const unsigned int K = trainingData.getNumClasses();
@@ -171,10 +187,14 @@ bool RandomForests::train_(ClassificationData &trainingData){
     classLabels = trainingData.getClassLabels();
     ranges = trainingData.getRanges();
     
-    //Scale the training data if needed
+    //The trees are built from data scaled between 0 and 1, so if scaling is needed the view is copied once and the copy is scaled,
+    //otherwise the bootstrapped datasets of the trees are views of the dataset the training view refers to and no samples are copied
+    ClassificationData scaledData;
+    ClassificationDataView forestData = trainingData;
     if( useScaling ){
-        //Scale the training data between 0 and 1
-        trainingData.scale(0, 1);
+        scaledData = trainingData.getClassificationData();
+        scaledData.scale(ranges, 0, 1);
+        forestData = ClassificationDataView( scaledData );
     }
     
     if( useValidationSet ){
@@ -186,14 +206,33 @@ bool RandomForests::train_(ClassificationData &trainingData){
     //Flag that the main algorithm has been trained encase we need to trigger any callbacks
     trained = true;
     
-    //Train the random forest
-    forest.reserve( forestSize );
-    
+    //Draw the seed for each tree up front from this instance's random generator, this makes each tree (and the
+    //forest) depend only on this generator and not on the order in which the trees are trained or the number of threads
+    Vector< unsigned long long > treeSeeds( forestSize );
     for(UINT i=0; i<forestSize; i++){
+        treeSeeds[i] = (unsigned long long)random.getRandomNumberInt( 1, std::numeric_limits< int >::max() );
+    }
+    
+    const UINT datasetSize = (UINT)floor(forestData.getNumSamples() * bootstrappedDatasetWeight);
+    Vector< UINT > treeTrained( forestSize, 0 );
+    Vector< Float > treeTrainingTime( forestSize, 0 );
+    Vector< Float > treeValidationAccuracy( forestSize, 0 );
+    Vector< VectorFloat > treeValidationPrecision( forestSize );
+    Vector< VectorFloat > treeValidationRecall( forestSize );
+    
+    //The out-of-bag votes, each tree votes for the samples that were not in its bootstrapped dataset
+    MatrixFloat oobVotes( M, K );
+    oobVotes.setAllValues( 0 );
+    std::mutex oobMutex;
+    
+    //Train the random forest, the trees are independent so they can be trained in parallel
+    forest.resize( forestSize, NULL );
+    
+    ThreadPool::parallel_for( 0, forestSize, [&](const UINT i){
         
-        //Get a balanced bootstrapped dataset
-        UINT datasetSize = (UINT)floor(trainingData.getNumSamples() * bootstrappedDatasetWeight);
-        ClassificationData data = trainingData.getBootstrappedDataset( datasetSize, true );
+        //Get a balanced bootstrapped view, this keeps every class of the forest so the class indexs of the tree match the forest
+        Random treeRandom( treeSeeds[i] );
+        ClassificationDataView data = forestData.getBootstrappedView( datasetSize, true, treeRandom, true );
         
         Timer timer;
         timer.start();
@@ -209,51 +248,107 @@ bool RandomForests::train_(ClassificationData &trainingData){
         tree.setMaxDepth( maxDepth );
         tree.enableNullRejection( useNullRejection );
         tree.setRemoveFeaturesAtEachSplit( removeFeaturesAtEachSplit );
-        
-        trainingLog << "Training decision tree " << i+1 << "/" << forestSize << "..." << std::endl;
+        tree.setRandomSeed( (unsigned long long)treeRandom.getRandomNumberInt( 1, std::numeric_limits< int >::max() ) );
         
         //Train this tree
         if( !tree.train_( data ) ){
+            return;
+        }
+        
+        treeTrainingTime[i] = timer.getMilliSeconds();
+        
+        if( useValidationSet ){
+            treeValidationAccuracy[i] = tree.getValidationSetAccuracy();
+            treeValidationPrecision[i] = tree.getValidationSetPrecision();
+            treeValidationRecall[i] = tree.getValidationSetRecall();
+        }
+        
+        //Deep copy the tree into the forest
+        forest[i] = tree.deepCopyTree();
+        if( forest[i] == NULL ){
+            return;
+        }
+        treeTrained[i] = 1;
+        
+        //Find the samples that were not used to train this tree and get this tree's vote for each of them, the bootstrapped view
+        //holds the indexs of its samples in the dataset the forest data refers to
+        Vector< UINT > inBag( forestData.getDataset().getNumSamples(), 0 );
+        for(UINT j=0; j<data.getNumSamples(); j++){
+            inBag[ data.getIndex(j) ] = 1;
+        }
+        
+        Vector< UINT > oobSamples;
+        Vector< UINT > oobPredictions;
+        VectorFloat x;
+        VectorFloat y;
+        for(UINT j=0; j<M; j++){
+            if( inBag[ forestData.getIndex(j) ] ) continue;
+            x = forestData[j].getSample();
+            if( !forest[i]->predict_( x, y ) ) continue;
+            oobSamples.push_back( j );
+            oobPredictions.push_back( (UINT)(std::max_element( y.begin(), y.end() ) - y.begin()) );
+        }
+        
+        //The votes are whole numbers, so the order in which the trees add their votes does not change the result
+        std::unique_lock< std::mutex > lock( oobMutex );
+        for(UINT j=0; j<oobSamples.getSize(); j++){
+            oobVotes[ oobSamples[j] ][ oobPredictions[j] ] += 1;
+        }
+    }, 1 );
+    
+    //Combine the results from each tree in forest order
+    for(UINT i=0; i<forestSize; i++){
+        
+        if( !treeTrained[i] ){
             errorLog << __GRT_LOG__ << " Failed to train tree at forest index: " << i << std::endl;
             clear();
             return false;
         }
         
-        Float computeTime = timer.getMilliSeconds();
-        trainingLog << "Decision tree trained in " << (computeTime*0.001)/60.0 << " minutes" << std::endl;
+        trainingLog << "Decision tree " << i+1 << "/" << forestSize << " trained in " << (treeTrainingTime[i]*0.001)/60.0 << " minutes" << std::endl;
         
         if( useValidationSet ){
             Float forestNorm = 1.0 / forestSize;
-            validationSetAccuracy += tree.getValidationSetAccuracy();
-            VectorFloat precision = tree.getValidationSetPrecision();
-            VectorFloat recall = tree.getValidationSetRecall();
+            validationSetAccuracy += treeValidationAccuracy[i];
+            const VectorFloat &precision = treeValidationPrecision[i];
+            const VectorFloat &recall = treeValidationRecall[i];
             
             grt_assert( precision.getSize() == validationSetPrecision.getSize() );
             grt_assert( recall.getSize() == validationSetRecall.getSize() );
             
-            for(UINT i=0; i<validationSetPrecision.getSize(); i++){
-                validationSetPrecision[i] += precision[i] * forestNorm;
+            for(UINT j=0; j<validationSetPrecision.getSize(); j++){
+                validationSetPrecision[j] += precision[j] * forestNorm;
             }
             
-            for(UINT i=0; i<validationSetRecall.getSize(); i++){
-                validationSetRecall[i] += recall[i] * forestNorm;
+            for(UINT j=0; j<validationSetRecall.getSize(); j++){
+                validationSetRecall[j] += recall[j] * forestNorm;
             }
         }
-
-        //Deep copy the tree into the forest
-        forest.push_back( tree.deepCopyTree() );
     }
+    
+    //Compute the out-of-bag error, samples that were used to train every tree have no votes and are ignored
+    UINT numOOBSamples = 0;
+    UINT numOOBErrors = 0;
+    for(UINT j=0; j<M; j++){
+        UINT bestIndex = 0;
+        for(UINT k=1; k<K; k++){
+            if( oobVotes[j][k] > oobVotes[j][bestIndex] ) bestIndex = k;
+        }
+        if( oobVotes[j][bestIndex] == 0 ) continue;
+        numOOBSamples++;
+        if( classLabels[ bestIndex ] != forestData[j].getClassLabel() ) numOOBErrors++;
+    }
+    oobError = numOOBSamples > 0 ? numOOBErrors / Float(numOOBSamples) : 0;
+    
+    trainingLog << "Out-of-bag error: " << oobError << " (" << numOOBSamples << " samples)" << std::endl;
 
     //Flag that the models have been trained
     trained = true;
     converged = true;
 
-    //Compute the final training stats
+    //Compute the final training stats, the training view has not been scaled so the model scales each sample as it is tested
     trainingSetAccuracy = 0;
 
-    //If scaling was on, then the data will already be scaled, so turn it off temporially so we can test the model accuracy
-    bool scalingState = useScaling;
-    useScaling = false;
     if( !computeAccuracy( trainingData, trainingSetAccuracy ) ){
         trained = false;
         converged = true;
@@ -262,9 +357,6 @@ bool RandomForests::train_(ClassificationData &trainingData){
     }
 
     trainingLog << "Training set accuracy: " << trainingSetAccuracy << std::endl;
-
-    //Reset the scaling state for future prediction
-    useScaling = scalingState;
     
     if( useValidationSet ){
         validationSetAccuracy /= forestSize;
@@ -312,16 +404,23 @@ bool RandomForests::predict_(VectorDouble &inputVector){
     
     std::fill(classDistances.begin(),classDistances.end(),0);
     
+    //Flatten the forest the first time it is used, if any of its nodes can not be flattened then each tree is run node by node
+    if( !flatForestBuilt ) buildFlatForest();
+    
     //Run the prediction for each tree in the forest
-    VectorDouble y;
-    for(UINT i=0; i<forestSize; i++){
-        if( !forest[i]->predict_(inputVector, y) ){
-            errorLog << __GRT_LOG__ << " Tree " << i << " failed prediction!" << std::endl;
-            return false;
-        }
-        
-        for(UINT j=0; j<numClasses; j++){
-            classDistances[j] += y[j];
+    if( flatForest.getNumTrees() > 0 ){
+        flatForest.predict( inputVector, classDistances );
+    }else{
+        VectorDouble y;
+        for(UINT i=0; i<forestSize; i++){
+            if( !forest[i]->predict_(inputVector, y) ){
+                errorLog << __GRT_LOG__ << " Tree " << i << " failed prediction!" << std::endl;
+                return false;
+            }
+            
+            for(UINT j=0; j<numClasses; j++){
+                classDistances[j] += y[j];
+            }
         }
     }
     
@@ -344,6 +443,79 @@ bool RandomForests::predict_(VectorDouble &inputVector){
     return true;
 }
 
+bool RandomForests::predictBatch(const MatrixFloat &inputData,MatrixFloat &classLikelihoods,Vector< UINT > &predictedClassLabels){
+    
+    if( !trained ){
+        errorLog << __GRT_LOG__ << " Model Not Trained!" << std::endl;
+        return false;
+    }
+    
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << __GRT_LOG__ << " The number of columns in the input data (" << inputData.getNumCols() << ") does not match the num features in the model (" << numInputDimensions << std::endl;
+        return false;
+    }
+    
+    if( !flatForestBuilt ) buildFlatForest();
+    
+    const UINT M = inputData.getNumRows();
+    predictedClassLabels.resize( M );
+    
+    //Scale a copy of the input data if needed
+    MatrixFloat scaledData;
+    if( useScaling ){
+        scaledData = inputData;
+        for(UINT i=0; i<M; i++){
+            for(UINT n=0; n<numInputDimensions; n++){
+                scaledData[i][n] = grt_scale(scaledData[i][n], ranges[n].minValue, ranges[n].maxValue, 0.0, 1.0);
+            }
+        }
+    }
+    const MatrixFloat &data = useScaling ? scaledData : inputData;
+    
+    //Sum the leaf class probabilities of each tree
+    if( flatForest.getNumTrees() > 0 ){
+        if( !flatForest.predict( data, classLikelihoods ) ){
+            errorLog << __GRT_LOG__ << " Failed to run the flat forest!" << std::endl;
+            return false;
+        }
+    }else{
+        if( !classLikelihoods.resize( M, numClasses ) ) return false;
+        classLikelihoods.setAllValues( 0 );
+        VectorFloat x( numInputDimensions );
+        VectorFloat y;
+        for(UINT i=0; i<M; i++){
+            std::copy( data[i], data[i]+numInputDimensions, x.begin() );
+            for(UINT t=0; t<forestSize; t++){
+                if( !forest[t]->predict_( x, y ) ){
+                    errorLog << __GRT_LOG__ << " Tree " << t << " failed prediction!" << std::endl;
+                    return false;
+                }
+                for(UINT k=0; k<numClasses; k++){
+                    classLikelihoods[i][k] += y[k];
+                }
+            }
+        }
+    }
+    
+    //Use the class distances to estimate the class likelihoods and pick the most likely class of each row
+    const Float classNorm = 1.0 / Float(forestSize);
+    for(UINT i=0; i<M; i++){
+        Float *likelihoods = classLikelihoods[i];
+        Float bestLikelihood = 0;
+        UINT bestIndex = 0;
+        for(UINT k=0; k<numClasses; k++){
+            likelihoods[k] *= classNorm;
+            if( likelihoods[k] > bestLikelihood ){
+                bestLikelihood = likelihoods[k];
+                bestIndex = k;
+            }
+        }
+        predictedClassLabels[i] = classLabels[ bestIndex ];
+    }
+    
+    return true;
+}
+
 bool RandomForests::clear(){
     
     //Call the classifiers clear function
@@ -358,6 +530,9 @@ bool RandomForests::clear(){
         }
     }
     forest.clear();
+    flatForest.clear();
+    flatForestBuilt = false;
+    oobError = 0;
 
     if( this->decisionTreeNode ){
         this->decisionTreeNode->clear();
@@ -630,6 +805,29 @@ bool RandomForests::combineModels( const RandomForests &forest ){
         }
     }
     
+    //The flat forest will be rebuilt with the new trees the next time it is used
+    flatForest.clear();
+    flatForestBuilt = false;
+    
+    return true;
+}
+
+bool RandomForests::buildFlatForest(){
+    
+    flatForestBuilt = true;
+    
+    if( !flatForest.init( numClasses ) ){
+        return false;
+    }
+    
+    for(UINT i=0; i<forest.getSize(); i++){
+        if( !flatForest.addTree( forest[i] ) ){
+            flatForest.clear();
+            warningLog << __GRT_LOG__ << " Failed to flatten tree " << i << ", the forest will be run node by node!" << std::endl;
+            return false;
+        }
+    }
+    
     return true;
 }
 
@@ -661,6 +859,10 @@ Float RandomForests::getBootstrappedDatasetWeight() const {
     return bootstrappedDatasetWeight;
 }
 
+Float RandomForests::getOOBError() const {
+    return oobError;
+}
+
 const Vector< DecisionTreeNode* >& RandomForests::getForest() const {
     return forest;
 }
@@ -782,7 +984,7 @@ bool RandomForests::setRemoveFeaturesAtEachSpilt(const bool removeFeaturesAtEach
 }
 
 bool RandomForests::setTrainingMode(const Tree::TrainingMode trainingMode){
-    if( trainingMode == Tree::BEST_ITERATIVE_SPILT || trainingMode == Tree::BEST_RANDOM_SPLIT ){
+    if( trainingMode == Tree::BEST_ITERATIVE_SPILT || trainingMode == Tree::BEST_RANDOM_SPLIT || trainingMode == Tree::BEST_HISTOGRAM_SPLIT ){
         this->trainingMode = trainingMode;
         return true;
     }
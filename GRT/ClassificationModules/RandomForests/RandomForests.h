@@ -102,6 +102,17 @@ public:
     @return returns true if the RandomForests model was trained, false otherwise
     */
     virtual bool train_(ClassificationData &trainingData);
+
+    /**
+    This trains the RandomForests model, using a view of the labelled classification data.  Each tree is trained from a bootstrapped
+    view, so the bootstrapped datasets are not copied.  If scaling is enabled the samples in the view are copied once and the copy is scaled,
+    otherwise the samples are only copied into the column-major store of each tree as it is built.  Any class without samples in the view is
+    removed from the view.
+
+    @param trainingData: a reference to a view of the training data
+    @return returns true if the RandomForests model was trained, false otherwise
+    */
+    virtual bool train_(ClassificationDataView &trainingData);
     
     /**
     This predicts the class of the inputVector.
@@ -112,6 +123,18 @@ public:
     */
     virtual bool predict_(VectorDouble &inputVector);
     
+    /**
+    This predicts the class of each row of the inputData. The forest is run over blocks of rows one tree at a time,
+    which is faster than calling predict for each row when there are many rows. The class likelihoods and predicted class
+    label of each row are the same as predict would give for that row, but the last prediction of the model is not updated.
+    
+    @param inputData: the input data to classify, each row is a sample
+    @param classLikelihoods: returns the class likelihoods of each row, this will be resized to [inputData.getNumRows() numClasses]
+    @param predictedClassLabels: returns the predicted class label of each row
+    @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictBatch(const MatrixFloat &inputData,MatrixFloat &classLikelihoods,Vector< UINT > &predictedClassLabels);
+    
     /**
     This function clears the RandomForests module, removing any trained model and setting all the base variables to their default values.
     
@@ -214,6 +237,14 @@ public:
     */
     Float getBootstrappedDatasetWeight() const;
     
+    /**
+    Gets the out-of-bag error of the forest, this is computed during training using, for each training sample, only the trees
+    that did not have that sample in their bootstrapped dataset. It is an estimate of the test error that does not need a separate test dataset.
+    
+    @return returns the out-of-bag error (in the range [0 1]), or zero if the model has not been trained
+    */
+    Float getOOBError() const;
+    
     /**
     Gets a pointer to the tree at the specific index in the forest. NULL will be returned if the model has not been trained or
     the index is invalid.
@@ -354,8 +385,13 @@ protected:
     Tree::TrainingMode trainingMode;
     bool removeFeaturesAtEachSplit;
     Float bootstrappedDatasetWeight;
+    Float oobError;
     DecisionTreeNode* decisionTreeNode;
     Vector< DecisionTreeNode* > forest;
+    FlatForest flatForest;
+    bool flatForestBuilt;
+    
+    bool buildFlatForest();
     
 private:
     static RegisterClassifierModule< RandomForests > registerModule;
@@ -139,6 +139,13 @@ bool SVM::deepCopyFrom(const Classifier *classifier){
 
 bool SVM::train_(ClassificationData &trainingData){
     
+    //The SVM model does not need to modify the training data, so it is trained from a view of the data rather than a copy
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool SVM::train_(ClassificationDataView &trainingData){
+    
     //Clear any previous model
     clear();
     
@@ -148,18 +155,15 @@ bool SVM::train_(ClassificationData &trainingData){
     }
 
     ranges = trainingData.getRanges();
-    ClassificationData validationData;
-    
-    //Scale the training data if needed
-    if( useScaling ){
-        //Scale the training data between 0 and 1
-        trainingData.scale(SVM_MIN_SCALE_RANGE, SVM_MAX_SCALE_RANGE);
-    }
+    ClassificationDataView validationData;
 
     if( useValidationSet ){
-        validationData = trainingData.split( 100-validationSetSize );
+        validationData = trainingData.split( 100-validationSetSize, false, random );
     }
 
+    //LIBSVM only knows the classes it is given samples for, so drop any class that has no samples in the view (or was moved to the validation set)
+    trainingData.removeEmptyClasses();
+
     //Convert the labelled classification data into the LIBSVM data format
     if( !convertClassificationDataToLIBSVMFormat(trainingData) ){
         errorLog << __GRT_LOG__ << " Failed To Convert Classification Data To LIBSVM Format!" << std::endl;
@@ -180,13 +184,10 @@ bool SVM::train_(ClassificationData &trainingData){
     trained = true;
     converged = true;
 
-    //Compute the final training stats
+    //Compute the final training stats, the view has not been scaled so the model scales each sample as it is tested
     trainingSetAccuracy = 0;
     validationSetAccuracy = 0;
 
-    //If scaling was on, then the data will already be scaled, so turn it off temporially so we can test the model accuracy
-    bool scalingState = useScaling;
-    useScaling = false;
     if( !computeAccuracy( trainingData, trainingSetAccuracy ) ){
         trained = false;
         errorLog << __GRT_LOG__ << " Failed to compute training set accuracy! Failed to fully train model!" << std::endl;
@@ -206,9 +207,6 @@ bool SVM::train_(ClassificationData &trainingData){
     if( useValidationSet ){
         trainingLog << "Validation set accuracy: " << validationSetAccuracy << std::endl;
     }
-
-    //Reset the scaling state for future prediction
-    useScaling = scalingState;
     
     return trained;
 }
@@ -506,7 +504,7 @@ bool SVM::predictSVM(VectorFloat &inputVector,Float &maxProbability, VectorFloat
     return true;
 }
 
-bool SVM::convertClassificationDataToLIBSVMFormat(ClassificationData &trainingData){
+bool SVM::convertClassificationDataToLIBSVMFormat(const ClassificationDataView &trainingData){
     
     //clear any previous problems
     deleteProblemSet();
@@ -522,14 +520,17 @@ bool SVM::convertClassificationDataToLIBSVMFormat(ClassificationData &trainingDa
     problemSet = true;
     
     for(UINT i=0; i<numTrainingExamples; i++){
+        const ClassificationSample &sample = trainingData[i];
+        
         //Set the class ID
-        prob.y[i] = trainingData[i].getClassLabel();
+        prob.y[i] = sample.getClassLabel();
         
         //Assign the memory for this training example, note that a dummy node is needed at the end of the vector
+        //The view has not been scaled, so each value is scaled (if needed) as it is copied into the problem
         prob.x[i] = new svm_node[numInputDimensions+1];
         for(UINT j=0; j<numInputDimensions; j++){
             prob.x[i][j].index = j+1;
-            prob.x[i][j].value = trainingData[i].getSample()[j];
+            prob.x[i][j].value = useScaling ? grt_scale(sample[j],ranges[j].minValue,ranges[j].maxValue,SVM_MIN_SCALE_RANGE,SVM_MAX_SCALE_RANGE) : sample[j];
         }
         prob.x[i][numInputDimensions].index = -1; //Assign the final node value
         prob.x[i][numInputDimensions].value = 0;
@@ -106,6 +106,15 @@ public:
     @return returns true if the SVM model was trained, false otherwise
     */
     virtual bool train_(ClassificationData &trainingData);
+
+    /**
+    This trains the SVM model, using a view of the labelled classification data.  The samples in the view are not copied or modified,
+    each sample is scaled (if needed) as it is copied into the LIBSVM problem.  Any class without samples in the view is removed from the view.
+
+    @param trainingData: a reference to a view of the training data
+    @return returns true if the SVM model was trained, false otherwise
+    */
+    virtual bool train_(ClassificationDataView &trainingData);
     
     /**
     This predicts the class of the inputVector.
@@ -365,7 +374,7 @@ protected:
     bool validateProblemAndParameters();
     bool validateSVMType(SVMType svmType);
     bool validateKernelType(KernelType kernelType);
-    bool convertClassificationDataToLIBSVMFormat(ClassificationData &trainingData);
+    bool convertClassificationDataToLIBSVMFormat(const ClassificationDataView &trainingData);
     bool trainSVM();
     
     bool predictSVM(VectorFloat &inputVector);
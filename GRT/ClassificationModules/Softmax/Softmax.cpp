@@ -79,35 +79,40 @@ bool Softmax::deepCopyFrom(const Classifier *classifier){
 
 bool Softmax::train_(ClassificationData &trainingData){
     
+    //The Softmax model does not need to modify the training data, so it is trained from a view of the data rather than a copy
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool Softmax::train_(ClassificationDataView &trainingData){
+    
     //Clear any previous model
     clear();
     
     const unsigned int M = trainingData.getNumSamples();
     const unsigned int N = trainingData.getNumDimensions();
-    const unsigned int K = trainingData.getNumClasses();
     
     if( M == 0 ){
         errorLog << __GRT_LOG__ << " Training data has zero samples!" << std::endl;
         return false;
     }
     
+    ranges = trainingData.getRanges();
+    ClassificationDataView validationData;
+
+    if( useValidationSet ){
+        validationData = trainingData.split( 100-validationSetSize, false, random );
+    }
+
+    //A model can only be trained for a class with samples, so drop any class that has no samples in the view (or was moved to the validation set)
+    trainingData.removeEmptyClasses();
+    
+    const unsigned int K = trainingData.getNumClasses();
     numInputDimensions = N;
     numOutputDimensions = K;
     numClasses = K;
     models.resize(K);
     classLabels.resize(K);
-    ranges = trainingData.getRanges();
-    ClassificationData validationData;
-    
-    //Scale the training data if needed
-    if( useScaling ){
-        //Scale the training data between 0 and 1
-        trainingData.scale(0, 1);
-    }
-
-    if( useValidationSet ){
-        validationData = trainingData.split( 100-validationSetSize );
-    }
     
     //Train a regression model for each class in the training data
     for(UINT k=0; k<numClasses; k++){
@@ -126,13 +131,10 @@ bool Softmax::train_(ClassificationData &trainingData){
     trained = true;
     converged = true;
 
-    //Compute the final training stats
+    //Compute the final training stats, the view has not been scaled so the model scales each sample as it is tested
     trainingSetAccuracy = 0;
     validationSetAccuracy = 0;
 
-    //If scaling was on, then the data will already be scaled, so turn it off temporially so we can test the model accuracy
-    bool scalingState = useScaling;
-    useScaling = false;
     if( !computeAccuracy( trainingData, trainingSetAccuracy ) ){
         trained = false;
         converged = false;
@@ -155,9 +157,158 @@ bool Softmax::train_(ClassificationData &trainingData){
         trainingLog << "Validation set accuracy: " << validationSetAccuracy << std::endl;
     }
 
-    //Reset the scaling state for future prediction
+    return trained;
+}
+
+bool Softmax::train_(ChunkedDataset &trainingData){
+
+    //Clear any previous model
+    clear();
+
+    const unsigned int M = trainingData.getNumSamples();
+    const unsigned int N = trainingData.getNumDimensions();
+    const unsigned int K = trainingData.getNumClasses();
+
+    if( trainingData.getDataType() != ChunkedDataset::CLASSIFICATION_DATA ){
+        errorLog << __GRT_LOG__ << " The chunked dataset does not contain classification data!" << std::endl;
+        return false;
+    }
+
+    if( M == 0 ){
+        errorLog << __GRT_LOG__ << " Training data has zero samples!" << std::endl;
+        return false;
+    }
+
+    numInputDimensions = N;
+    numOutputDimensions = K;
+    numClasses = K;
+    models.resize(K);
+    classLabels.resize(K);
+    ranges = trainingData.getInputRanges();
+    if( ranges.getSize() != N ){
+        errorLog << __GRT_LOG__ << " Failed to compute the ranges of the training data!" << std::endl;
+        return false;
+    }
+
+    const Vector< ClassTracker > classTracker = trainingData.getClassTracker();
+    for(UINT k=0; k<numClasses; k++){
+        classLabels[k] = classTracker[k].classLabel;
+        models[k].init( classLabels[k], N );
+    }
+
+    Float error = 0;
+    Float delta = 0;
+    UINT iter = 0;
+    UINT numConverged = 0;
+    VectorFloat errorSum(K,0);
+    VectorFloat lastErrorSum(K,0);
+    VectorFloat batchMean(N);
+    Vector< bool > modelConverged(K,false);
+    const Vector< MinMax > emptyRanges;
+    trainingResults.clear();
+    trainingResults.reserve( maxNumEpochs );
+    TrainingResult epochResult;
+
+    //Run the main stochastic gradient descent training algorithm, each model stops updating once it has converged
+    while( numConverged < K && iter < maxNumEpochs ){
+
+        errorSum.fill(0.0);
+        if( !trainingData.startEpoch() ) return false;
+        while( trainingData.nextChunk() ){
+
+            if( useScaling ) trainingData.scaleChunk( ranges, emptyRanges, 0, 1 );
+
+            const MatrixFloat &X = trainingData.getInputs();
+            const Vector< UINT > &labels = trainingData.getClassLabels();
+            const UINT numRows = X.getNumRows();
+            UINT m=0;
+            while( m < numRows ){
+                //The rows of the chunk are already shuffled, so each batch is a contiguous block of rows
+                const UINT roundSize = m+batchSize < numRows ? batchSize : numRows-m;
+                batchMean.fill(0.0);
+                for(UINT i=m; i<m+roundSize; i++){
+                    for(UINT j=0; j<N; j++){
+                        batchMean[j] += X[i][j];
+                    }
+                }
+                for(UINT j=0; j<N; j++) batchMean[j] /= roundSize;
+
+                for(UINT k=0; k<K; k++){
+                    if( modelConverged[k] ) continue;
+                    SoftmaxModel &model = models[k];
+
+                    //Compute the error on this batch, the samples are relabelled as positive (1.0) or negative (0.0) for this model
+                    error = 0.0;
+                    for(UINT i=m; i<m+roundSize; i++){
+                        error += (labels[i]==model.classLabel ? 1.0 : 0.0) - model.compute( X[i] );
+                    }
+                    error /= roundSize;
+                    errorSum[k] += error;
+
+                    //Update the weights
+                    for(UINT j=0; j<N; j++){
+                        model.w[j] += learningRate  * error * batchMean[j];
+                    }
+                    model.w0 += learningRate  * error;
+                }
+
+                m += roundSize;
+            }
+        }
+
+        iter++;
+        Float totalError = 0;
+        for(UINT k=0; k<K; k++){
+            if( modelConverged[k] ) continue;
+            totalError += errorSum[k];
+
+            //Check to see if this model should stop
+            delta = fabs( errorSum[k]-lastErrorSum[k] );
+            lastErrorSum[k] = errorSum[k];
+            if( delta <= minChange ){
+                modelConverged[k] = true;
+                numConverged++;
+            }
+            trainingLog << "Class: " << classLabels[k] << " Epoch: " << iter << " TotalError: " << errorSum[k] << " Delta: " << delta << std::endl;
+        }
+
+        epochResult.setClassificationResult( iter, totalError, this );
+        trainingResults.push_back( epochResult );
+    }
+
+    //Flag that the models have been trained
+    trained = true;
+    converged = numConverged == K;
+
+    //Compute the training set accuracy with one more pass over the data
+    bool scalingState = useScaling;
+    useScaling = false;
+    UINT numCorrect = 0;
+    VectorFloat x(N);
+    bool ok = trainingData.startEpoch();
+    while( ok && trainingData.nextChunk() ){
+        if( scalingState ) trainingData.scaleChunk( ranges, emptyRanges, 0, 1 );
+        const MatrixFloat &X = trainingData.getInputs();
+        const Vector< UINT > &labels = trainingData.getClassLabels();
+        for(UINT i=0; i<X.getNumRows() && ok; i++){
+            std::copy( X[i], X[i]+N, x.begin() );
+            ok = predict_( x );
+            if( predictedClassLabel == labels[i] ) numCorrect++;
+        }
+    }
     useScaling = scalingState;
 
+    if( !ok ){
+        trained = false;
+        converged = false;
+        errorLog << __GRT_LOG__ << " Failed to compute training set accuracy! Failed to fully train model!" << std::endl;
+        return false;
+    }
+    trainingSetAccuracy = numCorrect / Float(M) * 100.0;
+    validationSetAccuracy = 0;
+
+    trainingLog << "Training set accuracy: " << trainingSetAccuracy << std::endl;
+
     return trained;
 }
 
@@ -220,7 +371,7 @@ bool Softmax::predict_(VectorFloat &inputVector){
     return true;
 }
 
-bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,ClassificationData &data){
+bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,const ClassificationDataView &data){
     
     Float error = 0;
     Float errorSum = 0;
@@ -268,8 +419,10 @@ bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,Classificati
           UINT roundSize = m+batchSize < M ? batchSize : M-m;
           batchMean.fill(0.0);
           for(UINT i=0; i<roundSize; i++){
+            //The view has not been scaled, so each sample is scaled as it is copied into the batch
+            const ClassificationSample &sample = data[ randomTrainingOrder[m+i] ];
             for(UINT j=0; j<N; j++){
-              batchData[i][j] = data[ randomTrainingOrder[m+i] ][j];
+              batchData[i][j] = useScaling ? grt_scale(sample[j], ranges[j].minValue, ranges[j].maxValue, 0.0, 1.0) : sample[j];
               batchMean[j] += batchData[i][j];
             }
           }
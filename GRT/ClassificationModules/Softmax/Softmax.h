@@ -89,6 +89,25 @@ class GRT_API Softmax : public Classifier
     @return returns true if the Softmax model was trained, false otherwise
     */
     virtual bool train_(ClassificationData &trainingData);
+
+    /**
+    This trains the Softmax model, using a view of the labelled classification data.  The samples in the view are not copied or modified,
+    each sample is scaled (if needed) as it is copied into a minibatch.  Any class without samples in the view is removed from the view,
+    a model is only trained for the classes with samples.
+
+    @param trainingData: a reference to a view of the training data
+    @return returns true if the Softmax model was trained, false otherwise
+    */
+    virtual bool train_(ClassificationDataView &trainingData);
+
+    /**
+    This trains the Softmax model from a classification dataset that is stored on disk. All the class models are updated with the same
+    mini-batches, so each epoch only needs one pass over the file. Mini-batches do not span chunks, so the effective batch size is limited to the chunk size.
+
+    @param trainingData: a reference to the chunked classification dataset
+    @return returns true if the Softmax model was trained, false otherwise
+    */
+    virtual bool train_(ChunkedDataset &trainingData);
     
     /**
     This predicts the class of the inputVector.
@@ -145,7 +164,7 @@ class GRT_API Softmax : public Classifier
     using MLBase::load;
     
 protected:
-    bool trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,ClassificationData &data);
+    bool trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,const ClassificationDataView &data);
     bool loadLegacyModelFromFile( std::fstream &file );
     
     UINT batchSize;
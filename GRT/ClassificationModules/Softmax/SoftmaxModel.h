@@ -68,6 +68,14 @@ public:
         }
         return 1.0 / (1.0+exp(-sum));
     }
+
+    Float compute(const Float *x) const{
+        Float sum = w0;
+        for(UINT i=0; i<N; i++){
+            sum += x[i]*w[i];
+        }
+        return 1.0 / (1.0+exp(-sum));
+    }
     
     UINT classLabel;
     UINT N; //The number of dimensions
@@ -564,6 +564,7 @@ ClusterTreeNode* ClusterTree::buildTree(const MatrixFloat &trainingData,ClusterT
 bool ClusterTree::computeBestSplit( const MatrixFloat &trainingData, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError ){
     
     switch( trainingMode ){
+        case Tree::BEST_HISTOGRAM_SPLIT: //The cluster tree does not support histogram splits, so use the iterative search
         case Tree::BEST_ITERATIVE_SPILT:
             return computeBestSplitBestIterativeSplit( trainingData, features, featureIndex, threshold, minError );
             break;
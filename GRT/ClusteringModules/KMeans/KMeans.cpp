@@ -172,10 +172,9 @@ bool KMeans::train_(MatrixFloat &data){
 	count.resize(numClusters);
 
 	//Randomly pick k data points as the starting clusters
-	Random random;
 	Vector< UINT > randIndexs(numTrainingSamples);
 	for(UINT i=0; i<numTrainingSamples; i++) randIndexs[i] = i;
-    std::random_shuffle(randIndexs.begin(), randIndexs.end());
+    random.shuffle( randIndexs );
 
     //Copy the clusters
 	for(UINT k=0; k<numClusters; k++){
@@ -246,6 +245,143 @@ bool KMeans::predict_(VectorFloat &inputVector){
     return true;
 }
 
+bool KMeans::train_(ChunkedDataset &trainingData){
+
+    trained = false;
+
+    if( numClusters == 0 ){
+        errorLog << "train_(ChunkedDataset &trainingData) - Failed to train model. NumClusters is zero!" << std::endl;
+        return false;
+    }
+
+    if( trainingData.getNumSamples() < numClusters || trainingData.getNumDimensions() == 0 ){
+        errorLog << "train_(ChunkedDataset &trainingData) - There are not enough samples to train the model, or the number of dimensions is zero!" << std::endl;
+        return false;
+    }
+
+    numTrainingSamples = trainingData.getNumSamples();
+    numInputDimensions = trainingData.getNumDimensions();
+    ranges = trainingData.getInputRanges();
+    if( ranges.getSize() != numInputDimensions ){
+        errorLog << "train_(ChunkedDataset &trainingData) - Failed to compute the ranges of the training data!" << std::endl;
+        return false;
+    }
+
+    clusters.resize(numClusters,numInputDimensions);
+    count.resize(numClusters);
+    assign.clear();
+    const Vector< MinMax > emptyRanges;
+
+    //Use the first samples of the epoch as the starting clusters
+    UINT numInitialized = 0;
+    if( !trainingData.startEpoch() ) return false;
+    while( numInitialized < numClusters && trainingData.nextChunk() ){
+        if( useScaling ) trainingData.scaleChunk( ranges, emptyRanges, 0, 1 );
+        const MatrixFloat &X = trainingData.getInputs();
+        for(UINT i=0; i<X.getNumRows() && numInitialized < numClusters; i++){
+            std::copy( X[i], X[i]+numInputDimensions, clusters[ numInitialized++ ] );
+        }
+    }
+    if( numInitialized < numClusters ){
+        errorLog << "train_(ChunkedDataset &trainingData) - Failed to read the initial clusters!" << std::endl;
+        return false;
+    }
+
+    Timer timer;
+    UINT currentIter = 0;
+    UINT numChanged = 0;
+    bool keepTraining = true;
+    Float theta = 0;
+    Float lastTheta = 0;
+    Float delta = 0;
+    Float startTime = 0;
+    MatrixFloat sums(numClusters,numInputDimensions);
+    thetaTracker.clear();
+    finalTheta = 0;
+    numTrainingIterationsToConverge = 0;
+    converged = false;
+
+    //Run the training loop
+    timer.start();
+    while( keepTraining ){
+        startTime = timer.getMilliSeconds();
+
+        //Assign each sample to the closest cluster and accumulate the new means in one pass over the data
+        sums.setAllValues(0);
+        for(UINT k=0; k<numClusters; k++) count[k] = 0;
+        theta = 0;
+        if( !trainingData.startEpoch() ) return false;
+        while( trainingData.nextChunk() ){
+            if( useScaling ) trainingData.scaleChunk( ranges, emptyRanges, 0, 1 );
+            const MatrixFloat &X = trainingData.getInputs();
+            const UINT numRows = X.getNumRows();
+            for(UINT m=0; m<numRows; m++){
+                const Float *x = X[m];
+                UINT kmin = 0;
+                Float dmin = grt_numeric_limits< Float >::max();
+                for(UINT k=0; k<numClusters; k++){
+                    Float d = 0.0;
+                    for(UINT n=0; n<numInputDimensions; n++)
+                        d += grt_sqr( x[n]-clusters[k][n] );
+                    if( d <= dmin ){ dmin = d; kmin = k; }
+                }
+                count[kmin]++;
+                for(UINT n=0; n<numInputDimensions; n++) sums[kmin][n] += x[n];
+                theta += grt_sqrt( dmin );
+            }
+        }
+
+        //Move each cluster to the mean of its samples, counting the clusters that moved
+        numChanged = 0;
+        for(UINT k=0; k<numClusters; k++){
+            if( count[k] == 0 ) continue;
+            const Float countNorm = 1.0 / count[k];
+            for(UINT n=0; n<numInputDimensions; n++){
+                const Float value = sums[k][n] * countNorm;
+                if( value != clusters[k][n] ){
+                    clusters[k][n] = value;
+                    numChanged++;
+                }
+            }
+        }
+
+        //Update the iteration counter
+        currentIter++;
+
+        //Theta is the mean distance to the assigned cluster for this pass
+        if( computeTheta ){
+            theta /= numTrainingSamples;
+            delta = lastTheta - theta;
+            lastTheta = theta;
+        }else theta = delta = 0;
+
+        //Check convergance
+        if( numChanged == 0 && currentIter > minNumEpochs ){ converged = true; keepTraining = false; }
+        if( currentIter >= maxNumEpochs ){ keepTraining = false; }
+        if( fabs( delta ) < minChange && computeTheta && currentIter > minNumEpochs ){ converged = true; keepTraining = false; }
+        if( computeTheta )  thetaTracker.push_back( theta );
+
+        trainingLog << "Epoch: " << currentIter << "/" << maxNumEpochs;
+        trainingLog << " Epoch time: " << (timer.getMilliSeconds()-startTime)/1000.0 << " seconds";
+        trainingLog << " Theta: " << theta << " Delta: " << delta << std::endl;
+    }
+    trainingLog << "Model Trained at epoch: " << currentIter << " with a theta value of: " << theta << std::endl;
+
+    finalTheta = theta;
+    numTrainingIterationsToConverge = currentIter;
+    trained = true;
+
+    //Setup the cluster labels
+    clusterLabels.resize(numClusters);
+    for(UINT i=0; i<numClusters; i++){
+        clusterLabels[i] = i+1;
+    }
+    clusterLikelihoods.resize(numClusters,0);
+    clusterDistances.resize(numClusters,0);
+
+    return true;
+}
+
 bool KMeans::trainModel(MatrixFloat &data){
     
     if( numClusters == 0 ){
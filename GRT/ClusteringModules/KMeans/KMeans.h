@@ -122,6 +122,17 @@ public:
      @return returns true if the model was successfully trained, false otherwise
      */
      virtual bool train_(UnlabelledData &trainingData);
+
+    /**
+     This trains the KMeans model from a dataset that is stored on disk, the class labels or targets in the dataset are ignored.
+     Each epoch is one streaming pass of Lloyd's algorithm: every sample is assigned to the closest cluster and the new clusters are the mean of
+     the samples assigned to them. The samples are not kept in memory, so training stops when the clusters no longer move (rather than when no
+     sample changes cluster). The initial clusters are the first samples of the first chunk, which are random samples if the dataset is shuffled.
+
+     @param trainingData: a reference to the chunked dataset that will be used to train the ML model
+     @return returns true if the model was successfully trained, false otherwise
+     */
+    virtual bool train_(ChunkedDataset &trainingData);
     
     /**
      This is the main prediction interface for all reference VectorFloat data. It overrides the predict_ function in the ML base class.
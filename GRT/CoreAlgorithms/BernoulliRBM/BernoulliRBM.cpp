@@ -115,41 +115,9 @@ bool BernoulliRBM::train_(MatrixFloat &data){
     trainingLog << "NumInputDimensions: " << numInputDimensions << std::endl;
     trainingLog << "NumOutputDimensions: " << numOutputDimensions << std::endl;
     
-    if( randomizeWeightsForTraining ){
-        
-        //Init the weights matrix
-        weightsMatrix.resize(numHiddenUnits, numVisibleUnits);
-        
-        Float a = 1.0 / numVisibleUnits;
-        for(UINT i=0; i<numHiddenUnits; i++) {
-            for(UINT j=0; j<numVisibleUnits; j++) {
-                weightsMatrix[i][j] = rand.getRandomNumberUniform(-a, a);
-            }
-        }
-        
-        //Init the bias units
-        visibleLayerBias.resize( numVisibleUnits );
-        hiddenLayerBias.resize( numHiddenUnits );
-        std::fill(visibleLayerBias.begin(),visibleLayerBias.end(),0);
-        std::fill(hiddenLayerBias.begin(),hiddenLayerBias.end(),0);
-        
-    }else{
-        if( weightsMatrix.getNumRows() != numHiddenUnits ){
-            errorLog << "train_(MatrixFloat &data) - Weights matrix row size does not match the number of hidden units!" << std::endl;
-            return false;
-        }
-        if( weightsMatrix.getNumCols() != numVisibleUnits ){
-            errorLog << "train_(MatrixFloat &data) - Weights matrix row size does not match the number of visible units!" << std::endl;
-            return false;
-        }
-        if( visibleLayerBias.size() != numVisibleUnits ){
-            errorLog << "train_(MatrixFloat &data) - Visible layer bias size does not match the number of visible units!" << std::endl;
-            return false;
-        }
-        if( hiddenLayerBias.size() != numHiddenUnits ){
-            errorLog << "train_(MatrixFloat &data) - Hidden layer bias size does not match the number of hidden units!" << std::endl;
-            return false;
-        }
+    if( !initTrainingWeights() ){
+        errorLog << "train_(MatrixFloat &data) - Failed to init the weights!" << std::endl;
+        return false;
     }
     
     //Flag the model has been trained encase the user wants to save the model during a training iteration using an observer
@@ -188,36 +156,16 @@ bool BernoulliRBM::train_(MatrixFloat &data){
     }
     
     Timer timer;
-    UINT i,j,n,epoch,noChangeCounter = 0;
+    UINT i,j,epoch,noChangeCounter = 0;
     Float startTime = 0;
     Float alpha = learningRate;
     Float error = 0;
-    Float err = 0;
     Float delta = 0;
     Float lastError = 0;
     Vector< UINT > indexList(numTrainingSamples);
     TrainingResult trainingResult;
-    MatrixFloat wT( numVisibleUnits, numHiddenUnits );       //Stores a transposed copy of the weights vector
-    MatrixFloat vW( numHiddenUnits, numVisibleUnits );       //Stores the weight velocity updates
-    MatrixFloat tmpW( numHiddenUnits, numVisibleUnits );     //Stores the weight values that will be used to update the main weights matrix at each batch update
-    MatrixFloat v1( batchSize, numVisibleUnits );            //Stores the real batch data during a batch update
-    MatrixFloat v2( batchSize, numVisibleUnits );            //Stores the sampled batch data during a batch update
-    MatrixFloat h1( batchSize, numHiddenUnits );             //Stores the hidden states given v1 and the current weightsMatrix
-    MatrixFloat h2( batchSize, numHiddenUnits );             //Stores the sampled hidden states given v2 and the current weightsMatrix
-    MatrixFloat c1( numHiddenUnits, numVisibleUnits );       //Stores h1' * v1
-    MatrixFloat c2( numHiddenUnits, numVisibleUnits );       //Stores h2' * v2
-    MatrixFloat vDiff( batchSize, numVisibleUnits );         //Stores the difference between v1-v2
-    MatrixFloat hDiff( batchSize, numVisibleUnits );         //Stores the difference between h1-h2
-    MatrixFloat cDiff( numHiddenUnits, numVisibleUnits );    //Stores the difference between c1-c2
-    VectorFloat vDiffSum( numVisibleUnits );                 //Stores the column sum of vDiff
-    VectorFloat hDiffSum( numHiddenUnits );                  //Stores the column sum of hDiff
-    VectorFloat visibleLayerBiasVelocity( numVisibleUnits ); //Stores the velocity update of the visibleLayerBias
-    VectorFloat hiddenLayerBiasVelocity( numHiddenUnits );   //Stores the velocity update of the hiddenLayerBias
-    
-    //Set all the velocity weights to zero
-    vW.setAllValues( 0 );
-    std::fill(visibleLayerBiasVelocity.begin(),visibleLayerBiasVelocity.end(),0);
-    std::fill(hiddenLayerBiasVelocity.begin(),hiddenLayerBiasVelocity.end(),0);
+    TrainingBuffers buffers;
+    initTrainingBuffers( buffers );
     
     //Randomize the order that the training samples will be used in
     for(UINT i=0; i<numTrainingSamples; i++) indexList[i] = i;
@@ -237,25 +185,10 @@ bool BernoulliRBM::train_(MatrixFloat &data){
         //Run each of the batch updates
         for(UINT k=0; k<numBatches; k+=batchStepSize){
             
-            //Resize the data matrices, the matrices will only be resized if the rows cols are different
-            v1.resize( batchIndexs[k].batchSize, numVisibleUnits );
-            h1.resize( batchIndexs[k].batchSize, numHiddenUnits );
-            v2.resize( batchIndexs[k].batchSize, numVisibleUnits );
-            h2.resize( batchIndexs[k].batchSize, numHiddenUnits );
-            
-            //Setup the data pointers, using data pointers saves a few ms on large matrix updates
-            Float **w_p = weightsMatrix.getDataPointer();
-            Float **wT_p = wT.getDataPointer();
-            Float **vW_p = vW.getDataPointer();
+            //Get the batch data, the batch matrix will only be resized if the number of rows is different
+            buffers.v1.resize( batchIndexs[k].batchSize, numVisibleUnits );
             Float **data_p = data.getDataPointer();
-            Float **v1_p = v1.getDataPointer();
-            Float **v2_p = v2.getDataPointer();
-            Float **h1_p = h1.getDataPointer();
-            Float **h2_p = h2.getDataPointer();
-            Float *vlb_p = &visibleLayerBias[0];
-            Float *hlb_p = &hiddenLayerBias[0];
-            
-            //Get the batch data
+            Float **v1_p = buffers.v1.getDataPointer();
             UINT index = 0;
             for(i=batchIndexs[k].startIndex; i<batchIndexs[k].endIndex; i++){
                 for(j=0; j<numVisibleUnits; j++){
@@ -264,95 +197,106 @@ bool BernoulliRBM::train_(MatrixFloat &data){
                 index++;
             }
             
-            //Copy a transposed version of the weights matrix, this is used to compute h1 and h2
-            for(i=0; i<numHiddenUnits; i++)
-            for(j=0; j<numVisibleUnits; j++)
-            wT_p[j][i] = w_p[i][j];
-            
-            //Compute h1
-            h1.multiple(v1, wT);
-            for(n=0; n<batchIndexs[k].batchSize; n++){
-                for(i=0; i<numHiddenUnits; i++){
-                    h1_p[n][i] = sigmoidRandom( h1_p[n][i] + hlb_p[i] );
-                }
-            }
-            
-            //Compute v2
-            v2.multiple(h1, weightsMatrix);
-            for(n=0; n<batchIndexs[k].batchSize; n++){
-                for(i=0; i<numVisibleUnits; i++){
-                    v2_p[n][i] = sigmoidRandom( v2_p[n][i] + vlb_p[i] );
-                }
-            }
-            
-            //Compute h2
-            h2.multiple(v2,wT);
-            for(n=0; n<batchIndexs[k].batchSize; n++){
-                for(i=0; i<numHiddenUnits; i++){
-                    h2_p[n][i] = grt_sigmoid( h2_p[n][i] + hlb_p[i] );
-                }
-            }
-            
-            //Compute c1, c2 and the difference between v1-v2
-            c1.multiple(h1,v1,true);
-            c2.multiple(h2,v2,true);
-            vDiff.subtract(v1, v2);
-            
-            //Compute the sum of vdiff
-            for(j=0; j<numVisibleUnits; j++){
-                vDiffSum[j] = 0;
-                for(i=0; i<batchIndexs[k].batchSize; i++){
-                    vDiffSum[j] += vDiff[i][j];
-                }
-            }
-            
-            //Compute the difference between h1 and h2
-            hDiff.subtract(h1, h2);
-            for(j=0; j<numHiddenUnits; j++){
-                hDiffSum[j] = 0;
-                for(i=0; i<batchIndexs[k].batchSize; i++){
-                    hDiffSum[j] += hDiff[i][j];
-                }
-            }
-            
-            //Compute the difference between c1 and c2
-            cDiff.subtract(c1,c2);
-            
-            //Update the weight velocities
-            for(i=0; i<numHiddenUnits; i++){
-                for(j=0; j<numVisibleUnits; j++){
-                    vW_p[i][j] = ((momentum * vW_p[i][j]) + (alpha * cDiff[i][j])) / batchIndexs[k].batchSize;
-                }
-            }
-            for(i=0; i<numVisibleUnits; i++){
-                visibleLayerBiasVelocity[i] = ((momentum * visibleLayerBiasVelocity[i]) + (alpha * vDiffSum[i])) / batchIndexs[k].batchSize;
-            }
-            for(i=0; i<numHiddenUnits; i++){
-                hiddenLayerBiasVelocity[i] = ((momentum * hiddenLayerBiasVelocity[i]) + (alpha * hDiffSum[i])) / batchIndexs[k].batchSize;
-            }
-            
-            //Update the weights
-            weightsMatrix.add( vW );
-            
-            //Update the bias for the visible layer
-            for(i=0; i<numVisibleUnits; i++){
-                visibleLayerBias[i] += visibleLayerBiasVelocity[i];
+            error += updateBatch( buffers, alpha );
+        }
+        error /= numBatches;
+        delta = lastError - error;
+        lastError = error;
+        
+        trainingLog << "Epoch: " << epoch+1 << "/" << maxNumEpochs;
+        trainingLog << " Epoch time: " << (timer.getMilliSeconds()-startTime)/1000.0 << " seconds";
+        trainingLog << " Learning rate: " << alpha;
+        trainingLog << " Momentum: " << momentum;
+        trainingLog << " Average reconstruction error: " << error;
+        trainingLog << " Delta: " << delta << std::endl;
+        
+        //Update the learning rate
+        alpha *= learningRateUpdate;
+        
+        trainingResult.setClassificationResult(epoch, error, this);
+        trainingResults.push_back(trainingResult);
+        trainingResultsObserverManager.notifyObservers( trainingResult );
+        
+        //Check for convergance
+        if( fabs(delta) < minChange ){
+            if( ++noChangeCounter >= minNumEpochs ){
+                trainingLog << "Stopping training. MinChange limit reached!" << std::endl;
+                break;
             }
+        }else noChangeCounter = 0;
+        
+    }
+    trainingLog << "Training complete after " << epoch << " epochs. Total training time: " << timer.getMilliSeconds()/1000.0 << " seconds" << std::endl;
+    
+    trained = true;
+    
+    return true;
+}
+
+bool BernoulliRBM::train_(ChunkedDataset &trainingData){
+    
+    const UINT numTrainingSamples = trainingData.getNumSamples();
+    numInputDimensions = trainingData.getNumDimensions();
+    numOutputDimensions = numHiddenUnits;
+    numVisibleUnits = numInputDimensions;
+    
+    if( numTrainingSamples == 0 ){
+        errorLog << "train_(ChunkedDataset &trainingData) - Training data has zero samples!" << std::endl;
+        return false;
+    }
+    
+    //The data is scaled one chunk at a time as it is used, so only the ranges are needed here
+    ranges = trainingData.getInputRanges();
+    if( ranges.getSize() != numInputDimensions ){
+        errorLog << "train_(ChunkedDataset &trainingData) - Failed to compute the ranges of the training data!" << std::endl;
+        return false;
+    }
+    
+    if( !initTrainingWeights() ){
+        errorLog << "train_(ChunkedDataset &trainingData) - Failed to init the weights!" << std::endl;
+        return false;
+    }
+    
+    //Flag the model has been trained encase the user wants to save the model during a training iteration using an observer
+    trained = true;
+    
+    Timer timer;
+    UINT epoch,noChangeCounter = 0;
+    UINT numBatches = 0;
+    Float startTime = 0;
+    Float alpha = learningRate;
+    Float error = 0;
+    Float delta = 0;
+    Float lastError = 0;
+    TrainingResult trainingResult;
+    TrainingBuffers buffers;
+    initTrainingBuffers( buffers );
+    const Vector< MinMax > emptyRanges;
+    
+    //Start the main training loop, the chunked dataset shuffles the chunks (and the samples in each chunk) for each epoch
+    timer.start();
+    for(epoch=0; epoch<maxNumEpochs; epoch++) {
+        startTime = timer.getMilliSeconds();
+        error = 0;
+        numBatches = 0;
+        
+        if( !trainingData.startEpoch() ) return false;
+        while( trainingData.nextChunk() ){
             
-            //Update the bias for the visible layer
-            for(i=0; i<numHiddenUnits; i++){
-                hiddenLayerBias[i] += hiddenLayerBiasVelocity[i];
-            }
+            if( useScaling ) trainingData.scaleChunk( ranges, emptyRanges, 0.0, 1.0 );
             
-            //Compute the reconstruction error
-            err = 0;
-            for(i=0; i<batchIndexs[k].batchSize; i++){
-                for(j=0; j<numVisibleUnits; j++){
-                    err += SQR( v1[i][j] - v2[i][j] );
+            //Run each of the batch updates in this chunk, batches do not span chunks
+            const MatrixFloat &X = trainingData.getInputs();
+            const UINT numRows = X.getNumRows();
+            for(UINT batchStart=0; batchStart<numRows; batchStart += batchSize*batchStepSize){
+                const UINT numSamplesInBatch = std::min( batchSize, numRows-batchStart );
+                buffers.v1.resize( numSamplesInBatch, numVisibleUnits );
+                for(UINT n=0; n<numSamplesInBatch; n++){
+                    std::copy( X[batchStart+n], X[batchStart+n]+numVisibleUnits, buffers.v1[n] );
                 }
+                error += updateBatch( buffers, alpha );
+                numBatches++;
             }
-            
-            error += err / batchIndexs[k].batchSize;
         }
         error /= numBatches;
         delta = lastError - error;
@@ -388,6 +332,198 @@ bool BernoulliRBM::train_(MatrixFloat &data){
     return true;
 }
 
+bool BernoulliRBM::initTrainingWeights(){
+    
+    if( randomizeWeightsForTraining ){
+        
+        //Init the weights matrix
+        weightsMatrix.resize(numHiddenUnits, numVisibleUnits);
+        
+        Float a = 1.0 / numVisibleUnits;
+        for(UINT i=0; i<numHiddenUnits; i++) {
+            for(UINT j=0; j<numVisibleUnits; j++) {
+                weightsMatrix[i][j] = rand.getRandomNumberUniform(-a, a);
+            }
+        }
+        
+        //Init the bias units
+        visibleLayerBias.resize( numVisibleUnits );
+        hiddenLayerBias.resize( numHiddenUnits );
+        std::fill(visibleLayerBias.begin(),visibleLayerBias.end(),0);
+        std::fill(hiddenLayerBias.begin(),hiddenLayerBias.end(),0);
+        
+    }else{
+        if( weightsMatrix.getNumRows() != numHiddenUnits ){
+            errorLog << "initTrainingWeights() - Weights matrix row size does not match the number of hidden units!" << std::endl;
+            return false;
+        }
+        if( weightsMatrix.getNumCols() != numVisibleUnits ){
+            errorLog << "initTrainingWeights() - Weights matrix row size does not match the number of visible units!" << std::endl;
+            return false;
+        }
+        if( visibleLayerBias.size() != numVisibleUnits ){
+            errorLog << "initTrainingWeights() - Visible layer bias size does not match the number of visible units!" << std::endl;
+            return false;
+        }
+        if( hiddenLayerBias.size() != numHiddenUnits ){
+            errorLog << "initTrainingWeights() - Hidden layer bias size does not match the number of hidden units!" << std::endl;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+void BernoulliRBM::initTrainingBuffers( TrainingBuffers &buffers ){
+    buffers.wT.resize( numVisibleUnits, numHiddenUnits );
+    buffers.vW.resize( numHiddenUnits, numVisibleUnits );
+    buffers.v1.resize( batchSize, numVisibleUnits );
+    buffers.v2.resize( batchSize, numVisibleUnits );
+    buffers.h1.resize( batchSize, numHiddenUnits );
+    buffers.h2.resize( batchSize, numHiddenUnits );
+    buffers.c1.resize( numHiddenUnits, numVisibleUnits );
+    buffers.c2.resize( numHiddenUnits, numVisibleUnits );
+    buffers.vDiff.resize( batchSize, numVisibleUnits );
+    buffers.hDiff.resize( batchSize, numVisibleUnits );
+    buffers.cDiff.resize( numHiddenUnits, numVisibleUnits );
+    buffers.vDiffSum.resize( numVisibleUnits );
+    buffers.hDiffSum.resize( numHiddenUnits );
+    buffers.visibleLayerBiasVelocity.resize( numVisibleUnits );
+    buffers.hiddenLayerBiasVelocity.resize( numHiddenUnits );
+    
+    //Set all the velocity weights to zero
+    buffers.vW.setAllValues( 0 );
+    std::fill(buffers.visibleLayerBiasVelocity.begin(),buffers.visibleLayerBiasVelocity.end(),0);
+    std::fill(buffers.hiddenLayerBiasVelocity.begin(),buffers.hiddenLayerBiasVelocity.end(),0);
+}
+
+Float BernoulliRBM::updateBatch( TrainingBuffers &buffers, const Float alpha ){
+    
+    UINT i,j,n;
+    Float err = 0;
+    const UINT numSamplesInBatch = buffers.v1.getNumRows();
+    MatrixFloat &wT = buffers.wT;
+    MatrixFloat &vW = buffers.vW;
+    MatrixFloat &v1 = buffers.v1;
+    MatrixFloat &v2 = buffers.v2;
+    MatrixFloat &h1 = buffers.h1;
+    MatrixFloat &h2 = buffers.h2;
+    MatrixFloat &c1 = buffers.c1;
+    MatrixFloat &c2 = buffers.c2;
+    MatrixFloat &vDiff = buffers.vDiff;
+    MatrixFloat &hDiff = buffers.hDiff;
+    MatrixFloat &cDiff = buffers.cDiff;
+    VectorFloat &vDiffSum = buffers.vDiffSum;
+    VectorFloat &hDiffSum = buffers.hDiffSum;
+    VectorFloat &visibleLayerBiasVelocity = buffers.visibleLayerBiasVelocity;
+    VectorFloat &hiddenLayerBiasVelocity = buffers.hiddenLayerBiasVelocity;
+    
+    //Resize the data matrices, the matrices will only be resized if the rows cols are different
+    h1.resize( numSamplesInBatch, numHiddenUnits );
+    v2.resize( numSamplesInBatch, numVisibleUnits );
+    h2.resize( numSamplesInBatch, numHiddenUnits );
+    
+    //Setup the data pointers, using data pointers saves a few ms on large matrix updates
+    Float **w_p = weightsMatrix.getDataPointer();
+    Float **wT_p = wT.getDataPointer();
+    Float **vW_p = vW.getDataPointer();
+    Float **v2_p = v2.getDataPointer();
+    Float **h1_p = h1.getDataPointer();
+    Float **h2_p = h2.getDataPointer();
+    Float *vlb_p = &visibleLayerBias[0];
+    Float *hlb_p = &hiddenLayerBias[0];
+    
+    //Copy a transposed version of the weights matrix, this is used to compute h1 and h2
+    for(i=0; i<numHiddenUnits; i++)
+    for(j=0; j<numVisibleUnits; j++)
+    wT_p[j][i] = w_p[i][j];
+    
+    //Compute h1
+    h1.multiple(v1, wT);
+    for(n=0; n<numSamplesInBatch; n++){
+        for(i=0; i<numHiddenUnits; i++){
+            h1_p[n][i] = sigmoidRandom( h1_p[n][i] + hlb_p[i] );
+        }
+    }
+    
+    //Compute v2
+    v2.multiple(h1, weightsMatrix);
+    for(n=0; n<numSamplesInBatch; n++){
+        for(i=0; i<numVisibleUnits; i++){
+            v2_p[n][i] = sigmoidRandom( v2_p[n][i] + vlb_p[i] );
+        }
+    }
+    
+    //Compute h2
+    h2.multiple(v2,wT);
+    for(n=0; n<numSamplesInBatch; n++){
+        for(i=0; i<numHiddenUnits; i++){
+            h2_p[n][i] = grt_sigmoid( h2_p[n][i] + hlb_p[i] );
+        }
+    }
+    
+    //Compute c1, c2 and the difference between v1-v2
+    c1.multiple(h1,v1,true);
+    c2.multiple(h2,v2,true);
+    vDiff.subtract(v1, v2);
+    
+    //Compute the sum of vdiff
+    for(j=0; j<numVisibleUnits; j++){
+        vDiffSum[j] = 0;
+        for(i=0; i<numSamplesInBatch; i++){
+            vDiffSum[j] += vDiff[i][j];
+        }
+    }
+    
+    //Compute the difference between h1 and h2
+    hDiff.subtract(h1, h2);
+    for(j=0; j<numHiddenUnits; j++){
+        hDiffSum[j] = 0;
+        for(i=0; i<numSamplesInBatch; i++){
+            hDiffSum[j] += hDiff[i][j];
+        }
+    }
+    
+    //Compute the difference between c1 and c2
+    cDiff.subtract(c1,c2);
+    
+    //Update the weight velocities
+    for(i=0; i<numHiddenUnits; i++){
+        for(j=0; j<numVisibleUnits; j++){
+            vW_p[i][j] = ((momentum * vW_p[i][j]) + (alpha * cDiff[i][j])) / numSamplesInBatch;
+        }
+    }
+    for(i=0; i<numVisibleUnits; i++){
+        visibleLayerBiasVelocity[i] = ((momentum * visibleLayerBiasVelocity[i]) + (alpha * vDiffSum[i])) / numSamplesInBatch;
+    }
+    for(i=0; i<numHiddenUnits; i++){
+        hiddenLayerBiasVelocity[i] = ((momentum * hiddenLayerBiasVelocity[i]) + (alpha * hDiffSum[i])) / numSamplesInBatch;
+    }
+    
+    //Update the weights
+    weightsMatrix.add( vW );
+    
+    //Update the bias for the visible layer
+    for(i=0; i<numVisibleUnits; i++){
+        visibleLayerBias[i] += visibleLayerBiasVelocity[i];
+    }
+    
+    //Update the bias for the visible layer
+    for(i=0; i<numHiddenUnits; i++){
+        hiddenLayerBias[i] += hiddenLayerBiasVelocity[i];
+    }
+    
+    //Compute the reconstruction error
+    err = 0;
+    for(i=0; i<numSamplesInBatch; i++){
+        for(j=0; j<numVisibleUnits; j++){
+            err += SQR( v1[i][j] - v2[i][j] );
+        }
+    }
+    
+    return err / numSamplesInBatch;
+}
+
 bool BernoulliRBM::reset(){
     
     //Reset the base class
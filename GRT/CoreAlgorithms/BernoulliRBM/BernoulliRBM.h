@@ -87,6 +87,15 @@ class GRT_API BernoulliRBM : public MLBase{
     */
     virtual bool train_(MatrixFloat &data);
     
+    /**
+    This trains the RBM from a dataset that is stored on disk, the class labels or targets in the dataset are ignored.
+    The mini-batches are taken from each chunk in turn (batches do not span chunks) and the data is scaled one chunk at a time if scaling is enabled.
+    
+    @param trainingData: a reference to the chunked dataset that will be used to train the RBM model
+    @return returns true if the model was successfully trained, false otherwise
+    */
+    virtual bool train_(ChunkedDataset &trainingData);
+    
     /**
     This function will reset the model (i.e. set all values back to default settings). If you want to completely clear the model
     (i.e. clear any learned weights or values) then you should use the clear function.
@@ -144,7 +153,35 @@ class GRT_API BernoulliRBM : public MLBase{
     using MLBase::predict_; ///<Tell the compiler we are using the base class predict method to stop hidden virtual function warnings
     
 protected:
+    //Stores the batch data, the weight velocities and the temporary matrices used by each batch update
+    struct TrainingBuffers{
+        MatrixFloat wT;                         //Stores a transposed copy of the weights vector
+        MatrixFloat vW;                         //Stores the weight velocity updates
+        MatrixFloat v1;                         //Stores the real batch data during a batch update
+        MatrixFloat v2;                         //Stores the sampled batch data during a batch update
+        MatrixFloat h1;                         //Stores the hidden states given v1 and the current weightsMatrix
+        MatrixFloat h2;                         //Stores the sampled hidden states given v2 and the current weightsMatrix
+        MatrixFloat c1;                         //Stores h1' * v1
+        MatrixFloat c2;                         //Stores h2' * v2
+        MatrixFloat vDiff;                      //Stores the difference between v1-v2
+        MatrixFloat hDiff;                      //Stores the difference between h1-h2
+        MatrixFloat cDiff;                      //Stores the difference between c1-c2
+        VectorFloat vDiffSum;                   //Stores the column sum of vDiff
+        VectorFloat hDiffSum;                   //Stores the column sum of hDiff
+        VectorFloat visibleLayerBiasVelocity;   //Stores the velocity update of the visibleLayerBias
+        VectorFloat hiddenLayerBiasVelocity;    //Stores the velocity update of the hiddenLayerBias
+    };
+    
     bool loadLegacyModelFromFile( std::fstream &file );
+    bool initTrainingWeights();
+    void initTrainingBuffers( TrainingBuffers &buffers );
+    
+    /**
+    Runs one contrastive divergence update using the batch stored in buffers.v1.
+    
+    @return returns the average reconstruction error of the batch
+    */
+    Float updateBatch( TrainingBuffers &buffers, const Float alpha );
     
     inline Float sigmoidRandom(const Float &x){
         return (1.0 / (1.0 + exp(-x)) > rand.getRandomNumberUniform(0.0,1.0)) ? 1.0 : 0.0;
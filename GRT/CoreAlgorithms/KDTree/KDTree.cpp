@@ -0,0 +1,185 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "KDTree.h"
+
+GRT_BEGIN_NAMESPACE
+
+KDTree::KDTree(){
+    numPoints = 0;
+    numDimensions = 0;
+    distanceMethod = EUCLIDEAN_DISTANCE;
+    maxLeafSize = 16;
+}
+
+KDTree::~KDTree(){
+}
+
+bool KDTree::build( const MatrixFloat &data, const UINT distanceMethod, const UINT maxLeafSize ){
+
+    clear();
+
+    const UINT M = data.getNumRows();
+    const UINT N = data.getNumCols();
+    if( M == 0 || N == 0 ) return false;
+    if( distanceMethod != EUCLIDEAN_DISTANCE && distanceMethod != MANHATTAN_DISTANCE ) return false;
+    if( maxLeafSize == 0 ) return false;
+
+    this->numDimensions = N;
+    this->distanceMethod = distanceMethod;
+    this->maxLeafSize = maxLeafSize;
+
+    //Build the tree by partitioning the point order in place, the order then lists the points leaf by leaf
+    Vector< UINT > order( M );
+    for(UINT i=0; i<M; i++) order[i] = i;
+    allocateNodes( 1 );
+    buildNode( 0, data, order, 0, M );
+
+    //Copy the points into the tree in leaf order
+    points.resize( M*N );
+    pointIndexs = order;
+    for(UINT i=0; i<M; i++){
+        const Float *row = data[ order[i] ];
+        std::copy( row, row+N, &points[i*N] );
+    }
+    numPoints = M;
+
+    return true;
+}
+
+bool KDTree::clear(){
+    numPoints = 0;
+    numDimensions = 0;
+    points.clear();
+    pointIndexs.clear();
+    nodeStarts.clear();
+    nodeEnds.clear();
+    leftChildren.clear();
+    splitDimensions.clear();
+    splitValues.clear();
+    return true;
+}
+
+bool KDTree::search( const Float *query, const UINT K, Vector< IndexedDouble > &neighbours ) const{
+
+    if( numPoints == 0 || K == 0 || K > numPoints ) return false;
+
+    neighbours.clear();
+    neighbours.reserve( K+1 );
+
+    //The offsets hold the distance from the query to the cell of the current node in each dimension
+    Vector< Float > offsets( numDimensions, 0 );
+    searchNode( 0, query, &offsets[0], K, neighbours );
+
+    return true;
+}
+
+void KDTree::buildNode( const UINT node, const MatrixFloat &data, Vector< UINT > &order, const UINT start, const UINT end ){
+
+    nodeStarts[ node ] = start;
+    nodeEnds[ node ] = end;
+    if( end-start <= maxLeafSize ) return;
+
+    //Find the dimension with the largest spread
+    UINT bestDimension = 0;
+    Float bestSpread = 0;
+    for(UINT j=0; j<numDimensions; j++){
+        Float minValue = data[ order[start] ][j];
+        Float maxValue = minValue;
+        for(UINT i=start+1; i<end; i++){
+            const Float value = data[ order[i] ][j];
+            if( value < minValue ) minValue = value;
+            else if( value > maxValue ) maxValue = value;
+        }
+        if( maxValue-minValue > bestSpread ){
+            bestSpread = maxValue-minValue;
+            bestDimension = j;
+        }
+    }
+
+    //If all the points are the same then they can not be split
+    if( bestSpread == 0 ) return;
+
+    //Split the points at the median, the points before the median are <= the split value and the points after it are >=
+    const UINT mid = start + (end-start)/2;
+    std::nth_element( order.begin()+start, order.begin()+mid, order.begin()+end, [&]( const UINT a, const UINT b ){
+        return data[a][bestDimension] < data[b][bestDimension];
+    } );
+
+    const UINT left = allocateNodes( 2 );
+    leftChildren[ node ] = left;
+    splitDimensions[ node ] = bestDimension;
+    splitValues[ node ] = data[ order[mid] ][ bestDimension ];
+
+    buildNode( left, data, order, start, mid );
+    buildNode( left+1, data, order, mid, end );
+}
+
+UINT KDTree::allocateNodes( const UINT numNodes ){
+    const UINT index = nodeStarts.getSize();
+    nodeStarts.resize( index+numNodes, 0 );
+    nodeEnds.resize( index+numNodes, 0 );
+    leftChildren.resize( index+numNodes, 0 );
+    splitDimensions.resize( index+numNodes, 0 );
+    splitValues.resize( index+numNodes, 0 );
+    return index;
+}
+
+void KDTree::searchNode( const UINT node, const Float *query, Float *offsets, const UINT K, Vector< IndexedDouble > &neighbours ) const{
+
+    const UINT left = leftChildren[ node ];
+
+    //Test each point in a leaf
+    if( left == 0 ){
+        for(UINT i=nodeStarts[node]; i<nodeEnds[node]; i++){
+            addNeighbour( pointIndexs[i], computeDistance( query, &points[i*numDimensions] ), K, neighbours );
+        }
+        return;
+    }
+
+    //Search the child on the same side of the split as the query first
+    const UINT dimension = splitDimensions[ node ];
+    const Float diff = query[ dimension ] - splitValues[ node ];
+    const UINT nearChild = diff <= 0 ? left : left+1;
+    const UINT farChild = diff <= 0 ? left+1 : left;
+
+    searchNode( nearChild, query, offsets, K, neighbours );
+
+    //Only search the far child if its cell could hold a point that ranks before the current K-th neighbour
+    const Float oldOffset = offsets[ dimension ];
+    offsets[ dimension ] = diff;
+    if( neighbours.getSize() < K || computeCellDistance( offsets ) <= neighbours[K-1].value ){
+        searchNode( farChild, query, offsets, K, neighbours );
+    }
+    offsets[ dimension ] = oldOffset;
+}
+
+void KDTree::addNeighbour( const UINT pointIndex, const Float distance, const UINT K, Vector< IndexedDouble > &neighbours ) const{
+
+    const IndexedDouble neighbour( pointIndex, distance );
+    if( neighbours.getSize() == K && !sortNeighboursByDistance( neighbour, neighbours[K-1] ) ) return;
+
+    //Keep the neighbours sorted, K is small so an insertion is cheaper than maintaining a heap
+    neighbours.insert( std::upper_bound( neighbours.begin(), neighbours.end(), neighbour, sortNeighboursByDistance ), neighbour );
+    if( neighbours.getSize() > K ) neighbours.pop_back();
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,169 @@
+/**
+@file
+@author  Nicholas Gillian <ngillian@media.mit.edu>
+@version 1.0
+
+@brief This class implements a KD-tree, a spatial index used to find the exact K nearest neighbours of a query point.
+*/
+
+/**
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GRT_KD_TREE_HEADER
+#define GRT_KD_TREE_HEADER
+
+#include "../../Util/GRTCommon.h"
+
+GRT_BEGIN_NAMESPACE
+
+/**
+ @brief This class builds a KD-tree from a set of points and runs exact K nearest neighbour queries against it.
+
+ Each node of the tree splits its points at the median of the dimension with the largest spread, until a node holds no more
+ than the maximum leaf size. The points are copied into the tree in leaf order, so the points of each leaf are stored next to
+ each other. A query visits the leaf that holds the query point first and then only visits the nodes whose cell could hold a
+ point closer than the current K-th neighbour, so the result is the same as testing every point.
+
+ The neighbours are ranked by their distance and then by the index of the point, so ties are always resolved the same way.
+ The KD-tree supports the Euclidean and Manhattan distances, the index is not saved and should be rebuilt from the points.
+*/
+class GRT_API KDTree{
+public:
+    enum DistanceMethods{EUCLIDEAN_DISTANCE=0,MANHATTAN_DISTANCE};
+
+    /**
+     Default Constructor.
+     */
+    KDTree();
+
+    /**
+     Default Destructor.
+     */
+    ~KDTree();
+
+    /**
+     Builds the KD-tree from the rows of the data matrix, any previous tree will be cleared.
+
+     @param data: the points to index, each row is a point
+     @param distanceMethod: the distance used to rank the neighbours, this should be one of the DistanceMethods
+     @param maxLeafSize: the maximum number of points stored in a leaf, must be greater than zero
+     @return returns true if the tree was built, false otherwise
+     */
+    bool build( const MatrixFloat &data, const UINT distanceMethod = EUCLIDEAN_DISTANCE, const UINT maxLeafSize = 16 );
+
+    /**
+     Clears the tree and the points it holds.
+
+     @return returns true if the tree was cleared, false otherwise
+     */
+    bool clear();
+
+    /**
+     Finds the K nearest neighbours of the query point.
+
+     @param query: a pointer to the getNumDimensions() values of the query point
+     @param K: the number of neighbours to find, this should not be greater than the number of points in the tree
+     @param neighbours: returns the neighbours sorted by distance, the index is the row of the point in the data the tree was built from and the value is its distance to the query
+     @return returns true if the search was run, false otherwise
+     */
+    bool search( const Float *query, const UINT K, Vector< IndexedDouble > &neighbours ) const;
+
+    /**
+     @return returns true if the tree has been built, false otherwise
+     */
+    bool getBuilt() const{ return numPoints > 0; }
+
+    /**
+     @return returns the number of points in the tree
+     */
+    UINT getNumPoints() const{ return numPoints; }
+
+    /**
+     @return returns the number of dimensions of each point in the tree
+     */
+    UINT getNumDimensions() const{ return numDimensions; }
+
+    /**
+     @return returns the distance method used to rank the neighbours
+     */
+    UINT getDistanceMethod() const{ return distanceMethod; }
+
+    /**
+     Ranks two neighbours by their distance and then by their index, this is the order returned by search.
+
+     @return returns true if a should be ranked before b
+     */
+    static bool sortNeighboursByDistance( const IndexedDouble &a, const IndexedDouble &b ){
+        if( a.value != b.value ) return a.value < b.value;
+        return a.index < b.index;
+    }
+
+protected:
+    void buildNode( const UINT node, const MatrixFloat &data, Vector< UINT > &order, const UINT start, const UINT end );
+    UINT allocateNodes( const UINT numNodes );
+    void searchNode( const UINT node, const Float *query, Float *offsets, const UINT K, Vector< IndexedDouble > &neighbours ) const;
+    void addNeighbour( const UINT pointIndex, const Float distance, const UINT K, Vector< IndexedDouble > &neighbours ) const;
+
+    Float computeDistance( const Float *a, const Float *b ) const{
+        Float dist = 0;
+        if( distanceMethod == EUCLIDEAN_DISTANCE ){
+            for(UINT j=0; j<numDimensions; j++){
+                dist += SQR( a[j] - b[j] );
+            }
+            return sqrt( dist );
+        }
+        for(UINT j=0; j<numDimensions; j++){
+            dist += fabs( a[j] - b[j] );
+        }
+        return dist;
+    }
+
+    //Computes the distance from the query to a cell, given the offset from the query to the cell in each dimension. This is summed
+    //in the same order as computeDistance, so the distance to a cell is never greater than the distance to a point inside it
+    Float computeCellDistance( const Float *offsets ) const{
+        Float dist = 0;
+        if( distanceMethod == EUCLIDEAN_DISTANCE ){
+            for(UINT j=0; j<numDimensions; j++){
+                dist += SQR( offsets[j] );
+            }
+            return sqrt( dist );
+        }
+        for(UINT j=0; j<numDimensions; j++){
+            dist += fabs( offsets[j] );
+        }
+        return dist;
+    }
+
+    UINT numPoints;                         ///< The number of points in the tree
+    UINT numDimensions;                     ///< The number of dimensions of each point
+    UINT distanceMethod;                    ///< The distance used to rank the neighbours
+    UINT maxLeafSize;                       ///< The maximum number of points stored in a leaf
+    Vector< Float > points;                 ///< The points, stored row by row in leaf order
+    Vector< UINT > pointIndexs;             ///< The row of each stored point in the data the tree was built from
+    Vector< UINT > nodeStarts;              ///< The first stored point of each node
+    Vector< UINT > nodeEnds;                ///< One past the last stored point of each node
+    Vector< UINT > leftChildren;            ///< The left child of each node, the right child is stored after it, zero for a leaf
+    Vector< UINT > splitDimensions;         ///< The dimension each node splits on
+    Vector< Float > splitValues;            ///< The value each node splits at, the left child holds the points <= the value
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_KD_TREE_HEADER
@@ -0,0 +1,206 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "FlatForest.h"
+#include "Node.h"
+#include <deque>
+
+GRT_BEGIN_NAMESPACE
+
+FlatForest::FlatForest(){
+    numOutputs = 0;
+    hasComparisonSplits = false;
+}
+
+FlatForest::~FlatForest(){
+}
+
+bool FlatForest::init( const UINT numOutputs ){
+    clear();
+    if( numOutputs == 0 ) return false;
+    this->numOutputs = numOutputs;
+    return true;
+}
+
+bool FlatForest::clear(){
+    hasComparisonSplits = false;
+    roots.clear();
+    children.clear();
+    featureIndexs.clear();
+    thresholds.clear();
+    splitTypes.clear();
+    comparisonFeatureIndexs.clear();
+    leafValues.clear();
+    leafNodeIDs.clear();
+    return true;
+}
+
+bool FlatForest::addTree( const Node *root ){
+
+    if( root == NULL || numOutputs == 0 ) return false;
+
+    //Remember the size of the table, so the tree can be removed if any of its nodes can not be flattened
+    const UINT numNodes = getNumNodes();
+    const UINT numLeaves = getNumLeaves();
+    const UINT rootIndex = allocateNodes( 1 );
+
+    //Lay the tree out breadth first, the two children of each node are allocated next to each other
+    std::deque< std::pair< const Node*, UINT > > queue;
+    queue.push_back( std::pair< const Node*, UINT >( root, rootIndex ) );
+
+    bool ok = true;
+    while( ok && queue.size() > 0 ){
+        const Node *node = queue.front().first;
+        const UINT flatNodeIndex = queue.front().second;
+        queue.pop_front();
+
+        const Node *leftChild = node->getLeftChild();
+        const Node *rightChild = node->getRightChild();
+
+        if( node->getIsLeafNode() || (leftChild == NULL && rightChild == NULL) ){
+            ok = node->flatten( *this, flatNodeIndex, true );
+            continue;
+        }
+
+        if( !node->flatten( *this, flatNodeIndex, false ) ){
+            ok = false;
+            continue;
+        }
+
+        const UINT childIndex = allocateNodes( 2 );
+        children[ flatNodeIndex ] = childIndex;
+
+        //A missing child predicts with the values of its parent
+        if( leftChild != NULL ) queue.push_back( std::pair< const Node*, UINT >( leftChild, childIndex ) );
+        else ok = node->flatten( *this, childIndex, true );
+
+        if( rightChild != NULL ) queue.push_back( std::pair< const Node*, UINT >( rightChild, childIndex+1 ) );
+        else ok = ok && node->flatten( *this, childIndex+1, true );
+    }
+
+    if( !ok ){
+        children.resize( numNodes );
+        featureIndexs.resize( numNodes );
+        thresholds.resize( numNodes );
+        splitTypes.resize( numNodes );
+        if( hasComparisonSplits ) comparisonFeatureIndexs.resize( 2*numNodes );
+        leafValues.resize( numLeaves*numOutputs );
+        leafNodeIDs.resize( numLeaves );
+        return false;
+    }
+
+    roots.push_back( rootIndex );
+
+    return true;
+}
+
+bool FlatForest::setThresholdSplit( const UINT flatNodeIndex, const UINT featureIndex, const Float threshold ){
+    if( flatNodeIndex >= getNumNodes() ) return false;
+    featureIndexs[ flatNodeIndex ] = featureIndex;
+    thresholds[ flatNodeIndex ] = threshold;
+    splitTypes[ flatNodeIndex ] = THRESHOLD_SPLIT;
+    return true;
+}
+
+bool FlatForest::setComparisonSplit( const UINT flatNodeIndex, const UINT featureIndexA, const UINT featureIndexB, const UINT featureIndexC ){
+    if( flatNodeIndex >= getNumNodes() ) return false;
+
+    //The comparison features are only stored once the table has a comparison split
+    if( !hasComparisonSplits ){
+        hasComparisonSplits = true;
+        comparisonFeatureIndexs.resize( 2*getNumNodes(), 0 );
+    }
+
+    featureIndexs[ flatNodeIndex ] = featureIndexA;
+    thresholds[ flatNodeIndex ] = 0;
+    splitTypes[ flatNodeIndex ] = COMPARISON_SPLIT;
+    comparisonFeatureIndexs[ 2*flatNodeIndex ] = featureIndexB;
+    comparisonFeatureIndexs[ 2*flatNodeIndex+1 ] = featureIndexC;
+    return true;
+}
+
+bool FlatForest::setLeaf( const UINT flatNodeIndex, const VectorFloat &values, const UINT nodeID ){
+    if( flatNodeIndex >= getNumNodes() || values.getSize() != numOutputs ) return false;
+
+    children[ flatNodeIndex ] = 0;
+    featureIndexs[ flatNodeIndex ] = getNumLeaves();
+    thresholds[ flatNodeIndex ] = 0;
+    splitTypes[ flatNodeIndex ] = THRESHOLD_SPLIT;
+    leafValues.insert( leafValues.end(), values.begin(), values.end() );
+    leafNodeIDs.push_back( nodeID );
+    return true;
+}
+
+bool FlatForest::predict( const VectorFloat &x, VectorFloat &y ) const{
+
+    const UINT numTrees = getNumTrees();
+    if( numTrees == 0 ) return false;
+
+    if( y.getSize() != numOutputs ) y.resize( numOutputs );
+    std::fill( y.begin(), y.end(), 0 );
+
+    const Float *input = &x[0];
+    Float *output = &y[0];
+    for(UINT t=0; t<numTrees; t++){
+        const Float *values = getLeafValues( predictLeaf( t, input ) );
+        for(UINT k=0; k<numOutputs; k++){
+            output[k] += values[k];
+        }
+    }
+
+    return true;
+}
+
+bool FlatForest::predict( const MatrixFloat &x, MatrixFloat &y ) const{
+
+    const UINT numTrees = getNumTrees();
+    const UINT M = x.getNumRows();
+    if( numTrees == 0 ) return false;
+
+    if( !y.resize( M, numOutputs ) ) return false;
+    y.setAllValues( 0 );
+
+    //Run one tree at a time over all the rows, so each tree stays in the cache while it is used. The trees are added in the
+    //same order as the single sample predict, so each row gets the same result as predict on that row
+    for(UINT t=0; t<numTrees; t++){
+        for(UINT i=0; i<M; i++){
+            const Float *values = getLeafValues( predictLeaf( t, x[i] ) );
+            Float *output = y[i];
+            for(UINT k=0; k<numOutputs; k++){
+                output[k] += values[k];
+            }
+        }
+    }
+
+    return true;
+}
+
+UINT FlatForest::allocateNodes( const UINT numNodes ){
+    const UINT index = getNumNodes();
+    children.resize( index+numNodes, 0 );
+    featureIndexs.resize( index+numNodes, 0 );
+    thresholds.resize( index+numNodes, 0 );
+    splitTypes.resize( index+numNodes, THRESHOLD_SPLIT );
+    if( hasComparisonSplits ) comparisonFeatureIndexs.resize( 2*(index+numNodes), 0 );
+    return index;
+}
+
+GRT_END_NAMESPACE
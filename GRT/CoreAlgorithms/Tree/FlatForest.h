@@ -0,0 +1,221 @@
+/**
+@file
+@author  Nicholas Gillian <ngillian@media.mit.edu>
+@version 1.0
+
+@brief This class implements the FlatForest, a contiguous node table used to run fast inference with trained trees and forests.
+*/
+
+/**
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GRT_FLAT_FOREST_HEADER
+#define GRT_FLAT_FOREST_HEADER
+
+#include "../../Util/GRTCommon.h"
+
+GRT_BEGIN_NAMESPACE
+
+//Forward declare the Node class, the FlatForest is built from a tree of Nodes
+class Node;
+
+/**
+ @brief This class holds one or more trained trees in a flat, contiguous node table so they can be evaluated without
+ following the pointers between the Node objects or making a virtual call per level.
+
+ The nodes of all the trees are stored as a struct of arrays (feature index, threshold and child index per node). The two
+ children of a node are stored next to each other, so the next node is the left child index plus one if the sample goes
+ right. A child index of zero marks a leaf (the root of the first tree is node zero, so it can never be a child) and the
+ feature index of a leaf holds the index of its values in the leaf value table. Each tree is laid out breadth first, so
+ the top levels of a tree share cache lines.
+
+ A node splits on x[featureIndex] >= threshold, or, for comparison splits, on (x[A]-x[B]) >= (x[C]-x[B]).
+ The FlatForest is built by calling addTree with the root of each tree, each node writes its own split or leaf values
+ into the table through Node::flatten. The table is not saved, it should be rebuilt from the trees after they are loaded.
+*/
+class GRT_API FlatForest{
+public:
+    /**
+     Default Constructor.
+     */
+    FlatForest();
+
+    /**
+     Default Destructor.
+     */
+    ~FlatForest();
+
+    /**
+     Clears all the trees and sets the number of values each leaf holds.
+
+     @param numOutputs: the number of values each leaf holds (e.g. the number of classes or target dimensions)
+     @return returns true if the forest was initialized, false otherwise
+     */
+    bool init( const UINT numOutputs );
+
+    /**
+     Clears all the trees.
+
+     @return returns true if the forest was cleared, false otherwise
+     */
+    bool clear();
+
+    /**
+     Adds a tree to the forest. Each node of the tree is flattened with Node::flatten, if any node can not be flattened then
+     the tree is not added. A node that is not a leaf but is missing a child predicts with its own values on that side,
+     as Node::predict_ does.
+
+     @param root: the root node of the tree
+     @return returns true if the tree was added, false otherwise
+     */
+    bool addTree( const Node *root );
+
+    /**
+     Sets the split of a node to x[featureIndex] >= threshold, this is called by Node::flatten.
+
+     @param flatNodeIndex: the index of the node in the table
+     @param featureIndex: the feature the node splits on
+     @param threshold: the threshold of the split
+     @return returns true if the split was set, false otherwise
+     */
+    bool setThresholdSplit( const UINT flatNodeIndex, const UINT featureIndex, const Float threshold );
+
+    /**
+     Sets the split of a node to (x[featureIndexA]-x[featureIndexB]) >= (x[featureIndexC]-x[featureIndexB]), this is called by Node::flatten.
+
+     @param flatNodeIndex: the index of the node in the table
+     @param featureIndexA: the first feature of the split
+     @param featureIndexB: the feature both sides are compared relative to
+     @param featureIndexC: the second feature of the split
+     @return returns true if the split was set, false otherwise
+     */
+    bool setComparisonSplit( const UINT flatNodeIndex, const UINT featureIndexA, const UINT featureIndexB, const UINT featureIndexC );
+
+    /**
+     Sets a node as a leaf, this is called by Node::flatten.
+
+     @param flatNodeIndex: the index of the node in the table
+     @param values: the values a prediction that reaches this leaf returns, this must have getNumOutputs() values
+     @param nodeID: the ID of the Node the leaf was built from
+     @return returns true if the leaf was set, false otherwise
+     */
+    bool setLeaf( const UINT flatNodeIndex, const VectorFloat &values, const UINT nodeID );
+
+    /**
+     @return returns the number of trees in the forest
+     */
+    UINT getNumTrees() const{ return roots.getSize(); }
+
+    /**
+     @return returns the total number of nodes in the table, including the leaves
+     */
+    UINT getNumNodes() const{ return children.getSize(); }
+
+    /**
+     @return returns the total number of leaves in the table
+     */
+    UINT getNumLeaves() const{ return leafNodeIDs.getSize(); }
+
+    /**
+     @return returns the number of values each leaf holds
+     */
+    UINT getNumOutputs() const{ return numOutputs; }
+
+    /**
+     Runs one tree on the input and returns the leaf it ends at.
+
+     @param treeIndex: the index of the tree, this must be less than getNumTrees()
+     @param x: a pointer to the input, this must have at least as many values as the largest feature index in the trees
+     @return returns the index of the leaf
+     */
+    UINT predictLeaf( const UINT treeIndex, const Float *x ) const{
+        UINT n = roots[ treeIndex ];
+        const UINT *childIndexs = &children[0];
+        if( !hasComparisonSplits ){
+            const UINT *features = &featureIndexs[0];
+            const Float *nodeThresholds = &thresholds[0];
+            while( childIndexs[n] != 0 ){
+                n = childIndexs[n] + (x[ features[n] ] >= nodeThresholds[n] ? 1 : 0);
+            }
+        }else{
+            while( childIndexs[n] != 0 ){
+                n = childIndexs[n] + (goesRight( n, x ) ? 1 : 0);
+            }
+        }
+        return featureIndexs[n];
+    }
+
+    /**
+     @param leafIndex: the index of the leaf, as returned by predictLeaf
+     @return returns a pointer to the getNumOutputs() values of the leaf
+     */
+    const Float* getLeafValues( const UINT leafIndex ) const{ return &leafValues[ leafIndex*numOutputs ]; }
+
+    /**
+     @param leafIndex: the index of the leaf, as returned by predictLeaf
+     @return returns the ID of the Node the leaf was built from
+     */
+    UINT getLeafNodeID( const UINT leafIndex ) const{ return leafNodeIDs[ leafIndex ]; }
+
+    /**
+     Runs every tree on the input and sums the values of the leaves they end at.
+
+     @param x: the input Vector
+     @param y: returns the sum of the leaf values over all the trees, this will be resized to getNumOutputs()
+     @return returns true if the prediction was run, false otherwise
+     */
+    bool predict( const VectorFloat &x, VectorFloat &y ) const;
+
+    /**
+     Runs every tree on each row of the input and sums the values of the leaves they end at. The trees are run one at a time
+     over all the rows, so each tree stays in the cache while it is used. The result for each row is the same as predict on that row.
+
+     @param x: the input Matrix, each row is a sample
+     @param y: returns the sum of the leaf values over all the trees for each row, this will be resized to [x.getNumRows() getNumOutputs()]
+     @return returns true if the prediction was run, false otherwise
+     */
+    bool predict( const MatrixFloat &x, MatrixFloat &y ) const;
+
+protected:
+    UINT allocateNodes( const UINT numNodes );
+
+    bool goesRight( const UINT n, const Float *x ) const{
+        if( splitTypes[n] == THRESHOLD_SPLIT ) return x[ featureIndexs[n] ] >= thresholds[n];
+        const Float valueB = x[ comparisonFeatureIndexs[2*n] ];
+        return (x[ featureIndexs[n] ] - valueB) >= (x[ comparisonFeatureIndexs[2*n+1] ] - valueB);
+    }
+
+    enum SplitType{ THRESHOLD_SPLIT=0, COMPARISON_SPLIT };
+
+    UINT numOutputs;
+    bool hasComparisonSplits;
+    Vector< UINT > roots;
+    Vector< UINT > children;
+    Vector< UINT > featureIndexs;
+    VectorFloat thresholds;
+    Vector< unsigned char > splitTypes;
+    Vector< UINT > comparisonFeatureIndexs;
+    VectorFloat leafValues;
+    Vector< UINT > leafNodeIDs;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_FLAT_FOREST_HEADER
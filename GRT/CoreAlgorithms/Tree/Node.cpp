@@ -63,6 +63,11 @@ bool Node::predict_(VectorFloat &x,VectorFloat &y){
     return false;
 }
 
+bool Node::flatten( FlatForest &/*flatForest*/, const UINT /*flatNodeIndex*/, const bool /*isLeaf*/ ) const{
+    warningLog << __GRT_LOG__ << " Base class not overwritten!" << std::endl;
+    return false;
+}
+
 bool Node::clear(){
     
     //Set the parent pointer to null, this is safe as the parent pointer does not own the memory
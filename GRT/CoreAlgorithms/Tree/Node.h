@@ -31,6 +31,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define GRT_NODE_HEADER
 
 #include "../../CoreModules/MLBase.h"
+#include "FlatForest.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -124,6 +125,18 @@ public:
     */
     virtual bool load( std::fstream &file ) override;
     
+    /**
+    This function writes this node into a FlatForest. If isLeaf is true, the node is written as a leaf holding the values a
+    prediction that ends at this node returns, otherwise the split of the node is written.
+    This function should be overwritten by the inheriting class.
+    
+    @param flatForest: the flat forest the node will be written to
+    @param flatNodeIndex: the index of the node in the flat forest
+    @param isLeaf: if true, the node is written as a leaf
+    @return returns true if the node was written, false otherwise
+    */
+    virtual bool flatten( FlatForest &flatForest, const UINT flatNodeIndex, const bool isLeaf ) const;
+    
     /**
     This function returns a deep copy of the Node and all it's children.
     The user is responsible for managing the dynamic data that is returned from this function as a pointer.
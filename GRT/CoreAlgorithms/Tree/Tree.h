@@ -38,7 +38,7 @@ GRT_BEGIN_NAMESPACE
 class GRT_API Tree : public MLBase
 {
 public:
-    enum TrainingMode{BEST_ITERATIVE_SPILT=0,BEST_RANDOM_SPLIT,NUM_TRAINING_MODES};
+    enum TrainingMode{BEST_ITERATIVE_SPILT=0,BEST_RANDOM_SPLIT,BEST_HISTOGRAM_SPLIT,NUM_TRAINING_MODES};
 
     /**
      Default Constructor
@@ -108,6 +108,7 @@ public:
     
     If the trainingMode is set to BEST_ITERATIVE_SPILT, then the numSplittingSteps controls how many iterative steps there will be per feature.
     If the trainingMode is set to BEST_RANDOM_SPLIT, then the numSplittingSteps controls how many random searches there will be per feature.
+    If the trainingMode is set to BEST_HISTOGRAM_SPLIT, then the numSplittingSteps controls the maximum number of bins each feature is quantised into, this should be in the range [2 65535].
     
     @return returns the number of steps that will be used to search for the best spliting value for each node
     */
@@ -155,6 +156,7 @@ public:
     
     If the trainingMode is set to BEST_ITERATIVE_SPILT, then the numSplittingSteps controls how many iterative steps there will be per feature.
     If the trainingMode is set to BEST_RANDOM_SPLIT, then the numSplittingSteps controls how many random searches there will be per feature.
+    If the trainingMode is set to BEST_HISTOGRAM_SPLIT, then the numSplittingSteps controls the maximum number of bins each feature is quantised into, this should be in the range [2 65535].
     
     A higher value will increase the chances of building a better model, but will take longer to train the model.
     Value must be larger than zero.
@@ -0,0 +1,224 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "TreeTrainingData.h"
+
+GRT_BEGIN_NAMESPACE
+
+TreeTrainingData::TreeTrainingData(){
+    numSamples = 0;
+    numDimensions = 0;
+    numStats = 0;
+    maxNumBins = 0;
+    binsComputed = false;
+}
+
+TreeTrainingData::~TreeTrainingData(){
+}
+
+bool TreeTrainingData::clear(){
+    numSamples = 0;
+    numDimensions = 0;
+    numStats = 0;
+    maxNumBins = 0;
+    binsComputed = false;
+    data.clear();
+    sampleStats.clear();
+    indexs.clear();
+    numBins.clear();
+    bins.clear();
+    binThresholds.clear();
+    histograms.clear();
+    return true;
+}
+
+bool TreeTrainingData::resize( const UINT numSamples, const UINT numDimensions, const UINT numStats ){
+
+    TreeTrainingData::clear();
+
+    if( numSamples == 0 || numDimensions == 0 ) return false;
+
+    this->numSamples = numSamples;
+    this->numDimensions = numDimensions;
+    this->numStats = numStats;
+
+    if( !data.resize( numDimensions, numSamples ) ) return false;
+    if( numStats > 0 ){
+        if( !sampleStats.resize( numSamples, numStats ) ) return false;
+    }
+    indexs.resize( numSamples );
+    for(UINT i=0; i<numSamples; i++) indexs[i] = i;
+
+    return true;
+}
+
+bool TreeTrainingData::computeBins( const UINT maxNumBins ){
+
+    binsComputed = false;
+    histograms.clear();
+
+    if( numSamples == 0 || maxNumBins < 2 || maxNumBins > 65535 ) return false;
+
+    this->maxNumBins = maxNumBins;
+    numBins.resize( numDimensions );
+    binThresholds.resize( numDimensions );
+    bins.resize( numDimensions*numSamples );
+
+    VectorFloat sortedValues( numSamples );
+    for(UINT j=0; j<numDimensions; j++){
+
+        const Float *feature = data[j];
+        std::copy( feature, feature+numSamples, sortedValues.begin() );
+        std::sort( sortedValues.begin(), sortedValues.end() );
+
+        //Cut the sorted values at the quantiles, a cut is placed in front of the first occurrence of a value so equal values share a bin
+        VectorFloat &thresholds = binThresholds[j];
+        thresholds.clear();
+        for(UINT b=1; b<maxNumBins; b++){
+            UINT cutIndex = (UINT)( (unsigned long long)b * numSamples / maxNumBins );
+            while( cutIndex > 0 && sortedValues[cutIndex-1] == sortedValues[cutIndex] ) cutIndex--;
+            if( cutIndex == 0 ) continue;
+
+            const Float lowerValue = sortedValues[cutIndex-1];
+            const Float upperValue = sortedValues[cutIndex];
+            if( thresholds.size() > 0 && thresholds.back() > lowerValue ) continue;
+
+            //Place the threshold between the two values, if the midpoint rounds onto the lower value then use the upper value
+            Float threshold = lowerValue + (upperValue-lowerValue) * 0.5;
+            if( threshold <= lowerValue || threshold > upperValue ) threshold = upperValue;
+            thresholds.push_back( threshold );
+        }
+        numBins[j] = (UINT)thresholds.size() + 1;
+
+        //The bin of a value is the number of thresholds that are less than or equal to it
+        unsigned short *featureBins = &bins[ j*numSamples ];
+        for(UINT i=0; i<numSamples; i++){
+            featureBins[i] = (unsigned short)( std::upper_bound( thresholds.begin(), thresholds.end(), feature[i] ) - thresholds.begin() );
+        }
+    }
+
+    binsComputed = true;
+
+    return true;
+}
+
+VectorFloat TreeTrainingData::getMean( const UINT startIndex, const UINT endIndex ) const{
+
+    VectorFloat mean( numDimensions, 0 );
+
+    if( endIndex <= startIndex ) return mean;
+
+    for(UINT j=0; j<numDimensions; j++){
+        const Float *feature = data[j];
+        for(UINT i=startIndex; i<endIndex; i++){
+            mean[j] += feature[ indexs[i] ];
+        }
+        mean[j] /= Float(endIndex-startIndex);
+    }
+
+    return mean;
+}
+
+MinMax TreeTrainingData::getRange( const UINT featureIndex, const UINT startIndex, const UINT endIndex ) const{
+
+    MinMax range;
+
+    if( endIndex <= startIndex ) return range;
+
+    const Float *feature = data[ featureIndex ];
+    range.minValue = range.maxValue = feature[ indexs[startIndex] ];
+    for(UINT i=startIndex+1; i<endIndex; i++){
+        range.updateMinMax( feature[ indexs[i] ] );
+    }
+
+    return range;
+}
+
+const VectorFloat& TreeTrainingData::getHistogram( const UINT startIndex, const UINT endIndex ){
+
+    const std::pair< UINT, UINT > key( startIndex, endIndex );
+    std::map< std::pair< UINT, UINT >, VectorFloat >::iterator iter = histograms.find( key );
+    if( iter != histograms.end() ) return iter->second;
+
+    VectorFloat &histogram = histograms[ key ];
+    computeHistogram( startIndex, endIndex, histogram );
+    return histogram;
+}
+
+bool TreeTrainingData::releaseHistogram( const UINT startIndex, const UINT endIndex ){
+    return histograms.erase( std::pair< UINT, UINT >( startIndex, endIndex ) ) > 0;
+}
+
+bool TreeTrainingData::computeHistogram( const UINT startIndex, const UINT endIndex, VectorFloat &histogram ) const{
+
+    const UINT stride = numStats + 1;
+    histogram.resize( numDimensions*maxNumBins*stride );
+    std::fill( histogram.begin(), histogram.end(), 0 );
+
+    if( !binsComputed ) return false;
+
+    for(UINT j=0; j<numDimensions; j++){
+        const unsigned short *featureBins = &bins[ j*numSamples ];
+        Float *featureHistogram = &histogram[ j*maxNumBins*stride ];
+        for(UINT i=startIndex; i<endIndex; i++){
+            const UINT sampleIndex = indexs[i];
+            Float *entry = featureHistogram + featureBins[ sampleIndex ]*stride;
+            const Float *stats = numStats > 0 ? sampleStats[ sampleIndex ] : NULL;
+            entry[0]++;
+            for(UINT s=0; s<numStats; s++){
+                entry[s+1] += stats[s];
+            }
+        }
+    }
+
+    return true;
+}
+
+bool TreeTrainingData::splitHistogram( const UINT startIndex, const UINT splitIndex, const UINT endIndex ){
+
+    //If one side is empty, the other side has the same range and samples as the parent so its histogram is unchanged
+    if( splitIndex == startIndex || splitIndex == endIndex ) return true;
+
+    std::map< std::pair< UINT, UINT >, VectorFloat >::iterator iter = histograms.find( std::pair< UINT, UINT >( startIndex, endIndex ) );
+    if( iter == histograms.end() ) return true;
+
+    VectorFloat largerHistogram;
+    largerHistogram.swap( iter->second );
+    histograms.erase( iter );
+
+    //Only the smaller child is computed from the samples, the larger child is the parent minus the smaller child
+    const bool leftIsSmaller = splitIndex-startIndex <= endIndex-splitIndex;
+    const std::pair< UINT, UINT > smallerKey = leftIsSmaller ? std::pair< UINT, UINT >( startIndex, splitIndex ) : std::pair< UINT, UINT >( splitIndex, endIndex );
+    const std::pair< UINT, UINT > largerKey = leftIsSmaller ? std::pair< UINT, UINT >( splitIndex, endIndex ) : std::pair< UINT, UINT >( startIndex, splitIndex );
+
+    VectorFloat &smallerHistogram = histograms[ smallerKey ];
+    computeHistogram( smallerKey.first, smallerKey.second, smallerHistogram );
+
+    const size_t size = largerHistogram.size();
+    for(size_t i=0; i<size; i++){
+        largerHistogram[i] -= smallerHistogram[i];
+    }
+    histograms[ largerKey ].swap( largerHistogram );
+
+    return true;
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,224 @@
+/**
+@file
+@author  Nicholas Gillian <ngillian@media.mit.edu>
+@version 1.0
+
+@brief This class implements the base class TreeTrainingData, the training data store used to build the DecisionTree and RegressionTree.
+*/
+
+/**
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef GRT_TREE_TRAINING_DATA_HEADER
+#define GRT_TREE_TRAINING_DATA_HEADER
+
+#include "../../Util/GRTCommon.h"
+
+GRT_BEGIN_NAMESPACE
+
+/**
+ @brief This class holds the training data used to build a tree.
+
+ The features are stored column-major (one row per feature, one column per sample), together with a small Vector of
+ statistics for each sample (e.g. a one-hot class Vector for classification, or the targets for regression). The data is
+ copied once and is read-only while the tree is built. Each node owns a range [startIndex endIndex) of the sample index
+ permutation, which is partitioned in place when the node is split: the samples of the left child are the first part
+ of the range and the samples of the right child the second part.
+
+ The features can also be quantised into a small number of bins. A histogram of a node holds, for each feature and bin,
+ the number of samples and the sum of their statistics, so a split search can run over the bins instead of the samples.
+ When a node whose histogram has been computed is partitioned, only the histogram of the smaller child is computed from
+ the samples, the histogram of the larger child is the parent histogram minus the smaller one.
+*/
+class GRT_API TreeTrainingData{
+public:
+    /**
+     Default Constructor.
+     */
+    TreeTrainingData();
+
+    /**
+     Default Destructor.
+     */
+    virtual ~TreeTrainingData();
+
+    /**
+     Clears the store.
+
+     @return returns true if the store was cleared, false otherwise
+     */
+    virtual bool clear();
+
+    /**
+     Quantises each feature into at most maxNumBins bins, so that each bin holds about the same number of samples.
+     The bin thresholds are placed between the values of consecutive bins, so a sample is in a bin >= b if and only if
+     its value is >= getBinThreshold(featureIndex,b).
+
+     @param maxNumBins: the maximum number of bins per feature, this should be in the range [2 65535]
+     @return returns true if the bins were computed, false otherwise
+     */
+    bool computeBins( const UINT maxNumBins );
+
+    /**
+     @return returns true if the bins have been computed, false otherwise
+     */
+    bool getBinsComputed() const{ return binsComputed; }
+
+    /**
+     @return returns the total number of samples in the store
+     */
+    UINT getNumSamples() const{ return numSamples; }
+
+    /**
+     @return returns the number of dimensions of each sample
+     */
+    UINT getNumDimensions() const{ return numDimensions; }
+
+    /**
+     @return returns the number of statistics of each sample
+     */
+    UINT getNumStats() const{ return numStats; }
+
+    /**
+     @return returns the sample index permutation, the samples of a node are given by the node's range in this Vector
+     */
+    const Vector< UINT >& getIndexs() const{ return indexs; }
+
+    /**
+     @param sampleIndex: the index of the sample in the original dataset
+     @param featureIndex: the index of the feature
+     @return returns the value of the feature for that sample
+     */
+    Float getValue( const UINT sampleIndex, const UINT featureIndex ) const{ return data[ featureIndex ][ sampleIndex ]; }
+
+    /**
+     @param sampleIndex: the index of the sample in the original dataset
+     @param statIndex: the index of the statistic
+     @return returns the statistic for that sample
+     */
+    Float getSampleStat( const UINT sampleIndex, const UINT statIndex ) const{ return sampleStats[ sampleIndex ][ statIndex ]; }
+
+    /**
+     @param featureIndex: the index of the feature
+     @return returns the number of bins of the feature, the bins must have been computed first
+     */
+    UINT getNumBins( const UINT featureIndex ) const{ return numBins[ featureIndex ]; }
+
+    /**
+     @param sampleIndex: the index of the sample in the original dataset
+     @param featureIndex: the index of the feature
+     @return returns the bin of the feature for that sample, the bins must have been computed first
+     */
+    UINT getBin( const UINT sampleIndex, const UINT featureIndex ) const{ return bins[ featureIndex*numSamples + sampleIndex ]; }
+
+    /**
+     @param featureIndex: the index of the feature
+     @param binIndex: the index of the bin, this should be in the range [1 getNumBins(featureIndex)-1]
+     @return returns the threshold between bin binIndex-1 and bin binIndex
+     */
+    Float getBinThreshold( const UINT featureIndex, const UINT binIndex ) const{ return binThresholds[ featureIndex ][ binIndex-1 ]; }
+
+    /**
+     @param startIndex: the start of the range
+     @param endIndex: the end of the range (not inclusive)
+     @return returns the mean of the samples in the range [startIndex endIndex) of the index permutation
+     */
+    VectorFloat getMean( const UINT startIndex, const UINT endIndex ) const;
+
+    /**
+     @param featureIndex: the feature the range is computed for
+     @param startIndex: the start of the range
+     @param endIndex: the end of the range (not inclusive)
+     @return returns the min and max value of the feature over the samples in the range [startIndex endIndex) of the index permutation
+     */
+    MinMax getRange( const UINT featureIndex, const UINT startIndex, const UINT endIndex ) const;
+
+    /**
+     Gets the histogram of the samples in the range [startIndex endIndex), the bins must have been computed first.
+     The histogram has one entry per feature and bin, stored contiguously at (featureIndex*getMaxNumBins()+binIndex)*getHistogramStride().
+     The first value of an entry is the number of samples in the bin and value s+1 the sum of statistic s over those samples.
+     The histogram is computed the first time it is requested and kept until it is released, or until the range is partitioned.
+
+     @param startIndex: the start of the range
+     @param endIndex: the end of the range (not inclusive)
+     @return returns a reference to the histogram of the range
+     */
+    const VectorFloat& getHistogram( const UINT startIndex, const UINT endIndex );
+
+    /**
+     Releases the histogram of the range [startIndex endIndex), if one has been computed. This should be called when
+     the range becomes a leaf node.
+
+     @param startIndex: the start of the range
+     @param endIndex: the end of the range (not inclusive)
+     @return returns true if a histogram was released, false otherwise
+     */
+    bool releaseHistogram( const UINT startIndex, const UINT endIndex );
+
+    /**
+     @return returns the number of histogram entries between two consecutive features
+     */
+    UINT getMaxNumBins() const{ return maxNumBins; }
+
+    /**
+     @return returns the number of values of each histogram entry, this is getNumStats()+1
+     */
+    UINT getHistogramStride() const{ return numStats+1; }
+
+    /**
+     Partitions the range [startIndex endIndex) of the index permutation in place, the samples for which goesRight returns
+     false are moved to the front of the range and the samples for which it returns true to the back of the range.
+     No memory is allocated, the samples are swapped within the range. If the histogram of the range has been computed,
+     the histograms of the two parts are computed from it.
+
+     @param startIndex: the start of the range
+     @param endIndex: the end of the range (not inclusive)
+     @param goesRight: a function that takes a sample index and returns true if the sample should go to the right child
+     @return returns the index of the first sample of the right child
+     */
+    template< class Function >
+    UINT partition( const UINT startIndex, const UINT endIndex, Function goesRight ){
+        const UINT splitIndex = (UINT)(std::partition( indexs.begin()+startIndex, indexs.begin()+endIndex, [&](const UINT sampleIndex){ return !goesRight( sampleIndex ); } ) - indexs.begin());
+        splitHistogram( startIndex, splitIndex, endIndex );
+        return splitIndex;
+    }
+
+protected:
+    bool resize( const UINT numSamples, const UINT numDimensions, const UINT numStats );
+    bool computeHistogram( const UINT startIndex, const UINT endIndex, VectorFloat &histogram ) const;
+    bool splitHistogram( const UINT startIndex, const UINT splitIndex, const UINT endIndex );
+
+    UINT numSamples;
+    UINT numDimensions;
+    UINT numStats;
+    UINT maxNumBins;
+    bool binsComputed;
+    MatrixFloat data;
+    MatrixFloat sampleStats;
+    Vector< UINT > indexs;
+    Vector< UINT > numBins;
+    Vector< unsigned short > bins;
+    Vector< VectorFloat > binThresholds;
+    std::map< std::pair< UINT, UINT >, VectorFloat > histograms;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_TREE_TRAINING_DATA_HEADER
@@ -172,6 +172,46 @@ bool Classifier::computeAccuracy( const ClassificationData &data, Float &accurac
     return Metrics::computeAccuracy( *this, data, accuracy );
 }
 
+bool Classifier::computeAccuracy( const ClassificationDataView &data, Float &accuracy ){ 
+    return Metrics::computeAccuracy( *this, data, accuracy );
+}
+
+bool Classifier::predictBatch( const MatrixFloat &inputData, MatrixFloat &classLikelihoods, Vector< UINT > &predictedClassLabels ){
+
+    if( !trained ){
+        errorLog << __GRT_LOG__ << " Model Not Trained!" << std::endl;
+        return false;
+    }
+
+    if( inputData.getNumCols() != numInputDimensions ){
+        errorLog << __GRT_LOG__ << " The number of columns in the input data (" << inputData.getNumCols() << ") does not match the num features in the model (" << numInputDimensions << ")" << std::endl;
+        return false;
+    }
+
+    const UINT M = inputData.getNumRows();
+    classLikelihoods.resize( M, numClasses );
+    predictedClassLabels.resize( M );
+
+    //Copy each row into the same buffer, so a new vector is not allocated for each row. The buffer is copied for each row as predict_ may change it
+    VectorFloat inputVector( numInputDimensions );
+    for(UINT i=0; i<M; i++){
+        std::copy( inputData[i], inputData[i]+numInputDimensions, inputVector.begin() );
+
+        if( !predict_( inputVector ) ){
+            errorLog << __GRT_LOG__ << " Failed to predict row " << i << std::endl;
+            return false;
+        }
+
+        predictedClassLabels[i] = predictedClassLabel;
+        const UINT numLikelihoods = std::min( numClasses, this->classLikelihoods.getSize() );
+        for(UINT k=0; k<numClasses; k++){
+            classLikelihoods[i][k] = k < numLikelihoods ? this->classLikelihoods[k] : 0;
+        }
+    }
+
+    return true;
+}
+
 std::string Classifier::getClassifierType() const{
     return MLBase::getId(); 
 }
@@ -93,6 +93,26 @@ public:
     @return returns true if the accuracy was computed, false otherwise
     */
     virtual bool computeAccuracy( const ClassificationData &data, Float &accuracy );
+
+    /**
+    Computes the accuracy of the current model given a view of a dataset. The accuracy results will be stored in the accuracy parameter and will be in the range of [0., 100.0].
+    @param data: the view of the dataset that will be used to test the model
+    @param accuracy: the variable to which the accuracy of the model will be stored 
+    @return returns true if the accuracy was computed, false otherwise
+    */
+    virtual bool computeAccuracy( const ClassificationDataView &data, Float &accuracy );
+
+    /**
+    Predicts the class of each row of the input data, the rows are predicted in order. The base implementation copies each row into one buffer
+    and calls predict_, so the last prediction of the model will be the last row. Classifiers that can predict many rows at once more efficiently
+    should override this function, these may not update the last prediction of the model.
+
+    @param inputData: the input data to classify, each row is a sample and the number of columns must match the number of features of the model
+    @param classLikelihoods: returns the class likelihoods of each row, this will be resized to [inputData.getNumRows() numClasses]
+    @param predictedClassLabels: returns the predicted class label of each row, this will be resized to inputData.getNumRows()
+    @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictBatch( const MatrixFloat &inputData, MatrixFloat &classLikelihoods, Vector< UINT > &predictedClassLabels );
     
     /**
     Returns the classifier type as a string.
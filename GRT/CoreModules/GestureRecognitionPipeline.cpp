@@ -145,6 +145,24 @@ GestureRecognitionPipeline::~GestureRecognitionPipeline(void)
 } 
     
 bool GestureRecognitionPipeline::train_(ClassificationData &trainingData){
+    return trainOnSubset( trainingData, NULL );
+}
+
+bool GestureRecognitionPipeline::train(const ClassificationData &trainingData){
+    return trainOnSubset( trainingData, NULL );
+}
+
+bool GestureRecognitionPipeline::train_(ClassificationDataView &trainingData){
+    
+    if( !trainingData.getIsValid() ){
+        errorLog << __GRT_LOG__ << " Failed To Train Classifier, the view does not refer to a dataset!" << std::endl;
+        return false;
+    }
+    
+    return trainOnSubset( trainingData.getDataset(), &trainingData.getIndexs() );
+}
+
+bool GestureRecognitionPipeline::trainOnSubset(const ClassificationData &trainingData,const Vector< UINT > *sampleIndexs){
     
     trained = false;
     trainingTime = 0;
@@ -155,7 +173,10 @@ bool GestureRecognitionPipeline::train_(ClassificationData &trainingData){
         return false;
     }
     
-    if( trainingData.getNumSamples() == 0 ){
+    //Get the number of samples to train with, this is all the samples unless a subset has been given
+    const UINT numSamples = sampleIndexs != NULL ? sampleIndexs->getSize() : trainingData.getNumSamples();
+    
+    if( numSamples == 0 ){
         errorLog << __GRT_LOG__ << " Failed To Train Classifier, there is no training data!" << std::endl;
         return false;
     }
@@ -166,6 +187,24 @@ bool GestureRecognitionPipeline::train_(ClassificationData &trainingData){
     //Set the input Vector dimension size
     inputVectorDimensions = trainingData.getNumDimensions();
     
+    //If there are no pre-processing or feature extraction modules then the classifier is trained directly from a view of the training data, so the samples are not copied
+    if( !getIsPreProcessingSet() && !getIsFeatureExtractionSet() ){
+        Timer timer;
+        timer.start();
+        
+        ClassificationDataView view = sampleIndexs != NULL ? ClassificationDataView( trainingData, *sampleIndexs, false ) : ClassificationDataView( trainingData );
+        numTrainingSamples = view.getNumSamples();
+        
+        trained = classifier->train_( view );
+        if( !trained ){
+            errorLog << __GRT_LOG__ << " Failed To Train Classifier: " << classifier->getLastErrorMessage() << std::endl;
+            return false;
+        }
+        
+        trainingTime = timer.getMilliSeconds();
+        return true;
+    }
+    
     //Pass the training data through any pre-processing or feature extraction units
     UINT numDimensions = trainingData.getNumDimensions();
     
@@ -183,13 +222,14 @@ bool GestureRecognitionPipeline::train_(ClassificationData &trainingData){
     timer.start();
     
     ClassificationData processedTrainingData( numDimensions );
-    processedTrainingData.reserve( trainingData.getNumSamples() );
+    processedTrainingData.reserve( numSamples );
     UINT classLabel = 0;
     VectorFloat trainingSample;
-    for(UINT i=0; i<trainingData.getNumSamples(); i++){
+    for(UINT i=0; i<numSamples; i++){
         bool okToAddProcessedData = true;
-        classLabel = trainingData[i].getClassLabel();
-        trainingSample = trainingData[i].getSample();
+        const ClassificationSample &sample = trainingData[ sampleIndexs != NULL ? (*sampleIndexs)[i] : i ];
+        classLabel = sample.getClassLabel();
+        trainingSample = sample.getSample();
         
         //Perform any preprocessing
         if( getIsPreProcessingSet() ){
@@ -229,8 +269,8 @@ bool GestureRecognitionPipeline::train_(ClassificationData &trainingData){
         
     }
     
-    if( processedTrainingData.getNumSamples() != trainingData.getNumSamples() ){
-        warningLog << __GRT_LOG__ << " Lost " << trainingData.getNumSamples()-processedTrainingData.getNumSamples() << " of " << trainingData.getNumSamples() << " training samples due to the processing stage!" << std::endl;
+    if( processedTrainingData.getNumSamples() != numSamples ){
+        warningLog << __GRT_LOG__ << " Lost " << numSamples-processedTrainingData.getNumSamples() << " of " << numSamples << " training samples due to the processing stage!" << std::endl;
     }
 
     //Store the number of training samples
@@ -284,30 +324,49 @@ bool GestureRecognitionPipeline::train_(ClassificationData &data,const UINT kFol
         return false;
     }
     
-    //Run the k-fold training and testing
-    Float crossValidationAccuracy = 0;
-    ClassificationData foldTrainingData;
-    ClassificationData foldTestData;
+    //Run the k-fold training and testing, each fold is trained and tested on its own copy of the pipeline so the folds can run in parallel
+    Vector< GestureRecognitionPipeline > foldPipelines( kFoldValue );
+    for(UINT k=0; k<kFoldValue; k++){
+        foldPipelines[k] = *this;
+    }
+    Vector< UINT > foldTrained( kFoldValue, 0 );
+    Vector< UINT > foldTested( kFoldValue, 0 );
+    Vector< Float > foldAccuracy( kFoldValue, 0 );
     Vector< TestResult > cvResults(kFoldValue);
 
-    for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-		foldTrainingData = data.getTrainingFoldData(k);
+    ThreadPool::parallel_for( 0, kFoldValue, [&](const UINT k){
+        GestureRecognitionPipeline &pipeline = foldPipelines[k];
         
-        if( !train_( foldTrainingData ) ){
-            return false;
-        }
+        //Train the classification system
+        const Vector< UINT > foldTrainingIndexs = data.getTrainingFoldIndexs(k);
+        if( !pipeline.trainOnSubset( data, &foldTrainingIndexs ) ) return;
+        foldTrained[k] = 1;
         
         //Test the classification system
-        foldTestData = data.getTestFoldData(k);
+        const Vector< UINT > foldTestIndexs = data.getTestFoldIndexs(k);
+        if( !pipeline.testOnSubset( data, &foldTestIndexs ) ) return;
+        foldTested[k] = 1;
         
-        if( !test( foldTestData ) ){
+        foldAccuracy[k] = pipeline.getTestAccuracy();
+        cvResults[k] = pipeline.getTestResults();
+    } );
+
+    //Combine the results of each fold, in fold order
+    Float crossValidationAccuracy = 0;
+    for(UINT k=0; k<kFoldValue; k++){
+        if( !foldTrained[k] ){
+            errorLog << __GRT_LOG__ << " Failed to train pipeline for fold " << k << "." << std::endl;
             return false;
         }
-        
-        crossValidationAccuracy += getTestAccuracy();
-        cvResults[k] = getTestResults();
+        if( !foldTested[k] ){
+            errorLog << __GRT_LOG__ << " Failed to test pipeline for fold " << k << "." << std::endl;
+            return false;
+        }
+        crossValidationAccuracy += foldAccuracy[k];
     }
+    
+    //Keep the pipeline trained on the last fold, as the model of the pipeline
+    *this = foldPipelines[ kFoldValue-1 ];
 
     //Flag that the model has been trained
     trained = true;
@@ -323,6 +382,14 @@ bool GestureRecognitionPipeline::train_(ClassificationData &data,const UINT kFol
 }
 
 bool GestureRecognitionPipeline::train_( TimeSeriesClassificationData &trainingData ){
+    return trainOnSubset( trainingData, NULL );
+}
+
+bool GestureRecognitionPipeline::train( const TimeSeriesClassificationData &trainingData ){
+    return trainOnSubset( trainingData, NULL );
+}
+
+bool GestureRecognitionPipeline::trainOnSubset(const TimeSeriesClassificationData &trainingData,const Vector< UINT > *sampleIndexs){
     
     trained = false;
     trainingTime = 0;
@@ -333,7 +400,10 @@ bool GestureRecognitionPipeline::train_( TimeSeriesClassificationData &trainingD
         return false;
     }
     
-    if( trainingData.getNumSamples() == 0 ){
+    //Get the number of samples to train with, this is all the samples unless a subset has been given
+    const UINT numSamples = sampleIndexs != NULL ? sampleIndexs->getSize() : trainingData.getNumSamples();
+    
+    if( numSamples == 0 ){
         errorLog << __GRT_LOG__ << " Failed To Train Classifier, there is no training data!" << std::endl;
         return false;
     }
@@ -380,9 +450,10 @@ bool GestureRecognitionPipeline::train_( TimeSeriesClassificationData &trainingD
     }
     
     //Pass the timeseries data through any pre-processing modules and add it to the processedTrainingData structure
-    for(UINT i=0; i<trainingData.getNumSamples(); i++){
-        UINT classLabel = trainingData[i].getClassLabel();
-        MatrixFloat trainingSample = trainingData[i].getData();
+    for(UINT i=0; i<numSamples; i++){
+        const TimeSeriesClassificationSample &sample = trainingData[ sampleIndexs != NULL ? (*sampleIndexs)[i] : i ];
+        UINT classLabel = sample.getClassLabel();
+        MatrixFloat trainingSample = sample.getData();
         
         if( getIsPreProcessingSet() ){
             
@@ -557,30 +628,47 @@ bool GestureRecognitionPipeline::train_(TimeSeriesClassificationData &data,const
         return false;
     }
     
-    //Run the k-fold training and testing
-    Float crossValidationAccuracy = 0;
-    TimeSeriesClassificationData foldTrainingData;
-    TimeSeriesClassificationData foldTestData;
-    
+    //Run the k-fold training and testing, each fold is trained and tested on its own copy of the pipeline so the folds can run in parallel
+    Vector< GestureRecognitionPipeline > foldPipelines( kFoldValue );
     for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-		foldTrainingData = data.getTrainingFoldData(k);
+        foldPipelines[k] = *this;
+    }
+    Vector< UINT > foldTrained( kFoldValue, 0 );
+    Vector< UINT > foldTested( kFoldValue, 0 );
+    Vector< Float > foldAccuracy( kFoldValue, 0 );
+    
+    ThreadPool::parallel_for( 0, kFoldValue, [&](const UINT k){
+        GestureRecognitionPipeline &pipeline = foldPipelines[k];
         
-        if( !train_( foldTrainingData ) ){
-            errorLog << __GRT_LOG__ << " Failed to train pipeline for fold " << k << "." << std::endl;
-            return false;
-        }
+        //Train the classification system
+        const Vector< UINT > foldTrainingIndexs = data.getTrainingFoldIndexs(k);
+        if( !pipeline.trainOnSubset( data, &foldTrainingIndexs ) ) return;
+        foldTrained[k] = 1;
         
         //Test the classification system
-        foldTestData = data.getTestFoldData(k);
+        const Vector< UINT > foldTestIndexs = data.getTestFoldIndexs(k);
+        if( !pipeline.testOnSubset( data, &foldTestIndexs ) ) return;
+        foldTested[k] = 1;
         
-        if( !test( foldTestData ) ){
+        foldAccuracy[k] = pipeline.getTestAccuracy();
+    } );
+
+    //Combine the results of each fold, in fold order
+    Float crossValidationAccuracy = 0;
+    for(UINT k=0; k<kFoldValue; k++){
+        if( !foldTrained[k] ){
+            errorLog << __GRT_LOG__ << " Failed to train pipeline for fold " << k << "." << std::endl;
+            return false;
+        }
+        if( !foldTested[k] ){
             errorLog << __GRT_LOG__ << " Failed to test pipeline for fold " << k << "." << std::endl;
             return false;
         }
-        
-        crossValidationAccuracy += getTestAccuracy();
+        crossValidationAccuracy += foldAccuracy[k];
     }
+    
+    //Keep the pipeline trained on the last fold, as the model of the pipeline
+    *this = foldPipelines[ kFoldValue-1 ];
 
     //Flag that the model has been trained
     trained = true;
@@ -700,6 +788,14 @@ bool GestureRecognitionPipeline::train_(ClassificationDataStream &trainingData){
 }
     
 bool GestureRecognitionPipeline::train_(RegressionData &trainingData){
+    return trainOnSubset( trainingData, NULL );
+}
+
+bool GestureRecognitionPipeline::train(const RegressionData &trainingData){
+    return trainOnSubset( trainingData, NULL );
+}
+
+bool GestureRecognitionPipeline::trainOnSubset(const RegressionData &trainingData,const Vector< UINT > *sampleIndexs){
     
     trained = false;
     trainingTime = 0;
@@ -740,9 +836,13 @@ bool GestureRecognitionPipeline::train_(RegressionData &trainingData){
     
     processedTrainingData.setInputAndTargetDimensions(numInputs, numTargets);
     
-    for(UINT i=0; i<trainingData.getNumSamples(); i++){
-        VectorFloat inputVector = trainingData[i].getInputVector();
-        VectorFloat targetVector = trainingData[i].getTargetVector();
+    //Get the number of samples to train with, this is all the samples unless a subset has been given
+    const UINT numSamples = sampleIndexs != NULL ? sampleIndexs->getSize() : trainingData.getNumSamples();
+    
+    for(UINT i=0; i<numSamples; i++){
+        const RegressionSample &sample = trainingData[ sampleIndexs != NULL ? (*sampleIndexs)[i] : i ];
+        VectorFloat inputVector = sample.getInputVector();
+        VectorFloat targetVector = sample.getTargetVector();
         
         if( getIsPreProcessingSet() ){
             for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
@@ -832,28 +932,47 @@ bool GestureRecognitionPipeline::train_(RegressionData &data,const UINT kFoldVal
         return false;
     }
     
-    //Run the k-fold training and testing
-    Float crossValidationAccuracy = 0;
-    RegressionData foldTrainingData;
-    RegressionData foldTestData;
+    //Run the k-fold training and testing, each fold is trained and tested on its own copy of the pipeline so the folds can run in parallel
+    Vector< GestureRecognitionPipeline > foldPipelines( kFoldValue );
     for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-        foldTrainingData = data.getTrainingFoldData(k);
+        foldPipelines[k] = *this;
+    }
+    Vector< UINT > foldTrained( kFoldValue, 0 );
+    Vector< UINT > foldTested( kFoldValue, 0 );
+    Vector< Float > foldRMSError( kFoldValue, 0 );
+    
+    ThreadPool::parallel_for( 0, kFoldValue, [&](const UINT k){
+        GestureRecognitionPipeline &pipeline = foldPipelines[k];
         
-        if( !train_( foldTrainingData ) ){
-            return false;
-        }
+        //Train the regression system
+        const Vector< UINT > foldTrainingIndexs = data.getTrainingFoldIndexs(k);
+        if( !pipeline.trainOnSubset( data, &foldTrainingIndexs ) ) return;
+        foldTrained[k] = 1;
         
-        //Test the classification system
-        foldTestData = data.getTestFoldData(k);
+        //Test the regression system
+        const Vector< UINT > foldTestIndexs = data.getTestFoldIndexs(k);
+        if( !pipeline.testOnSubset( data, &foldTestIndexs ) ) return;
+        foldTested[k] = 1;
         
-        if( !test( foldTestData ) ){
+        foldRMSError[k] = pipeline.getTestRMSError();
+    } );
+
+    //Combine the results of each fold, in fold order
+    Float crossValidationAccuracy = 0;
+    for(UINT k=0; k<kFoldValue; k++){
+        if( !foldTrained[k] ){
+            errorLog << __GRT_LOG__ << " Failed to train pipeline for fold " << k << "." << std::endl;
             return false;
         }
-
-        crossValidationAccuracy += getTestRMSError();
-        
+        if( !foldTested[k] ){
+            errorLog << __GRT_LOG__ << " Failed to test pipeline for fold " << k << "." << std::endl;
+            return false;
+        }
+        crossValidationAccuracy += foldRMSError[k];
     }
+    
+    //Keep the pipeline trained on the last fold, as the model of the pipeline
+    *this = foldPipelines[ kFoldValue-1 ];
 
     //Flag that the model has been trained
     trained = true;
@@ -970,6 +1089,10 @@ bool GestureRecognitionPipeline::train_(UnlabelledData &trainingData){
 }
     
 bool GestureRecognitionPipeline::test(const ClassificationData &testData){
+    return testOnSubset( testData, NULL );
+}
+
+bool GestureRecognitionPipeline::testOnSubset(const ClassificationData &testData,const Vector< UINT > *sampleIndexs){
     
     //Clear any previous test results
     clearTestResults();
@@ -994,12 +1117,14 @@ bool GestureRecognitionPipeline::test(const ClassificationData &testData){
     //Reset all the modules
     reset();
 
-	//Validate that the class labels in the test data match the class labels in the model
+	//Validate that the class labels in the test data match the class labels in the model, only the classes with samples to test are checked
+	const Vector< ClassTracker > testClasses = sampleIndexs != NULL ? ClassificationDataView( testData, *sampleIndexs, false ).getClassTracker() : testData.getClassTracker();
 	bool classLabelValidationPassed = true;
-	for(UINT i=0; i<testData.getNumClasses(); i++){
+	for(UINT i=0; i<testClasses.getSize(); i++){
+		if( testClasses[i].counter == 0 ) continue;
 		bool labelFound = false;
 		for(UINT k=0; k<classifier->getNumClasses(); k++){
-			if( testData.getClassTracker()[i].classLabel == classifier->getClassLabels()[k] ){
+			if( testClasses[i].classLabel == classifier->getClassLabels()[k] ){
 				labelFound = true;
 				break;
 			}
@@ -1007,7 +1132,7 @@ bool GestureRecognitionPipeline::test(const ClassificationData &testData){
 
 		if( !labelFound ){
 			classLabelValidationPassed = false;
-            errorLog << __GRT_LOG__ << " The test dataset contains a class label (" << testData.getClassTracker()[i].classLabel << ") that is not in the model!" << std::endl;
+            errorLog << __GRT_LOG__ << " The test dataset contains a class label (" << testClasses[i].classLabel << ") that is not in the model!" << std::endl;
 		}
 	}
 
@@ -1038,8 +1163,8 @@ bool GestureRecognitionPipeline::test(const ClassificationData &testData){
     testPrecision.resize(getNumClassesInModel(), 0);
     testRecall.resize(getNumClassesInModel(), 0);
     testFMeasure.resize(getNumClassesInModel(), 0);
-    testResults.resize(testData.getNumSamples());
-    numTestSamples = testData.getNumSamples();
+    numTestSamples = sampleIndexs != NULL ? sampleIndexs->getSize() : testData.getNumSamples();
+    testResults.resize(numTestSamples);
     
     //Start the test timer
     Timer timer;
@@ -1047,8 +1172,9 @@ bool GestureRecognitionPipeline::test(const ClassificationData &testData){
 
     //Run the test
     for(UINT i=0; i<numTestSamples; i++){
-        UINT classLabel = testData[i].getClassLabel();
-        VectorFloat testSample = testData[i].getSample();
+        const ClassificationSample &sample = testData[ sampleIndexs != NULL ? (*sampleIndexs)[i] : i ];
+        UINT classLabel = sample.getClassLabel();
+        VectorFloat testSample = sample.getSample();
         
         //Pass the test sample through the pipeline
         if( !predict_( testSample ) ){
@@ -1083,6 +1209,10 @@ bool GestureRecognitionPipeline::test(const ClassificationData &testData){
 }
     
 bool GestureRecognitionPipeline::test(const TimeSeriesClassificationData &testData){
+    return testOnSubset( testData, NULL );
+}
+
+bool GestureRecognitionPipeline::testOnSubset(const TimeSeriesClassificationData &testData,const Vector< UINT > *sampleIndexs){
 
     //Clear any previous test results
     clearTestResults();
@@ -1123,17 +1253,18 @@ bool GestureRecognitionPipeline::test(const TimeSeriesClassificationData &testDa
     testPrecision.resize(K, 0);
     testRecall.resize(K, 0);
     testFMeasure.resize(K, 0);
-    numTestSamples = testData.getNumSamples();
+    numTestSamples = sampleIndexs != NULL ? sampleIndexs->getSize() : testData.getNumSamples();
     
     //Start the test timer
     Timer timer;
     timer.start();
     
     //Run the test
-	const UINT M = testData.getNumSamples();
+	const UINT M = numTestSamples;
     for(UINT i=0; i<M; i++){
-        UINT classLabel = testData[i].getClassLabel();
-        MatrixFloat timeseries = testData[i].getData();
+        const TimeSeriesClassificationSample &sample = testData[ sampleIndexs != NULL ? (*sampleIndexs)[i] : i ];
+        UINT classLabel = sample.getClassLabel();
+        MatrixFloat timeseries = sample.getData();
             
         //Pass the test timeseries through the pipeline
         if( !predict_( timeseries ) ){
@@ -1266,6 +1397,10 @@ bool GestureRecognitionPipeline::test(const ClassificationDataStream &testData){
 }
     
 bool GestureRecognitionPipeline::test(const RegressionData &testData){
+    return testOnSubset( testData, NULL );
+}
+
+bool GestureRecognitionPipeline::testOnSubset(const RegressionData &testData,const Vector< UINT > *sampleIndexs){
     
     //Clear any previous test results
     clearTestResults();
@@ -1295,7 +1430,7 @@ bool GestureRecognitionPipeline::test(const RegressionData &testData){
     //Reset all the modules
     reset();
     
-    numTestSamples = testData.getNumSamples();
+    numTestSamples = sampleIndexs != NULL ? sampleIndexs->getSize() : testData.getNumSamples();
     testResults.resize( numTestSamples );
     
     //Start the test timer
@@ -1306,8 +1441,9 @@ bool GestureRecognitionPipeline::test(const RegressionData &testData){
     testSquaredError = 0;
     testRMSError = 0;
     for(UINT i=0; i<numTestSamples; i++){
-        VectorFloat inputVector = testData[i].getInputVector();
-        VectorFloat targetVector = testData[i].getTargetVector();
+        const RegressionSample &sample = testData[ sampleIndexs != NULL ? (*sampleIndexs)[i] : i ];
+        VectorFloat inputVector = sample.getInputVector();
+        VectorFloat targetVector = sample.getTargetVector();
         
         //Pass the test sample through the pipeline
         if( !map( inputVector ) ){
@@ -1332,7 +1468,7 @@ bool GestureRecognitionPipeline::test(const RegressionData &testData){
     }
     
     //Compute the test metrics
-    testRMSError = sqrt( testSquaredError / Float( testData.getNumSamples() ) );
+    testRMSError = sqrt( testSquaredError / Float( numTestSamples ) );
     
     testTime = timer.getMilliSeconds();
     
@@ -1401,15 +1537,18 @@ bool GestureRecognitionPipeline::predict_(MatrixFloat &input){
     //Perform any pre-processing
     if( getIsPreProcessingSet() ){
 
-        //Setup a temporary matrix and vector
+        //Setup a temporary matrix and a row buffer, these are reused for each module and row so the rows are not copied into new vectors
         VectorFloat tmpVector;
         MatrixFloat tmpMatrix;
         
         for(UINT moduleIndex=0; moduleIndex<preProcessingModules.getSize(); moduleIndex++){
-            MatrixFloat tmpMatrix( inputMatrix.getNumRows(), preProcessingModules[moduleIndex]->getNumOutputDimensions() );
+            const UINT numInputDimensions = inputMatrix.getNumCols();
+            tmpMatrix.resize( inputMatrix.getNumRows(), preProcessingModules[moduleIndex]->getNumOutputDimensions() );
+            tmpVector.resize( numInputDimensions );
             
             for(UINT i=0; i<inputMatrix.getNumRows(); i++){
-                if( !preProcessingModules[moduleIndex]->process( inputMatrix.getRow(i) ) ){
+                std::copy( inputMatrix[i], inputMatrix[i]+numInputDimensions, tmpVector.begin() );
+                if( !preProcessingModules[moduleIndex]->process( tmpVector ) ){
                     errorLog << __GRT_LOG__ << " Failed to PreProcess Input Matrix. PreProcessingModuleIndex: " << moduleIndex << std::endl;
                     return false;
                 }
@@ -1568,6 +1707,111 @@ bool GestureRecognitionPipeline::predict_(MatrixFloat &input){
 	return true;
 }
 
+bool GestureRecognitionPipeline::predictBatch(const MatrixFloat &inputData,MatrixFloat &classLikelihoods,Vector< UINT > &predictedClassLabels){
+    
+    //Make sure the classification model has been trained
+    if( !trained ){
+        errorLog << __GRT_LOG__ << " The classifier has not been trained!" << std::endl;
+        return false;
+    }
+    
+    if( !getIsClassifierSet() ){
+        errorLog << __GRT_LOG__ << " A classifier has not been set" << std::endl;
+        return false;
+    }
+    
+    //Make sure the dimensionality of the input data matches the inputVectorDimensions
+    if( inputData.getNumCols() != inputVectorDimensions ){
+        errorLog << __GRT_LOG__ << " The dimensionality of the input data (" << inputData.getNumCols() << ") does not match that of the input Vector dimensions of the pipeline (" << inputVectorDimensions << ")" << std::endl;
+        return false;
+    }
+    
+    const UINT M = inputData.getNumRows();
+    if( M == 0 ){
+        errorLog << __GRT_LOG__ << " The input data is empty!" << std::endl;
+        return false;
+    }
+    
+    //A context module can stop the prediction of a sample at any point in the pipeline, so each sample has to be run through the full pipeline
+    if( getIsContextSet() ){
+        const UINT K = classifier->getNumClasses();
+        classLikelihoods.resize( M, K );
+        predictedClassLabels.resize( M );
+        batchInputVector.resize( inputVectorDimensions );
+        for(UINT i=0; i<M; i++){
+            std::copy( inputData[i], inputData[i]+inputVectorDimensions, batchInputVector.begin() );
+            if( !predict_classifier( batchInputVector ) ){
+                errorLog << __GRT_LOG__ << " Failed to predict row " << i << std::endl;
+                return false;
+            }
+            predictedClassLabels[i] = predictedClassLabel;
+            const VectorFloat likelihoods = classifier->getClassLikelihoods();
+            for(UINT k=0; k<K; k++){
+                classLikelihoods[i][k] = k < likelihoods.getSize() ? likelihoods[k] : 0;
+            }
+        }
+        return true;
+    }
+    
+    //Pass each sample through the preprocessing and feature extraction modules. These modules can hold state (such as a filter or a window), so
+    //the samples are processed in order. Each module is given the output of the previous module directly, so no data is copied between them
+    predictionModuleIndex = START_OF_PIPELINE;
+    const MatrixFloat *features = &inputData;
+    if( getIsPreProcessingSet() || getIsFeatureExtractionSet() ){
+        const UINT numFeatures = classifier->getNumInputDimensions();
+        batchFeatures.resize( M, numFeatures );
+        batchInputVector.resize( inputVectorDimensions );
+        
+        for(UINT i=0; i<M; i++){
+            std::copy( inputData[i], inputData[i]+inputVectorDimensions, batchInputVector.begin() );
+            const VectorFloat *inputVector = &batchInputVector;
+            
+            for(UINT moduleIndex=0; moduleIndex<preProcessingModules.getSize(); moduleIndex++){
+                if( !preProcessingModules[moduleIndex]->process( *inputVector ) ){
+                    errorLog << __GRT_LOG__ << " Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << std::endl;
+                    return false;
+                }
+                inputVector = &preProcessingModules[moduleIndex]->getProcessedData();
+            }
+            
+            for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.getSize(); moduleIndex++){
+                if( !featureExtractionModules[moduleIndex]->computeFeatures( *inputVector ) ){
+                    errorLog << __GRT_LOG__ << " Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << std::endl;
+                    return false;
+                }
+                inputVector = &featureExtractionModules[moduleIndex]->getFeatureVector();
+            }
+            
+            if( inputVector->getSize() != numFeatures ){
+                errorLog << __GRT_LOG__ << " The size of the processed data (" << inputVector->getSize() << ") does not match the number of features of the classifier (" << numFeatures << ")" << std::endl;
+                return false;
+            }
+            std::copy( inputVector->begin(), inputVector->end(), batchFeatures[i] );
+        }
+        features = &batchFeatures;
+    }
+    
+    //Predict all the samples with the classifier at once, so classifiers with a batch implementation can share the work between the samples
+    predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
+    if( !classifier->predictBatch( *features, classLikelihoods, predictedClassLabels ) ){
+        errorLog << __GRT_LOG__ << " Prediction Failed! " << classifier->getLastErrorMessage() << std::endl;
+        return false;
+    }
+    
+    //Post process the predicted class labels in order, as the post processing modules depend on the previous predictions
+    predictionModuleIndex = AFTER_CLASSIFIER;
+    if( getIsPostProcessingSet() ){
+        for(UINT i=0; i<M; i++){
+            if( !postProcessClassLabel( predictedClassLabels[i] ) ){
+                return false;
+            }
+        }
+    }
+    
+    predictionModuleIndex = END_OF_PIPELINE;
+    return true;
+}
+
 bool GestureRecognitionPipeline::map_(VectorFloat &inputVector){
 	return predict_regressifier( inputVector );
 }
@@ -1671,53 +1915,9 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
     //Perform any post processing
     predictionModuleIndex = AFTER_CLASSIFIER;
     if( getIsPostProcessingSet() ){
-        
-        if( pipelineMode != CLASSIFICATION_MODE){
-            errorLog << __GRT_LOG__ << " Pipeline Mode Is Not in CLASSIFICATION_MODE!" << std::endl;
+        if( !postProcessClassLabel( predictedClassLabel ) ){
             return false;
         }
-        
-        VectorFloat data;
-        for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
-            
-            //Select which input we should give the postprocessing module
-            if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
-                //Set the input
-                data.resize(1);
-                data[0] = predictedClassLabel;
-                
-                //Verify that the input size is OK
-                if( data.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
-                    errorLog << __GRT_LOG__ << " The size of the data Vector (" << int(data.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << std::endl;
-                    return false;
-                }
-                
-                //Postprocess the data
-                if( !postProcessingModules[moduleIndex]->process( data ) ){
-                    errorLog << __GRT_LOG__ << " Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << std::endl;
-                    return false;
-                }
-                
-                //Select which output we should update
-                data = postProcessingModules[moduleIndex]->getProcessedData();  
-            }
-            
-            //Select which output we should update
-            if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
-                //Get the processed predicted class label
-                data = postProcessingModules[moduleIndex]->getProcessedData(); 
-                
-                //Verify that the output size is OK
-                if( data.size() != 1 ){
-                    errorLog << __GRT_LOG__ << " The size of the processed data Vector (" << int(data.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << std::endl;
-                    return false;
-                }
-                
-                //Update the predicted class label
-                predictedClassLabel = (UINT)data[0];
-            }
-                  
-        }
     } 
     
     //Update the context module
@@ -1739,6 +1939,58 @@ bool GestureRecognitionPipeline::predict_classifier(const VectorFloat &input){
     return true;
 }
     
+bool GestureRecognitionPipeline::postProcessClassLabel(UINT &classLabel){
+    
+    if( pipelineMode != CLASSIFICATION_MODE){
+        errorLog << __GRT_LOG__ << " Pipeline Mode Is Not in CLASSIFICATION_MODE!" << std::endl;
+        return false;
+    }
+    
+    VectorFloat data;
+    for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+        
+        //Select which input we should give the postprocessing module
+        if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
+            //Set the input
+            data.resize(1);
+            data[0] = classLabel;
+            
+            //Verify that the input size is OK
+            if( data.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
+                errorLog << __GRT_LOG__ << " The size of the data Vector (" << int(data.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << std::endl;
+                return false;
+            }
+            
+            //Postprocess the data
+            if( !postProcessingModules[moduleIndex]->process( data ) ){
+                errorLog << __GRT_LOG__ << " Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << std::endl;
+                return false;
+            }
+            
+            //Select which output we should update
+            data = postProcessingModules[moduleIndex]->getProcessedData();  
+        }
+        
+        //Select which output we should update
+        if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
+            //Get the processed predicted class label
+            data = postProcessingModules[moduleIndex]->getProcessedData(); 
+            
+            //Verify that the output size is OK
+            if( data.size() != 1 ){
+                errorLog << __GRT_LOG__ << " The size of the processed data Vector (" << int(data.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << std::endl;
+                return false;
+            }
+            
+            //Update the predicted class label
+            classLabel = (UINT)data[0];
+        }
+              
+    }
+    
+    return true;
+}
+
 bool GestureRecognitionPipeline::predict_regressifier(const VectorFloat &input){
     
 	VectorFloat inputVector = input;
@@ -134,6 +134,25 @@ public:
     */
     virtual bool train_(ClassificationData &trainingData) override;
 
+    /**
+     This is the main training interface for training a Classifier with a const reference to ClassificationData.  The training data is passed through
+     the pipeline in the same way as train_(ClassificationData &trainingData), the pipeline does not modify the training data so it is not copied.
+
+    @param trainingData: the classification data that will be used to train the classifier at the core of the pipeline
+    @return bool returns true if the classifier was trained successfully, false otherwise
+    */
+    virtual bool train(const ClassificationData &trainingData) override;
+
+    /**
+     This is the main training interface for training a Classifier with a view of ClassificationData, such as a cross validation fold.  The samples in the view are
+     passed through any PreProcessing or FeatureExtraction modules in the same way as train_(ClassificationData &trainingData), if there are no PreProcessing or
+     FeatureExtraction modules then the view is passed directly to the Classification module without copying the samples.
+
+    @param trainingData: a view of the classification data that will be used to train the classifier at the core of the pipeline
+    @return bool returns true if the classifier was trained successfully, false otherwise
+    */
+    virtual bool train_(ClassificationDataView &trainingData) override;
+
     /**
      This is the main training interface for training a Classifier with ClassificationData using K-fold cross validation.  This function calls train_(...), so if you
      want to use a more efficient version of the algorithm (and don't care that your training data may get modified) then call train_(...) directly.
@@ -151,6 +170,9 @@ public:
      training function of the Classification module that has been added to the GestureRecognitionPipeline.  
      The function will return true if the classifier was trained successfully, false otherwise.
 
+     Each fold is trained and tested on its own copy of the pipeline, so the folds are run in parallel using the ThreadPool. The results are combined
+     in fold order, and the pipeline keeps the model trained on the last fold.
+
     @param trainingData: the labeled classification training data that will be used to train the classifier at the core of the pipeline
     @param kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples int the LabelledClassificationData
     @param useStratifiedSampling: sets if stratified sampling should be used during the cross validation training
@@ -169,6 +191,15 @@ public:
     */
     virtual bool train_(TimeSeriesClassificationData &trainingData) override;
 
+    /**
+     This is the main training interface for training a Classifier with a const reference to TimeSeriesClassificationData.  The training data is passed through
+     the pipeline in the same way as train_(TimeSeriesClassificationData &trainingData), the pipeline does not modify the training data so it is not copied.
+
+    @param trainingData: the time-series classification training data that will be used to train the classifier at the core of the pipeline
+    @return bool returns true if the classifier was trained successfully, false otherwise
+    */
+    virtual bool train(const TimeSeriesClassificationData &trainingData) override;
+
     /**
      This is the main training interface for training a Classifier with TimeSeriesClassificationData using K-fold cross validation. This function calls train_(...), so if you
      want to use a more efficient version of the algorithm (and don't care that your training data may get modified) then call train_(...) directly.
@@ -185,6 +216,9 @@ public:
      This function will pass the trainingData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the training function of the Classification module that has been added to the GestureRecognitionPipeline.
      The function will return true if the classifier was trained successfully, false otherwise.
      
+     Each fold is trained and tested on its own copy of the pipeline, so the folds are run in parallel using the ThreadPool. The results are combined
+     in fold order, and the pipeline keeps the model trained on the last fold.
+     
      @param trainingData: the labelled time-series classification training data that will be used to train the classifier at the core of the pipeline
      @param kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples in the LabelledClassificationData
      @param useStratifiedSampling: sets if stratified sampling should be used during the cross validation training
@@ -213,6 +247,15 @@ public:
     @return bool returns true if the regression module was trained successfully, false otherwise
     */
     virtual bool train_(RegressionData &trainingData) override;
+
+    /**
+     This is the main training interface for training a regression module with a const reference to RegressionData.  The training data is passed through
+     the pipeline in the same way as train_(RegressionData &trainingData), the pipeline does not modify the training data so it is not copied.
+
+    @param trainingData: the labelled regression training data that will be used to train the regression module at the core of the pipeline
+    @return bool returns true if the regression module was trained successfully, false otherwise
+    */
+    virtual bool train(const RegressionData &trainingData) override;
     
     /**
      This is the main training interface for training a regression module with a regression training and validation dataset.  This function will pass
@@ -241,6 +284,9 @@ public:
      the trainingData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the
      training function of the Regression module that has been added to the GestureRecognitionPipeline.
      The function will return true if the regressifier was trained successfully, false otherwise.
+
+     Each fold is trained and tested on its own copy of the pipeline, so the folds are run in parallel using the ThreadPool. The results are combined
+     in fold order, and the pipeline keeps the model trained on the last fold.
      
      @param trainingData: the regression training data that will be used to train the regressifier at the core of the pipeline
      @param kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples in the LabelledRegressionData
@@ -321,6 +367,23 @@ public:
      */
     virtual bool predict_(MatrixFloat &inputMatrix) override;
 
+    /**
+     This function classifies many samples at once, each row of the input data is a sample. The rows are treated as consecutive samples
+     of one stream, so the results are the same as calling predict with each row in order. The rows are passed through any PreProcessing
+     and FeatureExtraction modules in order using reused buffers, and then all the rows are given to the predictBatch function of the
+     classifier, which lets classifiers such as KNN and RandomForests share work between the rows. To score independent streams, use a
+     copy of the pipeline for each stream.
+
+     If any Context modules have been added then each row is run through the full pipeline, as a context module can stop any prediction.
+     The results are returned in the classLikelihoods and predictedClassLabels, the last prediction of the pipeline is not updated.
+
+     @param inputData: the input data to classify, each row is a sample and the number of columns must match the input dimensions of the pipeline
+     @param classLikelihoods: returns the class likelihoods of each row, this will be resized to [inputData.getNumRows() numClasses]
+     @param predictedClassLabels: returns the predicted class label of each row after any post processing, this will be resized to inputData.getNumRows()
+     @return bool returns true if the prediction was successful, false otherwise
+     */
+    bool predictBatch(const MatrixFloat &inputData,MatrixFloat &classLikelihoods,Vector< UINT > &predictedClassLabels);
+
     /**
      @deprecated use predict_(VectorFloat &inputVector)
      This function is now depreciated, you should use the predict_(VectorFloat &inputVector) function instead.
@@ -1385,6 +1448,7 @@ protected:
     bool predict_frame( const MatrixFloat &input );
     bool predict_regressifier(const VectorFloat &inputVector);
     bool predict_clusterer(const VectorFloat &inputVector);
+    bool postProcessClassLabel(UINT &classLabel);
     void deleteAllPreProcessingModules();
     void deleteAllFeatureExtractionModules();
     void deleteClassifier();
@@ -1395,6 +1459,15 @@ protected:
     bool updateTestMetrics(const UINT classLabel,const UINT predictedClassLabel,VectorFloat &precisionCounter,VectorFloat &recallCounter,Float &rejectionPrecisionCounter,Float &rejectionRecallCounter,VectorFloat &confusionMatrixCounter);
     bool computeTestMetrics(VectorFloat &precisionCounter,VectorFloat &recallCounter,Float &rejectionPrecisionCounter,Float &rejectionRecallCounter,VectorFloat &confusionMatrixCounter,const UINT numTestSamples);
     
+    //The subset functions train or test the pipeline with the samples at the given indexs, which avoids copying the data for each
+    //cross validation fold. If sampleIndexs is NULL then all the samples are used
+    bool trainOnSubset(const ClassificationData &trainingData,const Vector< UINT > *sampleIndexs);
+    bool trainOnSubset(const TimeSeriesClassificationData &trainingData,const Vector< UINT > *sampleIndexs);
+    bool trainOnSubset(const RegressionData &trainingData,const Vector< UINT > *sampleIndexs);
+    bool testOnSubset(const ClassificationData &testData,const Vector< UINT > *sampleIndexs);
+    bool testOnSubset(const TimeSeriesClassificationData &testData,const Vector< UINT > *sampleIndexs);
+    bool testOnSubset(const RegressionData &testData,const Vector< UINT > *sampleIndexs);
+    
     bool initialized;
     std::string info;
     UINT inputVectorDimensions;
@@ -1419,6 +1492,8 @@ protected:
     MatrixFloat testConfusionMatrix;
     Vector< TestResult > crossValidationResults;
     Vector< TestInstanceResult > testResults;
+    VectorFloat batchInputVector;           ///< A buffer used by predictBatch to pass each row through the pipeline
+    MatrixFloat batchFeatures;              ///< A buffer used by predictBatch to store the features of each row for the classifier
     
     Vector< PreProcessing* > preProcessingModules;
     Vector< FeatureExtraction* > featureExtractionModules;
@@ -104,43 +104,123 @@ bool MLBase::copyMLBaseVariables(const MLBase *mlBase){
     return true;
 }
 
-bool MLBase::train(ClassificationData trainingData){ return train_( trainingData ); }
+bool MLBase::train(const ClassificationData &trainingData){
+    //Pass a view of the data, so algorithms that can be trained from a view do not need a copy of the data
+    ClassificationDataView view( trainingData );
+    return train_( view );
+}
+
+bool MLBase::train(ClassificationData &&trainingData){ return train_( trainingData ); }
 
 bool MLBase::train_(ClassificationData &trainingData){ return false; }
 
-bool MLBase::train(RegressionData trainingData){ return train_( trainingData ); }
+bool MLBase::train(ClassificationDataView trainingData){ return train_( trainingData ); }
+
+bool MLBase::train_(ClassificationDataView &trainingData){
+    //If the view covers the whole dataset then copy the dataset directly, so the copy keeps the name and class order of the dataset
+    if( trainingData.getIsWholeDataset() ){
+        ClassificationData data( trainingData.getDataset() );
+        return train_( data );
+    }
+    ClassificationData data = trainingData.getClassificationData();
+    return train_( data );
+}
+
+bool MLBase::train(const RegressionData &trainingData){
+    RegressionData data( trainingData );
+    return train_( data );
+}
+
+bool MLBase::train(RegressionData &&trainingData){ return train_( trainingData ); }
 
 bool MLBase::train_(RegressionData &trainingData){ return false; }
 
-bool MLBase::train(RegressionData trainingData,RegressionData validationData){ return train_( trainingData, validationData ); }
+bool MLBase::train(const RegressionData &trainingData,const RegressionData &validationData){
+    RegressionData trainingDataCopy( trainingData );
+    RegressionData validationDataCopy( validationData );
+    return train_( trainingDataCopy, validationDataCopy );
+}
+
+bool MLBase::train(RegressionData &&trainingData,RegressionData &&validationData){ return train_( trainingData, validationData ); }
 
 bool MLBase::train_(RegressionData &trainingData,RegressionData &validationData){ return false; }
 
-bool MLBase::train(TimeSeriesClassificationData trainingData){ return train_( trainingData ); }
+bool MLBase::train(const TimeSeriesClassificationData &trainingData){
+    TimeSeriesClassificationData data( trainingData );
+    return train_( data );
+}
+
+bool MLBase::train(TimeSeriesClassificationData &&trainingData){ return train_( trainingData ); }
 
 bool MLBase::train_(TimeSeriesClassificationData &trainingData){ return false; }
 
-bool MLBase::train(ClassificationDataStream trainingData){ return train_( trainingData ); }
+bool MLBase::train(const ClassificationDataStream &trainingData){
+    ClassificationDataStream data( trainingData );
+    return train_( data );
+}
+
+bool MLBase::train(ClassificationDataStream &&trainingData){ return train_( trainingData ); }
 
 bool MLBase::train_(ClassificationDataStream &trainingData){ return false; }
 
-bool MLBase::train(UnlabelledData trainingData){ return train_( trainingData ); }
+bool MLBase::train(const UnlabelledData &trainingData){
+    UnlabelledData data( trainingData );
+    return train_( data );
+}
+
+bool MLBase::train(UnlabelledData &&trainingData){ return train_( trainingData ); }
 
 bool MLBase::train_(UnlabelledData &trainingData){ return false; }
 
-bool MLBase::train(MatrixFloat data){ return train_( data ); }
+bool MLBase::train(const MatrixFloat &data){
+    MatrixFloat dataCopy( data );
+    return train_( dataCopy );
+}
+
+bool MLBase::train(MatrixFloat &&data){ return train_( data ); }
 
 bool MLBase::train_(MatrixFloat &data){ return false; }
 
-bool MLBase::predict(VectorFloat inputVector){ return predict_( inputVector ); }
+bool MLBase::train(ChunkedDataset &trainingData){ return train_( trainingData ); }
+
+bool MLBase::train_(ChunkedDataset &trainingData){
+    errorLog << "train_(ChunkedDataset &trainingData) - This algorithm does not support training from a ChunkedDataset!" << std::endl;
+    return false;
+}
+
+bool MLBase::predict(const VectorFloat &inputVector){
+    //Copy the input into the buffer, which only allocates memory if the size of the input changes
+    inputVectorBuffer = inputVector;
+    return predict_( inputVectorBuffer );
+}
+
+bool MLBase::predict(VectorFloat &&inputVector){ return predict_( inputVector ); }
 
 bool MLBase::predict_(VectorFloat &inputVector){ return false; }
 
-bool MLBase::predict(MatrixFloat inputMatrix){ return predict_( inputMatrix ); }
+bool MLBase::predict(const MatrixFloat &inputMatrix){
+    //Copy the input into the buffer, which only allocates memory if the size of the input changes
+    if( inputMatrixBuffer.getNumRows() != inputMatrix.getNumRows() || inputMatrixBuffer.getNumCols() != inputMatrix.getNumCols() ){
+        if( !inputMatrixBuffer.resize( inputMatrix.getNumRows(), inputMatrix.getNumCols() ) ){
+            errorLog << "predict(const MatrixFloat &inputMatrix) - Failed to resize the input buffer!" << std::endl;
+            return false;
+        }
+    }
+    inputMatrixBuffer.copy( inputMatrix );
+    return predict_( inputMatrixBuffer );
+}
+
+bool MLBase::predict(MatrixFloat &&inputMatrix){ return predict_( inputMatrix ); }
 
 bool MLBase::predict_(MatrixFloat &inputMatrix){ return false; }
 
-bool MLBase::map(VectorFloat inputVector){ return map_( inputVector ); }
+bool MLBase::map(const VectorFloat &inputVector){
+    //Copy the input into the buffer, which only allocates memory if the size of the input changes
+    inputVectorBuffer = inputVector;
+    return map_( inputVectorBuffer );
+}
+
+bool MLBase::map(VectorFloat &&inputVector){ return map_( inputVector ); }
 
 bool MLBase::map_(VectorFloat &inputVector){ return false; }
 
@@ -386,6 +466,10 @@ bool MLBase::setRandomiseTrainingOrder(const bool randomiseTrainingOrder){
     return true;
 }
 
+bool MLBase::setRandomSeed(const unsigned long long seed){
+    return random.setSeed( seed );
+}
+
 bool MLBase::setTrainingLoggingEnabled(const bool loggingEnabled){
     return this->trainingLog.setInstanceLoggingEnabled( loggingEnabled );
 }
@@ -31,9 +31,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Util/Metrics.h"
 #include "../DataStructures/UnlabelledData.h"
 #include "../DataStructures/ClassificationData.h"
+#include "../DataStructures/ClassificationDataView.h"
 #include "../DataStructures/ClassificationDataStream.h"
 #include "../DataStructures/RegressionData.h"
 #include "../DataStructures/TimeSeriesClassificationData.h"
+#include "../DataStructures/ChunkedDataset.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -96,12 +98,22 @@ public:
     
     /**
     This is the main training interface for ClassificationData.
-    By default it will call the train_ function, unless it is overwritten by the derived class.
+    By default it will pass a view of the training data to the train_(ClassificationDataView &trainingData) function, so the data is only copied
+    if the derived class can not be trained from a view.  Use train(ClassificationData &&trainingData) to avoid the copy if you no longer need the data.
+    
+    @param trainingData: a const reference to the training data that will be used to train the ML model
+    @return returns true if the classifier was successfully trained, false otherwise
+    */
+    virtual bool train(const ClassificationData &trainingData);
+    
+    /**
+    This is the main training interface for ClassificationData that is no longer needed by the caller, such as a temporary dataset.
+    By default it will call the train_ function without copying the data, so the data may be modified (for example scaled) by the training algorithm.
     
-    @param trainingData: the training data that will be used to train the ML model
+    @param trainingData: an rvalue reference to the training data that will be used to train the ML model
     @return returns true if the classifier was successfully trained, false otherwise
     */
-    virtual bool train(ClassificationData trainingData);
+    virtual bool train(ClassificationData &&trainingData);
     
     /**
     This is the main training interface for referenced ClassificationData. This should be overwritten by the derived class.
@@ -110,15 +122,43 @@ public:
     @return returns true if the classifier was successfully trained, false otherwise
     */
     virtual bool train_(ClassificationData &trainingData);
+
+    /**
+    This is the main training interface for a ClassificationDataView, such as a cross validation fold or a bootstrapped subset of a dataset.
+    By default it will call the train_ function, unless it is overwritten by the derived class.
+
+    @param trainingData: a view of the training data that will be used to train the ML model
+    @return returns true if the classifier was successfully trained, false otherwise
+    */
+    virtual bool train(ClassificationDataView trainingData);
+
+    /**
+    This is the main training interface for a referenced ClassificationDataView. This should be overwritten by any derived class that can be trained
+    without modifying its training data. By default the samples in the view are copied into a new ClassificationData, which is passed to train_(ClassificationData &trainingData).
+    ANBC, KNN, GMM, MinDist, DecisionTree, RandomForests, SVM, Softmax and the GestureRecognitionPipeline override this, all other classifiers still copy the view.
+
+    @param trainingData: a reference to a view of the training data that will be used to train the ML model
+    @return returns true if the classifier was successfully trained, false otherwise
+    */
+    virtual bool train_(ClassificationDataView &trainingData);
     
     /**
     This is the main training interface for regression data.
-    By default it will call the train_ function, unless it is overwritten by the derived class.
+    The training data is copied before it is passed to the train_ function, use train(RegressionData &&trainingData) to avoid the copy if you no longer need the data.
     
-    @param trainingData: the training data that will be used to train a new regression model
+    @param trainingData: a const reference to the training data that will be used to train the ML model
     @return returns true if a new regression model was trained, false otherwise
     */
-    virtual bool train(RegressionData trainingData);
+    virtual bool train(const RegressionData &trainingData);
+    
+    /**
+    This is the main training interface for regression data that is no longer needed by the caller, such as a temporary dataset.
+    The training data is passed to the train_ function without being copied, so the data may be modified (for example scaled) by the training algorithm.
+    
+    @param trainingData: an rvalue reference to the training data that will be used to train the ML model
+    @return returns true if a new regression model was trained, false otherwise
+    */
+    virtual bool train(RegressionData &&trainingData);
     
     /**
     This is the main training interface for all the regression algorithms. This should be overwritten by the derived class.
@@ -132,11 +172,23 @@ public:
     This is the main training interface for training a regression model using a training and validation dataset. This should be overwritten by the derived class.
     By default it will call the train_ function, unless it is overwritten by the derived class.
     
+    The training and validation data are copied before they are passed to the train_ function.
+    
     @param trainingData: the training data that will be used to train a new regression model
     @param validationData: the validation data that will be used to validate the regression model
     @return returns true if a new regression model was trained, false otherwise
     */
-    virtual bool train(RegressionData trainingData,RegressionData validationData);
+    virtual bool train(const RegressionData &trainingData,const RegressionData &validationData);
+    
+    /**
+    This is the main training interface for training a regression model using a training and validation dataset that are no longer needed by the caller.
+    The training and validation data are passed to the train_ function without being copied.
+    
+    @param trainingData: an rvalue reference to the training data that will be used to train a new regression model
+    @param validationData: an rvalue reference to the validation data that will be used to validate the regression model
+    @return returns true if a new regression model was trained, false otherwise
+    */
+    virtual bool train(RegressionData &&trainingData,RegressionData &&validationData);
     
     /**
     This is the main training interface for training a regression model using a training and validation dataset. This should be overwritten by the derived class.
@@ -149,12 +201,21 @@ public:
     
     /**
     This is the main training interface for TimeSeriesClassificationData.
-    By default it will call the train_ function, unless it is overwritten by the derived class.
+    The training data is copied before it is passed to the train_ function, use train(TimeSeriesClassificationData &&trainingData) to avoid the copy if you no longer need the data.
     
-    @param trainingData: the training data that will be used to train the ML model
+    @param trainingData: a const reference to the training data that will be used to train the ML model
     @return returns true if the classifier was successfully trained, false otherwise
     */
-    virtual bool train(TimeSeriesClassificationData trainingData);
+    virtual bool train(const TimeSeriesClassificationData &trainingData);
+    
+    /**
+    This is the main training interface for TimeSeriesClassificationData that is no longer needed by the caller, such as a temporary dataset.
+    The training data is passed to the train_ function without being copied, so the data may be modified (for example scaled) by the training algorithm.
+    
+    @param trainingData: an rvalue reference to the training data that will be used to train the ML model
+    @return returns true if the classifier was successfully trained, false otherwise
+    */
+    virtual bool train(TimeSeriesClassificationData &&trainingData);
     
     /**
     This is the main training interface for referenced TimeSeriesClassificationData. This should be overwritten by the derived class.
@@ -166,12 +227,21 @@ public:
     
     /**
     This is the main training interface for ClassificationDataStream.
-    By default it will call the train_ function, unless it is overwritten by the derived class.
+    The training data is copied before it is passed to the train_ function, use train(ClassificationDataStream &&trainingData) to avoid the copy if you no longer need the data.
+    
+    @param trainingData: a const reference to the training data that will be used to train the ML model
+    @return returns true if the classifier was successfully trained, false otherwise
+    */
+    virtual bool train(const ClassificationDataStream &trainingData);
+    
+    /**
+    This is the main training interface for ClassificationDataStream that is no longer needed by the caller, such as a temporary dataset.
+    The training data is passed to the train_ function without being copied, so the data may be modified (for example scaled) by the training algorithm.
     
-    @param trainingData: the training data that will be used to train the ML model
+    @param trainingData: an rvalue reference to the training data that will be used to train the ML model
     @return returns true if the classifier was successfully trained, false otherwise
     */
-    virtual bool train(ClassificationDataStream trainingData);
+    virtual bool train(ClassificationDataStream &&trainingData);
     
     /**
     This is the main training interface for referenced ClassificationDataStream. This should be overwritten by the derived class.
@@ -183,12 +253,21 @@ public:
     
     /**
     This is the main training interface for UnlabelledData.
-    By default it will call the train_ function, unless it is overwritten by the derived class.
+    The training data is copied before it is passed to the train_ function, use train(UnlabelledData &&trainingData) to avoid the copy if you no longer need the data.
     
-    @param trainingData: the training data that will be used to train the ML model
+    @param trainingData: a const reference to the training data that will be used to train the ML model
     @return returns true if the classifier was successfully trained, false otherwise
     */
-    virtual bool train(UnlabelledData trainingData);
+    virtual bool train(const UnlabelledData &trainingData);
+    
+    /**
+    This is the main training interface for UnlabelledData that is no longer needed by the caller, such as a temporary dataset.
+    The training data is passed to the train_ function without being copied, so the data may be modified (for example scaled) by the training algorithm.
+    
+    @param trainingData: an rvalue reference to the training data that will be used to train the ML model
+    @return returns true if the classifier was successfully trained, false otherwise
+    */
+    virtual bool train(UnlabelledData &&trainingData);
     
     /**
     This is the main training interface for referenced UnlabelledData. This should be overwritten by the derived class.
@@ -200,12 +279,21 @@ public:
     
     /**
     This is the main training interface for MatrixFloat data.
-    By default it will call the train_ function, unless it is overwritten by the derived class.
+    The training data is copied before it is passed to the train_ function, use train(MatrixFloat &&trainingData) to avoid the copy if you no longer need the data.
     
-    @param trainingData: the training data that will be used to train the ML model
+    @param data: a const reference to the training data that will be used to train the ML model
     @return returns true if the classifier was successfully trained, false otherwise
     */
-    virtual bool train(MatrixFloat data);
+    virtual bool train(const MatrixFloat &data);
+    
+    /**
+    This is the main training interface for MatrixFloat data that is no longer needed by the caller, such as a temporary matrix.
+    The training data is passed to the train_ function without being copied, so the data may be modified (for example scaled) by the training algorithm.
+    
+    @param data: an rvalue reference to the training data that will be used to train the ML model
+    @return returns true if the classifier was successfully trained, false otherwise
+    */
+    virtual bool train(MatrixFloat &&data);
     
     /**
     This is the main training interface for referenced MatrixFloat data. This should be overwritten by the derived class.
@@ -214,15 +302,41 @@ public:
     @return returns true if the classifier was successfully trained, false otherwise
     */
     virtual bool train_(MatrixFloat &data);
+
+    /**
+    This is the main training interface for a ChunkedDataset, which serves data that is too large to fit in memory from disk one chunk at a time.
+    By default it will call the train_ function, unless it is overwritten by the derived class.
+
+    @param trainingData: a reference to the chunked dataset that will be used to train the ML model
+    @return returns true if the model was successfully trained, false otherwise
+    */
+    virtual bool train(ChunkedDataset &trainingData);
+
+    /**
+    This is the main training interface for a ChunkedDataset. This should be overwritten by any derived class that can be trained with mini-batches.
+
+    @param trainingData: a reference to the chunked dataset that will be used to train the ML model
+    @return returns true if the model was successfully trained, false otherwise (the base class always returns false)
+    */
+    virtual bool train_(ChunkedDataset &trainingData);
     
     /**
     This is the main prediction interface for all the GRT machine learning algorithms.
-    By defaut it will call the predict_ function, unless it is overwritten by the derived class.
+    By defaut it will copy the input vector into a buffer that is reused between predictions and call the predict_ function, unless it is overwritten by the derived class.
+    
+    @param inputVector: a const reference to the new input vector for prediction
+    @return returns true if the prediction was completed succesfully, false otherwise (the base class always returns false)
+    */
+    virtual bool predict(const VectorFloat &inputVector);
+    
+    /**
+    This is the main prediction interface for an input vector that is no longer needed by the caller, such as a temporary vector.
+    By defaut it will call the predict_ function without copying the input vector, unless it is overwritten by the derived class.
     
-    @param inputVector: the new input vector for prediction
+    @param inputVector: an rvalue reference to the new input vector for prediction
     @return returns true if the prediction was completed succesfully, false otherwise (the base class always returns false)
     */
-    virtual bool predict(VectorFloat inputVector);
+    virtual bool predict(VectorFloat &&inputVector);
     
     /**
     This is the main prediction interface for all the GRT machine learning algorithms. This should be overwritten by the derived class.
@@ -234,12 +348,21 @@ public:
     
     /**
     This is the prediction interface for time series data.
-    By defaut it will call the predict_ function, unless it is overwritten by the derived class.
+    By defaut it will copy the input matrix into a buffer that is reused between predictions and call the predict_ function, unless it is overwritten by the derived class.
+    
+    @param inputMatrix: a const reference to the new input matrix for prediction
+    @return returns true if the prediction was completed succesfully, false otherwise (the base class always returns false)
+    */
+    virtual bool predict(const MatrixFloat &inputMatrix);
+    
+    /**
+    This is the prediction interface for time series data that is no longer needed by the caller, such as a temporary matrix.
+    By defaut it will call the predict_ function without copying the input matrix, unless it is overwritten by the derived class.
     
-    @param inputMatrix: the new input matrix for prediction
+    @param inputMatrix: an rvalue reference to the new input matrix for prediction
     @return returns true if the prediction was completed succesfully, false otherwise (the base class always returns false)
     */
-    virtual bool predict(MatrixFloat inputMatrix);
+    virtual bool predict(MatrixFloat &&inputMatrix);
     
     /**
     This is the prediction interface for time series data. This should be overwritten by the derived class.
@@ -251,12 +374,21 @@ public:
     
     /**
     This is the main mapping interface for all the GRT machine learning algorithms.
-    By defaut it will call the map_ function, unless it is overwritten by the derived class.
+    By defaut it will copy the input vector into a buffer that is reused between calls and call the map_ function, unless it is overwritten by the derived class.
+    
+    @param inputVector: a const reference to the input vector for mapping/regression
+    @return returns true if the mapping was completed succesfully, false otherwise (the base class always returns false)
+    */
+    virtual bool map(const VectorFloat &inputVector);
+    
+    /**
+    This is the main mapping interface for an input vector that is no longer needed by the caller, such as a temporary vector.
+    By defaut it will call the map_ function without copying the input vector, unless it is overwritten by the derived class.
     
-    @param inputVector: the input vector for mapping/regression
+    @param inputVector: an rvalue reference to the input vector for mapping/regression
     @return returns true if the mapping was completed succesfully, false otherwise (the base class always returns false)
     */
-    virtual bool map(VectorFloat inputVector);
+    virtual bool map(VectorFloat &&inputVector);
     
     /**
     This is the main mapping interface by reference for all the GRT machine learning algorithms. This should be overwritten by the derived class.
@@ -462,7 +594,7 @@ public:
     
     @return returns the minimum change value
     */
-//    Float getMinChange() const;
+    Float getMinChange() const;
     
     /**
     Gets the current learningRate value, this is value used to update the weights at each step of a learning algorithm such as stochastic gradient descent.
@@ -538,7 +670,7 @@ public:
     
     @return returns true if the order of the training dataset should be randomized, false otherwise
     */
-//    bool getRandomiseTrainingOrder() const;
+    bool getRandomiseTrainingOrder() const;
     
     /**
     Gets if the model for the derived class has been succesfully trained.
@@ -693,6 +825,15 @@ public:
     */
     bool setRandomiseTrainingOrder(const bool randomiseTrainingOrder);
     
+    /**
+    Sets the seed of the random number generator used by this ML instance during training.
+    Setting the same seed before training makes the training process repeatable, if the seed is zero then the current system time will be used.
+    
+    @param seed: the new random seed
+    @return returns true if the seed was updated, false otherwise
+    */
+    bool setRandomSeed(const unsigned long long seed);
+    
     /**
     Sets if training logging is enabled/disabled for this specific ML instance.
     If you want to enable/disable training logging globally, then you should use the TrainingLog::enableLogging( bool ) function.
@@ -840,6 +981,8 @@ protected:
     TestResultsObserverManager testResultsObserverManager;
     TrainingLog trainingLog;
     TestingLog testingLog;
+    VectorFloat inputVectorBuffer;      ///< Reused by predict(const VectorFloat&) and map(const VectorFloat&), so predictions do not allocate a new vector
+    MatrixFloat inputMatrixBuffer;      ///< Reused by predict(const MatrixFloat&), so predictions do not allocate a new matrix
     
 };
 
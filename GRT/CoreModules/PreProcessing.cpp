@@ -170,7 +170,7 @@ bool PreProcessing::getInitialized() const{
     return initialized; 
 }
     
-VectorFloat PreProcessing::getProcessedData() const{ 
+const VectorFloat& PreProcessing::getProcessedData() const{ 
     return processedData; 
 }
 
@@ -96,9 +96,9 @@ public:
     bool getInitialized() const;
 
     /**
-     @return returns a VectorFloat containing the most recent processed data
+     @return returns a reference to the VectorFloat containing the most recent processed data
      */
-	VectorFloat getProcessedData() const;
+	const VectorFloat& getProcessedData() const;
     
     /**
      This typedef defines a map between a string and a PreProcessing pointer.
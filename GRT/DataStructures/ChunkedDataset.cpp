@@ -0,0 +1,436 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "ChunkedDataset.h"
+
+GRT_BEGIN_NAMESPACE
+
+ChunkedDataset::ChunkedDataset(const UINT chunkSize,const bool useShuffle) :
+#ifdef GRT_CXX11_ENABLED
+loader(1),
+#endif
+errorLog("[ERROR ChunkedDataset]"),warningLog("[WARNING ChunkedDataset]")
+{
+    this->chunkSize = chunkSize > 0 ? chunkSize : 1;
+    this->useShuffle = useShuffle;
+    dataType = UNKNOWN_DATA;
+    numSamples = 0;
+    numInputDimensions = 0;
+    numTargetDimensions = 0;
+    floatSize = 0;
+    inputBlockOffset = 0;
+    targetBlockOffset = 0;
+    rangesComputed = false;
+    epochStarted = false;
+    epochPosition = 0;
+    currentBuffer = 0;
+    loadingBuffer = 0;
+    loadingChunk = false;
+    loadResult = false;
+}
+
+ChunkedDataset::~ChunkedDataset(){
+    close();
+}
+
+bool ChunkedDataset::open(const std::string &filename){
+
+    close();
+
+    if( !file.openForReading( filename, "" ) ){
+        errorLog << "open(const std::string &filename) - Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    const std::string type = file.getDatasetType();
+    if( type == "ClassificationData" ) dataType = CLASSIFICATION_DATA;
+    else if( type == "RegressionData" ) dataType = REGRESSION_DATA;
+    else{
+        errorLog << "open(const std::string &filename) - Unsupported dataset type: " << type << std::endl;
+        close();
+        return false;
+    }
+
+    //The header layout matches ClassificationData::saveDatasetToBinaryFile and RegressionData::saveDatasetToBinaryFile
+    UINT useRanges = 0;
+    UINT numClasses = 0;
+    unsigned long long totalNumSamples = 0;
+    bool ok = file.readString( datasetName ) && file.readString( infoText );
+    if( dataType == CLASSIFICATION_DATA ){
+        numTargetDimensions = 0;
+        ok = ok && file.readUINT( numInputDimensions ) && file.readUINT64( totalNumSamples ) && file.readUINT( numClasses );
+        if( ok && numClasses > file.getNumBytesRemaining() ) ok = false;
+        if( ok ) classTracker.resize( numClasses );
+        for(UINT k=0; k<numClasses && ok; k++){
+            ok = file.readUINT( classTracker[k].classLabel ) && file.readUINT( classTracker[k].counter ) && file.readString( classTracker[k].className );
+        }
+    }else{
+        ok = ok && file.readUINT( numInputDimensions ) && file.readUINT( numTargetDimensions ) && file.readUINT64( totalNumSamples );
+    }
+
+    //If the dataset was saved with external ranges then these are used instead of scanning the file
+    ok = ok && file.readUINT( useRanges );
+    if( ok && useRanges != 0 ){
+        if( ((unsigned long long)numInputDimensions + numTargetDimensions) * 2 * sizeof(double) > file.getNumBytesRemaining() ) ok = false;
+        else{
+            inputRanges.resize( numInputDimensions );
+            targetRanges.resize( numTargetDimensions );
+        }
+        for(UINT j=0; j<inputRanges.getSize() && ok; j++){
+            ok = file.readFloat( inputRanges[j].minValue ) && file.readFloat( inputRanges[j].maxValue );
+        }
+        for(UINT j=0; j<targetRanges.getSize() && ok; j++){
+            ok = file.readFloat( targetRanges[j].minValue ) && file.readFloat( targetRanges[j].maxValue );
+        }
+        rangesComputed = ok;
+    }
+    ok = ok && file.readUINT( floatSize ) && file.alignBlock();
+
+    if( !ok || (floatSize != sizeof(float) && floatSize != sizeof(double)) || totalNumSamples > std::numeric_limits< UINT >::max() ){
+        errorLog << "open(const std::string &filename) - Failed to read dataset header!" << std::endl;
+        close();
+        return false;
+    }
+    numSamples = (UINT)totalNumSamples;
+
+    //Work out where the blocks start, the second block is padded to an 8 byte boundary
+    const unsigned long long inputBlockSize = (unsigned long long)numSamples * numInputDimensions * floatSize;
+    const unsigned long long targetBlockSize = dataType == CLASSIFICATION_DATA ? (unsigned long long)numSamples * sizeof(UINT) : (unsigned long long)numSamples * numTargetDimensions * floatSize;
+    inputBlockOffset = file.getPosition();
+    targetBlockOffset = inputBlockOffset + inputBlockSize;
+    targetBlockOffset += (8 - (targetBlockOffset % 8)) % 8;
+
+    if( targetBlockOffset + targetBlockSize > file.getPosition() + file.getNumBytesRemaining() ){
+        errorLog << "open(const std::string &filename) - The file does not contain all the samples listed in the header!" << std::endl;
+        close();
+        return false;
+    }
+
+    this->filename = filename;
+
+    return true;
+}
+
+bool ChunkedDataset::close(){
+
+    stopEpoch();
+    file.close();
+
+    dataType = UNKNOWN_DATA;
+    filename = "";
+    datasetName = "";
+    infoText = "";
+    numSamples = 0;
+    numInputDimensions = 0;
+    numTargetDimensions = 0;
+    floatSize = 0;
+    inputBlockOffset = 0;
+    targetBlockOffset = 0;
+    classTracker.clear();
+    inputRanges.clear();
+    targetRanges.clear();
+    rangesComputed = false;
+
+    return true;
+}
+
+bool ChunkedDataset::startEpoch(){
+
+    if( !file.getIsOpen() ){
+        errorLog << "startEpoch() - The file has not been opened!" << std::endl;
+        return false;
+    }
+
+    stopEpoch();
+
+    const UINT numChunks = getNumChunks();
+    chunkOrder.resize( numChunks );
+    for(UINT i=0; i<numChunks; i++) chunkOrder[i] = i;
+    if( useShuffle ) random.shuffle( chunkOrder );
+
+    epochStarted = true;
+    epochPosition = 0;
+    currentBuffer = 1;
+
+    return startLoadingNextChunk();
+}
+
+bool ChunkedDataset::nextChunk(){
+
+    if( !epochStarted || !loadingChunk ){
+        return false;
+    }
+
+    if( !waitForChunk() ){
+        errorLog << "nextChunk() - Failed to read chunk from file!" << std::endl;
+        stopEpoch();
+        return false;
+    }
+    currentBuffer = loadingBuffer;
+
+    //Start loading the next chunk while the caller is using this one
+    return startLoadingNextChunk();
+}
+
+bool ChunkedDataset::computeRanges(){
+
+    if( !file.getIsOpen() ){
+        errorLog << "computeRanges() - The file has not been opened!" << std::endl;
+        return false;
+    }
+
+    if( rangesComputed ) return true;
+
+    //The scan reuses the chunk buffers, so any epoch that is in progress is stopped
+    stopEpoch();
+
+    inputRanges.clear();
+    targetRanges.clear();
+    if( numSamples == 0 ) return false;
+
+    inputRanges.resize( numInputDimensions );
+    targetRanges.resize( numTargetDimensions );
+
+    //Stream through the file in the order it is stored, so the scan is a single sequential read
+    const UINT numChunks = getNumChunks();
+    for(UINT chunk=0; chunk<numChunks; chunk++){
+        sampleOrders[0].clear();
+        if( !loadChunk( chunk, 0 ) ){
+            errorLog << "computeRanges() - Failed to read chunk from file!" << std::endl;
+            inputRanges.clear();
+            targetRanges.clear();
+            return false;
+        }
+        const UINT numRows = inputBuffers[0].getNumRows();
+        for(UINT i=0; i<numRows; i++){
+            const Float *x = inputBuffers[0][i];
+            const Float *y = dataType == REGRESSION_DATA ? targetBuffers[0][i] : NULL;
+            if( chunk == 0 && i == 0 ){
+                for(UINT j=0; j<numInputDimensions; j++) inputRanges[j] = MinMax( x[j], x[j] );
+                for(UINT j=0; j<numTargetDimensions && y != NULL; j++) targetRanges[j] = MinMax( y[j], y[j] );
+                continue;
+            }
+            for(UINT j=0; j<numInputDimensions; j++) inputRanges[j].updateMinMax( x[j] );
+            for(UINT j=0; j<numTargetDimensions && y != NULL; j++) targetRanges[j].updateMinMax( y[j] );
+        }
+    }
+    rangesComputed = true;
+
+    return true;
+}
+
+bool ChunkedDataset::scaleChunk(const Vector< MinMax > &inputVectorRanges,const Vector< MinMax > &targetVectorRanges,const Float minTarget,const Float maxTarget){
+
+    if( !epochStarted ) return false;
+
+    const bool scaleTargets = dataType == REGRESSION_DATA && targetVectorRanges.getSize() > 0;
+    if( inputVectorRanges.getSize() != numInputDimensions || (scaleTargets && targetVectorRanges.getSize() != numTargetDimensions) ){
+        errorLog << "scaleChunk(...) - The size of the ranges does not match the number of dimensions!" << std::endl;
+        return false;
+    }
+
+    MatrixFloat &inputs = inputBuffers[ currentBuffer ];
+    MatrixFloat &targets = targetBuffers[ currentBuffer ];
+    const UINT numRows = inputs.getNumRows();
+    for(UINT i=0; i<numRows; i++){
+        Float *x = inputs[i];
+        for(UINT j=0; j<numInputDimensions; j++){
+            x[j] = grt_scale(x[j],inputVectorRanges[j].minValue,inputVectorRanges[j].maxValue,minTarget,maxTarget);
+        }
+        if( scaleTargets ){
+            Float *y = targets[i];
+            for(UINT j=0; j<numTargetDimensions; j++){
+                y[j] = grt_scale(y[j],targetVectorRanges[j].minValue,targetVectorRanges[j].maxValue,minTarget,maxTarget);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ChunkedDataset::setChunkSize(const UINT chunkSize){
+    if( chunkSize == 0 ){
+        errorLog << "setChunkSize(const UINT chunkSize) - The chunk size must be greater than zero!" << std::endl;
+        return false;
+    }
+    stopEpoch();
+    this->chunkSize = chunkSize;
+    return true;
+}
+
+bool ChunkedDataset::setShuffle(const bool useShuffle){
+    this->useShuffle = useShuffle;
+    return true;
+}
+
+bool ChunkedDataset::setSeed(const unsigned long long seed){
+    return random.setSeed( seed );
+}
+
+bool ChunkedDataset::getIsOpen() const{ return file.getIsOpen(); }
+
+bool ChunkedDataset::getShuffle() const{ return useShuffle; }
+
+ChunkedDataset::DataType ChunkedDataset::getDataType() const{ return dataType; }
+
+std::string ChunkedDataset::getFilename() const{ return filename; }
+
+std::string ChunkedDataset::getDatasetName() const{ return datasetName; }
+
+std::string ChunkedDataset::getInfoText() const{ return infoText; }
+
+UINT ChunkedDataset::getChunkSize() const{ return chunkSize; }
+
+UINT ChunkedDataset::getNumChunks() const{ return numSamples / chunkSize + (numSamples % chunkSize != 0 ? 1 : 0); }
+
+UINT ChunkedDataset::getNumSamples() const{ return numSamples; }
+
+UINT ChunkedDataset::getNumDimensions() const{ return numInputDimensions; }
+
+UINT ChunkedDataset::getNumInputDimensions() const{ return numInputDimensions; }
+
+UINT ChunkedDataset::getNumTargetDimensions() const{ return numTargetDimensions; }
+
+UINT ChunkedDataset::getNumClasses() const{ return classTracker.getSize(); }
+
+Vector< ClassTracker > ChunkedDataset::getClassTracker() const{ return classTracker; }
+
+Vector< MinMax > ChunkedDataset::getInputRanges(){
+    if( !computeRanges() ) return Vector< MinMax >();
+    return inputRanges;
+}
+
+Vector< MinMax > ChunkedDataset::getTargetRanges(){
+    if( !computeRanges() ) return Vector< MinMax >();
+    return targetRanges;
+}
+
+UINT ChunkedDataset::getNumSamplesInChunk() const{
+    if( !epochStarted ) return 0;
+    return inputBuffers[ currentBuffer ].getNumRows();
+}
+
+MatrixFloat& ChunkedDataset::getInputs(){ return inputBuffers[ currentBuffer ]; }
+
+MatrixFloat& ChunkedDataset::getTargets(){ return targetBuffers[ currentBuffer ]; }
+
+Vector< UINT >& ChunkedDataset::getClassLabels(){ return labelBuffers[ currentBuffer ]; }
+
+bool ChunkedDataset::loadChunk(const UINT chunkIndex,const UINT bufferIndex){
+
+    //This is run on the loader thread, so it must only touch the file and the buffer it has been given
+    const UINT start = chunkIndex * chunkSize;
+    const UINT numRows = std::min( chunkSize, numSamples - start );
+    const Vector< UINT > &order = sampleOrders[ bufferIndex ];
+    const bool shuffled = order.getSize() == numRows;
+    MatrixFloat &inputs = inputBuffers[ bufferIndex ];
+
+    if( inputs.getNumRows() != numRows || inputs.getNumCols() != numInputDimensions ){
+        if( !inputs.resize( numRows, numInputDimensions ) ) return false;
+    }
+
+    bool ok = file.seek( inputBlockOffset + (unsigned long long)start * numInputDimensions * floatSize );
+    if( ok && !shuffled ){
+        ok = file.readFloatBlock( inputs.getData(), (size_t)numRows * numInputDimensions, floatSize );
+    }else{
+        for(UINT i=0; i<numRows && ok; i++){
+            ok = file.readFloatBlock( inputs[ order[i] ], numInputDimensions, floatSize );
+        }
+    }
+
+    if( dataType == CLASSIFICATION_DATA ){
+        Vector< UINT > &labels = labelBuffers[ bufferIndex ];
+        labels.resize( numRows );
+        ok = ok && file.seek( targetBlockOffset + (unsigned long long)start * sizeof(UINT) );
+        if( ok && !shuffled ){
+            ok = file.readUINTBlock( labels.getData(), numRows );
+        }else{
+            for(UINT i=0; i<numRows && ok; i++){
+                ok = file.readUINT( labels[ order[i] ] );
+            }
+        }
+    }else{
+        MatrixFloat &targets = targetBuffers[ bufferIndex ];
+        if( targets.getNumRows() != numRows || targets.getNumCols() != numTargetDimensions ){
+            if( !targets.resize( numRows, numTargetDimensions ) ) return false;
+        }
+        ok = ok && file.seek( targetBlockOffset + (unsigned long long)start * numTargetDimensions * floatSize );
+        if( ok && !shuffled ){
+            ok = file.readFloatBlock( targets.getData(), (size_t)numRows * numTargetDimensions, floatSize );
+        }else{
+            for(UINT i=0; i<numRows && ok; i++){
+                ok = file.readFloatBlock( targets[ order[i] ], numTargetDimensions, floatSize );
+            }
+        }
+    }
+
+    return ok;
+}
+
+bool ChunkedDataset::startLoadingNextChunk(){
+
+    if( epochPosition >= chunkOrder.getSize() ){
+        return true;
+    }
+
+    const UINT chunkIndex = chunkOrder[ epochPosition++ ];
+    const UINT start = chunkIndex * chunkSize;
+    const UINT numRows = std::min( chunkSize, numSamples - start );
+    loadingBuffer = 1 - currentBuffer;
+
+    //The shuffle is drawn here rather than on the loader thread, so the random generator is only used by one thread
+    Vector< UINT > &order = sampleOrders[ loadingBuffer ];
+    order.clear();
+    if( useShuffle ){
+        order.resize( numRows );
+        for(UINT i=0; i<numRows; i++) order[i] = i;
+        random.shuffle( order );
+    }
+
+    loadingChunk = true;
+#ifdef GRT_CXX11_ENABLED
+    const UINT bufferIndex = loadingBuffer;
+    pendingChunk = loader.enqueue( [this,chunkIndex,bufferIndex](){ return loadChunk( chunkIndex, bufferIndex ); } );
+#else
+    loadResult = loadChunk( chunkIndex, loadingBuffer );
+#endif
+
+    return true;
+}
+
+bool ChunkedDataset::waitForChunk(){
+
+    if( !loadingChunk ) return true;
+    loadingChunk = false;
+#ifdef GRT_CXX11_ENABLED
+    loadResult = pendingChunk.get();
+#endif
+    return loadResult;
+}
+
+void ChunkedDataset::stopEpoch(){
+    waitForChunk();
+    epochStarted = false;
+    epochPosition = 0;
+    chunkOrder.clear();
+}
+
+GRT_END_NAMESPACE
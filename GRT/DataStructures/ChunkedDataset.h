@@ -0,0 +1,247 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+
+ @brief The ChunkedDataset class serves a ClassificationData or RegressionData binary data file (.grtb) from disk in fixed-size chunks,
+ so models can be trained on datasets that are larger than the memory of the machine.
+
+ Only two chunks are held in memory at any time: the chunk that is currently being used for training and the next chunk of the
+ epoch, which is loaded by a background thread while the current chunk is being used.  If shuffling is enabled then the order
+ of the chunks is shuffled at the start of each epoch and the samples within each chunk are shuffled as the chunk is loaded.
+
+ The ChunkedDataset can be passed to the train function of any of the algorithms that are trained with mini-batches or
+ stochastic gradient descent (Softmax, LogisticRegression, LinearRegression, MLP, KMeans and BernoulliRBM).
+ Binary data files are created with the ClassificationData::saveDatasetToBinaryFile or RegressionData::saveDatasetToBinaryFile functions.
+ */
+
+/**
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_CHUNKED_DATASET_HEADER
+#define GRT_CHUNKED_DATASET_HEADER
+
+#include "../Util/GRTCommon.h"
+#include "../Util/BinaryDataFile.h"
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API ChunkedDataset{
+public:
+    enum DataType{ UNKNOWN_DATA=0, CLASSIFICATION_DATA, REGRESSION_DATA };
+
+    /**
+     Default Constructor, sets the number of samples in each chunk.
+
+     @param chunkSize: the maximum number of samples in each chunk, must be greater than zero
+     @param useShuffle: if true, the order of the chunks and the order of the samples in each chunk will be shuffled at the start of each epoch
+     */
+    ChunkedDataset(const UINT chunkSize = 10000,const bool useShuffle = true);
+
+    /**
+     Default Destructor, waits for any chunk that is still being loaded and closes the file.
+     */
+    ~ChunkedDataset();
+
+    /**
+     Opens a binary data file created by ClassificationData::saveDatasetToBinaryFile or RegressionData::saveDatasetToBinaryFile.
+     Only the header of the file is read, the samples are read from the file one chunk at a time once an epoch has been started.
+
+     @param filename: the name of the binary data file to open
+     @return true if the file was opened, false otherwise
+     */
+    bool open(const std::string &filename);
+
+    /**
+     Closes the file, any chunk that is still being loaded is discarded.
+
+     @return true if the file was closed, false otherwise
+     */
+    bool close();
+
+    /**
+     Starts a new epoch. If shuffling is enabled then the order of the chunks is shuffled, the first chunk is then loaded in the background.
+     The chunks in the epoch are then accessed by calling nextChunk() until it returns false.
+
+     @return true if the epoch was started, false otherwise
+     */
+    bool startEpoch();
+
+    /**
+     Moves to the next chunk of the current epoch, waiting for it to finish loading if needed, and starts loading the chunk after it in the background.
+     The samples in the chunk can then be accessed with the getInputs(), getClassLabels() and getTargets() functions.
+
+     @return true if there was another chunk in the epoch, false if the epoch has finished or if the chunk could not be read from the file
+     */
+    bool nextChunk();
+
+    /**
+     Scans the whole file and computes the minimum and maximum values of each input and target dimension, the result is cached so the
+     file is only scanned once. The scan uses the same buffers as an epoch, so any epoch that is in progress is stopped.
+
+     @return true if the ranges were computed, false otherwise
+     */
+    bool computeRanges();
+
+    /**
+     Scales the current chunk in place, this is used by the learning algorithms to scale each chunk as it is used, in the same way
+     that they scale an in-memory dataset before it is used.
+
+     @param inputVectorRanges: the ranges of the input data, the size must match the number of input dimensions
+     @param targetVectorRanges: the ranges of the target data, this can be empty for a classification dataset
+     @param minTarget: the minimum value the data will be scaled to
+     @param maxTarget: the maximum value the data will be scaled to
+     @return true if the chunk was scaled, false otherwise
+     */
+    bool scaleChunk(const Vector< MinMax > &inputVectorRanges,const Vector< MinMax > &targetVectorRanges,const Float minTarget,const Float maxTarget);
+
+    /**
+     Sets the maximum number of samples in each chunk. Any epoch that is in progress is stopped.
+
+     @param chunkSize: the maximum number of samples in each chunk, must be greater than zero
+     @return true if the chunk size was updated, false otherwise
+     */
+    bool setChunkSize(const UINT chunkSize);
+
+    /**
+     Sets if the order of the chunks, and the order of the samples in each chunk, should be shuffled at the start of each epoch.
+
+     @param useShuffle: true if the data should be shuffled, false if the chunks should be served in the order they are stored in the file
+     @return true if the value was updated, false otherwise
+     */
+    bool setShuffle(const bool useShuffle);
+
+    /**
+     Sets the seed used to shuffle the data, this can be used to get the same order of samples each time the data is used.
+
+     @param seed: the new seed
+     @return true if the seed was updated, false otherwise
+     */
+    bool setSeed(const unsigned long long seed);
+
+    bool getIsOpen() const;
+    bool getShuffle() const;
+    DataType getDataType() const;
+    std::string getFilename() const;
+    std::string getDatasetName() const;
+    std::string getInfoText() const;
+    UINT getChunkSize() const;
+    UINT getNumChunks() const;
+    UINT getNumSamples() const;
+    UINT getNumDimensions() const;
+    UINT getNumInputDimensions() const;
+    UINT getNumTargetDimensions() const;
+
+    /**
+     @return returns the number of classes in a classification dataset, or zero for a regression dataset
+     */
+    UINT getNumClasses() const;
+
+    /**
+     @return returns the class tracker stored in a classification dataset, this is empty for a regression dataset
+     */
+    Vector< ClassTracker > getClassTracker() const;
+
+    /**
+     Gets the ranges of the input data, these are computed with computeRanges() the first time they are needed, unless
+     the dataset was saved with external ranges, in which case those ranges are returned.
+
+     @return returns the minimum and maximum value of each input dimension, or an empty Vector if the ranges could not be computed
+     */
+    Vector< MinMax > getInputRanges();
+
+    /**
+     Gets the ranges of the target data for a regression dataset, see getInputRanges().
+
+     @return returns the minimum and maximum value of each target dimension, or an empty Vector if the ranges could not be computed
+     */
+    Vector< MinMax > getTargetRanges();
+
+    /**
+     @return returns the number of samples in the current chunk, or zero if there is no current chunk
+     */
+    UINT getNumSamplesInChunk() const;
+
+    /**
+     @return returns a reference to the input data of the current chunk, each row is one sample
+     */
+    MatrixFloat& getInputs();
+
+    /**
+     @return returns a reference to the target data of the current chunk of a regression dataset, each row is one sample
+     */
+    MatrixFloat& getTargets();
+
+    /**
+     @return returns a reference to the class labels of the current chunk of a classification dataset
+     */
+    Vector< UINT >& getClassLabels();
+
+protected:
+    bool loadChunk(const UINT chunkIndex,const UINT bufferIndex);
+    bool startLoadingNextChunk();
+    bool waitForChunk();
+    void stopEpoch();
+
+    DataType dataType;
+    std::string filename;
+    std::string datasetName;
+    std::string infoText;
+    UINT chunkSize;
+    bool useShuffle;
+    UINT numSamples;
+    UINT numInputDimensions;
+    UINT numTargetDimensions;
+    UINT floatSize;
+    unsigned long long inputBlockOffset;
+    unsigned long long targetBlockOffset;
+    Vector< ClassTracker > classTracker;
+    Vector< MinMax > inputRanges;
+    Vector< MinMax > targetRanges;
+    bool rangesComputed;
+
+    BinaryDataFile file;
+    Random random;
+    bool epochStarted;
+    UINT epochPosition;
+    Vector< UINT > chunkOrder;
+    UINT currentBuffer;
+    UINT loadingBuffer;
+    bool loadingChunk;
+    bool loadResult;
+    MatrixFloat inputBuffers[2];
+    MatrixFloat targetBuffers[2];
+    Vector< UINT > labelBuffers[2];
+    Vector< UINT > sampleOrders[2];
+#ifdef GRT_CXX11_ENABLED
+    ThreadPool loader;
+    std::future< bool > pendingChunk;
+#endif
+    ErrorLog errorLog;
+    WarningLog warningLog;
+
+private:
+    //A ChunkedDataset owns a file and a loading thread, so it can not be copied
+    ChunkedDataset(const ChunkedDataset &rhs);
+    ChunkedDataset& operator=(const ChunkedDataset &rhs);
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_CHUNKED_DATASET_HEADER
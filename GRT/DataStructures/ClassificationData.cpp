@@ -20,6 +20,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "ClassificationData.h"
+#include "ClassificationDataView.h"
+#include "../Util/BinaryDataFile.h"
+#include "../Util/CSVReader.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -42,6 +45,10 @@ ClassificationData::ClassificationData(const ClassificationData &rhs){
     *this = rhs;
 }
 
+ClassificationData::ClassificationData(ClassificationData &&rhs){
+    *this = std::move( rhs );
+}
+
 ClassificationData::~ClassificationData(){
 }
     
@@ -67,6 +74,31 @@ ClassificationData& ClassificationData::operator=(const ClassificationData &rhs)
     return *this;
 }
 
+ClassificationData& ClassificationData::operator=(ClassificationData &&rhs){
+    if( this != &rhs){
+        this->datasetName = rhs.datasetName;
+        this->infoText = rhs.infoText;
+        this->numDimensions = rhs.numDimensions;
+        this->totalNumSamples = rhs.totalNumSamples;
+        this->kFoldValue = rhs.kFoldValue;
+        this->crossValidationSetup = rhs.crossValidationSetup;
+        this->useExternalRanges = rhs.useExternalRanges;
+        this->allowNullGestureClass = rhs.allowNullGestureClass;
+        this->externalRanges = rhs.externalRanges;
+        this->classTracker = std::move( rhs.classTracker );
+        this->data = std::move( rhs.data );
+        this->crossValidationIndexs = std::move( rhs.crossValidationIndexs );
+        this->infoLog = rhs.infoLog;
+        this->debugLog = rhs.debugLog;
+        this->errorLog = rhs.errorLog;
+        this->warningLog = rhs.warningLog;
+
+        //Leave the rhs instance empty, as its samples have been moved to this instance
+        rhs.clear();
+    }
+    return *this;
+}
+
 void ClassificationData::clear(){
 	totalNumSamples = 0;
 	data.clear();
@@ -382,6 +414,11 @@ bool ClassificationData::save(const std::string &filename) const{
         return saveDatasetToCSVFile( filename );
     }
     
+    //Check if the file should be saved as a binary file
+    if( BinaryDataFile::isBinaryDataFilename( filename ) ){
+        return saveDatasetToBinaryFile( filename );
+    }
+    
     //Otherwise save it as a custom GRT file
     return saveDatasetToFile( filename );
 }
@@ -393,6 +430,11 @@ bool ClassificationData::load(const std::string &filename){
         return loadDatasetFromCSVFile( filename );
     }
     
+    //Check if the file should be loaded as a binary file
+    if( BinaryDataFile::isBinaryDataFilename( filename ) ){
+        return loadDatasetFromBinaryFile( filename );
+    }
+    
     //Otherwise save it as a custom GRT file
     return loadDatasetFromFile( filename );
 }
@@ -609,58 +651,62 @@ bool ClassificationData::loadDatasetFromCSVFile(const std::string &filename,cons
     //Clear any previous data
     clear();
 
-    //Parse the CSV file
-    FileParser parser;
-
-    Timer timer;
-
-    timer.start();
+    //Open the CSV file and count the rows, so the memory for the data can be allocated before it is parsed
+    CSVReader reader;
+    UINT numRows = 0;
+    UINT numColumns = 0;
     
-    if( !parser.parseCSVFile(filename,true) ){
+    if( !reader.open( filename ) || !reader.countRows( numRows, numColumns ) ){
         errorLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex) - Failed to parse CSV file!" << std::endl;
         return false;
     }
     
-    if( !parser.getConsistentColumnSize() ){
-        errorLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndexe) - The CSV file does not have a consistent number of columns!" << std::endl;
+    if( numColumns <= 1 ){
+        errorLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex) - The CSV file does not have enough columns! It should contain at least two columns!" << std::endl;
         return false;
     }
     
-    if( parser.getColumnSize() <= 1 ){
-        errorLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex) - The CSV file does not have enough columns! It should contain at least two columns!" << std::endl;
+    if( classLabelColumnIndex >= numColumns ){
+        errorLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex) - The class label column index is larger than the number of columns in the CSV file!" << std::endl;
         return false;
     }
     
     //Set the number of dimensions
-    numDimensions = parser.getColumnSize()-1;
-
-    timer.start();
+    numDimensions = numColumns-1;
 
     //Reserve the memory for the data
-    data.resize( parser.getRowSize(), ClassificationSample(numDimensions) );
-
-    timer.start();
+    data.resize( numRows, ClassificationSample(numDimensions) );
    
-    //Loop over the samples and add them to the data set
+    //Loop over the samples and add them to the data set, each row is parsed straight from the file buffer
+    VectorFloat row( numColumns );
     UINT classLabel = 0;
     UINT j = 0;
-    UINT n = 0;
-    totalNumSamples = parser.getRowSize();
+    totalNumSamples = numRows;
     for(UINT i=0; i<totalNumSamples; i++){
-        //Get the class label
-        classLabel = grt_from_str< UINT >( parser[i][classLabelColumnIndex] );
+        if( !reader.readRow( row.getData(), numColumns ) ){
+            errorLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex) - Failed to parse row " << i << ", the CSV file must only contain numbers and have a consistent number of columns!" << std::endl;
+            clear();
+            return false;
+        }
+        
+        //Get the class label, it must be a non-negative integer that fits in a UINT
+        const Float label = row[classLabelColumnIndex];
+        if( !(label >= 0 && label <= std::numeric_limits< UINT >::max() && label == std::floor( label )) ){
+            errorLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex) - The class label on line " << reader.getLineNumber() << " is not valid, it must be a non-negative integer!" << std::endl;
+            clear();
+            return false;
+        }
+        classLabel = (UINT)label;
         
         //Set the class label
         data[i].setClassLabel( classLabel );
         
         //Get the sample data
         j=0;
-        n=0;
-        while( j != numDimensions ){
+        for(UINT n=0; n<numColumns; n++){
             if( n != classLabelColumnIndex ){
-                data[i][j++] = grt_from_str< Float >( parser[i][n] );
+                data[i][j++] = row[n];
             }
-            n++;
         }
         
         //Update the class tracker
@@ -670,9 +716,9 @@ bool ClassificationData::loadDatasetFromCSVFile(const std::string &filename,cons
         }else{
             bool labelFound = false;
             const size_t numClasses = classTracker.size();
-            for(size_t i=0; i<numClasses; i++){
-                if( classLabel == classTracker[i].classLabel ){
-                    classTracker[i].counter++;
+            for(size_t k=0; k<numClasses; k++){
+                if( classLabel == classTracker[k].classLabel ){
+                    classTracker[k].counter++;
                     labelFound = true;
                     break;
                 }
@@ -690,6 +736,137 @@ bool ClassificationData::loadDatasetFromCSVFile(const std::string &filename,cons
     return true;
 }
     
+bool ClassificationData::saveDatasetToBinaryFile(const std::string &filename,const bool useSinglePrecision) const{
+
+    BinaryDataFile file;
+    if( !file.openForWriting( filename, "ClassificationData" ) ){
+        errorLog << "saveDatasetToBinaryFile(const std::string &filename,const bool useSinglePrecision) - Failed to open file!" << std::endl;
+        return false;
+    }
+
+    const UINT floatSize = useSinglePrecision ? sizeof(float) : sizeof(double);
+    bool ok = file.writeString( datasetName ) && file.writeString( infoText );
+    ok = ok && file.writeUINT( numDimensions ) && file.writeUINT64( totalNumSamples );
+    ok = ok && file.writeUINT( classTracker.getSize() );
+    for(UINT k=0; k<classTracker.getSize() && ok; k++){
+        ok = file.writeUINT( classTracker[k].classLabel ) && file.writeUINT( classTracker[k].counter ) && file.writeString( classTracker[k].className );
+    }
+    ok = ok && file.writeUINT( useExternalRanges ? 1 : 0 );
+    if( useExternalRanges ){
+        for(UINT j=0; j<externalRanges.getSize() && ok; j++){
+            ok = file.writeFloat( externalRanges[j].minValue ) && file.writeFloat( externalRanges[j].maxValue );
+        }
+    }
+    ok = ok && file.writeUINT( floatSize );
+
+    //Write the samples as one contiguous block, followed by the class labels
+    ok = ok && file.alignBlock();
+    for(UINT i=0; i<totalNumSamples && ok; i++){
+        ok = file.writeFloatBlock( data[i].getSample().getData(), numDimensions, floatSize );
+    }
+    ok = ok && file.alignBlock();
+    for(UINT i=0; i<totalNumSamples && ok; i++){
+        ok = file.writeUINT( data[i].getClassLabel() );
+    }
+
+    if( !file.close() || !ok ){
+        errorLog << "saveDatasetToBinaryFile(const std::string &filename,const bool useSinglePrecision) - Failed to write data to file!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool ClassificationData::loadDatasetFromBinaryFile(const std::string &filename){
+
+    clear();
+
+    BinaryDataFile file;
+    if( !file.openForReading( filename, "ClassificationData" ) ){
+        errorLog << "loadDatasetFromBinaryFile(const std::string &filename) - Failed to open file!" << std::endl;
+        return false;
+    }
+
+    UINT numClasses = 0;
+    UINT useRanges = 0;
+    UINT floatSize = 0;
+    unsigned long long numSamples = 0;
+    bool ok = file.readString( datasetName ) && file.readString( infoText );
+    ok = ok && file.readUINT( numDimensions ) && file.readUINT64( numSamples ) && file.readUINT( numClasses );
+    if( !ok || numClasses > file.getNumBytesRemaining() || numSamples > std::numeric_limits< UINT >::max() ){
+        errorLog << "loadDatasetFromBinaryFile(const std::string &filename) - Failed to read dataset header!" << std::endl;
+        clear();
+        return false;
+    }
+
+    classTracker.resize( numClasses );
+    for(UINT k=0; k<numClasses && ok; k++){
+        ok = file.readUINT( classTracker[k].classLabel ) && file.readUINT( classTracker[k].counter ) && file.readString( classTracker[k].className );
+    }
+    ok = ok && file.readUINT( useRanges );
+    useExternalRanges = useRanges != 0;
+    if( ok && useExternalRanges && (unsigned long long)numDimensions * 2 * sizeof(double) > file.getNumBytesRemaining() ) ok = false;
+    if( ok && useExternalRanges ){
+        externalRanges.resize( numDimensions );
+        for(UINT j=0; j<numDimensions && ok; j++){
+            ok = file.readFloat( externalRanges[j].minValue ) && file.readFloat( externalRanges[j].maxValue );
+        }
+    }
+    ok = ok && file.readUINT( floatSize ) && file.alignBlock();
+
+    //Make sure the file actually contains all the samples before any memory is allocated for them, this also bounds the number of
+    //dimensions by the size of the file. A dataset without samples has no per-dimension data in the file, so nothing is allocated for it
+    const unsigned long long bytesPerSample = (unsigned long long)numDimensions * floatSize + sizeof(UINT);
+    if( !ok || (floatSize != sizeof(float) && floatSize != sizeof(double)) || numSamples > file.getNumBytesRemaining() / bytesPerSample ||
+        (numSamples > 0 && numDimensions == 0) ){
+        errorLog << "loadDatasetFromBinaryFile(const std::string &filename) - Failed to read dataset header!" << std::endl;
+        clear();
+        return false;
+    }
+
+    totalNumSamples = (UINT)numSamples;
+    if( totalNumSamples > 0 ){
+        data.resize( totalNumSamples, ClassificationSample( numDimensions ) );
+    }
+    for(UINT i=0; i<totalNumSamples && ok; i++){
+        ok = file.readFloatBlock( data[i].getSample().getData(), numDimensions, floatSize );
+    }
+    ok = ok && file.alignBlock();
+
+    //Every class label must be one of the classes in the header, and the number of samples of each class must match its counter
+    bool labelsValid = true;
+    Vector< UINT > classCounts( numClasses, 0 );
+    for(UINT i=0; i<totalNumSamples && ok && labelsValid; i++){
+        UINT classLabel = 0;
+        ok = file.readUINT( classLabel );
+        UINT k = 0;
+        while( k < numClasses && classTracker[k].classLabel != classLabel ) k++;
+        if( k < numClasses ) classCounts[k]++;
+        else labelsValid = false;
+        data[i].setClassLabel( classLabel );
+    }
+    for(UINT k=0; k<numClasses && labelsValid; k++){
+        if( classCounts[k] != classTracker[k].counter ) labelsValid = false;
+    }
+
+    if( !ok ){
+        errorLog << "loadDatasetFromBinaryFile(const std::string &filename) - Failed to read data from file!" << std::endl;
+        clear();
+        return false;
+    }
+
+    if( !labelsValid ){
+        errorLog << "loadDatasetFromBinaryFile(const std::string &filename) - The class labels of the samples do not match the classes in the file header!" << std::endl;
+        clear();
+        return false;
+    }
+
+    //Sort the class labels
+    sortClassLabels();
+
+    return true;
+}
+
 bool ClassificationData::printStats() const{
 
     std::cout << getStatsAsString();
@@ -709,6 +886,11 @@ ClassificationData ClassificationData::partition(const UINT trainingSizePercenta
 }
 
 ClassificationData ClassificationData::split(const UINT trainingSizePercentage,const bool useStratifiedSampling){
+    Random random;
+    return split( trainingSizePercentage, useStratifiedSampling, random );
+}
+
+ClassificationData ClassificationData::split(const UINT trainingSizePercentage,const bool useStratifiedSampling,Random &random){
 
     //Partitions the dataset into a training dataset (which is kept by this instance of the ClassificationData) and
 	//a testing/validation dataset (which is return as a new instance of the ClassificationData).  The trainingSizePercentage
@@ -724,8 +906,6 @@ ClassificationData ClassificationData::split(const UINT trainingSizePercentage,c
     trainingSet.setAllowNullGestureClass( allowNullGestureClass );
     testSet.setAllowNullGestureClass( allowNullGestureClass );
 
-	//Create the random partion indexs
-	Random random;
     UINT K = getNumClasses();
 
     //Make sure both datasets get all the class labels, even if they have no samples in each
@@ -749,7 +929,7 @@ ClassificationData ClassificationData::split(const UINT trainingSizePercentage,c
 
         //Randomize the order of the indexs in each of the class index buffers
         for(UINT k=0; k<K; k++){
-            std::random_shuffle(classData[k].begin(), classData[k].end());
+            random.shuffle( classData[k] );
         }
         
         //Reserve the memory
@@ -785,7 +965,7 @@ ClassificationData ClassificationData::split(const UINT trainingSizePercentage,c
         //Create the random partion indexs
         Vector< UINT > indexs( totalNumSamples );
         for(UINT i=0; i<totalNumSamples; i++) indexs[i] = i;
-        std::random_shuffle(indexs.begin(), indexs.end());
+        random.shuffle( indexs );
         
         //Reserve the memory
         trainingSet.reserve( numTrainingExamples );
@@ -1022,6 +1202,30 @@ ClassificationData ClassificationData::getTestFoldData(const UINT foldIndex) con
     return testData;
 }
 
+Vector< UINT > ClassificationData::getTrainingFoldIndexs(const UINT foldIndex) const{
+    
+    Vector< UINT > indexs;
+    
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return indexs;
+    
+    //The training fold consists of all the data that is NOT in the foldIndex
+    indexs.reserve( getNumSamples() - crossValidationIndexs[ foldIndex ].getSize() );
+    for(UINT k=0; k<kFoldValue; k++){
+        if( k != foldIndex ){
+            indexs.insert( indexs.end(), crossValidationIndexs[k].begin(), crossValidationIndexs[k].end() );
+        }
+    }
+    
+    return indexs;
+}
+
+Vector< UINT > ClassificationData::getTestFoldIndexs(const UINT foldIndex) const{
+    
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return Vector< UINT >();
+    
+    return crossValidationIndexs[ foldIndex ];
+}
+
 ClassificationData ClassificationData::getClassData(const UINT classLabel) const{
     
     ClassificationData classData;
@@ -1046,8 +1250,13 @@ ClassificationData ClassificationData::getClassData(const UINT classLabel) const
 }
     
 ClassificationData ClassificationData::getBootstrappedDataset(const UINT numSamples_,const bool balanceDataset) const{
-    
     Random rand;
+    Vector< UINT > sampleIndexs;
+    return getBootstrappedDataset( numSamples_, balanceDataset, rand, sampleIndexs );
+}
+
+ClassificationData ClassificationData::getBootstrappedDataset(const UINT numSamples_,const bool balanceDataset,Random &rand,Vector< UINT > &sampleIndexs) const{
+    
     ClassificationData newDataset;
     newDataset.setNumDimensions( getNumDimensions() );
     newDataset.setAllowNullGestureClass( allowNullGestureClass );
@@ -1066,6 +1275,23 @@ ClassificationData ClassificationData::getBootstrappedDataset(const UINT numSamp
         newDataset.addClass( classTracker[k].classLabel );
     }
 
+    drawBootstrappedIndexs( numBootstrapSamples, balanceDataset, rand, sampleIndexs );
+    for(UINT i=0; i<numBootstrapSamples; i++){
+        newDataset.addSample( data[ sampleIndexs[i] ].getClassLabel(), data[ sampleIndexs[i] ].getSample() );
+    }
+
+    //Sort the class labels so they are in order
+    newDataset.sortClassLabels();
+    
+    return newDataset;
+}
+
+void ClassificationData::drawBootstrappedIndexs(const UINT numBootstrapSamples,const bool balanceDataset,Random &rand,Vector< UINT > &sampleIndexs) const{
+
+    sampleIndexs.resize( numBootstrapSamples );
+
+    const UINT K = getNumClasses();
+
     if( balanceDataset ){
         //Group the class indexs
         Vector< Vector< UINT > > classIndexs( K );
@@ -1083,7 +1309,7 @@ ClassificationData ClassificationData::getBootstrappedDataset(const UINT numSamp
         for(UINT i=0; i<numBootstrapSamples; i++){
             randomIndex = rand.getRandomNumberInt(0, (UINT)classIndexs[ classIndex ].size() );
             randomIndex = classIndexs[ classIndex ][ randomIndex ];
-            newDataset.addSample(data[ randomIndex ].getClassLabel(), data[ randomIndex ].getSample());
+            sampleIndexs[i] = randomIndex;
             if( classCounter++ >= numSamplesPerClass && classIndex+1 < K ){
                 classCounter = 0;
                 classIndex++;
@@ -1092,17 +1318,41 @@ ClassificationData ClassificationData::getBootstrappedDataset(const UINT numSamp
 
     }else{
         //Randomly select the training samples to add to the new data set
-        UINT randomIndex;
         for(UINT i=0; i<numBootstrapSamples; i++){
-            randomIndex = rand.getRandomNumberInt(0, totalNumSamples);
-            newDataset.addSample( data[randomIndex].getClassLabel(), data[randomIndex].getSample() );
+            sampleIndexs[i] = rand.getRandomNumberInt(0, totalNumSamples);
         }
     }
+}
 
-    //Sort the class labels so they are in order
-    newDataset.sortClassLabels();
+ClassificationDataView ClassificationData::getView() const{
+    return ClassificationDataView( *this );
+}
+
+ClassificationDataView ClassificationData::getTrainingFoldView(const UINT foldIndex) const{
+    if( !crossValidationSetup ){
+        errorLog << "getTrainingFoldView(const UINT foldIndex) - Cross Validation has not been setup! You need to call the spiltDataIntoKFolds(UINT K,bool useStratifiedSampling) function first before calling this function!" << std::endl;
+    }
+    return ClassificationDataView( *this, getTrainingFoldIndexs( foldIndex ), false );
+}
+
+ClassificationDataView ClassificationData::getTestFoldView(const UINT foldIndex) const{
+    return ClassificationDataView( *this, getTestFoldIndexs( foldIndex ) );
+}
+
+ClassificationDataView ClassificationData::getClassView(const UINT classLabel) const{
+    return ClassificationDataView( *this, getClassDataIndexes( classLabel ), false );
+}
+
+ClassificationDataView ClassificationData::getBootstrappedView(const UINT numSamples_,const bool balanceDataset,Random &rand) const{
     
-    return newDataset;
+    const UINT numBootstrapSamples = numSamples_ > 0 ? numSamples_ : totalNumSamples;
+
+    grt_assert( numBootstrapSamples > 0 );
+
+    Vector< UINT > sampleIndexs;
+    drawBootstrappedIndexs( numBootstrapSamples, balanceDataset, rand, sampleIndexs );
+
+    return ClassificationDataView( *this, sampleIndexs, false );
 }
 
 RegressionData ClassificationData::reformatAsRegressionData() const{
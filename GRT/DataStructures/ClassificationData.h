@@ -35,6 +35,8 @@
 
 GRT_BEGIN_NAMESPACE
 
+class ClassificationDataView;
+
 /**
  @brief The ClassificationData is the main data structure for recording, labeling, managing, saving, and loading training data for supervised learning problems.
  
@@ -59,6 +61,13 @@ public:
     */
     ClassificationData(const ClassificationData &rhs);
 
+    /**
+     Move Constructor, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the ClassificationData class from which the data will be moved to this instance
+     */
+    ClassificationData(ClassificationData &&rhs);
+
     /**
      Default Destructor
     */
@@ -72,6 +81,14 @@ public:
     */
 	ClassificationData& operator=(const ClassificationData &rhs);
 
+    /**
+     Sets the move assignment operator, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the ClassificationData class from which the data will be moved to this instance
+	 @return a reference to this instance of ClassificationData
+     */
+	ClassificationData& operator=(ClassificationData &&rhs);
+
     /**
      Array Subscript Operator, returns the ClassificationSample at index i.  
      It is up to the user to ensure that i is within the range of [0 totalNumSamples-1]
@@ -265,8 +282,8 @@ public:
 	
     /**
      Saves the classification data to a file.
-     If the file format ends in '.csv' then the data will be saved as comma-seperated-values, otherwise it will be saved
-     to a custom GRT file (which contains the csv data with an additional header).
+     If the file format ends in '.csv' then the data will be saved as comma-seperated-values, if it ends in '.grtb' then it
+     will be saved as a binary data file, otherwise it will be saved to a custom GRT file (which contains the csv data with an additional header).
      
      @param filename: the name of the file the data will be saved to
      @return true if the data was saved successfully, false otherwise
@@ -275,8 +292,8 @@ public:
     
     /**
      Load the classification data from a file.
-     If the file format ends in '.csv' then the function will try and load the data from a csv format.  If this fails then it will
-     try and load the data as a custom GRT file.
+     If the file format ends in '.csv' then the function will try and load the data from a csv format, if it ends in '.grtb' then
+     it will be loaded as a binary data file, otherwise it will try and load the data as a custom GRT file.
      
      @param filename: the name of the file the data will be loaded from
      @return true if the data was loaded successfully, false otherwise
@@ -319,6 +336,29 @@ public:
      @return true if the data was loaded successfully, false otherwise
      */
     bool loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex = 0);
+
+    /**
+     Saves the labelled classification data to a binary data file.
+     The file contains the dataset header and class names, followed by the samples as one contiguous little-endian block
+     of float64 (or float32) values and then the class labels as a block of 32 bit unsigned integers.
+     This is much faster to save and load than the custom GRT text format and should use the '.grtb' file extension.
+
+     @param filename: the name of the file the data will be saved to
+     @param useSinglePrecision: if true the samples will be stored as float32 values, halving the size of the file. Default value = false
+     @return true if the data was saved successfully, false otherwise
+     */
+    bool saveDatasetToBinaryFile(const std::string &filename,const bool useSinglePrecision = false) const;
+
+    /**
+     Loads the labelled classification data from a binary data file saved with saveDatasetToBinaryFile.
+     The file is memory mapped where possible, so the samples are copied straight from the file into the dataset without parsing any text.
+     The samples are still copied onto the heap, the dataset does not keep the mapping, use a ChunkedDataset to train from a file that is too large to load.
+     The file is rejected if the header does not fit in the file, or if the class labels of the samples do not match the classes (and class counts) in the header.
+
+     @param filename: the name of the file the data will be loaded from
+     @return true if the data was loaded successfully, false otherwise
+     */
+    bool loadDatasetFromBinaryFile(const std::string &filename);
     
     /**
      Prints the dataset info (such as its name and infoText) and the stats (such as the number of examples, number of dimensions, number of classes, etc.)
@@ -356,12 +396,24 @@ public:
     /**
      Splits the dataset into a training dataset (which is kept by this instance of the ClassificationData) and
      a testing/validation dataset (which is returned as a new instance of a ClassificationData).
+     The data is partitioned with a new time-seeded random number generator, use the overload below to control the seed.
      
      @param splitPercentage: sets the percentage of data which remains in this instance, the remaining percentage of data is then returned as the testing/validation dataset
      @param useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt, default value is false
      @return a new ClassificationData instance, containing the remaining data not kept but this instance
      */
     ClassificationData split(const UINT splitPercentage,const bool useStratifiedSampling = false);
+
+    /**
+     Splits the dataset into a training dataset and a testing/validation dataset, using the random number generator supplied by the caller.
+     This makes the split repeatable when the generator has been seeded.
+     
+     @param splitPercentage: sets the percentage of data which remains in this instance, the remaining percentage of data is then returned as the testing/validation dataset
+     @param useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt
+     @param random: the random number generator used to partition the data
+     @return a new ClassificationData instance, containing the remaining data not kept but this instance
+     */
+    ClassificationData split(const UINT splitPercentage,const bool useStratifiedSampling,Random &random);
     
     /**
      This function prepares the dataset for k-fold cross validation and should be called prior to calling the getTrainingFold(UINT foldIndex) or getTestingFold(UINT foldIndex) functions.  It will spilt the dataset into K-folds, as long as K < M, where M is the number of samples in the dataset.
@@ -390,6 +442,24 @@ public:
     */
     ClassificationData getTestFoldData(const UINT foldIndex) const;
     
+    /**
+     Returns the indexs of the samples in the training dataset for the k-th fold for cross validation, without copying the samples.
+     The indexs are listed in the same order as the samples returned by getTrainingFoldData.
+     
+     @param foldIndex: the index of the fold you want the training indexs for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns the indexs of the training samples, an empty Vector will be returned if the data has not been spilt into K folds
+    */
+    Vector< UINT > getTrainingFoldIndexs(const UINT foldIndex) const;
+    
+    /**
+     Returns the indexs of the samples in the test dataset for the k-th fold for cross validation, without copying the samples.
+     The indexs are listed in the same order as the samples returned by getTestFoldData.
+     
+     @param foldIndex: the index of the fold you want the test indexs for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns the indexs of the test samples, an empty Vector will be returned if the data has not been spilt into K folds
+    */
+    Vector< UINT > getTestFoldIndexs(const UINT foldIndex) const;
+    
     /**
      Returns the all the data with the class label set by classLabel.
      The classLabel should be a valid classLabel, otherwise the dataset returned will be empty.
@@ -409,6 +479,65 @@ public:
      @return returns a bootstrapped ClassificationData
      */
     ClassificationData getBootstrappedDataset(const UINT numSamples=0, const bool balanceDataset=false ) const;
+
+    /**
+     Gets a bootstrapped dataset from the current dataset, using the random number generator supplied by the caller.
+     The index of the original sample used for each bootstrapped sample is returned in sampleIndexs, which can be
+     used to find the samples that were not selected (i.e. the out-of-bag samples).
+     
+     @param numSamples: the size of the bootstrapped dataset, if zero the size will match the size of the current dataset
+     @param balanceDataset: if true will use stratified sampling to balance the dataset returned, otherwise will use random sampling
+     @param random: the random number generator used to draw the samples
+     @param sampleIndexs: returns the index of the original sample for each sample in the bootstrapped dataset
+     @return returns a bootstrapped ClassificationData
+     */
+    ClassificationData getBootstrappedDataset(const UINT numSamples, const bool balanceDataset, Random &random, Vector< UINT > &sampleIndexs) const;
+
+    /**
+     Returns a view of all the samples in the dataset, no samples are copied.
+     The dataset must outlive the view and must not be modified while the view is being used.
+
+     @return returns a ClassificationDataView of the dataset
+    */
+    ClassificationDataView getView() const;
+
+    /**
+     Returns a view of the training dataset for the k-th fold for cross validation, no samples are copied.
+     Unlike getTrainingFoldData, the view only contains the classes that have samples in the training fold.
+     The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
+
+     @param foldIndex: the index of the fold you want the training data for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns a view of the training samples, the view will be empty if the data has not been spilt into K folds
+    */
+    ClassificationDataView getTrainingFoldView(const UINT foldIndex) const;
+
+    /**
+     Returns a view of the test dataset for the k-th fold for cross validation, no samples are copied.
+     The spiltDataIntoKFolds(UINT K) function should have been called once before using this function.
+
+     @param foldIndex: the index of the fold you want the test data for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns a view of the test samples, the view will be empty if the data has not been spilt into K folds
+    */
+    ClassificationDataView getTestFoldView(const UINT foldIndex) const;
+
+    /**
+     Returns a view of all the samples with the class label set by classLabel, no samples are copied.
+
+     @param classLabel: the class label of the class you want the samples for
+     @return returns a view containing all the samples with the matching classLabel
+    */
+    ClassificationDataView getClassView(const UINT classLabel) const;
+
+    /**
+     Gets a bootstrapped view of the current dataset, no samples are copied.  The samples are drawn in the same way as getBootstrappedDataset.
+     Unlike getBootstrappedDataset, the view only contains the classes that were drawn at least once.
+
+     @param numSamples: the size of the bootstrapped view, if zero the size will match the size of the current dataset
+     @param balanceDataset: if true will use stratified sampling to balance the view returned, otherwise will use random sampling
+     @param random: the random number generator used to draw the samples
+     @return returns a bootstrapped ClassificationDataView
+    */
+    ClassificationDataView getBootstrappedView(const UINT numSamples, const bool balanceDataset, Random &random) const;
     
 	/**
      Reformats the ClassificationData as RegressionData to enable regression algorithms like the MLP to be used as a classifier.
@@ -527,6 +656,21 @@ public:
     */
     Vector< ClassTracker > getClassTracker() const{ return classTracker; }
 
+    /**
+     @return returns true if samples with the default null gesture label can be added to the dataset, false otherwise
+    */
+    bool getAllowNullGestureClass() const{ return allowNullGestureClass; }
+
+    /**
+     @return returns true if the dataset should be scaled using the external ranges, false otherwise
+    */
+    bool getUseExternalRanges() const{ return useExternalRanges; }
+
+    /**
+     @return returns the external ranges set by the user, an empty Vector will be returned if they have not been set
+    */
+    Vector< MinMax > getExternalRanges() const{ return externalRanges; }
+
     /**
      Computes a histogram for a specific class.
 
@@ -675,6 +819,11 @@ public:
 
 private:
     
+    /**
+     Draws the indexs of the samples for a bootstrapped dataset, this is shared by getBootstrappedDataset and getBootstrappedView.
+    */
+    void drawBootstrappedIndexs(const UINT numBootstrapSamples, const bool balanceDataset, Random &random, Vector< UINT > &sampleIndexs) const;
+
     std::string datasetName;                                ///< The name of the dataset
     std::string infoText;                                   ///< Some infoText about the dataset
 	UINT numDimensions;										///< The number of dimensions in the dataset
@@ -20,6 +20,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "ClassificationDataStream.h"
+#include "../Util/CSVReader.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -46,6 +47,10 @@ ClassificationDataStream::ClassificationDataStream(const ClassificationDataStrea
     *this = rhs;
 }
 
+ClassificationDataStream::ClassificationDataStream(ClassificationDataStream &&rhs){
+    *this = std::move( rhs );
+}
+
 ClassificationDataStream::~ClassificationDataStream(){}
     
 ClassificationDataStream& ClassificationDataStream::operator=(const ClassificationDataStream &rhs){
@@ -70,6 +75,30 @@ ClassificationDataStream& ClassificationDataStream::operator=(const Classificati
     return *this;
 }
 
+ClassificationDataStream& ClassificationDataStream::operator=(ClassificationDataStream &&rhs){
+    if( this != &rhs){
+        this->datasetName = rhs.datasetName;
+        this->infoText = rhs.infoText;
+        this->numDimensions = rhs.numDimensions;
+        this->totalNumSamples = rhs.totalNumSamples;
+        this->lastClassID = rhs.lastClassID;
+        this->playbackIndex = rhs.playbackIndex;
+        this->trackingClass = rhs.trackingClass;
+        this->useExternalRanges = rhs.useExternalRanges;
+        this->externalRanges = rhs.externalRanges;
+        this->data = std::move( rhs.data );
+        this->classTracker = std::move( rhs.classTracker );
+        this->timeSeriesPositionTracker = std::move( rhs.timeSeriesPositionTracker );
+        this->debugLog = rhs.debugLog;
+        this->warningLog = rhs.warningLog;
+        this->errorLog = rhs.errorLog;
+
+        //Leave the rhs instance empty, as its samples have been moved to this instance
+        rhs.clear();
+    }
+    return *this;
+}
+
 void ClassificationDataStream::clear(){
 	totalNumSamples = 0;
 	playbackIndex = 0;
@@ -749,48 +778,67 @@ bool ClassificationDataStream::loadDatasetFromCSVFile(const std::string &filenam
     //Clear any previous data
     clear();
     
-    //Parse the CSV file
-    FileParser parser;
+    //Open the CSV file, the rows are parsed one at a time straight from the file buffer
+    CSVReader reader;
+    VectorFloat row;
     
-    if( !parser.parseCSVFile(filename,true) ){
+    if( !reader.open( filename ) || !reader.readRow( row ) ){
         errorLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - Failed to parse CSV file!" << std::endl;
         return false;
     }
     
-    if( !parser.getConsistentColumnSize() ){
-        errorLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - The CSV file does not have a consistent number of columns!" << std::endl;
+    const UINT numColumns = row.getSize();
+    if( numColumns <= 1 ){
+        errorLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - The CSV file does not have enough columns! It should contain at least two columns!" << std::endl;
         return false;
     }
     
-    if( parser.getColumnSize() <= 1 ){
-        errorLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - The CSV file does not have enough columns! It should contain at least two columns!" << std::endl;
+    if( classLabelColumnIndex >= numColumns ){
+        errorLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - The class label column index is larger than the number of columns in the CSV file!" << std::endl;
         return false;
     }
     
     //Set the number of dimensions
-    numDimensions = parser.getColumnSize()-1;
+    numDimensions = numColumns-1;
     UINT classLabel = 0;
     UINT j = 0;
-    UINT n = 0;
     VectorFloat sample(numDimensions);
-    for(UINT i=0; i<parser.getRowSize(); i++){
-        //Get the class label
-        classLabel = Util::stringToInt( parser[i][classLabelColumnIndex] );
+    UINT i = 0;
+    do{
+        if( row.getSize() != numColumns ){
+            errorLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - The CSV file does not have a consistent number of columns!" << std::endl;
+            clear();
+            return false;
+        }
+        
+        //Get the class label, it must be a non-negative integer that fits in a UINT
+        const Float label = row[classLabelColumnIndex];
+        if( !(label >= 0 && label <= std::numeric_limits< UINT >::max() && label == std::floor( label )) ){
+            errorLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - The class label on line " << reader.getLineNumber() << " is not valid, it must be a non-negative integer!" << std::endl;
+            clear();
+            return false;
+        }
+        classLabel = (UINT)label;
         
         //Get the sample data
         j=0;
-        n=0;
-        while( j != numDimensions ){
+        for(UINT n=0; n<numColumns; n++){
             if( n != classLabelColumnIndex ){
-                sample[j++] = Util::stringToFloat( parser[i][n] );
+                sample[j++] = row[n];
             }
-            n++;
         }
         
         //Add the labelled sample to the dataset
         if( !addSample(classLabel, sample) ){
             warningLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - Could not add sample " << i << " to the dataset!" << std::endl;
         }
+        i++;
+    }while( reader.readRow( row ) );
+    
+    if( reader.getError() ){
+        errorLog << "loadDatasetFromCSVFile(const std::string filename,const UINT classLabelColumnIndex) - Failed to parse row " << i << ", the CSV file must only contain numbers!" << std::endl;
+        clear();
+        return false;
     }
 
     return true;
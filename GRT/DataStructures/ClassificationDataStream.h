@@ -58,6 +58,13 @@ public:
 	 @param rhs: another instance of the ClassificationDataStream class from which the data will be copied to this instance
      */
 	ClassificationDataStream(const ClassificationDataStream &rhs);
+
+    /**
+     Move Constructor, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the ClassificationDataStream class from which the data will be moved to this instance
+     */
+	ClassificationDataStream(ClassificationDataStream &&rhs);
     
     /**
      Default Destructor
@@ -72,6 +79,14 @@ public:
      */
 	ClassificationDataStream& operator= (const ClassificationDataStream &rhs);
 
+    /**
+     Sets the move assignment operator, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the ClassificationDataStream class from which the data will be moved to this instance
+	 @return a reference to this instance of ClassificationDataStream
+     */
+	ClassificationDataStream& operator=(ClassificationDataStream &&rhs);
+
     /**
      Array Subscript Operator, returns the ClassificationSample at index i.
 	 It is up to the user to ensure that i is within the range of [0 totalNumSamples-1]
@@ -0,0 +1,355 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "ClassificationDataView.h"
+
+GRT_BEGIN_NAMESPACE
+
+ClassificationDataView::ClassificationDataView():data(NULL),errorLog("[ERROR ClassificationDataView]"),warningLog("[WARNING ClassificationDataView]"){
+}
+
+ClassificationDataView::ClassificationDataView(const ClassificationData &data):errorLog("[ERROR ClassificationDataView]"),warningLog("[WARNING ClassificationDataView]"){
+    this->data = &data;
+    const UINT M = data.getNumSamples();
+    indexs.resize( M );
+    for(UINT i=0; i<M; i++) indexs[i] = i;
+    updateClassTracker( true );
+}
+
+ClassificationDataView::ClassificationDataView(const ClassificationData &data,const Vector< UINT > &indexs,const bool keepEmptyClasses):errorLog("[ERROR ClassificationDataView]"),warningLog("[WARNING ClassificationDataView]"){
+    this->data = &data;
+    this->indexs = indexs;
+
+    //Drop any index that is not in the dataset, rather than letting it be dereferenced later
+    const UINT M = data.getNumSamples();
+    UINT numValid = 0;
+    for(UINT i=0; i<this->indexs.getSize(); i++){
+        if( this->indexs[i] < M ) this->indexs[ numValid++ ] = this->indexs[i];
+    }
+    if( numValid != this->indexs.getSize() ){
+        warningLog << "ClassificationDataView(...) - Ignoring " << this->indexs.getSize()-numValid << " indexs that are out of range of the dataset!" << std::endl;
+        this->indexs.resize( numValid );
+    }
+
+    updateClassTracker( keepEmptyClasses );
+}
+
+ClassificationDataView::ClassificationDataView(const ClassificationDataView &rhs):errorLog("[ERROR ClassificationDataView]"),warningLog("[WARNING ClassificationDataView]"){
+    *this = rhs;
+}
+
+ClassificationDataView::~ClassificationDataView(){
+}
+
+ClassificationDataView& ClassificationDataView::operator=(const ClassificationDataView &rhs){
+    if( this != &rhs ){
+        this->data = rhs.data;
+        this->indexs = rhs.indexs;
+        this->classTracker = rhs.classTracker;
+    }
+    return *this;
+}
+
+void ClassificationDataView::clear(){
+    data = NULL;
+    indexs.clear();
+    classTracker.clear();
+}
+
+ClassificationDataView ClassificationDataView::split(const UINT splitPercentage,const bool useStratifiedSampling,Random &random){
+
+    ClassificationDataView testView;
+
+    if( data == NULL ){
+        errorLog << "split(...) - The view does not refer to a dataset!" << std::endl;
+        return testView;
+    }
+
+    Vector< UINT > trainingIndexs;
+    Vector< UINT > testIndexs;
+    const UINT M = getNumSamples();
+    const UINT K = getNumClasses();
+
+    if( useStratifiedSampling ){
+        //Break the indexs into seperate classes
+        Vector< Vector< UINT > > classIndexs( K );
+        for(UINT i=0; i<M; i++){
+            const UINT classLabel = (*data)[ indexs[i] ].getClassLabel();
+            for(UINT k=0; k<K; k++){
+                if( classTracker[k].classLabel == classLabel ){
+                    classIndexs[k].push_back( indexs[i] );
+                    break;
+                }
+            }
+        }
+
+        //Randomize the order of the indexs in each class and add the first splitPercentage of each class to the training indexs
+        for(UINT k=0; k<K; k++){
+            random.shuffle( classIndexs[k] );
+            const UINT numTrainingExamples = (UINT) floor( Float(classIndexs[k].getSize()) / 100.0 * Float(splitPercentage) );
+            for(UINT i=0; i<classIndexs[k].getSize(); i++){
+                if( i < numTrainingExamples ) trainingIndexs.push_back( classIndexs[k][i] );
+                else testIndexs.push_back( classIndexs[k][i] );
+            }
+        }
+    }else{
+        const UINT numTrainingExamples = (UINT) floor( Float(M) / 100.0 * Float(splitPercentage) );
+        Vector< UINT > shuffledIndexs = indexs;
+        random.shuffle( shuffledIndexs );
+        trainingIndexs.insert( trainingIndexs.end(), shuffledIndexs.begin(), shuffledIndexs.begin()+numTrainingExamples );
+        testIndexs.insert( testIndexs.end(), shuffledIndexs.begin()+numTrainingExamples, shuffledIndexs.end() );
+    }
+
+    //Both views keep all the classes of this view, even if they have no samples in one of the views
+    testView.data = data;
+    testView.indexs = testIndexs;
+    testView.updateClassTracker( true );
+
+    indexs = trainingIndexs;
+    updateClassTracker( true );
+
+    return testView;
+}
+
+ClassificationDataView ClassificationDataView::getClassView(const UINT classLabel) const{
+
+    ClassificationDataView classView;
+    if( data == NULL ) return classView;
+
+    UINT numClassSamples = 0;
+    for(UINT k=0; k<classTracker.getSize(); k++){
+        if( classTracker[k].classLabel == classLabel ){
+            numClassSamples = classTracker[k].counter;
+            break;
+        }
+    }
+
+    classView.data = data;
+    classView.indexs.reserve( numClassSamples );
+    for(UINT i=0; i<indexs.getSize(); i++){
+        if( (*data)[ indexs[i] ].getClassLabel() == classLabel ){
+            classView.indexs.push_back( indexs[i] );
+        }
+    }
+    classView.updateClassTracker( false );
+
+    return classView;
+}
+
+ClassificationDataView ClassificationDataView::getBootstrappedView(const UINT numSamples,const bool balanceDataset,Random &random,const bool keepEmptyClasses) const{
+
+    ClassificationDataView bootstrappedView;
+    if( data == NULL || indexs.getSize() == 0 ) return bootstrappedView;
+
+    const UINT M = getNumSamples();
+    const UINT numBootstrapSamples = numSamples > 0 ? numSamples : M;
+    Vector< UINT > sampleIndexs( numBootstrapSamples );
+
+    if( balanceDataset ){
+        //Group the indexs of each class, any class without samples in this view can not be drawn from
+        Vector< Vector< UINT > > classIndexs( classTracker.getSize() );
+        for(UINT i=0; i<M; i++){
+            const UINT classLabel = (*data)[ indexs[i] ].getClassLabel();
+            for(UINT k=0; k<classTracker.getSize(); k++){
+                if( classTracker[k].classLabel == classLabel ){
+                    classIndexs[k].push_back( indexs[i] );
+                    break;
+                }
+            }
+        }
+        UINT K = 0;
+        for(UINT k=0; k<classIndexs.getSize(); k++){
+            if( classIndexs[k].getSize() > 0 ) classIndexs[ K++ ] = classIndexs[k];
+        }
+        classIndexs.resize( K );
+
+        //Randomly select the samples from each class
+        const UINT numSamplesPerClass = (UINT)floor( numBootstrapSamples / Float(K) );
+        UINT classIndex = 0;
+        UINT classCounter = 0;
+        for(UINT i=0; i<numBootstrapSamples; i++){
+            sampleIndexs[i] = classIndexs[ classIndex ][ random.getRandomNumberInt(0, classIndexs[ classIndex ].getSize()) ];
+            if( classCounter++ >= numSamplesPerClass && classIndex+1 < K ){
+                classCounter = 0;
+                classIndex++;
+            }
+        }
+    }else{
+        for(UINT i=0; i<numBootstrapSamples; i++){
+            sampleIndexs[i] = indexs[ random.getRandomNumberInt(0, M) ];
+        }
+    }
+
+    bootstrappedView.data = data;
+    bootstrappedView.indexs = sampleIndexs;
+    bootstrappedView.updateClassTracker( classTracker, keepEmptyClasses );
+
+    return bootstrappedView;
+}
+
+ClassificationData ClassificationDataView::getClassificationData() const{
+
+    ClassificationData copy;
+    if( data == NULL ) return copy;
+
+    copy.setNumDimensions( data->getNumDimensions() );
+    copy.setAllowNullGestureClass( data->getAllowNullGestureClass() );
+    copy.setExternalRanges( data->getExternalRanges(), data->getUseExternalRanges() );
+
+    //Add the classes first, so the copy has the same class order as the view, any class without samples is skipped
+    for(UINT k=0; k<classTracker.getSize(); k++){
+        if( classTracker[k].counter > 0 ) copy.addClass( classTracker[k].classLabel, classTracker[k].className );
+    }
+
+    const UINT M = getNumSamples();
+    copy.reserve( M );
+    for(UINT i=0; i<M; i++){
+        const ClassificationSample &sample = (*data)[ indexs[i] ];
+        copy.addSample( sample.getClassLabel(), sample.getSample() );
+    }
+
+    return copy;
+}
+
+MatrixFloat ClassificationDataView::getDataAsMatrixFloat() const{
+
+    const UINT M = getNumSamples();
+    const UINT N = getNumDimensions();
+    MatrixFloat matrix(M,N);
+
+    for(UINT i=0; i<M; i++){
+        const VectorFloat &sample = (*data)[ indexs[i] ].getSample();
+        std::copy( sample.begin(), sample.begin()+N, matrix[i] );
+    }
+
+    return matrix;
+}
+
+MatrixFloat ClassificationDataView::getDataAsMatrixFloat(const Vector< MinMax > &ranges,const Float minTarget,const Float maxTarget) const{
+
+    const UINT M = getNumSamples();
+    const UINT N = getNumDimensions();
+    if( ranges.getSize() != N ){
+        errorLog << "getDataAsMatrixFloat(...) - The number of ranges (" << ranges.getSize() << ") does not match the number of dimensions (" << N << ")!" << std::endl;
+        return MatrixFloat();
+    }
+
+    MatrixFloat matrix(M,N);
+    for(UINT i=0; i<M; i++){
+        const VectorFloat &sample = (*data)[ indexs[i] ].getSample();
+        for(UINT j=0; j<N; j++){
+            matrix[i][j] = grt_scale(sample[j],ranges[j].minValue,ranges[j].maxValue,minTarget,maxTarget);
+        }
+    }
+
+    return matrix;
+}
+
+bool ClassificationDataView::getIsWholeDataset() const{
+
+    if( data == NULL ) return false;
+    if( indexs.getSize() != data->getNumSamples() ) return false;
+    if( classTracker.getSize() != data->getNumClasses() ) return false;
+
+    for(UINT i=0; i<indexs.getSize(); i++){
+        if( indexs[i] != i ) return false;
+    }
+
+    return true;
+}
+
+Vector< UINT > ClassificationDataView::getClassLabels() const{
+    Vector< UINT > classLabels( classTracker.getSize() );
+    for(UINT k=0; k<classTracker.getSize(); k++){
+        classLabels[k] = classTracker[k].classLabel;
+    }
+    return classLabels;
+}
+
+Vector< MinMax > ClassificationDataView::getRanges() const{
+
+    if( data == NULL ) return Vector< MinMax >();
+
+    //If the dataset should be scaled using the external ranges then return the external ranges
+    if( data->getUseExternalRanges() ) return data->getExternalRanges();
+
+    const UINT M = getNumSamples();
+    const UINT N = getNumDimensions();
+    Vector< MinMax > ranges( N );
+    if( M == 0 ) return ranges;
+
+    const VectorFloat &first = (*data)[ indexs[0] ].getSample();
+    for(UINT j=0; j<N; j++){
+        ranges[j].minValue = first[j];
+        ranges[j].maxValue = first[j];
+    }
+    for(UINT i=1; i<M; i++){
+        const VectorFloat &sample = (*data)[ indexs[i] ].getSample();
+        for(UINT j=0; j<N; j++){
+            if( sample[j] < ranges[j].minValue ) ranges[j].minValue = sample[j];
+            else if( sample[j] > ranges[j].maxValue ) ranges[j].maxValue = sample[j];
+        }
+    }
+
+    return ranges;
+}
+
+void ClassificationDataView::removeEmptyClasses(){
+    if( data != NULL ) updateClassTracker( false );
+}
+
+void ClassificationDataView::updateClassTracker(const bool keepEmptyClasses){
+    //Start from the classes of the dataset, so views such as cross validation folds keep every class of the dataset
+    updateClassTracker( data->getClassTracker(), keepEmptyClasses );
+}
+
+void ClassificationDataView::updateClassTracker(const Vector< ClassTracker > &classes,const bool keepEmptyClasses){
+
+    //Copy the classes first, as they may be the class tracker of this view
+    const Vector< ClassTracker > startClasses = classes;
+    const UINT K = startClasses.getSize();
+    classTracker.resize( K );
+    for(UINT k=0; k<K; k++){
+        classTracker[k] = startClasses[k];
+        classTracker[k].counter = 0;
+    }
+    sort( classTracker.begin(), classTracker.end(), ClassTracker::sortByClassLabelAscending );
+
+    for(UINT i=0; i<indexs.getSize(); i++){
+        const UINT classLabel = (*data)[ indexs[i] ].getClassLabel();
+        for(UINT k=0; k<K; k++){
+            if( classTracker[k].classLabel == classLabel ){
+                classTracker[k].counter++;
+                break;
+            }
+        }
+    }
+
+    if( !keepEmptyClasses ){
+        UINT numClasses = 0;
+        for(UINT k=0; k<K; k++){
+            if( classTracker[k].counter > 0 ) classTracker[ numClasses++ ] = classTracker[k];
+        }
+        classTracker.resize( numClasses );
+    }
+}
+
+GRT_END_NAMESPACE
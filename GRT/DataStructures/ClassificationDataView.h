@@ -0,0 +1,239 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+
+ @brief The ClassificationDataView class gives access to a subset of the samples in a ClassificationData instance without copying them.
+
+ A view only stores a reference to its dataset and the indexs of the samples it contains, so the folds used for cross validation,
+ the bootstrapped datasets used by the ensemble algorithms and the per-class subsets used by many of the classifiers can be created
+ without duplicating the training data.  Views are created using the ClassificationData::getView, getTrainingFoldView, getTestFoldView,
+ getClassView and getBootstrappedView functions, and can be passed to the train function of any classifier.  ANBC, KNN, GMM, MinDist,
+ DecisionTree, RandomForests, SVM, Softmax and the GestureRecognitionPipeline (which passes the view on to its classifier) train directly
+ from a view, only copying the samples into the structures their models are built from.  All other classifiers are trained with a copy
+ of the samples in the view made by getClassificationData.
+
+ The dataset a view refers to must outlive the view and must not be modified while the view is being used.
+ */
+
+/**
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_CLASSIFICATION_DATA_VIEW_HEADER
+#define GRT_CLASSIFICATION_DATA_VIEW_HEADER
+
+#include "ClassificationData.h"
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API ClassificationDataView{
+public:
+    /**
+     Default Constructor, creates an empty view that does not refer to any dataset.
+     */
+    ClassificationDataView();
+
+    /**
+     Creates a view of all the samples in the dataset.
+
+     @param data: the dataset the view refers to, this must outlive the view
+     */
+    explicit ClassificationDataView(const ClassificationData &data);
+
+    /**
+     Creates a view of the samples in the dataset at the given indexs.  The same index can be listed more than once (for example in a bootstrapped view).
+
+     @param data: the dataset the view refers to, this must outlive the view
+     @param indexs: the indexs of the samples in the view, each index must be less than the number of samples in the dataset
+     @param keepEmptyClasses: if true the view keeps all the classes of the dataset, otherwise only the classes with at least one sample in the view are kept
+     */
+    ClassificationDataView(const ClassificationData &data,const Vector< UINT > &indexs,const bool keepEmptyClasses = true);
+
+    /**
+     Copy Constructor, the new view refers to the same dataset as the rhs view.
+     */
+    ClassificationDataView(const ClassificationDataView &rhs);
+
+    /**
+     Default Destructor
+     */
+    ~ClassificationDataView();
+
+    /**
+     Sets the equals operator, the view will refer to the same dataset and samples as the rhs view.
+     */
+    ClassificationDataView& operator=(const ClassificationDataView &rhs);
+
+    /**
+     Array Subscript Operator, returns the i'th ClassificationSample in the view.
+     It is up to the user to ensure that i is within the range of [0 numSamples-1]
+
+     @param i: the index of the sample in the view
+     @return a const reference to the i'th ClassificationSample in the view
+     */
+    inline const ClassificationSample& operator[] (const UINT i) const{
+        return (*data)[ indexs[i] ];
+    }
+
+    /**
+     Clears the view, the view will no longer refer to any dataset.
+     */
+    void clear();
+
+    /**
+     Splits the view into a training view (which is kept by this instance) and a testing/validation view, which is returned.
+     No samples are copied, both views refer to the same dataset as this view.
+
+     @param splitPercentage: sets the percentage of samples which remain in this view, the remaining samples are returned as the testing/validation view
+     @param useStratifiedSampling: sets if the samples should be broken into homogeneous groups first before randomly being spilt
+     @param random: the random number generator used to partition the samples
+     @return a new ClassificationDataView, containing the samples not kept by this view
+     */
+    ClassificationDataView split(const UINT splitPercentage,const bool useStratifiedSampling,Random &random);
+
+    /**
+     Returns a view of all the samples in this view with the given class label.
+
+     @param classLabel: the class label of the class you want the samples for
+     @return a view containing only the samples of the class
+     */
+    ClassificationDataView getClassView(const UINT classLabel) const;
+
+    /**
+     Gets a bootstrapped view of the samples in this view, no samples are copied.  The samples are drawn in the same way as ClassificationData::getBootstrappedDataset,
+     if the view is balanced then only the classes with samples in this view are drawn from.
+
+     @param numSamples: the number of samples in the bootstrapped view, if zero then the bootstrapped view will have the same number of samples as this view
+     @param balanceDataset: if true then the same number of samples will be drawn from each class
+     @param random: the random number generator used to draw the samples
+     @param keepEmptyClasses: if true the bootstrapped view keeps all the classes of this view, otherwise only the classes that were drawn at least once are kept
+     @return a new ClassificationDataView containing the bootstrapped samples, this will be empty if this view has no samples
+     */
+    ClassificationDataView getBootstrappedView(const UINT numSamples,const bool balanceDataset,Random &random,const bool keepEmptyClasses = false) const;
+
+    /**
+     Copies the samples in the view into a new ClassificationData instance.  This should only be used for algorithms that need to modify their training data.
+     Only the classes with at least one sample in the view are added to the copy, so a classifier trained with the copy never sees an empty class.
+     The copy uses the external ranges of the dataset the view refers to, if they are set, so it is scaled in the same way as the view.
+     Note that the copies made by ClassificationData::getTrainingFoldData and getTestFoldData do not keep the external ranges.
+
+     @return a new dataset containing a copy of the samples in the view
+     */
+    ClassificationData getClassificationData() const;
+
+    /**
+     Copies the samples in the view into a MatrixFloat, one row per sample. This returns just the data, not the labels.
+
+     @return an M by N MatrixFloat, where M is the number of samples in the view and N is the number of dimensions
+     */
+    MatrixFloat getDataAsMatrixFloat() const;
+
+    /**
+     Copies the samples in the view into a MatrixFloat, one row per sample, scaling each value from the given ranges to the target range as it is copied.
+     This lets an algorithm train with scaled data without modifying the dataset the view refers to.
+
+     @param ranges: the ranges each dimension is scaled from, this must have one MinMax for each dimension
+     @param minTarget: the minimum value the data is scaled to
+     @param maxTarget: the maximum value the data is scaled to
+     @return an M by N MatrixFloat, where M is the number of samples in the view and N is the number of dimensions, this will be empty if the ranges are not valid
+     */
+    MatrixFloat getDataAsMatrixFloat(const Vector< MinMax > &ranges,const Float minTarget,const Float maxTarget) const;
+
+    /**
+     @return true if the view refers to a dataset, false otherwise
+     */
+    bool getIsValid() const{ return data != NULL; }
+
+    /**
+     @return true if the view contains every sample of the dataset it refers to, in the same order as the dataset, false otherwise
+     */
+    bool getIsWholeDataset() const;
+
+    /**
+     @return the number of samples in the view
+     */
+    UINT getNumSamples() const{ return indexs.getSize(); }
+
+    /**
+     @return the number of dimensions of the dataset the view refers to
+     */
+    UINT getNumDimensions() const{ return data != NULL ? data->getNumDimensions() : 0; }
+
+    /**
+     @return the number of classes in the view
+     */
+    UINT getNumClasses() const{ return classTracker.getSize(); }
+
+    /**
+     Gets the index of the i'th sample of the view in the dataset the view refers to.
+
+     @param i: the index of the sample in the view
+     @return the index of the sample in the dataset
+     */
+    UINT getIndex(const UINT i) const{ return indexs[i]; }
+
+    /**
+     @return the indexs, in the dataset the view refers to, of the samples in the view
+     */
+    const Vector< UINT >& getIndexs() const{ return indexs; }
+
+    /**
+     @return a reference to the dataset the view refers to, the view must be valid
+     */
+    const ClassificationData& getDataset() const{ return *data; }
+
+    /**
+     Gets the class tracker for the view, the counter of each class is the number of samples of that class in the view.
+     The classes are sorted in ascending order of their class labels.
+
+     @return a Vector of ClassTracker for the classes in the view
+     */
+    const Vector< ClassTracker >& getClassTracker() const{ return classTracker; }
+
+    /**
+     @return the class labels of the classes in the view, sorted in ascending order
+     */
+    Vector< UINT > getClassLabels() const;
+
+    /**
+     Gets the ranges of the samples in the view.  If the dataset the view refers to is using external ranges then the external ranges are returned.
+
+     @return a Vector of MinMax, one for each dimension
+     */
+    Vector< MinMax > getRanges() const;
+
+    /**
+     Removes any class that has no samples in the view, so the view can be used to train a classifier that needs samples for every class.
+     */
+    void removeEmptyClasses();
+
+protected:
+    void updateClassTracker(const bool keepEmptyClasses);
+    void updateClassTracker(const Vector< ClassTracker > &classes,const bool keepEmptyClasses);
+
+    const ClassificationData *data;                         ///< The dataset the view refers to
+    Vector< UINT > indexs;                                  ///< The indexs of the samples in the view
+    Vector< ClassTracker > classTracker;                    ///< The number of samples of each class in the view
+    ErrorLog errorLog;
+    WarningLog warningLog;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_CLASSIFICATION_DATA_VIEW_HEADER
@@ -134,6 +134,21 @@ public:
         
     }
     
+    /**
+     Move Constructor, moves the data from the rhs Matrix to this Matrix without copying it
+     
+     @param rhs: the Matrix from which the data will be moved, this will be empty after the move
+    */
+    Matrix(Matrix &&rhs):errorLog("[ERROR Matrix]"){
+        this->dataPtr = NULL;
+        this->rowPtr = NULL;
+        this->rows = 0;
+        this->cols = 0;
+        this->size = 0;
+        this->capacity = 0;
+        this->move( rhs );
+    }
+    
     /**
      Destructor, cleans up any memory
     */
@@ -155,6 +170,20 @@ public:
         return *this;
     }
     
+    /**
+     Defines how the data from the rhs Matrix should be moved to this Matrix, the data is not copied
+     
+     @param rhs: another instance of a Matrix, this will be empty after the move
+     @return returns a reference to this instance of the Matrix
+    */
+    Matrix& operator=(Matrix &&rhs){
+        if(this!=&rhs){
+            this->clear();
+            this->move( rhs );
+        }
+        return *this;
+    }
+    
     /**
      Returns a pointer to the data at row r
      
@@ -354,6 +383,34 @@ public:
         return true;
     }
 
+    /**
+     Moves the data from the rhs Matrix to this Matrix, by taking ownership of the memory of the rhs Matrix rather than copying it.
+     Any existing data in this Matrix should be cleared before calling this function. The rhs Matrix will be empty after the move.
+     
+     @param rhs: the Matrix from which the data will be moved
+     @return returns true if the data was moved, false otherwise
+    */
+    bool move( Matrix<T> &rhs ){
+        
+        if( this == &rhs ) return false;
+        
+        this->rows = rhs.rows;
+        this->cols = rhs.cols;
+        this->size = rhs.size;
+        this->capacity = rhs.capacity;
+        this->dataPtr = rhs.dataPtr;
+        this->rowPtr = rhs.rowPtr;
+        
+        rhs.rows = 0;
+        rhs.cols = 0;
+        rhs.size = 0;
+        rhs.capacity = 0;
+        rhs.dataPtr = NULL;
+        rhs.rowPtr = NULL;
+        
+        return true;
+    }
+
     /**
      @deprecated
      This function is now depreciated! You should use setAll(const T &value) instead.
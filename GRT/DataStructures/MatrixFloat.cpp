@@ -20,6 +20,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "MatrixFloat.h"
+#include "../Util/CSVReader.h"
 
 GRT_BEGIN_NAMESPACE
    
@@ -54,6 +55,18 @@ MatrixFloat::MatrixFloat(const MatrixFloat &rhs){
     this->copy( rhs );
 }
     
+MatrixFloat::MatrixFloat(MatrixFloat &&rhs){
+    warningLog.setKey("[WARNING MatrixFloat]");
+    errorLog.setKey("[ERROR MatrixFloat]");
+    this->dataPtr = NULL;
+    this->rowPtr = NULL;
+    this->rows = 0;
+    this->cols = 0;
+    this->size = 0;
+    this->capacity = 0;
+    this->move( rhs );
+}
+    
 MatrixFloat::MatrixFloat(const Matrix< Float > &rhs){
     warningLog.setKey("[WARNING MatrixFloat]");
     errorLog.setKey("[ERROR MatrixFloat]");
@@ -101,6 +114,14 @@ MatrixFloat& MatrixFloat::operator=(const MatrixFloat &rhs){
     return *this;
 }
     
+MatrixFloat& MatrixFloat::operator=(MatrixFloat &&rhs){
+    if( this != &rhs ){
+        this->clear();
+        this->move( rhs );
+    }
+    return *this;
+}
+    
 MatrixFloat& MatrixFloat::operator=(const Matrix< Float > &rhs){
     if( this != &rhs ){
         this->clear();
@@ -248,18 +269,39 @@ VectorFloat MatrixFloat::multiple(const VectorFloat &b) const{
     }
     
     VectorFloat c(M);
-    const Float *pb = &b[0];
-    Float *pc = &c[0];
+    if( M == 0 ) return c;
     
-    unsigned int i,j = 0;
-    for(i=0; i<rows; i++){
-        pc[i] = 0;
-        for(j=0; j<cols; j++){
-            pc[i] += dataPtr[i*cols+j]*pb[j];
+    GEMM::gemv( false, M, N, 1.0, dataPtr, cols, &b[0], 0.0, &c[0] );
+    
+    return c;
+}
+    
+bool MatrixFloat::multiple(const VectorFloat &b,VectorFloat &c,const Float alpha,const Float beta,const bool aTranspose) const{
+    
+    const unsigned int K = !aTranspose ? cols : rows;
+    const unsigned int M = !aTranspose ? rows : cols;
+    
+    if( b.getSize() != K ){
+        errorLog << "multiple(const VectorFloat &b,VectorFloat &c,...) - The size of b (" << b.getSize() << ") does not match the matrix size (" << K << ")" << std::endl;
+        return false;
+    }
+    
+    if( &b == &c ){
+        errorLog << "multiple(const VectorFloat &b,VectorFloat &c,...) - The output vector can not be the input vector!" << std::endl;
+        return false;
+    }
+    
+    if( c.getSize() != M ){
+        if( beta != 0 ){
+            errorLog << "multiple(const VectorFloat &b,VectorFloat &c,...) - The size of c (" << c.getSize() << ") does not match the matrix size (" << M << ")" << std::endl;
+            return false;
         }
+        c.resize( M );
     }
     
-    return c;
+    if( M == 0 ) return true;
+    
+    return GEMM::gemv( aTranspose, rows, cols, alpha, dataPtr, cols, K > 0 ? &b[0] : NULL, beta, &c[0] );
 }
     
 MatrixFloat MatrixFloat::multiple(const MatrixFloat &b) const{
@@ -275,18 +317,9 @@ MatrixFloat MatrixFloat::multiple(const MatrixFloat &b) const{
     }
     
     MatrixFloat c(M,L);
-    Float **pb = b.getDataPointer();
-    Float **pc = c.getDataPointer();
+    if( M == 0 || L == 0 ) return c;
     
-    unsigned int i,j,k = 0;
-    for(i=0; i<M; i++){
-        for(j=0; j<L; j++){
-            pc[i][j] = 0;
-            for(k=0; k<K; k++){
-                pc[i][j] += dataPtr[i*cols+k] * pb[k][j];
-            }
-        }
-    }
+    GEMM::gemm( false, false, M, L, K, 1.0, dataPtr, cols, b.getData(), L, 0.0, c.getData(), L );
     
     return c;
 }
@@ -303,42 +336,51 @@ bool MatrixFloat::multiple(const MatrixFloat &a,const MatrixFloat &b,const bool
         return false;
     }
     
+    if( this == &a || this == &b ){
+        errorLog << "multiple(const MatrixFloat &a,const MatrixFloat &b,const bool aTranspose) - The output matrix can not be one of the input matrices!" << std::endl;
+        return false;
+    }
+    
     if( !resize( M, L ) ){
         errorLog << "multiple(const MatrixFloat &b,const MatrixFloat &c,const bool bTranspose) - Failed to resize matrix!" << std::endl;
         return false;
     }
     
-    unsigned int i, j, k = 0;
+    return GEMM::gemm( aTranspose, false, M, L, K, 1.0, a.getData(), a.getNumCols(), b.getData(), L, 0.0, dataPtr, cols );
+}
     
-    //Using direct pointers really helps speed up the computation time
-    Float **pa = a.getDataPointer();
-    Float **pb = b.getDataPointer();
+bool MatrixFloat::multiple(const MatrixFloat &a,const MatrixFloat &b,const Float alpha,const Float beta,const bool aTranspose,const bool bTranspose){
     
-    if( aTranspose ){
-        
-        for(j=0; j<L; j++){
-            for(i=0; i<M; i++){
-                dataPtr[i*cols+j] = 0;
-                for(k=0; k<K; k++){
-                    dataPtr[i*cols+j] += pa[k][i] * pb[k][j];
-                }
-            }
+    const unsigned int M = !aTranspose ? a.getNumRows() : a.getNumCols();
+    const unsigned int K = !aTranspose ? a.getNumCols() : a.getNumRows();
+    const unsigned int bK = !bTranspose ? b.getNumRows() : b.getNumCols();
+    const unsigned int N = !bTranspose ? b.getNumCols() : b.getNumRows();
+    
+    if( K != bK ) {
+        errorLog << "multiple(const MatrixFloat &a,const MatrixFloat &b,alpha,beta,...) - The inner dimension of a (" << K << ") does not match the inner dimension of b (" << bK << ")" << std::endl;
+        return false;
+    }
+    
+    if( this == &a || this == &b ){
+        errorLog << "multiple(const MatrixFloat &a,const MatrixFloat &b,alpha,beta,...) - The output matrix can not be one of the input matrices!" << std::endl;
+        return false;
+    }
+    
+    if( rows != M || cols != N ){
+        //The existing values are only needed if beta is not zero, in which case the size must already match
+        if( beta != 0 ){
+            errorLog << "multiple(const MatrixFloat &a,const MatrixFloat &b,alpha,beta,...) - The size of this matrix [" << rows << " " << cols << "] does not match the output size [" << M << " " << N << "]" << std::endl;
+            return false;
         }
-        
-    }else{
-        
-        for(j=0; j<L; j++){
-            for(i=0; i<M; i++){
-                dataPtr[i*cols+j] = 0;
-                for(k=0; k<K; k++){
-                    dataPtr[i*cols+j] += pa[i][k] * pb[k][j];
-                }
-            }
+        if( !resize( M, N ) ){
+            errorLog << "multiple(const MatrixFloat &a,const MatrixFloat &b,alpha,beta,...) - Failed to resize matrix!" << std::endl;
+            return false;
         }
-        
     }
     
-    return true;
+    if( M == 0 || N == 0 ) return true;
+    
+    return GEMM::gemm( aTranspose, bTranspose, M, N, K, alpha, a.getData(), a.getNumCols(), b.getData(), b.getNumCols(), beta, dataPtr, cols );
 }
     
 bool MatrixFloat::add(const MatrixFloat &b){
@@ -509,16 +551,19 @@ MatrixFloat MatrixFloat::getCovarianceMatrix() const{
     Vector<Float> mean = getMean();
     MatrixFloat covMatrix(cols,cols);
     
-    for(unsigned int j=0; j<cols; j++){
-        for(unsigned int k=0; k<cols; k++){
-            covMatrix[j][k] = 0;
-            for(unsigned int i=0; i<rows; i++){
-                covMatrix[j][k] += (dataPtr[i*cols+j]-mean[j]) * (dataPtr[i*cols+k]-mean[k]);
-            }
-            covMatrix[j][k] /= Float(rows-1);
+    if( rows == 0 || cols == 0 ) return covMatrix;
+    
+    //Center the data and compute the covariance as (X'X)/(rows-1), which lets the product run through the blocked GEMM kernels
+    MatrixFloat centered(rows,cols);
+    Float *pc = centered.getData();
+    for(unsigned int i=0; i<rows; i++){
+        for(unsigned int j=0; j<cols; j++){
+            pc[i*cols+j] = dataPtr[i*cols+j] - mean[j];
         }
     }
     
+    GEMM::gemm( true, false, cols, cols, rows, 1.0/Float(rows-1), pc, cols, pc, cols, 0.0, covMatrix.getData(), cols );
+    
     return covMatrix;
 }
     
@@ -569,101 +614,35 @@ bool MatrixFloat::load(const std::string &filename,const char seperator){
     clear();
     
     //Open the file
-    std::ifstream file( filename.c_str(), std::ifstream::in );
-    if ( !file.is_open() ){
-        warningLog << "parseFile(...) - Failed to open file: " << filename << std::endl;
+    CSVReader reader( seperator );
+    if ( !reader.open( filename ) ){
+        warningLog << "load(...) - Failed to open file: " << filename << std::endl;
         return false;
     }
     
-    Vector< std::string > vec;
-    VectorFloat row;
-    std::string line;
-    std::string columnString = "";
-    const int sepValue = seperator;
+    //Count the number of rows and columns in the file
     unsigned int rowCounter = 0;
     unsigned int columnCounter = 0;
-    unsigned int length = 0;
-    
-    //Count the number of columns in the first row
-    if( !getline(file,line) ){
-        warningLog << "parseFile(...) - Failed to read first row!" << std::endl;
+    if( !reader.countRows( rowCounter, columnCounter ) || rowCounter == 0 ){
+        warningLog << "load(...) - Failed to read first row!" << std::endl;
         return false;
     }
     
-    length = (unsigned int)line.length();
-    for(unsigned int i=0; i<length; i++){
-        if( int(line[i]) == sepValue ){
-            columnCounter++;
-        }
-    }
-    columnCounter++;
-
-    std::cout << "counting rows..." << std::endl;
-    
-    //Count the number of rows in the file
-    rowCounter = 1;
-    while ( getline(file,line) ){
-        rowCounter++;
-    }
-
-    std::cout << "matrix size: " << rowCounter << " " << columnCounter << std::endl;
-    
     //Assign the memory
     if( !resize(rowCounter, columnCounter) ){
-        warningLog << "parseFile(...) - Failed to resize memory!" << std::endl;
+        warningLog << "load(...) - Failed to resize memory!" << std::endl;
         return false;
     }
     
-    //Reset the file read pointer
-    file.close();
-    file.open( filename.c_str(), std::ifstream::in );
-    rowCounter = 0;
-    
-    //Loop over each line of data and parse the contents
-    while ( getline(file,line) )
-    {
-        //Scan the line contents for the seperator token and parse the contents between each token
-        vec.clear();
-        columnString = "";
-        length = (unsigned int)line.length();
-        for(unsigned int i=0; i<length; i++){
-            if( int(line[i]) == sepValue ){
-                vec.push_back( columnString );
-                columnString = "";
-            }else columnString += line[i];
-        }
-        
-        //Add the last column
-        vec.push_back( columnString );
-        
-        //Check to make sure all the columns are consistent
-        if( columnCounter != vec.size() ){
+    //Parse each row straight into the matrix
+    for(unsigned int i=0; i<rowCounter; i++){
+        if( !reader.readRow( dataPtr + i*cols, columnCounter ) ){
             clear();
-            warningLog << "parseFile(...) - Found inconsistent column size in row " << rowCounter;
-            warningLog << " ColumnSize: " << columnCounter << " LastColumnSize: " << vec.size() << std::endl;
+            warningLog << "load(...) - Failed to parse row " << i << ", the file must only contain numbers and have a consistent number of columns!" << std::endl;
             return false;
         }
-        
-        //Remove the new line character from the string in the last column
-        if( vec.size() >= 1 ){
-            size_t K = vec.size()-1;
-            size_t foundA = vec[ K ].find('\n');
-            size_t foundB = vec[K ].find('\r');
-            if( foundA != std::string::npos || foundB != std::string::npos ){
-                vec[ K ] = vec[ K ].substr(0,vec[ K ].length()-1);
-            }
-        }
-        
-        //Convert the string column values to Float values
-        for(unsigned int j=0; j<columnCounter; j++){
-            dataPtr[rowCounter*cols+j] = grt_from_str< Float >( vec[j] );
-        }
-        rowCounter++;
     }
     
-    //Close the file
-    file.close();
-    
     return true;
 }
     
@@ -30,6 +30,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../Util/WarningLog.h"
 #include "../Util/FileParser.h"
 #include "../Util/ErrorLog.h"
+#include "../Util/GEMM.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -55,6 +56,13 @@ public:
      */
     GRT_API MatrixFloat(const MatrixFloat &rhs);
     
+    /**
+     Move Constructor, moves the values from the rhs MatrixFloat to this MatrixFloat instance without copying them
+     
+     @param rhs: the MatrixFloat from which the values will be moved, this will be empty after the move
+     */
+    GRT_API MatrixFloat(MatrixFloat &&rhs);
+    
     /**
      Copy Constructor, copies the values from the rhs Matrix to this MatrixFloat instance
      
@@ -82,6 +90,14 @@ public:
      */
     GRT_API MatrixFloat& operator=(const MatrixFloat &rhs);
     
+    /**
+     Defines how the data from the rhs MatrixFloat should be moved to this MatrixFloat, the values are not copied
+     
+     @param rhs: another instance of a MatrixFloat, this will be empty after the move
+     @return returns a reference to this instance of the MatrixFloat
+     */
+    GRT_API MatrixFloat& operator=(MatrixFloat &&rhs);
+    
     /**
      Defines how the data from the rhs Matrix< Float > should be copied to this MatrixFloat
      
@@ -223,6 +239,20 @@ public:
      */
     GRT_API VectorFloat multiple(const VectorFloat &b) const;
     
+    /**
+     Performs the multiplication of this matrix (a) by the vector b, storing the result in the vector c without allocating a new vector.
+     This gives: c = alpha * a * b + beta * c, or if the aTranspose value is true: c = alpha * a' * b + beta * c
+     If beta is zero then c will be resized if needed, otherwise the size of c must already match the output size.
+     
+     @param b: the vector to multiple with this matrix
+     @param c: the vector that will store the result, this can not be the vector b
+     @param alpha: the scalar applied to the matrix-vector product
+     @param beta: the scalar applied to the existing values in c
+     @param aTranspose: a flag to indicate if this matrix should be transposed
+     @return true if the operation was completed successfully, false otherwise
+     */
+    GRT_API bool multiple(const VectorFloat &b,VectorFloat &c,const Float alpha = 1.0,const Float beta = 0.0,const bool aTranspose = false) const;
+    
     /**
      Performs the multiplication of this matrix (a) by the matrix b.
      This will return a new matrix (c): c = a * b
@@ -244,6 +274,21 @@ public:
      */
     GRT_API bool multiple(const MatrixFloat &a,const MatrixFloat &b,const bool aTranspose = false);
     
+    /**
+     Performs the general matrix multiplication c = alpha * op(a) * op(b) + beta * c, where this matrix is c and op(x) is either x or x'.
+     No new memory is allocated if this matrix already has the correct size. If beta is zero then this matrix will be resized if needed,
+     otherwise its size must already match the output size. This matrix can not be a or b.
+     
+     @param a: the matrix to multiple with b
+     @param b: the matrix to multiple with a
+     @param alpha: the scalar applied to the matrix product
+     @param beta: the scalar applied to the existing values in this matrix
+     @param aTranspose: a flag to indicate if matrix a should be transposed
+     @param bTranspose: a flag to indicate if matrix b should be transposed
+     @return true if the operation was completed successfully, false otherwise
+     */
+    GRT_API bool multiple(const MatrixFloat &a,const MatrixFloat &b,const Float alpha,const Float beta,const bool aTranspose = false,const bool bTranspose = false);
+    
     /**
      Adds the input matrix data (b) to this matrix (a), giving: a = a + b.
      This rows and cols of b must match that of this matrix.
@@ -20,6 +20,8 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "RegressionData.h"
+#include "../Util/BinaryDataFile.h"
+#include "../Util/CSVReader.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -40,6 +42,10 @@ RegressionData::RegressionData(const RegressionData &rhs){
     *this = rhs;
 }
 
+RegressionData::RegressionData(RegressionData &&rhs){
+    *this = std::move( rhs );
+}
+
 RegressionData::~RegressionData(){}
     
 RegressionData& RegressionData::operator=(const RegressionData &rhs){
@@ -63,6 +69,30 @@ RegressionData& RegressionData::operator=(const RegressionData &rhs){
     return *this;
 }
 
+RegressionData& RegressionData::operator=(RegressionData &&rhs){
+    if( this != &rhs){
+        this->datasetName = rhs.datasetName;
+        this->infoText = rhs.infoText;
+        this->numInputDimensions = rhs.numInputDimensions;
+        this->numTargetDimensions = rhs.numTargetDimensions;
+        this->totalNumSamples = rhs.totalNumSamples;
+        this->kFoldValue = rhs.kFoldValue;
+        this->crossValidationSetup = rhs.crossValidationSetup;
+        this->useExternalRanges = rhs.useExternalRanges;
+        this->externalInputRanges = rhs.externalInputRanges;
+        this->externalTargetRanges = rhs.externalTargetRanges;
+        this->data = std::move( rhs.data );
+        this->crossValidationIndexs = std::move( rhs.crossValidationIndexs );
+        this->debugLog = rhs.debugLog;
+        this->errorLog = rhs.errorLog;
+        this->warningLog = rhs.warningLog;
+
+        //Leave the rhs instance empty, as its samples have been moved to this instance
+        rhs.clear();
+    }
+    return *this;
+}
+
 void RegressionData::clear(){
     totalNumSamples = 0;
     kFoldValue = 0;
@@ -435,6 +465,30 @@ RegressionData RegressionData::getTestFoldData(const UINT foldIndex) const{
     return testData;
 }
 
+Vector< UINT > RegressionData::getTrainingFoldIndexs(const UINT foldIndex) const{
+    
+    Vector< UINT > indexs;
+    
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return indexs;
+    
+    //The training fold consists of all the data that is NOT in the foldIndex
+    indexs.reserve( getNumSamples() - crossValidationIndexs[ foldIndex ].getSize() );
+    for(UINT k=0; k<kFoldValue; k++){
+        if( k != foldIndex ){
+            indexs.insert( indexs.end(), crossValidationIndexs[k].begin(), crossValidationIndexs[k].end() );
+        }
+    }
+    
+    return indexs;
+}
+
+Vector< UINT > RegressionData::getTestFoldIndexs(const UINT foldIndex) const{
+    
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return Vector< UINT >();
+    
+    return crossValidationIndexs[ foldIndex ];
+}
+
 UINT RegressionData::removeDuplicateSamples(){
 
     UINT numSamplesRemoved = 0;
@@ -487,6 +541,11 @@ bool RegressionData::save(const std::string &filename) const{
         return saveDatasetToCSVFile( filename );
     }
     
+    //Check if the file should be saved as a binary file
+    if( BinaryDataFile::isBinaryDataFilename( filename ) ){
+        return saveDatasetToBinaryFile( filename );
+    }
+    
     //Otherwise save it as a custom GRT file
     return saveDatasetToFile( filename );
 }
@@ -498,6 +557,11 @@ bool RegressionData::load(const std::string &filename){
         return loadDatasetFromCSVFile( filename, numInputDimensions, numTargetDimensions );
     }
     
+    //Check if the file should be loaded as a binary file
+    if( BinaryDataFile::isBinaryDataFilename( filename ) ){
+        return loadDatasetFromBinaryFile( filename );
+    }
+    
     //Otherwise save it as a custom GRT file
     return loadDatasetFromFile( filename );
 }
@@ -705,44 +769,45 @@ bool RegressionData::loadDatasetFromCSVFile(const std::string &filename,const UI
     //Clear any previous data
     clear();
     
-    //Parse the CSV file
-    FileParser parser;
+    //Open the CSV file and count the rows, so the memory for the data can be allocated before it is parsed
+    CSVReader reader;
+    UINT numRows = 0;
+    UINT numColumns = 0;
     
-    if( !parser.parseCSVFile(filename,true) ){
+    if( !reader.open( filename ) || !reader.countRows( numRows, numColumns ) ){
         errorLog << "loadDatasetFromCSVFile(...) - Failed to parse CSV file!" << std::endl;
         return false;
     }
     
-    if( !parser.getConsistentColumnSize() ){
-        errorLog << "loadDatasetFromCSVFile(...) - The CSV file does not have a consistent number of columns!" << std::endl;
-        return false;
-    }
-    
-    if( parser.getColumnSize() != numInputDimensions+numTargetDimensions ){
-        errorLog << "loadDatasetFromCSVFile(...) - The number of columns in the CSV file (" << parser.getColumnSize() << ")";
+    if( numColumns != numInputDimensions+numTargetDimensions ){
+        errorLog << "loadDatasetFromCSVFile(...) - The number of columns in the CSV file (" << numColumns << ")";
         errorLog << " does not match the number of input dimensions plus the number of target dimensions (" << numInputDimensions+numTargetDimensions << ")" << std::endl;
         return false;
     }
     
     //Setup the labelled classification data
     setInputAndTargetDimensions(numInputDimensions, numTargetDimensions);
+    data.reserve( numRows );
     
-    UINT n = 0;
+    VectorFloat row(numColumns);
     VectorFloat inputVector(numInputDimensions);
     VectorFloat targetVector(numTargetDimensions);
-    for(UINT i=0; i<parser.getRowSize(); i++){
+    for(UINT i=0; i<numRows; i++){
         
-        //Reset n
-        n = 0;
+        if( !reader.readRow( row.getData(), numColumns ) ){
+            errorLog << "loadDatasetFromCSVFile(...) - Failed to parse row " << i << ", the CSV file must only contain numbers and have a consistent number of columns!" << std::endl;
+            clear();
+            return false;
+        }
         
         //Get the input Vector
         for(UINT j=0; j<numInputDimensions; j++){
-            inputVector[j] = grt_from_str< Float >( parser[i][n++] );
+            inputVector[j] = row[j];
         }
         
         //Get the target Vector
         for(UINT j=0; j<numTargetDimensions; j++){
-            targetVector[j] = grt_from_str< Float >( parser[i][n++] );
+            targetVector[j] = row[numInputDimensions+j];
         }
         
         //Add the labelled sample to the dataset
@@ -754,5 +819,108 @@ bool RegressionData::loadDatasetFromCSVFile(const std::string &filename,const UI
     return true;
 }
 
+bool RegressionData::saveDatasetToBinaryFile(const std::string &filename,const bool useSinglePrecision) const{
+
+    BinaryDataFile file;
+    if( !file.openForWriting( filename, "RegressionData" ) ){
+        errorLog << "saveDatasetToBinaryFile(const string &filename,const bool useSinglePrecision) - Failed to open file!" << std::endl;
+        return false;
+    }
+
+    const UINT floatSize = useSinglePrecision ? sizeof(float) : sizeof(double);
+    bool ok = file.writeString( datasetName ) && file.writeString( infoText );
+    ok = ok && file.writeUINT( numInputDimensions ) && file.writeUINT( numTargetDimensions ) && file.writeUINT64( totalNumSamples );
+    ok = ok && file.writeUINT( useExternalRanges ? 1 : 0 );
+    if( useExternalRanges ){
+        for(UINT j=0; j<externalInputRanges.getSize() && ok; j++){
+            ok = file.writeFloat( externalInputRanges[j].minValue ) && file.writeFloat( externalInputRanges[j].maxValue );
+        }
+        for(UINT j=0; j<externalTargetRanges.getSize() && ok; j++){
+            ok = file.writeFloat( externalTargetRanges[j].minValue ) && file.writeFloat( externalTargetRanges[j].maxValue );
+        }
+    }
+    ok = ok && file.writeUINT( floatSize );
+
+    //Write the input vectors as one contiguous block, followed by the target vectors
+    ok = ok && file.alignBlock();
+    for(UINT i=0; i<totalNumSamples && ok; i++){
+        ok = file.writeFloatBlock( data[i].getInputVector().getData(), numInputDimensions, floatSize );
+    }
+    ok = ok && file.alignBlock();
+    for(UINT i=0; i<totalNumSamples && ok; i++){
+        ok = file.writeFloatBlock( data[i].getTargetVector().getData(), numTargetDimensions, floatSize );
+    }
+
+    if( !file.close() || !ok ){
+        errorLog << "saveDatasetToBinaryFile(const string &filename,const bool useSinglePrecision) - Failed to write data to file!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool RegressionData::loadDatasetFromBinaryFile(const std::string &filename){
+
+    clear();
+
+    BinaryDataFile file;
+    if( !file.openForReading( filename, "RegressionData" ) ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - Failed to open file!" << std::endl;
+        return false;
+    }
+
+    UINT useRanges = 0;
+    UINT floatSize = 0;
+    unsigned long long numSamples = 0;
+    bool ok = file.readString( datasetName ) && file.readString( infoText );
+    ok = ok && file.readUINT( numInputDimensions ) && file.readUINT( numTargetDimensions ) && file.readUINT64( numSamples );
+    ok = ok && file.readUINT( useRanges );
+    useExternalRanges = useRanges != 0;
+    if( ok && useExternalRanges ){
+        if( ((unsigned long long)numInputDimensions + numTargetDimensions) * 2 * sizeof(double) > file.getNumBytesRemaining() ) ok = false;
+        else{
+            externalInputRanges.resize( numInputDimensions );
+            externalTargetRanges.resize( numTargetDimensions );
+        }
+        for(UINT j=0; j<externalInputRanges.getSize() && ok; j++){
+            ok = file.readFloat( externalInputRanges[j].minValue ) && file.readFloat( externalInputRanges[j].maxValue );
+        }
+        for(UINT j=0; j<externalTargetRanges.getSize() && ok; j++){
+            ok = file.readFloat( externalTargetRanges[j].minValue ) && file.readFloat( externalTargetRanges[j].maxValue );
+        }
+    }
+    ok = ok && file.readUINT( floatSize ) && file.alignBlock();
+
+    //Make sure the file actually contains all the samples before any memory is allocated for them, this also bounds the number of
+    //dimensions by the size of the file. A dataset without samples has no per-dimension data in the file, so nothing is allocated for it
+    const unsigned long long bytesPerSample = ((unsigned long long)numInputDimensions + numTargetDimensions) * floatSize;
+    if( !ok || (floatSize != sizeof(float) && floatSize != sizeof(double)) || numSamples > std::numeric_limits< UINT >::max() ||
+        (numSamples > 0 && (numInputDimensions == 0 || numTargetDimensions == 0 || numSamples > file.getNumBytesRemaining() / bytesPerSample)) ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - Failed to read dataset header!" << std::endl;
+        clear();
+        return false;
+    }
+
+    totalNumSamples = (UINT)numSamples;
+    if( totalNumSamples > 0 ){
+        data.resize( totalNumSamples, RegressionSample( VectorFloat(numInputDimensions), VectorFloat(numTargetDimensions) ) );
+    }
+    for(UINT i=0; i<totalNumSamples && ok; i++){
+        ok = file.readFloatBlock( data[i].getInputVector().getData(), numInputDimensions, floatSize );
+    }
+    ok = ok && file.alignBlock();
+    for(UINT i=0; i<totalNumSamples && ok; i++){
+        ok = file.readFloatBlock( data[i].getTargetVector().getData(), numTargetDimensions, floatSize );
+    }
+
+    if( !ok ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - Failed to read data from file!" << std::endl;
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
 GRT_END_NAMESPACE
 
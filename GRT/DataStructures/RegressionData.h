@@ -58,6 +58,13 @@ public:
 	 @param rhs: another instance of the RegressionData class from which the data will be copied to this instance
      */
 	RegressionData(const RegressionData &rhs);
+
+    /**
+     Move Constructor, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the RegressionData class from which the data will be moved to this instance
+     */
+	RegressionData(RegressionData &&rhs);
     
     /**
      Default Destructor
@@ -71,6 +78,14 @@ public:
 	 @return a reference to this instance of RegressionData
      */
 	RegressionData& operator=(const RegressionData &rhs);
+
+    /**
+     Sets the move assignment operator, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the RegressionData class from which the data will be moved to this instance
+	 @return a reference to this instance of RegressionData
+     */
+	RegressionData& operator=(RegressionData &&rhs);
 	
     /**
      Array Subscript Operator, returns the LabelledRegressionSample at index i.  
@@ -196,8 +211,8 @@ public:
     
     /**
      Saves the data to a file.
-     If the file format ends in '.csv' then the data will be saved as comma-seperated-values, otherwise it will be saved
-     to a custom GRT file (which contains the csv data with an additional header).
+     If the file format ends in '.csv' then the data will be saved as comma-seperated-values, if it ends in '.grtb' then it
+     will be saved as a binary data file, otherwise it will be saved to a custom GRT file (which contains the csv data with an additional header).
      
      @param filename: the name of the file the data will be saved to
      @return true if the data was saved successfully, false otherwise
@@ -206,8 +221,8 @@ public:
     
     /**
      Load the data from a file.
-     If the file format ends in '.csv' then the function will try and load the data from a csv format.  If this fails then it will
-     try and load the data as a custom GRT file.
+     If the file format ends in '.csv' then the function will try and load the data from a csv format, if it ends in '.grtb' then
+     it will be loaded as a binary data file, otherwise it will try and load the data as a custom GRT file.
      
      @param filename: the name of the file the data will be loaded from
      @return true if the data was loaded successfully, false otherwise
@@ -250,6 +265,28 @@ public:
 	 @return true if the data was saved successfully, false otherwise
      */
     bool loadDatasetFromCSVFile(const std::string &filename,const UINT numInputDimensions,const UINT numTargetDimensions);
+
+    /**
+     Saves the labelled regression data to a binary data file.
+     The file contains the dataset header, followed by the input vectors and then the target vectors, each stored as one
+     contiguous little-endian block of float64 (or float32) values.  This should use the '.grtb' file extension.
+
+     @param filename: the name of the file the data will be saved to
+     @param useSinglePrecision: if true the data will be stored as float32 values, halving the size of the file. Default value = false
+	 @return true if the data was saved successfully, false otherwise
+     */
+    bool saveDatasetToBinaryFile(const std::string &filename,const bool useSinglePrecision = false) const;
+
+    /**
+     Loads the labelled regression data from a binary data file saved with saveDatasetToBinaryFile.
+     The file is memory mapped where possible, so the data is copied straight from the file into the dataset without parsing any text.
+     The data is still copied onto the heap, the dataset does not keep the mapping, use a ChunkedDataset to train from a file that is too large to load.
+     The file is rejected if the header does not fit in the file, for example if it lists more samples than the file contains.
+
+     @param filename: the name of the file the data will be loaded from
+	 @return true if the data was loaded successfully, false otherwise
+     */
+    bool loadDatasetFromBinaryFile(const std::string &filename);
     
     bool printStats() const;
     
@@ -303,6 +340,24 @@ public:
 	 @return returns a test dataset
      */
     RegressionData getTestFoldData(const UINT foldIndex) const;
+    
+    /**
+     Returns the indexs of the samples in the training dataset for the k-th fold for cross validation, without copying the samples.
+     The indexs are listed in the same order as the samples returned by getTrainingFoldData.
+     
+     @param foldIndex: the index of the fold you want the training indexs for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns the indexs of the training samples, an empty Vector will be returned if the data has not been spilt into K folds
+    */
+    Vector< UINT > getTrainingFoldIndexs(const UINT foldIndex) const;
+    
+    /**
+     Returns the indexs of the samples in the test dataset for the k-th fold for cross validation, without copying the samples.
+     The indexs are listed in the same order as the samples returned by getTestFoldData.
+     
+     @param foldIndex: the index of the fold you want the test indexs for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns the indexs of the test samples, an empty Vector will be returned if the data has not been spilt into K folds
+    */
+    Vector< UINT > getTestFoldIndexs(const UINT foldIndex) const;
 
     UINT removeDuplicateSamples();
     
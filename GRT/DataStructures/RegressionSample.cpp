@@ -73,6 +73,14 @@ const VectorFloat& RegressionSample::getInputVector() const{
 const VectorFloat& RegressionSample::getTargetVector() const{
     return targetVector;
 }
+
+VectorFloat& RegressionSample::getInputVector(){
+    return inputVector;
+}
+
+VectorFloat& RegressionSample::getTargetVector(){
+    return targetVector;
+}
 	
 GRT_END_NAMESPACE
 
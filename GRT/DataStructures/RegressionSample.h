@@ -66,6 +66,8 @@ public:
     Float getTargetVectorValue(const UINT index) const;
     const VectorFloat& getInputVector() const;
     const VectorFloat& getTargetVector() const;
+    VectorFloat& getInputVector();
+    VectorFloat& getTargetVector();
 
 private:
 	VectorFloat inputVector;
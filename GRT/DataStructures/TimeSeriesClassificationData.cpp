@@ -20,6 +20,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "TimeSeriesClassificationData.h"
+#include "../Util/CSVReader.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -49,6 +50,15 @@ TimeSeriesClassificationData::TimeSeriesClassificationData(const TimeSeriesClass
     *this = rhs;
 }
 
+TimeSeriesClassificationData::TimeSeriesClassificationData(TimeSeriesClassificationData &&rhs){
+    
+    debugLog.setKey("[DEBUG TSCD]");
+    errorLog.setKey("[ERROR TSCD]");
+    warningLog.setKey("[WARNING TSCD]");
+    
+    *this = std::move( rhs );
+}
+
 TimeSeriesClassificationData::~TimeSeriesClassificationData(){}
     
 TimeSeriesClassificationData& TimeSeriesClassificationData::operator=(const TimeSeriesClassificationData &rhs){
@@ -71,6 +81,29 @@ TimeSeriesClassificationData& TimeSeriesClassificationData::operator=(const Time
     return *this;
 }
 
+TimeSeriesClassificationData& TimeSeriesClassificationData::operator=(TimeSeriesClassificationData &&rhs){
+    if( this != &rhs){
+        this->datasetName = rhs.datasetName;
+        this->infoText = rhs.infoText;
+        this->numDimensions = rhs.numDimensions;
+        this->useExternalRanges = rhs.useExternalRanges;
+        this->allowNullGestureClass = rhs.allowNullGestureClass;
+        this->crossValidationSetup = rhs.crossValidationSetup;
+        this->crossValidationIndexs = std::move( rhs.crossValidationIndexs );
+        this->totalNumSamples = rhs.totalNumSamples;
+        this->data = std::move( rhs.data );
+        this->classTracker = std::move( rhs.classTracker );
+        this->externalRanges = rhs.externalRanges;
+        this->debugLog = rhs.debugLog;
+        this->errorLog = rhs.errorLog;
+        this->warningLog = rhs.warningLog;
+
+        //Leave the rhs instance empty, as its samples have been moved to this instance
+        rhs.clear();
+    }
+    return *this;
+}
+
 void TimeSeriesClassificationData::clear(){
 	totalNumSamples = 0;
 	data.clear();
@@ -591,40 +624,39 @@ bool TimeSeriesClassificationData::loadDatasetFromCSVFile(const std::string &fil
     //Clear any previous data
     clear();
     
-    //Parse the CSV file
-    FileParser parser;
+    //Open the CSV file, the rows are parsed one at a time straight from the file buffer
+    CSVReader reader;
+    UINT numRows = 0;
+    UINT numColumns = 0;
     
-    if( !parser.parseCSVFile(filename,true) ){
+    if( !reader.open( filename ) || !reader.countRows( numRows, numColumns ) ){
         errorLog << "loadDatasetFromCSVFile(const std::string &filename) - Failed to parse CSV file!" << std::endl;
         return false;
     }
     
-    if( !parser.getConsistentColumnSize() ){
-        errorLog << "loadDatasetFromCSVFile(const std::string &filename) - The CSV file does not have a consistent number of columns!" << std::endl;
-        return false;
-    }
-    
-    if( parser.getColumnSize() <= 2 ){
+    if( numColumns <= 2 ){
         errorLog << "loadDatasetFromCSVFile(const std::string &filename) - The CSV file does not have enough columns! It should contain at least three columns!" << std::endl;
         return false;
     }
     
     //Set the number of dimensions
-    numDimensions = parser.getColumnSize()-2;
-    
-    //Reserve the memory for the data
-    data.reserve( parser.getRowSize() );
+    numDimensions = numColumns-2;
     
     UINT sampleCounter = 0;
     UINT lastSampleCounter = 0;
     UINT classLabel = 0;
-    UINT j = 0;
-    UINT n = 0;
+    VectorFloat row(numColumns);
     VectorFloat sample(numDimensions);
     MatrixFloat timeseries;
-    for(UINT i=0; i<parser.getRowSize(); i++){
+    for(UINT i=0; i<numRows; i++){
+        
+        if( !reader.readRow( row.getData(), numColumns ) ){
+            errorLog << "loadDatasetFromCSVFile(const std::string &filename) - Failed to parse row " << i << ", the CSV file must only contain numbers and have a consistent number of columns!" << std::endl;
+            clear();
+            return false;
+        }
         
-        sampleCounter = grt_from_str< UINT >( parser[i][0] );
+        sampleCounter = (UINT)row[0];
         
         //Check to see if a new timeseries has started, if so then add the previous time series as a sample and start recording the new time series
         if( sampleCounter != lastSampleCounter && i != 0 ){
@@ -636,15 +668,18 @@ bool TimeSeriesClassificationData::loadDatasetFromCSVFile(const std::string &fil
         }
         lastSampleCounter = sampleCounter;
         
-        //Get the class label
-        classLabel = grt_from_str< UINT >( parser[i][1] );
+        //Get the class label, it must be a non-negative integer that fits in a UINT
+        const Float label = row[1];
+        if( !(label >= 0 && label <= std::numeric_limits< UINT >::max() && label == std::floor( label )) ){
+            errorLog << "loadDatasetFromCSVFile(const std::string &filename) - The class label on line " << reader.getLineNumber() << " is not valid, it must be a non-negative integer!" << std::endl;
+            clear();
+            return false;
+        }
+        classLabel = (UINT)label;
         
         //Get the sample data
-        j=0;
-        n=2;
-        while( j != numDimensions ){
-            sample[j++] = grt_from_str< Float >( parser[i][n] );
-            n++;
+        for(UINT j=0; j<numDimensions; j++){
+            sample[j] = row[j+2];
         }
         
         //Add the sample to the timeseries
@@ -653,7 +688,7 @@ bool TimeSeriesClassificationData::loadDatasetFromCSVFile(const std::string &fil
 	if ( timeseries.getSize() > 0 )
         //Add the labelled sample to the dataset
         if( !addSample(classLabel, timeseries) ){
-            warningLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex) - Could not add sample " << parser.getRowSize()-1 << " to the dataset!" << std::endl;
+            warningLog << "loadDatasetFromCSVFile(const std::string &filename,const UINT classLabelColumnIndex) - Could not add sample " << numRows-1 << " to the dataset!" << std::endl;
         }
     
     return true;
@@ -969,6 +1004,30 @@ TimeSeriesClassificationData TimeSeriesClassificationData::getTestFoldData(const
     return testData;
 }
 
+Vector< UINT > TimeSeriesClassificationData::getTrainingFoldIndexs(const UINT foldIndex) const{
+    
+    Vector< UINT > indexs;
+    
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return indexs;
+    
+    //The training fold consists of all the data that is NOT in the foldIndex
+    indexs.reserve( getNumSamples() - crossValidationIndexs[ foldIndex ].getSize() );
+    for(UINT k=0; k<kFoldValue; k++){
+        if( k != foldIndex ){
+            indexs.insert( indexs.end(), crossValidationIndexs[k].begin(), crossValidationIndexs[k].end() );
+        }
+    }
+    
+    return indexs;
+}
+
+Vector< UINT > TimeSeriesClassificationData::getTestFoldIndexs(const UINT foldIndex) const{
+    
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return Vector< UINT >();
+    
+    return crossValidationIndexs[ foldIndex ];
+}
+
 TimeSeriesClassificationData TimeSeriesClassificationData::getClassData(const UINT classLabel) const {
     TimeSeriesClassificationData classData(numDimensions);
     for(UINT x=0; x<totalNumSamples; x++){
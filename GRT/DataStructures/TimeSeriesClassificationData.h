@@ -58,6 +58,13 @@ public:
 	 @param rhs: another instance of the TimeSeriesClassificationData class from which the data will be copied to this instance
      */
 	TimeSeriesClassificationData(const TimeSeriesClassificationData &rhs);
+
+    /**
+     Move Constructor, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the TimeSeriesClassificationData class from which the data will be moved to this instance
+     */
+	TimeSeriesClassificationData(TimeSeriesClassificationData &&rhs);
     
     /**
      Default Destructor
@@ -72,6 +79,14 @@ public:
      */
 	TimeSeriesClassificationData& operator= (const TimeSeriesClassificationData &rhs);
 
+    /**
+     Sets the move assignment operator, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the TimeSeriesClassificationData class from which the data will be moved to this instance
+	 @return a reference to this instance of TimeSeriesClassificationData
+     */
+	TimeSeriesClassificationData& operator=(TimeSeriesClassificationData &&rhs);
+
     /**
      Array Subscript Operator, returns the TimeSeriesClassificationSample at index i.
 	 It is up to the user to ensure that i is within the range of [0 totalNumSamples-1]
@@ -352,6 +367,24 @@ public:
      */
     TimeSeriesClassificationData getTestFoldData(const UINT foldIndex) const;
     
+    /**
+     Returns the indexs of the samples in the training dataset for the k-th fold for cross validation, without copying the samples.
+     The indexs are listed in the same order as the samples returned by getTrainingFoldData.
+     
+     @param foldIndex: the index of the fold you want the training indexs for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns the indexs of the training samples, an empty Vector will be returned if the data has not been spilt into K folds
+    */
+    Vector< UINT > getTrainingFoldIndexs(const UINT foldIndex) const;
+    
+    /**
+     Returns the indexs of the samples in the test dataset for the k-th fold for cross validation, without copying the samples.
+     The indexs are listed in the same order as the samples returned by getTestFoldData.
+     
+     @param foldIndex: the index of the fold you want the test indexs for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns the indexs of the test samples, an empty Vector will be returned if the data has not been spilt into K folds
+    */
+    Vector< UINT > getTestFoldIndexs(const UINT foldIndex) const;
+    
     /**
      Returns the all the data with the class label set by classLabel.
      The classLabel should be a valid classLabel, otherwise the dataset returned will be empty.
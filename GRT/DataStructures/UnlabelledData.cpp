@@ -20,6 +20,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "UnlabelledData.h"
+#include "../Util/CSVReader.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -37,6 +38,10 @@ UnlabelledData::UnlabelledData(const UnlabelledData &rhs):debugLog("[DEBUG ULCD]
     *this = rhs;
 }
 
+UnlabelledData::UnlabelledData(UnlabelledData &&rhs):debugLog("[DEBUG ULCD]"),errorLog("[ERROR ULCD]"),warningLog("[WARNING ULCD]"){
+    *this = std::move( rhs );
+}
+
 UnlabelledData::~UnlabelledData(){}
     
 UnlabelledData& UnlabelledData::operator=(const UnlabelledData &rhs){
@@ -58,6 +63,28 @@ UnlabelledData& UnlabelledData::operator=(const UnlabelledData &rhs){
     return *this;
 }
 
+UnlabelledData& UnlabelledData::operator=(UnlabelledData &&rhs){
+    if( this != &rhs){
+        this->datasetName = rhs.datasetName;
+        this->infoText = rhs.infoText;
+        this->numDimensions = rhs.numDimensions;
+        this->totalNumSamples = rhs.totalNumSamples;
+        this->kFoldValue = rhs.kFoldValue;
+        this->crossValidationSetup = rhs.crossValidationSetup;
+        this->useExternalRanges = rhs.useExternalRanges;
+        this->externalRanges = rhs.externalRanges;
+        this->data = std::move( rhs.data );
+        this->crossValidationIndexs = std::move( rhs.crossValidationIndexs );
+        this->debugLog = rhs.debugLog;
+        this->errorLog = rhs.errorLog;
+        this->warningLog = rhs.warningLog;
+
+        //Leave the rhs instance empty, as its samples have been moved to this instance
+        rhs.clear();
+    }
+    return *this;
+}
+
 void UnlabelledData::clear(){
 	totalNumSamples = 0;
 	data.clear();
@@ -373,22 +400,16 @@ bool UnlabelledData::loadDatasetFromCSVFile(const std::string &filename){
     //Clear any previous data
     clear();
     
-    //Parse the CSV file
-    FileParser parser;
+    //Open the CSV file and count the rows, so the memory for the data can be allocated before it is parsed
+    CSVReader reader;
+    UINT rows = 0;
+    UINT cols = 0;
     
-    if( !parser.parseCSVFile(filename,true) ){
+    if( !reader.open( filename ) || !reader.countRows( rows, cols ) ){
         errorLog << "loadDatasetFromCSVFile(const std::string &filename) - Failed to parse CSV file!" << std::endl;
         return false;
     }
     
-    if( !parser.getConsistentColumnSize() ){
-        errorLog << "loadDatasetFromCSVFile(const std::string &filename) - The CSV file does not have a consistent number of columns!" << std::endl;
-        return false;
-    }
-    
-    const UINT rows = parser.getRowSize();
-    const UINT cols = parser.getColumnSize();
-    
     //Setup the labelled classification data
     numDimensions = cols;
     
@@ -399,8 +420,10 @@ bool UnlabelledData::loadDatasetFromCSVFile(const std::string &filename){
     for(UINT i=0; i<rows; i++){
         
         //Get the input vector
-        for(UINT j=0; j<numDimensions; j++){
-            sample[j] = Util::stringToFloat( parser[i][j] );
+        if( !reader.readRow( sample.getData(), numDimensions ) ){
+            errorLog << "loadDatasetFromCSVFile(const std::string &filename) - Failed to parse row " << i << ", the CSV file must only contain numbers and have a consistent number of columns!" << std::endl;
+            clear();
+            return false;
         }
         
         //Add the labelled sample to the dataset
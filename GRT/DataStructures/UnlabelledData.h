@@ -55,6 +55,13 @@ public:
 	*/
 	UnlabelledData(const UnlabelledData &rhs);
 
+    /**
+     Move Constructor, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the UnlabelledData class from which the data will be moved to this instance
+     */
+	UnlabelledData(UnlabelledData &&rhs);
+
 	/**
      Default Destructor
     */
@@ -68,6 +75,14 @@ public:
 	*/
 	UnlabelledData& operator= (const UnlabelledData &rhs);
 
+    /**
+     Sets the move assignment operator, moves the data from the rhs instance to this instance without copying the samples. The rhs instance will be empty after the move.
+     
+	 @param rhs: another instance of the UnlabelledData class from which the data will be moved to this instance
+	 @return a reference to this instance of UnlabelledData
+     */
+	UnlabelledData& operator=(UnlabelledData &&rhs);
+
 	/**
      Array Subscript Operator, returns the UnlabelledData at index i.  
 	 It is up to the user to ensure that i is within the range of [0 totalNumSamples-1]
@@ -72,6 +72,13 @@ public:
         }else this->clear();
     }
     
+    /**
+     Move Constructor, moves the values from the rhs Vector to this Vector instance without copying them
+     
+     @param rhs: the Vector from which the values will be moved, this will be empty after the move
+    */
+    Vector( Vector &&rhs ) noexcept : std::vector< T >( std::move( rhs ) ){}
+    
     /**
      Copy Constructor, copies the values from the rhs std::vector to this Vector instance
      
@@ -107,6 +114,19 @@ public:
         return *this;
     }
 
+    /**
+     Defines how the data from the rhs Vector should be moved to this Vector, the values are not copied
+     
+     @param rhs: another instance of a Vector, this will be empty after the move
+     @return returns a reference to this instance of the Vector
+    */
+    Vector& operator=(Vector &&rhs) noexcept{
+        if(this!=&rhs){
+            std::vector< T >::operator=( std::move( rhs ) );
+        }
+        return *this;
+    }
+
     /**
      Defines how the data from the rhs std::vector instance should be copied to this Vector
      
@@ -20,7 +20,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #define GRT_DLL_EXPORTS
 #include "VectorFloat.h"
-#include "../Util/FileParser.h"
+#include "../Util/CSVReader.h"
 
 GRT_BEGIN_NAMESPACE
    
@@ -46,6 +46,11 @@ VectorFloat::VectorFloat(const VectorFloat &rhs):Vector(rhs){
   errorLog.setKey("[ERROR VectorFloat]");
 }
 
+VectorFloat::VectorFloat(VectorFloat &&rhs) noexcept : Vector(std::move(rhs)){
+  warningLog.setKey("[WARNING VectorFloat]");
+  errorLog.setKey("[ERROR VectorFloat]");
+}
+
 VectorFloat::~VectorFloat(){
   clear();
 }
@@ -61,6 +66,13 @@ VectorFloat& VectorFloat::operator=(const VectorFloat &rhs){
   return *this;
 }
     
+VectorFloat& VectorFloat::operator=(VectorFloat &&rhs) noexcept{
+  if (this != &rhs) {
+    Vector< Float >::operator=(std::move(rhs));
+  }
+  return *this;
+}
+    
 VectorFloat& VectorFloat::operator=(const Vector< Float > &rhs){
   if (this != &rhs) {
     UINT N = rhs.getSize();
@@ -189,67 +201,19 @@ bool VectorFloat::load(const std::string &filename, const char seperator) {
   clear();
 
   //Open the file
-  std::ifstream file( filename.c_str(), std::ifstream::in );
-  if (!file.is_open()){
+  CSVReader reader( seperator );
+  if (!reader.open( filename )){
     warningLog << "Failed to open file: " << filename << std::endl;
     return false;
   }
   
-  Vector< std::string > vec;
-  Vector< Float > row;
-  std::string line;
-  std::string columnString = "";
-  const int sepValue = seperator;
-  unsigned int numElements = 0;
-  size_t length = 0;
-  
   //Get the data, for a vector it should just be one line
-  if (!getline(file,line)) {
+  if (!reader.readRow( *this )) {
+    clear();
     warningLog << "Failed to read first row!" << std::endl;
     return false;
   }
   
-  //Scan the line contents for the seperator token and parse the contents between each token
-  columnString = "";
-  length = line.length();
-  vec.reserve( length );
-  for (size_t i=0; i<length; i++) {
-    if (int(line[i]) == sepValue) {
-      vec.push_back(columnString);
-      columnString = "";
-    }else columnString += line[i];
-  }
-        
-  //Add the last column
-  vec.push_back( columnString );
-          
-  //Remove the new line character from the string in the last column
-  if( vec.size() >= 1 ){
-    size_t K = vec.size()-1;
-    size_t foundA = vec[ K ].find('\n');
-    size_t foundB = vec[K ].find('\r');
-    if (foundA != std::string::npos || foundB != std::string::npos) {
-        vec[ K ] = vec[ K ].substr(0,vec[ K ].length()-1);
-    }
-  }
-  
-  numElements = vec.getSize();
-  
-  //Assign the memory
-  if (!resize(numElements)) {
-    warningLog << "Failed to resize memory!" << std::endl;
-    return false;
-  }
-      
-  //Convert the string column values to Float values
-  Float *data = getData();
-  for (unsigned int i=0; i<numElements; i++) {
-    data[i] = grt_from_str< Float >( vec[i] );
-  }
-  
-  //Close the file
-  file.close();
-  
   return true;
 }
     
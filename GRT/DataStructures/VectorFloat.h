@@ -59,6 +59,13 @@ public:
      */
     GRT_API VectorFloat(const VectorFloat &rhs);
     
+    /**
+     Move Constructor, moves the values from the rhs VectorFloat to this VectorFloat instance without copying them
+     
+     @param rhs: the VectorFloat from which the values will be moved, this will be empty after the move
+     */
+    GRT_API VectorFloat(VectorFloat &&rhs) noexcept;
+    
     /**
      Destructor, cleans up any memory
      */
@@ -72,6 +79,14 @@ public:
      */
     GRT_API VectorFloat& operator=(const VectorFloat &rhs);
     
+    /**
+     Defines how the data from the rhs VectorFloat should be moved to this VectorFloat, the values are not copied
+     
+     @param rhs: another instance of a VectorFloat, this will be empty after the move
+     @return returns a reference to this instance of the VectorFloat
+     */
+    GRT_API VectorFloat& operator=(VectorFloat &&rhs) noexcept;
+    
     /**
      Defines how the data from the rhs Vector< Float > should be copied to this VectorFloat
      
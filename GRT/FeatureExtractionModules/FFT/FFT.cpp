@@ -37,6 +37,9 @@ FFT::FFT(const UINT fftWindowSize,const UINT hopSize,const UINT numDimensions,co
     featureDataReady = false;
     numInputDimensions = 0;
     numOutputDimensions = 0;
+    useSlidingDFT = false;
+    slidingDFTValid = false;
+    slidingDFTCounter = 0;
     
     if( isPowerOfTwo(fftWindowSize) && hopSize > 0 && numDimensions > 0 ){
         init(fftWindowSize,hopSize,numDimensions,fftWindowFunction,computeMagnitude,computePhase);
@@ -67,6 +70,13 @@ FFT& FFT::operator=(const FFT &rhs){
         this->tempBuffer = rhs.tempBuffer;
         this->fft = rhs.fft;
         this->windowSizeMap = rhs.windowSizeMap;
+        this->useSlidingDFT = rhs.useSlidingDFT;
+        this->slidingDFTValid = rhs.slidingDFTValid;
+        this->slidingDFTCounter = rhs.slidingDFTCounter;
+        this->twiddleReal = rhs.twiddleReal;
+        this->twiddleImag = rhs.twiddleImag;
+        this->slidingReal = rhs.slidingReal;
+        this->slidingImag = rhs.slidingImag;
         
         copyBaseVariables( (FeatureExtraction*)&rhs );
         
@@ -238,6 +248,8 @@ bool FFT::init(const UINT fftWindowSize,const UINT hopSize,const UINT numDimensi
         }
     }
     
+    setupSlidingDFT();
+    
     initialized = true;
     
     return true;
@@ -278,16 +290,80 @@ bool FFT::update(const VectorFloat &x){
         return false;
     }
     
-    //Add the current input to the data buffers
-    dataBuffer.push_back( x );
+    featureDataReady = false;
+    
+    return updateSample( x );
+}
+
+bool FFT::update(const MatrixFloat &x){
+    
+    if( !initialized ){
+        errorLog << "update(const MatrixFloat &x) - Not initialized!" << std::endl;
+        return false;
+    }
+    
+    if( x.getNumCols() != numInputDimensions ){
+        errorLog << "update(const MatrixFloat &x) - The number of columns in the inputMatrix (" << x.getNumCols() << ") does not match that of the FeatureExtraction (" << numInputDimensions << ")!" << std::endl;
+        return false;
+    }
     
     featureDataReady = false;
     
+    VectorFloat sample( numInputDimensions );
+    for(UINT k=0; k<x.getNumRows(); k++){
+        for(UINT j=0; j<numInputDimensions; j++) sample[j] = x[k][j];
+        if( !updateSample( sample ) ){
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool FFT::updateSample(const VectorFloat &x){
+    
+    //Slide the spectrum of each dimension by one sample, this is only valid once the buffer is full as the window only slides from then
+    const UINT M = fftWindowSize/2;
+    if( useSlidingDFT ){
+        if( slidingDFTValid && dataBuffer.getBufferFilled() ){
+            const VectorFloat &oldest = dataBuffer[0];
+            for(UINT j=0; j<numInputDimensions; j++){
+                const Float delta = x[j] - oldest[j];
+                Float *re = slidingReal[j];
+                Float *im = slidingImag[j];
+                
+                //Bin 0 holds the DC component in the real part and the Nyquist component in the imaginary part
+                re[0] += delta;
+                im[0] = -(im[0] + delta);
+                
+                //The FastFourierTransform stores the imaginary parts with the opposite sign to the usual DFT, so each bin is rotated by exp(-2*pi*i*k/M)
+                for(UINT k=1; k<M; k++){
+                    const Float r = re[k] + delta;
+                    re[k] = r * twiddleReal[k] - im[k] * twiddleImag[k];
+                    im[k] = r * twiddleImag[k] + im[k] * twiddleReal[k];
+                }
+            }
+            slidingDFTCounter++;
+        }else slidingDFTValid = false;
+    }
+    
+    //Add the current input to the data buffers
+    dataBuffer.push_back( x );
+    
     if( ++hopCounter == hopSize ){
         hopCounter = 0;
+        
+        //The sliding DFT is recomputed with an FFT every fftWindowSize samples so the rounding errors can not accumulate
+        const bool computeFFT = !useSlidingDFT || !slidingDFTValid || slidingDFTCounter >= fftWindowSize;
+        
         //Compute the FFT for each dimension
         for(UINT j=0; j<numInputDimensions; j++){
             
+            if( !computeFFT ){
+                fft[j].setFFTData( slidingReal[j], slidingImag[j] );
+                continue;
+            }
+            
             //Copy the input data for this dimension into the temp buffer
             for(UINT i=0; i<dataBufferSize; i++){
                 tempBuffer[i] = dataBuffer[i][j];
@@ -298,6 +374,18 @@ bool FFT::update(const VectorFloat &x){
                 errorLog << "update(const VectorFloat &x) - Failed to compute FFT!" << std::endl;
                 return false;
             }
+            
+            if( useSlidingDFT ){
+                const Float *re = fft[j].getRealDataPtr();
+                const Float *im = fft[j].getImagDataPtr();
+                std::copy( re, re + M, slidingReal[j] );
+                std::copy( im, im + M, slidingImag[j] );
+            }
+        }
+        
+        if( useSlidingDFT && computeFFT ){
+            slidingDFTValid = dataBuffer.getBufferFilled();
+            slidingDFTCounter = 0;
         }
         
         //Flag that the fft was computed during this update
@@ -324,65 +412,33 @@ bool FFT::update(const VectorFloat &x){
     return true;
 }
 
-bool FFT::update(const MatrixFloat &x){
-    
-    if( !initialized ){
-        errorLog << "update(const MatrixFloat &x) - Not initialized!" << std::endl;
-        return false;
+void FFT::setupSlidingDFT(){
+    
+    //A sliding DFT costs about 4 multiplies per frequency bin for every sample, while an FFT costs about 2.5 log2(M) operations per
+    //frequency bin for every hop, so the sliding DFT is only used for small hop sizes. It can only compute the spectrum of a rectangular window
+    UINT numBits = 0;
+    while( (1u << numBits) < fftWindowSize ) numBits++;
+    useSlidingDFT = fftWindowFunction == RECTANGULAR_WINDOW && hopSize*2 <= numBits;
+    slidingDFTValid = false;
+    slidingDFTCounter = 0;
+    
+    if( !useSlidingDFT ){
+        twiddleReal.clear();
+        twiddleImag.clear();
+        slidingReal.clear();
+        slidingImag.clear();
+        return;
     }
     
-    if( x.getNumCols() != numInputDimensions ){
-        errorLog << "update(const MatrixFloat &x) - The number of columns in the inputMatrix (" << x.getNumCols() << ") does not match that of the FeatureExtraction (" << numInputDimensions << ")!" << std::endl;
-        return false;
+    const UINT M = fftWindowSize/2;
+    twiddleReal.resize( M );
+    twiddleImag.resize( M );
+    for(UINT k=0; k<M; k++){
+        twiddleReal[k] = cos( 2.0 * PI * k / fftWindowSize );
+        twiddleImag[k] = -sin( 2.0 * PI * k / fftWindowSize );
     }
-    
-    featureDataReady = false;
-    
-    for(UINT k=0; k<x.getNumRows(); k++){
-        
-        //Add the current input to the data buffers
-        dataBuffer.push_back( x.getRow(k) );
-        
-        if( ++hopCounter == hopSize ){
-            hopCounter = 0;
-            //Compute the FFT for each dimension
-            for(UINT j=0; j<numInputDimensions; j++){
-                
-                //Copy the input data for this dimension into the temp buffer
-                for(UINT i=0; i<dataBufferSize; i++){
-                    tempBuffer[i] = dataBuffer[i][j];
-                }
-                
-                //Compute the FFT
-                if( !fft[j].computeFFT( tempBuffer ) ){
-                    errorLog << "update(const VectorFloat &x) - Failed to compute FFT!" << std::endl;
-                    return false;
-                }
-            }
-            
-            //Flag that the fft was computed during this update
-            featureDataReady = true;
-            
-            //Copy the FFT data to the feature vector
-            UINT index = 0;
-            for(UINT j=0; j<numInputDimensions; j++){
-                if( computeMagnitude ){
-                    Float *mag = fft[j].getMagnitudeDataPtr();
-                    for(UINT i=0; i<fft[j].getFFTSize()/2; i++){
-                        featureVector[index++] = *mag++;
-                    }
-                }
-                if( computePhase ){
-                    Float *phase = fft[j].getPhaseDataPtr();
-                    for(UINT i=0; i<fft[j].getFFTSize()/2; i++){
-                        featureVector[index++] = *phase++;
-                    }
-                }
-            }
-        }
-    }
-    
-    return true;
+    slidingReal.resize( numInputDimensions, M );
+    slidingImag.resize( numInputDimensions, M );
 }
 
 bool FFT::clear(){
@@ -394,6 +450,13 @@ bool FFT::clear(){
     tempBuffer.clear();
     dataBuffer.clear();
     fft.clear();
+    useSlidingDFT = false;
+    slidingDFTValid = false;
+    slidingDFTCounter = 0;
+    twiddleReal.clear();
+    twiddleImag.clear();
+    slidingReal.clear();
+    slidingImag.clear();
     
     return true;
 }
@@ -443,6 +506,7 @@ bool FFT::setHopSize(const UINT hopSize){
     if( hopSize > 0 ){
         this->hopSize = hopSize;
         hopCounter = 0;
+        if( initialized ) setupSlidingDFT();
         return true;
     }
     errorLog << "setHopSize(UINT hopSize) - The hopSize value must be greater than zero!" << std::endl;
@@ -258,6 +258,18 @@ public:
     */
     bool getComputePhase() const { if(initialized){ return computePhase; } return false; }
     
+    /**
+    Returns if the spectrum is updated with a sliding DFT rather than an FFT.
+    
+    A sliding DFT updates each frequency bin in O(1) for every new sample, so for a window of M samples it costs O(M) per sample, compared
+    to O(M log M) for each FFT. It is therefore used automatically when the FFT uses a RECTANGULAR_WINDOW and the hopSize is small enough
+    that updating the spectrum every sample is cheaper than computing an FFT every hop. The spectrum is recomputed with an FFT every M samples
+    so the rounding errors of the sliding DFT can not accumulate.
+    
+    @return true if the spectrum is updated with a sliding DFT, false otherwise
+    */
+    bool getUseSlidingDFT() const { if(initialized){ return useSlidingDFT; } return false; }
+    
     /**
     Returns the FFT results computed from the last FFT of the input signal.
     
@@ -340,6 +352,8 @@ public:
 protected:
     bool isPowerOfTwo(UINT x);                                   ///< A helper function to compute if the input is a power of two
     bool validateFFTWindowFunction(UINT fftWindowFunction);
+    bool updateSample(const VectorFloat &x);                     ///< Adds one sample to the data buffer and computes the FFT if needed
+    void setupSlidingDFT();                                      ///< Sets if the sliding DFT should be used and resets its state
     
     UINT hopSize;                                               ///< The current hopSize, this sets how often the fft should be computed
     UINT dataBufferSize;                                        ///< Stores how much previous input data is stored in the dataBuffer
@@ -351,6 +365,13 @@ protected:
     VectorFloat tempBuffer;                                     ///< A temporary buffer used to store the input data for the FFT
     CircularBuffer< VectorFloat > dataBuffer;                  ///< A circular buffer used to store the previous M inputs
     Vector< FastFourierTransform > fft;                         ///< A buffer used to store the FFT results
+    bool useSlidingDFT;                                         ///< True if the spectrum is updated with a sliding DFT
+    bool slidingDFTValid;                                       ///< True if the sliding DFT holds the spectrum of the current window
+    UINT slidingDFTCounter;                                     ///< The number of samples since the sliding DFT was last computed with an FFT
+    VectorFloat twiddleReal;                                    ///< The real part of exp(-2*pi*i*k/M) for each frequency bin k, shared by all the dimensions
+    VectorFloat twiddleImag;                                    ///< The imaginary part of exp(-2*pi*i*k/M) for each frequency bin k, shared by all the dimensions
+    MatrixFloat slidingReal;                                    ///< The real part of the spectrum of each dimension, in the packed layout used by the FastFourierTransform
+    MatrixFloat slidingImag;                                    ///< The imaginary part of the spectrum of each dimension, in the packed layout used by the FastFourierTransform
     std::map< unsigned int, unsigned int > windowSizeMap;       ///< A map to relate the FFTWindowSize enumerations to actual values
     
 private:
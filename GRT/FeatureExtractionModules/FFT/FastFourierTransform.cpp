@@ -37,7 +37,6 @@ FastFourierTransform::FastFourierTransform(){
 	windowFunction = RECTANGULAR_WINDOW;
 	averagePower = 0;
     
-	initFFT();
 }
     
 FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
@@ -49,7 +48,6 @@ FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
     this->windowSize = rhs.windowSize;
     this->windowFunction = rhs.windowFunction;
     this->averagePower = 0;
-    this->initFFT();
     this->infoLog = rhs.infoLog;
     this->warningLog = rhs.warningLog;
     this->errorLog = rhs.errorLog;
@@ -82,8 +80,7 @@ FastFourierTransform& FastFourierTransform::operator=(const FastFourierTransform
         this->windowSize = rhs.windowSize;
         this->windowFunction = rhs.windowFunction;
         this->averagePower = 0;
-        this->initFFT();
-        
+            
         if( rhs.initialized ){
             this->init(rhs.windowSize,rhs.windowFunction,rhs.computeMagnitude,rhs.computePhase);
             
@@ -115,8 +112,6 @@ bool FastFourierTransform::init(const unsigned int windowSize,const unsigned int
         return false;
     }
     
-    initFFT();
-    
     this->windowSize = windowSize;
     this->windowFunction = windowFunction;
     this->computeMagnitude = computeMagnitude;
@@ -146,6 +141,12 @@ bool FastFourierTransform::init(const unsigned int windowSize,const unsigned int
         power[i] = 0;
     }
     
+    //Compute the window function once, rather than for every FFT
+    windowTable.clear();
+    VectorFloat table( windowSize, 1.0 );
+    windowData( table );
+    windowTable = table;
+    
     //Flag that the FFT has been initialized
     initialized = true;
     
@@ -190,6 +191,27 @@ bool FastFourierTransform::computeFFT( VectorFloat &data ){
     //Perform the FFT
     realFFT(data, &fftReal[0], &fftImag[0]);
 	
+    computeSpectrum();
+    
+    return true;
+}
+
+bool FastFourierTransform::setFFTData( const Float *realIn, const Float *imagIn ){
+    
+    if( !initialized ){
+        return false;
+    }
+    
+    std::copy( realIn, realIn + windowSize/2, &fftReal[0] );
+    std::copy( imagIn, imagIn + windowSize/2, &fftImag[0] );
+    
+    computeSpectrum();
+    
+    return true;
+}
+
+void FastFourierTransform::computeSpectrum(){
+    
     averagePower = 0;
     
     for(unsigned int i = 0; i<windowSize/2; i++){
@@ -207,14 +229,19 @@ bool FastFourierTransform::computeFFT( VectorFloat &data ){
 
     //Compute the average power
     averagePower = averagePower / (Float)(windowSize/2);
-    
-    return true;
 }
     
 bool FastFourierTransform::windowData( VectorFloat &data ){
    
 	const unsigned int N = (unsigned int)data.size();
  	const unsigned int K = N/2;
+    
+    //Use the precomputed window if the data fills the window
+    if( N == windowSize && windowTable.getSize() == windowSize ){
+        if( windowFunction == RECTANGULAR_WINDOW ) return true;
+        for(unsigned int i=0; i<N; i++) data[i] *= windowTable[i];
+        return true;
+    }
 
     switch( windowFunction ){
         case RECTANGULAR_WINDOW:
@@ -379,7 +406,7 @@ bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,Float *realI
         return false;
     }
     
-    if( bitTable.size() == 0 ) initFFT();
+    const Vector< Vector< int > > &bitTable = getBitTable();
     
     if( inverseTransform ) angle_numerator = -angle_numerator;
     
@@ -387,7 +414,7 @@ bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,Float *realI
     
     //Simultaneously data copy and bit-reversal ordering into outputs...
     for(i = 0; i < numSamples; i++) {
-        j = fastReverseBits(i, NumBits);
+        j = fastReverseBits(bitTable, i, NumBits);
         realOut[j] = realIn[i];
         imagOut[j] = (imagIn == NULL) ? 0.0 : imagIn[i];
     }
@@ -471,23 +498,27 @@ int FastFourierTransform::reverseBits(int index, int numBits)
     return rev;
 }
 
-void FastFourierTransform::initFFT()
+const Vector< Vector< int > >& FastFourierTransform::getBitTable()
 {
-    bitTable.resize( MAX_FAST_BITS );
-    
-    int len = 2;
-    for (int b = 1; b <= MAX_FAST_BITS; b++) {
-        
-        bitTable[b - 1].resize(len);
-        
-        for (int i = 0; i < len; i++)
-            bitTable[b - 1][i] = reverseBits(i, b);
-        
-        len <<= 1;
-    }
+    //The bit reversal tables only depend on the number of bits, so they are built once and shared by every FFT
+    static const Vector< Vector< int > > bitTable = [](){
+        Vector< Vector< int > > table( MAX_FAST_BITS );
+        int len = 2;
+        for (int b = 1; b <= MAX_FAST_BITS; b++) {
+            
+            table[b - 1].resize(len);
+            
+            for (int i = 0; i < len; i++)
+                table[b - 1][i] = reverseBits(i, b);
+            
+            len <<= 1;
+        }
+        return table;
+    }();
+    return bitTable;
 }
 
-inline int FastFourierTransform::fastReverseBits(const int i, const int numBits)
+inline int FastFourierTransform::fastReverseBits(const Vector< Vector< int > > &bitTable, const int i, const int numBits)
 {
     if (numBits <= MAX_FAST_BITS)
         return bitTable[numBits - 1][i];
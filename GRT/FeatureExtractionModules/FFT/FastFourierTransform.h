@@ -57,16 +57,39 @@ public:
 	Float *getPhaseDataPtr();
 	Float *getPowerDataPtr();
     
+    /**
+     Sets the result of the FFT and computes the magnitude, phase and power from it. The spectrum uses the same packed layout as the FFT:
+     element 0 holds the DC component in the real part and the Nyquist component in the imaginary part, the elements 1 to N/2-1 hold the
+     real and imaginary parts of the other frequency bins. This can be used to set a spectrum that was computed without an FFT, such as
+     the spectrum of a sliding DFT.
+     
+     @param realIn: a pointer to the N/2 real values of the spectrum
+     @param imagIn: a pointer to the N/2 imaginary values of the spectrum
+     @return returns true if the spectrum was set, false otherwise
+     */
+    bool setFFTData( const Float *realIn, const Float *imagIn );
+    
+    /**
+     @return returns a pointer to the N/2 real values of the last spectrum, using the packed layout described in setFFTData
+     */
+    const Float *getRealDataPtr() const { return &fftReal[0]; }
+    
+    /**
+     @return returns a pointer to the N/2 imaginary values of the last spectrum, using the packed layout described in setFFTData
+     */
+    const Float *getImagDataPtr() const { return &fftImag[0]; }
+    
 	UINT getFFTSize() const { return windowSize; }
     
 protected:
     bool windowData( VectorFloat &data );
+    void computeSpectrum();
     bool realFFT( const VectorFloat &realIn, Float *realOut, Float *imagOut );
     bool FFT(int NumSamples,bool InverseTransform,Float *realIn, Float *imagIn, Float *realOut, Float *imagOut);
     int numberOfBitsNeeded(int PowerOfTwo);
-    int reverseBits(int index, int NumBits);
-    void initFFT();
-    inline int fastReverseBits(const int i, const int NumBits);
+    static int reverseBits(int index, int NumBits);
+    static const Vector< Vector< int > >& getBitTable();
+    inline int fastReverseBits(const Vector< Vector< int > > &bitTable, const int i, const int NumBits);
     inline bool isPowerOfTwo(const unsigned int x);
     
     unsigned int windowSize;
@@ -82,9 +105,9 @@ protected:
     VectorFloat magnitude;
     VectorFloat phase;
     VectorFloat power;
+    VectorFloat windowTable;    //The window function, computed once for the full window size
     Float averagePower;
-    const int MAX_FAST_BITS = 16;
-    Vector< Vector< int > > bitTable;
+    static const int MAX_FAST_BITS = 16;
 };
     
 GRT_END_NAMESPACE
@@ -54,6 +54,8 @@
 #include "Util/SVD.h"
 #include "Util/LUDecomposition.h"
 #include "Util/Cholesky.h"
+#include "Util/GEMM.h"
+#include "Util/BinaryDataFile.h"
 #include "Util/EigenvalueDecomposition.h"
 #include "Util/TestResult.h"
 #include "Util/ClassificationResult.h"
@@ -68,10 +70,12 @@
 #include "DataStructures/Matrix.h"
 #include "DataStructures/MatrixFloat.h"
 #include "DataStructures/ClassificationData.h"
+#include "DataStructures/ClassificationDataView.h"
 #include "DataStructures/TimeSeriesClassificationData.h"
 #include "DataStructures/ClassificationDataStream.h"
 #include "DataStructures/RegressionData.h"
 #include "DataStructures/UnlabelledData.h"
+#include "DataStructures/ChunkedDataset.h"
 
 //Include the Core Alogirthms
 #include "CoreAlgorithms/BernoulliRBM/BernoulliRBM.h"
@@ -84,6 +88,7 @@
 #include "CoreAlgorithms/Tree/Tree.h"
 #include "CoreAlgorithms/MeanShift/MeanShift.h"
 #include "CoreAlgorithms/GridSearch/GridSearch.h"
+#include "CoreAlgorithms/KDTree/KDTree.h"
 
 //Include the PreProcessing Modules
 #include "PreProcessingModules/Derivative.h"
@@ -23,6 +23,141 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 GRT_BEGIN_NAMESPACE
 
+RunningMedian::RunningMedian(){
+    windowSize = 0;
+    numValues = 0;
+    writeIndex = 0;
+    heapSizes[LOWER_HEAP] = 0;
+    heapSizes[UPPER_HEAP] = 0;
+}
+
+RunningMedian::~RunningMedian(){
+
+}
+
+bool RunningMedian::init(const UINT windowSize){
+
+    if( windowSize == 0 ) return false;
+
+    this->windowSize = windowSize;
+    values.resize( windowSize, 0 );
+    heapId.resize( windowSize, 0 );
+    heapPosition.resize( windowSize, 0 );
+    heaps[LOWER_HEAP].resize( windowSize, 0 );
+    heaps[UPPER_HEAP].resize( windowSize, 0 );
+
+    return clear();
+}
+
+bool RunningMedian::clear(){
+    numValues = 0;
+    writeIndex = 0;
+    heapSizes[LOWER_HEAP] = 0;
+    heapSizes[UPPER_HEAP] = 0;
+    return true;
+}
+
+bool RunningMedian::push(const Float value){
+
+    if( windowSize == 0 ) return false;
+
+    const UINT slot = writeIndex;
+    if( ++writeIndex == windowSize ) writeIndex = 0;
+    values[slot] = value;
+
+    if( numValues < windowSize ){
+        //The window is still filling up, so add the value to the heap it belongs in and then rebalance the heaps so the
+        //upper heap holds the same number of values as the lower heap, or one more
+        numValues++;
+        if( heapSizes[UPPER_HEAP] == 0 || value >= values[ heaps[UPPER_HEAP][0] ] ) pushNode( UPPER_HEAP, slot );
+        else pushNode( LOWER_HEAP, slot );
+
+        if( heapSizes[UPPER_HEAP] > heapSizes[LOWER_HEAP]+1 ) pushNode( LOWER_HEAP, popNode( UPPER_HEAP ) );
+        else if( heapSizes[LOWER_HEAP] > heapSizes[UPPER_HEAP] ) pushNode( UPPER_HEAP, popNode( LOWER_HEAP ) );
+        return true;
+    }
+
+    //The window is full, so the new value overwrites the oldest value in place and we restore its heap
+    const UINT heap = heapId[slot];
+    siftDown( heap, siftUp( heap, heapPosition[slot] ) );
+
+    //If the new value crossed the median, swap the tops of the two heaps to restore the ordering between them
+    if( heapSizes[LOWER_HEAP] > 0 && values[ heaps[LOWER_HEAP][0] ] > values[ heaps[UPPER_HEAP][0] ] ){
+        const UINT lowerTop = heaps[LOWER_HEAP][0];
+        const UINT upperTop = heaps[UPPER_HEAP][0];
+        heaps[LOWER_HEAP][0] = upperTop;
+        heaps[UPPER_HEAP][0] = lowerTop;
+        heapId[upperTop] = LOWER_HEAP;
+        heapId[lowerTop] = UPPER_HEAP;
+        siftDown( LOWER_HEAP, 0 );
+        siftDown( UPPER_HEAP, 0 );
+    }
+
+    return true;
+}
+
+Float RunningMedian::getMedian() const{
+    if( numValues == 0 ) return 0;
+    return values[ heaps[UPPER_HEAP][0] ];
+}
+
+UINT RunningMedian::getNumValues() const { return numValues; }
+
+UINT RunningMedian::getWindowSize() const { return windowSize; }
+
+bool RunningMedian::higherPriority(const UINT heap,const UINT a,const UINT b) const{
+    if( heap == UPPER_HEAP ) return values[a] < values[b];
+    return values[a] > values[b];
+}
+
+void RunningMedian::swapNodes(const UINT heap,const UINT i,const UINT j){
+    std::swap( heaps[heap][i], heaps[heap][j] );
+    heapPosition[ heaps[heap][i] ] = i;
+    heapPosition[ heaps[heap][j] ] = j;
+}
+
+UINT RunningMedian::siftUp(const UINT heap,UINT i){
+    while( i > 0 ){
+        const UINT parent = (i-1)/2;
+        if( !higherPriority( heap, heaps[heap][i], heaps[heap][parent] ) ) break;
+        swapNodes( heap, i, parent );
+        i = parent;
+    }
+    return i;
+}
+
+void RunningMedian::siftDown(const UINT heap,UINT i){
+    const UINT size = heapSizes[heap];
+    while( true ){
+        const UINT left = 2*i + 1;
+        if( left >= size ) break;
+        UINT child = left;
+        if( left+1 < size && higherPriority( heap, heaps[heap][left+1], heaps[heap][left] ) ) child = left+1;
+        if( !higherPriority( heap, heaps[heap][child], heaps[heap][i] ) ) break;
+        swapNodes( heap, i, child );
+        i = child;
+    }
+}
+
+void RunningMedian::pushNode(const UINT heap,const UINT slot){
+    const UINT i = heapSizes[heap]++;
+    heaps[heap][i] = slot;
+    heapId[slot] = heap;
+    heapPosition[slot] = i;
+    siftUp( heap, i );
+}
+
+UINT RunningMedian::popNode(const UINT heap){
+    const UINT slot = heaps[heap][0];
+    const UINT last = --heapSizes[heap];
+    if( last > 0 ){
+        heaps[heap][0] = heaps[heap][last];
+        heapPosition[ heaps[heap][0] ] = 0;
+        siftDown( heap, 0 );
+    }
+    return slot;
+}
+
 //Define the string that will be used to identify the object
 const std::string MedianFilter::id = "MedianFilter";
 std::string MedianFilter::getId() { return MedianFilter::id; }
@@ -55,11 +190,14 @@ MedianFilter& MedianFilter::operator=(const MedianFilter &rhs){
         this->filterSize = 0;
         this->inputSampleCounter = 0;
         this->dataBuffer.clear();
+        this->runningMedians.clear();
         
         //Copy from the rhs instance
         if( rhs.initialized ){
             this->init( rhs.filterSize, rhs.numInputDimensions );
+            this->inputSampleCounter = rhs.inputSampleCounter;
             this->dataBuffer = rhs.dataBuffer;
+            this->runningMedians = rhs.runningMedians;
         }
         
         //Copy the preprocessing base variables
@@ -197,6 +335,12 @@ bool MedianFilter::init(const UINT filterSize,const UINT numDimensions){
     
     if( !initialized ){
         errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to resize dataBuffer!" << std::endl;
+        return false;
+    }
+    
+    runningMedians.resize( numDimensions );
+    for(unsigned int j=0; j<numDimensions; j++){
+        runningMedians[j].init( filterSize );
     }
     
     return initialized;
@@ -228,17 +372,10 @@ VectorFloat MedianFilter::filter(const VectorFloat &x){
     //Add the new value to the buffer
     dataBuffer.push_back( x );
     
-    //Compute the median value for each dimension
-    VectorFloat tmp( inputSampleCounter );
+    //Update the running median for each dimension, this drops the oldest value from the window once it is full
     for(unsigned int j=0; j<numInputDimensions; j++){
-        for(unsigned int i=0; i<inputSampleCounter; i++) {
-            tmp[i] = dataBuffer[i][j];
-        }
-        std::sort(tmp.begin(),tmp.end());
-        
-        //Get the median value
-        unsigned int medianIndex = (inputSampleCounter/2);
-        processedData[j] = tmp[ medianIndex ];
+        runningMedians[j].push( x[j] );
+        processedData[j] = runningMedians[j].getMedian();
     }
     
     return processedData;
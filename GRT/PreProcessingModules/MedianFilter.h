@@ -32,6 +32,90 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 GRT_BEGIN_NAMESPACE
 
+/**
+ @brief The RunningMedian class keeps track of the median of the last N values pushed into it.
+
+ The window is split across a max-heap that holds the lower half of the values and a min-heap that holds the upper half,
+ with each value remembering its position in its heap. Pushing a new value into a full window overwrites the oldest value
+ in place and repairs the heaps, so each update costs O(log N) and never allocates memory.
+*/
+class GRT_API RunningMedian {
+public:
+    /**
+    Default Constructor, the window size must be set using init before any values can be pushed.
+    */
+    RunningMedian();
+
+    /**
+    Default Destructor
+    */
+    ~RunningMedian();
+
+    /**
+    Sets the size of the window and clears any values already in the window.
+
+    @param windowSize: the number of values the median is computed over, must be greater than zero
+    @return true if the window was initialized, false otherwise
+    */
+    bool init(const UINT windowSize);
+
+    /**
+    Removes all the values from the window, the window size is not changed.
+
+    @return true if the window was cleared, false otherwise
+    */
+    bool clear();
+
+    /**
+    Adds a new value to the window.  If the window is full, the oldest value in the window will be removed.
+
+    @param value: the new value to add to the window
+    @return true if the value was added, false otherwise
+    */
+    bool push(const Float value);
+
+    /**
+    Gets the median of the values currently in the window.  If the window holds an even number of values then
+    the upper of the two middle values is returned.
+
+    @return the median of the window, or zero if the window is empty
+    */
+    Float getMedian() const;
+
+    /**
+    Gets the number of values currently in the window.
+
+    @return returns the number of values in the window
+    */
+    UINT getNumValues() const;
+
+    /**
+    Gets the size of the window.
+
+    @return returns the window size
+    */
+    UINT getWindowSize() const;
+
+protected:
+    enum HeapIndex{LOWER_HEAP=0,UPPER_HEAP,NUM_HEAPS};
+
+    bool higherPriority(const UINT heap,const UINT a,const UINT b) const;
+    void swapNodes(const UINT heap,const UINT i,const UINT j);
+    UINT siftUp(const UINT heap,UINT i);
+    void siftDown(const UINT heap,UINT i);
+    void pushNode(const UINT heap,const UINT slot);
+    UINT popNode(const UINT heap);
+
+    UINT windowSize;                                        ///< The maximum number of values in the window
+    UINT numValues;                                         ///< The number of values currently in the window
+    UINT writeIndex;                                        ///< The slot the next value will be written to
+    VectorFloat values;                                     ///< The values in the window, indexed by slot
+    Vector< UINT > heapId;                                  ///< The heap each slot is currently in
+    Vector< UINT > heapPosition;                            ///< The position of each slot within its heap
+    Vector< UINT > heaps[NUM_HEAPS];                        ///< The slots in the lower (max) and upper (min) heaps
+    UINT heapSizes[NUM_HEAPS];                              ///< The number of slots in each heap
+};
+
 /**
  @brief The MedianFilter implements a simple median filter: https://en.wikipedia.org/wiki/Median_filter
 */
@@ -176,6 +260,7 @@ protected:
     UINT filterSize;                                        ///< The size of the filter
     UINT inputSampleCounter;                                ///< A counter to keep track of the number of input samples
     CircularBuffer< VectorFloat > dataBuffer;           ///< A buffer to store the previous N values, N = filterSize
+    Vector< RunningMedian > runningMedians;                 ///< The running median of each dimension over the previous N values
     
 private:
     static const std::string id;   
@@ -21,6 +21,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define GRT_DLL_EXPORTS
 #include "MLP.h"
 #include "../../../CoreModules/Regressifier.h"
+#include "../../../Util/GEMM.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -40,6 +41,7 @@ MLP::MLP() : Regressifier( MLP::getId() )
     numRestarts = 1;
     validationSetSize = 20; //20% of the training data will be set aside for the validation set
     trainingMode = ONLINE_GRADIENT_DESCENT;
+    batchSize = 1;
     momentum = 0.5;
     gamma = 2.0;
     trainingError = 0;
@@ -70,17 +72,22 @@ MLP& MLP::operator=(const MLP &rhs){
         this->numInputNeurons = rhs.numInputNeurons;
         this->numHiddenNeurons = rhs.numHiddenNeurons;
         this->numOutputNeurons = rhs.numOutputNeurons;
+        this->hiddenLayerSizes = rhs.hiddenLayerSizes;
         this->inputLayerActivationFunction = rhs.inputLayerActivationFunction;
         this->hiddenLayerActivationFunction = rhs.hiddenLayerActivationFunction;
         this->outputLayerActivationFunction = rhs.outputLayerActivationFunction;
         this->trainingMode = rhs.trainingMode;
+        this->batchSize = rhs.batchSize;
         this->momentum = rhs.momentum;
         this->trainingError = rhs.trainingError;
         this->gamma = rhs.gamma;
         this->initialized = rhs.initialized;
-        this->inputLayer = rhs.inputLayer;
-        this->hiddenLayer = rhs.hiddenLayer;
-        this->outputLayer = rhs.outputLayer;
+        this->inputLayerWeights = rhs.inputLayerWeights;
+        this->inputLayerBias = rhs.inputLayerBias;
+        this->layerWeights = rhs.layerWeights;
+        this->layerBias = rhs.layerBias;
+        this->layerPreviousUpdates = rhs.layerPreviousUpdates;
+        this->layerPreviousBiasUpdates = rhs.layerPreviousBiasUpdates;
         this->inputVectorRanges = rhs.inputVectorRanges;
         this->targetVectorRanges = rhs.targetVectorRanges;
         this->trainingErrorLog = rhs.trainingErrorLog;
@@ -94,6 +101,13 @@ MLP& MLP::operator=(const MLP &rhs){
         this->maxLikelihood = rhs.maxLikelihood;
         this->classLikelihoods = rhs.classLikelihoods;
         
+        //Copy the temporary buffers, so they always match the size of the layers
+        this->scaledInput = rhs.scaledInput;
+        this->layerOutputs = rhs.layerOutputs;
+        this->layerDeltas = rhs.layerDeltas;
+        this->batchLayerOutputs = rhs.batchLayerOutputs;
+        this->batchLayerDeltas = rhs.batchLayerDeltas;
+        
         //Copy the base variables
         copyBaseVariables( (Regressifier*)&rhs );
     }
@@ -151,6 +165,260 @@ bool MLP::train_(RegressionData &trainingData){
     return trainModel(trainingData);
 }
 
+bool MLP::train_(ChunkedDataset &trainingData){
+    
+    trained = false;
+    
+    if( !initialized ){
+        errorLog << __GRT_LOG__ << " The MLP has not be initialized!" << std::endl;
+        return false;
+    }
+    
+    //Classification data is trained in classification mode, with one output per class, and regression data in regression mode
+    const bool classification = trainingData.getDataType() == ChunkedDataset::CLASSIFICATION_DATA;
+    const UINT M = trainingData.getNumSamples();
+    const UINT N = trainingData.getNumInputDimensions();
+    const UINT T = classification ? trainingData.getNumClasses() : trainingData.getNumTargetDimensions();
+    
+    if( M == 0 ){
+        errorLog << __GRT_LOG__ << " The training data is empty!" << std::endl;
+        return false;
+    }
+    if( N != numInputNeurons ){
+        errorLog << __GRT_LOG__ << " The number of input dimensions in the training data (" << N << ") does not match that of the MLP (" << numInputNeurons << ")" << std::endl;
+        return false;
+    }
+    if( T != numOutputNeurons ){
+        errorLog << __GRT_LOG__ << " The number of target dimensions in the training data (" << T << ") does not match that of the MLP (" << numOutputNeurons << ")" << std::endl;
+        return false;
+    }
+    
+    classificationModeActive = classification;
+    numInputDimensions = numInputNeurons;
+    numOutputDimensions = numOutputNeurons;
+    
+    //Set the target values that the output layer neurons should be scaled to
+    setOutputTargets();
+    
+    //The data is scaled one chunk at a time as it is used, so only the ranges are needed here. These are kept in local copies
+    //as each random restart calls init(), which clears the ranges of the model
+    Vector< MinMax > inputRanges;
+    Vector< MinMax > targetRanges;
+    if( useScaling ){
+        inputRanges = trainingData.getInputRanges();
+        targetRanges = classification ? Vector< MinMax >( T, MinMax(0,1) ) : trainingData.getTargetRanges();
+        if( inputRanges.getSize() != N || targetRanges.getSize() != T ){
+            errorLog << __GRT_LOG__ << " Failed to compute the ranges of the training data!" << std::endl;
+            return false;
+        }
+    }
+    
+    //The class targets are the same as ClassificationData::reformatAsRegressionData, scaled to the output targets if scaling is enabled
+    const bool tempScalingState = useScaling;
+    const Float classTargetMin = tempScalingState ? outputTargets.minValue : 0;
+    const Float classTargetMax = tempScalingState ? outputTargets.maxValue : 1;
+    const Vector< ClassTracker > classTracker = trainingData.getClassTracker();
+    const Vector< MinMax > emptyRanges;
+    useScaling = false;
+    
+    //Setup the training loop
+    bool keepTraining = true;
+    UINT epoch = 0;
+    Float alpha = learningRate;
+    Float beta = momentum;
+    UINT bestIter = 0;
+    MLP bestNetwork;
+    totalSquaredTrainingError = 0;
+    rmsTrainingError = 0;
+    rmsValidationError = 0;
+    trainingError = 0;
+    Float error = 0;
+    Float lastError = 0;
+    Float bestError = grt_numeric_limits< Float >::max();
+    Float bestRMSError = grt_numeric_limits< Float >::max();
+    Float delta = 0;
+    VectorFloat inputVector(N);
+    VectorFloat targetVector(T);
+    MatrixFloat classTargets;
+    Vector< VectorFloat > tempTrainingErrorLog;
+    TrainingResult result;
+    trainingErrorLog.clear();
+    
+    for(UINT iter=0; iter<numRestarts; iter++){
+        
+        epoch = 0;
+        keepTraining = true;
+        tempTrainingErrorLog.clear();
+        
+        //Randomise the start values of the neurons
+        init(numInputNeurons,hiddenLayerSizes,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
+        
+        while( keepTraining ){
+            
+            //Perform one training epoch, the chunked dataset shuffles the chunks (and the samples in each chunk) for each epoch
+            totalSquaredTrainingError = 0;
+            rmsTrainingError = 0;
+            
+            if( !trainingData.startEpoch() ){
+                useScaling = tempScalingState;
+                return false;
+            }
+            while( trainingData.nextChunk() ){
+                
+                if( tempScalingState ) trainingData.scaleChunk( inputRanges, classification ? emptyRanges : targetRanges, outputTargets.minValue, outputTargets.maxValue );
+                
+                const MatrixFloat &X = trainingData.getInputs();
+                const UINT numRows = X.getNumRows();
+                if( classification ){
+                    const Vector< UINT > &labels = trainingData.getClassLabels();
+                    classTargets.resize( numRows, T );
+                    for(UINT i=0; i<numRows; i++){
+                        for(UINT k=0; k<T; k++){
+                            classTargets[i][k] = labels[i] == classTracker[k].classLabel ? classTargetMax : classTargetMin;
+                        }
+                    }
+                }
+                const MatrixFloat &Y = classification ? classTargets : trainingData.getTargets();
+                
+                //Batches do not span chunks
+                for(UINT i=0; i<numRows; i+=batchSize){
+                    const UINT numBatchSamples = std::min( batchSize, numRows-i );
+                    Float backPropError = 0;
+                    
+                    //Perform the back propagation on the next batch of training examples
+                    if( numBatchSamples == 1 ){
+                        std::copy( X[i], X[i]+N, inputVector.begin() );
+                        std::copy( Y[i], Y[i]+T, targetVector.begin() );
+                        backPropError = back_prop( inputVector, targetVector, alpha, beta );
+                    }else{
+                        setupBatchBuffers( numBatchSamples );
+                        for(UINT n=0; n<numBatchSamples; n++){
+                            std::copy( X[i+n], X[i+n]+N, batchLayerOutputs[0][n] );
+                            std::copy( Y[i+n], Y[i+n]+T, batchTargets[n] );
+                        }
+                        backPropError = back_prop( numBatchSamples, alpha, beta );
+                    }
+                    
+                    if( isNAN(backPropError) ){
+                        errorLog << __GRT_LOG__ << " NaN found in back propagation error, epoch: " << epoch << std::endl;
+                        useScaling = tempScalingState;
+                        return false;
+                    }
+                    
+                    //Compute the error for the examples in the batch
+                    totalSquaredTrainingError += backPropError; //The backPropError is already squared
+                }
+            }
+            
+            if( checkForNAN() ){
+                errorLog << __GRT_LOG__ << " NaN found in weights at epoch " << epoch << std::endl;
+                useScaling = tempScalingState;
+                return false;
+            }
+            
+            //Compute the rms error on the training set
+            rmsTrainingError = sqrt( totalSquaredTrainingError / Float(M) );
+            
+            //Store the errors
+            VectorFloat temp(2);
+            temp[0] = rmsTrainingError;
+            temp[1] = rmsValidationError;
+            tempTrainingErrorLog.push_back( temp );
+            
+            error = rmsTrainingError;
+            
+            //Store the training results
+            result.setRegressionResult(iter,rmsTrainingError,rmsValidationError,this);
+            trainingResults.push_back( result );
+            
+            delta = fabs( error - lastError );
+            
+            trainingLog << "Random Training Iteration: " << iter+1 << " Epoch: " << epoch << " Rms Training Error: " << rmsTrainingError << " Delta: " << delta << std::endl;
+            
+            //Check to see if we should stop training
+            if( ++epoch >= maxNumEpochs ){
+                keepTraining = false;
+            }
+            if( delta <= minChange && epoch >= minNumEpochs ){
+                keepTraining = false;
+            }
+            
+            //Update the last error
+            lastError = error;
+            
+            //Notify any observers of the new training result
+            trainingResultsObserverManager.notifyObservers( result );
+            
+        }//End of While( keepTraining )
+        
+        //Check to see if this is the best model so far
+        if( lastError < bestError ){
+            bestIter = iter;
+            bestError = lastError;
+            bestRMSError = rmsTrainingError;
+            bestNetwork = *this;
+            trainingErrorLog = tempTrainingErrorLog;
+        }
+        
+    }//End of For( numRestarts )
+    
+    trainingLog << "Best Rms Error: " << bestRMSError << " in Random Training Iteration: " << bestIter+1 << std::endl;
+    
+    //Set the MLP model to the model that best during training
+    *this = bestNetwork;
+    trainingError = bestRMSError;
+    classificationModeActive = classification;
+    numInputDimensions = numInputNeurons;
+    numOutputDimensions = numOutputNeurons;
+    inputVectorRanges = inputRanges;
+    targetVectorRanges = targetRanges;
+    
+    //Compute the rejection threshold from the outputs for the correctly classified training examples, with one more pass over the data
+    if( classification && useNullRejection ){
+        
+        Float averageValue = 0;
+        VectorFloat classificationPredictions;
+        
+        bool ok = trainingData.startEpoch();
+        while( ok && trainingData.nextChunk() ){
+            if( tempScalingState ) trainingData.scaleChunk( inputRanges, emptyRanges, outputTargets.minValue, outputTargets.maxValue );
+            const MatrixFloat &X = trainingData.getInputs();
+            const Vector< UINT > &labels = trainingData.getClassLabels();
+            for(UINT i=0; i<X.getNumRows(); i++){
+                std::copy( X[i], X[i]+N, inputVector.begin() );
+                const VectorFloat &y = feedforward( inputVector );
+                
+                //Get the predicted class index
+                UINT bestIndex = 0;
+                for(UINT k=1; k<T; k++){
+                    if( y[k] > y[bestIndex] ) bestIndex = k;
+                }
+                
+                //Only add the max value if the prediction is correct
+                if( labels[i] == classTracker[bestIndex].classLabel ){
+                    classificationPredictions.push_back( y[bestIndex] );
+                    averageValue += y[bestIndex];
+                }
+            }
+        }
+        
+        averageValue /= Float(classificationPredictions.size());
+        Float stdDev = 0;
+        for(UINT i=0; i<classificationPredictions.size(); i++){
+            stdDev += SQR(classificationPredictions[i]-averageValue);
+        }
+        stdDev = sqrt( stdDev / Float(classificationPredictions.size()-1) );
+        
+        nullRejectionThreshold = averageValue-(stdDev*nullRejectionCoeff);
+    }
+    
+    //Reset the scaling state so the prediction data will be scaled if needed
+    useScaling = tempScalingState;
+    trained = true;
+    
+    return trained;
+}
+
 //Classifier interface
 bool MLP::predict_(VectorFloat &inputVector){
     
@@ -221,6 +489,19 @@ bool MLP::init(const UINT numInputNeurons,
                 const Neuron::Type inputLayerActivationFunction,
                 const Neuron::Type hiddenLayerActivationFunction,
                 const Neuron::Type outputLayerActivationFunction){
+    return init(numInputNeurons, Vector< UINT >(1,numHiddenNeurons), numOutputNeurons, inputLayerActivationFunction, hiddenLayerActivationFunction, outputLayerActivationFunction );
+}
+
+bool MLP::init(const UINT numInputNeurons,
+                const Vector< UINT > &hiddenLayerSizes,
+                const UINT numOutputNeurons,
+                const Neuron::Type inputLayerActivationFunction,
+                const Neuron::Type hiddenLayerActivationFunction,
+                const Neuron::Type outputLayerActivationFunction){
+    
+    //Copy the hidden layer sizes before clearing the model, as they may be this instance's own hiddenLayerSizes
+    const Vector< UINT > layerSizes = hiddenLayerSizes;
+    const UINT numHiddenLayers = layerSizes.getSize();
     
     //Clear any previous models
     clear();
@@ -228,13 +509,20 @@ bool MLP::init(const UINT numInputNeurons,
     //Initialize the random seed
     random.setSeed( (UINT)time(NULL) );
     
-    if( numInputNeurons == 0 || numHiddenNeurons == 0 || numOutputNeurons == 0 ){
+    if( numInputNeurons == 0 || numHiddenLayers == 0 || numOutputNeurons == 0 ){
         if( numInputNeurons == 0 ){  errorLog << __GRT_LOG__ << " The number of input neurons is zero!" << std::endl; }
-        if( numHiddenNeurons == 0 ){  errorLog << __GRT_LOG__ << " The number of hidden neurons is zero!" << std::endl; }
+        if( numHiddenLayers == 0 ){  errorLog << __GRT_LOG__ << " The number of hidden layers is zero!" << std::endl; }
         if( numOutputNeurons == 0 ){  errorLog << __GRT_LOG__ << " The number of output neurons is zero!" << std::endl; }
         return false;
     }
     
+    for(UINT l=0; l<numHiddenLayers; l++){
+        if( layerSizes[l] == 0 ){
+            errorLog << __GRT_LOG__ << " The number of hidden neurons in hidden layer " << l << " is zero!" << std::endl;
+            return false;
+        }
+    }
+    
     //Validate the activation functions
     if( !validateActivationFunction(inputLayerActivationFunction) || !validateActivationFunction(hiddenLayerActivationFunction) || !validateActivationFunction(outputLayerActivationFunction) ){
         errorLog << __GRT_LOG__ << " One Of The Activation Functions Failed The Validation Check" << std::endl;
@@ -243,8 +531,9 @@ bool MLP::init(const UINT numInputNeurons,
     
     //Set the size of the MLP
     this->numInputNeurons = numInputNeurons;
-    this->numHiddenNeurons = numHiddenNeurons;
+    this->numHiddenNeurons = layerSizes[0];
     this->numOutputNeurons = numOutputNeurons;
+    this->hiddenLayerSizes = layerSizes;
     
     //Set the regression IO
     this->numInputDimensions = numInputNeurons;
@@ -255,33 +544,35 @@ bool MLP::init(const UINT numInputNeurons,
     this->hiddenLayerActivationFunction = hiddenLayerActivationFunction;
     this->outputLayerActivationFunction = outputLayerActivationFunction;
     
-    //Setup the neurons for each of the layers
-    inputLayer.resize(numInputNeurons);
-    hiddenLayer.resize(numHiddenNeurons);
-    outputLayer.resize(numOutputNeurons);
+    //Each input neuron has a single input, the weights for the input layer should always be 1 and the bias should always be 0
+    inputLayerWeights.resize(numInputNeurons,1.0);
+    inputLayerBias.resize(numInputNeurons,0.0);
     
-    //Init the neuron memory for each of the layers
-    for(UINT i=0; i<numInputNeurons; i++){
-        inputLayer[i].init(1, inputLayerActivationFunction, random); //The input size for each input neuron will always be 1
-        inputLayer[i].weights[0] = 1.0; //The weights for the input layer should always be 1
-        inputLayer[i].bias = 0.0; //The bias for the input layer should always be 0
-        inputLayer[i].gamma = gamma;
-    }
-
     //Use normalized initialization (Glorot and Bengio, 2010) to init the hidden and output layers
-    const Float numIOHidden = numInputNeurons + numHiddenNeurons;
-    const Float numIOOuput = numHiddenNeurons + numOutputNeurons;
-    const Float hiddenLayerScaleFactor = sqrt(6.0/numIOHidden);
-    const Float outputLayerScaleFactor = sqrt(6.0/numIOOuput);
-    
-    for(UINT i=0; i<numHiddenNeurons; i++){
-        hiddenLayer[i].init(numInputNeurons, hiddenLayerActivationFunction, random, -hiddenLayerScaleFactor, hiddenLayerScaleFactor);
-        hiddenLayer[i].gamma = gamma;
-    }
-    
-    for(UINT i=0; i<numOutputNeurons; i++){
-        outputLayer[i].init(numHiddenNeurons, outputLayerActivationFunction, random, -outputLayerScaleFactor, outputLayerScaleFactor);
-        outputLayer[i].gamma = gamma;
+    const UINT numLayers = numHiddenLayers+1;
+    layerWeights.resize(numLayers);
+    layerBias.resize(numLayers);
+    layerPreviousUpdates.resize(numLayers);
+    layerPreviousBiasUpdates.resize(numLayers);
+    
+    UINT numLayerInputs = numInputNeurons;
+    for(UINT l=0; l<numLayers; l++){
+        const UINT numLayerNeurons = l < numHiddenLayers ? layerSizes[l] : numOutputNeurons;
+        const Float scaleFactor = sqrt( 6.0/Float(numLayerInputs+numLayerNeurons) );
+        
+        layerWeights[l].resize(numLayerNeurons,numLayerInputs);
+        layerBias[l].resize(numLayerNeurons);
+        layerPreviousUpdates[l].resize(numLayerNeurons,numLayerInputs,0);
+        layerPreviousBiasUpdates[l].resize(numLayerNeurons,0);
+        
+        for(UINT i=0; i<numLayerNeurons; i++){
+            for(UINT j=0; j<numLayerInputs; j++){
+                layerWeights[l][i][j] = random.getUniform(-scaleFactor,scaleFactor);
+            }
+            layerBias[l][i] = random.getUniform(-0.1,0.1);
+        }
+        
+        numLayerInputs = numLayerNeurons;
     }
     
     initialized = true;
@@ -297,9 +588,19 @@ bool MLP::clear(){
     numInputNeurons = 0;
     numHiddenNeurons = 0;
     numOutputNeurons = 0;
-    inputLayer.clear();
-    hiddenLayer.clear();
-    outputLayer.clear();
+    hiddenLayerSizes.clear();
+    inputLayerWeights.clear();
+    inputLayerBias.clear();
+    layerWeights.clear();
+    layerBias.clear();
+    layerPreviousUpdates.clear();
+    layerPreviousBiasUpdates.clear();
+    scaledInput.clear();
+    layerOutputs.clear();
+    layerDeltas.clear();
+    batchLayerOutputs.clear();
+    batchLayerDeltas.clear();
+    batchTargets.clear();
     initialized = false;
     
     return true;
@@ -371,11 +672,6 @@ bool MLP::trainModel(RegressionData &trainingData){
     
     //Setup the memory
     trainingErrorLog.clear();
-    inputNeuronsOutput.resize(numInputNeurons);
-    hiddenNeuronsOutput.resize(numHiddenNeurons);
-    outputNeuronsOutput.resize(numOutputNeurons);
-    deltaO.resize(numOutputNeurons);
-    deltaH.resize(numHiddenNeurons);
     
     //Call the main training function
     switch( trainingMode ){
@@ -446,7 +742,7 @@ bool MLP::trainOnlineGradientDescentClassification(const RegressionData &trainin
         tempTrainingErrorLog.clear();
         
         //Randomise the start values of the neurons
-        init(numInputNeurons,numHiddenNeurons,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
+        init(numInputNeurons,hiddenLayerSizes,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
         
         if( randomiseTrainingOrder ){
             for(UINT i=0; i<M; i++){
@@ -460,13 +756,11 @@ bool MLP::trainOnlineGradientDescentClassification(const RegressionData &trainin
             accuracy = 0;
             totalSquaredTrainingError = 0;
             
-            for(UINT i=0; i<M; i++){
-                //Get the i'th training and target Vectors
-                const VectorFloat &trainingExample = trainingData[ indexList[i] ].getInputVector();
-                const VectorFloat &targetVector = trainingData[ indexList[i] ].getTargetVector();
+            for(UINT i=0; i<M; i+=batchSize){
+                const UINT numBatchSamples = std::min( batchSize, M-i );
                 
-                //Perform the back propagation
-                backPropError = back_prop(trainingExample,targetVector,lRate,lMomentum);
+                //Perform the back propagation on the next batch of training examples
+                backPropError = back_prop(trainingData,indexList,i,numBatchSamples,lRate,lMomentum);
                 
                 //debugLog << "i: " << i << " backPropError: " << backPropError << std::endl;
                 
@@ -476,36 +770,40 @@ bool MLP::trainOnlineGradientDescentClassification(const RegressionData &trainin
                     return false;
                 }
                 
-                //Compute the error for the i'th example
+                //Compute the error for each example in the batch
                 if( classificationModeActive ){
-                    y = feedforward( trainingExample );
-                    
-                    //Get the class label
-                    bestValue = targetVector[0];
-                    bestIndex = 0;
-                    for(UINT i=1; i<targetVector.size(); i++){
-                        if( targetVector[i] > bestValue ){
-                            bestValue = targetVector[i];
-                            bestIndex = i;
+                    for(UINT n=i; n<i+numBatchSamples; n++){
+                        const VectorFloat &trainingExample = trainingData[ indexList[n] ].getInputVector();
+                        const VectorFloat &targetVector = trainingData[ indexList[n] ].getTargetVector();
+                        
+                        y = feedforward( trainingExample );
+                        
+                        //Get the class label
+                        bestValue = targetVector[0];
+                        bestIndex = 0;
+                        for(UINT i=1; i<targetVector.size(); i++){
+                            if( targetVector[i] > bestValue ){
+                                bestValue = targetVector[i];
+                                bestIndex = i;
+                            }
                         }
-                    }
-                    classLabel = bestIndex + 1;
-                    
-                    //Get the predicted class label
-                    bestValue = y[0];
-                    bestIndex = 0;
-                    for(UINT i=1; i<numOutputNeurons; i++){
-                        if( y[i] > bestValue ){
-                            bestValue = y[i];
-                            bestIndex = i;
+                        classLabel = bestIndex + 1;
+                        
+                        //Get the predicted class label
+                        bestValue = y[0];
+                        bestIndex = 0;
+                        for(UINT i=1; i<numOutputNeurons; i++){
+                            if( y[i] > bestValue ){
+                                bestValue = y[i];
+                                bestIndex = i;
+                            }
+                        }
+                        predictedClassLabel = bestIndex+1;
+                        
+                        if( classLabel == predictedClassLabel ){
+                            accuracy++;
                         }
                     }
-                    predictedClassLabel = bestIndex+1;
-                    
-                    if( classLabel == predictedClassLabel ){
-                        accuracy++;
-                    }
-                    
                 }else{
                     totalSquaredTrainingError += backPropError; //The backPropError is already squared
                 }
@@ -724,7 +1022,7 @@ bool MLP::trainOnlineGradientDescentRegression(const RegressionData &trainingDat
         tempTrainingErrorLog.clear();
         
         //Randomise the start values of the neurons
-        init(numInputNeurons,numHiddenNeurons,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
+        init(numInputNeurons,hiddenLayerSizes,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
         
         if( randomiseTrainingOrder ){
             std::random_shuffle(indexList.begin(), indexList.end());
@@ -737,23 +1035,19 @@ bool MLP::trainOnlineGradientDescentRegression(const RegressionData &trainingDat
             rmsTrainingError = 0;
             rmsValidationError = 0;
             
-            for(UINT i=0; i<M; i++){
-
-                //Get the i'th training and target Vectors
-                const UINT randomIndex = indexList[i];
-                const VectorFloat &trainingExample = trainingData[ randomIndex ].getInputVector();
-                const VectorFloat &targetVector = trainingData[ randomIndex ].getTargetVector();
+            for(UINT i=0; i<M; i+=batchSize){
+                const UINT numBatchSamples = std::min( batchSize, M-i );
                 
-                //Perform the back propagation
-                Float backPropError = back_prop(trainingExample,targetVector,alpha,beta);
+                //Perform the back propagation on the next batch of training examples
+                Float backPropError = back_prop(trainingData,indexList,i,numBatchSamples,alpha,beta);
                  
                 if( isNAN(backPropError) ){
                     keepTraining = false;
-                    errorLog << __GRT_LOG__ << " NaN found in back propagation error, epoch: " << epoch << " training iter: " << i << " random index: " << indexList[ randomIndex ] << std::endl;
+                    errorLog << __GRT_LOG__ << " NaN found in back propagation error, epoch: " << epoch << " training iter: " << i << " random index: " << indexList[i] << std::endl;
                     return false;
                 }
 
-                //Compute the error for the i'th example
+                //Compute the error for the examples in the batch
                 totalSquaredTrainingError += backPropError; //The backPropError is already squared
             }
             
@@ -774,7 +1068,7 @@ bool MLP::trainOnlineGradientDescentRegression(const RegressionData &trainingDat
                     const VectorFloat &trainingExample = validationData[n].getInputVector();
                     const VectorFloat &targetVector = validationData[n].getTargetVector();
                     
-                    VectorFloat y = feedforward(trainingExample);
+                    const VectorFloat &y = feedforward(trainingExample);
                     
                     //Update the error
                     Float error = 0;
@@ -849,114 +1143,189 @@ bool MLP::trainOnlineGradientDescentRegression(const RegressionData &trainingDat
     return true;
 }
 
-Float MLP::back_prop(const VectorFloat &trainingExample,const VectorFloat &targetVector,const Float learningRate,const Float learningMomentum){
+Float MLP::back_prop(const RegressionData &trainingData,const Vector< UINT > &indexList,const UINT batchStart,const UINT numSamples,const Float learningRate,const Float learningMomentum){
     
-    UINT i,j,k = 0;
-    Float update = 0;
+    //A batch with a single example is trained with online gradient descent
+    if( numSamples == 1 ){
+        const RegressionSample &sample = trainingData[ indexList[batchStart] ];
+        return back_prop( sample.getInputVector(), sample.getTargetVector(), learningRate, learningMomentum );
+    }
+    
+    //Copy the examples in the batch into the first rows of the batch buffers
+    setupBatchBuffers( numSamples );
+    for(UINT n=0; n<numSamples; n++){
+        const RegressionSample &sample = trainingData[ indexList[batchStart+n] ];
+        std::copy( sample.getInputVector().begin(), sample.getInputVector().end(), batchLayerOutputs[0][n] );
+        std::copy( sample.getTargetVector().begin(), sample.getTargetVector().end(), batchTargets[n] );
+    }
+    
+    return back_prop( numSamples, learningRate, learningMomentum );
+}
+
+Float MLP::back_prop(const UINT numSamples,const Float learningRate,const Float learningMomentum){
+    
+    const UINT L = layerWeights.getSize();
     Float error = 0;
     Float sqrError = 0;
     
-    //Forward propagation based on the current weights
-    feedforward(trainingExample,inputNeuronsOutput,hiddenNeuronsOutput,outputNeuronsOutput);
- 
+    //Forward propagation for the whole batch, based on the current weights
+    feedforwardBatch( numSamples );
+    
     //Compute the error of the output layer: the derivative of the output neuron, times the error of the output
-    for(k=0; k<numOutputNeurons; k++){
-        error = targetVector[k]-outputNeuronsOutput[k];
-        sqrError += SQR( error );
-        deltaO[k] = outputLayer[k].getDerivative( outputNeuronsOutput[k] ) * error;
+    Float backPropError = 0;
+    const MatrixFloat &outputs = batchLayerOutputs[L];
+    MatrixFloat &deltaO = batchLayerDeltas[L-1];
+    for(UINT n=0; n<numSamples; n++){
+        const Float *targetVector = batchTargets[n];
+        sqrError = 0;
+        for(UINT k=0; k<numOutputNeurons; k++){
+            error = targetVector[k]-outputs[n][k];
+            sqrError += SQR( error );
+            deltaO[n][k] = Neuron::derivative( outputLayerActivationFunction, outputs[n][k], gamma ) * error;
+        }
+        backPropError += sqrt( sqrError );
     }
-    sqrError = sqrt( sqrError );
     
-    //Compute the error of the hidden layer: the derivative of the hidden neuron, times the total error of the hidden output 
-    for(j=0; j<numHiddenNeurons; j++){
-        error = 0;
-        for(k=0; k<numOutputNeurons; k++){
-            error += outputLayer[k].weights[j] * deltaO[k];
+    //Compute the error of each hidden layer: the derivative of the hidden neuron, times the error of the next layer mapped back through its weights
+    for(UINT l=L-1; l>0; l--){
+        const UINT numNeurons = layerWeights[l].getNumRows();
+        const UINT numInputs = layerWeights[l].getNumCols();
+        const MatrixFloat &hiddenOutputs = batchLayerOutputs[l];
+        MatrixFloat &deltaH = batchLayerDeltas[l-1];
+        
+        GEMM::gemm( false, false, numSamples, numInputs, numNeurons, 1.0, batchLayerDeltas[l].getData(), numNeurons, layerWeights[l].getData(), numInputs, 0.0, deltaH.getData(), numInputs );
+        
+        for(UINT n=0; n<numSamples; n++){
+            for(UINT j=0; j<numInputs; j++){
+                deltaH[n][j] *= Neuron::derivative( hiddenLayerActivationFunction, hiddenOutputs[n][j], gamma );
+            }
         }
-        deltaH[j] = hiddenLayer[j].getDerivative( hiddenNeuronsOutput[j] ) * error;
     }
-
-    //Update the output weights, new weight = old weight + (learningRate * change) + (momenutum * previousChange)
-    for(j=0; j<numHiddenNeurons; j++){
-        for(k=0; k<numOutputNeurons; k++){
-            update = deltaO[k] * hiddenNeuronsOutput[j];
-            outputLayer[k].weights[j] += learningRate*update + learningMomentum*outputLayer[k].previousUpdate[j];
-            outputLayer[k].previousUpdate[j] = update;
+    
+    //Update the weights and bias of each layer with the average change over the batch,
+    //new weight = old weight + (learningRate * change) + (momenutum * previousChange)
+    const Float batchScale = 1.0/Float(numSamples);
+    for(UINT l=0; l<L; l++){
+        const UINT numNeurons = layerWeights[l].getNumRows();
+        const UINT numInputs = layerWeights[l].getNumCols();
+        const UINT numWeights = numNeurons*numInputs;
+        const MatrixFloat &deltas = batchLayerDeltas[l];
+        Float *weights = layerWeights[l].getData();
+        Float *previousUpdates = layerPreviousUpdates[l].getData();
+        VectorFloat &bias = layerBias[l];
+        VectorFloat &previousBiasUpdates = layerPreviousBiasUpdates[l];
+        
+        //Add the momentum, then replace the previous changes with the average change over the batch and add them
+        for(UINT i=0; i<numWeights; i++){
+            weights[i] += learningMomentum*previousUpdates[i];
         }
-    }
-
-    //Update the hidden weights, new weight = old weight + (learningRate * change) + (momenutum * previousChange)
-    for(i=0; i<numInputNeurons; i++){
-        for(j=0; j<numHiddenNeurons; j++){
-            update = deltaH[j] * inputNeuronsOutput[i];
-            hiddenLayer[j].weights[i] += learningRate*update + learningMomentum*hiddenLayer[j].previousUpdate[i];
-            hiddenLayer[j].previousUpdate[i] = update;
+        GEMM::gemm( true, false, numNeurons, numInputs, numSamples, batchScale, deltas.getData(), numNeurons, batchLayerOutputs[l].getData(), numInputs, 0.0, previousUpdates, numInputs );
+        for(UINT i=0; i<numWeights; i++){
+            weights[i] += learningRate*previousUpdates[i];
         }
-    }
-    
-    //Update the output bias, new weight = old weight + (learningRate * change) + (momenutum * previousChange)
-    for(k=0; k<numOutputNeurons; k++){
-        //Compute the update
-        update = learningRate*deltaO[k] + learningMomentum*outputLayer[k].previousBiasUpdate;
-        
-        //Update the bias
-        outputLayer[k].bias += update;
         
-        //Store the update
-        outputLayer[k].previousBiasUpdate = update;
+        for(UINT k=0; k<numNeurons; k++){
+            Float change = 0;
+            for(UINT n=0; n<numSamples; n++){
+                change += deltas[n][k];
+            }
+            const Float update = learningRate*change*batchScale + learningMomentum*previousBiasUpdates[k];
+            bias[k] += update;
+            previousBiasUpdates[k] = update;
+        }
     }
+    
+    //Return the sum of the error between the output of the network and the target Vector of each example
+    return backPropError;
+}
 
-    //Update the hidden bias, new weight = old weight + (learningRate * change) + (momenutum * previousChange)
-    for(j=0; j<numHiddenNeurons; j++){
-        //Compute the update
-        update = learningRate*deltaH[j] + learningMomentum*hiddenLayer[j].previousBiasUpdate;
-        
-        //Update the bias
-        hiddenLayer[j].bias += update;
-        
-        //Store the update
-        hiddenLayer[j].previousBiasUpdate = update;
+Float MLP::back_prop(const VectorFloat &trainingExample,const VectorFloat &targetVector,const Float learningRate,const Float learningMomentum){
+    
+    const UINT L = layerWeights.getSize();
+    Float update = 0;
+    Float error = 0;
+    Float sqrError = 0;
+    
+    //Forward propagation based on the current weights
+    feedforward( trainingExample.getData() );
+ 
+    //Compute the error of the output layer: the derivative of the output neuron, times the error of the output
+    const VectorFloat &outputs = layerOutputs[L];
+    VectorFloat &deltaO = layerDeltas[L-1];
+    for(UINT k=0; k<numOutputNeurons; k++){
+        error = targetVector[k]-outputs[k];
+        sqrError += SQR( error );
+        deltaO[k] = Neuron::derivative( outputLayerActivationFunction, outputs[k], gamma ) * error;
+    }
+    sqrError = sqrt( sqrError );
+    
+    //Compute the error of each hidden layer: the derivative of the hidden neuron, times the total error of the hidden output
+    for(UINT l=L-1; l>0; l--){
+        const MatrixFloat &weights = layerWeights[l];
+        const UINT numNeurons = weights.getNumRows();
+        const UINT numInputs = weights.getNumCols();
+        const VectorFloat &delta = layerDeltas[l];
+        const VectorFloat &hiddenOutputs = layerOutputs[l];
+        VectorFloat &deltaH = layerDeltas[l-1];
+        for(UINT j=0; j<numInputs; j++){
+            error = 0;
+            for(UINT k=0; k<numNeurons; k++){
+                error += weights[k][j] * delta[k];
+            }
+            deltaH[j] = Neuron::derivative( hiddenLayerActivationFunction, hiddenOutputs[j], gamma ) * error;
+        }
+    }
+
+    //Update the weights and bias of each layer, new weight = old weight + (learningRate * change) + (momenutum * previousChange)
+    for(UINT l=0; l<L; l++){
+        MatrixFloat &weights = layerWeights[l];
+        MatrixFloat &previousUpdates = layerPreviousUpdates[l];
+        VectorFloat &bias = layerBias[l];
+        VectorFloat &previousBiasUpdates = layerPreviousBiasUpdates[l];
+        const UINT numNeurons = weights.getNumRows();
+        const UINT numInputs = weights.getNumCols();
+        const VectorFloat &inputs = layerOutputs[l];
+        const VectorFloat &delta = layerDeltas[l];
+        
+        for(UINT k=0; k<numNeurons; k++){
+            Float *w = weights[k];
+            Float *previousUpdate = previousUpdates[k];
+            for(UINT j=0; j<numInputs; j++){
+                update = delta[k] * inputs[j];
+                w[j] += learningRate*update + learningMomentum*previousUpdate[j];
+                previousUpdate[j] = update;
+            }
+            
+            //Update the bias
+            update = learningRate*delta[k] + learningMomentum*previousBiasUpdates[k];
+            bias[k] += update;
+            previousBiasUpdates[k] = update;
+        }
     }
     
     //Return the squared error between the output of the network and the target Vector
     return sqrError;
 }
 
-VectorFloat MLP::feedforward(VectorFloat trainingExample){
+const VectorFloat& MLP::feedforward(const VectorFloat &trainingExample){
     
-    if( inputNeuronsOutput.size() != numInputNeurons ) inputNeuronsOutput.resize(numInputNeurons,0);
-    if( hiddenNeuronsOutput.size() != numHiddenNeurons ) hiddenNeuronsOutput.resize(numHiddenNeurons,0);
-    if( outputNeuronsOutput.size() != numOutputNeurons ) outputNeuronsOutput.resize(numOutputNeurons,0);
-
-    UINT i,j,k=0;
+    const Float *input = trainingExample.getData();
     
     //Scale the input vector if required
     if( useScaling ){
-        for(i=0; i<numInputNeurons; i++){
-            trainingExample[i] = scale(trainingExample[i],inputVectorRanges[i].minValue,inputVectorRanges[i].maxValue,outputTargets.minValue,outputTargets.maxValue);
+        if( scaledInput.getSize() != numInputNeurons ) scaledInput.resize(numInputNeurons);
+        for(UINT i=0; i<numInputNeurons; i++){
+            scaledInput[i] = scale(trainingExample[i],inputVectorRanges[i].minValue,inputVectorRanges[i].maxValue,outputTargets.minValue,outputTargets.maxValue);
         }
+        input = scaledInput.getData();
     }
     
-    //Input layer
-    VectorFloat input(1);
-    for(i=0; i<numInputNeurons; i++){
-        input[0] = trainingExample[i];
-        inputNeuronsOutput[i] = inputLayer[i].fire( input );
-    }
-    
-    //Hidden Layer
-    for(j=0; j<numHiddenNeurons; j++){
-        hiddenNeuronsOutput[j] = hiddenLayer[j].fire( inputNeuronsOutput );
-    }
-    
-    //Output Layer
-    for(k=0; k<numOutputNeurons; k++){
-        outputNeuronsOutput[k] = outputLayer[k].fire( hiddenNeuronsOutput );
-    }
+    feedforward( input );
     
     //Scale the output vector if required
+    VectorFloat &outputNeuronsOutput = layerOutputs[ layerWeights.getSize() ];
     if( useScaling ){
-        for(k=0; k<numOutputNeurons; k++){
+        for(UINT k=0; k<numOutputNeurons; k++){
             outputNeuronsOutput[k] = scale(outputNeuronsOutput[k],outputTargets.minValue,outputTargets.maxValue,targetVectorRanges[k].minValue,targetVectorRanges[k].maxValue);
         }
     }
@@ -964,37 +1333,103 @@ VectorFloat MLP::feedforward(VectorFloat trainingExample){
     return outputNeuronsOutput;
 }
 
-void MLP::feedforward(const VectorFloat &data,VectorFloat &inputNeuronsOutput,VectorFloat &hiddenNeuronsOutput,VectorFloat &outputNeuronsOutput){
+void MLP::feedforward(const Float *data){
     
-    if( inputNeuronsOutput.size() != numInputNeurons ) inputNeuronsOutput.resize(numInputNeurons,0);
-    if( hiddenNeuronsOutput.size() != numHiddenNeurons ) hiddenNeuronsOutput.resize(numHiddenNeurons,0);
-    if( outputNeuronsOutput.size() != numOutputNeurons ) outputNeuronsOutput.resize(numOutputNeurons,0);
-
-    UINT i,j,k=0;
+    const UINT L = layerWeights.getSize();
+    if( layerOutputs.getSize() != L+1 ) setupBuffers();
     
-    //Input layer
-    VectorFloat input(1);
-    for(i=0; i<numInputNeurons; i++){
-        input[0] = data[i];
-        inputNeuronsOutput[i] = inputLayer[i].fire( input );
+    //Input layer, each input neuron has a single input
+    VectorFloat &inputNeuronsOutput = layerOutputs[0];
+    for(UINT i=0; i<numInputNeurons; i++){
+        inputNeuronsOutput[i] = Neuron::activate( inputLayerActivationFunction, inputLayerBias[i] + data[i] * inputLayerWeights[i], gamma );
+    }
+    
+    //Hidden layers and output layer
+    for(UINT l=0; l<L; l++){
+        const MatrixFloat &weights = layerWeights[l];
+        const UINT numNeurons = weights.getNumRows();
+        const UINT numInputs = weights.getNumCols();
+        const Neuron::Type activationFunction = getLayerActivationFunction(l);
+        const VectorFloat &bias = layerBias[l];
+        const VectorFloat &inputs = layerOutputs[l];
+        VectorFloat &outputs = layerOutputs[l+1];
+        for(UINT k=0; k<numNeurons; k++){
+            const Float *w = weights[k];
+            Float y = bias[k];
+            for(UINT j=0; j<numInputs; j++){
+                y += inputs[j] * w[j];
+            }
+            outputs[k] = Neuron::activate( activationFunction, y, gamma );
+        }
     }
     
-    //Hidden Layer
-    for(j=0; j<numHiddenNeurons; j++){
-        hiddenNeuronsOutput[j] = hiddenLayer[j].fire( inputNeuronsOutput );
-    }
+}
+
+void MLP::feedforwardBatch(const UINT numSamples){
+    
+    const UINT L = layerWeights.getSize();
     
-    //Output Layer
-    for(k=0; k<numOutputNeurons; k++){
-        outputNeuronsOutput[k] = outputLayer[k].fire( hiddenNeuronsOutput );
+    //Input layer, each input neuron has a single input
+    MatrixFloat &inputNeuronsOutput = batchLayerOutputs[0];
+    for(UINT n=0; n<numSamples; n++){
+        Float *x = inputNeuronsOutput[n];
+        for(UINT i=0; i<numInputNeurons; i++){
+            x[i] = Neuron::activate( inputLayerActivationFunction, inputLayerBias[i] + x[i] * inputLayerWeights[i], gamma );
+        }
     }
     
+    //Hidden layers and output layer, the weighted sums of all the examples in the batch are computed with one matrix product
+    for(UINT l=0; l<L; l++){
+        const UINT numNeurons = layerWeights[l].getNumRows();
+        const UINT numInputs = layerWeights[l].getNumCols();
+        const Neuron::Type activationFunction = getLayerActivationFunction(l);
+        const VectorFloat &bias = layerBias[l];
+        MatrixFloat &outputs = batchLayerOutputs[l+1];
+        
+        GEMM::gemm( false, true, numSamples, numNeurons, numInputs, 1.0, batchLayerOutputs[l].getData(), numInputs, layerWeights[l].getData(), numInputs, 0.0, outputs.getData(), numNeurons );
+        
+        for(UINT n=0; n<numSamples; n++){
+            Float *y = outputs[n];
+            for(UINT k=0; k<numNeurons; k++){
+                y[k] = Neuron::activate( activationFunction, y[k] + bias[k], gamma );
+            }
+        }
+    }
+}
+
+void MLP::setupBuffers(){
+    const UINT L = layerWeights.getSize();
+    layerOutputs.resize(L+1);
+    layerDeltas.resize(L);
+    layerOutputs[0].resize(numInputNeurons);
+    for(UINT l=0; l<L; l++){
+        layerOutputs[l+1].resize(layerWeights[l].getNumRows());
+        layerDeltas[l].resize(layerWeights[l].getNumRows());
+    }
+}
+
+void MLP::setupBatchBuffers(const UINT numSamples){
+    const UINT L = layerWeights.getSize();
+    if( batchLayerOutputs.getSize() != L+1 || batchLayerOutputs[0].getNumRows() < numSamples || batchTargets.getNumCols() != numOutputNeurons ){
+        batchLayerOutputs.resize(L+1);
+        batchLayerDeltas.resize(L);
+        batchLayerOutputs[0].resize(numSamples,numInputNeurons);
+        batchTargets.resize(numSamples,numOutputNeurons);
+        for(UINT l=0; l<L; l++){
+            batchLayerOutputs[l+1].resize(numSamples,layerWeights[l].getNumRows());
+            batchLayerDeltas[l].resize(numSamples,layerWeights[l].getNumRows());
+        }
+    }
 }
 
 void MLP::printNetwork() const{
     std::cout<<"***************** MLP *****************\n";
     std::cout<<"NumInputNeurons: "<<numInputNeurons<< std::endl;
-    std::cout<<"NumHiddenNeurons: "<<numHiddenNeurons<< std::endl;
+    std::cout<<"NumHiddenLayers: "<<hiddenLayerSizes.getSize()<< std::endl;
+    std::cout<<"NumHiddenNeurons: ";
+    for(UINT l=0; l<hiddenLayerSizes.getSize(); l++){
+        std::cout << hiddenLayerSizes[l] << "\t";
+    } std::cout << std::endl;
     std::cout<<"NumOutputNeurons: "<<numOutputNeurons<< std::endl;
 
     std::cout << "ScalingEnabled: " << useScaling << std::endl;
@@ -1012,55 +1447,38 @@ void MLP::printNetwork() const{
     }
     
     std::cout<<"InputWeights:\n";
-    for(UINT i=0; i<numInputNeurons; i++){
-        std::cout<<"Neuron: "<<i<<" Bias: " << inputLayer[i].bias << " Weights: ";
-        for(UINT j=0; j<inputLayer[i].weights.getSize(); j++){
-            std::cout << inputLayer[i].weights[j] << "\t";
-        } std::cout << std::endl;
-    }
-    
-    std::cout<<"HiddenWeights:\n";
-    for(UINT i=0; i<numHiddenNeurons; i++){
-        std::cout<<"Neuron: "<<i<<" Bias: " << hiddenLayer[i].bias << " Weights: ";
-        for(UINT j=0; j<hiddenLayer[i].weights.getSize(); j++){
-            std::cout << hiddenLayer[i].weights[j] << "\t";
-        } std::cout << std::endl;
-    }
-    
-    std::cout<<"OutputWeights:\n";
-    for(UINT i=0; i<numOutputNeurons; i++){
-        std::cout<<"Neuron: "<<i<<" Bias: " << outputLayer[i].bias << " Weights: ";
-        for(UINT j=0; j<outputLayer[i].weights.getSize(); j++){
-            std::cout << outputLayer[i].weights[j] << "\t";
-        } std::cout << std::endl;
+    for(UINT i=0; i<inputLayerWeights.getSize(); i++){
+        std::cout<<"Neuron: "<<i<<" Bias: " << inputLayerBias[i] << " Weights: " << inputLayerWeights[i] << "\t" << std::endl;
+    }
+    
+    for(UINT l=0; l<layerWeights.getSize(); l++){
+        if( l+1 < layerWeights.getSize() ) std::cout<<"HiddenWeights: Layer: "<<l+1<<"\n";
+        else std::cout<<"OutputWeights:\n";
+        for(UINT i=0; i<layerWeights[l].getNumRows(); i++){
+            std::cout<<"Neuron: "<<i<<" Bias: " << layerBias[l][i] << " Weights: ";
+            for(UINT j=0; j<layerWeights[l].getNumCols(); j++){
+                std::cout << layerWeights[l][i][j] << "\t";
+            } std::cout << std::endl;
+        }
     }
     
 }
 
 bool MLP::checkForNAN() const{
     
-    UINT N = 0;
-    for(UINT i=0; i<numInputNeurons; i++){
-        if( isNAN(inputLayer[i].bias) ) return true;
-        N = inputLayer[i].weights.getSize();
-        for(UINT j=0; j<N; j++){
-            if( isNAN(inputLayer[i].weights[j]) ) return true;
-        }
-    }
-    
-    for(UINT i=0; i<numHiddenNeurons; i++){
-        if( isNAN(hiddenLayer[i].bias) ) return true;
-        N = hiddenLayer[i].weights.getSize();
-        for(UINT j=0; j<N; j++){
-            if( isNAN(hiddenLayer[i].weights[j]) ) return true;
-        }
+    for(UINT i=0; i<inputLayerWeights.getSize(); i++){
+        if( isNAN(inputLayerBias[i]) ) return true;
+        if( isNAN(inputLayerWeights[i]) ) return true;
     }
     
-    for(UINT i=0; i<numOutputNeurons; i++){
-        if( isNAN(outputLayer[i].bias) ) return true;
-        N = outputLayer[i].weights.getSize();
-        for(UINT j=0; j<N; j++){
-            if( isNAN(outputLayer[i].weights[j]) ) return true;
+    for(UINT l=0; l<layerWeights.getSize(); l++){
+        const UINT N = layerWeights[l].getNumRows();
+        const UINT M = layerWeights[l].getNumCols();
+        for(UINT i=0; i<N; i++){
+            if( isNAN(layerBias[l][i]) ) return true;
+            for(UINT j=0; j<M; j++){
+                if( isNAN(layerWeights[l][i][j]) ) return true;
+            }
         }
     }
     
@@ -1079,7 +1497,7 @@ bool MLP::save( std::fstream &file ) const{
         return false;
     }
     
-    file << "GRT_MLP_FILE_V2.0\n";
+    file << "GRT_MLP_FILE_V3.0\n";
     
     //Write the regressifier settings to the file
     if( !Regressifier::saveBaseSettingsToFile(file) ){
@@ -1088,12 +1506,18 @@ bool MLP::save( std::fstream &file ) const{
     }
     
     file << "NumInputNeurons: "<<numInputNeurons<< std::endl;
-    file << "NumHiddenNeurons: "<<numHiddenNeurons<< std::endl;
+    file << "NumHiddenLayers: "<<hiddenLayerSizes.getSize()<< std::endl;
+    file << "HiddenLayerSizes: ";
+    for(UINT l=0; l<hiddenLayerSizes.getSize(); l++){
+        file << hiddenLayerSizes[l] << "\t";
+    }
+    file << std::endl;
     file << "NumOutputNeurons: "<<numOutputNeurons<< std::endl;
     file << "InputLayerActivationFunction: " <<activationFunctionToString(inputLayerActivationFunction)<< std::endl;
     file << "HiddenLayerActivationFunction: " <<activationFunctionToString(hiddenLayerActivationFunction)<< std::endl;
     file << "OutputLayerActivationFunction: " <<activationFunctionToString(outputLayerActivationFunction)<< std::endl;
     file << "NumRandomTrainingIterations: " << numRestarts << std::endl;
+    file << "BatchSize: " << batchSize << std::endl;
     file << "Momentum: " << momentum << std::endl;
     file << "Gamma: " << gamma << std::endl;
     file << "ClassificationMode: " << classificationModeActive << std::endl;
@@ -1102,42 +1526,30 @@ bool MLP::save( std::fstream &file ) const{
     
     if( trained ){
         file << "InputLayer: \n";
+        file << "Weights: ";
         for(UINT i=0; i<numInputNeurons; i++){
-            file << "InputNeuron: " << i+1 << std::endl;
-            file << "NumInputs: " << inputLayer[i].numInputs << std::endl;
-            file << "Bias: " << inputLayer[i].bias << std::endl;
-            file << "Gamma: " << inputLayer[i].gamma << std::endl;
-            file << "Weights: " << std::endl;
-            for(UINT j=0; j<inputLayer[i].numInputs; j++){
-                file << inputLayer[i].weights[j] << "\t";
-            }
-            file << std::endl;
+            file << inputLayerWeights[i] << "\t";
         }
-        file << "\n";
-        
-        file << "HiddenLayer: \n";
-        for(UINT i=0; i<numHiddenNeurons; i++){
-            file << "HiddenNeuron: " << i+1 << std::endl;
-            file << "NumInputs: " << hiddenLayer[i].numInputs << std::endl;
-            file << "Bias: " << hiddenLayer[i].bias << std::endl;
-            file << "Gamma: " << hiddenLayer[i].gamma << std::endl;
-            file << "Weights: " << std::endl;
-            for(UINT j=0; j<hiddenLayer[i].numInputs; j++){
-                file << hiddenLayer[i].weights[j] << "\t";
-            }
-            file << std::endl;
+        file << std::endl;
+        file << "Bias: ";
+        for(UINT i=0; i<numInputNeurons; i++){
+            file << inputLayerBias[i] << "\t";
         }
-        file << "\n";
+        file << std::endl;
         
-        file << "OutputLayer: \n";
-        for(UINT i=0; i<numOutputNeurons; i++){
-            file << "OutputNeuron: " << i+1 << std::endl;
-            file << "NumInputs: " << outputLayer[i].numInputs << std::endl;
-            file << "Bias: " << outputLayer[i].bias << std::endl;
-            file << "Gamma: " << outputLayer[i].gamma << std::endl;
+        //Write the weights of each hidden layer and then the output layer, one row per neuron
+        for(UINT l=0; l<layerWeights.getSize(); l++){
+            file << "Layer: " << l+1 << std::endl;
             file << "Weights: " << std::endl;
-            for(UINT j=0; j<outputLayer[i].numInputs; j++){
-                file << outputLayer[i].weights[j] << "\t";
+            for(UINT i=0; i<layerWeights[l].getNumRows(); i++){
+                for(UINT j=0; j<layerWeights[l].getNumCols(); j++){
+                    file << layerWeights[l][i][j] << "\t";
+                }
+                file << std::endl;
+            }
+            file << "Bias: ";
+            for(UINT i=0; i<layerBias[l].getSize(); i++){
+                file << layerBias[l][i] << "\t";
             }
             file << std::endl;
         }
@@ -1167,8 +1579,11 @@ bool MLP::load( std::fstream &file ){
         return loadLegacyModelFromFile( file );
     }
     
+    //Version 2 files store a single hidden layer neuron by neuron, version 3 files store each layer as a weight matrix
+    const bool neuronFileFormat = word == "GRT_MLP_FILE_V2.0";
+    
     //Check to make sure this is a file with the MLP File Format
-    if( word != "GRT_MLP_FILE_V2.0" ){
+    if( !neuronFileFormat && word != "GRT_MLP_FILE_V3.0" ){
         file.close();
         errorLog << __GRT_LOG__ << " Failed to find file header!" << std::endl;
         return false;
@@ -1190,13 +1605,37 @@ bool MLP::load( std::fstream &file ){
     file >> numInputNeurons;
     numInputDimensions = numInputNeurons;
     
-    file >> word;
-    if(word != "NumHiddenNeurons:"){
-        file.close();
-        errorLog << __GRT_LOG__ << " Failed to find NumHiddenNeurons!" << std::endl;
-        return false;
+    if( neuronFileFormat ){
+        file >> word;
+        if(word != "NumHiddenNeurons:"){
+            file.close();
+            errorLog << __GRT_LOG__ << " Failed to find NumHiddenNeurons!" << std::endl;
+            return false;
+        }
+        file >> numHiddenNeurons;
+        hiddenLayerSizes.resize( 1, numHiddenNeurons );
+    }else{
+        UINT numHiddenLayers = 0;
+        file >> word;
+        if(word != "NumHiddenLayers:"){
+            file.close();
+            errorLog << __GRT_LOG__ << " Failed to find NumHiddenLayers!" << std::endl;
+            return false;
+        }
+        file >> numHiddenLayers;
+        
+        file >> word;
+        if(word != "HiddenLayerSizes:"){
+            file.close();
+            errorLog << __GRT_LOG__ << " Failed to find HiddenLayerSizes!" << std::endl;
+            return false;
+        }
+        hiddenLayerSizes.resize( numHiddenLayers );
+        for(UINT l=0; l<numHiddenLayers; l++){
+            file >> hiddenLayerSizes[l];
+        }
+        numHiddenNeurons = numHiddenLayers > 0 ? hiddenLayerSizes[0] : 0;
     }
-    file >> numHiddenNeurons;
     
     file >> word;
     if(word != "NumOutputNeurons:"){
@@ -1241,6 +1680,16 @@ bool MLP::load( std::fstream &file ){
     }
     file >> numRestarts;
     
+    if( !neuronFileFormat ){
+        file >> word;
+        if(word != "BatchSize:"){
+            file.close();
+            errorLog << __GRT_LOG__ << " Failed to find BatchSize!" << std::endl;
+            return false;
+        }
+        file >> batchSize;
+    }
+    
     file >> word;
     if(word != "Momentum:"){
         file.close();
@@ -1282,207 +1731,100 @@ bool MLP::load( std::fstream &file ){
     file >> nullRejectionThreshold;
     
     if( trained ) initialized = true;
-    else init(numInputNeurons,numHiddenNeurons,numOutputNeurons);
+    else init(numInputNeurons,hiddenLayerSizes,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
         
     if( trained ){
         
-        //Resize the layers
-        inputLayer.resize( numInputNeurons );
-        hiddenLayer.resize( numHiddenNeurons );
-        outputLayer.resize( numOutputNeurons );
-        
         //Load the neuron data
-        file >> word;
-        if(word != "InputLayer:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find InputLayer!" << std::endl;
-            return false;
-        }
-        
-        for(UINT i=0; i<numInputNeurons; i++){
-            UINT tempNeuronID = 0;
-            
-            file >> word;
-            if(word != "InputNeuron:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find InputNeuron!" << std::endl;
-                return false;
-            }
-            file >> tempNeuronID;
-            
-            if( tempNeuronID != i+1 ){
-                file.close();
-                errorLog << __GRT_LOG__ << " InputNeuron ID does not match!" << std::endl;
-                return false;
-            }
-            
-            file >> word;
-            if(word != "NumInputs:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find NumInputs!" << std::endl;
-                return false;
-            }
-            file >> inputLayer[i].numInputs;
-            
-            //Resize the buffers
-            inputLayer[i].weights.resize( inputLayer[i].numInputs );
-            
-            file >> word;
-            if(word != "Bias:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find Bias!" << std::endl;
+        if( neuronFileFormat ){
+            if( !loadNeuronLayers( file ) ){
                 return false;
             }
-            file >> inputLayer[i].bias;
-            
+        }else{
             file >> word;
-            if(word != "Gamma:"){
+            if(word != "InputLayer:"){
                 file.close();
-                errorLog << __GRT_LOG__ << " Failed to find Gamma!" << std::endl;
+                errorLog << __GRT_LOG__ << " Failed to find InputLayer!" << std::endl;
                 return false;
             }
-            file >> inputLayer[i].gamma;
-            
+        
             file >> word;
             if(word != "Weights:"){
                 file.close();
                 errorLog << __GRT_LOG__ << " Failed to find Weights!" << std::endl;
                 return false;
             }
-            
-            for(UINT j=0; j<inputLayer[i].numInputs; j++){
-                file >> inputLayer[i].weights[j];
+            inputLayerWeights.resize( numInputNeurons );
+            for(UINT i=0; i<numInputNeurons; i++){
+                file >> inputLayerWeights[i];
             }
-        }
-        
-        //Load the Hidden Layer
-        file >> word;
-        if(word != "HiddenLayer:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find HiddenLayer!" << std::endl;
-            return false;
-        }
         
-        for(UINT i=0; i<numHiddenNeurons; i++){
-            UINT tempNeuronID = 0;
-            
-            file >> word;
-            if(word != "HiddenNeuron:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find HiddenNeuron!" << std::endl;
-                return false;
-            }
-            file >> tempNeuronID;
-            
-            if( tempNeuronID != i+1 ){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find HiddenNeuron ID does not match!" << std::endl;
-                return false;
-            }
-            
-            file >> word;
-            if(word != "NumInputs:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find NumInputs!" << std::endl;
-                return false;
-            }
-            file >> hiddenLayer[i].numInputs;
-            
-            //Resize the buffers
-            hiddenLayer[i].weights.resize( hiddenLayer[i].numInputs );
-            
             file >> word;
             if(word != "Bias:"){
                 file.close();
                 errorLog << __GRT_LOG__ << " Failed to find Bias!" << std::endl;
                 return false;
             }
-            file >> hiddenLayer[i].bias;
-            
-            file >> word;
-            if(word != "Gamma:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find Gamma!" << std::endl;
-                return false;
-            }
-            file >> hiddenLayer[i].gamma;
-            
-            file >> word;
-            if(word != "Weights:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find Weights!" << std::endl;
-                return false;
-            }
-            
-            for(unsigned int j=0; j<hiddenLayer[i].numInputs; j++){
-                file >> hiddenLayer[i].weights[j];
+            inputLayerBias.resize( numInputNeurons );
+            for(UINT i=0; i<numInputNeurons; i++){
+                file >> inputLayerBias[i];
             }
-        }
-        
-        //Load the Output Layer
-        file >> word;
-        if(word != "OutputLayer:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find OutputLayer!" << std::endl;
-            return false;
-        }
         
-        for(UINT i=0; i<numOutputNeurons; i++){
-            UINT tempNeuronID = 0;
-            
-            file >> word;
-            if(word != "OutputNeuron:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find OutputNeuron!" << std::endl;
-                return false;
-            }
-            file >> tempNeuronID;
-            
-            if( tempNeuronID != i+1 ){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find OuputNeuron ID does not match!!" << std::endl;
-                return false;
-            }
-            
-            file >> word;
-            if(word != "NumInputs:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find NumInputs!" << std::endl;
-                return false;
-            }
-            file >> outputLayer[i].numInputs;
+            //Load the weights of each hidden layer and then the output layer
+            const UINT numLayers = hiddenLayerSizes.getSize()+1;
+            layerWeights.resize( numLayers );
+            layerBias.resize( numLayers );
+            layerPreviousUpdates.resize( numLayers );
+            layerPreviousBiasUpdates.resize( numLayers );
+        
+            UINT numLayerInputs = numInputNeurons;
+            for(UINT l=0; l<numLayers; l++){
+                const UINT numLayerNeurons = l+1 < numLayers ? hiddenLayerSizes[l] : numOutputNeurons;
+                UINT tempLayerID = 0;
             
-            //Resize the buffers
-            outputLayer[i].weights.resize( outputLayer[i].numInputs );
+                file >> word;
+                if(word != "Layer:"){
+                    file.close();
+                    errorLog << __GRT_LOG__ << " Failed to find Layer!" << std::endl;
+                    return false;
+                }
+                file >> tempLayerID;
             
-            file >> word;
-            if(word != "Bias:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find Bias!" << std::endl;
-                return false;
-            }
-            file >> outputLayer[i].bias;
+                if( tempLayerID != l+1 ){
+                    file.close();
+                    errorLog << __GRT_LOG__ << " Layer ID does not match!" << std::endl;
+                    return false;
+                }
             
-            file >> word;
-            if(word != "Gamma:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find Gamma!" << std::endl;
-                return false;
-            }
-            file >> outputLayer[i].gamma;
+                file >> word;
+                if(word != "Weights:"){
+                    file.close();
+                    errorLog << __GRT_LOG__ << " Failed to find Weights!" << std::endl;
+                    return false;
+                }
+                layerWeights[l].resize( numLayerNeurons, numLayerInputs );
+                for(UINT i=0; i<numLayerNeurons; i++){
+                    for(UINT j=0; j<numLayerInputs; j++){
+                        file >> layerWeights[l][i][j];
+                    }
+                }
             
-            file >> word;
-            if(word != "Weights:"){
-                file.close();
-                errorLog << __GRT_LOG__ << " Failed to find Weights!" << std::endl;
-                return false;
-            }
+                file >> word;
+                if(word != "Bias:"){
+                    file.close();
+                    errorLog << __GRT_LOG__ << " Failed to find Bias!" << std::endl;
+                    return false;
+                }
+                layerBias[l].resize( numLayerNeurons );
+                for(UINT i=0; i<numLayerNeurons; i++){
+                    file >> layerBias[l][i];
+                }
             
-            for(UINT j=0; j<outputLayer[i].numInputs; j++){
-                file >> outputLayer[i].weights[j];
+                layerPreviousUpdates[l].resize( numLayerNeurons, numLayerInputs, 0 );
+                layerPreviousBiasUpdates[l].resize( numLayerNeurons, 0 );
+                numLayerInputs = numLayerNeurons;
             }
         }
-        
     }
 
     setOutputTargets();
@@ -1504,6 +1846,14 @@ UINT MLP::getNumHiddenNeurons() const{
     return numHiddenNeurons;
 }
 
+UINT MLP::getNumHiddenLayers() const{
+    return hiddenLayerSizes.getSize();
+}
+
+Vector< UINT > MLP::getHiddenLayerSizes() const{
+    return hiddenLayerSizes;
+}
+
 UINT MLP::getNumOutputNeurons() const{
     return numOutputNeurons;
 }
@@ -1532,6 +1882,10 @@ Float MLP::getMomentum() const{
     return momentum;
 }
 
+UINT MLP::getBatchSize() const{
+    return batchSize;
+}
+
 Float MLP::getGamma() const{
     return gamma;
 }
@@ -1549,15 +1903,57 @@ bool MLP::getRegressionModeActive() const{
 }
 
 Vector< Neuron > MLP::getInputLayer() const{
+    Vector< Neuron > inputLayer( inputLayerWeights.getSize() );
+    for(UINT i=0; i<inputLayer.getSize(); i++){
+        inputLayer[i].numInputs = 1;
+        inputLayer[i].activationFunction = inputLayerActivationFunction;
+        inputLayer[i].gamma = gamma;
+        inputLayer[i].bias = inputLayerBias[i];
+        inputLayer[i].weights.resize( 1, inputLayerWeights[i] );
+        inputLayer[i].previousUpdate.resize( 1, 0 );
+    }
     return inputLayer;
 }
 
 Vector< Neuron > MLP::getHiddenLayer() const{
-    return hiddenLayer;
+    return getHiddenLayer( 0 );
+}
+
+Vector< Neuron > MLP::getHiddenLayer(const UINT layerIndex) const{
+    if( layerIndex >= hiddenLayerSizes.getSize() ) return Vector< Neuron >();
+    return getLayerNeurons( layerIndex );
 }
 
 Vector< Neuron > MLP::getOutputLayer() const{
-    return outputLayer;
+    if( layerWeights.getSize() == 0 ) return Vector< Neuron >();
+    return getLayerNeurons( layerWeights.getSize()-1 );
+}
+
+Vector< Neuron > MLP::getLayerNeurons(const UINT layerIndex) const{
+    
+    if( layerIndex >= layerWeights.getSize() ) return Vector< Neuron >();
+    
+    const MatrixFloat &weights = layerWeights[layerIndex];
+    const MatrixFloat &previousUpdates = layerPreviousUpdates[layerIndex];
+    const UINT numNeurons = weights.getNumRows();
+    const UINT numInputs = weights.getNumCols();
+    Vector< Neuron > neurons( numNeurons );
+    
+    for(UINT i=0; i<numNeurons; i++){
+        neurons[i].numInputs = numInputs;
+        neurons[i].activationFunction = getLayerActivationFunction( layerIndex );
+        neurons[i].gamma = gamma;
+        neurons[i].bias = layerBias[layerIndex][i];
+        neurons[i].previousBiasUpdate = layerPreviousBiasUpdates[layerIndex][i];
+        neurons[i].weights.resize( numInputs );
+        neurons[i].previousUpdate.resize( numInputs );
+        for(UINT j=0; j<numInputs; j++){
+            neurons[i].weights[j] = weights[i][j];
+            neurons[i].previousUpdate[j] = previousUpdates[i][j];
+        }
+    }
+    
+    return neurons;
 }
 
 Vector< VectorFloat > MLP::getTrainingLog() const{
@@ -1657,7 +2053,7 @@ bool MLP::setInputLayerActivationFunction(const Neuron::Type activationFunction)
     this->inputLayerActivationFunction = activationFunction;
     
     if( initialized ){
-        return init(numInputNeurons,numHiddenNeurons,numOutputNeurons);
+        return init(numInputNeurons,hiddenLayerSizes,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
     }
     
     return true;
@@ -1673,7 +2069,7 @@ bool MLP::setHiddenLayerActivationFunction(const Neuron::Type activationFunction
     this->hiddenLayerActivationFunction = activationFunction;
     
     if( initialized ){
-        return init(numInputNeurons,numHiddenNeurons,numOutputNeurons);
+        return init(numInputNeurons,hiddenLayerSizes,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
     }
     
     return true;
@@ -1689,7 +2085,7 @@ bool MLP::setOutputLayerActivationFunction(const Neuron::Type activationFunction
     this->outputLayerActivationFunction = activationFunction;
     
     if( initialized ){
-        return init(numInputNeurons,numHiddenNeurons,numOutputNeurons);
+        return init(numInputNeurons,hiddenLayerSizes,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
     }
     
     return true;
@@ -1707,6 +2103,15 @@ bool MLP::setMomentum(const Float momentum){
     return false;
 }
 
+bool MLP::setBatchSize(const UINT batchSize){
+    if( batchSize == 0 ){
+        warningLog << __GRT_LOG__ << " The batch size must be greater than zero!" << std::endl;
+        return false;
+    }
+    this->batchSize = batchSize;
+    return true;
+}
+
 bool MLP::setGamma(const Float gamma){
     
     if( gamma < 0 ){
@@ -1716,7 +2121,7 @@ bool MLP::setGamma(const Float gamma){
     this->gamma = gamma;
     
     if( initialized ){
-        return init(numInputNeurons,numHiddenNeurons,numOutputNeurons);
+        return init(numInputNeurons,hiddenLayerSizes,numOutputNeurons,inputLayerActivationFunction,hiddenLayerActivationFunction,outputLayerActivationFunction);
     }
     
     return true;
@@ -1907,203 +2312,12 @@ bool MLP::loadLegacyModelFromFile( std::fstream &file ){
     }
     file >> nullRejectionThreshold;
     
-    //Resize the layers
-    inputLayer.resize( numInputNeurons );
-    hiddenLayer.resize( numHiddenNeurons );
-    outputLayer.resize( numOutputNeurons );
-    
     //Load the neuron data
-    file >> word;
-    if(word != "InputLayer:"){
-        file.close();
-        errorLog << __GRT_LOG__ << " Failed to find InputLayer!" << std::endl;
-        return false;
-    }
-    
-    for(UINT i=0; i<numInputNeurons; i++){
-        UINT tempNeuronID = 0;
-        
-        file >> word;
-        if(word != "InputNeuron:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find InputNeuron!" << std::endl;
-            return false;
-        }
-        file >> tempNeuronID;
-        
-        if( tempNeuronID != i+1 ){
-            file.close();
-            errorLog << __GRT_LOG__ << " InputNeuron ID does not match!" << std::endl;
-            return false;
-        }
-        
-        file >> word;
-        if(word != "NumInputs:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find NumInputs!" << std::endl;
-            return false;
-        }
-        file >> inputLayer[i].numInputs;
-        
-        //Resize the buffers
-        inputLayer[i].weights.resize( inputLayer[i].numInputs );
-        
-        file >> word;
-        if(word != "Bias:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Bias!" << std::endl;
-            return false;
-        }
-        file >> inputLayer[i].bias;
-        
-        file >> word;
-        if(word != "Gamma:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Gamma!" << std::endl;
-            return false;
-        }
-        file >> inputLayer[i].gamma;
-        
-        file >> word;
-        if(word != "Weights:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Weights!" << std::endl;
-            return false;
-        }
-        
-        for(UINT j=0; j<inputLayer[i].numInputs; j++){
-            file >> inputLayer[i].weights[j];
-        }
-    }
-    
-    //Load the Hidden Layer
-    file >> word;
-    if(word != "HiddenLayer:"){
-        file.close();
-        errorLog << __GRT_LOG__ << " Failed to find HiddenLayer!" << std::endl;
-        return false;
-    }
-    
-    for(UINT i=0; i<numHiddenNeurons; i++){
-        UINT tempNeuronID = 0;
-        
-        file >> word;
-        if(word != "HiddenNeuron:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find HiddenNeuron!" << std::endl;
-            return false;
-        }
-        file >> tempNeuronID;
-        
-        if( tempNeuronID != i+1 ){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find HiddenNeuron ID does not match!" << std::endl;
-            return false;
-        }
-        
-        file >> word;
-        if(word != "NumInputs:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find NumInputs!" << std::endl;
-            return false;
-        }
-        file >> hiddenLayer[i].numInputs;
-        
-        //Resize the buffers
-        hiddenLayer[i].weights.resize( hiddenLayer[i].numInputs );
-        
-        file >> word;
-        if(word != "Bias:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Bias!" << std::endl;
-            return false;
-        }
-        file >> hiddenLayer[i].bias;
-        
-        file >> word;
-        if(word != "Gamma:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Gamma!" << std::endl;
-            return false;
-        }
-        file >> hiddenLayer[i].gamma;
-        
-        file >> word;
-        if(word != "Weights:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Weights!" << std::endl;
-            return false;
-        }
-        
-        for(unsigned int j=0; j<hiddenLayer[i].numInputs; j++){
-            file >> hiddenLayer[i].weights[j];
-        }
-    }
-    
-    //Load the Output Layer
-    file >> word;
-    if(word != "OutputLayer:"){
-        file.close();
-        errorLog << __GRT_LOG__ << " Failed to find OutputLayer!" << std::endl;
+    hiddenLayerSizes.resize( 1, numHiddenNeurons );
+    if( !loadNeuronLayers( file ) ){
         return false;
     }
     
-    for(UINT i=0; i<numOutputNeurons; i++){
-        UINT tempNeuronID = 0;
-        
-        file >> word;
-        if(word != "OutputNeuron:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find OutputNeuron!" << std::endl;
-            return false;
-        }
-        file >> tempNeuronID;
-        
-        if( tempNeuronID != i+1 ){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find OuputNeuron ID does not match!!" << std::endl;
-            return false;
-        }
-        
-        file >> word;
-        if(word != "NumInputs:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find NumInputs!" << std::endl;
-            return false;
-        }
-        file >> outputLayer[i].numInputs;
-        
-        //Resize the buffers
-        outputLayer[i].weights.resize( outputLayer[i].numInputs );
-        
-        file >> word;
-        if(word != "Bias:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Bias!" << std::endl;
-            return false;
-        }
-        file >> outputLayer[i].bias;
-        
-        file >> word;
-        if(word != "Gamma:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Gamma!" << std::endl;
-            return false;
-        }
-        file >> outputLayer[i].gamma;
-        
-        file >> word;
-        if(word != "Weights:"){
-            file.close();
-            errorLog << __GRT_LOG__ << " Failed to find Weights!" << std::endl;
-            return false;
-        }
-        
-        for(UINT j=0; j<outputLayer[i].numInputs; j++){
-            file >> outputLayer[i].weights[j];
-        }
-    }
-    
     if( useScaling ){
         //Resize the ranges buffers
         inputVectorRanges.resize( numInputNeurons );
@@ -2139,6 +2353,131 @@ bool MLP::loadLegacyModelFromFile( std::fstream &file ){
     return true;
 }
 
+bool MLP::loadNeuronLayers( std::fstream &file ){
+    
+    //The neurons are stored layer by layer, each layer has a header followed by the data for each of its neurons
+    const std::string layerNames[3] = {"InputLayer","HiddenLayer","OutputLayer"};
+    const std::string neuronNames[3] = {"InputNeuron","HiddenNeuron","OutputNeuron"};
+    const UINT layerSizes[3] = {numInputNeurons,numHiddenNeurons,numOutputNeurons};
+    Vector< Neuron > layers[3];
+    std::string word;
+    
+    for(UINT l=0; l<3; l++){
+        file >> word;
+        if( word != layerNames[l] + ":" ){
+            file.close();
+            errorLog << __GRT_LOG__ << " Failed to find " << layerNames[l] << "!" << std::endl;
+            return false;
+        }
+        
+        layers[l].resize( layerSizes[l] );
+        for(UINT i=0; i<layerSizes[l]; i++){
+            Neuron &neuron = layers[l][i];
+            UINT tempNeuronID = 0;
+            
+            file >> word;
+            if( word != neuronNames[l] + ":" ){
+                file.close();
+                errorLog << __GRT_LOG__ << " Failed to find " << neuronNames[l] << "!" << std::endl;
+                return false;
+            }
+            file >> tempNeuronID;
+            
+            if( tempNeuronID != i+1 ){
+                file.close();
+                errorLog << __GRT_LOG__ << " " << neuronNames[l] << " ID does not match!" << std::endl;
+                return false;
+            }
+            
+            file >> word;
+            if(word != "NumInputs:"){
+                file.close();
+                errorLog << __GRT_LOG__ << " Failed to find NumInputs!" << std::endl;
+                return false;
+            }
+            file >> neuron.numInputs;
+            
+            //Resize the buffers
+            neuron.weights.resize( neuron.numInputs );
+            
+            file >> word;
+            if(word != "Bias:"){
+                file.close();
+                errorLog << __GRT_LOG__ << " Failed to find Bias!" << std::endl;
+                return false;
+            }
+            file >> neuron.bias;
+            
+            file >> word;
+            if(word != "Gamma:"){
+                file.close();
+                errorLog << __GRT_LOG__ << " Failed to find Gamma!" << std::endl;
+                return false;
+            }
+            file >> neuron.gamma;
+            
+            file >> word;
+            if(word != "Weights:"){
+                file.close();
+                errorLog << __GRT_LOG__ << " Failed to find Weights!" << std::endl;
+                return false;
+            }
+            
+            for(UINT j=0; j<neuron.numInputs; j++){
+                file >> neuron.weights[j];
+            }
+        }
+    }
+    
+    return setLayersFromNeurons( layers[0], layers[1], layers[2] );
+}
+
+bool MLP::setLayersFromNeurons(const Vector< Neuron > &inputLayer,const Vector< Neuron > &hiddenLayer,const Vector< Neuron > &outputLayer){
+    
+    //Each input neuron has a single input
+    inputLayerWeights.resize( inputLayer.getSize() );
+    inputLayerBias.resize( inputLayer.getSize() );
+    for(UINT i=0; i<inputLayer.getSize(); i++){
+        if( inputLayer[i].numInputs != 1 ){
+            errorLog << __GRT_LOG__ << " Input neuron " << i << " should have 1 input, but it has " << inputLayer[i].numInputs << std::endl;
+            return false;
+        }
+        inputLayerWeights[i] = inputLayer[i].weights[0];
+        inputLayerBias[i] = inputLayer[i].bias;
+    }
+    
+    //Copy the neurons of the hidden layer and the output layer into the weight matrix of each layer
+    const Vector< Neuron > *layers[2] = {&hiddenLayer,&outputLayer};
+    layerWeights.resize( 2 );
+    layerBias.resize( 2 );
+    layerPreviousUpdates.resize( 2 );
+    layerPreviousBiasUpdates.resize( 2 );
+    
+    UINT numLayerInputs = inputLayer.getSize();
+    for(UINT l=0; l<2; l++){
+        const Vector< Neuron > &neurons = *layers[l];
+        const UINT numLayerNeurons = neurons.getSize();
+        layerWeights[l].resize( numLayerNeurons, numLayerInputs );
+        layerBias[l].resize( numLayerNeurons );
+        layerPreviousUpdates[l].resize( numLayerNeurons, numLayerInputs, 0 );
+        layerPreviousBiasUpdates[l].resize( numLayerNeurons, 0 );
+        
+        for(UINT i=0; i<numLayerNeurons; i++){
+            if( neurons[i].numInputs != numLayerInputs ){
+                errorLog << __GRT_LOG__ << " Neuron " << i << " in layer " << l+1 << " should have " << numLayerInputs << " inputs, but it has " << neurons[i].numInputs << std::endl;
+                return false;
+            }
+            for(UINT j=0; j<numLayerInputs; j++){
+                layerWeights[l][i][j] = neurons[i].weights[j];
+            }
+            layerBias[l][i] = neurons[i].bias;
+        }
+        numLayerInputs = numLayerNeurons;
+    }
+    
+    return true;
+}
+
 bool MLP::setOutputTargets(){
 
     switch( outputLayerActivationFunction ){
@@ -35,6 +35,12 @@ GRT_BEGIN_NAMESPACE
 /**
  @brief This class implements a Multilayer Perceptron Artificial Neural Network.
 
+ The network can have any number of hidden layers. The weights of each layer are stored as one dense matrix, with one row per neuron, so a
+ layer is computed as a matrix product. By default the network is trained with online gradient descent, updating the weights after each
+ training example. If the batch size is set to a value greater than 1, then the network is trained with mini-batch gradient descent: the
+ forward and backward passes for all the examples in a batch are computed as matrix products (using GEMM), and the weights are updated
+ once per batch with the average gradient of the batch.
+
  @example RegressionModulesExamples/MLPRegressionExample/MLPRegressionExample.cpp
 
  @remark This implementation is based on Bishop, Christopher M. Pattern recognition and machine learning. Vol. 1. New York: springer, 2006.
@@ -93,6 +99,16 @@ public:
     */
     virtual bool train_(RegressionData &trainingData);
     
+    /**
+    This trains the MLP model from a dataset that is stored on disk. A classification dataset sets the MLP into Classification Mode (with one
+    output neuron per class) and a regression dataset sets the MLP into Regression Mode. Mini-batches are taken from each chunk in turn, so the
+    effective batch size is limited to the chunk size. The validation set is not used, the training error is the RMS error in both modes.
+    
+    @param trainingData: the chunked dataset that will be used to train the model
+    @return returns true if the MLP model was trained, false otherwise
+    */
+    virtual bool train_(ChunkedDataset &trainingData);
+    
     /**
     This function either predicts the class of the input Vector (if the MLP is in Classification Mode), or it performs regression using
     the MLP model.
@@ -182,6 +198,26 @@ public:
               const Neuron::Type hiddenLayerActivationFunction, 
               const Neuron::Type outputLayerActivationFunction);
     
+    /**
+    Initializes the MLP for training with one or more hidden layers. This should be called before the MLP is trained.
+    The number of input neurons should match the number of input dimensions in your training data.
+    The number of output neurons should match the number of target dimensions in your training data.
+    All the hidden layers use the hidden layer activation function.
+    Initializaling the MLP will clear any previous model or settings.
+    
+    @param numInputNeurons: the number of input neurons (should match the number of input dimensions in your training data)
+    @param hiddenLayerSizes: the number of neurons in each hidden layer, there must be at least one hidden layer and each layer must have at least one neuron
+    @param numOutputNeurons: the number of output neurons (should match the number of target dimensions in your training data)
+    @param inputLayerActivationFunction: the activation function to use for the input layer
+    @param hiddenLayerActivationFunction: the activation function to use for the hidden layers
+    @param outputLayerActivationFunction: the activation function to use for the output layer
+    @return returns true if the MLP was initialized, false otherwise
+    */
+    bool init(const UINT numInputNeurons, const Vector< UINT > &hiddenLayerSizes, const UINT numOutputNeurons,
+              const Neuron::Type inputLayerActivationFunction,
+              const Neuron::Type hiddenLayerActivationFunction,
+              const Neuron::Type outputLayerActivationFunction);
+    
     /**
     Prints the current MLP weights and coefficents to std out.
     This function is depreciated, you should now use print() instead.
@@ -227,12 +263,26 @@ public:
     UINT getNumInputNeurons() const;
     
     /**
-    Gets the number of hidden neurons.
+    Gets the number of hidden neurons. If the MLP has more than one hidden layer, this is the number of neurons in the first hidden layer.
     
     @return returns the number of hidden neurons
     */
     UINT getNumHiddenNeurons() const;
     
+    /**
+    Gets the number of hidden layers.
+    
+    @return returns the number of hidden layers
+    */
+    UINT getNumHiddenLayers() const;
+    
+    /**
+    Gets the number of neurons in each hidden layer.
+    
+    @return returns a Vector with the number of neurons in each hidden layer
+    */
+    Vector< UINT > getHiddenLayerSizes() const;
+    
     /**
     Gets the number of output neurons.
     
@@ -285,6 +335,13 @@ public:
     */
     Float getMomentum() const;
     
+    /**
+    Gets the batch size, this is the number of training examples used for each update of the weights.
+    
+    @return returns the batch size
+    */
+    UINT getBatchSize() const;
+    
     /**
     Gets the gamma value. This controls the gamma parameter for the neurons.
     
@@ -322,12 +379,20 @@ public:
     Vector< Neuron > getInputLayer() const;
     
     /**
-    Returns the neurons for the hidden layer.
+    Returns the neurons for the hidden layer. If the MLP has more than one hidden layer, this returns the neurons of the first hidden layer.
     
     @return returns a Vector of neurons for the hidden layer
     */
     Vector< Neuron > getHiddenLayer() const;
     
+    /**
+    Returns the neurons for one of the hidden layers.
+    
+    @param layerIndex: the index of the hidden layer, this must be less than the number of hidden layers
+    @return returns a Vector of neurons for the hidden layer, an empty Vector will be returned if the layerIndex is not valid
+    */
+    Vector< Neuron > getHiddenLayer(const UINT layerIndex) const;
+    
     /**
     Returns the neurons for the output layer.
     
@@ -445,6 +510,17 @@ public:
     */
     bool setMomentum(const Float momentum);
     
+    /**
+    Sets the batch size, this is the number of training examples used for each update of the weights. A batch size of 1 (the default) trains
+    the MLP with online gradient descent. A larger batch size trains the MLP with mini-batch gradient descent, where each update uses the
+    average gradient of the batch and the forward and backward passes of the batch are computed as matrix products. A larger batch size
+    is much faster for large datasets, but may need a larger learning rate.
+    
+    @param batchSize: the number of training examples in each batch, must be greater than zero
+    @return returns true if the value was updated successfully, false otherwise
+    */
+    bool setBatchSize(const UINT batchSize);
+    
     /**
     Sets the gamma parameter for the Neurons. Gamma must be greater than zero.
     If the MLP instance has been initialized then this function will also call the init function to reinitialize the instance.
@@ -514,6 +590,37 @@ protected:
     
     bool loadLegacyModelFromFile( std::fstream &file );
     
+    bool loadNeuronLayers( std::fstream &file );
+    
+    bool setLayersFromNeurons(const Vector< Neuron > &inputLayer,const Vector< Neuron > &hiddenLayer,const Vector< Neuron > &outputLayer);
+    
+    Vector< Neuron > getLayerNeurons(const UINT layerIndex) const;
+    
+    /**
+    Performs one round of back propagation, using a batch of training examples. If the batch has one example, then the weights are updated
+    with online gradient descent, otherwise the weights are updated with the average gradient of the batch.
+    
+    @param trainingData: the training data
+    @param indexList: the order of the training examples
+    @param batchStart: the index in the indexList of the first example in the batch
+    @param numSamples: the number of examples in the batch
+    @param alpha: the training rate
+    @param beta: the momentum
+    @return returns the sum of the error for each training example in the batch
+    */
+    Float back_prop(const RegressionData &trainingData,const Vector< UINT > &indexList,const UINT batchStart,const UINT numSamples,const Float alpha,const Float beta);
+    
+    /**
+    Performs one round of back propagation for a batch of training examples that has already been copied into the batch buffers: the inputs
+    are the first rows of batchLayerOutputs[0] and the targets are the first rows of batchTargets.
+    
+    @param numSamples: the number of examples in the batch
+    @param alpha: the training rate
+    @param beta: the momentum
+    @return returns the sum of the error for each training example in the batch
+    */
+    Float back_prop(const UINT numSamples,const Float alpha,const Float beta);
+    
     /**
     Performs one round of back propagation, using the training example and target Vector
     
@@ -529,36 +636,52 @@ protected:
     Performs the feedforward step using the current model and the input training example.
     
     @param data: the input Vector to use for the feedforward
-    @return returns a new Vector of the results from the feedforward step
+    @return returns a reference to the output of the network, this is valid until the next feedforward
     */
-    VectorFloat feedforward(VectorFloat data);
+    const VectorFloat& feedforward(const VectorFloat &data);
     
     /**
-    Performs the feedforward step for back propagation, using the input data
+    Performs the feedforward step for back propagation, using the input data. The output of each layer is stored in layerOutputs.
     
-    @param data: the input Vector to use for the feedforward
-    @param inputNeuronsOutput: the results of the input layer
-    @param hiddenNeuronsOutput: the results of the hidden layer
-    @param outputNeuronsOutput: the results of the output layer
+    @param data: a pointer to the input data to use for the feedforward
     */
-    void feedforward(const VectorFloat &data,VectorFloat &inputNeuronsOutput,VectorFloat &hiddenNeuronsOutput,VectorFloat &outputNeuronsOutput);
+    void feedforward(const Float *data);
+    
+    /**
+    Performs the feedforward step for a batch of examples. The output of each layer for each example is stored in batchLayerOutputs.
+    
+    @param numSamples: the number of examples in the batch, the examples are the first rows of batchLayerOutputs[0]
+    */
+    void feedforwardBatch(const UINT numSamples);
+    
+    void setupBuffers();
+    void setupBatchBuffers(const UINT numSamples);
+    
+    Neuron::Type getLayerActivationFunction(const UINT layerIndex) const{
+        return layerIndex+1 < layerWeights.getSize() ? hiddenLayerActivationFunction : outputLayerActivationFunction;
+    }
     
     UINT numInputNeurons;
     UINT numHiddenNeurons;
     UINT numOutputNeurons;
+    Vector< UINT > hiddenLayerSizes;
     Neuron::Type inputLayerActivationFunction;
     Neuron::Type hiddenLayerActivationFunction;
     Neuron::Type outputLayerActivationFunction;
     UINT trainingMode;
+    UINT batchSize;
     Float momentum;
     Float gamma;
     Float trainingError;
     MinMax outputTargets;
     bool initialized;
     
-    Vector< Neuron > inputLayer;
-    Vector< Neuron > hiddenLayer;
-    Vector< Neuron > outputLayer;
+    VectorFloat inputLayerWeights;                  ///< The weight of each input neuron, each input neuron has one input
+    VectorFloat inputLayerBias;                     ///< The bias of each input neuron
+    Vector< MatrixFloat > layerWeights;             ///< The weights of each hidden layer and then the output layer, each row holds the weights of one neuron
+    Vector< VectorFloat > layerBias;                ///< The bias of each neuron in each hidden layer and the output layer
+    Vector< MatrixFloat > layerPreviousUpdates;     ///< The previous weight updates, used for the momentum
+    Vector< VectorFloat > layerPreviousBiasUpdates; ///< The previous bias updates, used for the momentum
     Vector< VectorFloat > trainingErrorLog;
     
     //Classifier Variables
@@ -571,11 +694,12 @@ protected:
     VectorFloat classLikelihoods;
     
     //Temp Training Stuff
-    VectorFloat inputNeuronsOutput;
-    VectorFloat hiddenNeuronsOutput;
-    VectorFloat outputNeuronsOutput;
-    VectorFloat deltaO;
-    VectorFloat deltaH;
+    VectorFloat scaledInput;
+    Vector< VectorFloat > layerOutputs;             ///< The output of the input layer, then each hidden layer and the output layer
+    Vector< VectorFloat > layerDeltas;              ///< The error term of each hidden layer and the output layer
+    Vector< MatrixFloat > batchLayerOutputs;        ///< The output of each layer for each example in a batch, one row per example
+    Vector< MatrixFloat > batchLayerDeltas;         ///< The error term of each layer for each example in a batch, one row per example
+    MatrixFloat batchTargets;                       ///< The target of each example in a batch, one row per example
 
 private:
     static RegisterRegressifierModule< MLP > registerModule;
@@ -93,62 +93,15 @@ void Neuron::clear(){
 
 Float Neuron::fire(const VectorFloat &x){
     
-    Float y = 0;
-    UINT i=0;
-    
-    switch( activationFunction ){
-        case(LINEAR):
-            y = bias;
-            for(i=0; i<numInputs; i++){
-                y += x[i] * weights[i];
-            }
-            break;
-        case(SIGMOID):
-            y = bias;
-            for(i=0; i<numInputs; i++){
-                y += x[i] * weights[i];
-            }
-            
-            y = 1.0/(1.0+exp(-y));
-            break;
-        case(BIPOLAR_SIGMOID):
-            y = bias;
-            for(i=0; i<numInputs; i++){
-                y += x[i] * weights[i];
-            }
-	
-            y = (2.0 / (1.0 + exp(-gamma * y))) - 1.0;
-            break;
-        case(TANH):
-            y = bias;
-            for(i=0; i<numInputs; i++){
-                y += x[i] * weights[i];
-            }
-            y = tanh( y );
-            break;
+    Float y = bias;
+    for(UINT i=0; i<numInputs; i++){
+        y += x[i] * weights[i];
     }
-    return y;
-    
+    return activate( activationFunction, y, gamma );
 }
 
 Float Neuron::getDerivative(const Float &y){
-
-  Float yy = 0;
-  switch( activationFunction ){
-        case(LINEAR):
-			yy = 1.0;
-            break;
-        case(SIGMOID):
-			yy = y * (1.0 - y);
-            break;
-        case(BIPOLAR_SIGMOID):
-			yy = (gamma * (1.0 - (y*y))) / 2.0;
-            break;
-        case(TANH):
-            yy = 1.0 - (y*y);
-            break;
-    }
-    return yy;
+    return derivative( activationFunction, y, gamma );
 }
     
 bool Neuron::validateActivationFunction(const Type actvationFunction){
@@ -54,6 +54,33 @@ public:
     
     static bool validateActivationFunction(const Type activationFunction);
     
+    //Computes the activation function for the weighted sum y, and the derivative of the activation function for the output y
+    static inline Float activate(const UINT activationFunction,const Float y,const Float gamma){
+        switch( activationFunction ){
+            case(SIGMOID):
+                return 1.0/(1.0+exp(-y));
+            case(BIPOLAR_SIGMOID):
+                return (2.0 / (1.0 + exp(-gamma * y))) - 1.0;
+            case(TANH):
+                return tanh( y );
+            default:
+                return y;
+        }
+    }
+    
+    static inline Float derivative(const UINT activationFunction,const Float y,const Float gamma){
+        switch( activationFunction ){
+            case(SIGMOID):
+                return y * (1.0 - y);
+            case(BIPOLAR_SIGMOID):
+                return (gamma * (1.0 - (y*y))) / 2.0;
+            case(TANH):
+                return 1.0 - (y*y);
+            default:
+                return 1.0;
+        }
+    }
+    
     Float gamma;
     Float bias;
     Float previousBiasUpdate;
@@ -197,6 +197,126 @@ bool LinearRegression::train_(RegressionData &trainingData){
     return trained;
 }
 
+bool LinearRegression::train_(ChunkedDataset &trainingData){
+
+    const unsigned int M = trainingData.getNumSamples();
+    const unsigned int N = trainingData.getNumInputDimensions();
+    const unsigned int K = trainingData.getNumTargetDimensions();
+    trained = false;
+    trainingResults.clear();
+
+    if( trainingData.getDataType() != ChunkedDataset::REGRESSION_DATA ){
+        errorLog << "train_(ChunkedDataset &trainingData) - The chunked dataset does not contain regression data!" << std::endl;
+        return false;
+    }
+
+    if( M == 0 ){
+        errorLog << "train_(ChunkedDataset &trainingData) - Training data has zero samples!" << std::endl;
+        return false;
+    }
+
+    if( K == 0 ){
+        errorLog << "train_(ChunkedDataset &trainingData) - The number of target dimensions is not 1!" << std::endl;
+        return false;
+    }
+
+    numInputDimensions = N;
+    numOutputDimensions = 1;
+    inputVectorRanges.clear();
+    targetVectorRanges.clear();
+
+    //The data is scaled one chunk at a time as it is used, so only the ranges are needed here
+    if( useScaling ){
+        inputVectorRanges = trainingData.getInputRanges();
+        targetVectorRanges = trainingData.getTargetRanges();
+        if( inputVectorRanges.getSize() != N || targetVectorRanges.getSize() != K ){
+            errorLog << "train_(ChunkedDataset &trainingData) - Failed to compute the ranges of the training data!" << std::endl;
+            return false;
+        }
+    }
+
+    //Reset the weights
+    Random rand;
+    w0 = rand.getRandomNumberUniform(-0.1,0.1);
+    w.resize(N);
+    for(UINT j=0; j<N; j++){
+        w[j] = rand.getRandomNumberUniform(-0.1,0.1);
+    }
+
+    Float error = 0;
+    Float lastError = 0;
+    Float delta = 0;
+    UINT iter = 0;
+    bool keepTraining = true;
+    TrainingResult result;
+
+    //Run the main stochastic gradient descent training algorithm, the chunked dataset shuffles the samples for each epoch
+    while( keepTraining ){
+
+        //Run one epoch of training using stochastic gradient descent
+        totalSquaredTrainingError = 0;
+        if( !trainingData.startEpoch() ) return false;
+        while( trainingData.nextChunk() ){
+
+            if( useScaling ) trainingData.scaleChunk( inputVectorRanges, targetVectorRanges, 0.0, 1.0 );
+
+            const MatrixFloat &X = trainingData.getInputs();
+            const MatrixFloat &Y = trainingData.getTargets();
+            const UINT numRows = X.getNumRows();
+            for(UINT i=0; i<numRows; i++){
+
+                //Compute the error, given the current weights
+                const Float *x = X[i];
+                Float h = w0;
+                for(UINT j=0; j<N; j++){
+                    h += x[j] * w[j];
+                }
+                error = Y[i][0] - h;
+                totalSquaredTrainingError += SQR( error );
+
+                //Update the weights
+                for(UINT j=0; j<N; j++){
+                    w[j] += learningRate * error * x[j];
+                }
+                w0 += learningRate * error;
+            }
+        }
+
+        //Compute the error
+        delta = fabs( totalSquaredTrainingError-lastError );
+        lastError = totalSquaredTrainingError;
+
+        //Check to see if we should stop
+        if( delta <= minChange ){
+            keepTraining = false;
+        }
+
+        if( grt_isinf( totalSquaredTrainingError ) || grt_isnan( totalSquaredTrainingError ) ){
+            errorLog << "train_(ChunkedDataset &trainingData) - Training failed! Total squared training error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << std::endl;
+            return false;
+        }
+
+        if( ++iter >= maxNumEpochs ){
+            keepTraining = false;
+        }
+
+        //Store the training results
+        rmsTrainingError = sqrt( totalSquaredTrainingError / Float(M) );
+        result.setRegressionResult(iter,totalSquaredTrainingError,rmsTrainingError,this);
+        trainingResults.push_back( result );
+
+        //Notify any observers of the new result
+        trainingResultsObserverManager.notifyObservers( result );
+
+        trainingLog << "Epoch: " << iter << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << std::endl;
+    }
+
+    //Flag that the algorithm has been trained
+    regressionData.resize(1,0);
+    trained = true;
+    return trained;
+}
+
 bool LinearRegression::predict_(VectorFloat &inputVector){
     
     if( !trained ){
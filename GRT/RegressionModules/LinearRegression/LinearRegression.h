@@ -82,6 +82,15 @@ class GRT_API LinearRegression : public Regressifier
     @return returns true if the LRC model was trained, false otherwise
     */
     virtual bool train_(RegressionData &trainingData);
+
+    /**
+    This trains the Linear Regression model from a regression dataset that is stored on disk, using stochastic gradient descent over
+    each chunk of the dataset. If scaling is enabled the ranges of the dataset are computed with one pass over the file before training starts.
+
+    @param trainingData: the chunked regression dataset that will be used to train the regression model
+    @return returns true if the model was trained, false otherwise
+    */
+    virtual bool train_(ChunkedDataset &trainingData);
     
     /**
     This performs the regression by mapping the inputVector using the current Logistic Regression model.
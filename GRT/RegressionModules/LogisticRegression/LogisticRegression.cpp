@@ -279,6 +279,159 @@ bool LogisticRegression::train_(RegressionData &trainingData){
     return trained;
 }
 
+bool LogisticRegression::train_(ChunkedDataset &trainingData){
+
+    const unsigned int M = trainingData.getNumSamples();
+    const unsigned int N = trainingData.getNumInputDimensions();
+    const unsigned int K = trainingData.getNumTargetDimensions();
+    trained = false;
+    trainingResults.clear();
+
+    if( trainingData.getDataType() != ChunkedDataset::REGRESSION_DATA ){
+        errorLog << "train_(ChunkedDataset &trainingData) - The chunked dataset does not contain regression data!" << std::endl;
+        return false;
+    }
+
+    if( M == 0 ){
+        errorLog << "train_(ChunkedDataset &trainingData) - Training data has zero samples!" << std::endl;
+        return false;
+    }
+
+    if( K == 0 ){
+        errorLog << "train_(ChunkedDataset &trainingData) - The number of target dimensions is not 1!" << std::endl;
+        return false;
+    }
+
+    numInputDimensions = N;
+    numOutputDimensions = 1; //Logistic Regression will have 1 output
+    inputVectorRanges.clear();
+    targetVectorRanges.clear();
+
+    //The data is scaled one chunk at a time as it is used, so only the ranges are needed here
+    if( useScaling ){
+        inputVectorRanges = trainingData.getInputRanges();
+        targetVectorRanges = trainingData.getTargetRanges();
+        if( inputVectorRanges.getSize() != N || targetVectorRanges.getSize() != K ){
+            errorLog << "train_(ChunkedDataset &trainingData) - Failed to compute the ranges of the training data!" << std::endl;
+            return false;
+        }
+    }
+
+    //Reset the weights
+    w0 = 0;
+    w.resize(N);
+    for(UINT j=0; j<N; j++){
+        w[j] = 0;
+    }
+
+    //A batch size of zero means each chunk is used as one batch
+    const UINT maxBatchSize = batchSize == 0 ? trainingData.getChunkSize() : batchSize;
+
+    Float error = 0;
+    Float lastError = 0;
+    Float delta = 0;
+    Float batchError = 0;
+    Float h = 0;
+    UINT iter = 0;
+    UINT epoch = 0;
+    bool keepTraining = true;
+    TrainingResult result;
+    VectorFloat meanInputData(N);
+
+    //Run the main stochastic gradient descent training algorithm, the chunked dataset shuffles the samples for each epoch
+    while( keepTraining ){
+
+        if( !trainingData.startEpoch() ) return false;
+        while( keepTraining && trainingData.nextChunk() ){
+
+            if( useScaling ) trainingData.scaleChunk( inputVectorRanges, targetVectorRanges, 0.0, 1.0 );
+
+            const MatrixFloat &X = trainingData.getInputs();
+            const MatrixFloat &Y = trainingData.getTargets();
+            const UINT numRows = X.getNumRows();
+            UINT batchStartIndex = 0;
+            while( batchStartIndex < numRows && keepTraining ){
+
+                rmsTrainingError = 0.0;
+
+                //Update the batch counters, the rows of the chunk are already shuffled so each batch is a contiguous block of rows
+                const UINT batchEndIndex = std::min( batchStartIndex + maxBatchSize, numRows );
+                const UINT numSamplesInBatch = batchEndIndex-batchStartIndex;
+
+                //Compute the average input for this batch
+                meanInputData.fill(0.0);
+                for(UINT n=batchStartIndex; n<batchEndIndex; n++){
+                    const Float *x = X[n];
+                    for(UINT j=0; j<N; j++){
+                        meanInputData[j] += x[j];
+                    }
+                }
+                for(UINT j=0; j<N; j++){
+                    meanInputData[j] /= static_cast<Float>(numSamplesInBatch);
+                }
+
+                //Compute the error for each sample in the batch, given the current weights
+                batchError = 0;
+                for(UINT n=batchStartIndex; n<batchEndIndex; n++){
+                    const Float *x = X[n];
+                    h = w0;
+                    for(UINT j=0; j<N; j++){
+                        h += x[j] * w[j];
+                    }
+                    error = Y[n][0] - sigmoid( h );
+                    batchError += error;
+                    rmsTrainingError += SQR(error);
+                }
+                //The batch error is the average error across the batch
+                batchError /= static_cast<Float>(numSamplesInBatch);
+
+                //Update the weights based on the average error across the batch
+                for(UINT j=0; j<N; j++){
+                    w[j] += learningRate * batchError * meanInputData[j];
+                }
+                w0 += learningRate * batchError;
+
+                //Compute the error
+                rmsTrainingError = sqrt( rmsTrainingError / static_cast<Float>(numSamplesInBatch) );
+                delta = iter > 0 ? fabs( rmsTrainingError-lastError ) : rmsTrainingError;
+                lastError = rmsTrainingError;
+
+                //Check to see if we should stop
+                if( delta <= minChange && epoch >= minNumEpochs ){
+                    keepTraining = false;
+                }
+
+                if( grt_isinf( rmsTrainingError ) || grt_isnan( rmsTrainingError ) ){
+                    errorLog << __GRT_LOG__ << " Training failed! RMS error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << std::endl;
+                    return false;
+                }
+
+                //Update the counters and batch index
+                iter++;
+                batchStartIndex = batchEndIndex;
+
+                //Store the training results
+                result.setRegressionResult(epoch,rmsTrainingError,0,this);
+                trainingResults.push_back( result );
+
+                //Notify any observers of the new result
+                trainingResultsObserverManager.notifyObservers( result );
+
+                trainingLog << "Epoch: " << epoch << " | Iter: " << iter << " | RMS Training Error: " << rmsTrainingError << " | Delta: " << delta << std::endl;
+            }
+        }
+
+        if( ++epoch >= maxNumEpochs ){
+            keepTraining = false;
+        }
+    }
+
+    //Flag that the algorithm has been trained
+    regressionData.resize(1,0);
+    trained = true;
+    return trained;
+}
+
 bool LogisticRegression::predict_(VectorFloat &inputVector){
     
     if( !trained ){
@@ -87,6 +87,15 @@ public:
     @return returns true if the LRC model was trained, false otherwise
     */
     virtual bool train_(RegressionData &trainingData);
+
+    /**
+    This trains the Logistic Regression model from a regression dataset that is stored on disk, using mini-batch gradient descent over each chunk
+    of the dataset. Mini-batches do not span chunks, so the effective batch size is limited to the chunk size. The validation set is not used.
+
+    @param trainingData: the chunked regression dataset that will be used to train the regression model
+    @return returns true if the model was trained, false otherwise
+    */
+    virtual bool train_(ChunkedDataset &trainingData);
     
     /**
     This performs the regression by mapping the inputVector using the current Logistic Regression model.
@@ -36,6 +36,8 @@ RegisterRegressifierModule< RegressionTree >  RegressionTree::registerModule( Re
 RegressionTree::RegressionTree(const UINT numSplittingSteps,const UINT minNumSamplesPerNode,const UINT maxDepth,const bool removeFeaturesAtEachSpilt,const Tree::TrainingMode trainingMode,const bool useScaling,const Float minRMSErrorPerNode) : Regressifier( RegressionTree::getId() )
 {
     tree = NULL;
+    flatTreeBuilt = false;
+    predictedNodeID = 0;
     this->numSplittingSteps = numSplittingSteps;
     this->minNumSamplesPerNode = minNumSamplesPerNode;
     this->maxDepth = maxDepth;
@@ -48,6 +50,8 @@ RegressionTree::RegressionTree(const UINT numSplittingSteps,const UINT minNumSam
 RegressionTree::RegressionTree(const RegressionTree &rhs) : Regressifier( RegressionTree::getId() )
 {
     tree = NULL;
+    flatTreeBuilt = false;
+    predictedNodeID = 0;
     *this = rhs;
 }
 
@@ -139,9 +143,22 @@ bool RegressionTree::train_(RegressionData &trainingData){
         features[i] = i;
     }
     
+    //Copy the training data into the column-major store that is shared by all the nodes while the tree is built
+    RegressionTreeTrainingData treeData;
+    if( !treeData.set( trainingData ) ){
+        Regressifier::errorLog << "train_(RegressionData &trainingData) - Failed to set the tree training data!" << std::endl;
+        return false;
+    }
+    
+    //Quantise the features if the tree will be built from histograms, the number of splitting steps is the maximum number of bins
+    if( trainingMode == Tree::BEST_HISTOGRAM_SPLIT && !treeData.computeBins( numSplittingSteps ) ){
+        Regressifier::errorLog << "train_(RegressionData &trainingData) - Failed to compute the feature bins, the number of splitting steps must be in the range [2 65535] when using the histogram training mode!" << std::endl;
+        return false;
+    }
+    
     //Build the tree
     UINT nodeID = 0;
-    tree = buildTree( trainingData, NULL, features, nodeID );
+    tree = buildTree( treeData, 0, M, NULL, features, nodeID );
     
     if( tree == NULL ){
         clear();
@@ -178,9 +195,21 @@ bool RegressionTree::predict_(VectorFloat &inputVector){
         }
     }
     
-    if( !tree->predict_( inputVector, regressionData ) ){
-        Regressifier::errorLog << "predict_(VectorFloat &inputVector) - Failed to predict!" << std::endl;
-        return false;
+    //Flatten the tree the first time it is used, if any of its nodes can not be flattened then the tree is run node by node
+    if( !flatTreeBuilt ) buildFlatTree();
+    
+    if( flatTree.getNumTrees() > 0 ){
+        const UINT leafIndex = flatTree.predictLeaf( 0, &inputVector[0] );
+        const Float *leafValues = flatTree.getLeafValues( leafIndex );
+        regressionData.resize( numOutputDimensions );
+        std::copy( leafValues, leafValues+numOutputDimensions, regressionData.begin() );
+        predictedNodeID = flatTree.getLeafNodeID( leafIndex );
+    }else{
+        if( !tree->predict_( inputVector, regressionData ) ){
+            Regressifier::errorLog << "predict_(VectorFloat &inputVector) - Failed to predict!" << std::endl;
+            return false;
+        }
+        predictedNodeID = tree->getPredictedNodeID();
     }
     
     return true;
@@ -196,6 +225,9 @@ bool RegressionTree::clear(){
         delete tree;
         tree = NULL;
     }
+    flatTree.clear();
+    flatTreeBuilt = false;
+    predictedNodeID = 0;
     
     return true;
 }
@@ -371,12 +403,7 @@ UINT RegressionTree::getMaxDepth()const{
 }
 
 UINT RegressionTree::getPredictedNodeID()const{
-    
-    if( tree == NULL ){
-        return 0;
-    }
-    
-    return tree->getPredictedNodeID();
+    return predictedNodeID;
 }
 
 bool RegressionTree::getRemoveFeaturesAtEachSpilt() const{
@@ -429,12 +456,10 @@ bool RegressionTree::setMinRMSErrorPerNode(const Float minRMSErrorPerNode){
     return true;
 }
 
-RegressionTreeNode* RegressionTree::buildTree(const RegressionData &trainingData,RegressionTreeNode *parent,Vector< UINT > features,UINT nodeID){
+RegressionTreeNode* RegressionTree::buildTree(RegressionTreeTrainingData &trainingData,const UINT startIndex,const UINT endIndex,RegressionTreeNode *parent,Vector< UINT > features,UINT nodeID){
     
-    const UINT M = trainingData.getNumSamples();
-    const UINT N = trainingData.getNumInputDimensions();
-    const UINT T = trainingData.getNumTargetDimensions();
-    VectorFloat regressionData(T);
+    const UINT M = endIndex - startIndex;
+    VectorFloat regressionData;
     
     //Update the nodeID
     
@@ -445,7 +470,7 @@ RegressionTreeNode* RegressionTree::buildTree(const RegressionData &trainingData
     depth = parent->getDepth() + 1;
     
     //If there are no training data then return NULL
-    if( trainingData.getNumSamples() == 0 )
+    if( M == 0 )
     return NULL;
     
     //Create the new node
@@ -457,19 +482,20 @@ RegressionTreeNode* RegressionTree::buildTree(const RegressionData &trainingData
     //Set the parent
     node->initNode( parent, depth, nodeID );
     
+    //Compute the regression data that will be stored at this node
+    computeNodeRegressionData( trainingData, startIndex, endIndex, regressionData );
+    
     //If there are no features left then create a leaf node and return
     if( features.size() == 0 || M < minNumSamplesPerNode || depth >= maxDepth ){
         
         //Flag that this is a leaf node
         node->setIsLeafNode( true );
         
-        //Compute the regression data that will be stored at this node
-        computeNodeRegressionData( trainingData, regressionData );
+        //Set the node and release its histogram, if one was computed
+        node->set( M, 0, 0, regressionData );
+        trainingData.releaseHistogram( startIndex, endIndex );
         
-        //Set the node
-        node->set( trainingData.getNumSamples(), 0, 0, regressionData );
-        
-        Regressifier::trainingLog << "Reached leaf node. Depth: " << depth << " NumSamples: " << trainingData.getNumSamples() << std::endl;
+        Regressifier::trainingLog << "Reached leaf node. Depth: " << depth << " NumSamples: " << M << std::endl;
         
         return node;
     }
@@ -478,7 +504,8 @@ RegressionTreeNode* RegressionTree::buildTree(const RegressionData &trainingData
     UINT featureIndex = 0;
     Float threshold = 0;
     Float minError = 0;
-    if( !computeBestSpilt( trainingData, features, featureIndex, threshold, minError ) ){
+    if( !computeBestSpilt( trainingData, startIndex, endIndex, features, featureIndex, threshold, minError ) ){
+        trainingData.releaseHistogram( startIndex, endIndex );
         delete node;
         return NULL;
     }
@@ -487,11 +514,10 @@ RegressionTreeNode* RegressionTree::buildTree(const RegressionData &trainingData
     
     //If the minError is below the minRMSError then create a leaf node and return
     if( minError <= minRMSErrorPerNode ){
-        //Compute the regression data that will be stored at this node
-        computeNodeRegressionData( trainingData, regressionData );
-        
         //Set the node
-        node->set( trainingData.getNumSamples(), featureIndex, threshold, regressionData );
+        node->setIsLeafNode( true );
+        node->set( M, featureIndex, threshold, regressionData );
+        trainingData.releaseHistogram( startIndex, endIndex );
         
         trainingLog << "Reached leaf node. Depth: " << depth << " NumSamples: " << M << std::endl;
         
@@ -499,7 +525,22 @@ RegressionTreeNode* RegressionTree::buildTree(const RegressionData &trainingData
     }
     
     //Set the node
-    node->set( trainingData.getNumSamples(), featureIndex, threshold, regressionData );
+    node->set( M, featureIndex, threshold, regressionData );
+    
+    //Split the data into a left and right range, the samples are partitioned in place so no data is copied (the node histogram is split with them)
+    const UINT splitIndex = trainingData.partition( startIndex, endIndex, [&](const UINT sampleIndex){
+        return trainingData.getValue( sampleIndex, featureIndex ) >= threshold;
+    } );
+    
+    //If the split did not separate the samples then the node can not be split any further, so create a leaf node and return
+    if( splitIndex == startIndex || splitIndex == endIndex ){
+        node->setIsLeafNode( true );
+        trainingData.releaseHistogram( startIndex, endIndex );
+        
+        trainingLog << "Reached leaf node, no valid split. Depth: " << depth << " NumSamples: " << M << std::endl;
+        
+        return node;
+    }
     
     //Remove the selected feature so we will not use it again
     if( removeFeaturesAtEachSpilt ){
@@ -511,32 +552,25 @@ RegressionTreeNode* RegressionTree::buildTree(const RegressionData &trainingData
         }
     }
     
-    //Split the data
-    RegressionData lhs(N,T);
-    RegressionData rhs(N,T);
-    
-    for(UINT i=0; i<M; i++){
-        if( node->predict( trainingData[i].getInputVector() ) ){
-            rhs.addSample(trainingData[i].getInputVector(), trainingData[i].getTargetVector());
-        }else lhs.addSample(trainingData[i].getInputVector(), trainingData[i].getTargetVector());
-    }
-    
     //Run the recursive tree building on the children
-    node->setLeftChild( buildTree( lhs, node, features, nodeID ) );
-    node->setRightChild( buildTree( rhs, node, features, nodeID ) );
+    node->setLeftChild( buildTree( trainingData, startIndex, splitIndex, node, features, nodeID ) );
+    node->setRightChild( buildTree( trainingData, splitIndex, endIndex, node, features, nodeID ) );
     
     return node;
 }
 
-bool RegressionTree::computeBestSpilt( const RegressionData &trainingData, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError ){
+bool RegressionTree::computeBestSpilt( RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError ){
     
     switch( trainingMode ){
         case Tree::BEST_ITERATIVE_SPILT:
-        return computeBestSpiltBestIterativeSpilt( trainingData, features, featureIndex, threshold, minError );
+        return computeBestSpiltBestIterativeSpilt( trainingData, startIndex, endIndex, features, featureIndex, threshold, minError );
         break;
         case Tree::BEST_RANDOM_SPLIT:
         //return computeBestSpiltBestRandomSpilt( trainingData, features, featureIndex, threshold, minError );
         break;
+        case Tree::BEST_HISTOGRAM_SPLIT:
+        return computeBestSpiltBestHistogramSpilt( trainingData, startIndex, endIndex, features, featureIndex, threshold, minError );
+        break;
         default:
         Regressifier::errorLog << "Uknown trainingMode!" << std::endl;
         return false;
@@ -546,10 +580,11 @@ bool RegressionTree::computeBestSpilt( const RegressionData &trainingData, const
     return false;
 }
 
-bool RegressionTree::computeBestSpiltBestIterativeSpilt( const RegressionData &trainingData, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError ){
+bool RegressionTree::computeBestSpiltBestIterativeSpilt( const RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError ){
     
-    const UINT M = trainingData.getNumSamples();
+    const UINT M = endIndex - startIndex;
     const UINT N = (UINT)features.size();
+    const Vector< UINT > &indexs = trainingData.getIndexs();
     
     if( N == 0 ) return false;
     
@@ -561,16 +596,17 @@ bool RegressionTree::computeBestSpiltBestIterativeSpilt( const RegressionData &t
     Float minRange = 0;
     Float maxRange = 0;
     Float step = 0;
+    MinMax range;
     Vector< UINT > groupIndex(M);
     VectorFloat groupCounter(2,0);
     VectorFloat groupMean(2,0);
     VectorFloat groupMSE(2,0);
-    Vector< MinMax > ranges = trainingData.getInputRanges();
     
     //Loop over each feature and try and find the best split point
     for(UINT n=0; n<N; n++){
-        minRange = ranges[n].minValue;
-        maxRange = ranges[n].maxValue;
+        range = trainingData.getRange( n, startIndex, endIndex );
+        minRange = range.minValue;
+        maxRange = range.maxValue;
         step = (maxRange-minRange)/Float(numSplittingSteps);
         threshold = minRange;
         featureIndex = features[n];
@@ -578,9 +614,9 @@ bool RegressionTree::computeBestSpiltBestIterativeSpilt( const RegressionData &t
             
             //Iterate over each sample and work out what group it falls into
             for(UINT i=0; i<M; i++){
-                groupID = trainingData[i].getInputVector()[featureIndex] >= threshold ? 1 : 0;
+                groupID = trainingData.getValue( indexs[startIndex+i], featureIndex ) >= threshold ? 1 : 0;
                 groupIndex[i] = groupID;
-                groupMean[ groupID ] += trainingData[i].getInputVector()[featureIndex];
+                groupMean[ groupID ] += trainingData.getValue( indexs[startIndex+i], featureIndex );
                 groupCounter[ groupID ]++;
             }
             groupMean[0] /= groupCounter[0] > 0 ? groupCounter[0] : 1;
@@ -588,7 +624,7 @@ bool RegressionTree::computeBestSpiltBestIterativeSpilt( const RegressionData &t
             
             //Compute the MSE for each group
             for(UINT i=0; i<M; i++){
-                groupMSE[ groupIndex[i] ] += grt_sqr( groupMean[ groupIndex[i] ] - trainingData[ i ].getInputVector()[features[n]] );
+                groupMSE[ groupIndex[i] ] += grt_sqr( groupMean[ groupIndex[i] ] - trainingData.getValue( indexs[startIndex+i], features[n] ) );
             }
             groupMSE[0] /= groupCounter[0] > 0 ? groupCounter[0] : 1;
             groupMSE[1] /= groupCounter[1] > 0 ? groupCounter[1] : 1;
@@ -603,6 +639,7 @@ bool RegressionTree::computeBestSpiltBestIterativeSpilt( const RegressionData &t
             }
             
             //Update the threshold
+            if( step <= 0 ) break;
             threshold += step;
         }
     }
@@ -614,6 +651,76 @@ bool RegressionTree::computeBestSpiltBestIterativeSpilt( const RegressionData &t
     return true;
 }
 
+bool RegressionTree::computeBestSpiltBestHistogramSpilt( RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError ){
+    
+    const UINT M = endIndex - startIndex;
+    const UINT N = (UINT)features.size();
+    const UINT T = trainingData.getNumTargetDimensions();
+    
+    if( N == 0 ) return false;
+    
+    //Get the histogram of this node, each entry holds the number of samples in a bin, the sum of their targets and the sum of their squared targets
+    const VectorFloat &histogram = trainingData.getHistogram( startIndex, endIndex );
+    const UINT stride = trainingData.getHistogramStride();
+    const UINT maxNumBins = trainingData.getMaxNumBins();
+    
+    //Sum the histogram of the first feature to get the statistics of the whole node
+    VectorFloat nodeStats( stride, 0 );
+    for(UINT b=0; b<trainingData.getNumBins( features[0] ); b++){
+        const Float *entry = &histogram[ (features[0]*maxNumBins + b)*stride ];
+        for(UINT s=0; s<stride; s++){
+            nodeStats[s] += entry[s];
+        }
+    }
+    
+    minError = grt_numeric_limits< Float >::max();
+    UINT bestFeatureIndex = 0;
+    Float bestThreshold = 0;
+    Float error = 0;
+    VectorFloat statsL( stride );
+    VectorFloat statsR( stride );
+    
+    //Loop over each feature and test a split between each pair of neighbouring bins, the lhs group is every bin below the split
+    for(UINT n=0; n<N; n++){
+        featureIndex = features[n];
+        const UINT numBins = trainingData.getNumBins( featureIndex );
+        const Float *featureHistogram = &histogram[ featureIndex*maxNumBins*stride ];
+        
+        std::fill( statsL.begin(), statsL.end(), 0 );
+        for(UINT b=1; b<numBins; b++){
+            const Float *entry = featureHistogram + (b-1)*stride;
+            if( entry[0] == 0 ) continue;
+            for(UINT s=0; s<stride; s++){
+                statsL[s] += entry[s];
+                statsR[s] = nodeStats[s] - statsL[s];
+            }
+            if( statsR[0] <= 0 ) break;
+            
+            //The error is the RMS error of the targets when each group is predicted by its mean target
+            error = sqrt( (trainingData.computeSumSquaredError( statsL[0], &statsL[1], statsL[T+1] ) +
+                           trainingData.computeSumSquaredError( statsR[0], &statsR[1], statsR[T+1] )) / M );
+            
+            //Store the best threshold and feature index
+            if( error < minError ){
+                minError = error;
+                bestThreshold = trainingData.getBinThreshold( featureIndex, b );
+                bestFeatureIndex = featureIndex;
+            }
+        }
+    }
+    
+    //If all the samples share a bin for every feature then the bins can not split the node, so run the exact search over the samples instead
+    if( minError == grt_numeric_limits< Float >::max() ){
+        return computeBestSpiltBestIterativeSpilt( trainingData, startIndex, endIndex, features, featureIndex, threshold, minError );
+    }
+    
+    //Set the best feature index and threshold
+    featureIndex = bestFeatureIndex;
+    threshold = bestThreshold;
+    
+    return true;
+}
+
 /*
 bool RegressionTree::computeBestSpiltBestRandomSpilt( const RegressionData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &threshold, Float &minError ){
 
@@ -686,30 +793,32 @@ return true;
 
 */
 
-//Compute the regression data that will be stored at this node
-bool RegressionTree::computeNodeRegressionData( const RegressionData &trainingData, VectorFloat &regressionData ){
+bool RegressionTree::buildFlatTree(){
     
-    const UINT M = trainingData.getNumSamples();
-    const UINT N = trainingData.getNumInputDimensions();
-    const UINT T = trainingData.getNumTargetDimensions();
+    flatTreeBuilt = true;
     
-    if( M == 0 ){
-        Regressifier::errorLog << "computeNodeRegressionData(...) - Failed to compute regression data, there are zero training samples!" << std::endl;
+    if( tree == NULL ) return false;
+    
+    if( !flatTree.init( numOutputDimensions ) || !flatTree.addTree( tree ) ){
+        flatTree.clear();
+        Regressifier::warningLog << "buildFlatTree() - Failed to flatten the tree, the tree will be run node by node!" << std::endl;
         return false;
     }
     
-    //Make sure the regression data is the correct size
-    regressionData.clear();
-    regressionData.resize( T, 0 );
+    return true;
+}
+
+//Compute the regression data that will be stored at this node
+bool RegressionTree::computeNodeRegressionData( const RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, VectorFloat &regressionData ){
     
-    //The regression data at this node is simply an average over all the training data at this node
-    for(unsigned int j=0; j<N; j++){
-        for(unsigned int i=0; i<M; i++){
-            regressionData[j] += trainingData[i].getTargetVector()[j];
-        }
-        regressionData[j] /= M;
+    if( endIndex <= startIndex ){
+        Regressifier::errorLog << "computeNodeRegressionData(...) - Failed to compute regression data, there are zero training samples!" << std::endl;
+        return false;
     }
     
+    //The regression data at this node is simply an average over all the training data at this node
+    regressionData = trainingData.getTargetMean( startIndex, endIndex );
+    
     return true;
 }
 
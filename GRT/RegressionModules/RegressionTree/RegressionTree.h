@@ -29,6 +29,7 @@
 #include "../../CoreModules/Regressifier.h"
 #include "../../CoreAlgorithms/Tree/Tree.h"
 #include "RegressionTreeNode.h"
+#include "RegressionTreeTrainingData.h"
 
 GRT_BEGIN_NAMESPACE
 
@@ -168,6 +169,8 @@ public:
     
     If the trainingMode is set to BEST_ITERATIVE_SPILT, then the numSplittingSteps controls how many iterative steps there will be per feature.
     If the trainingMode is set to BEST_RANDOM_SPLIT, then the numSplittingSteps controls how many random searches there will be per feature.
+    If the trainingMode is set to BEST_HISTOGRAM_SPLIT, then the numSplittingSteps controls the maximum number of bins each feature is quantised into, this should be in the range [2 65535].
+    The histogram search scores each split by the RMS error of the targets on either side of the split, and this is the error that is compared against the minRMSErrorPerNode.
     
     @return returns the number of steps that will be used to search for the best spliting value for each node
     */
@@ -215,6 +218,8 @@ public:
     
     If the trainingMode is set to BEST_ITERATIVE_SPILT, then the numSplittingSteps controls how many iterative steps there will be per feature.
     If the trainingMode is set to BEST_RANDOM_SPLIT, then the numSplittingSteps controls how many random searches there will be per feature.
+    If the trainingMode is set to BEST_HISTOGRAM_SPLIT, then the numSplittingSteps controls the maximum number of bins each feature is quantised into, this should be in the range [2 65535].
+    The histogram search scores each split by the RMS error of the targets on either side of the split, and this is the error that is compared against the minRMSErrorPerNode.
     
     A higher value will increase the chances of building a better model, but will take longer to train the model.
     Value must be larger than zero.
@@ -276,6 +281,9 @@ public:
     
 protected:
     Node *tree; 
+    FlatForest flatTree;
+    bool flatTreeBuilt;
+    UINT predictedNodeID;
     UINT minNumSamplesPerNode;
     UINT maxDepth;
     UINT numSplittingSteps;
@@ -283,11 +291,13 @@ protected:
     Tree::TrainingMode trainingMode;
     Float minRMSErrorPerNode;
     
-    RegressionTreeNode* buildTree( const RegressionData &trainingData, RegressionTreeNode *parent, Vector< UINT > features, UINT nodeID );
-    bool computeBestSpilt( const RegressionData &trainingData, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError );
-    bool computeBestSpiltBestIterativeSpilt( const RegressionData &trainingData, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError );
+    RegressionTreeNode* buildTree( RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, RegressionTreeNode *parent, Vector< UINT > features, UINT nodeID );
+    bool computeBestSpilt( RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError );
+    bool computeBestSpiltBestIterativeSpilt( const RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError );
+    bool computeBestSpiltBestHistogramSpilt( RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, const Vector< UINT > &features, UINT &featureIndex, Float &threshold, Float &minError );
     //bool computeBestSpiltBestRandomSpilt( const RegressionData &trainingData, const Vector< UINT > &features, const Vector< UINT > &classLabels, UINT &featureIndex, Float &threshold, Float &minError );
-    bool computeNodeRegressionData( const RegressionData &trainingData, VectorFloat &regressionData );
+    bool computeNodeRegressionData( const RegressionTreeTrainingData &trainingData, const UINT startIndex, const UINT endIndex, VectorFloat &regressionData );
+    bool buildFlatTree();
 
 private:
     static RegisterRegressifierModule< RegressionTree > registerModule;
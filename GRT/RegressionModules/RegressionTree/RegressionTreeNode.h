@@ -103,6 +103,20 @@ public:
         return false;
     }
     
+    /**
+     This function writes this node into a FlatForest, as a leaf holding the regression data of the node if isLeaf is true,
+     otherwise as a threshold split on the feature index and threshold of the node.
+     
+     @param flatForest: the flat forest the node will be written to
+     @param flatNodeIndex: the index of the node in the flat forest
+     @param isLeaf: if true, the node is written as a leaf
+     @return returns true if the node was written, false otherwise
+     */
+    virtual bool flatten( FlatForest &flatForest, const UINT flatNodeIndex, const bool isLeaf ) const override{
+        if( isLeaf ) return flatForest.setLeaf( flatNodeIndex, regressionData, nodeID );
+        return flatForest.setThresholdSplit( flatNodeIndex, featureIndex, threshold );
+    }
+    
     /**
      This functions cleans up any dynamic memory assigned by the node.
      It will recursively clear the memory for the left and right child nodes.
@@ -0,0 +1,101 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "RegressionTreeTrainingData.h"
+
+GRT_BEGIN_NAMESPACE
+
+RegressionTreeTrainingData::RegressionTreeTrainingData(){
+    numTargetDimensions = 0;
+}
+
+RegressionTreeTrainingData::~RegressionTreeTrainingData(){
+}
+
+bool RegressionTreeTrainingData::set( const RegressionData &trainingData ){
+
+    clear();
+
+    const UINT T = trainingData.getNumTargetDimensions();
+    if( T == 0 ) return false;
+
+    //The statistics of each sample are its targets followed by the sum of its squared targets
+    if( !resize( trainingData.getNumSamples(), trainingData.getNumInputDimensions(), T+1 ) ) return false;
+    numTargetDimensions = T;
+
+    //Transpose the data so the values of each feature are contiguous
+    for(UINT i=0; i<numSamples; i++){
+        const VectorFloat &inputVector = trainingData[i].getInputVector();
+        const VectorFloat &targetVector = trainingData[i].getTargetVector();
+        for(UINT j=0; j<numDimensions; j++){
+            data[j][i] = inputVector[j];
+        }
+
+        Float *stats = sampleStats[i];
+        stats[T] = 0;
+        for(UINT t=0; t<T; t++){
+            stats[t] = targetVector[t];
+            stats[T] += targetVector[t] * targetVector[t];
+        }
+    }
+
+    return true;
+}
+
+bool RegressionTreeTrainingData::clear(){
+    TreeTrainingData::clear();
+    numTargetDimensions = 0;
+    return true;
+}
+
+VectorFloat RegressionTreeTrainingData::getTargetMean( const UINT startIndex, const UINT endIndex ) const{
+
+    VectorFloat mean( numTargetDimensions, 0 );
+
+    if( endIndex <= startIndex ) return mean;
+
+    for(UINT i=startIndex; i<endIndex; i++){
+        const Float *stats = sampleStats[ indexs[i] ];
+        for(UINT t=0; t<numTargetDimensions; t++){
+            mean[t] += stats[t];
+        }
+    }
+    for(UINT t=0; t<numTargetDimensions; t++){
+        mean[t] /= Float(endIndex-startIndex);
+    }
+
+    return mean;
+}
+
+Float RegressionTreeTrainingData::computeSumSquaredError( const Float numSamples, const Float *sumTargets, const Float sumSquaredTargets ) const{
+
+    if( numSamples <= 0 ) return 0;
+
+    //sum((y-mean)^2) = sum(y^2) - sum(y)^2/n, clamped at zero to remove any rounding error
+    Float sse = sumSquaredTargets;
+    for(UINT t=0; t<numTargetDimensions; t++){
+        sse -= sumTargets[t] * sumTargets[t] / numSamples;
+    }
+
+    return sse > 0 ? sse : 0;
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,111 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+
+ @brief This class implements the RegressionTreeTrainingData, the training data store used to build a RegressionTree.
+ */
+
+/**
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_REGRESSION_TREE_TRAINING_DATA_HEADER
+#define GRT_REGRESSION_TREE_TRAINING_DATA_HEADER
+
+#include "../../DataStructures/RegressionData.h"
+#include "../../CoreAlgorithms/Tree/TreeTrainingData.h"
+
+GRT_BEGIN_NAMESPACE
+
+/**
+ @brief This class holds the training data used to build a RegressionTree.
+
+ The statistics of each sample are its target Vector followed by the sum of its squared targets, so the histogram of a node
+ holds the sums and sums of squares of the targets in each bin, which is everything needed to compute the squared error of
+ the targets on either side of a split between two bins. See TreeTrainingData for how the samples are stored and partitioned.
+*/
+class GRT_API RegressionTreeTrainingData : public TreeTrainingData{
+public:
+    /**
+     Default Constructor.
+     */
+    RegressionTreeTrainingData();
+
+    /**
+     Default Destructor.
+     */
+    virtual ~RegressionTreeTrainingData();
+
+    /**
+     Copies the training data into the column-major store and resets the sample index permutation.
+
+     @param trainingData: the data that will be copied
+     @return returns true if the data was set, false otherwise
+     */
+    bool set( const RegressionData &trainingData );
+
+    /**
+     Clears the store.
+
+     @return returns true if the store was cleared, false otherwise
+     */
+    virtual bool clear();
+
+    /**
+     @return returns the number of target dimensions
+     */
+    UINT getNumTargetDimensions() const{ return numTargetDimensions; }
+
+    /**
+     @param sampleIndex: the index of the sample in the original dataset
+     @param targetIndex: the index of the target dimension
+     @return returns the target value for that sample
+     */
+    Float getTarget( const UINT sampleIndex, const UINT targetIndex ) const{ return sampleStats[ sampleIndex ][ targetIndex ]; }
+
+    /**
+     @param sampleIndex: the index of the sample in the original dataset
+     @return returns the sum of the squared targets of that sample
+     */
+    Float getSumSquaredTargets( const UINT sampleIndex ) const{ return sampleStats[ sampleIndex ][ numTargetDimensions ]; }
+
+    /**
+     Computes the sum of the squared errors between the targets of a group of samples and the mean target of the group.
+
+     @param numSamples: the number of samples in the group
+     @param sumTargets: the sum of the targets of the group, this should point to getNumTargetDimensions() values
+     @param sumSquaredTargets: the sum of the squared targets of the group
+     @return returns the sum of the squared errors of the group
+     */
+    Float computeSumSquaredError( const Float numSamples, const Float *sumTargets, const Float sumSquaredTargets ) const;
+
+    /**
+     @param startIndex: the start of the range
+     @param endIndex: the end of the range (not inclusive)
+     @return returns the mean target Vector of the samples in the range [startIndex endIndex) of the index permutation
+     */
+    VectorFloat getTargetMean( const UINT startIndex, const UINT endIndex ) const;
+
+protected:
+    UINT numTargetDimensions;
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_REGRESSION_TREE_TRAINING_DATA_HEADER
@@ -0,0 +1,382 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "BinaryDataFile.h"
+#include <cstring>
+#include <stdint.h>
+
+#if defined(__GRT_OSX_BUILD__) || defined(__GRT_LINUX_BUILD__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+GRT_BEGIN_NAMESPACE
+
+const UINT BinaryDataFile::FILE_VERSION = 1;
+
+//The magic string at the start of every binary data file, this is padded with zeros to 8 bytes
+static const char BINARY_DATA_FILE_MAGIC[8] = {'G','R','T','B','I','N','\0','\0'};
+
+//The number of values converted at a time when reading or writing a block that is not a straight copy
+static const size_t BLOCK_CHUNK_SIZE = 4096;
+
+static bool isLittleEndian(){
+    const uint16_t value = 1;
+    return *reinterpret_cast< const unsigned char* >( &value ) == 1;
+}
+
+//Reverses the byte order of a value if this machine is big-endian, the file is always little-endian
+template< class T > static T toLittleEndian(T value){
+    if( !isLittleEndian() ){
+        unsigned char *bytes = reinterpret_cast< unsigned char* >( &value );
+        for(size_t i=0; i<sizeof(T)/2; i++) std::swap( bytes[i], bytes[sizeof(T)-1-i] );
+    }
+    return value;
+}
+
+BinaryDataFile::BinaryDataFile() : errorLog("[ERROR BinaryDataFile]"){
+    writing = false;
+    reading = false;
+    mappedData = NULL;
+    fileSize = 0;
+    position = 0;
+}
+
+BinaryDataFile::~BinaryDataFile(){
+    close();
+}
+
+bool BinaryDataFile::openForWriting(const std::string &filename,const std::string &datasetType){
+
+    close();
+
+    file.open( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if( !file.is_open() ){
+        errorLog << "openForWriting(const std::string &filename,const std::string &datasetType) - Failed to open file: " << filename << std::endl;
+        return false;
+    }
+    writing = true;
+    position = 0;
+
+    if( !writeBytes( BINARY_DATA_FILE_MAGIC, sizeof(BINARY_DATA_FILE_MAGIC) ) || !writeUINT( FILE_VERSION ) || !writeString( datasetType ) ){
+        errorLog << "openForWriting(const std::string &filename,const std::string &datasetType) - Failed to write file header!" << std::endl;
+        close();
+        return false;
+    }
+    this->datasetType = datasetType;
+
+    return true;
+}
+
+bool BinaryDataFile::openForReading(const std::string &filename,const std::string &datasetType){
+
+    close();
+
+    //Try and map the file, if this fails then fall back to reading it as a stream
+    if( !mapFile( filename ) ){
+        file.open( filename.c_str(), std::ios::in | std::ios::binary );
+        if( !file.is_open() ){
+            errorLog << "openForReading(const std::string &filename,const std::string &datasetType) - Failed to open file: " << filename << std::endl;
+            return false;
+        }
+        file.seekg( 0, std::ios::end );
+        fileSize = (unsigned long long)file.tellg();
+        file.seekg( 0, std::ios::beg );
+    }
+    reading = true;
+    position = 0;
+
+    char magic[ sizeof(BINARY_DATA_FILE_MAGIC) ];
+    UINT version = 0;
+    std::string type;
+    if( !readBytes( magic, sizeof(magic) ) || memcmp( magic, BINARY_DATA_FILE_MAGIC, sizeof(magic) ) != 0 ){
+        errorLog << "openForReading(const std::string &filename,const std::string &datasetType) - The file is not a binary data file!" << std::endl;
+        close();
+        return false;
+    }
+
+    if( !readUINT( version ) || version == 0 || version > FILE_VERSION ){
+        errorLog << "openForReading(const std::string &filename,const std::string &datasetType) - Unsupported file version: " << version << std::endl;
+        close();
+        return false;
+    }
+
+    if( !readString( type ) || (datasetType != "" && type != datasetType) ){
+        errorLog << "openForReading(const std::string &filename,const std::string &datasetType) - The file contains a " << type << ", expected a " << datasetType << std::endl;
+        close();
+        return false;
+    }
+    this->datasetType = type;
+
+    return true;
+}
+
+bool BinaryDataFile::close(){
+
+    bool ok = true;
+    if( writing ){
+        file.flush();
+        ok = !file.fail();
+    }
+    if( file.is_open() ) file.close();
+    unmapFile();
+
+    writing = false;
+    reading = false;
+    fileSize = 0;
+    position = 0;
+    datasetType = "";
+
+    return ok;
+}
+
+bool BinaryDataFile::getIsOpen() const { return writing || reading; }
+
+bool BinaryDataFile::getIsMemoryMapped() const { return reading && mappedData != NULL; }
+
+bool BinaryDataFile::writeUINT(const UINT value){
+    const uint32_t x = toLittleEndian< uint32_t >( value );
+    return writeBytes( &x, sizeof(x) );
+}
+
+bool BinaryDataFile::writeUINT64(const unsigned long long value){
+    const uint64_t x = toLittleEndian< uint64_t >( value );
+    return writeBytes( &x, sizeof(x) );
+}
+
+bool BinaryDataFile::writeFloat(const Float value){
+    return writeFloatBlock( &value, 1, sizeof(double) );
+}
+
+bool BinaryDataFile::writeString(const std::string &value){
+    if( !writeUINT( (UINT)value.size() ) ) return false;
+    return writeBytes( value.data(), value.size() );
+}
+
+bool BinaryDataFile::writeFloatBlock(const Float *data,const size_t size,const UINT floatSize){
+
+    if( floatSize != sizeof(double) && floatSize != sizeof(float) ) return false;
+
+    //If the values are already stored in the file format then they can be written directly
+    if( floatSize == sizeof(Float) && isLittleEndian() ){
+        return writeBytes( data, size*sizeof(Float) );
+    }
+
+    char buffer[ BLOCK_CHUNK_SIZE*sizeof(double) ];
+    size_t i = 0;
+    while( i < size ){
+        const size_t n = std::min( BLOCK_CHUNK_SIZE, size-i );
+        for(size_t k=0; k<n; k++){
+            if( floatSize == sizeof(double) ){
+                const double x = toLittleEndian< double >( (double)data[i+k] );
+                memcpy( buffer + k*sizeof(double), &x, sizeof(double) );
+            }else{
+                const float x = toLittleEndian< float >( (float)data[i+k] );
+                memcpy( buffer + k*sizeof(float), &x, sizeof(float) );
+            }
+        }
+        if( !writeBytes( buffer, n*floatSize ) ) return false;
+        i += n;
+    }
+    return true;
+}
+
+bool BinaryDataFile::writeUINTBlock(const UINT *data,const size_t size){
+
+    if( sizeof(UINT) == sizeof(uint32_t) && isLittleEndian() ){
+        return writeBytes( data, size*sizeof(UINT) );
+    }
+
+    for(size_t i=0; i<size; i++){
+        if( !writeUINT( data[i] ) ) return false;
+    }
+    return true;
+}
+
+bool BinaryDataFile::readUINT(UINT &value){
+    uint32_t x = 0;
+    if( !readBytes( &x, sizeof(x) ) ) return false;
+    value = (UINT)toLittleEndian< uint32_t >( x );
+    return true;
+}
+
+bool BinaryDataFile::readUINT64(unsigned long long &value){
+    uint64_t x = 0;
+    if( !readBytes( &x, sizeof(x) ) ) return false;
+    value = (unsigned long long)toLittleEndian< uint64_t >( x );
+    return true;
+}
+
+bool BinaryDataFile::readFloat(Float &value){
+    return readFloatBlock( &value, 1, sizeof(double) );
+}
+
+bool BinaryDataFile::readString(std::string &value){
+    UINT size = 0;
+    if( !readUINT( size ) || size > getNumBytesRemaining() ) return false;
+    value.resize( size );
+    if( size == 0 ) return true;
+    return readBytes( &value[0], size );
+}
+
+bool BinaryDataFile::readFloatBlock(Float *data,const size_t size,const UINT floatSize){
+
+    if( floatSize != sizeof(double) && floatSize != sizeof(float) ) return false;
+    if( (unsigned long long)size*floatSize > getNumBytesRemaining() ) return false;
+
+    if( floatSize == sizeof(Float) && isLittleEndian() ){
+        return readBytes( data, size*sizeof(Float) );
+    }
+
+    char buffer[ BLOCK_CHUNK_SIZE*sizeof(double) ];
+    size_t i = 0;
+    while( i < size ){
+        const size_t n = std::min( BLOCK_CHUNK_SIZE, size-i );
+        if( !readBytes( buffer, n*floatSize ) ) return false;
+        for(size_t k=0; k<n; k++){
+            if( floatSize == sizeof(double) ){
+                double x;
+                memcpy( &x, buffer + k*sizeof(double), sizeof(double) );
+                data[i+k] = (Float)toLittleEndian< double >( x );
+            }else{
+                float x;
+                memcpy( &x, buffer + k*sizeof(float), sizeof(float) );
+                data[i+k] = (Float)toLittleEndian< float >( x );
+            }
+        }
+        i += n;
+    }
+    return true;
+}
+
+bool BinaryDataFile::readUINTBlock(UINT *data,const size_t size){
+
+    if( (unsigned long long)size*sizeof(uint32_t) > getNumBytesRemaining() ) return false;
+
+    if( sizeof(UINT) == sizeof(uint32_t) && isLittleEndian() ){
+        return readBytes( data, size*sizeof(UINT) );
+    }
+
+    for(size_t i=0; i<size; i++){
+        if( !readUINT( data[i] ) ) return false;
+    }
+    return true;
+}
+
+bool BinaryDataFile::alignBlock(){
+    const size_t padding = (size_t)( (8 - (position % 8)) % 8 );
+    if( padding == 0 ) return true;
+    char zeros[8] = {0,0,0,0,0,0,0,0};
+    if( writing ) return writeBytes( zeros, padding );
+    if( reading ) return readBytes( zeros, padding );
+    return false;
+}
+
+unsigned long long BinaryDataFile::getNumBytesRemaining() const{
+    if( !reading || position > fileSize ) return 0;
+    return fileSize - position;
+}
+
+bool BinaryDataFile::seek(const unsigned long long offset){
+    if( !reading || offset > fileSize ) return false;
+    if( mappedData == NULL ){
+        file.clear();
+        file.seekg( (std::streamoff)offset, std::ios::beg );
+        if( file.fail() ) return false;
+    }
+    position = offset;
+    return true;
+}
+
+unsigned long long BinaryDataFile::getPosition() const{
+    return position;
+}
+
+std::string BinaryDataFile::getDatasetType() const{
+    return datasetType;
+}
+
+bool BinaryDataFile::isBinaryDataFilename(const std::string &filename){
+    const std::string extension = ".grtb";
+    if( filename.size() < extension.size() ) return false;
+    return filename.compare( filename.size()-extension.size(), extension.size(), extension ) == 0;
+}
+
+bool BinaryDataFile::writeBytes(const void *bytes,const size_t numBytes){
+    if( !writing ) return false;
+    if( numBytes == 0 ) return true;
+    file.write( reinterpret_cast< const char* >( bytes ), numBytes );
+    if( file.fail() ) return false;
+    position += numBytes;
+    return true;
+}
+
+bool BinaryDataFile::readBytes(void *bytes,const size_t numBytes){
+    if( !reading || numBytes > getNumBytesRemaining() ) return false;
+    if( numBytes == 0 ) return true;
+    if( mappedData != NULL ){
+        memcpy( bytes, mappedData + position, numBytes );
+    }else{
+        file.read( reinterpret_cast< char* >( bytes ), numBytes );
+        if( file.fail() ) return false;
+    }
+    position += numBytes;
+    return true;
+}
+
+bool BinaryDataFile::mapFile(const std::string &filename){
+#if defined(__GRT_OSX_BUILD__) || defined(__GRT_LINUX_BUILD__)
+    const int fd = ::open( filename.c_str(), O_RDONLY );
+    if( fd < 0 ) return false;
+
+    struct stat info;
+    if( fstat( fd, &info ) != 0 || info.st_size <= 0 ){
+        ::close( fd );
+        return false;
+    }
+
+    void *data = mmap( NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+    if( data == MAP_FAILED ) return false;
+
+    //The file is read from start to finish, so let the kernel read ahead
+    madvise( data, (size_t)info.st_size, MADV_SEQUENTIAL );
+
+    mappedData = reinterpret_cast< const char* >( data );
+    fileSize = (unsigned long long)info.st_size;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void BinaryDataFile::unmapFile(){
+#if defined(__GRT_OSX_BUILD__) || defined(__GRT_LINUX_BUILD__)
+    if( mappedData != NULL ){
+        munmap( const_cast< char* >( mappedData ), (size_t)fileSize );
+    }
+#endif
+    mappedData = NULL;
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,209 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+
+ @brief The BinaryDataFile class reads and writes the versioned binary container used by the GRT datasets.
+
+ A binary data file starts with an 8 byte magic string and a version number, followed by a string that names the dataset
+ type that wrote it.  Everything after that is written by the dataset itself using the little-endian helpers below, with
+ the bulk sample data stored as contiguous blocks of float64 or float32 values.  Call alignBlock before writing or reading
+ a block so the block starts on an 8 byte boundary within the file.
+
+ When a file is opened for reading it is memory mapped (on OSX and Linux), so loading a block is a single copy straight
+ from the page cache into the destination.  If the file can not be mapped it is read through a normal file stream instead.
+ The mapping is only used while a file is being loaded: the datasets store each sample in its own VectorFloat, so the
+ samples are always copied onto the heap and can not be trained on directly from the mapped file.  A ChunkedDataset keeps the
+ file mapped while it is used and only copies the two chunks it holds in memory, so it should be used to train the mini-batch
+ algorithms on files that are too large to load.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_BINARY_DATA_FILE_HEADER
+#define GRT_BINARY_DATA_FILE_HEADER
+
+#include "GRTTypedefs.h"
+#include "ErrorLog.h"
+#include <fstream>
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API BinaryDataFile{
+public:
+    /**
+     Default Constructor
+     */
+    BinaryDataFile();
+
+    /**
+     Default Destructor, closes the file if it is still open.
+     */
+    ~BinaryDataFile();
+
+    /**
+     Creates a new binary data file and writes the file header.
+
+     @param filename: the name of the file to create
+     @param datasetType: a string identifying the type of dataset that will be written to the file
+     @return true if the file was created, false otherwise
+     */
+    bool openForWriting(const std::string &filename,const std::string &datasetType);
+
+    /**
+     Opens an existing binary data file and checks the file header.
+
+     @param filename: the name of the file to open
+     @param datasetType: the type of dataset that is expected in the file, the file will not be opened if it does not match. If this is empty then any type of dataset will be accepted
+     @return true if the file was opened, false otherwise
+     */
+    bool openForReading(const std::string &filename,const std::string &datasetType);
+
+    /**
+     Closes the file, unmapping it if it was memory mapped.
+
+     @return true if all the data written to the file was flushed successfully, false otherwise
+     */
+    bool close();
+
+    /**
+     @return returns true if the file is open for reading or writing, false otherwise
+     */
+    bool getIsOpen() const;
+
+    /**
+     @return returns true if the file is open for reading and has been memory mapped, false otherwise
+     */
+    bool getIsMemoryMapped() const;
+
+    bool writeUINT(const UINT value);
+    bool writeUINT64(const unsigned long long value);
+    bool writeFloat(const Float value);
+    bool writeString(const std::string &value);
+
+    /**
+     Writes a block of values to the file, either as float64 or as float32 values.
+
+     @param data: a pointer to the values to write
+     @param size: the number of values to write
+     @param floatSize: the size in bytes of each value in the file, must be 4 or 8
+     @return true if the values were written, false otherwise
+     */
+    bool writeFloatBlock(const Float *data,const size_t size,const UINT floatSize);
+
+    /**
+     Writes a block of unsigned 32 bit values to the file.
+
+     @param data: a pointer to the values to write
+     @param size: the number of values to write
+     @return true if the values were written, false otherwise
+     */
+    bool writeUINTBlock(const UINT *data,const size_t size);
+
+    bool readUINT(UINT &value);
+    bool readUINT64(unsigned long long &value);
+    bool readFloat(Float &value);
+    bool readString(std::string &value);
+
+    /**
+     Reads a block of values from the file, converting them from float64 or float32 values.
+
+     @param data: a pointer to the memory the values will be written to, this must have room for size values
+     @param size: the number of values to read
+     @param floatSize: the size in bytes of each value in the file, must be 4 or 8
+     @return true if the values were read, false otherwise
+     */
+    bool readFloatBlock(Float *data,const size_t size,const UINT floatSize);
+
+    /**
+     Reads a block of unsigned 32 bit values from the file.
+
+     @param data: a pointer to the memory the values will be written to, this must have room for size values
+     @param size: the number of values to read
+     @return true if the values were read, false otherwise
+     */
+    bool readUINTBlock(UINT *data,const size_t size);
+
+    /**
+     Pads the file (when writing) or skips the padding (when reading) so the next value starts on an 8 byte boundary.
+
+     @return true if the file position was aligned, false otherwise
+     */
+    bool alignBlock();
+
+    /**
+     Gets the number of bytes that have not been read yet, this can be used to check a block will fit before it is allocated.
+
+     @return returns the number of bytes remaining in the file, or zero if the file is not open for reading
+     */
+    unsigned long long getNumBytesRemaining() const;
+
+    /**
+     Checks if the file extension matches the extension used for binary data files (.grtb).
+
+     @param filename: the filename to check
+     @return true if the filename ends with the binary data file extension, false otherwise
+     */
+    static bool isBinaryDataFilename(const std::string &filename);
+
+    /**
+     Moves the read position to an absolute offset in the file, this can be used to jump straight to a block recorded while reading the header.
+
+     @param offset: the offset in bytes from the start of the file
+     @return true if the read position was moved, false if the file is not open for reading or the offset is past the end of the file
+     */
+    bool seek(const unsigned long long offset);
+
+    /**
+     @return returns the current read or write offset in bytes from the start of the file
+     */
+    unsigned long long getPosition() const;
+
+    /**
+     @return returns the type of dataset stored in the file, this is only valid if the file is open
+     */
+    std::string getDatasetType() const;
+
+    static const UINT FILE_VERSION;
+
+protected:
+    bool writeBytes(const void *bytes,const size_t numBytes);
+    bool readBytes(void *bytes,const size_t numBytes);
+    bool mapFile(const std::string &filename);
+    void unmapFile();
+
+    bool writing;
+    bool reading;
+    std::fstream file;
+    const char *mappedData;
+    unsigned long long fileSize;
+    unsigned long long position;
+    std::string datasetType;
+    ErrorLog errorLog;
+
+private:
+    //A BinaryDataFile owns a file handle and possibly a mapping, so it can not be copied
+    BinaryDataFile(const BinaryDataFile &rhs);
+    BinaryDataFile& operator=(const BinaryDataFile &rhs);
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_BINARY_DATA_FILE_HEADER
@@ -0,0 +1,316 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software 
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial 
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT 
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, 
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#define GRT_DLL_EXPORTS
+#include "CSVReader.h"
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+GRT_BEGIN_NAMESPACE
+
+//The exact powers of ten that can be represented by a double
+static const double CSV_READER_POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline bool isCSVWhitespace(const char c){
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+CSVReader::CSVReader(const char seperator,const size_t bufferSize) : errorLog("[ERROR CSVReader]"){
+    this->seperator = seperator;
+    buffer.resize( bufferSize > 0 ? bufferSize : 1 );
+    bufferStart = 0;
+    bufferEnd = 0;
+    endOfFile = true;
+    error = false;
+    lineNumber = 0;
+}
+
+CSVReader::~CSVReader(){
+    close();
+}
+
+bool CSVReader::open(const std::string &filename){
+
+    close();
+
+    file.open( filename.c_str(), std::ios::in | std::ios::binary );
+    if( !file.is_open() ){
+        errorLog << "open(const std::string &filename) - Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    endOfFile = false;
+    return true;
+}
+
+bool CSVReader::close(){
+    if( file.is_open() ) file.close();
+    bufferStart = 0;
+    bufferEnd = 0;
+    endOfFile = true;
+    error = false;
+    lineNumber = 0;
+    return true;
+}
+
+bool CSVReader::rewind(){
+    if( !file.is_open() ) return false;
+    file.clear();
+    file.seekg( 0, std::ios::beg );
+    bufferStart = 0;
+    bufferEnd = 0;
+    endOfFile = false;
+    error = false;
+    lineNumber = 0;
+    return !file.fail();
+}
+
+bool CSVReader::countRows(UINT &numRows,UINT &numColumns){
+
+    numRows = 0;
+    numColumns = 0;
+    if( !file.is_open() ) return false;
+
+    const char *begin = NULL;
+    const char *end = NULL;
+    while( nextLine( begin, end ) ){
+        if( numRows++ == 0 ){
+            numColumns = 1;
+            for(const char *p=begin; p!=end; ++p){
+                if( *p == seperator ) numColumns++;
+            }
+        }
+    }
+
+    return rewind();
+}
+
+bool CSVReader::readRow(VectorFloat &row){
+
+    error = false;
+    const char *begin = NULL;
+    const char *end = NULL;
+    if( !nextLine( begin, end ) ) return false;
+
+    //Clearing the row keeps its capacity, so after the first row this does not allocate
+    row.clear();
+    const char *cell = begin;
+    Float value = 0;
+    while( true ){
+        const char *cellEnd = cell;
+        while( cellEnd != end && *cellEnd != seperator ) ++cellEnd;
+        if( !parseFloat( cell, cellEnd, value ) ){
+            errorLog << "readRow(VectorFloat &row) - Failed to parse column " << row.getSize() << " on line " << lineNumber << std::endl;
+            error = true;
+            return false;
+        }
+        row.push_back( value );
+        if( cellEnd == end ) break;
+        cell = cellEnd + 1;
+    }
+
+    return true;
+}
+
+bool CSVReader::readRow(Float *row,const UINT numColumns){
+
+    error = false;
+    const char *begin = NULL;
+    const char *end = NULL;
+    if( !nextLine( begin, end ) ) return false;
+
+    const char *cell = begin;
+    UINT column = 0;
+    while( true ){
+        const char *cellEnd = cell;
+        while( cellEnd != end && *cellEnd != seperator ) ++cellEnd;
+        if( column == numColumns ){
+            errorLog << "readRow(Float *row,const UINT numColumns) - Line " << lineNumber << " has more than " << numColumns << " columns!" << std::endl;
+            error = true;
+            return false;
+        }
+        if( !parseFloat( cell, cellEnd, row[column] ) ){
+            errorLog << "readRow(Float *row,const UINT numColumns) - Failed to parse column " << column << " on line " << lineNumber << std::endl;
+            error = true;
+            return false;
+        }
+        column++;
+        if( cellEnd == end ) break;
+        cell = cellEnd + 1;
+    }
+
+    if( column != numColumns ){
+        errorLog << "readRow(Float *row,const UINT numColumns) - Line " << lineNumber << " has " << column << " columns, expected " << numColumns << std::endl;
+        error = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool CSVReader::getIsOpen() const { return file.is_open(); }
+
+bool CSVReader::getError() const { return error; }
+
+UINT CSVReader::getLineNumber() const { return lineNumber; }
+
+bool CSVReader::parseFloat(const char *begin,const char *end,Float &value){
+
+    //Trim any whitespace around the value
+    while( begin != end && isCSVWhitespace( *begin ) ) ++begin;
+    while( end != begin && isCSVWhitespace( *(end-1) ) ) --end;
+    if( begin == end ) return false;
+
+    //Try the fast path, which handles plain decimal numbers such as -12.345e-6
+    const char *p = begin;
+    const bool negative = *p == '-';
+    if( *p == '-' || *p == '+' ) ++p;
+
+    uint64_t mantissa = 0;
+    int numSignificantDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+    bool exact = true;
+
+    while( p != end && *p >= '0' && *p <= '9' ){
+        const int digit = *p++ - '0';
+        anyDigits = true;
+        if( mantissa == 0 && digit == 0 ) continue;
+        if( numSignificantDigits == 19 ){ exact = false; break; }
+        mantissa = mantissa*10 + digit;
+        numSignificantDigits++;
+    }
+    if( exact && p != end && *p == '.' ){
+        ++p;
+        while( p != end && *p >= '0' && *p <= '9' ){
+            const int digit = *p++ - '0';
+            anyDigits = true;
+            if( mantissa == 0 && digit == 0 ){ exponent--; continue; }
+            if( numSignificantDigits == 19 ){ exact = false; break; }
+            mantissa = mantissa*10 + digit;
+            numSignificantDigits++;
+            exponent--;
+        }
+    }
+    if( exact && anyDigits && p != end && (*p == 'e' || *p == 'E') ){
+        ++p;
+        const bool negativeExponent = p != end && *p == '-';
+        if( p != end && (*p == '-' || *p == '+') ) ++p;
+        int e = 0;
+        bool anyExponentDigits = false;
+        while( p != end && *p >= '0' && *p <= '9' && e < 100000 ){
+            e = e*10 + (*p++ - '0');
+            anyExponentDigits = true;
+        }
+        if( !anyExponentDigits ) exact = false;
+        exponent += negativeExponent ? -e : e;
+    }
+
+    //The result is exact if the mantissa and the power of ten can both be represented exactly by a double
+    if( exact && anyDigits && p == end && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22 ){
+        double x = (double)mantissa;
+        if( exponent < 0 ) x /= CSV_READER_POWERS_OF_TEN[ -exponent ];
+        else x *= CSV_READER_POWERS_OF_TEN[ exponent ];
+        value = (Float)( negative ? -x : x );
+        return true;
+    }
+
+    //Otherwise fall back to strtod, which needs a null terminated copy of the value
+    const size_t length = end - begin;
+    char local[64];
+    std::string longValue;
+    const char *str = local;
+    if( length < sizeof(local) ){
+        memcpy( local, begin, length );
+        local[length] = '\0';
+    }else{
+        longValue.assign( begin, end );
+        str = longValue.c_str();
+    }
+    char *parsedEnd = NULL;
+    const double x = strtod( str, &parsedEnd );
+    if( parsedEnd != str + length ) return false;
+    value = (Float)x;
+    return true;
+}
+
+bool CSVReader::nextLine(const char *&begin,const char *&end){
+
+    while( true ){
+        //Look for the end of the next line in the buffer
+        char *start = &buffer[0] + bufferStart;
+        char *last = &buffer[0] + bufferEnd;
+        char *newline = (char*)memchr( start, '\n', last - start );
+
+        if( newline == NULL && !endOfFile ){
+            //The line continues past the end of the buffer, so read more of the file and try again
+            if( !fillBuffer() ) return false;
+            continue;
+        }
+
+        if( newline == NULL && start == last ) return false;
+
+        //At the end of the file the last line may not have a newline character
+        char *lineEnd = newline != NULL ? newline : last;
+        bufferStart = newline != NULL ? (size_t)(newline - &buffer[0]) + 1 : bufferEnd;
+        lineNumber++;
+
+        //Trim the carriage return from Windows line endings and skip empty lines
+        char *trimmedEnd = lineEnd;
+        while( trimmedEnd != start && isCSVWhitespace( *(trimmedEnd-1) ) ) --trimmedEnd;
+        if( trimmedEnd == start ) continue;
+
+        begin = start;
+        end = trimmedEnd;
+        return true;
+    }
+}
+
+bool CSVReader::fillBuffer(){
+
+    //Move the partial line at the end of the buffer to the start of the buffer
+    const size_t remaining = bufferEnd - bufferStart;
+    if( remaining > 0 && bufferStart > 0 ) memmove( &buffer[0], &buffer[0] + bufferStart, remaining );
+    bufferStart = 0;
+    bufferEnd = remaining;
+
+    //If a single line fills the whole buffer then grow the buffer
+    if( bufferEnd == buffer.getSize() ) buffer.resize( buffer.getSize()*2 );
+
+    file.read( &buffer[0] + bufferEnd, buffer.getSize() - bufferEnd );
+    const std::streamsize numRead = file.gcount();
+    bufferEnd += (size_t)numRead;
+
+    if( file.eof() ) endOfFile = true;
+    else if( file.fail() ){
+        errorLog << "fillBuffer() - Failed to read from file!" << std::endl;
+        error = true;
+        endOfFile = true;
+        return false;
+    }
+
+    return true;
+}
+
+GRT_END_NAMESPACE
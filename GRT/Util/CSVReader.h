@@ -0,0 +1,156 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+
+ @brief The CSVReader class reads numeric CSV (or TSV) files one row at a time.
+
+ The file is read in fixed-size chunks and each row is tokenised in place in the read buffer, with each cell parsed straight
+ into the destination row, so the memory used does not depend on the size of the file.  Numbers are parsed with a fast
+ exact path for decimal values with up to 19 significant digits and a power of ten of up to 22, which covers almost all
+ sensor data, and fall back to strtod for everything else, so the result is always the correctly rounded value.
+
+ Empty lines are skipped, whitespace around each cell is ignored and both Unix and Windows line endings are supported.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_CSV_READER_HEADER
+#define GRT_CSV_READER_HEADER
+
+#include "GRTTypedefs.h"
+#include "ErrorLog.h"
+#include "../DataStructures/VectorFloat.h"
+#include <fstream>
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API CSVReader{
+public:
+    /**
+     Default Constructor
+
+     @param seperator: the character that separates the columns in each row. Default value = ','
+     @param bufferSize: the number of bytes read from the file at a time, this grows automatically if a single row is larger. Default value = 1MB
+     */
+    CSVReader(const char seperator = ',',const size_t bufferSize = 1 << 20);
+
+    /**
+     Default Destructor
+     */
+    ~CSVReader();
+
+    /**
+     Opens a CSV file, ready to read the first row.
+
+     @param filename: the name of the file to open
+     @return true if the file was opened, false otherwise
+     */
+    bool open(const std::string &filename);
+
+    /**
+     Closes the file.
+
+     @return true if the file was closed, false otherwise
+     */
+    bool close();
+
+    /**
+     Moves back to the start of the file, so the next call to readRow returns the first row again.
+
+     @return true if the file was rewound, false otherwise
+     */
+    bool rewind();
+
+    /**
+     Scans the rest of the file, counting the number of rows and the number of columns in the first of those rows, and then
+     rewinds the file.  This does not parse any numbers, so it is a cheap way to allocate the destination before reading.
+
+     @param numRows: returns the number of non-empty rows
+     @param numColumns: returns the number of columns in the first row
+     @return true if the file was scanned, false otherwise
+     */
+    bool countRows(UINT &numRows,UINT &numColumns);
+
+    /**
+     Reads the next row, resizing the row to the number of columns in the file.  The row keeps its memory between calls,
+     so reading a file with a consistent number of columns does not allocate after the first row.
+
+     @param row: returns the values in the row
+     @return true if a row was read, false if the end of the file was reached or the row could not be parsed (see getError)
+     */
+    bool readRow(VectorFloat &row);
+
+    /**
+     Reads the next row straight into the memory pointed to by row, which must have room for numColumns values.
+
+     @param row: a pointer to the memory the values will be written to
+     @param numColumns: the number of columns the row must contain
+     @return true if a row was read, false if the end of the file was reached or the row could not be parsed (see getError)
+     */
+    bool readRow(Float *row,const UINT numColumns);
+
+    /**
+     @return returns true if the file is open, false otherwise
+     */
+    bool getIsOpen() const;
+
+    /**
+     @return returns true if the last call to readRow failed because the row could not be parsed, rather than because the end of the file was reached
+     */
+    bool getError() const;
+
+    /**
+     @return returns the line number (starting at 1) of the last row that was read
+     */
+    UINT getLineNumber() const;
+
+    /**
+     Parses a single floating point value, ignoring any whitespace around it.
+
+     @param begin: a pointer to the first character of the value
+     @param end: a pointer to one past the last character of the value
+     @param value: returns the parsed value
+     @return true if the characters contained a valid number, false otherwise
+     */
+    static bool parseFloat(const char *begin,const char *end,Float &value);
+
+protected:
+    bool nextLine(const char *&begin,const char *&end);
+    bool fillBuffer();
+
+    char seperator;
+    std::ifstream file;
+    Vector< char > buffer;
+    size_t bufferStart;
+    size_t bufferEnd;
+    bool endOfFile;
+    bool error;
+    UINT lineNumber;
+    ErrorLog errorLog;
+
+private:
+    CSVReader(const CSVReader &rhs);
+    CSVReader& operator=(const CSVReader &rhs);
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_CSV_READER_HEADER
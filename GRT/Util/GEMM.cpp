@@ -0,0 +1,426 @@
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define GRT_DLL_EXPORTS
+#include "GEMM.h"
+#include <vector>
+#include <algorithm>
+#include <atomic>
+
+//The SIMD kernels are written for double precision, they will only be used if Float is a double
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRT_GEMM_AVX2_ENABLED
+#define GRT_GEMM_AVX2_TARGET __attribute__((target("avx2,fma")))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#define GRT_GEMM_AVX2_ENABLED
+#define GRT_GEMM_AVX2_TARGET
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define GRT_GEMM_NEON_ENABLED
+#include <arm_neon.h>
+#endif
+
+GRT_BEGIN_NAMESPACE
+
+//The register block size (MR x NR) computed by each micro-kernel, and the cache block sizes used to pack A and B
+#define GRT_GEMM_MR 4
+#define GRT_GEMM_NR 8
+#define GRT_GEMM_MC 96
+#define GRT_GEMM_KC 256
+#define GRT_GEMM_NC 2048
+
+//Products smaller than this (M*N*K) skip the packing stage and are computed directly
+#define GRT_GEMM_SMALL_PRODUCT 32768
+
+typedef void (*GEMMMicroKernel)(const UINT kc,const Float *a,const Float *b,Float *acc);
+
+static bool gemmCPUSupportsAVX2(){
+#if defined(GRT_GEMM_AVX2_ENABLED) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(GRT_GEMM_AVX2_ENABLED)
+    return true;
+#else
+    return false;
+#endif
+}
+
+static GEMM::KernelType gemmSelectDefaultKernel(){
+    if( sizeof(Float) != sizeof(double) ) return GEMM::SCALAR_KERNEL;
+    if( gemmCPUSupportsAVX2() ) return GEMM::AVX2_KERNEL;
+#ifdef GRT_GEMM_NEON_ENABLED
+    return GEMM::NEON_KERNEL;
+#else
+    return GEMM::SCALAR_KERNEL;
+#endif
+}
+
+//The kernel type is read by every product and can be changed by setKernelType, so it is atomic to allow products to be computed in parallel
+static std::atomic< GEMM::KernelType > &gemmKernelType(){
+    static std::atomic< GEMM::KernelType > kernelType( gemmSelectDefaultKernel() );
+    return kernelType;
+}
+
+/////////////////////////////////// Micro-kernels ///////////////////////////////////
+//Each micro-kernel computes acc[MR][NR] = a[MR x kc] * b[kc x NR], where a and b are packed panels
+
+static void gemmMicroKernelScalar(const UINT kc,const Float *a,const Float *b,Float *acc){
+    Float c[GRT_GEMM_MR*GRT_GEMM_NR];
+    for(UINT i=0; i<GRT_GEMM_MR*GRT_GEMM_NR; i++) c[i] = 0;
+
+    for(UINT p=0; p<kc; p++){
+        for(UINT i=0; i<GRT_GEMM_MR; i++){
+            const Float ai = a[i];
+            for(UINT j=0; j<GRT_GEMM_NR; j++){
+                c[i*GRT_GEMM_NR+j] += ai * b[j];
+            }
+        }
+        a += GRT_GEMM_MR;
+        b += GRT_GEMM_NR;
+    }
+
+    for(UINT i=0; i<GRT_GEMM_MR*GRT_GEMM_NR; i++) acc[i] = c[i];
+}
+
+#ifdef GRT_GEMM_AVX2_ENABLED
+GRT_GEMM_AVX2_TARGET static void gemmMicroKernelAVX2(const UINT kc,const Float *a_,const Float *b_,Float *acc_){
+    const double *a = reinterpret_cast< const double* >( a_ );
+    const double *b = reinterpret_cast< const double* >( b_ );
+    double *acc = reinterpret_cast< double* >( acc_ );
+
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+    for(UINT p=0; p<kc; p++){
+        const __m256d b0 = _mm256_loadu_pd( b );
+        const __m256d b1 = _mm256_loadu_pd( b+4 );
+        __m256d ai = _mm256_broadcast_sd( a );
+        c00 = _mm256_fmadd_pd( ai, b0, c00 ); c01 = _mm256_fmadd_pd( ai, b1, c01 );
+        ai = _mm256_broadcast_sd( a+1 );
+        c10 = _mm256_fmadd_pd( ai, b0, c10 ); c11 = _mm256_fmadd_pd( ai, b1, c11 );
+        ai = _mm256_broadcast_sd( a+2 );
+        c20 = _mm256_fmadd_pd( ai, b0, c20 ); c21 = _mm256_fmadd_pd( ai, b1, c21 );
+        ai = _mm256_broadcast_sd( a+3 );
+        c30 = _mm256_fmadd_pd( ai, b0, c30 ); c31 = _mm256_fmadd_pd( ai, b1, c31 );
+        a += GRT_GEMM_MR;
+        b += GRT_GEMM_NR;
+    }
+
+    _mm256_storeu_pd( acc, c00 );    _mm256_storeu_pd( acc+4, c01 );
+    _mm256_storeu_pd( acc+8, c10 );  _mm256_storeu_pd( acc+12, c11 );
+    _mm256_storeu_pd( acc+16, c20 ); _mm256_storeu_pd( acc+20, c21 );
+    _mm256_storeu_pd( acc+24, c30 ); _mm256_storeu_pd( acc+28, c31 );
+}
+
+GRT_GEMM_AVX2_TARGET static Float gemmDotAVX2(const Float *x_,const Float *y_,const UINT n){
+    const double *x = reinterpret_cast< const double* >( x_ );
+    const double *y = reinterpret_cast< const double* >( y_ );
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    UINT i = 0;
+    for(; i+8<=n; i+=8){
+        s0 = _mm256_fmadd_pd( _mm256_loadu_pd(x+i), _mm256_loadu_pd(y+i), s0 );
+        s1 = _mm256_fmadd_pd( _mm256_loadu_pd(x+i+4), _mm256_loadu_pd(y+i+4), s1 );
+    }
+    double tmp[4];
+    _mm256_storeu_pd( tmp, _mm256_add_pd( s0, s1 ) );
+    double sum = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+    for(; i<n; i++) sum += x[i] * y[i];
+    return sum;
+}
+
+GRT_GEMM_AVX2_TARGET static void gemmAxpyAVX2(const Float alpha,const Float *x_,Float *y_,const UINT n){
+    const double *x = reinterpret_cast< const double* >( x_ );
+    double *y = reinterpret_cast< double* >( y_ );
+    const __m256d a = _mm256_set1_pd( alpha );
+    UINT i = 0;
+    for(; i+4<=n; i+=4){
+        _mm256_storeu_pd( y+i, _mm256_fmadd_pd( a, _mm256_loadu_pd(x+i), _mm256_loadu_pd(y+i) ) );
+    }
+    for(; i<n; i++) y[i] += alpha * x[i];
+}
+#endif //GRT_GEMM_AVX2_ENABLED
+
+#ifdef GRT_GEMM_NEON_ENABLED
+static void gemmMicroKernelNEON(const UINT kc,const Float *a_,const Float *b_,Float *acc_){
+    const double *a = reinterpret_cast< const double* >( a_ );
+    const double *b = reinterpret_cast< const double* >( b_ );
+    double *acc = reinterpret_cast< double* >( acc_ );
+
+    float64x2_t c[GRT_GEMM_MR][GRT_GEMM_NR/2];
+    for(UINT i=0; i<GRT_GEMM_MR; i++)
+        for(UINT j=0; j<GRT_GEMM_NR/2; j++)
+            c[i][j] = vdupq_n_f64( 0.0 );
+
+    for(UINT p=0; p<kc; p++){
+        const float64x2_t b0 = vld1q_f64( b );
+        const float64x2_t b1 = vld1q_f64( b+2 );
+        const float64x2_t b2 = vld1q_f64( b+4 );
+        const float64x2_t b3 = vld1q_f64( b+6 );
+        for(UINT i=0; i<GRT_GEMM_MR; i++){
+            const float64x2_t ai = vdupq_n_f64( a[i] );
+            c[i][0] = vfmaq_f64( c[i][0], ai, b0 );
+            c[i][1] = vfmaq_f64( c[i][1], ai, b1 );
+            c[i][2] = vfmaq_f64( c[i][2], ai, b2 );
+            c[i][3] = vfmaq_f64( c[i][3], ai, b3 );
+        }
+        a += GRT_GEMM_MR;
+        b += GRT_GEMM_NR;
+    }
+
+    for(UINT i=0; i<GRT_GEMM_MR; i++)
+        for(UINT j=0; j<GRT_GEMM_NR/2; j++)
+            vst1q_f64( acc + i*GRT_GEMM_NR + j*2, c[i][j] );
+}
+#endif //GRT_GEMM_NEON_ENABLED
+
+static Float gemmDotScalar(const Float *x,const Float *y,const UINT n){
+    Float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    UINT i = 0;
+    for(; i+4<=n; i+=4){
+        s0 += x[i] * y[i];
+        s1 += x[i+1] * y[i+1];
+        s2 += x[i+2] * y[i+2];
+        s3 += x[i+3] * y[i+3];
+    }
+    Float sum = (s0 + s1) + (s2 + s3);
+    for(; i<n; i++) sum += x[i] * y[i];
+    return sum;
+}
+
+static void gemmAxpyScalar(const Float alpha,const Float *x,Float *y,const UINT n){
+    for(UINT i=0; i<n; i++) y[i] += alpha * x[i];
+}
+
+/////////////////////////////////// Packing ///////////////////////////////////
+
+//Packs the [mc kc] block of op(A) starting at (i0,p0) into MR row strips, padding the last strip with zeros
+static void gemmPackA(const bool transA,const Float *A,const UINT lda,const UINT i0,const UINT p0,const UINT mc,const UINT kc,Float *buffer){
+    for(UINT ir=0; ir<mc; ir+=GRT_GEMM_MR){
+        const UINT mr = std::min( (UINT)GRT_GEMM_MR, mc-ir );
+        for(UINT p=0; p<kc; p++){
+            for(UINT i=0; i<GRT_GEMM_MR; i++){
+                if( i < mr ){
+                    const UINT r = i0 + ir + i;
+                    const UINT k = p0 + p;
+                    *buffer++ = transA ? A[ k*lda + r ] : A[ r*lda + k ];
+                }else *buffer++ = 0;
+            }
+        }
+    }
+}
+
+//Packs the [kc nc] block of op(B) starting at (p0,j0) into NR column strips, padding the last strip with zeros
+static void gemmPackB(const bool transB,const Float *B,const UINT ldb,const UINT p0,const UINT j0,const UINT kc,const UINT nc,Float *buffer){
+    for(UINT jr=0; jr<nc; jr+=GRT_GEMM_NR){
+        const UINT nr = std::min( (UINT)GRT_GEMM_NR, nc-jr );
+        for(UINT p=0; p<kc; p++){
+            const UINT k = p0 + p;
+            if( !transB && nr == GRT_GEMM_NR ){
+                const Float *b = B + k*ldb + j0 + jr;
+                for(UINT j=0; j<GRT_GEMM_NR; j++) *buffer++ = b[j];
+            }else{
+                for(UINT j=0; j<GRT_GEMM_NR; j++){
+                    if( j < nr ){
+                        const UINT c = j0 + jr + j;
+                        *buffer++ = transB ? B[ c*ldb + k ] : B[ k*ldb + c ];
+                    }else *buffer++ = 0;
+                }
+            }
+        }
+    }
+}
+
+/////////////////////////////////// GEMM ///////////////////////////////////
+
+static void gemmScaleC(const UINT M,const UINT N,const Float beta,Float *C,const UINT ldc){
+    if( beta == 1 ) return;
+    for(UINT i=0; i<M; i++){
+        Float *c = C + i*ldc;
+        if( beta == 0 ){
+            for(UINT j=0; j<N; j++) c[j] = 0;
+        }else{
+            for(UINT j=0; j<N; j++) c[j] *= beta;
+        }
+    }
+}
+
+bool GEMM::gemm(const bool transA,const bool transB,const UINT M,const UINT N,const UINT K,const Float alpha,const Float *A,const UINT lda,const Float *B,const UINT ldb,const Float beta,Float *C,const UINT ldc){
+
+    if( M == 0 || N == 0 ) return true;
+    if( C == NULL || ldc < N ) return false;
+
+    gemmScaleC( M, N, beta, C, ldc );
+
+    if( K == 0 || alpha == 0 ) return true;
+    if( A == NULL || B == NULL ) return false;
+    if( lda < (transA ? M : K) || ldb < (transB ? K : N) ) return false;
+
+    //Small products are faster to compute directly, the i-k-j ordering keeps the inner loop contiguous in B and C
+    if( (unsigned long long)M * N * K <= GRT_GEMM_SMALL_PRODUCT ){
+        for(UINT i=0; i<M; i++){
+            Float *c = C + i*ldc;
+            for(UINT k=0; k<K; k++){
+                const Float aik = alpha * (transA ? A[ k*lda + i ] : A[ i*lda + k ]);
+                if( transB ){
+                    for(UINT j=0; j<N; j++) c[j] += aik * B[ j*ldb + k ];
+                }else{
+                    const Float *b = B + k*ldb;
+                    for(UINT j=0; j<N; j++) c[j] += aik * b[j];
+                }
+            }
+        }
+        return true;
+    }
+
+    GEMMMicroKernel microKernel = gemmMicroKernelScalar;
+    switch( gemmKernelType().load() ){
+#ifdef GRT_GEMM_AVX2_ENABLED
+        case AVX2_KERNEL:
+            microKernel = gemmMicroKernelAVX2;
+        break;
+#endif
+#ifdef GRT_GEMM_NEON_ENABLED
+        case NEON_KERNEL:
+            microKernel = gemmMicroKernelNEON;
+        break;
+#endif
+        default:
+        break;
+    }
+
+    //The packing buffers are reused between calls to avoid allocating memory on each product
+#ifdef GRT_CXX11_ENABLED
+    static thread_local std::vector< Float > packedA;
+    static thread_local std::vector< Float > packedB;
+#else
+    std::vector< Float > packedA;
+    std::vector< Float > packedB;
+#endif
+    const UINT maxNC = std::min( (UINT)GRT_GEMM_NC, N );
+    const UINT maxKC = std::min( (UINT)GRT_GEMM_KC, K );
+    const UINT maxMC = std::min( (UINT)GRT_GEMM_MC, M );
+    const size_t packedBSize = size_t(maxKC) * ((maxNC + GRT_GEMM_NR - 1) / GRT_GEMM_NR) * GRT_GEMM_NR;
+    const size_t packedASize = size_t(maxKC) * ((maxMC + GRT_GEMM_MR - 1) / GRT_GEMM_MR) * GRT_GEMM_MR;
+    if( packedA.size() < packedASize ) packedA.resize( packedASize );
+    if( packedB.size() < packedBSize ) packedB.resize( packedBSize );
+
+    Float acc[ GRT_GEMM_MR*GRT_GEMM_NR ];
+
+    for(UINT j0=0; j0<N; j0+=GRT_GEMM_NC){
+        const UINT nc = std::min( (UINT)GRT_GEMM_NC, N-j0 );
+        for(UINT p0=0; p0<K; p0+=GRT_GEMM_KC){
+            const UINT kc = std::min( (UINT)GRT_GEMM_KC, K-p0 );
+            gemmPackB( transB, B, ldb, p0, j0, kc, nc, &packedB[0] );
+
+            for(UINT i0=0; i0<M; i0+=GRT_GEMM_MC){
+                const UINT mc = std::min( (UINT)GRT_GEMM_MC, M-i0 );
+                gemmPackA( transA, A, lda, i0, p0, mc, kc, &packedA[0] );
+
+                //Run the micro-kernel over each MR x NR tile of this block and accumulate the result into C
+                for(UINT jr=0; jr<nc; jr+=GRT_GEMM_NR){
+                    const UINT nr = std::min( (UINT)GRT_GEMM_NR, nc-jr );
+                    const Float *b = &packedB[ size_t(jr) * kc ];
+                    for(UINT ir=0; ir<mc; ir+=GRT_GEMM_MR){
+                        const UINT mr = std::min( (UINT)GRT_GEMM_MR, mc-ir );
+                        const Float *a = &packedA[ size_t(ir) * kc ];
+                        microKernel( kc, a, b, acc );
+                        for(UINT i=0; i<mr; i++){
+                            Float *c = C + size_t(i0+ir+i)*ldc + j0 + jr;
+                            const Float *t = acc + i*GRT_GEMM_NR;
+                            for(UINT j=0; j<nr; j++) c[j] += alpha * t[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/////////////////////////////////// GEMV ///////////////////////////////////
+
+bool GEMM::gemv(const bool transA,const UINT M,const UINT N,const Float alpha,const Float *A,const UINT lda,const Float *x,const Float beta,Float *y){
+
+    const UINT ySize = transA ? N : M;
+    if( ySize == 0 ) return true;
+    if( y == NULL || lda < N ) return false;
+    if( y == x ) return false; //The output can not be the input, as y is overwritten before x is read
+
+    gemmScaleC( 1, ySize, beta, y, ySize );
+
+    if( M == 0 || N == 0 || alpha == 0 ) return true;
+    if( A == NULL || x == NULL ) return false;
+
+    Float (*dot)(const Float*,const Float*,const UINT) = gemmDotScalar;
+    void (*axpy)(const Float,const Float*,Float*,const UINT) = gemmAxpyScalar;
+#ifdef GRT_GEMM_AVX2_ENABLED
+    if( gemmKernelType().load() == AVX2_KERNEL ){
+        dot = gemmDotAVX2;
+        axpy = gemmAxpyAVX2;
+    }
+#endif
+
+    if( !transA ){
+        for(UINT i=0; i<M; i++){
+            y[i] += alpha * dot( A + size_t(i)*lda, x, N );
+        }
+    }else{
+        for(UINT i=0; i<M; i++){
+            axpy( alpha * x[i], A + size_t(i)*lda, y, N );
+        }
+    }
+
+    return true;
+}
+
+GEMM::KernelType GEMM::getKernelType(){
+    return gemmKernelType().load();
+}
+
+bool GEMM::setKernelType(const KernelType kernelType){
+    if( !isKernelSupported( kernelType ) ) return false;
+    gemmKernelType().store( kernelType );
+    return true;
+}
+
+bool GEMM::isKernelSupported(const KernelType kernelType){
+    switch( kernelType ){
+        case SCALAR_KERNEL:
+            return true;
+        case AVX2_KERNEL:
+            return sizeof(Float) == sizeof(double) && gemmCPUSupportsAVX2();
+        case NEON_KERNEL:
+#ifdef GRT_GEMM_NEON_ENABLED
+            return sizeof(Float) == sizeof(double);
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+GRT_END_NAMESPACE
@@ -0,0 +1,116 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+
+ @brief The GEMM class implements the general matrix-matrix (C = alpha*op(A)*op(B) + beta*C) and matrix-vector
+ (y = alpha*op(A)*x + beta*y) products used by the MatrixFloat class. The matrix-matrix product is cache blocked: panels
+ of A and B are packed into contiguous buffers and a small register-blocked micro-kernel computes each tile of C.
+
+ The micro-kernel is selected at runtime: an AVX2/FMA kernel is used on x86 CPUs that support it, a NEON kernel is used on
+ AArch64, and a portable scalar kernel is used everywhere else.
+
+ All matrices are assumed to be stored in row-major order, with a leading dimension (the distance between rows) that is at
+ least the number of columns.
+ */
+
+/*
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef GRT_GEMM_HEADER
+#define GRT_GEMM_HEADER
+
+#include "GRTTypedefs.h"
+
+GRT_BEGIN_NAMESPACE
+
+class GRT_API GEMM{
+public:
+    /**
+     Lists the micro-kernels that can be used by the GEMM class.
+     */
+    enum KernelType{ SCALAR_KERNEL=0, AVX2_KERNEL, NEON_KERNEL };
+
+    /**
+     Computes C = alpha*op(A)*op(B) + beta*C, where op(X) is X or X' depending on the transpose flags.
+     op(A) is [M K], op(B) is [K N] and C is [M N]. If beta is zero then C does not need to be initialized.
+
+     @param transA: if true, A is stored as a [K M] matrix and will be transposed
+     @param transB: if true, B is stored as a [N K] matrix and will be transposed
+     @param M: the number of rows in op(A) and C
+     @param N: the number of columns in op(B) and C
+     @param K: the number of columns in op(A) and rows in op(B)
+     @param alpha: the scalar applied to op(A)*op(B)
+     @param A: a pointer to the first element in A
+     @param lda: the leading dimension (row stride) of A
+     @param B: a pointer to the first element in B
+     @param ldb: the leading dimension (row stride) of B
+     @param beta: the scalar applied to C before the product is added
+     @param C: a pointer to the first element in C
+     @param ldc: the leading dimension (row stride) of C
+     @return returns true if the product was computed, false otherwise
+     */
+    static bool gemm(const bool transA,const bool transB,const UINT M,const UINT N,const UINT K,const Float alpha,const Float *A,const UINT lda,const Float *B,const UINT ldb,const Float beta,Float *C,const UINT ldc);
+
+    /**
+     Computes y = alpha*op(A)*x + beta*y, where A is stored as a [M N] matrix and op(A) is A or A'.
+     If transA is false, x must have N elements and y must have M elements, otherwise x must have M elements and y N elements.
+     If beta is zero then y does not need to be initialized.
+
+     @param transA: if true, the product will be computed with A'
+     @param M: the number of rows in A
+     @param N: the number of columns in A
+     @param alpha: the scalar applied to op(A)*x
+     @param A: a pointer to the first element in A
+     @param lda: the leading dimension (row stride) of A
+     @param x: a pointer to the first element in x
+     @param beta: the scalar applied to y before the product is added
+     @param y: a pointer to the first element in y, this can not be the same memory as x
+     @return returns true if the product was computed, false otherwise
+     */
+    static bool gemv(const bool transA,const UINT M,const UINT N,const Float alpha,const Float *A,const UINT lda,const Float *x,const Float beta,Float *y);
+
+    /**
+     Gets the micro-kernel that will be used on this CPU.
+
+     @return returns the KernelType that is currently in use
+     */
+    static KernelType getKernelType();
+
+    /**
+     Overrides the micro-kernel selected at runtime. This is mainly useful for testing, the kernel will only be changed if
+     it is supported by the CPU (the scalar kernel is always supported).
+
+     @param kernelType: the kernel that should be used
+     @return returns true if the kernel was changed, false otherwise
+     */
+    static bool setKernelType(const KernelType kernelType);
+
+    /**
+     Returns true if the kernel type is supported by this build and CPU.
+
+     @param kernelType: the kernel that should be checked
+     @return returns true if the kernel is supported, false otherwise
+     */
+    static bool isKernelSupported(const KernelType kernelType);
+};
+
+GRT_END_NAMESPACE
+
+#endif //GRT_GEMM_HEADER
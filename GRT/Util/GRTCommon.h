@@ -78,6 +78,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "LUDecomposition.h"
 #include "SVD.h"
 #include "FileParser.h"
+#include "CSVReader.h"
 #include "ObserverManager.h"
 #include "ThreadPool.h"
 #include "DataType.h"
@@ -21,6 +21,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define GRT_DLL_EXPORTS
 #include "Metrics.h"
 #include "../DataStructures/ClassificationData.h"
+#include "../DataStructures/ClassificationDataView.h"
 #include "../CoreModules/Classifier.h"
 
 GRT_BEGIN_NAMESPACE
@@ -54,5 +55,30 @@ bool Metrics::computeAccuracy( GRT::Classifier &model, const GRT::Classification
     return true;
 }
 
+bool Metrics::computeAccuracy( GRT::Classifier &model, const GRT::ClassificationDataView &data, Float &accuracy ){
+
+    accuracy = 0;
+
+    if( !model.getTrained() ) return false;
+
+    const UINT M = data.getNumSamples();
+
+    for(UINT i=0; i<M; i++){
+        if( !model.predict( data[i].getSample() ) ){
+            accuracy = 0;
+            return false;
+        }
+
+        if( model.getPredictedClassLabel() == data[i].getClassLabel() ){
+            accuracy++;
+        }
+    }
+
+    //Convert the accuracy to a percentage
+    accuracy = accuracy / static_cast<Float>(M) * 100.0;
+
+    return true;
+}
+
 GRT_END_NAMESPACE
 
@@ -15,6 +15,7 @@ GRT_BEGIN_NAMESPACE
 //Forward declaration
 class Classifier;
 class ClassificationData;
+class ClassificationDataView;
 
 class GRT_API Metrics{
 public:
@@ -36,6 +37,15 @@ public:
     @return returns true if the accuracy was computed, false otherwise
     */
     static bool computeAccuracy( Classifier &model, const ClassificationData &data, Float &accuracy );
+
+    /**
+    Computes the accuracy of the model given a view of a dataset. The accuracy results will be stored in the accuracy parameter and will be in the range of [0., 100.0].
+    @param model: the trained model you want to test the accuracy using the samples in the view
+    @param data: the view of the dataset that will be used to test the model
+    @param accuracy: the variable to which the accuracy of the model will be stored 
+    @return returns true if the accuracy was computed, false otherwise
+    */
+    static bool computeAccuracy( Classifier &model, const ClassificationDataView &data, Float &accuracy );
 };
     
 GRT_END_NAMESPACE
@@ -32,6 +32,10 @@ public:
     MinMax(Float minValue,Float maxValue){
         this->minValue = minValue;
         this->maxValue = maxValue;
+    }
+    MinMax(const MinMax &rhs){
+        this->minValue = rhs.minValue;
+        this->maxValue = rhs.maxValue;
     }
 	~MinMax(){};
 
@@ -197,7 +197,7 @@ Vector< unsigned int > Random::getRandomSubset( const unsigned int startRange, c
     for(i=startRange; i<endRange; i++){
         indexs[i] = i;
     }
-    std::random_shuffle(indexs.begin(), indexs.end());
+    shuffle( indexs );
     
     //Select the first X values from the randomly shuffled range buffer as the subset
     for(i=0; i<subsetSize; i++){
@@ -188,6 +188,19 @@ public:
      @return returns a Vector of unsigned ints selected from the
      */
     Vector< unsigned int > getRandomSubset( const unsigned int startRange, const unsigned int endRange, const unsigned int subsetSize );
+
+    /**
+     Randomly shuffles the elements of the input Vector in place (Fisher-Yates), using this instance's generator.
+     Unlike std::random_shuffle, the result only depends on the seed of this instance.
+     @param values: the Vector that will be shuffled
+     */
+    template< class T >
+    void shuffle( Vector< T > &values ){
+        const int N = (int)values.size();
+        for(int i=N-1; i>0; i--){
+            std::swap( values[i], values[ getRandomNumberInt(0,i+1) ] );
+        }
+    }
     
 private:
 
@@ -7,6 +7,14 @@ using namespace GRT;
 #ifdef GRT_CXX11_ENABLED
 //Initalize the static thread pool size to the systems suggested thread limit
 std::atomic< unsigned int > ThreadPool::threadPoolSize( std::thread::hardware_concurrency() );
+
+//The pool and worker index of the current thread, these are only set on the worker threads
+static thread_local ThreadPool *currentThreadPool = NULL;
+static thread_local unsigned int currentWorkerIndex = 0;
+
+//The global thread pool used by parallel_for and parallel_reduce
+static std::mutex globalThreadPoolMutex;
+static std::shared_ptr< ThreadPool > globalThreadPool;
 #endif
 
 ThreadPool::ThreadPool()
@@ -28,9 +36,11 @@ ThreadPool::ThreadPool(const unsigned int poolSize)
 // the destructor joins all threads
 ThreadPool::~ThreadPool()
 {
-std::cout << "~ThreadPool()\n";
 #ifdef GRT_CXX11_ENABLED
-    stop = true;
+    {
+        std::unique_lock< std::mutex > lock( queue_mutex );
+        stop = true;
+    }
     condition.notify_all();
     for(std::thread &worker: workers)
         worker.join();
@@ -40,41 +50,133 @@ std::cout << "~ThreadPool()\n";
 #ifdef GRT_CXX11_ENABLED
 void ThreadPool::launchThreads( const unsigned int poolSize ){
     
-    //Start the worker thread, each thread will wait for incoming tasks and pop them off the queue when ready
+    nextQueue = 0;
+    numPendingTasks = 0;
+    for(unsigned int i = 0; i<poolSize; ++i)
+        queues.emplace_back( new WorkerQueue );
+    
+    //Start the worker thread, each thread will run the tasks in its own queue, steal tasks from the other queues, or wait for new tasks
     for(unsigned int i = 0; i<poolSize; ++i)
         workers.emplace_back(
-                             [this]
+                             [this,i]
                              {
+                                 currentThreadPool = this;
+                                 currentWorkerIndex = i;
+                                 
                                  while( true )
                                  {
                                     std::function< void() > task;
 
-                                    //Lock the queue and wait for the condition to change
-                                    {
-                                        std::unique_lock<std::mutex> lock(this->queue_mutex);
-                                         this->condition.wait(lock,
-                                                              [this]{ return this->stop || !this->tasks.empty(); });
-                                         if(this->stop && this->tasks.empty()){
-                                            std::cout << "stopping worker!" << std::endl;
-                                            return;
-                                         }
-                                         task = std::move(this->tasks.front());
-                                         this->tasks.pop();
-                                    }
-                                    
-
-                                    //Otherwise grab the task from the front of the buffer
-                                    if( task ){
+                                    if( this->popTask( task ) ){
                                         //Run the task
-                                        task();
+                                        if( task ) task();
+                                        continue;
                                     }
                                     
+                                    //Lock the queue and wait for the condition to change
+                                    std::unique_lock<std::mutex> lock(this->queue_mutex);
+                                    this->condition.wait(lock,
+                                                         [this]{ return this->stop || this->numPendingTasks > 0; });
+                                    if(this->stop && this->numPendingTasks == 0){
+                                        return;
+                                    }
                                  }
                              }
                              );
 }
+
+void ThreadPool::pushTask( std::function< void() > task ){
+    
+    //If there are no workers then the task has to be run here
+    if( queues.size() == 0 ){
+        task();
+        return;
+    }
+    
+    //Tasks added by a worker go into its own queue, so nested tasks stay on the same thread unless they are stolen
+    const unsigned int index = currentThreadPool == this ? currentWorkerIndex : (nextQueue++ % queues.size());
+    
+    numPendingTasks++;
+    {
+        std::unique_lock< std::mutex > lock( queues[index]->mutex );
+        queues[index]->tasks.push_back( std::move( task ) );
+    }
+    {
+        std::unique_lock< std::mutex > lock( queue_mutex );
+    }
+    condition.notify_one();
+}
+
+bool ThreadPool::popTask( std::function< void() > &task ){
+    
+    const unsigned int numQueues = (unsigned int)queues.size();
+    if( numQueues == 0 ) return false;
+    
+    //A worker runs the newest task in its own queue first
+    const bool isWorker = currentThreadPool == this;
+    if( isWorker ){
+        WorkerQueue &queue = *queues[ currentWorkerIndex ];
+        std::unique_lock< std::mutex > lock( queue.mutex );
+        if( !queue.tasks.empty() ){
+            task = std::move( queue.tasks.back() );
+            queue.tasks.pop_back();
+            numPendingTasks--;
+            return true;
+        }
+    }
+    
+    //Otherwise steal the oldest task from one of the other queues
+    const unsigned int start = isWorker ? currentWorkerIndex + 1 : nextQueue.load();
+    for(unsigned int i=0; i<numQueues; i++){
+        WorkerQueue &queue = *queues[ (start + i) % numQueues ];
+        std::unique_lock< std::mutex > lock( queue.mutex );
+        if( !queue.tasks.empty() ){
+            task = std::move( queue.tasks.front() );
+            queue.tasks.pop_front();
+            numPendingTasks--;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool ThreadPool::runPendingTask(){
+    std::function< void() > task;
+    if( !popTask( task ) ) return false;
+    if( task ) task();
+    return true;
+}
+
+std::shared_ptr< ThreadPool > ThreadPool::getGlobalThreadPool(){
+    
+    const unsigned int poolSize = threadPoolSize;
+    if( poolSize <= 1 ) return std::shared_ptr< ThreadPool >();
+    
+    //The thread that starts a parallel loop also runs tasks, so the global pool only needs poolSize-1 workers
+    std::unique_lock< std::mutex > lock( globalThreadPoolMutex );
+    if( !globalThreadPool || globalThreadPool->getNumThreads() != poolSize-1 ){
+        globalThreadPool = std::make_shared< ThreadPool >( poolSize-1 );
+    }
+    return globalThreadPool;
+}
 #endif
 
+unsigned int ThreadPool::getNumThreads() const{
+#ifdef GRT_CXX11_ENABLED
+    return (unsigned int)workers.size();
+#else
+    return 0;
+#endif
+}
+
+UINT ThreadPool::getGrainSize(const UINT rangeSize,const UINT grainSize){
+    if( grainSize > 0 ) return grainSize;
+    //Split the range into at most 256 chunks, which gives enough tasks to balance the load without depending on the number of threads
+    const UINT maxNumChunks = 256;
+    return rangeSize > maxNumChunks ? (rangeSize + maxNumChunks - 1) / maxNumChunks : 1;
+}
+
 unsigned int ThreadPool::getThreadPoolSize(){
 #ifdef GRT_CXX11_ENABLED
     return threadPoolSize;
@@ -91,4 +193,3 @@ bool ThreadPool::setThreadPoolSize( const unsigned int threadPoolSize_ ){
     return false;
 #endif
 }
-
@@ -4,6 +4,13 @@
  
  @brief The ThreadPool class implements a flexible inteface for performing a large number of batch tasks. You need to build the GRT with
  GRT_CXX11_ENABLED, otherwise the ThreadPool class will be empty (as it requires C++11 support).
+
+ Each worker thread has its own task queue. A worker runs the newest task from its own queue first, and if its queue is empty it steals the
+ oldest task from another worker, which keeps all the threads busy when the tasks have very different run times.
+
+ The static parallel_for and parallel_reduce functions run a loop over a range of indices using one global thread pool that is shared by
+ the whole library, the size of this pool is controlled by setThreadPoolSize(...). The thread that calls these functions also runs tasks
+ while it waits for the loop to finish, so they can safely be nested (e.g. a parallel loop inside another parallel loop).
  
  @note This class is mainly based on the following thread pool example: https://github.com/progschj/ThreadPool/
  */
@@ -34,15 +41,18 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //Include the common C++ headers
 #include <vector>
 #include <queue>
+#include <deque>
 #include <stdexcept>
 
 #ifdef GRT_CXX11_ENABLED
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <functional>
+#include <exception>
 #endif //GRT_CXX11_ENABLED
 
 #include "GRTTypedefs.h"
@@ -82,8 +92,26 @@ public:
      */
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future< typename std::result_of<F(Args...) >::type>;
+
+    /**
+     Runs one pending task from this thread pool on the calling thread, if there is one. If the calling thread is one of the workers in this pool
+     then the newest task in its own queue is used, otherwise the oldest task is stolen from one of the workers.
+     This is used to keep the calling thread busy while it waits for other tasks to finish.
+
+     @note This function will only be enabled if the GRT is compiled with C++11 support.
+
+     @return returns true if a task was run, false if there were no pending tasks
+     */
+    bool runPendingTask();
 #endif //GRT_CXX11_ENABLED
 
+    /**
+     Gets the number of worker threads in this thread pool.
+
+     @return returns the number of worker threads in this thread pool
+     */
+    unsigned int getNumThreads() const;
+
     /**
      This function returns the current thread limit.  This defaults to the number of threads set by std::thread::hardware_concurrency(), but the user
      can override this value if needed using the setThreadLimit(...) function.
@@ -94,18 +122,63 @@ public:
     
     /**
      This function sets the current thread limit.  This defaults to the number of threads set by std::thread::hardware_concurrency(), but the user
-     can override this value using this function.
+     can override this value using this function.  This also sets the number of threads used by parallel_for and parallel_reduce, setting the
+     size to 1 will run all the parallel loops in the library on the calling thread.  This should not be changed while a parallel loop is running.
      
      @return returns ture if the value was updated, false otherwise
      */
     static bool setThreadPoolSize( const unsigned int threadPoolSize );
     
+    /**
+     Runs func(i) for each index i in [begin end), using the global thread pool.  The range is split into chunks of grainSize indices, and each
+     chunk is run as one task.  The function returns once all the indices have been processed.  The function must be safe to call concurrently for
+     different indices.  If the function throws an exception, the remaining chunks are still run and the first exception is rethrown here.
+
+     @param begin: the first index in the range
+     @param end: one past the last index in the range
+     @param func: the function to call for each index, this should have the signature void func(const UINT i)
+     @param grainSize: the number of indices in each task, if zero the grain size will be set automatically. Default value = 0
+     @return returns true if the loop was run, false otherwise
+     */
+    template< class Function >
+    static bool parallel_for(const UINT begin,const UINT end,Function func,const UINT grainSize = 0);
+
+    /**
+     Computes reduce( ... reduce( reduce(identity, map(begin)), map(begin+1) ) ..., map(end-1) ) using the global thread pool.  The range is split
+     into chunks of grainSize indices, the values in each chunk are reduced in parallel and the chunk results are then reduced in order, so the
+     result is deterministic for a given grain size (regardless of the number of threads).  If the grain size is zero it is set automatically
+     using only the size of the range.
+
+     @param begin: the first index in the range
+     @param end: one past the last index in the range
+     @param identity: the initial value of each reduction, e.g. zero for a sum
+     @param map: the function that computes the value for each index, this should have the signature T map(const UINT i)
+     @param reduce: the function that combines two values, this should have the signature T reduce(const T &a,const T &b)
+     @param grainSize: the number of indices in each task, if zero the grain size will be set automatically. Default value = 0
+     @return returns the reduced value, or the identity if the range is empty
+     */
+    template< class T, class Map, class Reduce >
+    static T parallel_reduce(const UINT begin,const UINT end,const T &identity,Map map,Reduce reduce,const UINT grainSize = 0);
+
 protected:
+    static UINT getGrainSize(const UINT rangeSize,const UINT grainSize);
+
 #ifdef GRT_CXX11_ENABLED
     void launchThreads(const unsigned int threads);
+    void pushTask(std::function< void() > task);
+    bool popTask(std::function< void() > &task);
+    static std::shared_ptr< ThreadPool > getGlobalThreadPool();
+
+    //Each worker has its own queue, protected by its own mutex
+    struct WorkerQueue{
+        std::deque< std::function< void() > > tasks;
+        std::mutex mutex;
+    };
     
     std::vector< std::thread > workers;
-    std::queue< std::function<void()> > tasks;
+    std::vector< std::unique_ptr< WorkerQueue > > queues;
+    std::atomic< unsigned int > nextQueue;
+    std::atomic< unsigned int > numPendingTasks;
     
     // synchronization
     std::mutex queue_mutex;
@@ -126,18 +199,110 @@ template<class F, class... Args> auto ThreadPool::enqueue(F&& func, Args&&... ar
     auto task = std::make_shared< std::packaged_task< return_type() > >( std::bind(std::forward<F>( func ), std::forward<Args>(args)...) );
     
     std::future< return_type > res = task->get_future();
-    {
-        std::unique_lock< std::mutex > lock( queue_mutex );
         
-        // don't allow enqueueing after stopping the pool
-        if( stop )
-            throw std::runtime_error("enqueue on stopped ThreadPool");
+    // don't allow enqueueing after stopping the pool
+    if( stop )
+        throw std::runtime_error("enqueue on stopped ThreadPool");
         
-        tasks.emplace( [task](){ (*task)(); } );
-    }
-    condition.notify_one();
+    pushTask( [task](){ (*task)(); } );
+
     return res;
 }
+
+template< class Function >
+bool ThreadPool::parallel_for(const UINT begin,const UINT end,Function func,const UINT grainSize){
+
+    if( end <= begin ) return true;
+
+    const UINT rangeSize = end - begin;
+    const UINT grain = getGrainSize( rangeSize, grainSize );
+    std::shared_ptr< ThreadPool > pool = getGlobalThreadPool();
+
+    //If there is only one thread, or only one chunk, then just run the loop here
+    if( !pool || rangeSize <= grain ){
+        for(UINT i=begin; i<end; i++) func( i );
+        return true;
+    }
+
+    //The tasks reference the variables on this stack, which is safe as we do not return until they have all finished
+    const UINT numChunks = (rangeSize + grain - 1) / grain;
+    UINT numRemaining = numChunks;
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    for(UINT chunk=0; chunk<numChunks; chunk++){
+        pool->pushTask( [&,chunk](){
+            const UINT chunkBegin = begin + chunk*grain;
+            const UINT chunkEnd = chunkBegin + grain < end ? chunkBegin + grain : end;
+            try{
+                for(UINT i=chunkBegin; i<chunkEnd; i++) func( i );
+            }catch(...){
+                std::unique_lock< std::mutex > lock( exceptionMutex );
+                if( !exception ) exception = std::current_exception();
+            }
+            //The last task wakes the calling thread, this is done while holding the lock so the condition is not destroyed while it is being notified
+            std::unique_lock< std::mutex > lock( doneMutex );
+            if( --numRemaining == 0 ) doneCondition.notify_all();
+        } );
+    }
+
+    //Help run the tasks while there are any left in the queues, then sleep until the tasks that are still running on the workers have finished
+    while( pool->runPendingTask() ){}
+    {
+        std::unique_lock< std::mutex > lock( doneMutex );
+        doneCondition.wait( lock, [&]{ return numRemaining == 0; } );
+    }
+
+    if( exception ) std::rethrow_exception( exception );
+
+    return true;
+}
+
+template< class T, class Map, class Reduce >
+T ThreadPool::parallel_reduce(const UINT begin,const UINT end,const T &identity,Map map,Reduce reduce,const UINT grainSize){
+
+    if( end <= begin ) return identity;
+
+    //The chunks are independent of the number of threads, so the result is the same for any thread pool size
+    const UINT rangeSize = end - begin;
+    const UINT grain = getGrainSize( rangeSize, grainSize );
+    const UINT numChunks = (rangeSize + grain - 1) / grain;
+    std::vector< T > results( numChunks, identity );
+
+    parallel_for( 0, numChunks, [&](const UINT chunk){
+        const UINT chunkBegin = begin + chunk*grain;
+        const UINT chunkEnd = chunkBegin + grain < end ? chunkBegin + grain : end;
+        T value = identity;
+        for(UINT i=chunkBegin; i<chunkEnd; i++) value = reduce( value, map( i ) );
+        results[ chunk ] = value;
+    }, 1 );
+
+    T value = identity;
+    for(UINT chunk=0; chunk<numChunks; chunk++) value = reduce( value, results[chunk] );
+    return value;
+}
+#else
+template< class Function >
+bool ThreadPool::parallel_for(const UINT begin,const UINT end,Function func,const UINT grainSize){
+    for(UINT i=begin; i<end; i++) func( i );
+    return true;
+}
+
+template< class T, class Map, class Reduce >
+T ThreadPool::parallel_reduce(const UINT begin,const UINT end,const T &identity,Map map,Reduce reduce,const UINT grainSize){
+    if( end <= begin ) return identity;
+    const UINT grain = getGrainSize( end - begin, grainSize );
+    T value = identity;
+    for(UINT chunkBegin=begin; chunkBegin<end; chunkBegin+=grain){
+        const UINT chunkEnd = chunkBegin + grain < end ? chunkBegin + grain : end;
+        T chunkValue = identity;
+        for(UINT i=chunkBegin; i<chunkEnd; i++) chunkValue = reduce( chunkValue, map( i ) );
+        value = reduce( value, chunkValue );
+    }
+    return value;
+}
 #endif //GRT_CXX11_ENABLED
     
 GRT_END_NAMESPACE
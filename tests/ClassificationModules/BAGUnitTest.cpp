@@ -207,6 +207,27 @@ TEST(BAG, TrainGaussDataset) {
   EXPECT_TRUE( tester.testTrainGaussLinearDataset() );
 }
 
+// Tests that two ensembles with the same random seed draw the same bootstraps
+TEST(BAG, TestRandomSeedIsRepeatable) {
+  GRT::ClassificationData trainingData = GRT::ClassificationData::generateGaussDataset( 500, 3, 2, 10, 1 );
+
+  GRT::BAG bagA, bagB;
+  EXPECT_TRUE( bagA.addClassifierToEnsemble( GRT::ANBC() ) );
+  EXPECT_TRUE( bagA.addClassifierToEnsemble( GRT::ANBC() ) );
+  EXPECT_TRUE( bagB.addClassifierToEnsemble( GRT::ANBC() ) );
+  EXPECT_TRUE( bagB.addClassifierToEnsemble( GRT::ANBC() ) );
+  EXPECT_TRUE( bagA.setRandomSeed( 42 ) );
+  EXPECT_TRUE( bagB.setRandomSeed( 42 ) );
+  EXPECT_TRUE( bagA.train( trainingData ) );
+  EXPECT_TRUE( bagB.train( trainingData ) );
+
+  for(GRT::UINT i=0; i<trainingData.getNumSamples(); i++){
+    EXPECT_TRUE( bagA.predict( trainingData[i].getSample() ) );
+    EXPECT_TRUE( bagB.predict( trainingData[i].getSample() ) );
+    EXPECT_EQ( bagA.getClassLikelihoods(), bagB.getClassLikelihoods() );
+  }
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
@@ -14,6 +14,355 @@ TEST(DTW, TestCopyConstructor) {
 
 //TODO: Need to implement temporal train unit tests
 
+//Generates a dataset of noisy sine waves, each class uses a different frequency
+inline GRT::TimeSeriesClassificationData generateSineDataset( const GRT::UINT numClasses, const GRT::UINT numSamplesPerClass, GRT::Random &random ){
+  GRT::TimeSeriesClassificationData data( 2 );
+  for(GRT::UINT k=0; k<numClasses; k++){
+    for(GRT::UINT n=0; n<numSamplesPerClass; n++){
+      const GRT::UINT length = 40 + random.getRandomNumberInt(0,20);
+      GRT::MatrixFloat sample( length, 2 );
+      for(GRT::UINT i=0; i<length; i++){
+        const GRT::Float t = i / GRT::Float(length);
+        sample[i][0] = sin( TWO_PI * (k+1) * t ) + random.getRandomNumberGauss(0,0.05);
+        sample[i][1] = cos( TWO_PI * (k+1) * t ) + random.getRandomNumberGauss(0,0.05);
+      }
+      data.addSample( k+1, sample );
+    }
+  }
+  return data;
+}
+
+//A naive DTW reference using the full cost matrix, this returns the mean accumulated cost along the warping path
+inline GRT::Float naiveDTW( const GRT::MatrixFloat &a, const GRT::MatrixFloat &b, GRT::Float *accumulatedCost = NULL ){
+  const GRT::UINT M = a.getNumRows();
+  const GRT::UINT N = b.getNumRows();
+  GRT::MatrixFloat D( M, N );
+  for(GRT::UINT i=0; i<M; i++){
+    for(GRT::UINT j=0; j<N; j++){
+      GRT::Float cost = 0;
+      for(GRT::UINT k=0; k<a.getNumCols(); k++) cost += GRT::SQR( a[i][k] - b[j][k] );
+      cost = sqrt( cost );
+      if( i == 0 && j == 0 ) D[i][j] = cost;
+      else if( i == 0 ) D[i][j] = cost + D[i][j-1];
+      else if( j == 0 ) D[i][j] = cost + D[i-1][j];
+      else D[i][j] = cost + std::min( D[i-1][j-1], std::min( D[i-1][j], D[i][j-1] ) );
+    }
+  }
+  GRT::UINT i = M-1;
+  GRT::UINT j = N-1;
+  GRT::Float sum = D[i][j];
+  if( accumulatedCost != NULL ) *accumulatedCost = D[i][j];
+  GRT::UINT length = 1;
+  while( i > 0 || j > 0 ){
+    if( i == 0 ) j--;
+    else if( j == 0 ) i--;
+    else{
+      const GRT::Float diag = D[i-1][j-1];
+      const GRT::Float up = D[i-1][j];
+      const GRT::Float left = D[i][j-1];
+      if( diag <= up && diag <= left ){ i--; j--; }
+      else if( up <= left ) i--;
+      else j--;
+    }
+    sum += D[i][j];
+    length++;
+  }
+  return sum / length;
+}
+
+// Tests the DTW distances against a naive reference, and checks the warping path mode gives the same distances
+TEST(DTW, TestDistance) {
+  GRT::Random random;
+  GRT::TimeSeriesClassificationData trainingData = generateSineDataset( 3, 5, random );
+  GRT::TimeSeriesClassificationData testData = generateSineDataset( 3, 2, random );
+
+  GRT::DTW dtw;
+  EXPECT_TRUE( dtw.setTrainingLoggingEnabled( false ) );
+  EXPECT_TRUE( dtw.setContrainWarpingPath( false ) );
+  EXPECT_TRUE( dtw.train( trainingData ) );
+  EXPECT_TRUE( dtw.getTrained() );
+
+  GRT::Vector< GRT::DTWTemplate > templates = dtw.getModels();
+  for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+    GRT::MatrixFloat timeseries = testData[i].getData();
+    EXPECT_TRUE( dtw.predict( timeseries ) );
+    EXPECT_EQ( testData[i].getClassLabel(), dtw.getPredictedClassLabel() );
+    GRT::VectorFloat distances = dtw.getClassDistances();
+    for(GRT::UINT k=0; k<templates.getSize(); k++){
+      EXPECT_NEAR( naiveDTW( templates[k].timeSeries, timeseries ), distances[k], 1.0e-9 );
+    }
+  }
+
+  //The banded distance should match when the full cost matrix and warping path are computed
+  EXPECT_TRUE( dtw.setContrainWarpingPath( true ) );
+  GRT::DTW dtwWithPaths( dtw );
+  EXPECT_TRUE( dtwWithPaths.enableWarpingPaths( true ) );
+  for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+    GRT::MatrixFloat timeseries = testData[i].getData();
+    EXPECT_TRUE( dtw.predict( timeseries ) );
+    EXPECT_TRUE( dtwWithPaths.predict( timeseries ) );
+    GRT::VectorFloat distances = dtw.getClassDistances();
+    GRT::VectorFloat distancesWithPaths = dtwWithPaths.getClassDistances();
+    EXPECT_EQ( distances.getSize(), distancesWithPaths.getSize() );
+    for(GRT::UINT k=0; k<distances.getSize(); k++){
+      EXPECT_NEAR( distances[k], distancesWithPaths[k], 1.0e-9 );
+    }
+    const GRT::Vector< GRT::Vector< GRT::IndexDist > > &warpPaths = dtwWithPaths.getWarpingPaths();
+    EXPECT_EQ( templates.getSize(), warpPaths.getSize() );
+    for(GRT::UINT k=0; k<warpPaths.getSize(); k++){
+      EXPECT_TRUE( warpPaths[k].getSize() > 0 );
+      EXPECT_EQ( 0, warpPaths[k].back().x );
+      EXPECT_EQ( 0, warpPaths[k].back().y );
+    }
+  }
+  EXPECT_EQ( 0, dtw.getWarpingPaths().getSize() );
+}
+
+// Tests the streaming subsequence DTW mode against a brute force search over every possible subsequence start
+TEST(DTW, TestStreamingMode) {
+  GRT::Random random;
+  GRT::TimeSeriesClassificationData trainingData = generateSineDataset( 2, 3, random );
+
+  GRT::DTW dtw;
+  EXPECT_TRUE( dtw.setTrainingLoggingEnabled( false ) );
+  EXPECT_TRUE( dtw.enableStreamingMode( true ) );
+  EXPECT_TRUE( dtw.getStreamingModeEnabled() );
+  EXPECT_TRUE( dtw.train( trainingData ) );
+  EXPECT_TRUE( dtw.reset() );
+  EXPECT_EQ( 0, dtw.getStreamingSampleCounter() );
+
+  GRT::Vector< GRT::DTWTemplate > templates = dtw.getModels();
+  const GRT::UINT streamLength = 80;
+  GRT::MatrixFloat stream( streamLength, 2 );
+  for(GRT::UINT t=0; t<streamLength; t++){
+    GRT::VectorFloat sample( 2 );
+    sample[0] = random.getRandomNumberGauss(0,1);
+    sample[1] = random.getRandomNumberGauss(0,1);
+    stream.setRowVector( sample, t );
+    EXPECT_TRUE( dtw.predict( sample ) );
+    EXPECT_EQ( t+1, dtw.getStreamingSampleCounter() );
+
+    //The predictions start once the number of samples reaches the average template length, which is at most 60 samples here
+    if( t < 59 || t % 10 != 9 ) continue;
+
+    //Search for the subsequence ending at t with the minimum accumulated cost
+    const GRT::VectorFloat distances = dtw.getClassDistances();
+    const GRT::Vector< GRT::UINT > &matchStart = dtw.getStreamingMatchStart();
+    EXPECT_EQ( templates.getSize(), matchStart.getSize() );
+    for(GRT::UINT k=0; k<templates.getSize(); k++){
+      GRT::Float bestCost = GRT::grt_numeric_limits< GRT::Float >::max();
+      GRT::Float bestDistance = 0;
+      GRT::UINT bestStart = 0;
+      for(GRT::UINT start=0; start<=t; start++){
+        GRT::MatrixFloat subsequence( t-start+1, 2 );
+        for(GRT::UINT i=start; i<=t; i++) subsequence.setRowVector( stream.getRow(i), i-start );
+        GRT::Float cost = 0;
+        const GRT::Float distance = naiveDTW( templates[k].timeSeries, subsequence, &cost );
+        if( cost < bestCost ){
+          bestCost = cost;
+          bestDistance = distance;
+          bestStart = start;
+        }
+      }
+      EXPECT_EQ( bestStart, matchStart[k] );
+      EXPECT_NEAR( bestDistance, distances[k], 1.0e-9 );
+    }
+  }
+}
+
+// Tests that the streaming null rejection thresholds are trained with the subsequence distance used by the streaming mode
+TEST(DTW, TestStreamingNullRejection) {
+  GRT::Random random;
+  GRT::TimeSeriesClassificationData trainingData = generateSineDataset( 2, 6, random );
+
+  GRT::DTW dtw( false, true, 3.0 );
+  EXPECT_TRUE( dtw.setTrainingLoggingEnabled( false ) );
+  EXPECT_TRUE( dtw.enableStreamingMode( true ) );
+  EXPECT_TRUE( dtw.train( trainingData ) );
+
+  //Each threshold should be set from the streaming distances of its template
+  GRT::Vector< GRT::DTWTemplate > templates = dtw.getModels();
+  GRT::VectorFloat thresholds = dtw.getStreamingNullRejectionThresholds();
+  ASSERT_EQ( templates.getSize(), thresholds.getSize() );
+  for(GRT::UINT k=0; k<templates.getSize(); k++){
+    EXPECT_GT( templates[k].streamingMu, 0 );
+    EXPECT_NEAR( templates[k].streamingMu + 3.0 * templates[k].streamingSigma, thresholds[k], 1.0e-9 );
+  }
+
+  //Changing the null rejection coefficient should update the streaming thresholds
+  EXPECT_TRUE( dtw.setNullRejectionCoeff( 2.0 ) );
+  EXPECT_TRUE( dtw.recomputeNullRejectionThresholds() );
+  thresholds = dtw.getStreamingNullRejectionThresholds();
+  for(GRT::UINT k=0; k<templates.getSize(); k++){
+    EXPECT_NEAR( templates[k].streamingMu + 2.0 * templates[k].streamingSigma, thresholds[k], 1.0e-9 );
+  }
+
+  //The thresholds should be saved with the model
+  EXPECT_TRUE( dtw.save( "dtw_streaming_model.grt" ) );
+  GRT::DTW loadedDTW;
+  EXPECT_TRUE( loadedDTW.load( "dtw_streaming_model.grt" ) );
+  GRT::VectorFloat loadedThresholds = loadedDTW.getStreamingNullRejectionThresholds();
+  ASSERT_EQ( thresholds.getSize(), loadedThresholds.getSize() );
+  for(GRT::UINT k=0; k<thresholds.getSize(); k++) EXPECT_NEAR( thresholds[k], loadedThresholds[k], 1.0e-4 );
+
+  //Streaming the longest training example should give a distance to its class template that is within the threshold, as its subsequence
+  //distance was used to train the threshold
+  GRT::UINT longestIndex = 0;
+  for(GRT::UINT i=1; i<trainingData.getNumSamples(); i++){
+    if( trainingData[i].getLength() > trainingData[longestIndex].getLength() ) longestIndex = i;
+  }
+  const GRT::MatrixFloat &example = trainingData[longestIndex].getData();
+  EXPECT_TRUE( dtw.reset() );
+  for(GRT::UINT i=0; i<example.getNumRows(); i++){
+    EXPECT_TRUE( dtw.predict( example.getRow(i) ) );
+  }
+  const GRT::VectorFloat distances = dtw.getClassDistances();
+  for(GRT::UINT k=0; k<templates.getSize(); k++){
+    if( templates[k].classLabel == trainingData[longestIndex].getClassLabel() ){
+      EXPECT_LE( distances[k], thresholds[k] );
+    }
+  }
+}
+
+// Tests that the lower bound pruning does not change the prediction, and that the envelopes are saved with the model
+TEST(DTW, TestLowerBounding) {
+  GRT::Random random;
+  GRT::TimeSeriesClassificationData trainingData = generateSineDataset( 8, 3, random );
+  GRT::TimeSeriesClassificationData testData = generateSineDataset( 8, 2, random );
+
+  GRT::DTW dtw;
+  EXPECT_TRUE( dtw.setTrainingLoggingEnabled( false ) );
+  EXPECT_TRUE( dtw.train( trainingData ) );
+  EXPECT_FALSE( dtw.getLowerBoundingEnabled() );
+
+  GRT::DTW dtwWithLowerBounds( dtw );
+  EXPECT_TRUE( dtwWithLowerBounds.enableLowerBounding( true ) );
+  EXPECT_TRUE( dtwWithLowerBounds.getLowerBoundingEnabled() );
+
+  //Each template should have an envelope for the realtime input length, which must contain the template samples inside the warping window
+  GRT::Vector< GRT::DTWTemplate > templates = dtw.getModels();
+  for(GRT::UINT k=0; k<templates.getSize(); k++){
+    EXPECT_TRUE( templates[k].upperEnvelope.getNumRows() > 0 );
+    EXPECT_EQ( templates[0].upperEnvelope.getNumRows(), templates[k].upperEnvelope.getNumRows() );
+    EXPECT_EQ( templates[k].upperEnvelope.getNumRows(), templates[k].lowerEnvelope.getNumRows() );
+    for(GRT::UINT j=0; j<templates[k].upperEnvelope.getNumRows(); j++){
+      for(GRT::UINT n=0; n<2; n++){
+        EXPECT_TRUE( templates[k].upperEnvelope[j][n] >= templates[k].lowerEnvelope[j][n] );
+      }
+    }
+  }
+
+  for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+    GRT::MatrixFloat timeseries = testData[i].getData();
+    EXPECT_TRUE( dtw.predict( timeseries ) );
+    EXPECT_TRUE( dtwWithLowerBounds.predict( timeseries ) );
+    EXPECT_EQ( dtw.getPredictedClassLabel(), dtwWithLowerBounds.getPredictedClassLabel() );
+    EXPECT_NEAR( dtw.getBestDistance(), dtwWithLowerBounds.getBestDistance(), 1.0e-9 );
+
+    //A pruned template reports a lower bound of its distance, which must be greater than the best distance
+    GRT::VectorFloat distances = dtw.getClassDistances();
+    GRT::VectorFloat boundedDistances = dtwWithLowerBounds.getClassDistances();
+    for(GRT::UINT k=0; k<distances.getSize(); k++){
+      EXPECT_TRUE( boundedDistances[k] <= distances[k] + 1.0e-9 );
+      if( fabs( boundedDistances[k] - distances[k] ) > 1.0e-9 ){
+        EXPECT_TRUE( boundedDistances[k] > dtw.getBestDistance() );
+      }
+    }
+  }
+
+  //The envelopes should be saved and loaded with the model
+  const std::string modelFilename = "DTW_lower_bounding_model.grt";
+  EXPECT_TRUE( dtwWithLowerBounds.save( modelFilename ) );
+  GRT::DTW dtwLoaded;
+  EXPECT_TRUE( dtwLoaded.load( modelFilename ) );
+  GRT::Vector< GRT::DTWTemplate > loadedTemplates = dtwLoaded.getModels();
+  EXPECT_EQ( templates.getSize(), loadedTemplates.getSize() );
+  for(GRT::UINT k=0; k<loadedTemplates.getSize(); k++){
+    EXPECT_EQ( templates[k].upperEnvelope.getNumRows(), loadedTemplates[k].upperEnvelope.getNumRows() );
+    for(GRT::UINT j=0; j<loadedTemplates[k].upperEnvelope.getNumRows(); j++){
+      for(GRT::UINT n=0; n<2; n++){
+        EXPECT_NEAR( templates[k].upperEnvelope[j][n], loadedTemplates[k].upperEnvelope[j][n], 1.0e-4 );
+        EXPECT_NEAR( templates[k].lowerEnvelope[j][n], loadedTemplates[k].lowerEnvelope[j][n], 1.0e-4 );
+      }
+    }
+  }
+  EXPECT_TRUE( dtwLoaded.enableLowerBounding( true ) );
+  for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+    GRT::MatrixFloat timeseries = testData[i].getData();
+    EXPECT_TRUE( dtw.predict( timeseries ) );
+    EXPECT_TRUE( dtwLoaded.predict( timeseries ) );
+    EXPECT_EQ( dtw.getPredictedClassLabel(), dtwLoaded.getPredictedClassLabel() );
+  }
+}
+
+// Tests that lower bounding does not change the prediction for any of the null rejection modes
+TEST(DTW, TestLowerBoundingWithNullRejection) {
+  GRT::Random random;
+  GRT::TimeSeriesClassificationData trainingData = generateSineDataset( 8, 3, random );
+  GRT::TimeSeriesClassificationData testData = generateSineDataset( 8, 2, random );
+
+  GRT::DTW dtw;
+  EXPECT_TRUE( dtw.setTrainingLoggingEnabled( false ) );
+  EXPECT_TRUE( dtw.enableNullRejection( true ) );
+  EXPECT_TRUE( dtw.train( trainingData ) );
+
+  const GRT::UINT rejectionModes[] = { GRT::DTW::TEMPLATE_THRESHOLDS, GRT::DTW::CLASS_LIKELIHOODS, GRT::DTW::THRESHOLDS_AND_LIKELIHOODS };
+  const GRT::Float likelihoodThresholds[] = { 0.05, 0.1, 0.2, 0.3 };
+  for(GRT::UINT m=0; m<3; m++){
+    for(GRT::UINT t=0; t<4; t++){
+      EXPECT_TRUE( dtw.setRejectionMode( rejectionModes[m] ) );
+      EXPECT_TRUE( dtw.setNullRejectionThreshold( likelihoodThresholds[t] ) );
+      EXPECT_TRUE( dtw.enableLowerBounding( false ) );
+      GRT::DTW dtwWithLowerBounds( dtw );
+      EXPECT_TRUE( dtwWithLowerBounds.enableLowerBounding( true ) );
+
+      for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+        GRT::MatrixFloat timeseries = testData[i].getData();
+        EXPECT_TRUE( dtw.predict( timeseries ) );
+        EXPECT_TRUE( dtwWithLowerBounds.predict( timeseries ) );
+        EXPECT_EQ( dtw.getPredictedClassLabel(), dtwWithLowerBounds.getPredictedClassLabel() );
+        EXPECT_NEAR( dtw.getBestDistance(), dtwWithLowerBounds.getBestDistance(), 1.0e-9 );
+        if( rejectionModes[m] != GRT::DTW::TEMPLATE_THRESHOLDS ){
+          EXPECT_NEAR( dtw.getMaximumLikelihood(), dtwWithLowerBounds.getMaximumLikelihood(), 1.0e-9 );
+        }
+      }
+    }
+  }
+}
+
+// Tests that training the templates in parallel gives the same model as training them serially
+TEST(DTW, TestParallelTraining) {
+  GRT::Random random;
+  GRT::TimeSeriesClassificationData trainingData = generateSineDataset( 4, 6, random );
+  const unsigned int threadPoolSize = GRT::ThreadPool::getThreadPoolSize();
+
+  GRT::DTW serialDTW( false, true, 3.0 );
+  EXPECT_TRUE( serialDTW.setTrainingLoggingEnabled( false ) );
+  EXPECT_TRUE( GRT::ThreadPool::setThreadPoolSize( 1 ) );
+  EXPECT_TRUE( serialDTW.train( trainingData ) );
+
+  GRT::DTW parallelDTW( false, true, 3.0 );
+  EXPECT_TRUE( parallelDTW.setTrainingLoggingEnabled( false ) );
+  EXPECT_TRUE( GRT::ThreadPool::setThreadPoolSize( 4 ) );
+  EXPECT_TRUE( parallelDTW.train( trainingData ) );
+  EXPECT_TRUE( GRT::ThreadPool::setThreadPoolSize( threadPoolSize ) );
+
+  GRT::Vector< GRT::DTWTemplate > serialTemplates = serialDTW.getModels();
+  GRT::Vector< GRT::DTWTemplate > parallelTemplates = parallelDTW.getModels();
+  EXPECT_EQ( serialTemplates.getSize(), parallelTemplates.getSize() );
+  for(GRT::UINT k=0; k<serialTemplates.getSize(); k++){
+    EXPECT_EQ( serialTemplates[k].classLabel, parallelTemplates[k].classLabel );
+    EXPECT_EQ( serialTemplates[k].timeSeries.getNumRows(), parallelTemplates[k].timeSeries.getNumRows() );
+    EXPECT_NEAR( serialTemplates[k].trainingMu, parallelTemplates[k].trainingMu, 1.0e-9 );
+    EXPECT_NEAR( serialTemplates[k].trainingSigma, parallelTemplates[k].trainingSigma, 1.0e-9 );
+  }
+  GRT::VectorFloat serialThresholds = serialDTW.getNullRejectionThresholds();
+  GRT::VectorFloat parallelThresholds = parallelDTW.getNullRejectionThresholds();
+  for(GRT::UINT k=0; k<serialThresholds.getSize(); k++){
+    EXPECT_NEAR( serialThresholds[k], parallelThresholds[k], 1.0e-9 );
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest( &argc, argv );
   return RUN_ALL_TESTS();
@@ -24,6 +24,112 @@ TEST(DecisionTree, TrainGaussDataset) {
   EXPECT_TRUE( tester.testTrainGaussLinearDataset() );
 }
 
+//Generates a gauss dataset and splits it with a seeded random number generator, so the trees see the same data on every run.
+//The centroid of class k is range in dimension k and zero in the others, so the classes can be separated by thresholds, clusters
+//or by comparing two features, which is the split used by the triple feature node.
+void generateSeededGaussDataset( const GRT::UINT numSamples, const GRT::UINT numClasses, const GRT::UINT numDimensions, const GRT::Float range, const GRT::Float sigma, GRT::ClassificationData &trainingData, GRT::ClassificationData &testData ) {
+  GRT::Random random( 42 );
+  trainingData.clear();
+  trainingData.setNumDimensions( numDimensions );
+  GRT::VectorFloat x( numDimensions );
+  for(GRT::UINT i=0; i<numSamples; i++){
+    const GRT::UINT k = random.getRandomNumberInt( 0, numClasses );
+    for(GRT::UINT j=0; j<numDimensions; j++){
+      x[j] = (j == k ? range : 0) + random.getRandomNumberGauss( 0, sigma );
+    }
+    EXPECT_TRUE( trainingData.addSample( k+1, x ) );
+  }
+  testData = trainingData.split( 50, true, random );
+}
+
+// Tests the tree building with each node type, each node splits its samples in place in the shared training data store
+TEST(DecisionTree, TrainEachNodeType) {
+  GRT::ClassificationData trainingData, testData;
+  generateSeededGaussDataset( 1000, 3, 4, 5, 1, trainingData, testData );
+
+  GRT::DecisionTreeThresholdNode thresholdNode;
+  GRT::DecisionTreeClusterNode clusterNode;
+  GRT::DecisionTreeTripleFeatureNode tripleFeatureNode;
+  GRT::Vector< GRT::DecisionTreeNode* > nodes;
+  nodes.push_back( &thresholdNode );
+  nodes.push_back( &clusterNode );
+  nodes.push_back( &tripleFeatureNode );
+
+  for(GRT::UINT n=0; n<nodes.getSize(); n++){
+    GRT::DecisionTree treeA;
+    treeA.setDecisionTreeNode( *nodes[n] );
+    treeA.setRandomSeed( 42 );
+    treeA.enableNullRejection( true );
+    EXPECT_TRUE( treeA.train( trainingData ) );
+
+    GRT::DecisionTree treeB;
+    treeB.setDecisionTreeNode( *nodes[n] );
+    treeB.setRandomSeed( 42 );
+    treeB.enableNullRejection( true );
+    EXPECT_TRUE( treeB.train( trainingData ) );
+
+    //The trees were built from the same seed so they should be the same
+    EXPECT_EQ( treeA.getTrainingSetAccuracy(), treeB.getTrainingSetAccuracy() );
+    EXPECT_EQ( treeA.getNullRejectionThresholds(), treeB.getNullRejectionThresholds() );
+
+    GRT::Float accuracy = 0;
+    EXPECT_TRUE( treeA.computeAccuracy( testData, accuracy ) );
+    EXPECT_GT( accuracy, 80.0 );
+
+    //The flattened tree should give the same results as running the tree node by node
+    GRT::Node *tree = treeA.getTree()->deepCopy();
+    for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+      GRT::VectorFloat x = testData[i].getSample();
+      GRT::VectorFloat y;
+      EXPECT_TRUE( treeA.predict( x ) );
+      EXPECT_TRUE( tree->predict_( x, y ) );
+      EXPECT_EQ( treeA.getClassLikelihoods(), y );
+      EXPECT_EQ( treeA.getPredictedNodeID(), tree->getPredictedNodeID() );
+    }
+    delete tree;
+  }
+}
+
+// Tests the histogram split, which quantises each feature into at most numSplittingSteps bins
+TEST(DecisionTree, TrainHistogramSplit) {
+  GRT::ClassificationData trainingData = GRT::ClassificationData::generateGaussDataset( 1000, 3, 4, 10, 1 );
+  GRT::ClassificationData testData = trainingData.split( 50, true );
+
+  GRT::DecisionTree treeA( GRT::DecisionTreeThresholdNode(), 5, 10, false, GRT::Tree::BEST_HISTOGRAM_SPLIT, 64 );
+  treeA.setRandomSeed( 42 );
+  EXPECT_TRUE( treeA.train( trainingData ) );
+
+  GRT::DecisionTree treeB( GRT::DecisionTreeThresholdNode(), 5, 10, false, GRT::Tree::BEST_HISTOGRAM_SPLIT, 64 );
+  treeB.setRandomSeed( 42 );
+  EXPECT_TRUE( treeB.train( trainingData ) );
+  EXPECT_EQ( treeA.getTrainingSetAccuracy(), treeB.getTrainingSetAccuracy() );
+
+  GRT::Float accuracy = 0;
+  EXPECT_TRUE( treeA.computeAccuracy( testData, accuracy ) );
+  EXPECT_GT( accuracy, 80.0 );
+
+  //A single bin can not be split
+  EXPECT_TRUE( treeA.setNumSplittingSteps( 1 ) );
+  EXPECT_FALSE( treeA.train( trainingData ) );
+
+  //With two bins the first and second class share the lower bin, so they must be separated by the exact search
+  GRT::ClassificationData sharedBinData;
+  sharedBinData.setNumDimensions( 1 );
+  GRT::Random random( 42 );
+  GRT::VectorFloat x(1);
+  for(GRT::UINT i=0; i<300; i++){
+    const GRT::UINT classLabel = 1 + i%3;
+    x[0] = (classLabel-1)*2 + random.getRandomNumberUniform( 0, 1 );
+    EXPECT_TRUE( sharedBinData.addSample( classLabel, x ) );
+  }
+
+  GRT::DecisionTree treeC( GRT::DecisionTreeThresholdNode(), 5, 10, false, GRT::Tree::BEST_HISTOGRAM_SPLIT, 2 );
+  treeC.setRandomSeed( 42 );
+  EXPECT_TRUE( treeC.train( sharedBinData ) );
+  EXPECT_TRUE( treeC.computeAccuracy( sharedBinData, accuracy ) );
+  EXPECT_EQ( accuracy, 100.0 );
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest( &argc, argv );
   return RUN_ALL_TESTS();
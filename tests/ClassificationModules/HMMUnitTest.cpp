@@ -12,6 +12,157 @@ TEST(HMM, TestCopyConstructor) {
   EXPECT_TRUE( tester.testCopyConstructor() );
 }
 
+// Tests that the incremental sliding window prediction matches classifying the same window as a timeseries
+TEST(HMM, ContinuousSlidingWindowPrediction) {
+  const GRT::UINT length = 50;
+  const GRT::UINT numDimensions = 2;
+  GRT::MatrixFloat data( length, numDimensions );
+  for(GRT::UINT i=0; i<length; i++){
+    data[i][0] = sin( i * 0.2 );
+    data[i][1] = cos( i * 0.1 );
+  }
+  GRT::TimeSeriesClassificationSample sample( 1, data );
+
+  GRT::ContinuousHiddenMarkovModel model( 5, 1, true, 10.0 );
+  EXPECT_TRUE( model.train_( sample ) );
+  EXPECT_TRUE( model.reset() );
+  EXPECT_EQ( model.getPredictionMode(), HMM_SLIDING_WINDOW );
+  GRT::ContinuousHiddenMarkovModel reference( model );
+
+  //The window starts with the zeros the model is reset with
+  GRT::MatrixFloat window( length, numDimensions );
+  window.setAllValues( 0 );
+  GRT::VectorFloat x( numDimensions );
+  for(GRT::UINT t=0; t<3*length; t++){
+    x[0] = sin( t * 0.15 );
+    x[1] = cos( t * 0.1 ) * 0.5;
+    for(GRT::UINT i=0; i+1<length; i++){
+      for(GRT::UINT j=0; j<numDimensions; j++) window[i][j] = window[i+1][j];
+    }
+    for(GRT::UINT j=0; j<numDimensions; j++) window[length-1][j] = x[j];
+
+    EXPECT_TRUE( model.predict_( x ) );
+    EXPECT_TRUE( reference.predict_( window ) );
+    EXPECT_NEAR( model.getLoglikelihood(), reference.getLoglikelihood(), 1.0e-9 );
+    EXPECT_EQ( model.getPhase(), reference.getPhase() );
+  }
+
+  //A copy made in the middle of the stream should continue from the same window
+  GRT::ContinuousHiddenMarkovModel copy( model );
+  for(GRT::UINT t=0; t<length; t++){
+    x[0] = cos( t * 0.3 );
+    x[1] = sin( t * 0.05 );
+    EXPECT_TRUE( model.predict_( x ) );
+    EXPECT_TRUE( copy.predict_( x ) );
+    EXPECT_EQ( model.getLoglikelihood(), copy.getLoglikelihood() );
+    EXPECT_EQ( model.getPhase(), copy.getPhase() );
+  }
+}
+
+// Tests that the online prediction mode matches the forward algorithm over all the observations since the last reset
+TEST(HMM, ContinuousOnlinePrediction) {
+  const GRT::UINT length = 50;
+  const GRT::UINT numDimensions = 2;
+  GRT::MatrixFloat data( length, numDimensions );
+  for(GRT::UINT i=0; i<length; i++){
+    data[i][0] = sin( i * 0.2 );
+    data[i][1] = cos( i * 0.1 );
+  }
+  GRT::TimeSeriesClassificationSample sample( 1, data );
+
+  GRT::ContinuousHiddenMarkovModel model( 5, 1, true, 10.0 );
+  EXPECT_TRUE( model.train_( sample ) );
+  GRT::ContinuousHiddenMarkovModel reference( model );
+  EXPECT_TRUE( model.setPredictionMode( HMM_ONLINE ) );
+  EXPECT_FALSE( model.setPredictionMode( 99 ) );
+
+  GRT::MatrixFloat test( 2*length, numDimensions );
+  for(GRT::UINT i=0; i<test.getNumRows(); i++){
+    test[i][0] = sin( i * 0.18 );
+    test[i][1] = cos( i * 0.11 );
+  }
+
+  for(GRT::UINT i=0; i<test.getNumRows(); i++){
+    GRT::VectorFloat x = test.getRow( i );
+    EXPECT_TRUE( model.predict_( x ) );
+  }
+  EXPECT_TRUE( reference.predict_( test ) );
+  EXPECT_NEAR( model.getLoglikelihood(), reference.getLoglikelihood(), 1.0e-6 );
+  EXPECT_EQ( model.getPhase(), reference.getPhase() );
+}
+
+// Tests that the loglikelihood stays finite for high dimensional inputs that are far from the model
+TEST(HMM, ContinuousHighDimensionalLoglikelihood) {
+  const GRT::UINT length = 50;
+  const GRT::UINT numDimensions = 40;
+  GRT::MatrixFloat data( length, numDimensions );
+  for(GRT::UINT i=0; i<length; i++){
+    for(GRT::UINT j=0; j<numDimensions; j++){
+      data[i][j] = sin( i * 0.2 + j );
+    }
+  }
+  GRT::TimeSeriesClassificationSample sample( 1, data );
+
+  GRT::ContinuousHiddenMarkovModel model( 5, 1, false, 0.1 );
+  EXPECT_TRUE( model.train_( sample ) );
+
+  //Each dimension is 10 sigma away from the model, the emission probabilities underflow if they are not computed in log space
+  GRT::MatrixFloat test( data );
+  for(GRT::UINT i=0; i<length; i++){
+    for(GRT::UINT j=0; j<numDimensions; j++){
+      test[i][j] += 1.0;
+    }
+  }
+
+  EXPECT_TRUE( model.predict_( data ) );
+  const GRT::Float bestLoglikelihood = model.getLoglikelihood();
+  EXPECT_TRUE( model.predict_( test ) );
+  EXPECT_FALSE( grt_isnan( model.getLoglikelihood() ) );
+  EXPECT_FALSE( grt_isinf( model.getLoglikelihood() ) );
+  EXPECT_TRUE( model.getLoglikelihood() < bestLoglikelihood );
+}
+
+// Tests that the parallel Baum-Welch training does not depend on the number of threads
+TEST(HMM, DiscreteTrainingIsDeterministic) {
+  const GRT::UINT numStates = 4;
+  const GRT::UINT numSymbols = 6;
+  GRT::Random random( 42 );
+  GRT::Vector< GRT::Vector< GRT::UINT > > sequences( 100, GRT::Vector< GRT::UINT >( 30 ) );
+  for(GRT::UINT k=0; k<sequences.getSize(); k++){
+    for(GRT::UINT t=0; t<30; t++){
+      sequences[k][t] = (t/8 + random.getRandomNumberInt(0,2)) % numSymbols;
+    }
+  }
+
+  GRT::MatrixFloat a( numStates, numStates );
+  GRT::MatrixFloat b( numStates, numSymbols );
+  GRT::VectorFloat pi( numStates, 1.0/numStates );
+  a.setAllValues( 1.0/numStates );
+  b.setAllValues( 1.0/numSymbols );
+  for(GRT::UINT i=0; i<numStates; i++) b[i][i] += 0.5;
+  for(GRT::UINT i=0; i<numStates; i++){
+    for(GRT::UINT j=0; j<numSymbols; j++) b[i][j] /= 1.5;
+  }
+
+  const GRT::UINT threadPoolSize = GRT::ThreadPool::getThreadPoolSize();
+  GRT::Vector< GRT::Float > loglikelihoods( 2 );
+  GRT::Vector< GRT::VectorFloat > iterationLogs( 2 );
+  for(GRT::UINT n=0; n<2; n++){
+    EXPECT_TRUE( GRT::ThreadPool::setThreadPoolSize( n == 0 ? 1 : 4 ) );
+    GRT::DiscreteHiddenMarkovModel model( a, b, pi, HMM_ERGODIC, 1 );
+    GRT::UINT numIter = 0;
+    EXPECT_TRUE( model.train_( sequences, 20, numIter, loglikelihoods[n] ) );
+    iterationLogs[n] = model.getTrainingIterationLog();
+  }
+  EXPECT_TRUE( GRT::ThreadPool::setThreadPoolSize( threadPoolSize ) );
+
+  EXPECT_EQ( loglikelihoods[0], loglikelihoods[1] );
+  EXPECT_EQ( iterationLogs[0].getSize(), iterationLogs[1].getSize() );
+  for(GRT::UINT i=0; i<iterationLogs[0].getSize() && i<iterationLogs[1].getSize(); i++){
+    EXPECT_EQ( iterationLogs[0][i], iterationLogs[1][i] );
+  }
+}
+
 //TODO: Need to implement temporal train unit tests
 
 int main(int argc, char **argv) {
@@ -26,6 +26,99 @@ TEST(KNN, TrainGaussDataset) {
   EXPECT_TRUE( tester.testTrainGaussLinearDataset() );
 }
 
+// Tests that the KDTree search gives the same predictions as testing every training example
+TEST(KNN, TestSpatialIndexMatchesBruteForce) {
+  GRT::ClassificationData trainingData = GRT::ClassificationData::generateGaussDataset( 2000, 3, 3, 10, 1 );
+  GRT::ClassificationData testData = trainingData.split( 50, true );
+
+  //Add duplicates of some of the training examples, so there are neighbours at the same distance
+  for(GRT::UINT i=0; i<100; i++){
+    trainingData.addSample( testData[i].getClassLabel(), testData[i].getSample() );
+    trainingData.addSample( testData[i].getClassLabel()%3 + 1, testData[i].getSample() );
+  }
+
+  const GRT::UINT distanceMethods[] = { GRT::KNN::EUCLIDEAN_DISTANCE, GRT::KNN::MANHATTAN_DISTANCE };
+  for(GRT::UINT d=0; d<2; d++){
+    GRT::KNN indexed( 5, false, true, 3.0 );
+    GRT::KNN bruteForce( 5, false, true, 3.0 );
+    EXPECT_TRUE( indexed.setDistanceMethod( distanceMethods[d] ) );
+    EXPECT_TRUE( bruteForce.setDistanceMethod( distanceMethods[d] ) );
+    EXPECT_TRUE( bruteForce.enableSpatialIndex( false ) );
+    EXPECT_TRUE( indexed.train( trainingData ) );
+    EXPECT_TRUE( bruteForce.train( trainingData ) );
+    EXPECT_TRUE( indexed.getSpatialIndexBuilt() );
+    EXPECT_FALSE( bruteForce.getSpatialIndexBuilt() );
+    EXPECT_EQ( indexed.getNullRejectionThresholds(), bruteForce.getNullRejectionThresholds() );
+
+    for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+      EXPECT_TRUE( indexed.predict( testData[i].getSample() ) );
+      EXPECT_TRUE( bruteForce.predict( testData[i].getSample() ) );
+      EXPECT_EQ( indexed.getPredictedClassLabel(), bruteForce.getPredictedClassLabel() );
+      EXPECT_EQ( indexed.getClassLikelihoods(), bruteForce.getClassLikelihoods() );
+      EXPECT_EQ( indexed.getClassDistances(), bruteForce.getClassDistances() );
+    }
+  }
+
+  //The index is rebuilt when the model is loaded
+  GRT::KNN knn;
+  EXPECT_TRUE( knn.train( trainingData ) );
+  EXPECT_TRUE( knn.save( "knn_model.grt" ) );
+  GRT::KNN loaded;
+  EXPECT_TRUE( loaded.load( "knn_model.grt" ) );
+  EXPECT_TRUE( loaded.getSpatialIndexBuilt() );
+  for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+    EXPECT_TRUE( knn.predict( testData[i].getSample() ) );
+    EXPECT_TRUE( loaded.predict( testData[i].getSample() ) );
+    EXPECT_EQ( knn.getPredictedClassLabel(), loaded.getPredictedClassLabel() );
+  }
+}
+
+// Tests that predictBatch gives the same results as predicting each row, for each distance and with each search method
+TEST(KNN, TestPredictBatch) {
+  GRT::ClassificationData trainingData = GRT::ClassificationData::generateGaussDataset( 1000, 3, 5, 10, 1 );
+  GRT::ClassificationData testData = trainingData.split( 50, true );
+  GRT::MatrixFloat inputData = testData.getDataAsMatrixFloat();
+
+  const GRT::UINT distanceMethods[] = { GRT::KNN::EUCLIDEAN_DISTANCE, GRT::KNN::COSINE_DISTANCE, GRT::KNN::MANHATTAN_DISTANCE };
+  for(GRT::UINT d=0; d<3; d++){
+    for(GRT::UINT useIndex=0; useIndex<2; useIndex++){
+      GRT::KNN knn( 7, true );
+      EXPECT_TRUE( knn.setDistanceMethod( distanceMethods[d] ) );
+      EXPECT_TRUE( knn.enableSpatialIndex( useIndex == 1 ) );
+      EXPECT_TRUE( knn.train( trainingData ) );
+
+      GRT::MatrixFloat likelihoods;
+      GRT::Vector< GRT::UINT > labels;
+      EXPECT_TRUE( knn.predictBatch( inputData, likelihoods, labels ) );
+      EXPECT_EQ( likelihoods.getNumRows(), inputData.getNumRows() );
+      EXPECT_EQ( labels.getSize(), inputData.getNumRows() );
+
+      for(GRT::UINT i=0; i<inputData.getNumRows(); i++){
+        EXPECT_TRUE( knn.predict( inputData.getRow(i) ) );
+        EXPECT_EQ( labels[i], knn.getPredictedClassLabel() );
+        EXPECT_EQ( likelihoods.getRow(i), knn.getClassLikelihoods() );
+      }
+    }
+  }
+
+  //The full scan should give the same distances with the scalar and SIMD kernels
+  const GRT::GEMM::KernelType kernelType = GRT::GEMM::getKernelType();
+  for(GRT::UINT d=0; d<3; d++){
+    GRT::KNN knn( 7 );
+    EXPECT_TRUE( knn.setDistanceMethod( distanceMethods[d] ) );
+    EXPECT_TRUE( knn.enableSpatialIndex( false ) );
+    EXPECT_TRUE( knn.train( trainingData ) );
+    for(GRT::UINT i=0; i<inputData.getNumRows(); i++){
+      EXPECT_TRUE( GRT::GEMM::setKernelType( GRT::GEMM::SCALAR_KERNEL ) );
+      EXPECT_TRUE( knn.predict( inputData.getRow(i) ) );
+      GRT::VectorFloat scalarDistances = knn.getClassDistances();
+      EXPECT_TRUE( GRT::GEMM::setKernelType( kernelType ) );
+      EXPECT_TRUE( knn.predict( inputData.getRow(i) ) );
+      EXPECT_EQ( scalarDistances, knn.getClassDistances() );
+    }
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest( &argc, argv );
   return RUN_ALL_TESTS();
@@ -26,6 +26,84 @@ TEST(RandomForests, TrainGaussDataset) {
   EXPECT_TRUE( tester.testTrainGaussLinearDataset() );
 }
 
+// Tests that a seeded forest is the same when trained with one or several threads, and that the out-of-bag error is valid
+TEST(RandomForests, TestParallelTraining) {
+  GRT::ClassificationData trainingData = GRT::ClassificationData::generateGaussDataset( 1000, 3, 4, 10, 1 );
+  GRT::ClassificationData testData = trainingData.split( 50, true );
+  const unsigned int threadPoolSize = GRT::ThreadPool::getThreadPoolSize();
+
+  GRT::RandomForests serialForest;
+  serialForest.setForestSize( 20 );
+  serialForest.setRandomSeed( 42 );
+  GRT::ThreadPool::setThreadPoolSize( 1 );
+  EXPECT_TRUE( serialForest.train( trainingData ) );
+
+  GRT::RandomForests parallelForest;
+  parallelForest.setForestSize( 20 );
+  parallelForest.setRandomSeed( 42 );
+  GRT::ThreadPool::setThreadPoolSize( 4 );
+  EXPECT_TRUE( parallelForest.train( trainingData ) );
+  GRT::ThreadPool::setThreadPoolSize( threadPoolSize );
+
+  EXPECT_EQ( serialForest.getOOBError(), parallelForest.getOOBError() );
+  EXPECT_GE( parallelForest.getOOBError(), 0.0 );
+  EXPECT_LT( parallelForest.getOOBError(), 0.5 );
+  EXPECT_EQ( serialForest.getValidationSetAccuracy(), parallelForest.getValidationSetAccuracy() );
+
+  for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+    EXPECT_TRUE( serialForest.predict( testData[i].getSample() ) );
+    EXPECT_TRUE( parallelForest.predict( testData[i].getSample() ) );
+    EXPECT_EQ( serialForest.getPredictedClassLabel(), parallelForest.getPredictedClassLabel() );
+    EXPECT_EQ( serialForest.getClassLikelihoods(), parallelForest.getClassLikelihoods() );
+  }
+}
+
+// Tests the flattened forest gives the same results as running each tree node by node, for single and batch predictions
+TEST(RandomForests, TestFlatForestPrediction) {
+  GRT::ClassificationData trainingData = GRT::ClassificationData::generateGaussDataset( 1000, 3, 4, 10, 1 );
+  GRT::ClassificationData testData = trainingData.split( 50, true );
+  GRT::MatrixFloat testMatrix = testData.getDataAsMatrixFloat();
+
+  GRT::DecisionTreeThresholdNode thresholdNode;
+  GRT::DecisionTreeTripleFeatureNode tripleFeatureNode;
+  GRT::Vector< GRT::DecisionTreeNode* > nodes;
+  nodes.push_back( &thresholdNode );
+  nodes.push_back( &tripleFeatureNode );
+
+  for(GRT::UINT n=0; n<nodes.getSize(); n++){
+    GRT::RandomForests forest;
+    EXPECT_TRUE( forest.setDecisionTreeNode( *nodes[n] ) );
+    EXPECT_TRUE( forest.setForestSize( 10 ) );
+    forest.setRandomSeed( 42 );
+    EXPECT_TRUE( forest.train( trainingData ) );
+
+    GRT::MatrixFloat batchLikelihoods;
+    GRT::Vector< GRT::UINT > batchLabels;
+    EXPECT_TRUE( forest.predictBatch( testMatrix, batchLikelihoods, batchLabels ) );
+    EXPECT_EQ( batchLikelihoods.getNumRows(), testData.getNumSamples() );
+    EXPECT_EQ( batchLabels.getSize(), testData.getNumSamples() );
+
+    for(GRT::UINT i=0; i<testData.getNumSamples(); i++){
+      EXPECT_TRUE( forest.predict( testData[i].getSample() ) );
+      EXPECT_EQ( forest.getPredictedClassLabel(), batchLabels[i] );
+      EXPECT_EQ( forest.getClassLikelihoods(), batchLikelihoods.getRow(i) );
+
+      //Run each tree node by node and check the flattened forest gives the same likelihoods
+      GRT::VectorFloat likelihoods( forest.getNumClasses(), 0 );
+      for(GRT::UINT t=0; t<forest.getForestSize(); t++){
+        GRT::Node *tree = forest.getTree( t )->deepCopy();
+        GRT::VectorFloat x = testData[i].getSample();
+        GRT::VectorFloat y;
+        EXPECT_TRUE( tree->predict_( x, y ) );
+        for(GRT::UINT k=0; k<likelihoods.getSize(); k++) likelihoods[k] += y[k];
+        delete tree;
+      }
+      for(GRT::UINT k=0; k<likelihoods.getSize(); k++) likelihoods[k] *= 1.0 / forest.getForestSize();
+      EXPECT_EQ( forest.getClassLikelihoods(), likelihoods );
+    }
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest( &argc, argv );
   return RUN_ALL_TESTS();
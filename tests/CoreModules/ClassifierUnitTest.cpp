@@ -162,6 +162,42 @@ TEST(Classifier, GetClassLabels) {
   EXPECT_TRUE( labels.getSize() == 0 ); //The default size should be zero
 }
 
+// Tests that training and prediction give the same results for const reference and rvalue inputs
+TEST(Classifier, TrainAndPredictOverloads) {
+
+  const ClassificationData data = ClassificationData::generateGaussLinearDataset( 300, 3, 2, 10, 1 );
+
+  //Training from a const reference should not modify the data, even if the classifier scales the data
+  const VectorFloat firstSample = data[0].getSample();
+  ANBC anbc( true );
+  EXPECT_TRUE( anbc.train( data ) );
+  EXPECT_EQ( data.getNumSamples(), 300 );
+  EXPECT_EQ( data[0].getSample(), firstSample );
+
+  KNN knn( 5, true );
+  EXPECT_TRUE( knn.train( data ) );
+  EXPECT_EQ( knn.getNumClasses(), 3 );
+
+  //Training from an rvalue should give the same model
+  ClassificationData copy( data );
+  ANBC anbcFromRvalue( true );
+  EXPECT_TRUE( anbcFromRvalue.train( std::move( copy ) ) );
+  EXPECT_EQ( anbcFromRvalue.getTrainingSetAccuracy(), anbc.getTrainingSetAccuracy() );
+
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    const VectorFloat &sample = data[i].getSample();
+    EXPECT_TRUE( anbc.predict( sample ) );
+    const UINT predictedClassLabel = anbc.getPredictedClassLabel();
+    EXPECT_TRUE( anbcFromRvalue.predict( VectorFloat( sample ) ) );
+    EXPECT_EQ( anbcFromRvalue.getPredictedClassLabel(), predictedClassLabel );
+  }
+
+  //The classifier should reject inputs with the wrong size, from either overload
+  EXPECT_FALSE( anbc.predict( VectorFloat( 5 ) ) );
+  const VectorFloat wrongSize( 1 );
+  EXPECT_FALSE( anbc.predict( wrongSize ) );
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
@@ -0,0 +1,207 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT ChunkedDataset class
+
+//Creates a classification dataset where the first dimension of each sample is its index, so the samples served by a ChunkedDataset can be checked
+ClassificationData createIndexedClassificationData( const UINT numSamples ){
+  ClassificationData data( 3, "chunked_test" );
+  Random random;
+  VectorFloat sample( 3 );
+  for(UINT i=0; i<numSamples; i++){
+    sample[0] = i;
+    sample[1] = random.getRandomNumberUniform( -1, 1 );
+    sample[2] = random.getRandomNumberUniform( -1, 1 );
+    data.addSample( (i%3)+1, sample );
+  }
+  return data;
+}
+
+//Creates a classification dataset with 3 well separated clusters
+ClassificationData createClusterData( const UINT numSamplesPerClass ){
+  ClassificationData data( 2, "chunked_clusters" );
+  Random random;
+  VectorFloat sample( 2 );
+  for(UINT k=0; k<3; k++){
+    for(UINT i=0; i<numSamplesPerClass; i++){
+      sample[0] = k * 10.0 + random.getRandomNumberGauss( 0, 0.5 );
+      sample[1] = (k%2) * 10.0 + random.getRandomNumberGauss( 0, 0.5 );
+      data.addSample( k+1, sample );
+    }
+  }
+  return data;
+}
+
+// Tests that one epoch serves each sample exactly once, with its class label, with and without shuffling
+TEST(ChunkedDataset, TestEpochCoversAllSamples) {
+
+  const UINT numSamples = 1000;
+  ClassificationData data = createIndexedClassificationData( numSamples );
+  EXPECT_TRUE( data.save( "chunked_dataset_test.grtb" ) );
+
+  ChunkedDataset chunked( 64 );
+  EXPECT_TRUE( chunked.open( "chunked_dataset_test.grtb" ) );
+  EXPECT_EQ( chunked.getDataType(), ChunkedDataset::CLASSIFICATION_DATA );
+  EXPECT_EQ( chunked.getNumSamples(), numSamples );
+  EXPECT_EQ( chunked.getNumDimensions(), 3 );
+  EXPECT_EQ( chunked.getNumClasses(), 3 );
+  EXPECT_EQ( chunked.getNumChunks(), 16 );
+
+  for(UINT shuffle=0; shuffle<2; shuffle++){
+    EXPECT_TRUE( chunked.setShuffle( shuffle == 1 ) );
+    for(UINT epoch=0; epoch<2; epoch++){
+      Vector< UINT > seen( numSamples, 0 );
+      UINT numServed = 0;
+      bool inOrder = true;
+      EXPECT_TRUE( chunked.startEpoch() );
+      while( chunked.nextChunk() ){
+        const MatrixFloat &inputs = chunked.getInputs();
+        const Vector< UINT > &labels = chunked.getClassLabels();
+        ASSERT_EQ( inputs.getNumRows(), labels.getSize() );
+        ASSERT_EQ( inputs.getNumRows(), chunked.getNumSamplesInChunk() );
+        for(UINT i=0; i<inputs.getNumRows(); i++){
+          const UINT index = (UINT)inputs[i][0];
+          ASSERT_LT( index, numSamples );
+          EXPECT_EQ( labels[i], (index%3)+1 );
+          EXPECT_EQ( inputs[i][1], data[index][1] );
+          if( index != numServed ) inOrder = false;
+          seen[index]++;
+          numServed++;
+        }
+      }
+      EXPECT_EQ( numServed, numSamples );
+      for(UINT i=0; i<numSamples; i++) ASSERT_EQ( seen[i], 1 );
+      if( shuffle == 0 ) EXPECT_TRUE( inOrder );
+      else EXPECT_FALSE( inOrder );
+    }
+  }
+
+  //The ranges should match the in-memory dataset
+  Vector< MinMax > ranges = data.getRanges();
+  Vector< MinMax > chunkedRanges = chunked.getInputRanges();
+  ASSERT_EQ( chunkedRanges.getSize(), ranges.getSize() );
+  for(UINT j=0; j<ranges.getSize(); j++){
+    EXPECT_EQ( chunkedRanges[j].minValue, ranges[j].minValue );
+    EXPECT_EQ( chunkedRanges[j].maxValue, ranges[j].maxValue );
+  }
+
+  //The chunk size can not be zero
+  EXPECT_FALSE( chunked.setChunkSize( 0 ) );
+  EXPECT_TRUE( chunked.setChunkSize( 1000 ) );
+  EXPECT_EQ( chunked.getNumChunks(), 1 );
+
+  EXPECT_TRUE( chunked.close() );
+  EXPECT_FALSE( chunked.getIsOpen() );
+  EXPECT_FALSE( chunked.startEpoch() );
+
+  std::remove( "chunked_dataset_test.grtb" );
+}
+
+// Tests that files that are not binary datasets are rejected
+TEST(ChunkedDataset, TestOpenInvalidFile) {
+
+  ClassificationData data = createIndexedClassificationData( 10 );
+  EXPECT_TRUE( data.save( "chunked_dataset_test.csv" ) );
+
+  ChunkedDataset chunked;
+  EXPECT_FALSE( chunked.open( "chunked_dataset_test.csv" ) );
+  EXPECT_FALSE( chunked.open( "chunked_dataset_missing_file.grtb" ) );
+  EXPECT_FALSE( chunked.getIsOpen() );
+
+  std::remove( "chunked_dataset_test.csv" );
+}
+
+// Tests training the regression algorithms from a chunked regression dataset
+TEST(ChunkedDataset, TestTrainRegression) {
+
+  RegressionData data( 1, 1, "chunked_regression" );
+  Random random;
+  VectorFloat x( 1 ), y( 1 );
+  for(UINT i=0; i<2000; i++){
+    x[0] = random.getRandomNumberUniform( 0, 1 );
+    y[0] = 0.8 * x[0] + 0.1;
+    data.addSample( x, y );
+  }
+  EXPECT_TRUE( data.saveDatasetToBinaryFile( "chunked_regression_test.grtb", true ) );
+
+  ChunkedDataset chunked( 256 );
+  EXPECT_TRUE( chunked.open( "chunked_regression_test.grtb" ) );
+  EXPECT_EQ( chunked.getDataType(), ChunkedDataset::REGRESSION_DATA );
+  EXPECT_EQ( chunked.getNumTargetDimensions(), 1 );
+
+  LinearRegression linearRegression;
+  linearRegression.setMaxNumEpochs( 100 );
+  EXPECT_TRUE( linearRegression.train( chunked ) );
+  EXPECT_TRUE( linearRegression.getTrained() );
+  x[0] = 0.5;
+  EXPECT_TRUE( linearRegression.predict( x ) );
+  EXPECT_NEAR( linearRegression.getRegressionData()[0], 0.5, 0.05 );
+
+  LogisticRegression logisticRegression;
+  logisticRegression.setMaxNumEpochs( 10 );
+  EXPECT_TRUE( logisticRegression.train( chunked ) );
+  EXPECT_TRUE( logisticRegression.getTrained() );
+
+  MLP mlp;
+  EXPECT_TRUE( mlp.init( 1, 5, 1 ) );
+  mlp.setMaxNumEpochs( 50 );
+  mlp.setBatchSize( 16 );
+  EXPECT_TRUE( mlp.train( chunked ) );
+  EXPECT_TRUE( mlp.getTrained() );
+  EXPECT_TRUE( mlp.getRegressionModeActive() );
+
+  EXPECT_TRUE( chunked.close() );
+  std::remove( "chunked_regression_test.grtb" );
+}
+
+// Tests training the classification and clustering algorithms from a chunked classification dataset
+TEST(ChunkedDataset, TestTrainClassification) {
+
+  ClassificationData data = createClusterData( 300 );
+  EXPECT_TRUE( data.save( "chunked_clusters_test.grtb" ) );
+
+  ChunkedDataset chunked( 128 );
+  EXPECT_TRUE( chunked.open( "chunked_clusters_test.grtb" ) );
+
+  Softmax softmax( true );
+  softmax.setMaxNumEpochs( 100 );
+  EXPECT_TRUE( softmax.train( chunked ) );
+  EXPECT_TRUE( softmax.getTrained() );
+  EXPECT_GT( softmax.getTrainingSetAccuracy(), 90.0 );
+
+  KMeans kmeans( 3 );
+  kmeans.setMinChange( 1.0e-10 );
+  EXPECT_TRUE( kmeans.train( chunked ) );
+  EXPECT_TRUE( kmeans.getTrained() );
+
+  //Every sample should have been assigned to one of the clusters in the last pass
+  EXPECT_EQ( kmeans.getClusters().getNumRows(), 3 );
+  UINT numAssigned = 0;
+  for(UINT k=0; k<3; k++) numAssigned += kmeans.getClassCountVector()[k];
+  EXPECT_EQ( numAssigned, data.getNumSamples() );
+
+  BernoulliRBM rbm( 5 );
+  rbm.setMaxNumEpochs( 5 );
+  EXPECT_TRUE( rbm.train( chunked ) );
+  EXPECT_TRUE( rbm.getTrained() );
+
+  MLP mlp;
+  EXPECT_TRUE( mlp.init( 2, 5, 3 ) );
+  mlp.setMaxNumEpochs( 20 );
+  mlp.setBatchSize( 8 );
+  EXPECT_TRUE( mlp.train( chunked ) );
+  EXPECT_TRUE( mlp.getClassificationModeActive() );
+
+  //Algorithms that can not be trained from a chunked dataset should fail
+  ANBC anbc;
+  EXPECT_FALSE( anbc.train( chunked ) );
+
+  EXPECT_TRUE( chunked.close() );
+  std::remove( "chunked_clusters_test.grtb" );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT ClassificationData class
+
+ClassificationData CREATE_DATASET( const UINT numSamples, const UINT numDimensions, const UINT numClasses ){
+  ClassificationData data( numDimensions, "binary_test", "some info text" );
+  Random random;
+  VectorFloat sample( numDimensions );
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<numDimensions; j++) sample[j] = random.getRandomNumberGauss( 0, 10 );
+    data.addSample( 1 + (i % numClasses), sample );
+  }
+  data.setClassNameForCorrespondingClassLabel( "first_class", 1 );
+  return data;
+}
+
+// Tests saving and loading a dataset using the binary file format
+TEST(ClassificationData, TestBinarySaveLoad) {
+
+  ClassificationData data = CREATE_DATASET( 500, 7, 3 );
+  EXPECT_TRUE( data.save( "classification_data_test.grtb" ) );
+
+  ClassificationData loaded;
+  EXPECT_TRUE( loaded.load( "classification_data_test.grtb" ) );
+
+  EXPECT_EQ( loaded.getDatasetName(), data.getDatasetName() );
+  EXPECT_EQ( loaded.getInfoText(), data.getInfoText() );
+  EXPECT_EQ( loaded.getNumDimensions(), data.getNumDimensions() );
+  EXPECT_EQ( loaded.getNumSamples(), data.getNumSamples() );
+  EXPECT_EQ( loaded.getNumClasses(), data.getNumClasses() );
+  EXPECT_EQ( loaded.getClassNameForCorrespondingClassLabel( 1 ), "first_class" );
+  for(UINT k=0; k<data.getNumClasses(); k++){
+    EXPECT_EQ( loaded.getClassTracker()[k].classLabel, data.getClassTracker()[k].classLabel );
+    EXPECT_EQ( loaded.getClassTracker()[k].counter, data.getClassTracker()[k].counter );
+  }
+
+  //The samples are stored as float64 values, so they should match exactly
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    ASSERT_EQ( loaded[i].getClassLabel(), data[i].getClassLabel() );
+    for(UINT j=0; j<data.getNumDimensions(); j++){
+      ASSERT_EQ( loaded[i][j], data[i][j] );
+    }
+  }
+}
+
+// Tests saving and loading a dataset using single precision values
+TEST(ClassificationData, TestBinarySaveLoadSinglePrecision) {
+
+  ClassificationData data = CREATE_DATASET( 100, 4, 2 );
+  EXPECT_TRUE( data.saveDatasetToBinaryFile( "classification_data_test_f32.grtb", true ) );
+
+  ClassificationData loaded;
+  EXPECT_TRUE( loaded.loadDatasetFromBinaryFile( "classification_data_test_f32.grtb" ) );
+  EXPECT_EQ( loaded.getNumSamples(), data.getNumSamples() );
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    ASSERT_EQ( loaded[i].getClassLabel(), data[i].getClassLabel() );
+    for(UINT j=0; j<data.getNumDimensions(); j++){
+      ASSERT_EQ( loaded[i][j], (Float)(float)data[i][j] );
+    }
+  }
+}
+
+// Tests that loading a truncated or mismatched binary file fails cleanly
+TEST(ClassificationData, TestBinaryLoadInvalidFile) {
+
+  ClassificationData data = CREATE_DATASET( 100, 4, 2 );
+  EXPECT_TRUE( data.save( "classification_data_test.grtb" ) );
+
+  //Copy all but the last few bytes of the file
+  std::ifstream in( "classification_data_test.grtb", std::ios::binary );
+  std::string contents( (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>() );
+  in.close();
+  std::ofstream out( "classification_data_test_truncated.grtb", std::ios::binary );
+  out.write( contents.data(), contents.size()-10 );
+  out.close();
+
+  ClassificationData loaded;
+  EXPECT_FALSE( loaded.load( "classification_data_test_truncated.grtb" ) );
+  EXPECT_EQ( loaded.getNumSamples(), 0 );
+
+  //A regression dataset can not be loaded from a classification data file
+  RegressionData regressionData;
+  EXPECT_FALSE( regressionData.load( "classification_data_test.grtb" ) );
+
+  //The last 4 bytes of the file are the class label of the last sample, a label that is not in the header should be rejected
+  const UINT lastLabel = data[ data.getNumSamples()-1 ].getClassLabel();
+  const UINT invalidLabels[] = { 999, lastLabel == 1 ? 2u : 1u };
+  for(UINT k=0; k<2; k++){
+    std::string corrupted = contents;
+    const unsigned char *label = reinterpret_cast< const unsigned char* >( &invalidLabels[k] );
+    for(UINT i=0; i<4; i++) corrupted[ corrupted.size()-4+i ] = label[i];
+    out.open( "classification_data_test_truncated.grtb", std::ios::binary );
+    out.write( corrupted.data(), corrupted.size() );
+    out.close();
+    EXPECT_FALSE( loaded.load( "classification_data_test_truncated.grtb" ) );
+    EXPECT_EQ( loaded.getNumSamples(), 0 );
+  }
+
+  //The number of dimensions in the header is only used to allocate samples that the file actually contains
+  for(UINT numSamples=0; numSamples<2; numSamples++){
+    BinaryDataFile file;
+    EXPECT_TRUE( file.openForWriting( "classification_data_test_truncated.grtb", "ClassificationData" ) );
+    EXPECT_TRUE( file.writeString( "" ) && file.writeString( "" ) );
+    EXPECT_TRUE( file.writeUINT( std::numeric_limits< UINT >::max() ) && file.writeUINT64( numSamples ) );
+    EXPECT_TRUE( file.writeUINT( 0 ) && file.writeUINT( 0 ) && file.writeUINT( sizeof(double) ) && file.alignBlock() );
+    EXPECT_TRUE( file.close() );
+    EXPECT_EQ( loaded.load( "classification_data_test_truncated.grtb" ), numSamples == 0 );
+    EXPECT_EQ( loaded.getNumSamples(), 0 );
+  }
+
+  std::remove( "classification_data_test.grtb" );
+  std::remove( "classification_data_test_truncated.grtb" );
+}
+
+// Tests that loading a CSV file with a class label that is not a non-negative integer fails
+TEST(ClassificationData, TestCSVLoadInvalidClassLabel) {
+
+  const char *labels[] = { "1.5", "-1", "1e20" };
+  for(UINT k=0; k<3; k++){
+    std::ofstream out( "classification_data_test_label.csv" );
+    out << "1,0.5,0.25\n" << labels[k] << ",0.5,0.25\n";
+    out.close();
+
+    ClassificationData loaded;
+    EXPECT_FALSE( loaded.loadDatasetFromCSVFile( "classification_data_test_label.csv" ) );
+    EXPECT_EQ( loaded.getNumSamples(), 0 );
+  }
+
+  std::ofstream out( "classification_data_test_label.csv" );
+  out << "1,0.5,0.25\n2,0.5,0.25\n";
+  out.close();
+  ClassificationData loaded;
+  EXPECT_TRUE( loaded.loadDatasetFromCSVFile( "classification_data_test_label.csv" ) );
+  EXPECT_EQ( loaded.getNumClasses(), 2 );
+
+  std::remove( "classification_data_test_label.csv" );
+}
+
+// Tests moving a dataset, the samples should be moved rather than copied
+TEST(ClassificationData, TestMove) {
+
+  ClassificationData data = CREATE_DATASET( 200, 3, 4 );
+  const ClassificationSample *firstSample = &data[0];
+
+  ClassificationData moved( std::move( data ) );
+  EXPECT_EQ( &moved[0], firstSample );
+  EXPECT_EQ( moved.getNumSamples(), 200 );
+  EXPECT_EQ( moved.getNumDimensions(), 3 );
+  EXPECT_EQ( moved.getNumClasses(), 4 );
+  EXPECT_EQ( moved.getDatasetName(), "binary_test" );
+  EXPECT_EQ( data.getNumSamples(), 0 );
+  EXPECT_EQ( data.getNumClasses(), 0 );
+
+  ClassificationData assigned;
+  assigned = std::move( moved );
+  EXPECT_EQ( &assigned[0], firstSample );
+  EXPECT_EQ( assigned.getNumSamples(), 200 );
+  EXPECT_EQ( assigned.getNumClasses(), 4 );
+  EXPECT_EQ( assigned.getClassNameForCorrespondingClassLabel( 1 ), "first_class" );
+  EXPECT_EQ( moved.getNumSamples(), 0 );
+
+  //The moved from dataset can be reused
+  VectorFloat sample( 3, 1.0 );
+  EXPECT_TRUE( moved.addSample( 1, sample ) );
+  EXPECT_EQ( moved.getNumSamples(), 1 );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,305 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT ClassificationDataView class
+
+//Returns true if the view contains the same samples, in the same order, as the dataset
+bool viewMatchesDataset( const ClassificationDataView &view, const ClassificationData &data ){
+  if( view.getNumSamples() != data.getNumSamples() ) return false;
+  if( view.getNumDimensions() != data.getNumDimensions() ) return false;
+  for(UINT i=0; i<view.getNumSamples(); i++){
+    if( view[i].getClassLabel() != data[i].getClassLabel() ) return false;
+    for(UINT j=0; j<view.getNumDimensions(); j++){
+      if( view[i][j] != data[i][j] ) return false;
+    }
+  }
+  return true;
+}
+
+//Returns true if the two classifiers predict the same class label for every sample in the dataset
+bool predictionsMatch( Classifier &a, Classifier &b, const ClassificationData &data ){
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    if( !a.predict( data[i].getSample() ) || !b.predict( data[i].getSample() ) ) return false;
+    if( a.getPredictedClassLabel() != b.getPredictedClassLabel() ) return false;
+  }
+  return true;
+}
+
+// Tests that the views of a dataset refer to the correct samples
+TEST(ClassificationDataView, TestViews) {
+
+  const UINT numSamples = 300;
+  const UINT numClasses = 3;
+  ClassificationData data = ClassificationData::generateGaussDataset( numSamples, numClasses, 2, 10, 1 );
+  ASSERT_EQ( data.getNumSamples(), numSamples );
+
+  //A view of the whole dataset
+  ClassificationDataView view = data.getView();
+  EXPECT_TRUE( view.getIsValid() );
+  EXPECT_EQ( view.getNumSamples(), numSamples );
+  EXPECT_EQ( view.getNumClasses(), numClasses );
+  EXPECT_TRUE( viewMatchesDataset( view, data ) );
+  EXPECT_EQ( &view.getDataset(), &data );
+
+  //The ranges of the view should match the dataset
+  Vector< MinMax > ranges = data.getRanges();
+  Vector< MinMax > viewRanges = view.getRanges();
+  ASSERT_EQ( viewRanges.getSize(), ranges.getSize() );
+  for(UINT j=0; j<ranges.getSize(); j++){
+    EXPECT_EQ( viewRanges[j].minValue, ranges[j].minValue );
+    EXPECT_EQ( viewRanges[j].maxValue, ranges[j].maxValue );
+  }
+
+  //The class views should only contain the samples of each class
+  UINT numClassSamples = 0;
+  for(UINT k=0; k<numClasses; k++){
+    const UINT classLabel = data.getClassTracker()[k].classLabel;
+    ClassificationDataView classView = data.getClassView( classLabel );
+    EXPECT_EQ( classView.getNumClasses(), 1 );
+    EXPECT_TRUE( viewMatchesDataset( classView, data.getClassData( classLabel ) ) );
+    EXPECT_TRUE( viewMatchesDataset( view.getClassView( classLabel ), data.getClassData( classLabel ) ) );
+    numClassSamples += classView.getNumSamples();
+  }
+  EXPECT_EQ( numClassSamples, numSamples );
+
+  //The fold views should contain the same samples as the fold datasets
+  const UINT K = 5;
+  EXPECT_TRUE( data.spiltDataIntoKFolds( K, true ) );
+  for(UINT k=0; k<K; k++){
+    ClassificationDataView trainingFold = data.getTrainingFoldView( k );
+    ClassificationDataView testFold = data.getTestFoldView( k );
+    EXPECT_EQ( trainingFold.getNumSamples() + testFold.getNumSamples(), numSamples );
+    EXPECT_EQ( trainingFold.getNumClasses(), numClasses );
+    EXPECT_TRUE( viewMatchesDataset( trainingFold, data.getTrainingFoldData( k ) ) );
+    EXPECT_TRUE( viewMatchesDataset( testFold, data.getTestFoldData( k ) ) );
+  }
+
+  //The bootstrapped view should draw the same samples as the bootstrapped dataset for the same seed
+  for(UINT balance=0; balance<2; balance++){
+    Random random;
+    Vector< UINT > sampleIndexs;
+    random.setSeed( 42 );
+    ClassificationData bootstrappedData = data.getBootstrappedDataset( 100, balance == 1, random, sampleIndexs );
+    random.setSeed( 42 );
+    ClassificationDataView bootstrappedView = data.getBootstrappedView( 100, balance == 1, random );
+    EXPECT_EQ( bootstrappedView.getIndexs(), sampleIndexs );
+    EXPECT_TRUE( viewMatchesDataset( bootstrappedView, bootstrappedData ) );
+  }
+
+  //Splitting a view should partition its samples without changing the dataset
+  Random random;
+  ClassificationDataView trainingView = data.getView();
+  ClassificationDataView testView = trainingView.split( 80, true, random );
+  EXPECT_EQ( trainingView.getNumSamples() + testView.getNumSamples(), numSamples );
+  EXPECT_EQ( trainingView.getNumClasses(), numClasses );
+  EXPECT_EQ( testView.getNumClasses(), numClasses );
+  EXPECT_EQ( data.getNumSamples(), numSamples );
+  Vector< UINT > seen( numSamples, 0 );
+  for(UINT i=0; i<trainingView.getNumSamples(); i++) seen[ trainingView.getIndex(i) ]++;
+  for(UINT i=0; i<testView.getNumSamples(); i++) seen[ testView.getIndex(i) ]++;
+  for(UINT i=0; i<numSamples; i++) EXPECT_EQ( seen[i], 1 );
+
+  //Copying the view should give a dataset with the same samples
+  ClassificationData copy = view.getClassificationData();
+  EXPECT_TRUE( viewMatchesDataset( view, copy ) );
+  EXPECT_EQ( copy.getNumClasses(), numClasses );
+
+  //Indexs outside of the dataset are ignored
+  Vector< UINT > indexs( 2 );
+  indexs[0] = 0;
+  indexs[1] = numSamples;
+  EXPECT_EQ( ClassificationDataView( data, indexs ).getNumSamples(), 1 );
+
+  view.clear();
+  EXPECT_FALSE( view.getIsValid() );
+  EXPECT_EQ( view.getNumSamples(), 0 );
+}
+
+// Tests training classifiers from views of a dataset
+TEST(ClassificationDataView, TestTrainFromView) {
+
+  ClassificationData data = ClassificationData::generateGaussLinearDataset( 500, 3, 2, 10, 1 );
+  EXPECT_TRUE( data.spiltDataIntoKFolds( 2, true ) );
+  ClassificationData trainingData = data.getTrainingFoldData( 0 );
+  ClassificationDataView trainingView = data.getTrainingFoldView( 0 );
+  ClassificationData testData = data.getTestFoldData( 0 );
+
+  //Training the ANBC model from a view should give the same model as training it from a copy of the data
+  ANBC anbcFromData;
+  ANBC anbcFromView;
+  EXPECT_TRUE( anbcFromData.train( trainingData ) );
+  EXPECT_TRUE( anbcFromView.train( trainingView ) );
+  EXPECT_TRUE( anbcFromView.getTrained() );
+  EXPECT_EQ( anbcFromView.getNumClasses(), 3 );
+  EXPECT_EQ( anbcFromView.getTrainingSetAccuracy(), anbcFromData.getTrainingSetAccuracy() );
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    EXPECT_TRUE( anbcFromData.predict( testData[i].getSample() ) );
+    EXPECT_TRUE( anbcFromView.predict( testData[i].getSample() ) );
+    EXPECT_EQ( anbcFromView.getPredictedClassLabel(), anbcFromData.getPredictedClassLabel() );
+  }
+
+  //The view should not have been modified by training with scaling enabled
+  ANBC scaledAnbc( true );
+  EXPECT_TRUE( scaledAnbc.train( trainingView ) );
+  EXPECT_TRUE( viewMatchesDataset( trainingView, trainingData ) );
+  EXPECT_GT( scaledAnbc.getTrainingSetAccuracy(), 90.0 );
+
+  //The ensemble classifiers train each weak classifier from a bootstrapped view
+  BAG bag;
+  bag.addClassifierToEnsemble( ANBC() );
+  bag.addClassifierToEnsemble( MinDist() );
+  EXPECT_TRUE( bag.train( trainingView ) );
+  EXPECT_TRUE( bag.getTrained() );
+
+  //The pipeline trains the classifier with the view when there are no preprocessing or feature extraction modules
+  GestureRecognitionPipeline pipeline;
+  pipeline << ANBC();
+  EXPECT_TRUE( pipeline.train( trainingView ) );
+  EXPECT_TRUE( pipeline.getTrained() );
+  EXPECT_EQ( pipeline.getNumTrainingSamples(), trainingView.getNumSamples() );
+  EXPECT_TRUE( pipeline.test( testData ) );
+  EXPECT_GT( pipeline.getTestAccuracy(), 90.0 );
+
+  //Cross validation with the pipeline trains each fold from a view
+  EXPECT_TRUE( pipeline.train( data, 4, true ) );
+  EXPECT_GT( pipeline.getTestAccuracy(), 90.0 );
+}
+
+// Tests the classifiers that train directly from a view, the view should not be modified and the model should match one trained from a copy of the view
+TEST(ClassificationDataView, TestNativeViewTraining) {
+
+  ClassificationData data = ClassificationData::generateGaussLinearDataset( 500, 3, 2, 10, 1 );
+  EXPECT_TRUE( data.spiltDataIntoKFolds( 2, true ) );
+  ClassificationData trainingData = data.getTrainingFoldData( 0 );
+  ClassificationDataView trainingView = data.getTrainingFoldView( 0 );
+  ClassificationData testData = data.getTestFoldData( 0 );
+
+  //A bootstrapped view only contains samples of the view it was drawn from
+  Random random;
+  ClassificationDataView bootstrappedView = trainingView.getBootstrappedView( 100, true, random );
+  EXPECT_EQ( bootstrappedView.getNumSamples(), 100 );
+  EXPECT_EQ( bootstrappedView.getNumClasses(), 3 );
+  Vector< UINT > inView( data.getNumSamples(), 0 );
+  for(UINT i=0; i<trainingView.getNumSamples(); i++) inView[ trainingView.getIndex(i) ] = 1;
+  for(UINT i=0; i<bootstrappedView.getNumSamples(); i++){
+    EXPECT_EQ( inView[ bootstrappedView.getIndex(i) ], 1 );
+  }
+  EXPECT_EQ( trainingView.getClassView( 1 ).getBootstrappedView( 10, false, random ).getNumClasses(), 1 );
+  EXPECT_EQ( trainingView.getClassView( 1 ).getBootstrappedView( 10, false, random, true ).getNumClasses(), 1 );
+  EXPECT_EQ( trainingView.getBootstrappedView( 0, false, random ).getNumSamples(), trainingView.getNumSamples() );
+
+  //The deterministic classifiers should give the same model from the view as from a copy of the view
+  KNN knnFromData( 10, true );
+  KNN knnFromView( 10, true );
+  EXPECT_TRUE( knnFromData.train( trainingData ) );
+  EXPECT_TRUE( knnFromView.train( trainingView ) );
+  EXPECT_EQ( knnFromView.getTrainingSetAccuracy(), knnFromData.getTrainingSetAccuracy() );
+  EXPECT_TRUE( predictionsMatch( knnFromData, knnFromView, testData ) );
+
+  SVM svmFromData;
+  SVM svmFromView;
+  svmFromData.enableScaling( true );
+  svmFromView.enableScaling( true );
+  EXPECT_TRUE( svmFromData.train( trainingData ) );
+  EXPECT_TRUE( svmFromView.train( trainingView ) );
+  EXPECT_TRUE( predictionsMatch( svmFromData, svmFromView, testData ) );
+
+  DecisionTree treeFromData;
+  DecisionTree treeFromView;
+  treeFromData.enableScaling( true );
+  treeFromView.enableScaling( true );
+  treeFromData.setRandomSeed( 42 );
+  treeFromView.setRandomSeed( 42 );
+  EXPECT_TRUE( treeFromData.train( trainingData ) );
+  EXPECT_TRUE( treeFromView.train( trainingView ) );
+  EXPECT_EQ( treeFromView.getTrainingSetAccuracy(), treeFromData.getTrainingSetAccuracy() );
+  EXPECT_TRUE( predictionsMatch( treeFromData, treeFromView, testData ) );
+
+  RandomForests forestFromData;
+  RandomForests forestFromView;
+  forestFromData.setRandomSeed( 42 );
+  forestFromView.setRandomSeed( 42 );
+  EXPECT_TRUE( forestFromData.train( trainingData ) );
+  EXPECT_TRUE( forestFromView.train( trainingView ) );
+  EXPECT_EQ( forestFromView.getOOBError(), forestFromData.getOOBError() );
+  EXPECT_TRUE( predictionsMatch( forestFromData, forestFromView, testData ) );
+  forestFromData.enableScaling( true );
+  forestFromView.enableScaling( true );
+  forestFromData.setRandomSeed( 42 );
+  forestFromView.setRandomSeed( 42 );
+  EXPECT_TRUE( forestFromData.train( trainingData ) );
+  EXPECT_TRUE( forestFromView.train( trainingView ) );
+  EXPECT_TRUE( predictionsMatch( forestFromData, forestFromView, testData ) );
+
+  //The other classifiers use random initial models, so they are only checked to train a model
+  Float accuracy = 0;
+  GMM gmm( 2 );
+  gmm.enableScaling( true );
+  EXPECT_TRUE( gmm.train( trainingView ) );
+  EXPECT_TRUE( gmm.computeAccuracy( testData, accuracy ) );
+  EXPECT_GT( accuracy, 90.0 );
+
+  MinDist minDist( true );
+  EXPECT_TRUE( minDist.train( trainingView ) );
+  EXPECT_TRUE( minDist.computeAccuracy( testData, accuracy ) );
+  EXPECT_GT( accuracy, 90.0 );
+
+  //The accuracy of the Softmax model depends too much on its random initial weights to be checked here
+  Softmax softmax( true );
+  EXPECT_TRUE( softmax.train( trainingView ) );
+  EXPECT_EQ( softmax.getNumClasses(), 3 );
+
+  //None of the classifiers should have modified the view
+  EXPECT_TRUE( viewMatchesDataset( trainingView, trainingData ) );
+}
+
+// Tests training from the folds of a dataset with a class that has no samples in the training folds
+TEST(ClassificationDataView, TestTrainFromFoldsWithMissingClass) {
+
+  //Class 3 is added to the dataset, but none of its samples are, so it is missing from every fold
+  ClassificationData data = ClassificationData::generateGaussLinearDataset( 300, 2, 2, 10, 1 );
+  EXPECT_TRUE( data.addClass( 3 ) );
+  EXPECT_EQ( data.getNumClasses(), 3 );
+  EXPECT_TRUE( data.spiltDataIntoKFolds( 3, false ) );
+
+  //The training views and the copies made from them should only contain the classes with samples
+  ClassificationDataView trainingView = data.getTrainingFoldView( 0 );
+  EXPECT_EQ( trainingView.getNumClasses(), 2 );
+  EXPECT_EQ( trainingView.getClassificationData().getNumClasses(), 2 );
+  ClassificationDataView fullView( data, trainingView.getIndexs() );
+  EXPECT_EQ( fullView.getNumClasses(), 3 );
+  EXPECT_EQ( fullView.getClassificationData().getNumClasses(), 2 );
+
+  //ANBC, GMM and MinDist train natively from the view and only train models for the classes with samples
+  ANBC anbc;
+  EXPECT_TRUE( anbc.train( fullView ) );
+  EXPECT_EQ( anbc.getNumClasses(), 2 );
+  ClassificationData testData = data.getTestFoldData( 0 );
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    EXPECT_TRUE( anbc.predict( testData[i].getSample() ) );
+    EXPECT_FALSE( grt_isnan( anbc.getMaximumLikelihood() ) );
+  }
+
+  GMM gmm( 2 );
+  EXPECT_TRUE( gmm.train( fullView ) );
+  EXPECT_EQ( gmm.getNumClasses(), 2 );
+  MinDist minDist;
+  EXPECT_TRUE( minDist.train( fullView ) );
+  EXPECT_EQ( minDist.getNumClasses(), 2 );
+
+  //Cross validation with the pipeline should train and test every fold
+  GestureRecognitionPipeline pipeline;
+  pipeline << ANBC();
+  EXPECT_TRUE( pipeline.train( data, 3, false ) );
+  EXPECT_GT( pipeline.getTestAccuracy(), 90.0 );
+  pipeline << MinDist();
+  EXPECT_TRUE( pipeline.train( data, 3, false ) );
+  pipeline << GMM( 2 );
+  EXPECT_TRUE( pipeline.train( data, 3, false ) );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -48,6 +48,42 @@ TEST(MatrixFloat, EqualsConstructor) {
   	EXPECT_EQ(numCols, mat2.getNumCols());
 }
 
+// Tests the move c'tor.
+TEST(MatrixFloat, MoveConstructor) {
+	const UINT numRows = 100;
+	const UINT numCols = 50;
+	MatrixFloat mat1( numRows, numCols );
+	mat1.setAll( 1.5 );
+	const Float *data = mat1.getData();
+	MatrixFloat mat2( std::move(mat1) );
+	EXPECT_EQ(numRows, mat2.getNumRows());
+  	EXPECT_EQ(numCols, mat2.getNumCols());
+	EXPECT_EQ(data, mat2.getData()); //The memory should have been moved, not copied
+	EXPECT_EQ(1.5, mat2[numRows-1][numCols-1]);
+	EXPECT_EQ(0, mat1.getSize());
+	EXPECT_EQ(0, mat1.getNumRows());
+}
+
+// Tests the move equals operator.
+TEST(MatrixFloat, MoveEqualsOperator) {
+	const UINT numRows = 100;
+	const UINT numCols = 50;
+	MatrixFloat mat1( numRows, numCols );
+	mat1.setAll( 1.5 );
+	const Float *data = mat1.getData();
+	MatrixFloat mat2( 5, 5 );
+	mat2 = std::move(mat1);
+	EXPECT_EQ(numRows, mat2.getNumRows());
+  	EXPECT_EQ(numCols, mat2.getNumCols());
+	EXPECT_EQ(data, mat2.getData()); //The memory should have been moved, not copied
+	EXPECT_EQ(1.5, mat2[0][0]);
+	EXPECT_EQ(0, mat1.getSize());
+
+	//The moved from matrix can be reused
+	EXPECT_TRUE( mat1.resize( 2, 2 ) );
+	EXPECT_EQ(4, mat1.getSize());
+}
+
 // Tests the Vector c'tor.
 TEST(MatrixFloat, VectorConstructor) {
 	const UINT numRows = 100;
@@ -256,6 +292,104 @@ TEST(MatrixFloat, SaveLoad) {
 	}
 }
 
+// Tests the matrix multiplication functions against a naive reference implementation
+TEST(MatrixFloat, Multiple) {
+	const UINT M = 67;
+	const UINT K = 301;
+	const UINT N = 45;
+	Random random;
+	MatrixFloat a( M, K );
+	MatrixFloat b( K, N );
+	for(UINT i=0; i<M; i++) for(UINT k=0; k<K; k++) a[i][k] = random.getRandomNumberUniform(-1.0,1.0);
+	for(UINT k=0; k<K; k++) for(UINT j=0; j<N; j++) b[k][j] = random.getRandomNumberUniform(-1.0,1.0);
+
+	MatrixFloat expected( M, N );
+	for(UINT i=0; i<M; i++){
+		for(UINT j=0; j<N; j++){
+			expected[i][j] = 0;
+			for(UINT k=0; k<K; k++) expected[i][j] += a[i][k] * b[k][j];
+		}
+	}
+
+	MatrixFloat c = a.multiple( b );
+	EXPECT_EQ(M, c.getNumRows());
+	EXPECT_EQ(N, c.getNumCols());
+	for(UINT i=0; i<M; i++) for(UINT j=0; j<N; j++) EXPECT_NEAR( expected[i][j], c[i][j], 1.0e-9 );
+
+	//Test the transposed version, a' is [K M] so compute (a')' * b
+	MatrixFloat aT( a );
+	EXPECT_TRUE( aT.transpose() );
+	MatrixFloat d;
+	EXPECT_TRUE( d.multiple( aT, b, true ) );
+	for(UINT i=0; i<M; i++) for(UINT j=0; j<N; j++) EXPECT_NEAR( expected[i][j], d[i][j], 1.0e-9 );
+
+	//Test the in-place version, d = 2 * a * b - d, which should give expected
+	MatrixFloat bT( b );
+	EXPECT_TRUE( bT.transpose() );
+	EXPECT_TRUE( d.multiple( a, bT, 2.0, -1.0, false, true ) );
+	for(UINT i=0; i<M; i++) for(UINT j=0; j<N; j++) EXPECT_NEAR( expected[i][j], d[i][j], 1.0e-9 );
+
+	//Test the matrix vector product
+	VectorFloat x( K );
+	for(UINT k=0; k<K; k++) x[k] = random.getRandomNumberUniform(-1.0,1.0);
+	VectorFloat y = a.multiple( x );
+	VectorFloat yT;
+	EXPECT_TRUE( aT.multiple( x, yT, 1.0, 0.0, true ) );
+	EXPECT_EQ(M, y.getSize());
+	EXPECT_EQ(M, yT.getSize());
+	for(UINT i=0; i<M; i++){
+		Float sum = 0;
+		for(UINT k=0; k<K; k++) sum += a[i][k] * x[k];
+		EXPECT_NEAR( sum, y[i], 1.0e-9 );
+		EXPECT_NEAR( sum, yT[i], 1.0e-9 );
+	}
+
+	//A NaN in the matrix should propagate to the output, even if it is multiplied by zero, as it does in the naive product
+	MatrixFloat nanMatrix( 2, 2 );
+	nanMatrix.setAll( 1.0 );
+	nanMatrix[0][1] = NAN;
+	VectorFloat z( 2 );
+	z[0] = 0.0;
+	z[1] = 1.0;
+	VectorFloat nanResult;
+	EXPECT_TRUE( nanMatrix.multiple( z, nanResult, 1.0, 0.0, true ) );
+	EXPECT_TRUE( std::isnan( nanResult[1] ) );
+	EXPECT_TRUE( nanMatrix.multiple( z, nanResult ) );
+	EXPECT_TRUE( std::isnan( nanResult[0] ) );
+
+	//The output vector can not be the input vector
+	VectorFloat square( 2, 1.0 );
+	EXPECT_FALSE( nanMatrix.multiple( square, square ) );
+
+	//The scalar kernel should give the same results as the default kernel
+	const GEMM::KernelType kernelType = GEMM::getKernelType();
+	EXPECT_TRUE( GEMM::setKernelType( GEMM::SCALAR_KERNEL ) );
+	MatrixFloat e = a.multiple( b );
+	for(UINT i=0; i<M; i++) for(UINT j=0; j<N; j++) EXPECT_NEAR( expected[i][j], e[i][j], 1.0e-9 );
+	EXPECT_TRUE( GEMM::setKernelType( kernelType ) );
+}
+
+// Tests the covariance matrix
+TEST(MatrixFloat, CovarianceMatrix) {
+	const UINT numRows = 200;
+	const UINT numCols = 7;
+	Random random;
+	MatrixFloat mat( numRows, numCols );
+	for(UINT i=0; i<numRows; i++) for(UINT j=0; j<numCols; j++) mat[i][j] = random.getRandomNumberGauss( j, 1.0 );
+
+	VectorFloat mean = mat.getMean();
+	MatrixFloat cov = mat.getCovarianceMatrix();
+	EXPECT_EQ(numCols, cov.getNumRows());
+	EXPECT_EQ(numCols, cov.getNumCols());
+	for(UINT j=0; j<numCols; j++){
+		for(UINT k=0; k<numCols; k++){
+			Float sum = 0;
+			for(UINT i=0; i<numRows; i++) sum += (mat[i][j]-mean[j]) * (mat[i][k]-mean[k]);
+			EXPECT_NEAR( sum / Float(numRows-1), cov[j][k], 1.0e-9 );
+		}
+	}
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
@@ -0,0 +1,64 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT RegressionData class
+
+// Tests saving and loading a dataset using the binary file format
+TEST(RegressionData, TestBinarySaveLoad) {
+
+  const UINT numSamples = 300;
+  RegressionData data( 5, 2, "binary_test" );
+  Random random;
+  VectorFloat input( 5 ), target( 2 );
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<5; j++) input[j] = random.getRandomNumberUniform( -1, 1 );
+    for(UINT j=0; j<2; j++) target[j] = random.getRandomNumberGauss( 0, 1 );
+    EXPECT_TRUE( data.addSample( input, target ) );
+  }
+
+  EXPECT_TRUE( data.save( "regression_data_test.grtb" ) );
+
+  RegressionData loaded;
+  EXPECT_TRUE( loaded.load( "regression_data_test.grtb" ) );
+  EXPECT_EQ( loaded.getDatasetName(), data.getDatasetName() );
+  EXPECT_EQ( loaded.getNumInputDimensions(), 5 );
+  EXPECT_EQ( loaded.getNumTargetDimensions(), 2 );
+  EXPECT_EQ( loaded.getNumSamples(), numSamples );
+  for(UINT i=0; i<numSamples; i++){
+    for(UINT j=0; j<5; j++) ASSERT_EQ( loaded[i].getInputVector()[j], data[i].getInputVector()[j] );
+    for(UINT j=0; j<2; j++) ASSERT_EQ( loaded[i].getTargetVector()[j], data[i].getTargetVector()[j] );
+  }
+}
+
+// Tests that a binary file whose header lists samples that are not in the file fails to load without allocating them
+TEST(RegressionData, TestBinaryLoadInvalidFile) {
+
+  //A header with samples but no dimensions would otherwise allocate every sample from a file that holds none of them
+  BinaryDataFile file;
+  EXPECT_TRUE( file.openForWriting( "regression_data_test_invalid.grtb", "RegressionData" ) );
+  EXPECT_TRUE( file.writeString( "" ) && file.writeString( "" ) );
+  EXPECT_TRUE( file.writeUINT( 0 ) && file.writeUINT( 0 ) && file.writeUINT64( 1000000000ULL ) );
+  EXPECT_TRUE( file.writeUINT( 0 ) && file.writeUINT( sizeof(double) ) && file.alignBlock() );
+  EXPECT_TRUE( file.close() );
+
+  RegressionData loaded;
+  EXPECT_FALSE( loaded.load( "regression_data_test_invalid.grtb" ) );
+  EXPECT_EQ( loaded.getNumSamples(), 0 );
+
+  //A header with huge dimensions but no samples allocates nothing
+  EXPECT_TRUE( file.openForWriting( "regression_data_test_invalid.grtb", "RegressionData" ) );
+  EXPECT_TRUE( file.writeString( "" ) && file.writeString( "" ) );
+  EXPECT_TRUE( file.writeUINT( std::numeric_limits< UINT >::max() ) && file.writeUINT( std::numeric_limits< UINT >::max() ) && file.writeUINT64( 0 ) );
+  EXPECT_TRUE( file.writeUINT( 0 ) && file.writeUINT( sizeof(double) ) && file.alignBlock() );
+  EXPECT_TRUE( file.close() );
+  EXPECT_TRUE( loaded.load( "regression_data_test_invalid.grtb" ) );
+  EXPECT_EQ( loaded.getNumSamples(), 0 );
+
+  std::remove( "regression_data_test_invalid.grtb" );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -26,6 +26,22 @@ TEST(VectorFloat, CopyConstructor) {
 	EXPECT_EQ(vec1.getSize(), vec2.getSize());
 }
 
+// Tests the move c'tor and move equals operator, these must be noexcept so a Vector< VectorFloat > moves its elements when it grows.
+TEST(VectorFloat, MoveConstructor) {
+	EXPECT_TRUE( std::is_nothrow_move_constructible< VectorFloat >::value );
+	EXPECT_TRUE( std::is_nothrow_move_assignable< VectorFloat >::value );
+	const UINT size = 100;
+	VectorFloat vec1(size);
+	const Float *data = vec1.getData();
+	VectorFloat vec2( std::move(vec1) );
+	EXPECT_EQ(size, vec2.getSize());
+	EXPECT_EQ(data, vec2.getData());
+	VectorFloat vec3;
+	vec3 = std::move(vec2);
+	EXPECT_EQ(size, vec3.getSize());
+	EXPECT_EQ(data, vec3.getData());
+}
+
 // Tests the equals operator.
 TEST(VectorFloat, EqualsConstructor) {
 	const UINT size = 100;
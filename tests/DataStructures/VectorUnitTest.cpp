@@ -36,6 +36,29 @@ TEST(Vector, EqualsConstructor) {
 	EXPECT_EQ(vec1.getSize(), vec2.getSize());
 }
 
+// Tests the move c'tor.
+TEST(Vector, MoveConstructor) {
+	const UINT size = 100;
+	Vector< int > vec1(size);
+	const int *data = vec1.data();
+	Vector< int > vec2( std::move(vec1) );
+	EXPECT_EQ(size, vec2.getSize());
+	EXPECT_EQ(data, vec2.data()); //The memory should have been moved, not copied
+	EXPECT_EQ(0, vec1.getSize());
+}
+
+// Tests the move equals operator.
+TEST(Vector, MoveEqualsOperator) {
+	const UINT size = 100;
+	Vector< int > vec1(size);
+	const int *data = vec1.data();
+	Vector< int > vec2;
+	vec2 = std::move(vec1);
+	EXPECT_EQ(size, vec2.getSize());
+	EXPECT_EQ(data, vec2.data()); //The memory should have been moved, not copied
+	EXPECT_EQ(0, vec1.getSize());
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
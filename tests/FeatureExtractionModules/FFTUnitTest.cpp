@@ -0,0 +1,110 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT FFT module
+
+// Tests the default constructor
+TEST(FFT, TestDefaultConstructor) {
+  
+  FFT fft;
+
+  //Check the id's matches
+  EXPECT_TRUE( fft.getId() == FFT::getId() );
+
+  //Check the default settings
+  EXPECT_EQ( fft.getFFTWindowSize(), 512 );
+  EXPECT_EQ( fft.getHopSize(), 1 );
+  EXPECT_EQ( fft.getNumInputDimensions(), 1 );
+  EXPECT_EQ( fft.getNumOutputDimensions(), 512 );
+}
+
+// Tests which settings use the sliding DFT
+TEST(FFT, TestUseSlidingDFT) {
+  
+  EXPECT_TRUE( FFT( 64, 1, 1, FFT::RECTANGULAR_WINDOW ).getUseSlidingDFT() );
+  EXPECT_TRUE( FFT( 64, 3, 1, FFT::RECTANGULAR_WINDOW ).getUseSlidingDFT() );
+  EXPECT_FALSE( FFT( 64, 4, 1, FFT::RECTANGULAR_WINDOW ).getUseSlidingDFT() );
+  EXPECT_FALSE( FFT( 64, 1, 1, FFT::HANNING_WINDOW ).getUseSlidingDFT() );
+
+  //The hop size can be changed without reinitializing the FFT
+  FFT fft( 64, 1, 1, FFT::RECTANGULAR_WINDOW );
+  EXPECT_TRUE( fft.setHopSize( 32 ) );
+  EXPECT_FALSE( fft.getUseSlidingDFT() );
+}
+
+// Tests that the sliding DFT computes the same spectrum as an FFT of the window
+TEST(FFT, TestSlidingDFTMatchesFFT) {
+  
+  const UINT windowSize = 64;
+  const UINT numDimensions = 3;
+  FFT fft( windowSize, 1, numDimensions, FFT::RECTANGULAR_WINDOW );
+  EXPECT_TRUE( fft.getUseSlidingDFT() );
+
+  FastFourierTransform reference;
+  EXPECT_TRUE( reference.init( windowSize, FastFourierTransform::RECTANGULAR_WINDOW ) );
+
+  Random random( 42 );
+  MatrixFloat window( windowSize, numDimensions );
+  window.setAllValues( 0 );
+  VectorFloat x( numDimensions );
+  for(UINT t=0; t<5*windowSize; t++){
+    for(UINT j=0; j<numDimensions; j++){
+      x[j] = sin( t * 0.1 * (j+1) ) + random.getRandomNumberUniform(-0.5,0.5);
+    }
+    for(UINT i=0; i+1<windowSize; i++){
+      for(UINT j=0; j<numDimensions; j++) window[i][j] = window[i+1][j];
+    }
+    for(UINT j=0; j<numDimensions; j++) window[windowSize-1][j] = x[j];
+
+    EXPECT_TRUE( fft.update( x ) );
+    EXPECT_TRUE( fft.getFeatureDataReady() );
+
+    //The window only slides once the buffer is full
+    if( t+1 < windowSize ) continue;
+
+    const Vector< FastFourierTransform > &results = fft.getFFTResultsPtr();
+    for(UINT j=0; j<numDimensions; j++){
+      VectorFloat data = window.getCol( j );
+      EXPECT_TRUE( reference.computeFFT( data ) );
+      for(UINT k=0; k<windowSize/2; k++){
+        EXPECT_NEAR( results[j].getRealDataPtr()[k], reference.getRealDataPtr()[k], 1.0e-9 );
+        EXPECT_NEAR( results[j].getImagDataPtr()[k], reference.getImagDataPtr()[k], 1.0e-9 );
+      }
+    }
+  }
+}
+
+// Tests that a copy of the FFT continues the sliding DFT from the same state
+TEST(FFT, TestCopyConstructor) {
+  
+  FFT fft( 32, 1, 2, FFT::RECTANGULAR_WINDOW );
+  VectorFloat x( 2 );
+  for(UINT t=0; t<100; t++){
+    x[0] = sin( t * 0.3 );
+    x[1] = cos( t * 0.2 );
+    EXPECT_TRUE( fft.update( x ) );
+  }
+
+  FFT copy( fft );
+  EXPECT_TRUE( copy.getId() == FFT::getId() );
+  EXPECT_EQ( copy.getUseSlidingDFT(), fft.getUseSlidingDFT() );
+
+  for(UINT t=100; t<150; t++){
+    x[0] = sin( t * 0.3 );
+    x[1] = cos( t * 0.2 );
+    EXPECT_TRUE( fft.update( x ) );
+    EXPECT_TRUE( copy.update( x ) );
+    const VectorFloat a = fft.getFeatureVector();
+    const VectorFloat b = copy.getFeatureVector();
+    ASSERT_EQ( a.getSize(), b.getSize() );
+    for(UINT i=0; i<a.getSize(); i++){
+      EXPECT_EQ( a[i], b[i] );
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
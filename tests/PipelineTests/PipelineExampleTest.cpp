@@ -98,6 +98,72 @@ TEST(GestureRecognitionPipeline, ExamplePipeline) {
   }
 }
 
+// Tests the k-fold cross validation training, the folds are run in parallel and combined in fold order
+TEST(GestureRecognitionPipeline, KFoldCrossValidation) {
+
+  const UINT numSamples = 500;
+  const UINT kFoldValue = 5;
+  ClassificationData trainingData = ClassificationData::generateGaussLinearDataset(numSamples, 3, 5, 10, 1);
+
+  GestureRecognitionPipeline pipeline;
+  pipeline << ANBC();
+
+  //Train the pipeline using k-fold cross validation
+  EXPECT_TRUE(pipeline.train(trainingData, kFoldValue, true));
+  EXPECT_TRUE(pipeline.getTrained());
+  EXPECT_TRUE(pipeline.getTestAccuracy() >= 80);
+
+  //There should be one set of results for each fold, the test accuracy is the average accuracy of the folds
+  Vector< TestResult > cvResults = pipeline.getCrossValidationResults();
+  EXPECT_EQ(cvResults.getSize(), kFoldValue);
+  Float accuracy = 0;
+  for(UINT k=0; k<cvResults.getSize(); k++){
+    accuracy += cvResults[k].accuracy;
+  }
+  EXPECT_NEAR(accuracy / kFoldValue, pipeline.getTestAccuracy(), 1.0e-9);
+
+  //The pipeline should still be able to make predictions with the model trained on the last fold
+  EXPECT_TRUE(pipeline.predict(trainingData[0].getSample()));
+}
+
+// Tests that predictBatch gives the same results as calling predict with each row in order
+TEST(GestureRecognitionPipeline, PredictBatch) {
+
+  ClassificationData trainingData = ClassificationData::generateGaussLinearDataset(400, 3, 4, 10, 1);
+  ClassificationData testData = trainingData.split(75);
+  MatrixFloat inputData = testData.getDataAsMatrixFloat();
+
+  //Test a classifier with its own batch implementation and one that uses the default implementation, with stateful pre and post processing
+  for(UINT t=0; t<2; t++){
+    GestureRecognitionPipeline pipeline;
+    pipeline << MovingAverageFilter(3, 4);
+    if( t == 0 ) pipeline << KNN(5);
+    else pipeline << ANBC();
+    pipeline << ClassLabelFilter(2, 3);
+    EXPECT_TRUE(pipeline.train(trainingData));
+
+    //Use a copy of the trained pipeline for the reference, and reset both so the filters start from the same state
+    GestureRecognitionPipeline reference = pipeline;
+    EXPECT_TRUE(pipeline.reset());
+    EXPECT_TRUE(reference.reset());
+
+    MatrixFloat classLikelihoods;
+    Vector< UINT > predictedClassLabels;
+    EXPECT_TRUE(pipeline.predictBatch(inputData, classLikelihoods, predictedClassLabels));
+    EXPECT_EQ(classLikelihoods.getNumRows(), inputData.getNumRows());
+    EXPECT_EQ(predictedClassLabels.getSize(), inputData.getNumRows());
+
+    for(UINT i=0; i<inputData.getNumRows(); i++){
+      EXPECT_TRUE(reference.predict(inputData.getRow(i)));
+      EXPECT_EQ(predictedClassLabels[i], reference.getPredictedClassLabel()) << "row " << i;
+      VectorFloat likelihoods = reference.getClassLikelihoods();
+      for(UINT k=0; k<likelihoods.getSize(); k++){
+        EXPECT_NEAR(classLikelihoods[i][k], likelihoods[k], 1.0e-9) << "row " << i;
+      }
+    }
+  }
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
@@ -0,0 +1,92 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT MedianFilter module
+
+//Computes the median of the last filterSize values in the signal by sorting them, this is used as the reference for the running median
+Float SORTED_MEDIAN( const VectorFloat &signal, const UINT index, const UINT filterSize ){
+  const UINT start = index+1 >= filterSize ? index+1-filterSize : 0;
+  std::vector< Float > tmp( signal.begin()+start, signal.begin()+index+1 );
+  std::sort( tmp.begin(), tmp.end() );
+  return tmp[ tmp.size()/2 ];
+}
+
+// Tests the default constructor
+TEST(MedianFilter, TestDefaultConstructor) {
+  
+  MedianFilter filter;
+
+  //Check the id's matches
+  EXPECT_TRUE( filter.getId() == MedianFilter::getId() );
+
+  //Check the default filter is initialized
+  EXPECT_TRUE( filter.getInitialized() );
+  EXPECT_EQ( filter.getFilterSize(), 5 );
+}
+
+// Tests the running median against a sorted window
+TEST(MedianFilter, TestFilterMatchesSortedWindow) {
+
+  const UINT numSamples = 1000;
+  Random random;
+
+  //Test odd and even filter sizes, the signal is rounded so the window contains repeated values
+  const UINT filterSizes[] = {1,2,5,10,101};
+  for(UINT k=0; k<5; k++){
+    const UINT filterSize = filterSizes[k];
+    MedianFilter filter( filterSize, 2 );
+
+    VectorFloat signalA( numSamples ), signalB( numSamples );
+    for(UINT i=0; i<numSamples; i++){
+      signalA[i] = round( random.getRandomNumberGauss( 0, 5 ) );
+      signalB[i] = random.getRandomNumberUniform( -1, 1 );
+    }
+
+    for(UINT i=0; i<numSamples; i++){
+      VectorFloat x(2);
+      x[0] = signalA[i];
+      x[1] = signalB[i];
+      VectorFloat y = filter.filter( x );
+      ASSERT_EQ( y.getSize(), 2 );
+      ASSERT_EQ( y[0], SORTED_MEDIAN( signalA, i, filterSize ) );
+      ASSERT_EQ( y[1], SORTED_MEDIAN( signalB, i, filterSize ) );
+    }
+  }
+}
+
+// Tests that reset clears the window
+TEST(MedianFilter, TestReset) {
+
+  MedianFilter filter( 3, 1 );
+
+  filter.filter( 10 );
+  filter.filter( 10 );
+  filter.filter( 10 );
+  EXPECT_EQ( filter.filter( 1 ), 10 );
+
+  EXPECT_TRUE( filter.reset() );
+  EXPECT_EQ( filter.filter( 1 ), 1 );
+  EXPECT_EQ( filter.filter( 2 ), 2 );
+}
+
+// Tests that a copy continues filtering from the same window
+TEST(MedianFilter, TestCopyConstructor) {
+
+  MedianFilter filter( 5, 1 );
+  const Float values[] = {3,9,1,7,5,2,8};
+  for(UINT i=0; i<7; i++) filter.filter( values[i] );
+
+  MedianFilter filter2( filter );
+  EXPECT_EQ( filter2.getFilterSize(), 5 );
+
+  for(UINT i=0; i<10; i++){
+    const Float x = (Float)((i*7) % 11);
+    EXPECT_EQ( filter.filter( x ), filter2.filter( x ) );
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -115,6 +115,69 @@ TEST(MLP, XORScaled) {
   EXPECT_TRUE( train_mlp_xor(true) );
 }
 
+// Tests an MLP with two hidden layers trained with mini-batch gradient descent, and that the layers are restored when the model is loaded
+TEST(MLP, MultipleHiddenLayersMiniBatch) {
+
+  TrainingLog::setLoggingEnabled( false );
+
+  //Create a smooth regression problem with two inputs and one output
+  RegressionData data;
+  data.setInputAndTargetDimensions( 2, 1 );
+  Random random;
+  VectorFloat x(2);
+  VectorFloat y(1);
+  for(UINT i=0; i<500; i++){
+    x[0] = random.getUniform(-1.0,1.0);
+    x[1] = random.getUniform(-1.0,1.0);
+    y[0] = 0.5*x[0] - 0.3*x[1];
+    data.addSample( x, y );
+  }
+
+  Vector< UINT > hiddenLayerSizes(2);
+  hiddenLayerSizes[0] = 8;
+  hiddenLayerSizes[1] = 6;
+
+  MLP mlp;
+  EXPECT_TRUE( mlp.init( 2, hiddenLayerSizes, 1, Neuron::LINEAR, Neuron::TANH, Neuron::LINEAR ) );
+  EXPECT_EQ( mlp.getNumHiddenLayers(), 2 );
+  EXPECT_EQ( mlp.getNumHiddenNeurons(), 8 );
+  EXPECT_EQ( mlp.getHiddenLayer(1).getSize(), 6 );
+  EXPECT_EQ( mlp.getOutputLayer()[0].numInputs, 6 );
+  EXPECT_TRUE( !mlp.setBatchSize( 0 ) );
+  EXPECT_TRUE( mlp.setBatchSize( 16 ) );
+  EXPECT_EQ( mlp.getBatchSize(), 16 );
+  EXPECT_TRUE( mlp.setMaxNumEpochs( 500 ) );
+  EXPECT_TRUE( mlp.setMinChange( 1.0e-10 ) );
+  EXPECT_TRUE( mlp.setLearningRate( 0.1 ) );
+  EXPECT_TRUE( mlp.setMomentum( 0.5 ) );
+  EXPECT_TRUE( mlp.setUseValidationSet( false ) );
+  EXPECT_TRUE( mlp.setRandomiseTrainingOrder( true ) );
+
+  EXPECT_TRUE( mlp.train( data ) );
+  EXPECT_TRUE( mlp.getTrained() );
+  EXPECT_EQ( mlp.getNumHiddenLayers(), 2 );
+  EXPECT_LT( mlp.getRMSTrainingError(), 0.1 );
+
+  VectorFloat predictions( data.getNumSamples() );
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    EXPECT_TRUE( mlp.predict( data[i].getInputVector() ) );
+    predictions[i] = mlp.getRegressionData()[0];
+  }
+
+  //The loaded model should have the same layers and give the same predictions
+  EXPECT_TRUE( mlp.save( "mlp_deep_model.grt" ) );
+  MLP loaded;
+  EXPECT_TRUE( loaded.load( "mlp_deep_model.grt" ) );
+  EXPECT_TRUE( loaded.getTrained() );
+  EXPECT_EQ( loaded.getNumHiddenLayers(), 2 );
+  EXPECT_EQ( loaded.getHiddenLayerSizes()[1], 6 );
+  EXPECT_EQ( loaded.getBatchSize(), 16 );
+  for(UINT i=0; i<data.getNumSamples(); i++){
+    EXPECT_TRUE( loaded.predict( data[i].getInputVector() ) );
+    EXPECT_NEAR( loaded.getRegressionData()[0], predictions[i], 1.0e-3 );
+  }
+}
+
 int main(int argc, char **argv) {
 	::testing::InitGoogleTest( &argc, argv );
 	return RUN_ALL_TESTS();
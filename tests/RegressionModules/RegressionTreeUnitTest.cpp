@@ -0,0 +1,85 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT RegressionTree module
+
+//Generates a dataset with a piecewise constant target that depends on the first of two inputs
+RegressionData generateStepDataset(const UINT numSamples) {
+  RegressionData data;
+  data.setInputAndTargetDimensions( 2, 1 );
+
+  Random random( 42 );
+  VectorFloat x(2);
+  VectorFloat y(1);
+  for(UINT i=0; i<numSamples; i++){
+    x[0] = random.getRandomNumberUniform( 0, 1 );
+    x[1] = random.getRandomNumberUniform( 0, 1 );
+    y[0] = x[0] < 0.25 ? -1 : (x[0] < 0.5 ? 0 : (x[0] < 0.75 ? 2 : 1));
+    data.addSample( x, y );
+  }
+  return data;
+}
+
+// Tests the default constructor
+TEST(RegressionTree, TestDefaultConstructor) {
+  RegressionTree tree;
+  EXPECT_TRUE( tree.getId() == RegressionTree::getId() );
+  EXPECT_TRUE( !tree.getTrained() );
+}
+
+// Tests the tree can be trained on a basic dataset
+TEST(RegressionTree, TrainStepDataset) {
+  TrainingLog::setLoggingEnabled( false );
+
+  RegressionData trainingData = generateStepDataset( 2000 );
+  RegressionData testData = trainingData.split( 50 );
+
+  RegressionTree regressionTree( 100, 5, 10, false, Tree::BEST_ITERATIVE_SPILT, false, 0 );
+  EXPECT_TRUE( regressionTree.train( trainingData ) );
+  EXPECT_TRUE( regressionTree.getTrained() );
+
+  //The flattened tree should give the same results as running the tree node by node
+  Node *tree = regressionTree.getTree()->deepCopy();
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    VectorFloat x = testData[i].getInputVector();
+    VectorFloat y;
+    EXPECT_TRUE( regressionTree.predict( x ) );
+    EXPECT_TRUE( tree->predict_( x, y ) );
+    EXPECT_EQ( regressionTree.getRegressionData(), y );
+  }
+  delete tree;
+}
+
+// Tests the histogram search, which splits on the sums and sums of squares of the targets in each bin
+TEST(RegressionTree, TrainStepDatasetWithHistograms) {
+  TrainingLog::setLoggingEnabled( false );
+
+  RegressionData trainingData = generateStepDataset( 2000 );
+  RegressionData testData = trainingData.split( 50 );
+
+  //The number of bins must be in the range [2 65535]
+  RegressionTree invalidTree( 1, 5, 10, false, Tree::BEST_HISTOGRAM_SPLIT, false, 0 );
+  EXPECT_FALSE( invalidTree.train( trainingData ) );
+
+  //The step target should be learnt almost exactly, as the splits are placed on the targets rather than the inputs
+  RegressionTree histogramTree( 64, 5, 10, false, Tree::BEST_HISTOGRAM_SPLIT, false, 0 );
+  EXPECT_TRUE( histogramTree.train( trainingData ) );
+  EXPECT_TRUE( histogramTree.getTrained() );
+  Float sse = 0;
+  for(UINT i=0; i<testData.getNumSamples(); i++){
+    EXPECT_TRUE( histogramTree.predict( testData[i].getInputVector() ) );
+    sse += grt_sqr( histogramTree.getRegressionData()[0] - testData[i].getTargetVector()[0] );
+  }
+  EXPECT_LT( sqrt( sse / testData.getNumSamples() ), 0.2 );
+
+  //A large minRMSErrorPerNode should stop the tree at the root
+  RegressionTree stumpTree( 64, 5, 10, false, Tree::BEST_HISTOGRAM_SPLIT, false, 10 );
+  EXPECT_TRUE( stumpTree.train( trainingData ) );
+  EXPECT_TRUE( stumpTree.getTree()->getIsLeafNode() );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
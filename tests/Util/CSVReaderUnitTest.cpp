@@ -0,0 +1,118 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT CSVReader class
+
+// Tests that the fast number parser returns the same value as strtod
+TEST(CSVReader, TestParseFloatMatchesStrtod) {
+
+  const char *values[] = { "0", "-0", "1", "+1", "-12.5", "3.14159", "0.1", "1e-5", "-2.5E+10", "  42  ", "1.", ".5",
+                           "123456789012345678", "0.000000000000000000001234", "12345678901234567890123", "1e400", "4.9e-324",
+                           "2.2250738585072014e-308", "9007199254740993", "inf", "-nan", "0x10" };
+  const UINT numValues = sizeof(values)/sizeof(values[0]);
+  for(UINT i=0; i<numValues; i++){
+    Float value = 0;
+    const char *str = values[i];
+    EXPECT_TRUE( CSVReader::parseFloat( str, str+strlen(str), value ) ) << str;
+    const double expected = strtod( str, NULL );
+    if( grt_isnan( expected ) ) EXPECT_TRUE( grt_isnan( value ) ) << str;
+    else EXPECT_EQ( value, expected ) << str;
+  }
+
+  //Check a large set of random values with a range of precisions and exponents
+  Random random;
+  char str[64];
+  for(UINT i=0; i<10000; i++){
+    const double x = random.getRandomNumberGauss( 0, 1 ) * pow( 10.0, random.getRandomNumberInt( -30, 30 ) );
+    snprintf( str, sizeof(str), "%.*g", random.getRandomNumberInt( 1, 18 ), x );
+    Float value = 0;
+    ASSERT_TRUE( CSVReader::parseFloat( str, str+strlen(str), value ) ) << str;
+    ASSERT_EQ( value, strtod( str, NULL ) ) << str;
+  }
+
+  //Check invalid values are rejected
+  const char *invalid[] = { "", "  ", "-", "abc", "1.2.3", "1e", "12a", "1 2" };
+  for(UINT i=0; i<sizeof(invalid)/sizeof(invalid[0]); i++){
+    Float value = 0;
+    EXPECT_FALSE( CSVReader::parseFloat( invalid[i], invalid[i]+strlen(invalid[i]), value ) ) << invalid[i];
+  }
+}
+
+// Tests reading rows with a small buffer, so rows span several reads and the buffer has to grow
+TEST(CSVReader, TestReadRows) {
+
+  std::ofstream out( "csv_reader_test.csv", std::ios::binary );
+  out << "1,2.5,-3\r\n";
+  out << "\n";
+  out << "4, 5 ,6e2\n";
+  out << "0.125,1234567.875,-0.001\n";
+  out << "7,8,9";
+  out.close();
+
+  CSVReader reader( ',', 4 );
+  EXPECT_TRUE( reader.open( "csv_reader_test.csv" ) );
+
+  UINT numRows = 0;
+  UINT numColumns = 0;
+  EXPECT_TRUE( reader.countRows( numRows, numColumns ) );
+  EXPECT_EQ( numRows, 4 );
+  EXPECT_EQ( numColumns, 3 );
+
+  const Float expected[4][3] = { {1,2.5,-3}, {4,5,600}, {0.125,1234567.875,-0.001}, {7,8,9} };
+  VectorFloat row;
+  for(UINT i=0; i<4; i++){
+    EXPECT_TRUE( reader.readRow( row ) );
+    ASSERT_EQ( row.getSize(), 3 );
+    for(UINT j=0; j<3; j++) EXPECT_EQ( row[j], expected[i][j] );
+  }
+  EXPECT_FALSE( reader.readRow( row ) );
+  EXPECT_FALSE( reader.getError() );
+
+  //Rows with the wrong number of columns should be reported as errors
+  EXPECT_TRUE( reader.rewind() );
+  Float values[2];
+  EXPECT_FALSE( reader.readRow( values, 2 ) );
+  EXPECT_TRUE( reader.getError() );
+}
+
+// Tests loading a classification dataset and a matrix from a CSV file
+TEST(CSVReader, TestLoadDataset) {
+
+  ClassificationData data( 3 );
+  Random random;
+  VectorFloat sample( 3 );
+  for(UINT i=0; i<200; i++){
+    for(UINT j=0; j<3; j++) sample[j] = random.getRandomNumberUniform( -100, 100 );
+    data.addSample( 1 + (i % 4), sample );
+  }
+  EXPECT_TRUE( data.save( "csv_reader_test_data.csv" ) );
+
+  ClassificationData loaded;
+  EXPECT_TRUE( loaded.load( "csv_reader_test_data.csv" ) );
+  EXPECT_EQ( loaded.getNumSamples(), 200 );
+  EXPECT_EQ( loaded.getNumDimensions(), 3 );
+  EXPECT_EQ( loaded.getNumClasses(), 4 );
+  for(UINT i=0; i<200; i++){
+    EXPECT_EQ( loaded[i].getClassLabel(), data[i].getClassLabel() );
+    for(UINT j=0; j<3; j++) EXPECT_NEAR( loaded[i][j], data[i][j], 1.0e-3 );
+  }
+
+  MatrixFloat matrix;
+  EXPECT_TRUE( matrix.load( "csv_reader_test_data.csv" ) );
+  EXPECT_EQ( matrix.getNumRows(), 200 );
+  EXPECT_EQ( matrix.getNumCols(), 4 );
+  EXPECT_EQ( matrix[5][0], data[5].getClassLabel() );
+
+  //A file containing text should fail to load
+  std::ofstream out( "csv_reader_test_invalid.csv" );
+  out << "label,x,y\n1,2,3\n";
+  out.close();
+  EXPECT_FALSE( loaded.load( "csv_reader_test_invalid.csv" ) );
+  EXPECT_EQ( loaded.getNumSamples(), 0 );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+#include <GRT.h>
+#include "gtest/gtest.h"
+using namespace GRT;
+
+//Unit tests for the GRT ThreadPool
+
+// Tests that tasks added to a thread pool are run and return their results
+TEST(ThreadPool, EnqueueTest) {
+  ThreadPool pool( 4 );
+  EXPECT_EQ( 4, pool.getNumThreads() );
+
+  const UINT numTasks = 100;
+  std::vector< std::future< UINT > > results( numTasks );
+  for(UINT i=0; i<numTasks; i++){
+    results[i] = pool.enqueue( [](const UINT x){ return x*x; }, i );
+  }
+  for(UINT i=0; i<numTasks; i++){
+    EXPECT_EQ( i*i, results[i].get() );
+  }
+}
+
+// Tests that parallel_for visits each index exactly once, for several thread pool sizes
+TEST(ThreadPool, ParallelForTest) {
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  const UINT N = 10000;
+
+  for(unsigned int numThreads=1; numThreads<=4; numThreads++){
+    EXPECT_TRUE( ThreadPool::setThreadPoolSize( numThreads ) );
+    std::vector< std::atomic< UINT > > counts( N );
+    for(UINT i=0; i<N; i++) counts[i] = 0;
+    EXPECT_TRUE( ThreadPool::parallel_for( 0, N, [&](const UINT i){ counts[i]++; } ) );
+    for(UINT i=0; i<N; i++) EXPECT_EQ( 1, counts[i] );
+  }
+
+  //An empty range should not call the function
+  bool called = false;
+  EXPECT_TRUE( ThreadPool::parallel_for( 5, 5, [&](const UINT i){ called = true; } ) );
+  EXPECT_FALSE( called );
+
+  EXPECT_TRUE( ThreadPool::setThreadPoolSize( threadPoolSize ) );
+}
+
+// Tests that a parallel_for can be run inside another parallel_for without deadlocking
+TEST(ThreadPool, NestedParallelForTest) {
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  EXPECT_TRUE( ThreadPool::setThreadPoolSize( 4 ) );
+
+  const UINT M = 32;
+  const UINT N = 100;
+  std::vector< std::atomic< UINT > > counts( M*N );
+  for(UINT i=0; i<M*N; i++) counts[i] = 0;
+  EXPECT_TRUE( ThreadPool::parallel_for( 0, M, [&](const UINT i){
+    ThreadPool::parallel_for( 0, N, [&](const UINT j){ counts[i*N+j]++; }, 1 );
+  }, 1 ) );
+  for(UINT i=0; i<M*N; i++) EXPECT_EQ( 1, counts[i] );
+
+  EXPECT_TRUE( ThreadPool::setThreadPoolSize( threadPoolSize ) );
+}
+
+// Tests that parallel_reduce gives the same result for any thread pool size
+TEST(ThreadPool, ParallelReduceTest) {
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  const UINT N = 12345;
+
+  EXPECT_TRUE( ThreadPool::setThreadPoolSize( 1 ) );
+  const Float expected = ThreadPool::parallel_reduce( 0, N, Float(0), [](const UINT i){ return 1.0 / (i+1); }, [](const Float a,const Float b){ return a + b; } );
+  Float sum = 0;
+  for(UINT i=0; i<N; i++) sum += 1.0 / (i+1);
+  EXPECT_NEAR( sum, expected, 1.0e-9 );
+
+  for(unsigned int numThreads=2; numThreads<=4; numThreads++){
+    EXPECT_TRUE( ThreadPool::setThreadPoolSize( numThreads ) );
+    const Float result = ThreadPool::parallel_reduce( 0, N, Float(0), [](const UINT i){ return 1.0 / (i+1); }, [](const Float a,const Float b){ return a + b; } );
+    EXPECT_EQ( expected, result );
+  }
+
+  //The maximum of the range
+  const UINT maxValue = ThreadPool::parallel_reduce( 0, N, UINT(0), [](const UINT i){ return (i*7919) % N; }, [](const UINT a,const UINT b){ return a > b ? a : b; } );
+  EXPECT_EQ( N-1, maxValue );
+
+  EXPECT_TRUE( ThreadPool::setThreadPoolSize( threadPoolSize ) );
+}
+
+// Tests that an exception thrown inside a parallel_for is passed back to the caller
+TEST(ThreadPool, ParallelForExceptionTest) {
+  const unsigned int threadPoolSize = ThreadPool::getThreadPoolSize();
+  EXPECT_TRUE( ThreadPool::setThreadPoolSize( 4 ) );
+
+  EXPECT_THROW( ThreadPool::parallel_for( 0, 100, [](const UINT i){ if( i == 50 ) throw std::runtime_error("test"); }, 1 ), std::runtime_error );
+
+  EXPECT_TRUE( ThreadPool::setThreadPoolSize( threadPoolSize ) );
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}